@@ -0,0 +1,303 @@
+/*
+ * @file benchmark_animation.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Plays a clip of 3000 translation, scale and rotation tracks with
+ * linear, Hermite and Bezier keys and reports tracks sampled per
+ * millisecond. AnimationClip with cursors, with and without quantization,
+ * and with random seeking, is compared against binary searching the keys
+ * of every track. The results must match the reference.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Animation\AnimationClip.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Lite;
+
+static const int TRACKS = 3000;
+static const float DURATION = 10.0f;
+static const int BAKED_KEYS = 301;
+static const int FRAMES = 600;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static float random(unsigned int& state)
+{
+  state = state * 1664525u + 1013904223u;
+  return (state >> 8) / 16777216.0f;
+}
+
+// A track as it was stored before, sampled with a binary search.
+struct ReferenceTrack
+{
+  AnimationClip::TrackType     type;
+  AnimationClip::Interpolation interpolation;
+  std::vector<float>           times;
+  std::vector<float>           values;
+};
+
+// A smooth curve per track: a rotation about a fixed axis or a vector.
+static void evaluateCurve(int track, bool isRotation, float time, float* pOut)
+{
+  float phase = track * 0.7f, frequency = 0.5f + (track % 7) * 0.3f;
+  if (isRotation)
+  {
+    float angle = sinf(frequency * time + phase);
+    float axis[3] = { sinf(phase), cosf(phase), 0.5f };
+    float length = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    float s = sinf(angle * 0.5f) / length;
+    pOut[0] = axis[0] * s;
+    pOut[1] = axis[1] * s;
+    pOut[2] = axis[2] * s;
+    pOut[3] = cosf(angle * 0.5f);
+  }
+  else
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      pOut[c] = (c + 1.0f) * sinf(frequency * time + phase + c);
+    }
+  }
+}
+
+static void makeTrack(int index, unsigned int& state, ReferenceTrack& track)
+{
+  static const AnimationClip::Interpolation INTERPOLATIONS[3] =
+  {
+    AnimationClip::INTERPOLATION_LINEAR,
+    AnimationClip::INTERPOLATION_HERMITE,
+    AnimationClip::INTERPOLATION_BEZIER
+  };
+  track.type = index % 2 == 0 ? AnimationClip::TRACK_ROTATION : AnimationClip::TRACK_VECTOR;
+  track.interpolation = INTERPOLATIONS[(index / 2) % 3];
+
+  // Two of three tracks are baked at 30 fps, the rest have reduced keys.
+  if (index % 3 != 2)
+  {
+    for (int k = 0; k < BAKED_KEYS; ++k)
+    {
+      track.times.push_back(k * DURATION / (BAKED_KEYS - 1));
+    }
+  }
+  else
+  {
+    float time = 0.0f;
+    while (time < DURATION)
+    {
+      track.times.push_back(time);
+      time += 0.1f + random(state) * 0.4f;
+    }
+    track.times.push_back(DURATION);
+  }
+
+  bool isRotation = track.type == AnimationClip::TRACK_ROTATION;
+  int components = isRotation ? 4 : 3;
+  size_t keys = track.times.size();
+  for (size_t k = 0; k < keys; ++k)
+  {
+    float value[4], before[4], after[4];
+    float step = 0.001f;
+    evaluateCurve(index, isRotation, track.times[k], value);
+    evaluateCurve(index, isRotation, track.times[k] - step, before);
+    evaluateCurve(index, isRotation, track.times[k] + step, after);
+    float previous = k > 0 ? track.times[k] - track.times[k - 1] : 0.0f;
+    float next = k + 1 < keys ? track.times[k + 1] - track.times[k] : 0.0f;
+
+    float in[4], out[4];
+    for (int c = 0; c < components; ++c)
+    {
+      float derivative = (after[c] - before[c]) / (2.0f * step);
+      if (track.interpolation == AnimationClip::INTERPOLATION_BEZIER)
+      {
+        in[c] = value[c] - derivative * previous / 3.0f;
+        out[c] = value[c] + derivative * next / 3.0f;
+      }
+      else
+      {
+        in[c] = derivative;
+        out[c] = derivative;
+      }
+    }
+
+    if (track.interpolation != AnimationClip::INTERPOLATION_LINEAR)
+    {
+      track.values.insert(track.values.end(), in, in + components);
+    }
+    track.values.insert(track.values.end(), value, value + components);
+    if (track.interpolation != AnimationClip::INTERPOLATION_LINEAR)
+    {
+      track.values.insert(track.values.end(), out, out + components);
+    }
+  }
+}
+
+static void sampleReference(const std::vector<ReferenceTrack>& tracks, float time,
+                            float* const pOut[4])
+{
+  for (size_t i = 0; i < tracks.size(); ++i)
+  {
+    const ReferenceTrack& track = tracks[i];
+    const std::vector<float>& times = track.times;
+    size_t key = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+    key = std::min(key == 0 ? 0 : key - 1, times.size() - 2);
+    float span = times[key + 1] - times[key];
+    float u = std::min(std::max((time - times[key]) / span, 0.0f), 1.0f), v = 1.0f - u;
+
+    bool isRotation = track.type == AnimationClip::TRACK_ROTATION;
+    int components = isRotation ? 4 : 3;
+    float result[4];
+    if (track.interpolation == AnimationClip::INTERPOLATION_LINEAR)
+    {
+      const float* p0 = &track.values[key * components];
+      for (int c = 0; c < components; ++c)
+      {
+        result[c] = v * p0[c] + u * p0[components + c];
+      }
+    }
+    else
+    {
+      // in, value, out per key.
+      const float* p0 = &track.values[key * 3 * components];
+      const float* p1 = p0 + 3 * components;
+      for (int c = 0; c < components; ++c)
+      {
+        float v0 = p0[components + c], v1 = p1[components + c];
+        if (track.interpolation == AnimationClip::INTERPOLATION_HERMITE)
+        {
+          result[c] = (2 * u * u * u - 3 * u * u + 1) * v0 + (u * u * u - 2 * u * u + u) * span *
+                      p0[2 * components + c] + (-2 * u * u * u + 3 * u * u) * v1 +
+                      (u * u * u - u * u) * span * p1[c];
+        }
+        else
+        {
+          result[c] = v * v * v * v0 + 3 * u * v * v * p0[2 * components + c] +
+                      3 * u * u * v * p1[c] + u * u * u * v1;
+        }
+      }
+    }
+
+    if (isRotation)
+    {
+      float length = sqrtf(result[0] * result[0] + result[1] * result[1] +
+                           result[2] * result[2] + result[3] * result[3]);
+      for (int c = 0; c < 4; ++c)
+      {
+        result[c] /= length;
+      }
+    }
+    for (int c = 0; c < components; ++c)
+    {
+      pOut[c][i] = result[c];
+    }
+  }
+}
+
+int main()
+{
+  std::vector<ReferenceTrack> tracks(TRACKS);
+  AnimationClip clip, quantized(true);
+  unsigned int state = 7;
+  size_t referenceBytes = 0;
+  for (int i = 0; i < TRACKS; ++i)
+  {
+    ReferenceTrack& track = tracks[i];
+    makeTrack(i, state, track);
+    clip.addTrack(track.type, track.interpolation, &track.times[0], track.times.size(),
+                  &track.values[0]);
+    quantized.addTrack(track.type, track.interpolation, &track.times[0], track.times.size(),
+                       &track.values[0]);
+    referenceBytes += (track.times.size() + track.values.size()) * sizeof(float);
+  }
+  printf("%d tracks, %u timelines, %.1f s\n", TRACKS, (unsigned int) clip.getTimelineCount(),
+         clip.getDuration());
+  printf("Memory: %u KB per track, %u KB shared times, %u KB quantized\n",
+         (unsigned int) (referenceBytes / 1024), (unsigned int) (clip.getMemoryUsage() / 1024),
+         (unsigned int) (quantized.getMemoryUsage() / 1024));
+
+  std::vector<float> output[3][4];
+  float* pOut[3][4];
+  for (int o = 0; o < 3; ++o)
+  {
+    for (int c = 0; c < 4; ++c)
+    {
+      output[o][c].assign(TRACKS, 0.0f);
+      pOut[o][c] = &output[o][c][0];
+    }
+  }
+
+  // Check against the reference while playing forward.
+  AnimationClip::Cursor cursor, quantizedCursor;
+  float error = 0.0f, quantizedError = 0.0f;
+  for (int frame = 0; frame <= FRAMES; ++frame)
+  {
+    float time = frame * DURATION / FRAMES;
+    sampleReference(tracks, time, pOut[0]);
+    clip.sample(time, cursor, pOut[1][0], pOut[1][1], pOut[1][2], pOut[1][3]);
+    quantized.sample(time, quantizedCursor, pOut[2][0], pOut[2][1], pOut[2][2], pOut[2][3]);
+    for (int i = 0; i < TRACKS; ++i)
+    {
+      int components = tracks[i].type == AnimationClip::TRACK_ROTATION ? 4 : 3;
+      for (int c = 0; c < components; ++c)
+      {
+        error = std::max(error, fabsf(output[1][c][i] - output[0][c][i]));
+        quantizedError = std::max(quantizedError, fabsf(output[2][c][i] - output[0][c][i]));
+      }
+    }
+  }
+  printf("Max error: %.2g, quantized %.2g\n\n", error, quantizedError);
+
+  std::vector<float> randomTimes(FRAMES);
+  for (int frame = 0; frame < FRAMES; ++frame)
+  {
+    randomTimes[frame] = random(state) * DURATION;
+  }
+
+  for (int mode = 0; mode < 4; ++mode)
+  {
+    static const char* NAMES[4] =
+    {
+      "binary search per track", "clip with cursor", "quantized clip with cursor",
+      "clip, random seeking"
+    };
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+      float time = frame * DURATION / FRAMES;
+      if (mode == 0)
+      {
+        sampleReference(tracks, time, pOut[0]);
+      }
+      else if (mode == 1)
+      {
+        clip.sample(time, cursor, pOut[1][0], pOut[1][1], pOut[1][2], pOut[1][3]);
+      }
+      else if (mode == 2)
+      {
+        quantized.sample(time, quantizedCursor, pOut[2][0], pOut[2][1], pOut[2][2], pOut[2][3]);
+      }
+      else
+      {
+        clip.sample(randomTimes[frame], cursor, pOut[1][0], pOut[1][1], pOut[1][2], pOut[1][3]);
+      }
+    }
+    double ms = elapsedMs(start);
+    printf("%-28s %8.0f tracks/ms\n", NAMES[mode], (double) TRACKS * FRAMES / ms);
+  }
+  return 0;
+}
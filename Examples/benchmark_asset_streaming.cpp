@@ -0,0 +1,227 @@
+/*
+ * @file benchmark_asset_streaming.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Streams a grid of asset files around a moving camera while a
+ * simulated frame loop runs. Priorities follow the camera distance,
+ * assets left behind are cancelled and every file is decoded and verified
+ * on the thread pool. Reports frame stalls, throughput and latency for
+ * asynchronous I/O and for blocking reads on the pool.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\AssetStreamer.h>
+#include <LiteCube\Core\ThreadPool.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Lite;
+
+static const int GRID = 16;
+static const float SPACING = 10.0f;
+static const float CANCEL_DISTANCE = 40.0f;
+static const double FRAME_WORK_MS = 2.0;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static String toString(const std::string& text)
+{
+  return String(text.begin(), text.end());
+}
+
+static std::string getPath(int index)
+{
+  char name[64];
+  sprintf(name, "benchmark_asset_%03d.bin", index);
+  return name;
+}
+
+/*
+ * Files hold a pseudo random payload followed by its checksum.
+ */
+static unsigned int checksum(const unsigned char* pData, size_t size)
+{
+  unsigned int hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash = (hash ^ pData[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static void writeFiles(int count, size_t size)
+{
+  std::vector<unsigned char> data(size + sizeof(unsigned int));
+  unsigned int state = 12345;
+  for (int i = 0; i < count; ++i)
+  {
+    for (size_t j = 0; j < size; ++j)
+    {
+      state = state * 1664525u + 1013904223u;
+      data[j] = (unsigned char) (state >> 24);
+    }
+    unsigned int hash = checksum(&data[0], size);
+    memcpy(&data[size], &hash, sizeof(hash));
+
+    FILE* pFile = fopen(getPath(i).c_str(), "wb");
+    fwrite(&data[0], 1, data.size(), pFile);
+    fclose(pFile);
+  }
+}
+
+/*
+ * Stand-in for decompression: verifies the checksum and strips it.
+ */
+static bool decode(std::vector<unsigned char>& data)
+{
+  if (data.size() < sizeof(unsigned int))
+  {
+    return false;
+  }
+  size_t size = data.size() - sizeof(unsigned int);
+  unsigned int hash;
+  memcpy(&hash, &data[size], sizeof(hash));
+  data.resize(size);
+  return checksum(data.empty() ? NULL : &data[0], size) == hash;
+}
+
+static void spin(double ms)
+{
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  while (elapsedMs(start) < ms)
+  {
+  }
+}
+
+static void run(const char* name, ThreadPool& pool, bool useAsyncIO, size_t fileSize)
+{
+  AssetStreamer streamer(&pool, AssetStreamer::DEFAULT_MAX_READS, useAsyncIO);
+  int count = GRID * GRID;
+  std::vector<AssetStreamer::RequestId> ids(count);
+  std::vector<int> states(count, 0);
+  int loaded = 0, failed = 0, cancelled = 0;
+
+  AssetStreamer::CompletionCallback callback =
+    [&](AssetStreamer::RequestId id, AssetStreamer::Status status, std::vector<unsigned char>& data) {
+      for (int i = 0; i < count; ++i)
+      {
+        if (ids[i] == id)
+        {
+          states[i] = 2;
+        }
+      }
+      if (status == AssetStreamer::STATUS_COMPLETE && data.size() == fileSize)
+      {
+        ++loaded;
+      }
+      else if (status == AssetStreamer::STATUS_CANCELLED)
+      {
+        ++cancelled;
+      }
+      else
+      {
+        ++failed;
+      }
+    };
+
+  // The camera flies along the x axis over the grid of assets.
+  float cameraX = 0.0f, cameraZ = GRID * SPACING * 0.5f;
+  for (int i = 0; i < count; ++i)
+  {
+    float dx = (i % GRID) * SPACING - cameraX, dz = (i / GRID) * SPACING - cameraZ;
+    ids[i] = streamer.request(toString(getPath(i)), -sqrtf(dx * dx + dz * dz), decode, callback);
+    states[i] = 1;
+  }
+
+  double maxUpdateMs = 0.0, sumUpdateMs = 0.0, maxFrameMs = 0.0;
+  size_t maxDepth = 0;
+  int frames = 0;
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  while (!streamer.isIdle())
+  {
+    std::chrono::high_resolution_clock::time_point frameStart =
+      std::chrono::high_resolution_clock::now();
+    cameraX += 5.0f;
+
+    for (int i = 0; i < count; ++i)
+    {
+      if (states[i] != 1)
+      {
+        continue;
+      }
+      float dx = (i % GRID) * SPACING - cameraX, dz = (i / GRID) * SPACING - cameraZ;
+      if (dx < -CANCEL_DISTANCE)
+      {
+        streamer.cancel(ids[i]);
+      }
+      else
+      {
+        streamer.reprioritize(ids[i], -sqrtf(dx * dx + dz * dz));
+      }
+    }
+
+    std::chrono::high_resolution_clock::time_point updateStart =
+      std::chrono::high_resolution_clock::now();
+    streamer.update();
+    double updateMs = elapsedMs(updateStart);
+    maxUpdateMs = updateMs > maxUpdateMs ? updateMs : maxUpdateMs;
+    sumUpdateMs += updateMs;
+
+    AssetStreamer::Metrics metrics;
+    streamer.getMetrics(metrics);
+    maxDepth = metrics.queueDepth > maxDepth ? metrics.queueDepth : maxDepth;
+
+    spin(FRAME_WORK_MS);
+    double frameMs = elapsedMs(frameStart);
+    maxFrameMs = frameMs > maxFrameMs ? frameMs : maxFrameMs;
+    ++frames;
+  }
+  double totalMs = elapsedMs(start);
+
+  AssetStreamer::Metrics metrics;
+  streamer.getMetrics(metrics);
+  printf("%s (%s)\n", name, metrics.isAsyncIO ? "asynchronous I/O" : "blocking reads on the pool");
+  printf("  %d frames in %.1f ms, frame max %.2f ms (work %.1f ms), update avg %.3f ms max %.3f ms\n",
+         frames, totalMs, maxFrameMs, FRAME_WORK_MS, sumUpdateMs / frames, maxUpdateMs);
+  printf("  loaded %d, cancelled %d, failed %d, max queue depth %u\n",
+         loaded, cancelled, failed, (unsigned int) maxDepth);
+  printf("  %.1f MB read, %.1f MB/s, latency avg %.1f ms max %.1f ms\n",
+         metrics.bytesRead / 1e6, metrics.bytesPerSecond / 1e6,
+         metrics.averageLatencyMs, metrics.maxLatencyMs);
+}
+
+int main(int argc, char** argv)
+{
+  size_t fileSize = (size_t) (argc > 1 ? atoi(argv[1]) : 256) * 1024;
+  int count = GRID * GRID;
+  writeFiles(count, fileSize);
+
+  ThreadPool pool(4);
+  printf("%d files of %u KB, %u pool threads\n", count, (unsigned int) (fileSize / 1024),
+         pool.getThreadCount());
+  run("Streaming", pool, true, fileSize);
+  run("Streaming", pool, false, fileSize);
+
+  for (int i = 0; i < count; ++i)
+  {
+    remove(getPath(i).c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * @file benchmark_broadphase.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures SweepAndPrune updates for moving bodies at several levels
+ * of motion coherence.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Physics\SweepAndPrune.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static float randomRange(float range)
+{
+  return (rand() / (float) RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+// Half size of a world in which every unit box overlaps about one other box.
+static float worldSizeFor(size_t count)
+{
+  return 2.0f * powf((float) count, 1.0f / 3.0f);
+}
+
+static void run(size_t count, float speed, ThreadPool* pPool)
+{
+  const float worldSize = worldSizeFor(count);
+  const float halfSize = 0.5f;
+  const int frames = 30;
+
+  std::vector<Vector3f> positions(count);
+  std::vector<Vector3f> velocities(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    positions[i] = Vector3f(randomRange(worldSize), randomRange(worldSize * 0.2f), randomRange(worldSize));
+    velocities[i] = Vector3f(randomRange(speed), randomRange(speed), randomRange(speed));
+  }
+
+  SweepAndPrune sap;
+  std::vector<unsigned int> proxies(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    Vector3f extent(halfSize, halfSize, halfSize);
+    proxies[i] = sap.addProxy(AABB(positions[i] - extent, positions[i] + extent));
+  }
+  sap.update(pPool);
+
+  size_t added = 0, removed = 0;
+  double totalMs = 0.0;
+  for (int f = 0; f < frames; ++f)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      positions[i] += velocities[i];
+      Vector3f extent(halfSize, halfSize, halfSize);
+      sap.updateProxy(proxies[i], AABB(positions[i] - extent, positions[i] + extent));
+    }
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    sap.update(pPool);
+    totalMs += elapsedMs(start);
+    added += sap.getAddedPairs().size();
+    removed += sap.getRemovedPairs().size();
+  }
+
+  printf("%7u bodies, speed %5.2f, %s: %8.3f ms/frame, %6u pairs, +%u/-%u per frame\n",
+         (unsigned int) count, speed, pPool != NULL ? "pool  " : "single",
+         totalMs / frames, (unsigned int) sap.getPairs().size(),
+         (unsigned int) (added / frames), (unsigned int) (removed / frames));
+}
+
+int main()
+{
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("Threads: %u\n", pool.getThreadCount());
+
+  const size_t counts[] = { 10000, 30000, 100000 };
+  const float speeds[] = { 0.01f, 0.1f, 1.0f };
+  for (int c = 0; c < 3; ++c)
+  {
+    for (int s = 0; s < 3; ++s)
+    {
+      run(counts[c], speeds[s], NULL);
+      run(counts[c], speeds[s], &pool);
+    }
+  }
+
+  // All pairs reference point for the smallest case.
+  size_t count = counts[0];
+  std::vector<AABB> boxes(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    float worldSize = worldSizeFor(count);
+    Vector3f p(randomRange(worldSize), randomRange(worldSize * 0.2f), randomRange(worldSize));
+    boxes[i] = AABB(p - Vector3f(0.5f, 0.5f, 0.5f), p + Vector3f(0.5f, 0.5f, 0.5f));
+  }
+
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  size_t pairs = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t j = i + 1; j < count; ++j)
+    {
+      pairs += boxes[i].intersects(boxes[j]) ? 1 : 0;
+    }
+  }
+  printf("%7u bodies, all pairs:    %8.3f ms/frame, %6u pairs\n",
+         (unsigned int) count, elapsedMs(start), (unsigned int) pairs);
+
+  return 0;
+}
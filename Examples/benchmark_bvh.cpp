@@ -0,0 +1,169 @@
+/*
+ * @file benchmark_bvh.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures BVH build time and ray throughput on a large mesh.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Geometry\BVH.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Builds a bumpy height field of size x size quads (2 triangles each).
+static void makeTerrain(int size, std::vector<Vector3f>& vertices,
+                        std::vector<unsigned int>& indices)
+{
+  vertices.reserve((size + 1) * (size + 1));
+  for (int z = 0; z <= size; ++z)
+  {
+    for (int x = 0; x <= size; ++x)
+    {
+      float h = 4.0f * sinf(x * 0.05f) * cosf(z * 0.07f) +
+                0.5f * sinf(x * 0.9f + z * 0.3f);
+      vertices.push_back(Vector3f((float) x, h, (float) z));
+    }
+  }
+
+  indices.reserve(size * size * 6);
+  for (int z = 0; z < size; ++z)
+  {
+    for (int x = 0; x < size; ++x)
+    {
+      unsigned int i = z * (size + 1) + x;
+      indices.push_back(i);
+      indices.push_back(i + size + 1);
+      indices.push_back(i + 1);
+      indices.push_back(i + 1);
+      indices.push_back(i + size + 1);
+      indices.push_back(i + size + 2);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int size = argc > 1 ? atoi(argv[1]) : 1024;
+  const int width = 1024;
+  const int height = 768;
+
+  std::vector<Vector3f> vertices;
+  std::vector<unsigned int> indices;
+  makeTerrain(size, vertices, indices);
+  size_t triangleCount = indices.size() / 3;
+
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("Triangles: %u, threads: %u\n", (unsigned int) triangleCount,
+         pool.getThreadCount());
+
+  BVH bvh;
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  bvh.build(&vertices[0], &indices[0], triangleCount, NULL);
+  printf("Build (1 thread):  %8.1f ms\n", elapsedMs(start));
+
+  start = std::chrono::high_resolution_clock::now();
+  bvh.build(&vertices[0], &indices[0], triangleCount, &pool);
+  printf("Build (pool):      %8.1f ms, %u nodes\n", elapsedMs(start),
+         (unsigned int) bvh.getNodeCount());
+
+  // Camera rays looking down onto the terrain from above its first
+  // quarter, in row-major pixel order. Every ray meets the ground plane
+  // within the terrain.
+  std::vector<Ray> rays(width * height);
+  Vector3f eye(size * 0.5f, size * 0.06f, size * 0.25f);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      Ray& ray = rays[y * width + x];
+      ray.origin = eye;
+      ray.direction = Vector3f((x - width * 0.5f) / width,
+                               -0.3f - (float) y / height,
+                               1.0f);
+      ray.tMin = 0.0f;
+      ray.tMax = 1e30f;
+    }
+  }
+
+  std::vector<RayHit> hits(rays.size());
+  double mrays = rays.size() / 1e6;
+
+  start = std::chrono::high_resolution_clock::now();
+  size_t hitCount = 0;
+  for (size_t i = 0; i < rays.size(); ++i)
+  {
+    hitCount += bvh.intersect(rays[i], hits[i]) ? 1 : 0;
+  }
+  printf("Closest, single:   %8.2f Mrays/s (%u hits)\n",
+         mrays / (elapsedMs(start) / 1000.0), (unsigned int) hitCount);
+  if (hitCount == 0)
+  {
+    printf("No ray hit the terrain, the figures would measure nothing.\n");
+    return 1;
+  }
+
+  start = std::chrono::high_resolution_clock::now();
+  bvh.intersect(&rays[0], &hits[0], rays.size(), NULL);
+  printf("Closest, packets:  %8.2f Mrays/s\n", mrays / (elapsedMs(start) / 1000.0));
+
+  start = std::chrono::high_resolution_clock::now();
+  bvh.intersect(&rays[0], &hits[0], rays.size(), &pool);
+  printf("Closest, pool:     %8.2f Mrays/s\n", mrays / (elapsedMs(start) / 1000.0));
+
+  // Shadow rays from the hit points towards a light.
+  Vector3f light(size * 0.5f, 200.0f, size * 0.5f);
+  std::vector<Ray> shadowRays;
+  shadowRays.reserve(rays.size());
+  for (size_t i = 0; i < rays.size(); ++i)
+  {
+    if (hits[i].triangle == BVH::INVALID_INDEX)
+    {
+      continue;
+    }
+    Ray ray;
+    ray.origin = rays[i].origin + rays[i].direction * hits[i].t;
+    ray.direction = light - ray.origin;
+    ray.tMin = 1e-3f;
+    ray.tMax = 1.0f;
+    shadowRays.push_back(ray);
+  }
+
+  if (!shadowRays.empty())
+  {
+    std::vector<unsigned char> occluded(shadowRays.size());
+    double mshadow = shadowRays.size() / 1e6;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < shadowRays.size(); ++i)
+    {
+      occluded[i] = bvh.occluded(shadowRays[i]);
+    }
+    printf("Any-hit, single:   %8.2f Mrays/s\n", mshadow / (elapsedMs(start) / 1000.0));
+
+    bool* pResults = new bool[shadowRays.size()];
+    start = std::chrono::high_resolution_clock::now();
+    bvh.occluded(&shadowRays[0], pResults, shadowRays.size(), &pool);
+    printf("Any-hit, pool:     %8.2f Mrays/s\n", mshadow / (elapsedMs(start) / 1000.0));
+    delete[] pResults;
+  }
+
+  return 0;
+}
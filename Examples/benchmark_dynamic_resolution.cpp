@@ -0,0 +1,143 @@
+/*
+ * @file benchmark_dynamic_resolution.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Drives DynamicResolution with synthetic frame times of a 1920x1080
+ * scene whose cost follows the rendered area and changes with the load of
+ * the scene, and reports missed frames, mean scale and resizes for a fixed
+ * full resolution and for the PID and hysteresis policies. Every run is
+ * played twice to check that the decisions repeat exactly. Also times the
+ * upscale of the render target to the output size.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Graphics\DynamicResolution.h>
+#include <LiteCube\Graphics\Image.h>
+#include <LiteCube\Graphics\ImageOps.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+using namespace Lite;
+
+static const int OUTPUT_WIDTH = 1920;
+static const int OUTPUT_HEIGHT = 1080;
+static const unsigned int FRAMES = 1200;
+
+// Load of the scene over time: heavy, heavier, then light.
+static float sceneLoad(unsigned int frame)
+{
+  return frame < 300 ? 1.0f : frame < 700 ? 1.6f : 0.6f;
+}
+
+// Fixed cost plus a cost per rendered pixel, with noise from the frame index.
+static float frameTime(unsigned int frame, int width, int height)
+{
+  unsigned int hash = (frame + 1) * 2654435761u;
+  hash ^= hash >> 15;
+  float noise = (hash & 0xFFFF) / 65535.0f - 0.5f;
+  float area = (float) width * height / (OUTPUT_WIDTH * OUTPUT_HEIGHT);
+  return 3.0f + 15.0f * sceneLoad(frame) * area + 1.5f * noise;
+}
+
+struct Result
+{
+  DynamicResolution::Stats stats;
+  double                   scaleSum;
+  unsigned int             settleFrame;  // Last resize while the load was heavier
+  unsigned int             hash;         // Of the render size of every frame
+};
+
+static void run(DynamicResolution::Policy policy, bool isFixed, Result& result)
+{
+  DynamicResolution resolution;
+  resolution.setOutputSize(OUTPUT_WIDTH, OUTPUT_HEIGHT);
+  resolution.setPolicy(policy);
+  resolution.setFrameTimeModel(frameTime);
+  if (isFixed)
+  {
+    resolution.setScaleRange(1.0f, 1.0f);
+  }
+
+  result.scaleSum = 0.0;
+  result.settleFrame = 0;
+  result.hash = 2166136261u;
+  int width = resolution.getRenderWidth();
+  for (unsigned int frame = 0; frame < FRAMES; ++frame)
+  {
+    resolution.beginFrame();
+    resolution.endFrame();
+    result.scaleSum += resolution.getScale();
+    if (resolution.getRenderWidth() != width && frame >= 300 && frame < 700)
+    {
+      result.settleFrame = frame - 300;
+    }
+    width = resolution.getRenderWidth();
+    result.hash = (result.hash ^ (unsigned int) width) * 16777619u;
+    result.hash = (result.hash ^ (unsigned int) resolution.getRenderHeight()) * 16777619u;
+  }
+  resolution.getStats(result.stats);
+}
+
+int main()
+{
+  printf("%u synthetic frames at %dx%d, target %.2f ms\n\n", FRAMES, OUTPUT_WIDTH,
+         OUTPUT_HEIGHT, 1000.0f / 60.0f);
+  printf("policy          missed   mean scale   down     up   settled   final size   repeats\n");
+
+  static const char* NAMES[3] = { "full size", "PID", "hysteresis" };
+  for (int i = 0; i < 3; ++i)
+  {
+    DynamicResolution::Policy policy =
+      i == 2 ? DynamicResolution::POLICY_HYSTERESIS : DynamicResolution::POLICY_PID;
+    Result first, second;
+    run(policy, i == 0, first);
+    run(policy, i == 0, second);
+
+    const DynamicResolution::Stats& stats = first.stats;
+    printf("  %-12s %6.1f%%   %10.3f %6u %6u %9u   %4dx%-5d   %s\n", NAMES[i],
+           100.0 * stats.overBudgetCount / stats.frameCount, first.scaleSum / FRAMES,
+           stats.decreaseCount, stats.increaseCount, first.settleFrame, stats.renderWidth,
+           stats.renderHeight, first.hash == second.hash ? "yes" : "NO");
+  }
+
+  // What the upscale in present() costs at a few render sizes.
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("\nUpscale to %dx%d with %s, %u threads   one thread         pool\n", OUTPUT_WIDTH,
+         OUTPUT_HEIGHT, ImageOps::getInstructionSet(), (unsigned int) pool.getThreadCount());
+  Image output(OUTPUT_WIDTH, OUTPUT_HEIGHT);
+  static const float SCALES[3] = { 0.5f, 0.75f, 0.9f };
+  for (int i = 0; i < 3; ++i)
+  {
+    DynamicResolution resolution;
+    resolution.setOutputSize(OUTPUT_WIDTH, OUTPUT_HEIGHT);
+    resolution.setScaleRange(SCALES[i], SCALES[i]);
+    Image& target = resolution.getRenderTarget();
+    target.fill(0xFF336699);
+
+    double singleMs = 1e9, parallelMs = 1e9;
+    for (int repeat = 0; repeat < 5; ++repeat)
+    {
+      for (int threaded = 0; threaded < 2; ++threaded)
+      {
+        std::chrono::high_resolution_clock::time_point start =
+          std::chrono::high_resolution_clock::now();
+        ImageOps::scale(target, output, ImageOps::FILTER_BILINEAR, threaded ? &pool : NULL);
+        double ms = std::chrono::duration<double, std::milli>(
+          std::chrono::high_resolution_clock::now() - start).count();
+        double& best = threaded ? parallelMs : singleMs;
+        best = std::min(best, ms);
+      }
+    }
+    printf("  scale %.2f (%4dx%-4d)                    %7.2f ms   %7.2f ms\n", SCALES[i],
+           target.getWidth(), target.getHeight(), singleMs, parallelMs);
+  }
+  return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * @file benchmark_fixed_step.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Exercises FixedStepLoop and TransformBuffer:
+ *  - steps that get slower than real time for a while, on a synthetic
+ *    clock, with and without the catch-up limit,
+ *  - a body moving at constant speed simulated at 30 Hz and shown at
+ *    144 Hz, with and without interpolation,
+ *  - interpolation of 100000 transforms with Quaternion::nlerp() against
+ *    TransformBuffer on one thread and on the pool,
+ *  - half a second with the simulation on its own thread, checking that
+ *    the rendered snapshots are never torn and never go back in time.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\FixedStepLoop.h>
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Core\TransformBuffer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/*
+ * 600 frames on a synthetic clock. Rendering costs 4 ms, steps cost 6 ms
+ * except for steps 200 to 320, which cost 25 ms, more than the 16.7 ms they
+ * simulate.
+ */
+static void runSpike(bool isCapped)
+{
+  double clock = 0.0, worstFrame = 0.0;
+  unsigned int stepIndex = 0, frames = 0;
+  unsigned int hash = 2166136261u;
+
+  FixedStepLoop loop;
+  loop.setTimeSource([&clock]() { return clock; });
+  if (!isCapped)
+  {
+    loop.setMaxSteps(0xFFFFFFFFu);
+    loop.setMaxUpdateTime(1e9);
+  }
+  loop.setStepFunction([&](double time, float)
+  {
+    clock += stepIndex >= 200 && stepIndex < 320 ? 0.025 : 0.006;
+    ++stepIndex;
+    hash = (hash ^ (unsigned int) (time * 1e6)) * 16777619u;
+  });
+  loop.setRenderFunction([&](double) { clock += 0.004; });
+
+  double frameStart = 0.0;
+  loop.run([&]() -> bool
+  {
+    worstFrame = std::max(worstFrame, clock - frameStart);
+    frameStart = clock;
+    return frames++ < 600;
+  });
+
+  FixedStepLoop::Stats stats;
+  loop.getStats(stats);
+  printf("  %-10s %8.1f ms %10u %12.2f s %11.2f s   %08x\n", isCapped ? "capped" : "uncapped",
+         worstFrame * 1000.0, stats.maxUpdateSteps, stats.droppedTime, clock, hash);
+}
+
+/*
+ * A body moving at 1 unit per second, simulated at 30 Hz and rendered at
+ * 144 Hz. Reports how far the distance moved per frame strays from the
+ * ideal one, relative to it.
+ */
+static void runSmoothness(bool isInterpolated)
+{
+  double clock = 0.0;
+  TransformBuffer buffer;
+  buffer.resize(1);
+
+  FixedStepLoop loop;
+  loop.setStep(1.0 / 30.0);
+  loop.setTimeSource([&clock]() { return clock; });
+  loop.setStepFunction([&](double time, float)
+  {
+    buffer.getPositions()[0] = Vector3f((float) time, 0.0f, 0.0f);
+    buffer.publish(time);
+  });
+
+  std::vector<float> shown;
+  loop.setRenderFunction([&](double time)
+  {
+    buffer.acquire();
+    Vector3f position;
+    buffer.interpolate(isInterpolated ? time : buffer.getCurrentTime(), &position, NULL);
+    shown.push_back(position.x);
+    clock += 1.0 / 144.0;
+  });
+
+  unsigned int frames = 0;
+  loop.run([&frames]() { return frames++ < 1440; });
+
+  double ideal = 1.0 / 144.0, worst = 0.0, sum = 0.0;
+  for (size_t i = 145; i < shown.size(); ++i)
+  {
+    double error = fabs((shown[i] - shown[i - 1]) - ideal) / ideal;
+    worst = std::max(worst, error);
+    sum += error;
+  }
+  printf("  %-14s %12.1f%% %12.1f%%\n", isInterpolated ? "interpolated" : "latest step",
+         100.0 * sum / (shown.size() - 145), 100.0 * worst);
+}
+
+int main()
+{
+  printf("Steps slower than real time, 600 frames\n");
+  printf("  loop         worst frame  max steps       dropped   clock time   steps hash\n");
+  runSpike(false);
+  runSpike(true);
+  runSpike(true);
+
+  printf("\nMotion at 30 Hz shown at 144 Hz   mean error    max error\n");
+  runSmoothness(false);
+  runSmoothness(true);
+
+  // Interpolation throughput.
+  static const size_t COUNT = 100000;
+  std::vector<Vector3f> fromPositions(COUNT), toPositions(COUNT), positions(COUNT);
+  std::vector<Quaternion> fromOrientations(COUNT), toOrientations(COUNT), orientations(COUNT);
+  std::vector<Quaternion> expected(COUNT);
+  for (size_t i = 0; i < COUNT; ++i)
+  {
+    float angle = i * 0.001f;
+    fromPositions[i] = Vector3f(angle, 2.0f * angle, -angle);
+    toPositions[i] = Vector3f(angle + 0.1f, 2.0f * angle, 1.0f - angle);
+    fromOrientations[i] = Quaternion(Vector3f(0.0f, 1.0f, 0.0f), angle);
+    toOrientations[i] = Quaternion(Vector3f(0.0f, 1.0f, 0.0f), angle + 0.05f);
+    if (i % 3 == 0)
+    {
+      // The same rotation with the opposite sign, taking the shorter path.
+      Quaternion& q = toOrientations[i];
+      q = Quaternion(-q.x, -q.y, -q.z, -q.w);
+    }
+  }
+
+  ThreadPool& pool = ThreadPool::getDefault();
+  TransformBuffer buffer;
+  buffer.resize(COUNT);
+  std::copy(fromPositions.begin(), fromPositions.end(), buffer.getPositions());
+  std::copy(fromOrientations.begin(), fromOrientations.end(), buffer.getOrientations());
+  buffer.publish(0.0);
+  buffer.acquire();
+  std::copy(toPositions.begin(), toPositions.end(), buffer.getPositions());
+  std::copy(toOrientations.begin(), toOrientations.end(), buffer.getOrientations());
+  buffer.publish(1.0);
+  buffer.acquire();
+
+  double referenceMs = 1e9, singleMs = 1e9, parallelMs = 1e9;
+  for (int run = 0; run < 5; ++run)
+  {
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+      positions[i] = fromPositions[i] + 0.3f * (toPositions[i] - fromPositions[i]);
+      expected[i] = Quaternion::nlerp(fromOrientations[i], toOrientations[i], 0.3f);
+    }
+    referenceMs = std::min(referenceMs, elapsedMs(start));
+
+    start = std::chrono::high_resolution_clock::now();
+    buffer.interpolate(0.3, &positions[0], &orientations[0]);
+    singleMs = std::min(singleMs, elapsedMs(start));
+
+    start = std::chrono::high_resolution_clock::now();
+    buffer.interpolate(0.3, &positions[0], &orientations[0], &pool);
+    parallelMs = std::min(parallelMs, elapsedMs(start));
+  }
+
+  float error = 0.0f;
+  for (size_t i = 0; i < COUNT; ++i)
+  {
+    error = std::max(error, fabsf(orientations[i].x - expected[i].x));
+    error = std::max(error, fabsf(orientations[i].y - expected[i].y));
+    error = std::max(error, fabsf(orientations[i].z - expected[i].z));
+    error = std::max(error, fabsf(orientations[i].w - expected[i].w));
+  }
+  printf("\nInterpolate %u transforms   nlerp loop   one thread         pool\n",
+         (unsigned int) COUNT);
+  printf("                           %7.3f ms   %7.3f ms   %7.3f ms   max error %g\n",
+         referenceMs, singleMs, parallelMs, error);
+
+  // Simulation on its own thread against the clock.
+  static const size_t BODIES = 1000;
+  TransformBuffer shared;
+  shared.resize(BODIES);
+  FixedStepLoop loop;
+  loop.setStep(1.0 / 120.0);
+  loop.setStepFunction([&shared](double time, float)
+  {
+    Vector3f* pPositions = shared.getPositions();
+    for (size_t i = 0; i < BODIES; ++i)
+    {
+      pPositions[i] = Vector3f((float) time, (float) i, 0.0f);
+    }
+    shared.publish(time);
+  });
+
+  unsigned int torn = 0, backwards = 0;
+  float last = -1.0f;
+  std::vector<Vector3f> rendered(BODIES);
+  loop.setRenderFunction([&](double time)
+  {
+    shared.acquire();
+    shared.interpolate(time, &rendered[0], NULL);
+    for (size_t i = 1; i < BODIES; ++i)
+    {
+      torn += rendered[i].x != rendered[0].x ? 1 : 0;
+    }
+    backwards += rendered[0].x < last - 1e-5f ? 1 : 0;
+    last = rendered[0].x;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  });
+
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+  loop.run([&start]() { return elapsedMs(start) < 500.0; }, true);
+
+  FixedStepLoop::Stats stats;
+  loop.getStats(stats);
+  printf("\nSeparate threads for 500 ms at 120 Hz: %llu steps, %llu frames, %u torn, "
+         "%u backwards\n", stats.stepCount, stats.frameCount, torn, backwards);
+  return 0;
+}
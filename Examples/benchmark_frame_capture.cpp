@@ -0,0 +1,244 @@
+/*
+ * @file benchmark_frame_capture.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Records synthetic 1080p frames with FrameCapture and compares the
+ * cost on the frame thread against encoding and writing synchronously.
+ * A paced run at 60 frames per second and an unpaced run, which makes the
+ * pipeline fall behind, report dropped and downsampled frames. The file is
+ * read back and every frame checked against the generated image.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\FrameCapture.h>
+#include <LiteCube\Core\LzCompressor.h>
+#include <LiteCube\Core\ThreadPool.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+using namespace Lite;
+
+static const int WIDTH = 1920;
+static const int HEIGHT = 1080;
+static const double FRAME_MS = 1000.0 / 60.0;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static String toString(const char* text)
+{
+  return String(text, text + strlen(text));
+}
+
+/*
+ * A user interface like image: a gradient background, flat panels, a
+ * moving box and a noisy region standing in for textured 3D content.
+ */
+static void render(int frame, std::vector<unsigned char>& pixels)
+{
+  unsigned int state = 777 + frame;
+  for (int y = 0; y < HEIGHT; ++y)
+  {
+    unsigned char* pRow = &pixels[(size_t) y * WIDTH * 4];
+    for (int x = 0; x < WIDTH; ++x)
+    {
+      unsigned char* p = pRow + x * 4;
+      p[0] = (unsigned char) (x / 8);
+      p[1] = (unsigned char) (y / 5);
+      p[2] = 96;
+      p[3] = 255;
+
+      if (x < 300 || y > HEIGHT - 120)
+      {
+        p[0] = p[1] = p[2] = 40;
+      }
+      if (x >= 1200 && x < 1600 && y >= 200 && y < 600)
+      {
+        state = state * 1664525u + 1013904223u;
+        p[0] = (unsigned char) (state >> 24);
+        p[1] = (unsigned char) (p[1] + (state >> 28));
+      }
+      int boxX = (frame * 7) % (WIDTH - 200);
+      if (x >= boxX && x < boxX + 200 && y >= 700 && y < 900)
+      {
+        p[0] = 20;
+        p[1] = 200;
+        p[2] = 240;
+      }
+    }
+  }
+}
+
+static void spin(double ms)
+{
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  while (elapsedMs(start) < ms)
+  {
+  }
+}
+
+/*
+ * Runs the frame loop and prints the cost seen by the frame thread.
+ */
+static void record(const char* name, const char* path, ThreadPool& pool, int frames,
+                   size_t budget, bool isPaced, std::vector<unsigned char>* pFrames)
+{
+  FrameCapture capture;
+  capture.open(toString(path), WIDTH, HEIGHT, budget, &pool);
+
+  double sumMs = 0.0, maxMs = 0.0;
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < frames; ++i)
+  {
+    std::chrono::high_resolution_clock::time_point frameStart =
+      std::chrono::high_resolution_clock::now();
+    capture.submitFrame(&pFrames[i % 8][0], WIDTH * 4);
+    double ms = elapsedMs(frameStart);
+    sumMs += ms;
+    maxMs = ms > maxMs ? ms : maxMs;
+
+    if (isPaced)
+    {
+      spin(FRAME_MS - elapsedMs(frameStart));
+    }
+  }
+  double loopMs = elapsedMs(start);
+
+  FrameCapture::Stats stats;
+  capture.getStats(stats);
+  capture.close();
+  double totalMs = elapsedMs(start);
+
+  printf("%s, budget %u MB (%u buffers)\n", name, (unsigned int) (budget >> 20),
+         (unsigned int) stats.bufferCount);
+  printf("  frame thread: avg %.2f ms, max %.2f ms per frame, loop %.0f ms, flush %.0f ms\n",
+         sumMs / frames, maxMs, loopMs, totalMs - loopMs);
+  printf("  submitted %u, written %u, downsampled %u, dropped %u, memory %.0f MB\n",
+         (unsigned int) stats.framesSubmitted, (unsigned int) stats.framesWritten,
+         (unsigned int) stats.framesDownsampled, (unsigned int) stats.framesDropped,
+         stats.memoryUsed / 1e6);
+  printf("  %.1f MB -> %.1f MB (%.1fx), encode %.2f ms per frame\n",
+         stats.bytesCaptured / 1e6, stats.bytesWritten / 1e6,
+         (double) stats.bytesCaptured / stats.bytesWritten, stats.averageEncodeMs);
+}
+
+/*
+ * Decode every frame of a capture and compare it with the source images.
+ */
+static bool verify(const char* path, std::vector<unsigned char>* pFrames)
+{
+  std::ifstream file(path, std::ios::binary);
+  FrameCapture::FileHeader fileHeader;
+  file.read((char*) &fileHeader, sizeof(fileHeader));
+  if (!file || memcmp(fileHeader.magic, "LCAP", 4) != 0)
+  {
+    return false;
+  }
+
+  std::vector<unsigned char> data, pixels;
+  FrameCapture::FrameHeader header;
+  int frames = 0, exact = 0;
+  while (file.read((char*) &header, sizeof(header)))
+  {
+    data.resize(header.compressedSize);
+    file.read((char*) &data[0], data.size());
+    if (!FrameCapture::decodeFrame(header, &data[0], pixels))
+    {
+      return false;
+    }
+
+    const std::vector<unsigned char>& source = pFrames[header.index % 8];
+    bool isDownsampled = (header.flags & FrameCapture::FRAME_DOWNSAMPLED) != 0;
+    if (!isDownsampled)
+    {
+      if (pixels != source)
+      {
+        return false;
+      }
+      ++exact;
+    }
+    else
+    {
+      // Rounding of the averaging differs by at most one step per level.
+      for (unsigned int y = 0; y < header.height; ++y)
+      {
+        for (unsigned int x = 0; x < header.width * 4; ++x)
+        {
+          size_t s = (size_t) 2 * y * WIDTH * 4 + (x / 4) * 8 + x % 4;
+          int sum = source[s] + source[s + 4] + source[s + WIDTH * 4] + source[s + WIDTH * 4 + 4];
+          int difference = pixels[(size_t) y * header.width * 4 + x] - (sum + 2) / 4;
+          if (difference < -2 || difference > 2)
+          {
+            return false;
+          }
+        }
+      }
+    }
+    ++frames;
+  }
+  printf("  verified %d frames (%d full resolution)\n", frames, exact);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  int frames = argc > 1 ? atoi(argv[1]) : 120;
+  std::vector<unsigned char> sources[8];
+  for (int i = 0; i < 8; ++i)
+  {
+    sources[i].resize((size_t) WIDTH * HEIGHT * 4);
+    render(i, sources[i]);
+  }
+
+  ThreadPool pool(4);
+  printf("%dx%d, %d frames, %u pool threads\n", WIDTH, HEIGHT, frames, pool.getThreadCount());
+
+  // Reference: compressing and writing on the frame thread, without the
+  // delta filter.
+  {
+    std::vector<unsigned char> copy(sources[0].size());
+    std::vector<unsigned char> compressed(LzCompressor::getMaxCompressedSize(copy.size()));
+    LzCompressor compressor;
+    std::ofstream file("benchmark_capture_sync.bin", std::ios::binary);
+    size_t bytes = 0;
+    int count = frames < 30 ? frames : 30;
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+      memcpy(&copy[0], &sources[i % 8][0], copy.size());
+      size_t size = compressor.compress(&copy[0], copy.size(), &compressed[0]);
+      file.write((const char*) &compressed[0], size);
+      bytes += size;
+    }
+    double ms = elapsedMs(start) / count;
+    printf("Synchronous capture: %.2f ms per frame (%.1fx), %.0f fps at most\n",
+           ms, (double) copy.size() * count / bytes, 1000.0 / ms);
+  }
+  remove("benchmark_capture_sync.bin");
+
+  bool isValid = true;
+  record("Paced at 60 fps", "benchmark_capture.lcap", pool, frames, 256 << 20, true, sources);
+  isValid = verify("benchmark_capture.lcap", sources) && isValid;
+  record("Unpaced", "benchmark_capture.lcap", pool, frames, 64 << 20, false, sources);
+  isValid = verify("benchmark_capture.lcap", sources) && isValid;
+  remove("benchmark_capture.lcap");
+
+  printf("Decoded frames match: %s\n", isValid ? "yes" : "NO");
+  return isValid ? 0 : 1;
+}
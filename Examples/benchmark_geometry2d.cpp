@@ -0,0 +1,297 @@
+/*
+ * @file benchmark_geometry2d.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Runs the Geometry2D kernels on 1M point inputs. Compares the
+ * convex hull of points in a disc and on an integer grid against a plain
+ * float monotone chain, on one thread and on the pool. Triangulates a
+ * star shaped polygon of 1M vertices with the sweep line and smaller ones
+ * with both ear clipping and the sweep line, clips the large one with a
+ * hexagon and tests 1M points against a 256 vertex polygon one at a time
+ * and in batches. Hulls must match on one thread and on the pool,
+ * triangles must cover the polygon area, and batches must agree with the
+ * exact test, also for points lying on the edges.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Geometry\Geometry2D.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Lite;
+
+static const size_t POINTS = 1000000;
+static const int RUNS = 3;
+static const double PI = 3.14159265358979323846;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static unsigned int g_state = 1;
+
+static float random(float minimum, float maximum)
+{
+  g_state = g_state * 1664525u + 1013904223u;
+  return minimum + (maximum - minimum) * ((g_state >> 8) / 16777216.0f);
+}
+
+static bool isBefore(const Vector2f& a, const Vector2f& b)
+{
+  return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+static float cross(const Vector2f& a, const Vector2f& b, const Vector2f& c)
+{
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// The monotone chain as usually written, float cross products and no filter.
+static void plainHull(std::vector<Vector2f> points, std::vector<Vector2f>& hull)
+{
+  std::sort(points.begin(), points.end(), isBefore);
+  hull.assign(2 * points.size(), Vector2f());
+  size_t size = 0;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    while (size >= 2 && cross(hull[size - 2], hull[size - 1], points[i]) <= 0.0f)
+    {
+      --size;
+    }
+    hull[size++] = points[i];
+  }
+  for (size_t i = points.size() - 1, lower = size + 1; i-- > 0;)
+  {
+    while (size >= lower && cross(hull[size - 2], hull[size - 1], points[i]) <= 0.0f)
+    {
+      --size;
+    }
+    hull[size++] = points[i];
+  }
+  hull.resize(size - 1);
+}
+
+// Vertices at increasing angles around the origin never cross.
+static void makeStar(size_t count, float radius, std::vector<Vector2f>& polygon)
+{
+  polygon.resize(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    double angle = 2.0 * PI * (i + random(0.0f, 0.9f)) / count;
+    float distance = radius * random(0.5f, 1.0f);
+    polygon[i] = Vector2f((float) (cos(angle) * distance), (float) (sin(angle) * distance));
+  }
+}
+
+static bool isSameHull(const std::vector<Vector2f>& a, const std::vector<Vector2f>& b)
+{
+  if (a.size() != b.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    if (a[i].x != b[i].x || a[i].y != b[i].y)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Relative difference between the area of the triangles and of the polygon.
+static double getAreaError(const std::vector<Vector2f>& polygon,
+                           const std::vector<unsigned int>& indices)
+{
+  double area = 0.0;
+  for (size_t i = 0; i < indices.size(); i += 3)
+  {
+    Vector2f triangle[3] = { polygon[indices[i]], polygon[indices[i + 1]],
+                             polygon[indices[i + 2]] };
+    area += Geometry2D::getSignedArea(triangle, 3);
+  }
+  double expected = fabs(Geometry2D::getSignedArea(&polygon[0], polygon.size()));
+  return fabs(area - expected) / expected;
+}
+
+int main()
+{
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("Kernels: %s, %u threads\n\n", Geometry2D::getInstructionSet(), pool.getThreadCount());
+
+  // Convex hulls.
+  std::vector<Vector2f> disc(POINTS), grid(POINTS);
+  for (size_t i = 0; i < POINTS; ++i)
+  {
+    float angle = random(0.0f, 2.0f * (float) PI), distance = sqrtf(random(0.0f, 1.0f));
+    disc[i] = Vector2f(cosf(angle) * distance * 1000.0f, sinf(angle) * distance * 1000.0f);
+    grid[i] = Vector2f(floorf(random(0.0f, 64.0f)), floorf(random(0.0f, 64.0f)));
+  }
+
+  printf("Convex hull of 1M points       plain float   one thread         pool   hull\n");
+  const char* hullNames[2] = { "disc", "64x64 grid" };
+  std::vector<Vector2f>* hullInputs[2] = { &disc, &grid };
+  for (int set = 0; set < 2; ++set)
+  {
+    const std::vector<Vector2f>& points = *hullInputs[set];
+    std::vector<Vector2f> hulls[3];
+    double best[3] = { 1e30, 1e30, 1e30 };
+    for (int run = 0; run < RUNS; ++run)
+    {
+      for (int variant = 0; variant < 3; ++variant)
+      {
+        std::chrono::high_resolution_clock::time_point start =
+          std::chrono::high_resolution_clock::now();
+        if (variant == 0)
+        {
+          plainHull(points, hulls[0]);
+        }
+        else
+        {
+          Geometry2D::convexHull(&points[0], points.size(), hulls[variant],
+                                 variant == 2 ? &pool : NULL);
+        }
+        best[variant] = std::min(best[variant], elapsedMs(start));
+      }
+    }
+    printf("  %-26s %8.2f ms  %8.2f ms  %8.2f ms   %u points%s\n", hullNames[set], best[0],
+           best[1], best[2], (unsigned int) hulls[1].size(),
+           isSameHull(hulls[1], hulls[2]) && isSameHull(hulls[0], hulls[1]) ? "" :
+           "  MISMATCH");
+  }
+
+  // Triangulation.
+  printf("\nTriangulation                  ear clipping  sweep line         area error\n");
+  size_t sizes[3] = { 64, 1000, POINTS };
+  for (int s = 0; s < 3; ++s)
+  {
+    std::vector<Vector2f> polygon;
+    makeStar(sizes[s], 1000.0f, polygon);
+    if (s == 1)
+    {
+      // Clockwise input.
+      std::reverse(polygon.begin(), polygon.end());
+    }
+
+    int runs = sizes[s] < 10000 ? 200 : 1;
+    std::vector<unsigned int> ears, monotone;
+    double earMs = 0.0, monotoneMs = 0.0;
+    bool isEarDone = true, isMonotoneDone = true;
+    std::chrono::high_resolution_clock::time_point start;
+    if (sizes[s] <= 1000)
+    {
+      start = std::chrono::high_resolution_clock::now();
+      for (int run = 0; run < runs; ++run)
+      {
+        isEarDone = Geometry2D::triangulateEars(&polygon[0], polygon.size(), ears);
+      }
+      earMs = elapsedMs(start) / runs;
+    }
+    start = std::chrono::high_resolution_clock::now();
+    for (int run = 0; run < runs; ++run)
+    {
+      isMonotoneDone = Geometry2D::triangulateMonotone(&polygon[0], polygon.size(), monotone);
+    }
+    monotoneMs = elapsedMs(start) / runs;
+
+    char earText[32] = "        -";
+    if (!ears.empty())
+    {
+      sprintf(earText, "%8.3f ms", earMs);
+    }
+    printf("  %7u vertices %s  %12s  %8.3f ms  %9.2e%s%s\n", (unsigned int) sizes[s],
+           s == 1 ? "(cw)" : "    ", earText, monotoneMs, getAreaError(polygon, monotone),
+           ears.empty() || getAreaError(polygon, ears) < 1e-9 ? "" : "  EARS WRONG",
+           isEarDone && isMonotoneDone && monotone.size() == (sizes[s] - 2) * 3 ? "" :
+           "  FAILED");
+  }
+
+  // Clipping.
+  std::vector<Vector2f> star, clipped;
+  makeStar(POINTS, 1000.0f, star);
+  Vector2f hexagon[6];
+  for (int k = 0; k < 6; ++k)
+  {
+    hexagon[k] = Vector2f(600.0f * (float) cos(k * PI / 3.0), 600.0f * (float) sin(k * PI / 3.0));
+  }
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+  Geometry2D::clip(&star[0], star.size(), hexagon, 6, clipped);
+  double clipMs = elapsedMs(start);
+  printf("\nClip 1M vertices by a hexagon  %8.2f ms, %u vertices left, area %.0f of %.0f\n",
+         clipMs, (unsigned int) clipped.size(), Geometry2D::getSignedArea(&clipped[0],
+         clipped.size()), Geometry2D::getSignedArea(hexagon, 6));
+
+  // Point in polygon, in a random polygon and on the edges of an integer one.
+  printf("\nPoint in polygon, 1M points     one by one   batch        pool     inside\n");
+  std::vector<Vector2f> polygons[2];
+  makeStar(256, 1000.0f, polygons[0]);
+  for (int k = 0; k < 256; ++k)
+  {
+    float radius = k % 2 == 0 ? 64.0f : 32.0f;
+    polygons[1].push_back(Vector2f(floorf(radius * (float) cos(k * PI / 128.0)),
+                                   floorf(radius * (float) sin(k * PI / 128.0))));
+  }
+  std::vector<Vector2f> queries[2];
+  queries[0].resize(POINTS);
+  queries[1].resize(POINTS);
+  for (size_t i = 0; i < POINTS; ++i)
+  {
+    queries[0][i] = Vector2f(random(-1100.0f, 1100.0f), random(-1100.0f, 1100.0f));
+    queries[1][i] = Vector2f(floorf(random(-70.0f, 70.0f)), floorf(random(-70.0f, 70.0f)));
+  }
+
+  const char* pipNames[2] = { "random", "integer grid" };
+  for (int set = 0; set < 2; ++set)
+  {
+    const std::vector<Vector2f>& polygon = polygons[set];
+    const std::vector<Vector2f>& points = queries[set];
+    std::vector<unsigned char> results[3];
+    double times[3];
+    for (int variant = 0; variant < 3; ++variant)
+    {
+      results[variant].resize(POINTS);
+      start = std::chrono::high_resolution_clock::now();
+      if (variant == 0)
+      {
+        for (size_t i = 0; i < POINTS; ++i)
+        {
+          results[0][i] = Geometry2D::pointInPolygon(&polygon[0], polygon.size(), points[i]) ?
+                          1 : 0;
+        }
+      }
+      else
+      {
+        Geometry2D::pointsInPolygon(&polygon[0], polygon.size(), &points[0], POINTS,
+                                    &results[variant][0], variant == 2 ? &pool : NULL);
+      }
+      times[variant] = elapsedMs(start);
+    }
+
+    size_t inside = 0, mismatches = 0;
+    for (size_t i = 0; i < POINTS; ++i)
+    {
+      inside += results[0][i];
+      mismatches += results[0][i] != results[1][i] || results[0][i] != results[2][i] ? 1 : 0;
+    }
+    printf("  %-26s %8.2f ms  %8.2f ms  %8.2f ms   %5.1f%%", pipNames[set], times[0], times[1],
+           times[2], 100.0 * inside / POINTS);
+    if (mismatches != 0)
+    {
+      printf("  %u MISMATCHES", (unsigned int) mismatches);
+    }
+    printf("\n");
+  }
+  return 0;
+}
@@ -0,0 +1,292 @@
+/*
+ * @file benchmark_image_ops.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Scales a 1920x1080 image to 3840x2160 and back with the nearest,
+ * bilinear and box filters and reports megapixels written per second for
+ * per-pixel floating point loops and for ImageOps on one thread and on the
+ * pool. Also times the red and blue swap and the premultiplied alpha
+ * conversions on a 4K image. ImageOps must stay within a step of the float
+ * loops, and give identical images on one thread and on the pool. Small
+ * targets down to one pixel are checked against the float loops too, from
+ * odd source sizes where the box filter spans the whole row.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Graphics\Image.h>
+#include <LiteCube\Graphics\ImageOps.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static const int RUNS = 3;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Gradients, a checkerboard and noise, so that every filter has work to do.
+static void makeImage(Image& image)
+{
+  unsigned int state = 1;
+  for (int y = 0; y < image.getHeight(); ++y)
+  {
+    unsigned int* pRow = image.getRow(y);
+    for (int x = 0; x < image.getWidth(); ++x)
+    {
+      state = state * 1664525u + 1013904223u;
+      unsigned int checker = ((x / 7) ^ (y / 5)) & 1 ? 60 : 0;
+      unsigned int red = (x * 255 / image.getWidth() + checker) & 0xFF;
+      unsigned int green = (y * 255 / image.getHeight()) & 0xFF;
+      unsigned int blue = (state >> 24) & 0xFF;
+      unsigned int alpha = 128 + ((x + y) & 127);
+      pRow[x] = alpha << 24 | red << 16 | green << 8 | blue;
+    }
+  }
+}
+
+static float channel(const Image& image, int x, int y, int shift)
+{
+  x = std::min(std::max(x, 0), image.getWidth() - 1);
+  y = std::min(std::max(y, 0), image.getHeight() - 1);
+  return (float) ((image.getRow(y)[x] >> shift) & 0xFF);
+}
+
+// Scaling as it was done before, one pixel at a time in floating point.
+static void scaleReference(const Image& source, Image& target, ImageOps::Filter filter)
+{
+  float scaleX = (float) source.getWidth() / target.getWidth();
+  float scaleY = (float) source.getHeight() / target.getHeight();
+  for (int y = 0; y < target.getHeight(); ++y)
+  {
+    unsigned int* pRow = target.getRow(y);
+    for (int x = 0; x < target.getWidth(); ++x)
+    {
+      float u = (x + 0.5f) * scaleX, v = (y + 0.5f) * scaleY;
+      unsigned int result = 0;
+      for (int shift = 0; shift < 32; shift += 8)
+      {
+        float value;
+        if (filter == ImageOps::FILTER_NEAREST)
+        {
+          value = channel(source, (int) u, (int) v, shift);
+        }
+        else if (filter == ImageOps::FILTER_BILINEAR)
+        {
+          float fu = std::max(u - 0.5f, 0.0f), fv = std::max(v - 0.5f, 0.0f);
+          int x0 = (int) fu, y0 = (int) fv;
+          float s = fu - x0, t = fv - y0;
+          value = (1 - t) * ((1 - s) * channel(source, x0, y0, shift) +
+                             s * channel(source, x0 + 1, y0, shift)) +
+                  t * ((1 - s) * channel(source, x0, y0 + 1, shift) +
+                       s * channel(source, x0 + 1, y0 + 1, shift));
+        }
+        else
+        {
+          float left = x * scaleX, right = left + scaleX, top = y * scaleY, bottom = top + scaleY;
+          float sum = 0.0f;
+          for (int sy = (int) top; sy < bottom; ++sy)
+          {
+            float height = std::min(bottom, sy + 1.0f) - std::max(top, (float) sy);
+            for (int sx = (int) left; sx < right; ++sx)
+            {
+              float width = std::min(right, sx + 1.0f) - std::max(left, (float) sx);
+              sum += width * height * channel(source, sx, sy, shift);
+            }
+          }
+          value = sum / (scaleX * scaleY);
+        }
+        result |= (unsigned int) std::min((int) (value + 0.5f), 255) << shift;
+      }
+      pRow[x] = result;
+    }
+  }
+}
+
+static int maxDifference(const Image& a, const Image& b)
+{
+  int difference = 0;
+  for (int y = 0; y < a.getHeight(); ++y)
+  {
+    for (int x = 0; x < a.getWidth(); ++x)
+    {
+      for (int shift = 0; shift < 32; shift += 8)
+      {
+        int delta = (int) channel(a, x, y, shift) - (int) channel(b, x, y, shift);
+        difference = std::max(difference, abs(delta));
+      }
+    }
+  }
+  return difference;
+}
+
+int main()
+{
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("Kernels: %s, %u threads\n\n", ImageOps::getInstructionSet(),
+         (unsigned int) pool.getThreadCount());
+
+  Image hd(1920, 1080), uhd(3840, 2160);
+  makeImage(hd);
+  makeImage(uhd);
+
+  static const char* FILTERS[3] = { "nearest", "bilinear", "box" };
+  for (int direction = 0; direction < 2; ++direction)
+  {
+    const Image& source = direction == 0 ? hd : uhd;
+    int width = direction == 0 ? 3840 : 1920, height = direction == 0 ? 2160 : 1080;
+    printf("%dx%d -> %dx%d        float loop   one thread         pool   error\n",
+           source.getWidth(), source.getHeight(), width, height);
+
+    for (int f = 0; f < 3; ++f)
+    {
+      ImageOps::Filter filter = (ImageOps::Filter) f;
+      Image reference(width, height), single(width, height), parallel(width, height);
+      double megapixels = width * (double) height / 1e6;
+
+      std::chrono::high_resolution_clock::time_point start =
+        std::chrono::high_resolution_clock::now();
+      scaleReference(source, reference, filter);
+      double referenceMs = elapsedMs(start);
+
+      double singleMs = 1e9, parallelMs = 1e9;
+      for (int run = 0; run < RUNS; ++run)
+      {
+        start = std::chrono::high_resolution_clock::now();
+        ImageOps::scale(source, single, filter);
+        singleMs = std::min(singleMs, elapsedMs(start));
+        start = std::chrono::high_resolution_clock::now();
+        ImageOps::scale(source, parallel, filter, &pool);
+        parallelMs = std::min(parallelMs, elapsedMs(start));
+      }
+
+      bool isIdentical = std::equal(single.getPixels(), single.getPixels() + width * height,
+                                    parallel.getPixels());
+      printf("  %-22s %7.0f MP/s %7.0f MP/s %7.0f MP/s   %d%s\n", FILTERS[f],
+             megapixels * 1000.0 / referenceMs, megapixels * 1000.0 / singleMs,
+             megapixels * 1000.0 / parallelMs, maxDifference(reference, single),
+             isIdentical ? "" : "  POOL MISMATCH");
+    }
+    printf("\n");
+  }
+
+  // Conversions of a 4K image, in place after the first copy.
+  size_t count = (size_t) uhd.getWidth() * uhd.getHeight();
+  std::vector<unsigned int> pixels(uhd.getPixels(), uhd.getPixels() + count);
+  std::vector<unsigned int> converted(count), expected(count);
+  printf("3840x2160 conversions          per pixel   one thread         pool\n");
+  for (int operation = 0; operation < 3; ++operation)
+  {
+    static const char* NAMES[3] = { "swap red and blue", "premultiply", "unpremultiply" };
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i)
+    {
+      unsigned int pixel = pixels[i], alpha = pixel >> 24, result = pixel & 0xFF000000;
+      for (int shift = 0; shift < 24; shift += 8)
+      {
+        float value = (float) ((pixel >> shift) & 0xFF);
+        if (operation == 0)
+        {
+          result |= (unsigned int) value << (16 - shift);
+        }
+        else if (operation == 1)
+        {
+          result |= (unsigned int) (value * alpha / 255.0f + 0.5f) << shift;
+        }
+        else if (alpha != 0)
+        {
+          result |= (unsigned int) std::min(value * 255.0f / alpha + 0.5f, 255.0f) << shift;
+        }
+      }
+      expected[i] = result;
+    }
+    double referenceMs = elapsedMs(start);
+
+    double singleMs = 1e9, parallelMs = 1e9;
+    for (int run = 0; run < RUNS; ++run)
+    {
+      for (int threaded = 0; threaded < 2; ++threaded)
+      {
+        ThreadPool* pPool = threaded ? &pool : NULL;
+        start = std::chrono::high_resolution_clock::now();
+        if (operation == 0)
+        {
+          ImageOps::swapRedBlue(&pixels[0], &converted[0], count, pPool);
+        }
+        else if (operation == 1)
+        {
+          ImageOps::premultiply(&pixels[0], &converted[0], count, pPool);
+        }
+        else
+        {
+          ImageOps::unpremultiply(&pixels[0], &converted[0], count, pPool);
+        }
+        double& ms = threaded ? parallelMs : singleMs;
+        ms = std::min(ms, elapsedMs(start));
+      }
+    }
+
+    int error = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      for (int shift = 0; shift < 32; shift += 8)
+      {
+        int delta = (int) ((converted[i] >> shift) & 0xFF) - (int) ((expected[i] >> shift) & 0xFF);
+        error = std::max(error, abs(delta));
+      }
+    }
+    double megapixels = count / 1e6;
+    printf("  %-22s %7.0f MP/s %7.0f MP/s %7.0f MP/s   %d\n", NAMES[operation],
+           megapixels * 1000.0 / referenceMs, megapixels * 1000.0 / singleMs,
+           megapixels * 1000.0 / parallelMs, error);
+  }
+
+  // Premultiplying and back loses at most the precision alpha leaves.
+  ImageOps::premultiply(&pixels[0], &converted[0], count);
+  ImageOps::unpremultiply(&converted[0], &converted[0], count);
+  int roundTrip = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (int shift = 0; shift < 24; shift += 8)
+    {
+      int delta = (int) ((converted[i] >> shift) & 0xFF) - (int) ((pixels[i] >> shift) & 0xFF);
+      roundTrip = std::max(roundTrip, abs(delta));
+    }
+  }
+  printf("\nRound trip through premultiplied alpha: max error %d\n", roundTrip);
+
+  // Tiny and one pixel targets, where a box covers the whole odd source.
+  static const int SIZES[5][4] = { { 3, 3, 1, 1 }, { 5, 7, 1, 2 }, { 9, 1, 1, 1 },
+                                   { 7, 5, 3, 1 }, { 1, 3, 1, 1 } };
+  int smallError = 0;
+  for (int s = 0; s < 5; ++s)
+  {
+    Image source(SIZES[s][0], SIZES[s][1]);
+    makeImage(source);
+    for (int f = 0; f < 3; ++f)
+    {
+      Image reference(SIZES[s][2], SIZES[s][3]), scaled(SIZES[s][2], SIZES[s][3]);
+      scaleReference(source, reference, (ImageOps::Filter) f);
+      ImageOps::scale(source, scaled, (ImageOps::Filter) f);
+      smallError = std::max(smallError, maxDifference(reference, scaled));
+    }
+  }
+  printf("Small targets from odd sizes: max error %d%s\n", smallError,
+         smallError <= 1 ? "" : "  FAILED");
+  return smallError <= 1 ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/*
+ * @file benchmark_mesh_import.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures MeshImporter throughput on a large synthetic mesh stored
+ * as OBJ, ascii PLY and binary PLY, against the simple Mesh::loadObj() path
+ * and a plain pass over the mapped file.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\MappedFile.h>
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Geometry\Mesh.h>
+#include <LiteCube\Geometry\MeshImporter.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static String toString(const char* text)
+{
+  return String(text, text + strlen(text));
+}
+
+/*
+ * Write a wavy grid with normals and texture coordinates in all formats.
+ */
+static void writeGrid(int side)
+{
+  FILE* pObj = fopen("benchmark_import.obj", "w");
+  FILE* pAscii = fopen("benchmark_import_ascii.ply", "w");
+  FILE* pBinary = fopen("benchmark_import_binary.ply", "wb");
+  int vertices = side * side, faces = (side - 1) * (side - 1);
+
+  const char* header =
+    "ply\nformat %s 1.0\nelement vertex %d\n"
+    "property float x\nproperty float y\nproperty float z\n"
+    "property float nx\nproperty float ny\nproperty float nz\n"
+    "property float u\nproperty float v\n"
+    "element face %d\nproperty list uchar int vertex_indices\nend_header\n";
+  fprintf(pAscii, header, "ascii", vertices, faces);
+  fprintf(pBinary, header, "binary_little_endian", vertices, faces);
+
+  for (int z = 0; z < side; ++z)
+  {
+    for (int x = 0; x < side; ++x)
+    {
+      float v[8] = { (float) x, sinf(x * 0.1f) * cosf(z * 0.1f), (float) z,
+                     0.0f, 1.0f, 0.0f, x / (float) side, z / (float) side };
+      fprintf(pObj, "v %f %f %f\nvn %f %f %f\nvt %f %f\n",
+              v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+      fprintf(pAscii, "%f %f %f %f %f %f %f %f\n",
+              v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+      fwrite(v, sizeof(float), 8, pBinary);
+    }
+  }
+
+  for (int z = 0; z + 1 < side; ++z)
+  {
+    for (int x = 0; x + 1 < side; ++x)
+    {
+      int quad[4] = { z * side + x, (z + 1) * side + x, (z + 1) * side + x + 1, z * side + x + 1 };
+      fprintf(pObj, "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n",
+              quad[0] + 1, quad[0] + 1, quad[0] + 1, quad[1] + 1, quad[1] + 1, quad[1] + 1,
+              quad[2] + 1, quad[2] + 1, quad[2] + 1, quad[3] + 1, quad[3] + 1, quad[3] + 1);
+      fprintf(pAscii, "4 %d %d %d %d\n", quad[0], quad[1], quad[2], quad[3]);
+      unsigned char count = 4;
+      fwrite(&count, 1, 1, pBinary);
+      fwrite(quad, sizeof(int), 4, pBinary);
+    }
+  }
+
+  fclose(pObj);
+  fclose(pAscii);
+  fclose(pBinary);
+}
+
+static bool isSameMesh(const Mesh& a, const Mesh& b)
+{
+  if (a.positions.size() != b.positions.size() || a.indices != b.indices ||
+      a.normals.size() != b.normals.size() || a.uvs.size() != b.uvs.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < a.positions.size(); ++i)
+  {
+    if (a.positions[i].x != b.positions[i].x || a.positions[i].y != b.positions[i].y ||
+        a.positions[i].z != b.positions[i].z)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * Time one import and print the throughput.
+ */
+static double run(const char* name, const char* path, MeshImporter& importer,
+                  Mesh& mesh, ThreadPool* pPool, double bytes)
+{
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  bool isLoaded = importer.importFile(toString(path), mesh, pPool);
+  double ms = elapsedMs(start);
+  printf("  %-22s %9.1f ms %8.1f MB/s  %s\n", name, ms, bytes / ms / 1000.0,
+         isLoaded ? "" : "FAILED");
+  return ms;
+}
+
+int main(int argc, char** argv)
+{
+  int side = argc > 1 ? atoi(argv[1]) : 1000;
+  writeGrid(side);
+
+  ThreadPool& pool = ThreadPool::getDefault();
+  const char* paths[] = {
+    "benchmark_import.obj", "benchmark_import_ascii.ply", "benchmark_import_binary.ply"
+  };
+
+  // Reference: touching every byte of the mapping approximates the
+  // bandwidth the parser could reach.
+  MappedFile file;
+  file.open(toString(paths[0]));
+  double bytes = (double) file.getSize();
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  const unsigned char* pData = (const unsigned char*) file.getData();
+  unsigned int newLines = 0;
+  for (size_t i = 0; i < file.getSize(); ++i)
+  {
+    newLines += pData[i] == '\n';
+  }
+  double scanMs = elapsedMs(start);
+  file.close();
+
+  printf("Grid %dx%d, threads: %u\n", side, side, pool.getThreadCount());
+  printf("OBJ, %.1f MB (%u lines)\n", bytes / 1e6, newLines);
+  printf("  %-22s %9.1f ms %8.1f MB/s\n", "scan mapping", scanMs, bytes / scanMs / 1000.0);
+
+  Mesh reference;
+  start = std::chrono::high_resolution_clock::now();
+  reference.loadObj(toString(paths[0]));
+  double simpleMs = elapsedMs(start);
+  printf("  %-22s %9.1f ms %8.1f MB/s\n", "Mesh::loadObj", simpleMs, bytes / simpleMs / 1000.0);
+
+  MeshImporter importer;
+  Mesh mesh;
+  run("importer single", paths[0], importer, mesh, NULL, bytes);
+  bool isSame = isSameMesh(reference, mesh);
+  double poolMs = run("importer pool", paths[0], importer, mesh, &pool, bytes);
+  isSame = isSame && isSameMesh(reference, mesh);
+  printf("  speedup over Mesh::loadObj: %.1fx, contents match: %s\n",
+         simpleMs / poolMs, isSame ? "yes" : "NO");
+
+  for (int i = 1; i < 3; ++i)
+  {
+    file.open(toString(paths[i]));
+    bytes = (double) file.getSize();
+    file.close();
+
+    printf("%s PLY, %.1f MB\n", i == 1 ? "Ascii" : "Binary", bytes / 1e6);
+    run("importer single", paths[i], importer, mesh, NULL, bytes);
+    run("importer pool", paths[i], importer, mesh, &pool, bytes);
+    printf("  triangles: %u, vertices: %u\n",
+           (unsigned int) (mesh.indices.size() / 3), (unsigned int) mesh.positions.size());
+  }
+
+  for (int i = 0; i < 3; ++i)
+  {
+    remove(paths[i]);
+  }
+  return isSame ? 0 : 1;
+}
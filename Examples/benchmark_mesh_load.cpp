@@ -0,0 +1,143 @@
+/*
+ * @file benchmark_mesh_load.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Compares loading a mesh from OBJ text with mapping the binary
+ * MeshFile format.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Geometry\Mesh.h>
+#include <LiteCube\Geometry\MeshFile.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static String toString(const char* text)
+{
+  return String(text, text + strlen(text));
+}
+
+/*
+ * Write a wavy grid with normals and texture coordinates as OBJ text.
+ */
+static bool writeGrid(const char* path, int side)
+{
+  FILE* pFile = fopen(path, "w");
+  if (pFile == NULL)
+  {
+    return false;
+  }
+
+  for (int z = 0; z < side; ++z)
+  {
+    for (int x = 0; x < side; ++x)
+    {
+      float height = sinf(x * 0.1f) * cosf(z * 0.1f);
+      fprintf(pFile, "v %f %f %f\n", (float) x, height, (float) z);
+      fprintf(pFile, "vn %f %f %f\n", 0.0f, 1.0f, 0.0f);
+      fprintf(pFile, "vt %f %f\n", x / (float) side, z / (float) side);
+    }
+  }
+
+  for (int z = 0; z + 1 < side; ++z)
+  {
+    for (int x = 0; x + 1 < side; ++x)
+    {
+      int a = z * side + x + 1, b = a + 1, c = a + side, d = c + 1;
+      fprintf(pFile, "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n",
+              a, a, a, c, c, c, d, d, d, b, b, b);
+    }
+  }
+
+  fclose(pFile);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  int side = argc > 1 ? atoi(argv[1]) : 1000;
+  const char* objPath = "benchmark_mesh.obj";
+  const char* binaryPath = "benchmark_mesh.lcm";
+
+  if (!writeGrid(objPath, side))
+  {
+    printf("Failed to write %s\n", objPath);
+    return 1;
+  }
+
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  Mesh mesh;
+  if (!mesh.loadObj(toString(objPath)))
+  {
+    printf("Failed to read %s\n", objPath);
+    return 1;
+  }
+  double textMs = elapsedMs(start);
+
+  if (!MeshFile::write(toString(binaryPath), mesh))
+  {
+    printf("Failed to write %s\n", binaryPath);
+    return 1;
+  }
+  printf("Mesh: %u vertices, %u triangles\n",
+         (unsigned int) mesh.getVertexCount(), (unsigned int) mesh.getTriangleCount());
+  printf("  OBJ text load:        %10.3f ms\n", textMs);
+
+  start = std::chrono::high_resolution_clock::now();
+  MeshFile file;
+  if (!file.open(toString(binaryPath)))
+  {
+    printf("Failed to map %s\n", binaryPath);
+    return 1;
+  }
+  double openMs = elapsedMs(start);
+
+  // First pass over the positions pulls the pages in.
+  start = std::chrono::high_resolution_clock::now();
+  Span<Vector3f> positions = file.getPositions();
+  float sum = 0.0f;
+  for (size_t i = 0; i < positions.size(); ++i)
+  {
+    sum += positions[i].y;
+  }
+  double touchMs = elapsedMs(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  bool isValid = file.verify();
+  double verifyMs = elapsedMs(start);
+
+  printf("  Binary open:          %10.3f ms\n", openMs);
+  printf("  First position pass:  %10.3f ms (sum %.1f)\n", touchMs, sum);
+  printf("  Lazy checksum:        %10.3f ms (%s)\n", verifyMs, isValid ? "valid" : "CORRUPT");
+  printf("  Speedup open + pass:  %10.1fx\n", textMs / (openMs + touchMs));
+
+  bool isSame = positions.size() == mesh.positions.size() &&
+                file.getIndices().size() == mesh.indices.size();
+  for (size_t i = 0; isSame && i < positions.size(); ++i)
+  {
+    isSame = positions[i] == mesh.positions[i];
+  }
+  printf("  Contents match:       %s\n", isSame ? "yes" : "NO");
+
+  remove(objPath);
+  remove(binaryPath);
+  return isSame && isValid ? 0 : 1;
+}
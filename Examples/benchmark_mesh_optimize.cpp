@@ -0,0 +1,169 @@
+/*
+ * @file benchmark_mesh_optimize.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures MeshOptimizer and MeshSimplifier on a large heightfield:
+ * the cache miss ratio before and after reordering and the throughput of
+ * the simplification and of building a chain of levels of detail. The
+ * same terrain moved far from the origin must simplify the same way.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Geometry\Mesh.h>
+#include <LiteCube\Geometry\MeshOptimizer.h>
+#include <LiteCube\Geometry\MeshSimplifier.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/*
+ * Rolling hills with texture coordinates, triangles in random order as an
+ * exporter without cache awareness could leave them.
+ */
+static void makeTerrain(int side, Mesh& mesh)
+{
+  mesh.clear();
+  for (int z = 0; z < side; ++z)
+  {
+    for (int x = 0; x < side; ++x)
+    {
+      float height = 4.0f * sinf(x * 0.05f) * cosf(z * 0.04f) + 0.5f * sinf(x * 0.31f + z * 0.17f);
+      mesh.positions.push_back(Vector3f((float) x, height, (float) z));
+      mesh.uvs.push_back(Vector2f(x / (float) side, z / (float) side));
+    }
+  }
+  for (int z = 0; z + 1 < side; ++z)
+  {
+    for (int x = 0; x + 1 < side; ++x)
+    {
+      unsigned int i = z * side + x;
+      unsigned int quad[6] = { i, i + side, i + side + 1, i, i + side + 1, i + 1 };
+      mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+    }
+  }
+
+  size_t triangles = mesh.indices.size() / 3;
+  for (size_t t = triangles - 1; t > 0; --t)
+  {
+    size_t other = ((size_t) rand() * (RAND_MAX + 1u) + rand()) % (t + 1);
+    for (int k = 0; k < 3; ++k)
+    {
+      std::swap(mesh.indices[t * 3 + k], mesh.indices[other * 3 + k]);
+    }
+  }
+}
+
+static float acmr(const Mesh& mesh)
+{
+  return MeshOptimizer::computeACMR(&mesh.indices[0], mesh.indices.size(),
+                                    mesh.positions.size());
+}
+
+int main(int argc, char** argv)
+{
+  int side = argc > 1 ? atoi(argv[1]) : 1000;
+  ThreadPool& pool = ThreadPool::getDefault();
+
+  Mesh mesh;
+  makeTerrain(side, mesh);
+  double triangles = (double) mesh.getTriangleCount();
+  printf("Terrain %dx%d, %u triangles, threads: %u\n", side, side,
+         (unsigned int) triangles, pool.getThreadCount());
+
+  printf("Vertex cache (FIFO %u)\n", MeshOptimizer::DEFAULT_CACHE_SIZE);
+  printf("  ACMR shuffled:          %6.3f\n", acmr(mesh));
+
+  Mesh optimized = mesh;
+  std::vector<unsigned int> clusters;
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  MeshOptimizer::optimizeVertexCache(&optimized.indices[0], optimized.indices.size(),
+                                     optimized.positions.size(),
+                                     MeshOptimizer::DEFAULT_CACHE_SIZE, &clusters);
+  double ms = elapsedMs(start);
+  printf("  ACMR after Tipsify:     %6.3f  (%.1f ms, %.1f Mtriangles/s)\n", acmr(optimized),
+         ms, triangles / ms / 1000.0);
+
+  start = std::chrono::high_resolution_clock::now();
+  MeshOptimizer::optimizeOverdraw(&optimized.indices[0], optimized.indices.size(),
+                                  &optimized.positions[0], clusters);
+  ms = elapsedMs(start);
+  printf("  ACMR after overdraw:    %6.3f  (%.1f ms, %u clusters)\n", acmr(optimized), ms,
+         (unsigned int) clusters.size());
+
+  start = std::chrono::high_resolution_clock::now();
+  MeshOptimizer::optimizeVertexFetch(optimized);
+  printf("  vertex fetch reorder:   %.1f ms\n", elapsedMs(start));
+
+  printf("Simplification to 10%%\n");
+  MeshSimplifier simplifier;
+  Mesh simplified;
+  ThreadPool* pools[2] = { NULL, &pool };
+  for (int p = 0; p < 2; ++p)
+  {
+    start = std::chrono::high_resolution_clock::now();
+    simplifier.simplify(mesh, simplified, (size_t) (triangles * 0.1), 1e30f, pools[p]);
+    ms = elapsedMs(start);
+    printf("  %-8s %9.1f ms %6.2f Mtriangles/s  -> %u triangles, error %g\n",
+           p == 0 ? "single" : "pool", ms, triangles / ms / 1000.0,
+           (unsigned int) simplified.getTriangleCount(), simplifier.getError());
+  }
+
+  // Heights in steps of 1/64 stay exact when moved, so every offset must
+  // give the same collapses and the same error.
+  printf("Translated 200x200 terrain to 8000 triangles\n");
+  Mesh small, reference;
+  makeTerrain(200, small);
+  for (size_t v = 0; v < small.positions.size(); ++v)
+  {
+    small.positions[v].y = floorf(small.positions[v].y * 64.0f) / 64.0f;
+  }
+  float offsets[3] = { 0.0f, 1000.0f, 10000.0f };
+  for (int o = 0; o < 3; ++o)
+  {
+    Mesh moved = small;
+    for (size_t v = 0; v < moved.positions.size(); ++v)
+    {
+      moved.positions[v] += Vector3f(offsets[o], offsets[o], offsets[o]);
+    }
+    simplifier.simplify(moved, simplified, 8000, 1e30f, &pool);
+    if (o == 0)
+    {
+      reference = simplified;
+    }
+    printf("  offset %-6.0f -> %u triangles, error %g%s\n", offsets[o],
+           (unsigned int) simplified.getTriangleCount(), simplifier.getError(),
+           simplified.indices == reference.indices ? "" : "  DIFFERENT COLLAPSES");
+  }
+
+  printf("LOD chain, 6 levels, ratio 0.5\n");
+  std::vector<Mesh> lods;
+  start = std::chrono::high_resolution_clock::now();
+  simplifier.buildLodChain(mesh, 6, 0.5f, 1e30f, lods, &pool);
+  ms = elapsedMs(start);
+  for (size_t i = 0; i < lods.size(); ++i)
+  {
+    printf("  LOD %u: %8u triangles %8u vertices  ACMR %.3f  error %g\n", (unsigned int) i,
+           (unsigned int) lods[i].getTriangleCount(), (unsigned int) lods[i].getVertexCount(),
+           acmr(lods[i]), simplifier.getLodErrors()[i]);
+  }
+  printf("  total %.1f ms, %.2f Mtriangles/s\n", ms, triangles / ms / 1000.0);
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * @file benchmark_neighbours.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Compares SpatialHashGrid and KdTree queries against brute force.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Geometry\KdTree.h>
+#include <LiteCube\Geometry\SpatialHashGrid.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static float distanceSqr(const Vector3f& a, const Vector3f& b)
+{
+  float dx = a.x - b.x;
+  float dy = a.y - b.y;
+  float dz = a.z - b.z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+int main(int argc, char** argv)
+{
+  size_t count = argc > 1 ? (size_t) atoi(argv[1]) : 100000;
+  const size_t k = 8;
+  const float worldSize = 1000.0f;
+  const float radius = 5.0f;
+
+  std::vector<Vector3f> points(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    points[i] = Vector3f(rand() * worldSize / RAND_MAX,
+                         rand() * worldSize / RAND_MAX,
+                         rand() * worldSize / RAND_MAX * 0.1f);
+  }
+
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("Points: %u, threads: %u\n", (unsigned int) count, pool.getThreadCount());
+
+  // Brute force on a sample of the queries, extrapolated to all of them.
+  size_t sample = count < 1000 ? count : 1000;
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  size_t bruteFound = 0;
+  for (size_t q = 0; q < sample; ++q)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      bruteFound += distanceSqr(points[q], points[i]) <= radius * radius ? 1 : 0;
+    }
+  }
+  double bruteMs = elapsedMs(start) * count / sample;
+  printf("Radius, brute force:   %10.1f ms (estimated)\n", bruteMs);
+
+  SpatialHashGrid grid(radius);
+  start = std::chrono::high_resolution_clock::now();
+  grid.build(&points[0], count, &pool);
+  printf("Grid build:            %10.1f ms\n", elapsedMs(start));
+
+  std::vector<unsigned int> offsets, results;
+  start = std::chrono::high_resolution_clock::now();
+  grid.queryRadius(&points[0], count, radius, offsets, results, NULL);
+  printf("Radius, grid:          %10.1f ms (%u pairs)\n", elapsedMs(start),
+         (unsigned int) results.size());
+
+  start = std::chrono::high_resolution_clock::now();
+  grid.queryRadius(&points[0], count, radius, offsets, results, &pool);
+  printf("Radius, grid + pool:   %10.1f ms\n", elapsedMs(start));
+
+  KdTree tree;
+  start = std::chrono::high_resolution_clock::now();
+  tree.build(&points[0], count, &pool);
+  printf("k-d tree build:        %10.1f ms\n", elapsedMs(start));
+
+  start = std::chrono::high_resolution_clock::now();
+  std::vector<float> bestDist(k);
+  for (size_t q = 0; q < sample; ++q)
+  {
+    bestDist.assign(k, 1e30f);
+    for (size_t i = 0; i < count; ++i)
+    {
+      float d = distanceSqr(points[q], points[i]);
+      if (d < bestDist[k - 1])
+      {
+        size_t j = k - 1;
+        while (j > 0 && bestDist[j - 1] > d)
+        {
+          bestDist[j] = bestDist[j - 1];
+          --j;
+        }
+        bestDist[j] = d;
+      }
+    }
+  }
+  printf("%u-NN, brute force:     %10.1f ms (estimated)\n", (unsigned int) k,
+         elapsedMs(start) * count / sample);
+
+  std::vector<unsigned int> indices(count * k);
+  std::vector<float> distances(count * k);
+  start = std::chrono::high_resolution_clock::now();
+  tree.queryKNearest(&points[0], count, k, &indices[0], &distances[0], NULL);
+  printf("%u-NN, k-d tree:        %10.1f ms\n", (unsigned int) k, elapsedMs(start));
+
+  start = std::chrono::high_resolution_clock::now();
+  tree.queryKNearest(&points[0], count, k, &indices[0], &distances[0], &pool);
+  printf("%u-NN, k-d tree + pool: %10.1f ms\n", (unsigned int) k, elapsedMs(start));
+
+  return bruteFound > 0 ? 0 : 1;
+}
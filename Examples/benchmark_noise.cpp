@@ -0,0 +1,136 @@
+/*
+ * @file benchmark_noise.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Fills 2048x2048 and 128^3 grids with value, Perlin and simplex
+ * noise, single octave, fBm and ridged, and reports million samples per
+ * second on one thread and on the pool. One million scattered points are
+ * evaluated in a batch and one at a time; both must give bit identical
+ * results. The printed checksums must not change between builds for
+ * different instruction sets.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Math\Noise.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace Lite;
+
+static const int SIZE_2D = 2048;
+static const int SIZE_3D = 128;
+static const int POINTS = 1000000;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// FNV-1a over the bits of the samples.
+static unsigned int checksum(const std::vector<float>& values)
+{
+  unsigned int hash = 2166136261u;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    unsigned int bits;
+    memcpy(&bits, &values[i], sizeof(bits));
+    hash = (hash ^ bits) * 16777619u;
+  }
+  return hash;
+}
+
+int main()
+{
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("Instruction set %s, %u pool threads\n\n", Noise::getInstructionSet(),
+         pool.getThreadCount());
+
+  static const char* TYPES[3] = { "value", "Perlin", "simplex" };
+  static const char* FRACTALS[3] = { "1 octave", "fBm x4", "ridged x4" };
+
+  std::vector<float> grid2((size_t) SIZE_2D * SIZE_2D);
+  std::vector<float> grid3((size_t) SIZE_3D * SIZE_3D * SIZE_3D);
+  printf("%-8s %-10s %12s %12s %12s %12s  checksums\n", "noise", "fractal", "2D single",
+         "2D pool", "3D single", "3D pool");
+  for (int type = 0; type < 3; ++type)
+  {
+    for (int fractal = 0; fractal < 3; ++fractal)
+    {
+      Noise noise((Noise::Type) type, 1234);
+      noise.setFrequency(0.02f);
+      noise.setFractal((Noise::Fractal) fractal, 4);
+
+      double ms[4];
+      for (int run = 0; run < 4; ++run)
+      {
+        ThreadPool* pPool = run % 2 == 0 ? NULL : &pool;
+        std::chrono::high_resolution_clock::time_point start =
+          std::chrono::high_resolution_clock::now();
+        if (run < 2)
+        {
+          noise.fillGrid(&grid2[0], SIZE_2D, SIZE_2D, Vector2f(-1000.0f, 250.0f),
+                         Vector2f(1.0f, 1.0f), pPool);
+        }
+        else
+        {
+          noise.fillGrid(&grid3[0], SIZE_3D, SIZE_3D, SIZE_3D, Vector3f(-64.0f, 10.0f, 3.0f),
+                         Vector3f(1.0f, 1.0f, 1.0f), pPool);
+        }
+        ms[run] = elapsedMs(start);
+      }
+
+      printf("%-8s %-10s", TYPES[type], FRACTALS[fractal]);
+      for (int run = 0; run < 4; ++run)
+      {
+        double samples = run < 2 ? (double) grid2.size() : (double) grid3.size();
+        printf(" %7.1f MS/s", samples / ms[run] / 1000.0);
+      }
+      printf("  %08x %08x\n", checksum(grid2), checksum(grid3));
+    }
+  }
+
+  // Scattered points, batched against one at a time.
+  std::vector<Vector2f> points(POINTS);
+  unsigned int state = 99;
+  for (int i = 0; i < POINTS; ++i)
+  {
+    state = state * 1664525u + 1013904223u;
+    float x = (state >> 8) / 16777216.0f * 2000.0f - 1000.0f;
+    state = state * 1664525u + 1013904223u;
+    float y = (state >> 8) / 16777216.0f * 2000.0f - 1000.0f;
+    points[i] = Vector2f(x, y);
+  }
+
+  Noise noise(Noise::TYPE_SIMPLEX, 7);
+  noise.setFractal(Noise::FRACTAL_FBM, 4);
+  std::vector<float> batched(POINTS), single(POINTS);
+
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  noise.sample(&points[0], POINTS, &batched[0]);
+  double batchMs = elapsedMs(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < POINTS; ++i)
+  {
+    single[i] = noise.sample(points[i]);
+  }
+  double singleMs = elapsedMs(start);
+
+  bool isSame = memcmp(&batched[0], &single[0], POINTS * sizeof(float)) == 0;
+  printf("\n1M points, simplex fBm x4: batch %.1f MS/s, one at a time %.1f MS/s, %s\n",
+         POINTS / batchMs / 1000.0, POINTS / singleMs / 1000.0,
+         isSame ? "bit identical" : "MISMATCH");
+  return isSame ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+/*
+ * @file benchmark_occlusion.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Culls small objects in a city of box shaped buildings with
+ * OcclusionCuller at 512x256 while the camera walks down a street. Reports
+ * the cost of each step per frame and the culling rate, and checks every
+ * culled box against the full resolution depth buffer.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Geometry\OcclusionCuller.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static const int WIDTH = 512;
+static const int HEIGHT = 256;
+static const float FOV_Y = 1.0f;
+static const float NEAR_PLANE = 0.5f;
+static const int BLOCKS = 40;
+static const float BLOCK_SIZE = 40.0f;
+static const float STREET_WIDTH = 12.0f;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static float random(unsigned int& state, float low, float high)
+{
+  state = state * 1664525u + 1013904223u;
+  return low + (high - low) * (state >> 8) / 16777216.0f;
+}
+
+// Adds the 12 triangles of a box.
+static void addBox(const Vector3f& low, const Vector3f& high, std::vector<Vector3f>& vertices,
+                   std::vector<unsigned int>& indices)
+{
+  static const unsigned int FACES[36] = { 0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5,
+                                          0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6,
+                                          0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3 };
+  unsigned int base = (unsigned int) vertices.size();
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    vertices.push_back(Vector3f((corner & 4) ? high.x : low.x, (corner & 2) ? high.y : low.y,
+                                (corner & 1) ? high.z : low.z));
+  }
+  for (int i = 0; i < 36; ++i)
+  {
+    indices.push_back(base + FACES[i]);
+  }
+}
+
+/*
+ * A grid of blocks separated by streets, each holding a building of random
+ * height, and small objects scattered on the streets and on the roofs.
+ */
+static void makeCity(size_t objectCount, std::vector<Vector3f>& vertices,
+                     std::vector<unsigned int>& indices, std::vector<AABB>& objects)
+{
+  unsigned int state = 1234;
+  std::vector<float> heights;
+  for (int z = 0; z < BLOCKS; ++z)
+  {
+    for (int x = 0; x < BLOCKS; ++x)
+    {
+      float height = random(state, 10.0f, 60.0f);
+      Vector3f low(x * BLOCK_SIZE + STREET_WIDTH * 0.5f, 0.0f, z * BLOCK_SIZE + STREET_WIDTH * 0.5f);
+      Vector3f high(low.x + BLOCK_SIZE - STREET_WIDTH, height, low.z + BLOCK_SIZE - STREET_WIDTH);
+      addBox(low, high, vertices, indices);
+      heights.push_back(height);
+    }
+  }
+
+  float extent = BLOCKS * BLOCK_SIZE;
+  while (objects.size() < objectCount)
+  {
+    float x = random(state, 0.0f, extent), z = random(state, 0.0f, extent);
+    float size = random(state, 0.5f, 2.5f);
+    float localX = fmodf(x, BLOCK_SIZE), localZ = fmodf(z, BLOCK_SIZE);
+    bool isStreet = localX < STREET_WIDTH * 0.5f || localX > BLOCK_SIZE - STREET_WIDTH * 0.5f ||
+                    localZ < STREET_WIDTH * 0.5f || localZ > BLOCK_SIZE - STREET_WIDTH * 0.5f;
+    float y = isStreet ? 0.0f : heights[(int) (z / BLOCK_SIZE) * BLOCKS + (int) (x / BLOCK_SIZE)];
+    objects.push_back(AABB(Vector3f(x, y, z), Vector3f(x + size, y + size, z + size)));
+  }
+}
+
+/*
+ * Reference test on the full resolution buffer: a box is hidden when it is
+ * behind the camera, off screen or every pixel its corners cover has an
+ * occluder in front of its nearest corner.
+ */
+static bool isHiddenReference(const OcclusionCuller& culler, const AABB& box,
+                                const Vector3f& eye, const float axes[3][3])
+{
+  float scale = HEIGHT * 0.5f / tanf(FOV_Y * 0.5f);
+  float minX = 1e30f, maxX = -1e30f, minY = 1e30f, maxY = -1e30f, minZ = 1e30f;
+  int behind = 0, outside = 15;
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    float p[3] = { ((corner & 1) ? box.max.x : box.min.x) - eye.x,
+                   ((corner & 2) ? box.max.y : box.min.y) - eye.y,
+                   ((corner & 4) ? box.max.z : box.min.z) - eye.z };
+    float v[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      v[i] = axes[i][0] * p[0] + axes[i][1] * p[1] + axes[i][2] * p[2];
+    }
+    // Sides of the frustum the corner is outside of.
+    float halfWidth = culler.getWidth() * 0.5f * v[2], halfHeight = HEIGHT * 0.5f * v[2];
+    outside &= (v[0] * scale > halfWidth ? 1 : 0) | (-v[0] * scale > halfWidth ? 2 : 0) |
+               (v[1] * scale > halfHeight ? 4 : 0) | (-v[1] * scale > halfHeight ? 8 : 0);
+    if (v[2] < NEAR_PLANE)
+    {
+      ++behind;
+      continue;
+    }
+    minX = std::min(minX, culler.getWidth() * 0.5f + v[0] * scale / v[2]);
+    maxX = std::max(maxX, culler.getWidth() * 0.5f + v[0] * scale / v[2]);
+    minY = std::min(minY, HEIGHT * 0.5f - v[1] * scale / v[2]);
+    maxY = std::max(maxY, HEIGHT * 0.5f - v[1] * scale / v[2]);
+    minZ = std::min(minZ, v[2]);
+  }
+  if (behind > 0 || outside != 0)
+  {
+    return behind == 8 || outside != 0;
+  }
+
+  if (maxX < 0.0f || maxY < 0.0f || minX >= culler.getWidth() || minY >= HEIGHT)
+  {
+    return true;
+  }
+
+  int x0 = std::max((int) minX, 0), x1 = std::min((int) maxX, culler.getWidth() - 1);
+  int y0 = std::max((int) minY, 0), y1 = std::min((int) maxY, HEIGHT - 1);
+  for (int y = y0; y <= y1; ++y)
+  {
+    for (int x = x0; x <= x1; ++x)
+    {
+      // Small tolerance for the rounding of the reciprocal depth.
+      if (culler.getViewDepth(x, y) >= minZ * 0.9999f)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  size_t objectCount = argc > 1 ? (size_t) atoi(argv[1]) : 100000;
+  int frames = argc > 2 ? atoi(argv[2]) : 60;
+
+  std::vector<Vector3f> vertices;
+  std::vector<unsigned int> indices;
+  std::vector<AABB> objects;
+  makeCity(objectCount, vertices, indices, objects);
+  std::vector<unsigned char> visible(objects.size());
+
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("%dx%d, %u occluder triangles, %u objects, %u pool threads\n", WIDTH, HEIGHT,
+         (unsigned int) (indices.size() / 3), (unsigned int) objects.size(),
+         pool.getThreadCount());
+
+  OcclusionCuller culler(WIDTH, HEIGHT);
+  bool isValid = true;
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    ThreadPool* pPool = pass == 0 ? NULL : &pool;
+    double setupMs = 0.0, rasterMs = 0.0, testMs = 0.0;
+    size_t triangles = 0, visibleCount = 0, occludedCount = 0, outsideCount = 0;
+    size_t falseCulled = 0, referenceHidden = 0;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+      // Walk along a street, looking slightly off its direction.
+      float t = (float) frame / frames;
+      float angle = 0.3f * sinf(t * 6.28f);
+      Vector3f eye(STREET_WIDTH * 0.25f + 2.0f * BLOCK_SIZE, 1.8f, t * 10.0f * BLOCK_SIZE);
+      Vector3f target(eye.x + sinf(angle), eye.y, eye.z + cosf(angle));
+
+      std::chrono::high_resolution_clock::time_point start =
+        std::chrono::high_resolution_clock::now();
+      culler.clear();
+      culler.setCamera(eye, target, Vector3f(0.0f, 1.0f, 0.0f), FOV_Y, NEAR_PLANE);
+      culler.addOccluders(&vertices[0], &indices[0], indices.size());
+      setupMs += elapsedMs(start);
+
+      start = std::chrono::high_resolution_clock::now();
+      culler.rasterize(pPool);
+      rasterMs += elapsedMs(start);
+
+      start = std::chrono::high_resolution_clock::now();
+      OcclusionCuller::Stats stats = culler.testBoxes(&objects[0], objects.size(), &visible[0],
+                                                      pPool);
+      testMs += elapsedMs(start);
+
+      triangles += culler.getTriangleCount();
+      visibleCount += stats.visible;
+      occludedCount += stats.occluded;
+      outsideCount += stats.outside;
+
+      // Every culled box must be hidden at full resolution as well. The
+      // reference check is slow, so it runs on every tenth frame.
+      if (pass == 0 && frame % 10 == 0)
+      {
+        float forward[3] = { target.x - eye.x, 0.0f, target.z - eye.z };
+        float length = sqrtf(forward[0] * forward[0] + forward[2] * forward[2]);
+        float axes[3][3] = { { -forward[2] / length, 0.0f, forward[0] / length },
+                             { 0.0f, 1.0f, 0.0f },
+                             { forward[0] / length, 0.0f, forward[2] / length } };
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+          bool isReferenceHidden = isHiddenReference(culler, objects[i], eye, axes);
+          referenceHidden += isReferenceHidden ? 1 : 0;
+          if (visible[i] == 0 && !isReferenceHidden)
+          {
+            ++falseCulled;
+          }
+        }
+      }
+    }
+
+    printf("%s:\n", pass == 0 ? "Single thread" : "Thread pool");
+    printf("  per frame: setup %.3f ms, raster + pyramid %.3f ms, test %.3f ms, total %.3f ms\n",
+           setupMs / frames, rasterMs / frames, testMs / frames,
+           (setupMs + rasterMs + testMs) / frames);
+    printf("  %.0f triangles on screen, %.1f ns per box\n", (double) triangles / frames,
+           testMs * 1e6 / frames / objects.size());
+    printf("  visible %.1f%%, occluded %.1f%%, outside %.1f%%\n",
+           100.0 * visibleCount / frames / objects.size(),
+           100.0 * occludedCount / frames / objects.size(),
+           100.0 * outsideCount / frames / objects.size());
+    if (pass == 0)
+    {
+      printf("  full resolution reference hides %.1f%%, wrongly culled: %u\n",
+             100.0 * referenceHidden / ((frames + 9) / 10) / objects.size(),
+             (unsigned int) falseCulled);
+      isValid = falseCulled == 0;
+    }
+  }
+
+  printf("Culled boxes hidden at full resolution: %s\n", isValid ? "yes" : "NO");
+  return isValid ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+/*
+ * @file benchmark_particles.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures ParticleSystem update throughput against an AoS loop.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Effects\ParticleSystem.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static float randomRange(float range)
+{
+  return (rand() / (float) RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+struct Particle
+{
+  Vector3f position;
+  Vector3f velocity;
+  float    lifetime;
+};
+
+int main(int argc, char** argv)
+{
+  size_t count = argc > 1 ? (size_t) atoi(argv[1]) : 2000000;
+  const int frames = 60;
+  const float dt = 1.0f / 60.0f;
+
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("Particles: %u, threads: %u\n", (unsigned int) count, pool.getThreadCount());
+
+  ParticleSystem::Plane ground;
+  ground.normal = Vector3f(0.0f, 1.0f, 0.0f);
+  ground.distance = 0.0f;
+  ground.restitution = 0.5f;
+
+  // Reference: array of structures updated with Vector3f operators.
+  std::vector<Particle> particles(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    particles[i].position = Vector3f(randomRange(10.0f), 5.0f + randomRange(5.0f), randomRange(10.0f));
+    particles[i].velocity = Vector3f(randomRange(2.0f), randomRange(2.0f), randomRange(2.0f));
+    particles[i].lifetime = 100.0f;
+  }
+
+  Vector3f gravity(0.0f, -9.81f, 0.0f);
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  for (int f = 0; f < frames; ++f)
+  {
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+      Particle& p = particles[i];
+      p.velocity += gravity * dt;
+      p.velocity *= 1.0f - 0.1f * dt;
+      p.position += p.velocity * dt;
+      if (p.position.y < 0.0f)
+      {
+        p.position.y = 0.0f;
+        if (p.velocity.y < 0.0f)
+        {
+          p.velocity.y *= -ground.restitution;
+        }
+      }
+      p.lifetime -= dt;
+    }
+  }
+  double ms = elapsedMs(start) / frames;
+  printf("AoS Vector3f:       %10.0f particles/ms\n", count / ms);
+
+  ParticleSystem system(count);
+  system.setDrag(0.1f);
+  system.addPlane(ground);
+
+  for (int run = 0; run < 2; ++run)
+  {
+    ThreadPool* pPool = run == 0 ? NULL : &pool;
+    system.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+      system.emit(particles[i].position, particles[i].velocity, 100.0f);
+    }
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; ++f)
+    {
+      system.update(dt, pPool);
+    }
+    ms = elapsedMs(start) / frames;
+    printf("SoA SIMD, %s:   %10.0f particles/ms\n",
+           pPool != NULL ? "pool  " : "single", count / ms);
+  }
+
+  // Short lifetimes so that every frame removes particles.
+  system.clear();
+  for (size_t i = 0; i < count; ++i)
+  {
+    system.emit(particles[i].position, particles[i].velocity, (i % 600) * dt);
+  }
+  start = std::chrono::high_resolution_clock::now();
+  for (int f = 0; f < frames; ++f)
+  {
+    system.update(dt, &pool);
+  }
+  ms = elapsedMs(start) / frames;
+  printf("SoA SIMD, dying:    %10.0f particles/ms (%u left)\n", count / ms,
+         (unsigned int) system.getCount());
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * @file benchmark_physics.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures RigidBodyWorld step time per stage for piles of spheres
+ * and boxes, against the 16.6 ms budget of a 60 Hz frame. The run on the
+ * pool must end with exactly the same positions as the one on one thread.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Physics\RigidBodyWorld.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static float randomRange(float range)
+{
+  return (rand() / (float) RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+/*
+ * Drop bodies in a grid of columns so that they land on each other and form
+ * many small islands, as they would in a game level.
+ */
+static void populate(RigidBodyWorld& world, size_t count)
+{
+  srand(1234);
+  world.clear();
+
+  size_t side = (size_t) ceil(sqrt(count / 10.0));
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t column = i % (side * side);
+    size_t level = i / (side * side);
+    Vector3f position(((float) (column % side) - side * 0.5f) * 2.5f + randomRange(0.2f),
+                      0.6f + level * 1.1f,
+                      ((float) (column / side) - side * 0.5f) * 2.5f + randomRange(0.2f));
+
+    if (i % 2 == 0)
+    {
+      world.addSphere(position, 0.5f, 1.0f);
+    }
+    else
+    {
+      Quaternion orientation(Vector3f(0.0f, 1.0f, 0.0f), randomRange(3.14f));
+      world.addBox(position, Vector3f(0.5f, 0.5f, 0.5f), orientation, 1.0f);
+    }
+  }
+}
+
+static void run(const char* name, size_t count, ThreadPool* pPool,
+                std::vector<Vector3f>& positions)
+{
+  const int frames = 300;
+  const float dt = 1.0f / 60.0f;
+
+  RigidBodyWorld world;
+  populate(world, count);
+
+  RigidBodyWorld::Timings sum = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double worst = 0.0;
+  for (int frame = 0; frame < frames; ++frame)
+  {
+    world.step(dt, pPool);
+    const RigidBodyWorld::Timings& t = world.getTimings();
+    sum.integrateVelocities += t.integrateVelocities;
+    sum.broadphase += t.broadphase;
+    sum.narrowphase += t.narrowphase;
+    sum.islands += t.islands;
+    sum.solver += t.solver;
+    sum.integratePositions += t.integratePositions;
+    sum.total += t.total;
+    worst = t.total > worst ? t.total : worst;
+  }
+
+  double lowest = 1e30;
+  positions.resize(world.getBodyCount());
+  for (size_t i = 0; i < world.getBodyCount(); ++i)
+  {
+    Vector3f p = world.getPosition((unsigned int) i);
+    lowest = p.y < lowest ? p.y : lowest;
+    positions[i] = p;
+  }
+
+  printf("%-8s bodies %6u  contacts %6u  islands %5u  lowest y %.3f\n", name,
+         (unsigned int) count, (unsigned int) world.getContactCount(),
+         (unsigned int) world.getIslandCount(), lowest);
+  printf("  velocities %.3f  broadphase %.3f  narrowphase %.3f  islands %.3f  "
+         "solver %.3f  positions %.3f ms\n",
+         sum.integrateVelocities / frames, sum.broadphase / frames,
+         sum.narrowphase / frames, sum.islands / frames, sum.solver / frames,
+         sum.integratePositions / frames);
+  printf("  step avg %.3f ms  worst %.3f ms  %s 60 Hz budget\n",
+         sum.total / frames, worst,
+         sum.total / frames <= 1000.0 / 60.0 ? "within" : "over");
+}
+
+int main(int argc, char** argv)
+{
+  size_t count = argc > 1 ? (size_t) atoi(argv[1]) : 10000;
+
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("Threads: %u, %d steps at 60 Hz\n", pool.getThreadCount(), 300);
+
+  std::vector<Vector3f> single, pooled;
+  run("single", count, NULL, single);
+  run("pool", count, &pool, pooled);
+
+  size_t mismatches = 0;
+  for (size_t i = 0; i < single.size(); ++i)
+  {
+    if (single[i].x != pooled[i].x || single[i].y != pooled[i].y ||
+        single[i].z != pooled[i].z)
+    {
+      ++mismatches;
+    }
+  }
+  printf("Pool and single thread %s\n", mismatches == 0 ? "match" : "DIFFER");
+
+  return mismatches == 0 ? 0 : 1;
+}
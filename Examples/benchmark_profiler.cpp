@@ -0,0 +1,137 @@
+/*
+ * @file benchmark_profiler.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures the cost of a profiling zone and a counter and exports a
+ * multithreaded capture as a Chrome trace.
+ *
+ * A zone reads the clock twice. Virtual machines often trap rdtsc, which
+ * makes the clock read dominate, so the recording cost without the clock
+ * reads is reported as well.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#define LITE_PROFILE
+#include <LiteCube\Core\Profiler.h>
+#include <LiteCube\Core\ThreadPool.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static String toString(const char* text)
+{
+  return String(text, text + strlen(text));
+}
+
+static volatile float s_sink = 0.0f;
+static volatile unsigned long long s_ticks = 0;
+
+/*
+ * A small amount of work so the loops are not optimized away.
+ */
+static void work(int i)
+{
+  s_sink = s_sink * 0.5f + (float) i;
+}
+
+static double timeLoop(const char* name, int count, int mode)
+{
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < count; ++i)
+  {
+    if (mode == 0)
+    {
+      work(i);
+    }
+    else if (mode == 1)
+    {
+      LITE_PROFILE_ZONE("zone");
+      work(i);
+    }
+    else if (mode == 2)
+    {
+      LITE_PROFILE_COUNTER("counter", i);
+      work(i);
+    }
+    else
+    {
+      s_ticks += Profiler::getTimestamp();
+      work(i);
+    }
+  }
+  double ns = elapsedMs(start) * 1e6 / count;
+  printf("  %-26s %7.2f ns\n", name, ns);
+  return ns;
+}
+
+int main(int argc, char** argv)
+{
+  int count = argc > 1 ? atoi(argv[1]) : 10000000;
+  ThreadPool& pool = ThreadPool::getDefault();
+
+  LITE_PROFILE_THREAD("Main");
+  printf("Clock: %.1f ticks/us, ring capacity: %u events, threads: %u\n",
+         Profiler::getTicksPerMicrosecond(), Profiler::RING_CAPACITY,
+         pool.getThreadCount());
+
+  printf("Per iteration, %d iterations\n", count);
+  double baseline = timeLoop("empty loop", count, 0);
+  double clock = timeLoop("clock read", count, 3) - baseline;
+  double zone = timeLoop("zone", count, 1) - baseline;
+  double counter = timeLoop("counter", count, 2) - baseline;
+  Profiler::setEnabled(false);
+  double disabled = timeLoop("zone, disabled at runtime", count, 1) - baseline;
+  Profiler::setEnabled(true);
+  printf("  overhead: zone %.2f ns, counter %.2f ns, disabled zone %.2f ns\n",
+         zone, counter, disabled);
+  printf("  zone without its two clock reads: %.2f ns\n", zone - 2.0 * clock);
+  printf("  dropped (ring wrapped): %u\n", (unsigned int) Profiler::getDroppedCount());
+
+  // A short capture with nested zones on every pool thread.
+  Profiler::clear();
+  for (int frame = 0; frame < 8; ++frame)
+  {
+    LITE_PROFILE_FRAME();
+    LITE_PROFILE_ZONE("frame");
+    pool.parallelFor(0, 64, 1, [](size_t begin, size_t end) {
+      LITE_PROFILE_ZONE("chunk");
+      for (size_t i = begin; i < end; ++i)
+      {
+        LITE_PROFILE_ZONE("item");
+        float value = 0.0f;
+        for (int j = 0; j < 2000; ++j)
+        {
+          value += sqrtf((float) (i + j));
+        }
+        s_sink = value;
+      }
+    });
+    LITE_PROFILE_COUNTER("frame index", frame);
+  }
+
+  size_t events = Profiler::getEventCount();
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  bool isExported = Profiler::exportChromeTrace(toString("benchmark_profiler.json"));
+  printf("Capture: %u events, exported in %.2f ms to benchmark_profiler.json %s\n",
+         (unsigned int) events, elapsedMs(start), isExported ? "" : "FAILED");
+
+  return isExported ? 0 : 1;
+}
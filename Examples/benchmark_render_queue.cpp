@@ -0,0 +1,187 @@
+/*
+ * @file benchmark_render_queue.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Records 10k to 1M rectangle commands on several threads with
+ * RenderQueue and compares its radix sort with std::sort and
+ * std::stable_sort on the same keys. Opaque commands sort by material and
+ * front to back, transparent ones after them back to front. The result is
+ * checked against std::stable_sort and executed on a SoftwareBackend.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Graphics\RenderQueue.h>
+#include <LiteCube\Graphics\SoftwareBackend.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+using namespace Lite;
+
+static const int WIDTH = 1280;
+static const int HEIGHT = 720;
+static const unsigned int BUFFER_COUNT = 4;
+static const int REPEATS = 5;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/*
+ * Sort key of item i of a frame's draw list.
+ */
+static SortKey makeKey(size_t i, bool& isTransparent)
+{
+  unsigned int state = (unsigned int) i * 2654435761u;
+  float depth = (state >> 8) / 16777216.0f * 100.0f;
+  isTransparent = (state & 15) < 2;
+  if (isTransparent)
+  {
+    return (1ull << 62) | ~RenderQueue::encodeDepth(depth);
+  }
+  SortKey material = (state >> 4) & 0x3FF;
+  return (material << 32) | RenderQueue::encodeDepth(depth);
+}
+
+/*
+ * Records the items of a range of a frame's draw list.
+ */
+static void record(CommandBuffer& buffer, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    bool isTransparent;
+    SortKey key = makeKey(i, isTransparent);
+    unsigned int state = (unsigned int) i * 2654435761u;
+    SoftwareBackend::RectCommand* pRect = buffer.push<SoftwareBackend::RectCommand>(
+      key, isTransparent ? SoftwareBackend::COMMAND_BLEND_RECT : SoftwareBackend::COMMAND_FILL_RECT);
+    pRect->x = (int) (state % (WIDTH - 16));
+    pRect->y = (int) ((state >> 11) % (HEIGHT - 16));
+    pRect->width = 4 + (int) (state >> 27);
+    pRect->height = 4 + (int) ((state >> 23) & 15);
+    pRect->color = isTransparent ? 0x80000000u | (state & 0xFFFFFF) : 0xFF000000u | (state >> 8);
+  }
+}
+
+static void recordFrame(RenderQueue& queue, size_t count, ThreadPool* pPool)
+{
+  queue.clear();
+  SoftwareBackend::ClearCommand clear = { 0xFF202020u };
+  queue.getBuffer(0).push(0, SoftwareBackend::COMMAND_CLEAR, &clear, sizeof(clear));
+
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end) {
+    for (size_t b = begin; b < end; ++b)
+    {
+      record(queue.getBuffer((unsigned int) b), b * count / BUFFER_COUNT,
+             (b + 1) * count / BUFFER_COUNT);
+    }
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, BUFFER_COUNT, 1, task);
+  }
+  else
+  {
+    task(0, BUFFER_COUNT);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  size_t maxCount = argc > 1 ? (size_t) atoi(argv[1]) : 1000000;
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("%u recording buffers, %u pool threads\n", BUFFER_COUNT, pool.getThreadCount());
+  printf("%9s %9s %9s %9s %9s %9s %9s %9s\n", "commands", "record", "radix", "radix mt",
+         "std::sort", "stable", "speedup", "execute");
+
+  RenderQueue queue(BUFFER_COUNT);
+  SoftwareBackend backend(WIDTH, HEIGHT, &pool);
+  bool isValid = true;
+  for (size_t count = 10000; count <= maxCount; count *= 10)
+  {
+    // Keys and indices in recording order for the baselines.
+    std::vector<std::pair<SortKey, unsigned int> > pairs, sorted;
+    std::vector<SortKey> keys(count), keysTemp(count);
+    std::vector<unsigned int> values(count), valuesTemp(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      bool isTransparent;
+      pairs.push_back(std::make_pair(makeKey(i, isTransparent), (unsigned int) i));
+    }
+
+    double recordMs = 1e30, radixMs = 1e30, radixPoolMs = 1e30, sortMs = 1e30;
+    double stableMs = 1e30;
+    for (int repeat = 0; repeat < REPEATS; ++repeat)
+    {
+      std::chrono::high_resolution_clock::time_point start =
+        std::chrono::high_resolution_clock::now();
+      recordFrame(queue, count, &pool);
+      recordMs = std::min(recordMs, elapsedMs(start));
+
+      start = std::chrono::high_resolution_clock::now();
+      queue.sort(NULL);
+      radixMs = std::min(radixMs, elapsedMs(start));
+
+      start = std::chrono::high_resolution_clock::now();
+      queue.sort(&pool);
+      radixPoolMs = std::min(radixPoolMs, elapsedMs(start));
+
+      sorted = pairs;
+      start = std::chrono::high_resolution_clock::now();
+      std::sort(sorted.begin(), sorted.end());
+      sortMs = std::min(sortMs, elapsedMs(start));
+
+      sorted = pairs;
+      start = std::chrono::high_resolution_clock::now();
+      std::stable_sort(sorted.begin(), sorted.end(),
+                       [](const std::pair<SortKey, unsigned int>& a,
+                          const std::pair<SortKey, unsigned int>& b) {
+                         return a.first < b.first;
+                       });
+      stableMs = std::min(stableMs, elapsedMs(start));
+    }
+
+    // The radix sort is stable, it must agree with std::stable_sort on
+    // every index.
+    for (size_t i = 0; i < count; ++i)
+    {
+      keys[i] = pairs[i].first;
+      values[i] = pairs[i].second;
+    }
+    RenderQueue::sortKeys(&keys[0], &values[0], count, &keysTemp[0], &valuesTemp[0], &pool);
+    for (size_t i = 0; i < count; ++i)
+    {
+      isValid = isValid && keys[i] == sorted[i].first && values[i] == sorted[i].second;
+    }
+    const RenderCommand* pCommands = queue.getCommands();
+    isValid = isValid && queue.getCommandCount() == count + 1 &&
+              pCommands[0].type == SoftwareBackend::COMMAND_CLEAR;
+    for (size_t i = 1; i < queue.getCommandCount(); ++i)
+    {
+      isValid = isValid && pCommands[i - 1].key <= pCommands[i].key;
+    }
+
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    queue.execute(backend);
+    double executeMs = elapsedMs(start);
+
+    printf("%9u %7.2fms %7.2fms %7.2fms %7.2fms %7.2fms %8.1fx %7.2fms\n", (unsigned int) count,
+           recordMs, radixMs, radixPoolMs, sortMs, stableMs, sortMs / radixPoolMs, executeMs);
+  }
+
+  printf("Sorted order matches: %s\n", isValid ? "yes" : "NO");
+  return isValid ? 0 : 1;
+}
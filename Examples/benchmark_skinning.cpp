@@ -0,0 +1,271 @@
+/*
+ * @file benchmark_skinning.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Skins 1 to 100 characters, each a bending tube of 8192 vertices
+ * with four influences per vertex on a 64 bone chain, and reports vertices
+ * per millisecond for linear blend and dual quaternion skinning, on one
+ * thread and on the pool, next to a scalar per-vertex reference. The
+ * results must match the reference.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Animation\Skinning.h>
+#include <LiteCube\Core\ThreadPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Lite;
+
+static const int BONES = 64;
+static const int RINGS = 64;
+static const int RING_VERTICES = 128;
+static const int VERTICES = RINGS * RING_VERTICES;
+static const int REPEATS = 5;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// A tube along y, bone i starts at height i. Every vertex is weighted to the
+// four bones around its height.
+static void makeMesh(std::vector<Vector3f>& positions, std::vector<Vector3f>& normals,
+                     std::vector<Skinning::BoneInfluence>& influences)
+{
+  for (int ring = 0; ring < RINGS; ++ring)
+  {
+    float height = (ring + 0.5f) * BONES / RINGS;
+    int bone = (int) height;
+    float weights[4];
+    float total = 0.0f;
+    for (int k = 0; k < 4; ++k)
+    {
+      float distance = fabsf(bone - 1 + k + 0.5f - height);
+      weights[k] = std::max(2.0f - distance, 0.0f);
+      total += weights[k];
+    }
+
+    for (int i = 0; i < RING_VERTICES; ++i)
+    {
+      float angle = 6.2831853f * i / RING_VERTICES;
+      positions.push_back(Vector3f(cosf(angle) * 0.5f, height, sinf(angle) * 0.5f));
+      normals.push_back(Vector3f(cosf(angle), 0.0f, sinf(angle)));
+
+      Skinning::BoneInfluence influence;
+      for (int k = 0; k < 4; ++k)
+      {
+        influence.bones[k] = (unsigned short) std::min(std::max(bone - 1 + k, 0), BONES - 1);
+        influence.weights[k] = weights[k] / total;
+      }
+      influences.push_back(influence);
+    }
+  }
+}
+
+// Bend the chain, every bone rotated a little against its parent. The bind
+// pose of bone i is a translation by i along y.
+static void makePose(float phase, Skinning::BoneMatrix* pMatrices,
+                     Skinning::DualQuaternion* pDualQuaternions)
+{
+  Quaternion rotation;
+  Vector3f position(0.0f, 0.0f, 0.0f);
+  for (int i = 0; i < BONES; ++i)
+  {
+    Quaternion local(Vector3f(1.0f, 0.0f, 0.3f), 0.15f * sinf(phase + i * 0.2f));
+    local.normalize();
+    rotation = rotation * local;
+    rotation.normalize();
+
+    Vector3f offset = rotation.rotate(Vector3f(0.0f, (float) i, 0.0f));
+    Vector3f translation(position.x - offset.x, position.y - offset.y, position.z - offset.z);
+    pMatrices[i] = Skinning::makeMatrix(rotation, translation);
+    pDualQuaternions[i] = Skinning::makeDualQuaternion(rotation, translation);
+
+    Vector3f up = rotation.rotate(Vector3f(0.0f, 1.0f, 0.0f));
+    position.x += up.x;
+    position.y += up.y;
+    position.z += up.z;
+  }
+}
+
+// One vertex at a time with scalar math, as skinning was done so far.
+static void skinLinearReference(const Skinning::Job& job)
+{
+  for (size_t i = 0; i < job.count; ++i)
+  {
+    const Skinning::BoneInfluence& influence = job.pInfluences[i];
+    const Vector3f& p = job.pPositions[i];
+    const Vector3f& n = job.pNormals[i];
+    float position[3] = { 0.0f, 0.0f, 0.0f }, normal[3] = { 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < 4; ++k)
+    {
+      const float* m = job.pMatrices[influence.bones[k]].m;
+      float w = influence.weights[k];
+      for (int r = 0; r < 3; ++r)
+      {
+        position[r] += w * (m[r] * p.x + m[4 + r] * p.y + m[8 + r] * p.z + m[12 + r]);
+        normal[r] += w * (m[r] * n.x + m[4 + r] * n.y + m[8 + r] * n.z);
+      }
+    }
+    float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    job.pOutPositions[i] = Vector3f(position[0], position[1], position[2]);
+    job.pOutNormals[i] = Vector3f(normal[0] / length, normal[1] / length, normal[2] / length);
+  }
+}
+
+static void skinDualQuaternionReference(const Skinning::Job& job)
+{
+  for (size_t i = 0; i < job.count; ++i)
+  {
+    const Skinning::BoneInfluence& influence = job.pInfluences[i];
+    const Quaternion& first = job.pDualQuaternions[influence.bones[0]].real;
+    Quaternion real(0.0f, 0.0f, 0.0f, 0.0f), dual(0.0f, 0.0f, 0.0f, 0.0f);
+    for (int k = 0; k < 4; ++k)
+    {
+      const Skinning::DualQuaternion& bone = job.pDualQuaternions[influence.bones[k]];
+      float w = first.dot(bone.real) < 0.0f ? -influence.weights[k] : influence.weights[k];
+      real = Quaternion(real.x + w * bone.real.x, real.y + w * bone.real.y,
+                        real.z + w * bone.real.z, real.w + w * bone.real.w);
+      dual = Quaternion(dual.x + w * bone.dual.x, dual.y + w * bone.dual.y,
+                        dual.z + w * bone.dual.z, dual.w + w * bone.dual.w);
+    }
+    float length = real.length();
+    real = Quaternion(real.x / length, real.y / length, real.z / length, real.w / length);
+    dual = Quaternion(dual.x / length, dual.y / length, dual.z / length, dual.w / length);
+
+    Quaternion t = dual * real.conjugate();
+    Vector3f rotated = real.rotate(job.pPositions[i]);
+    job.pOutPositions[i] = Vector3f(rotated.x + 2.0f * t.x, rotated.y + 2.0f * t.y,
+                                    rotated.z + 2.0f * t.z);
+    job.pOutNormals[i] = real.rotate(job.pNormals[i]);
+  }
+}
+
+static float maxError(const std::vector<Vector3f>& left, const std::vector<Vector3f>& right)
+{
+  float error = 0.0f;
+  for (size_t i = 0; i < left.size(); ++i)
+  {
+    error = std::max(error, fabsf(left[i].x - right[i].x));
+    error = std::max(error, fabsf(left[i].y - right[i].y));
+    error = std::max(error, fabsf(left[i].z - right[i].z));
+  }
+  return error;
+}
+
+int main()
+{
+  ThreadPool& pool = ThreadPool::getDefault();
+  std::vector<Vector3f> positions, normals;
+  std::vector<Skinning::BoneInfluence> influences;
+  makeMesh(positions, normals, influences);
+  printf("%d vertices and %d bones per character, %u pool threads\n", VERTICES, BONES,
+         pool.getThreadCount());
+
+  const int MAX_CHARACTERS = 100;
+  std::vector<Skinning::BoneMatrix> matrices(MAX_CHARACTERS * BONES);
+  std::vector<Skinning::DualQuaternion> dualQuaternions(MAX_CHARACTERS * BONES);
+  std::vector<Vector3f> outPositions((size_t) MAX_CHARACTERS * VERTICES);
+  std::vector<Vector3f> outNormals((size_t) MAX_CHARACTERS * VERTICES);
+  std::vector<Skinning::Job> jobs(MAX_CHARACTERS);
+  for (int c = 0; c < MAX_CHARACTERS; ++c)
+  {
+    makePose(c * 0.37f, &matrices[c * BONES], &dualQuaternions[c * BONES]);
+
+    Skinning::Job& job = jobs[c];
+    job.method = Skinning::LINEAR_BLEND;
+    job.pPositions = &positions[0];
+    job.pNormals = &normals[0];
+    job.pInfluences = &influences[0];
+    job.count = VERTICES;
+    job.pMatrices = &matrices[c * BONES];
+    job.pDualQuaternions = &dualQuaternions[c * BONES];
+    job.pOutPositions = &outPositions[(size_t) c * VERTICES];
+    job.pOutNormals = &outNormals[(size_t) c * VERTICES];
+  }
+
+  // Check against the references on the first character.
+  {
+    std::vector<Vector3f> refPositions(VERTICES), refNormals(VERTICES);
+    Skinning::Job job = jobs[0];
+    job.pOutPositions = &refPositions[0];
+    job.pOutNormals = &refNormals[0];
+
+    for (int method = 0; method < 2; ++method)
+    {
+      jobs[0].method = job.method = (Skinning::Method) method;
+      Skinning::skin(jobs[0]);
+      if (method == Skinning::LINEAR_BLEND)
+      {
+        skinLinearReference(job);
+      }
+      else
+      {
+        skinDualQuaternionReference(job);
+      }
+      std::vector<Vector3f> skinnedPositions(outPositions.begin(), outPositions.begin() + VERTICES);
+      std::vector<Vector3f> skinnedNormals(outNormals.begin(), outNormals.begin() + VERTICES);
+      printf("%s: max error %.2g (positions), %.2g (normals)\n",
+             method == Skinning::LINEAR_BLEND ? "Linear blend" : "Dual quaternion",
+             maxError(skinnedPositions, refPositions), maxError(skinnedNormals, refNormals));
+    }
+  }
+
+  printf("\n%10s %18s %10s %10s %10s\n", "characters", "method", "reference", "single", "pool");
+  int counts[] = { 1, 10, 100 };
+  for (int n = 0; n < 3; ++n)
+  {
+    int characters = counts[n];
+    for (int method = 0; method < 2; ++method)
+    {
+      for (int c = 0; c < characters; ++c)
+      {
+        jobs[c].method = (Skinning::Method) method;
+      }
+
+      double referenceMs = 1e30, singleMs = 1e30, poolMs = 1e30;
+      for (int repeat = 0; repeat < REPEATS; ++repeat)
+      {
+        std::chrono::high_resolution_clock::time_point start =
+          std::chrono::high_resolution_clock::now();
+        for (int c = 0; c < characters; ++c)
+        {
+          if (method == Skinning::LINEAR_BLEND)
+          {
+            skinLinearReference(jobs[c]);
+          }
+          else
+          {
+            skinDualQuaternionReference(jobs[c]);
+          }
+        }
+        referenceMs = std::min(referenceMs, elapsedMs(start));
+
+        start = std::chrono::high_resolution_clock::now();
+        Skinning::skin(&jobs[0], characters, NULL);
+        singleMs = std::min(singleMs, elapsedMs(start));
+
+        start = std::chrono::high_resolution_clock::now();
+        Skinning::skin(&jobs[0], characters, &pool);
+        poolMs = std::min(poolMs, elapsedMs(start));
+      }
+
+      double vertices = (double) characters * VERTICES;
+      printf("%10d %18s %10.0f %10.0f %10.0f  vertices/ms\n", characters,
+             method == Skinning::LINEAR_BLEND ? "linear blend" : "dual quaternion",
+             vertices / referenceMs, vertices / singleMs, vertices / poolMs);
+    }
+  }
+  return 0;
+}
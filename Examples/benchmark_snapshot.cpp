@@ -0,0 +1,213 @@
+/*
+ * @file benchmark_snapshot.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Replicates the positions and velocities of 10000 entities, a
+ * quarter of them moving, over an in-memory loopback transport for 60
+ * ticks. Reports bytes per entity for raw floats, raw floats through
+ * LzCompressor, quantized snapshots and quantized snapshots delta coded
+ * against the previous tick, and the time to encode and decode them. The
+ * receiver must end up with the sender's quantized values, within the
+ * error bound of each field.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\BitStream.h>
+#include <LiteCube\Core\LzCompressor.h>
+#include <LiteCube\Core\SnapshotCodec.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace Lite;
+
+static const size_t ENTITIES = 10000;
+static const int TICKS = 60;
+static const float TICK = 1.0f / 30.0f;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/*
+ * Packets sent from one end to the other in a fixed block of memory, the
+ * way a loopback socket would carry them.
+ */
+class Loopback
+{
+public:
+  Loopback(size_t capacity)
+    : m_buffer(capacity)
+    , m_size(0)
+  {
+  }
+
+  bool send(const unsigned char* pData, size_t size)
+  {
+    if (size > m_buffer.size())
+    {
+      return false;
+    }
+    memcpy(&m_buffer[0], pData, size);
+    m_size = size;
+    return true;
+  }
+
+  size_t receive(unsigned char* pData, size_t capacity)
+  {
+    size_t size = std::min(m_size, capacity);
+    memcpy(pData, &m_buffer[0], size);
+    m_size = 0;
+    return size;
+  }
+
+private:
+  std::vector<unsigned char> m_buffer;
+  size_t                     m_size;
+};
+
+static unsigned int g_state = 1;
+
+static float random(float minimum, float maximum)
+{
+  g_state = g_state * 1664525u + 1013904223u;
+  return minimum + (maximum - minimum) * ((g_state >> 8) / 16777216.0f);
+}
+
+int main()
+{
+  SnapshotCodec sender, receiver;
+  SnapshotCodec* codecs[2] = { &sender, &receiver };
+  for (int i = 0; i < 2; ++i)
+  {
+    // Positions to 2 mm within 2 km, velocities to 2 cm/s up to 32 m/s.
+    codecs[i]->addField(AABB(Vector3f(-1024.0f, -64.0f, -1024.0f),
+                             Vector3f(1024.0f, 192.0f, 1024.0f)), 20);
+    codecs[i]->addField(AABB(Vector3f(-32.0f, -32.0f, -32.0f), Vector3f(32.0f, 32.0f, 32.0f)), 12);
+    codecs[i]->setEntityCount(ENTITIES);
+  }
+
+  std::vector<Vector3f> positions(ENTITIES), velocities(ENTITIES);
+  for (size_t i = 0; i < ENTITIES; ++i)
+  {
+    positions[i] = Vector3f(random(-1000.0f, 1000.0f), random(0.0f, 20.0f),
+                            random(-1000.0f, 1000.0f));
+    if (i % 4 == 0)
+    {
+      velocities[i] = Vector3f(random(-8.0f, 8.0f), random(-1.0f, 1.0f), random(-8.0f, 8.0f));
+    }
+  }
+
+  size_t snapshotSize = sender.getSnapshotSize();
+  std::vector<unsigned int> current(snapshotSize), baseline(snapshotSize);
+  std::vector<unsigned int> received(snapshotSize), receivedBaseline(snapshotSize);
+  std::vector<unsigned char> packet(sender.getMaxEncodedSize());
+  std::vector<unsigned char> incoming(sender.getMaxEncodedSize());
+  std::vector<Vector3f> decodedPositions(ENTITIES), decodedVelocities(ENTITIES);
+  Loopback loopback(packet.size());
+
+  LzCompressor compressor;
+  std::vector<unsigned char> lzBuffer(LzCompressor::getMaxCompressedSize(ENTITIES * 24));
+  std::vector<unsigned char> raw(ENTITIES * 24);
+
+  double fullBytes = 0.0, deltaBytes = 0.0, lzBytes = 0.0;
+  double encodeMs = 0.0, decodeMs = 0.0;
+  unsigned int mismatches = 0, failures = 0;
+  float worstPosition = 0.0f, worstVelocity = 0.0f;
+  for (int tick = 0; tick <= TICKS; ++tick)
+  {
+    for (size_t i = 0; i < ENTITIES; i += 4)
+    {
+      velocities[i].x += random(-0.5f, 0.5f);
+      velocities[i].z += random(-0.5f, 0.5f);
+      positions[i] += velocities[i] * TICK;
+    }
+
+    memcpy(&raw[0], &positions[0], ENTITIES * 12);
+    memcpy(&raw[ENTITIES * 12], &velocities[0], ENTITIES * 12);
+    lzBytes += (double) compressor.compress(&raw[0], raw.size(), &lzBuffer[0]);
+
+    // Tick 0 goes out without a baseline, later ticks against the last one.
+    bool hasBaseline = tick > 0;
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    sender.quantize(0, &positions[0], &current[0]);
+    sender.quantize(1, &velocities[0], &current[0]);
+    BitWriter writer(&packet[0], packet.size());
+    bool isEncoded = sender.encode(&current[0], hasBaseline ? &baseline[0] : NULL, writer);
+    size_t size = writer.flush();
+    if (hasBaseline)
+    {
+      encodeMs += elapsedMs(start);
+      deltaBytes += (double) size;
+    }
+    else
+    {
+      fullBytes = (double) size;
+    }
+    failures += isEncoded && loopback.send(&packet[0], size) ? 0 : 1;
+
+    start = std::chrono::high_resolution_clock::now();
+    size_t incomingSize = loopback.receive(&incoming[0], incoming.size());
+    BitReader reader(&incoming[0], incomingSize);
+    bool isDecoded = receiver.decode(reader, hasBaseline ? &receivedBaseline[0] : NULL,
+                                     &received[0]);
+    receiver.dequantize(0, &received[0], &decodedPositions[0]);
+    receiver.dequantize(1, &received[0], &decodedVelocities[0]);
+    if (hasBaseline)
+    {
+      decodeMs += elapsedMs(start);
+    }
+    failures += isDecoded ? 0 : 1;
+
+    mismatches += std::equal(current.begin(), current.end(), received.begin()) ? 0 : 1;
+    for (size_t i = 0; i < ENTITIES; ++i)
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        worstPosition = std::max(worstPosition,
+                                 fabsf(decodedPositions[i].v[c] - positions[i].v[c]));
+        worstVelocity = std::max(worstVelocity,
+                                 fabsf(decodedVelocities[i].v[c] - velocities[i].v[c]));
+      }
+    }
+
+    // Both ends move on to the snapshot just delivered.
+    baseline.swap(current);
+    receivedBaseline.swap(received);
+  }
+
+  printf("%u entities, positions and velocities, %d ticks\n\n", (unsigned int) ENTITIES, TICKS);
+  printf("  raw Vector3f                 %6.2f bytes per entity\n", 24.0);
+  printf("  raw through LzCompressor     %6.2f bytes per entity\n",
+         lzBytes / (TICKS + 1) / ENTITIES);
+  printf("  quantized                    %6.2f bytes per entity\n", fullBytes / ENTITIES);
+  printf("  quantized, delta coded       %6.2f bytes per entity\n\n",
+         deltaBytes / TICKS / ENTITIES);
+
+  printf("  encode (quantize + pack)     %7.3f ms per tick, %6.0f entities/ms\n",
+         encodeMs / TICKS, ENTITIES * TICKS / encodeMs);
+  printf("  decode (unpack + dequantize) %7.3f ms per tick, %6.0f entities/ms\n\n",
+         decodeMs / TICKS, ENTITIES * TICKS / decodeMs);
+
+  Vector3f positionBound = sender.getErrorBound(0), velocityBound = sender.getErrorBound(1);
+  float positionLimit = std::max(positionBound.x, std::max(positionBound.y, positionBound.z));
+  float velocityLimit = std::max(velocityBound.x, std::max(velocityBound.y, velocityBound.z));
+  printf("  max position error %.6f of %.6f, max velocity error %.6f of %.6f%s\n",
+         worstPosition, positionLimit, worstVelocity, velocityLimit,
+         worstPosition <= positionLimit && worstVelocity <= velocityLimit ? "" : "  OVER BOUND");
+  printf("  %u snapshots differ from the sender's, %u failed to encode or decode\n",
+         mismatches, failures);
+  return 0;
+}
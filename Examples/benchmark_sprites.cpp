@@ -0,0 +1,182 @@
+/*
+ * @file benchmark_sprites.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Draws 50k rotated, scaled and tinted sprites from eight textures
+ * into a 1280x720 image with SpriteBatch and reports sprites per
+ * millisecond on one thread and on the pool. Also compares the batched
+ * Matrix3x2 point transform with transforming point by point. The images
+ * drawn on one thread and on the pool must be identical.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Graphics\Image.h>
+#include <LiteCube\Graphics\SpriteBatch.h>
+#include <LiteCube\Math\Matrix3x2.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Lite;
+
+static const int WIDTH = 1280;
+static const int HEIGHT = 720;
+static const int TEXTURE_COUNT = 8;
+static const int TEXTURE_SIZE = 32;
+static const int FRAMES = 10;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static float random(unsigned int& state, float low, float high)
+{
+  state = state * 1664525u + 1013904223u;
+  return low + (high - low) * (state >> 8) / 16777216.0f;
+}
+
+// A disc with a soft edge in a different color per texture.
+static void makeTexture(int index, Image& texture)
+{
+  texture.resize(TEXTURE_SIZE, TEXTURE_SIZE);
+  float radius = TEXTURE_SIZE * 0.5f;
+  for (int y = 0; y < TEXTURE_SIZE; ++y)
+  {
+    for (int x = 0; x < TEXTURE_SIZE; ++x)
+    {
+      float dx = x + 0.5f - radius, dy = y + 0.5f - radius;
+      float coverage = std::min(std::max(radius - sqrtf(dx * dx + dy * dy), 0.0f), 1.0f);
+      unsigned int alpha = (unsigned int) (coverage * 255.0f);
+      unsigned int rgb = ((index * 97 + x * 4) & 0xFF) << 16 | ((y * 8) & 0xFF) << 8 |
+                         ((index * 31) & 0xFF);
+      texture.getRow(y)[x] = alpha << 24 | rgb;
+    }
+  }
+}
+
+static void submit(SpriteBatch& batch, const std::vector<SpriteBatch::Sprite>& sprites,
+                   const Matrix3x2& view)
+{
+  batch.begin(view);
+  for (size_t i = 0; i < sprites.size(); ++i)
+  {
+    batch.draw(sprites[i]);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  size_t spriteCount = argc > 1 ? (size_t) atoi(argv[1]) : 50000;
+  ThreadPool& pool = ThreadPool::getDefault();
+  printf("%dx%d, %u sprites, %u pool threads\n", WIDTH, HEIGHT, (unsigned int) spriteCount,
+         pool.getThreadCount());
+
+  // Batched transform against one point at a time.
+  {
+    std::vector<Vector2f> points, batched, single;
+    unsigned int state = 1;
+    for (int i = 0; i < 1000000; ++i)
+    {
+      points.push_back(Vector2f(random(state, -100.0f, 100.0f), random(state, -100.0f, 100.0f)));
+    }
+    batched = points;
+    single = points;
+    Matrix3x2 transform = Matrix3x2::transform(Vector2f(10.0f, 20.0f), 0.3f,
+                                               Vector2f(2.0f, 0.5f), Vector2f(1.0f, 1.0f));
+
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    transform.transformPoints(&points[0], &batched[0], points.size());
+    double batchMs = elapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      Vector2f result = transform.transformPoint(points[i]);
+      single[i].x = result.x;
+      single[i].y = result.y;
+    }
+    double singleMs = elapsedMs(start);
+
+    bool isSame = true;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      isSame = isSame && fabsf(batched[i].x - single[i].x) < 1e-3f &&
+               fabsf(batched[i].y - single[i].y) < 1e-3f;
+    }
+    printf("Transform 1M points: batched %.2f ms, one by one %.2f ms (%.1fx)%s\n", batchMs,
+           singleMs, singleMs / batchMs, isSame ? "" : ", MISMATCH");
+  }
+
+  std::vector<Image> textures(TEXTURE_COUNT);
+  for (int i = 0; i < TEXTURE_COUNT; ++i)
+  {
+    makeTexture(i, textures[i]);
+  }
+
+  std::vector<SpriteBatch::Sprite> sprites(spriteCount);
+  unsigned int state = 42;
+  for (size_t i = 0; i < spriteCount; ++i)
+  {
+    SpriteBatch::Sprite& sprite = sprites[i];
+    float size = random(state, 8.0f, 24.0f);
+    sprite.pTexture = &textures[i % TEXTURE_COUNT];
+    sprite.position.x = random(state, -16.0f, WIDTH + 16.0f);
+    sprite.position.y = random(state, -16.0f, HEIGHT + 16.0f);
+    sprite.size.x = size;
+    sprite.size.y = size * random(state, 0.75f, 1.25f);
+    sprite.origin.x = 0.5f;
+    sprite.origin.y = 0.5f;
+    sprite.rotation = i % 2 == 0 ? 0.0f : random(state, 0.0f, 6.28f);
+    sprite.source[0] = 0;
+    sprite.source[1] = 0;
+    sprite.source[2] = TEXTURE_SIZE;
+    sprite.source[3] = TEXTURE_SIZE;
+    sprite.color = i % 4 == 0 ? 0xC0FF8040u : 0xFFFFFFFFu;
+    sprite.layer = (int) (i % 3);
+  }
+
+  SpriteBatch batch;
+  Image single(WIDTH, HEIGHT), pooled(WIDTH, HEIGHT);
+  Matrix3x2 view = Matrix3x2::translation(-8.0f, 4.0f);
+  double submitMs = 1e30, singleMs = 1e30, pooledMs = 1e30;
+  for (int frame = 0; frame < FRAMES; ++frame)
+  {
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    submit(batch, sprites, view);
+    submitMs = std::min(submitMs, elapsedMs(start));
+
+    single.fill(0xFF102030);
+    start = std::chrono::high_resolution_clock::now();
+    batch.end(single, NULL);
+    singleMs = std::min(singleMs, elapsedMs(start));
+
+    submit(batch, sprites, view);
+    pooled.fill(0xFF102030);
+    start = std::chrono::high_resolution_clock::now();
+    batch.end(pooled, &pool);
+    pooledMs = std::min(pooledMs, elapsedMs(start));
+  }
+
+  bool isSame = std::equal(single.getPixels(), single.getPixels() + WIDTH * HEIGHT,
+                           pooled.getPixels());
+  printf("Submit: %.2f ms, %u batches\n", submitMs, (unsigned int) batch.getBatchCount());
+  printf("Single thread: %.2f ms, %.0f sprites/ms\n", singleMs, spriteCount / singleMs);
+  printf("Thread pool:   %.2f ms, %.0f sprites/ms\n", pooledMs, spriteCount / pooledMs);
+  printf("Submit and draw on the pool: %.0f sprites/ms\n", spriteCount / (submitMs + pooledMs));
+  printf("Images match: %s\n", isSame ? "yes" : "NO");
+  return isSame ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+/*
+ * @file benchmark_text.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Draws a debug overlay of 40 lines of changing counters into a
+ * 1920x1080 image every frame and reports glyphs per millisecond with
+ * TextRenderer and GlyphAtlas against rasterizing and blending every glyph
+ * as it is drawn. Then cycles through 4000 distinct characters with an
+ * atlas too small to hold them and reports the hit rate and evictions.
+ * The built in font is used unless a TrueType file is given. The images
+ * drawn both ways must be identical.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Graphics\Font.h>
+#include <LiteCube\Graphics\GlyphAtlas.h>
+#include <LiteCube\Graphics\Image.h>
+#include <LiteCube\Graphics\TextRenderer.h>
+#include <LiteCube\Graphics\TrueTypeFont.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Lite;
+
+static const int WIDTH = 1920;
+static const int HEIGHT = 1080;
+static const int LINES = 40;
+static const int FRAMES = 200;
+static const int LARGE_SET = 4000;
+static const int LARGE_SET_FRAMES = 20;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static void formatLine(int frame, int line, char* pText, size_t size)
+{
+  snprintf(pText, size, "Counter %02d: frame %5d  value %8.3f ms  objects %6d  [%s]", line,
+           frame, (frame * 7 + line * 13) % 1000 / 37.0, (frame * 31 + line * 101) % 65536,
+           line % 3 == 0 ? "ok" : line % 3 == 1 ? "WARN" : "error");
+}
+
+// Rasterizes and blends every glyph as it is drawn, as before the atlas.
+static size_t drawReference(const Font& font, const char* pText, int x, int y,
+                            unsigned int color, Image& target)
+{
+  std::vector<unsigned char> coverage;
+  int penX = x, baseline = y + font.getAscent();
+  size_t glyphs = 0;
+  for (const char* p = pText; *p != 0; ++p)
+  {
+    GlyphMetrics metrics;
+    font.getGlyphMetrics((unsigned char) *p, metrics);
+    coverage.assign((size_t) metrics.width * metrics.height, 0);
+    if (!coverage.empty())
+    {
+      font.rasterize((unsigned char) *p, metrics, &coverage[0], metrics.width);
+    }
+
+    for (int gy = 0; gy < metrics.height; ++gy)
+    {
+      int py = baseline + metrics.top + gy;
+      for (int gx = 0; gx < metrics.width; ++gx)
+      {
+        int px = penX + metrics.left + gx;
+        if (px < 0 || py < 0 || px >= target.getWidth() || py >= target.getHeight())
+        {
+          continue;
+        }
+        unsigned int alpha = coverage[(size_t) gy * metrics.width + gx] * (color >> 24) + 128;
+        alpha = (alpha + (alpha >> 8)) >> 8;
+        unsigned int& pixel = target.getRow(py)[px];
+        unsigned int source = color | 0xFF000000, result = 0;
+        for (int channel = 0; channel < 32; channel += 8)
+        {
+          unsigned int value = ((source >> channel) & 0xFF) * alpha +
+                               ((pixel >> channel) & 0xFF) * (255 - alpha) + 128;
+          result |= ((value + (value >> 8)) >> 8) << channel;
+        }
+        pixel = result;
+      }
+    }
+    penX += metrics.advance;
+    ++glyphs;
+  }
+  return glyphs;
+}
+
+static unsigned int lineColor(int line)
+{
+  return line % 4 == 0 ? 0xFFFFFFFF : line % 4 == 1 ? 0xC000FF00 : line % 4 == 2 ? 0xFFFFD040 :
+         0x80FF4040;
+}
+
+// Encode a codepoint as UTF-8.
+static char* appendUtf8(char* pText, unsigned int codepoint)
+{
+  if (codepoint < 0x80)
+  {
+    *pText++ = (char) codepoint;
+  }
+  else if (codepoint < 0x800)
+  {
+    *pText++ = (char) (0xC0 | codepoint >> 6);
+    *pText++ = (char) (0x80 | (codepoint & 0x3F));
+  }
+  else
+  {
+    *pText++ = (char) (0xE0 | codepoint >> 12);
+    *pText++ = (char) (0x80 | ((codepoint >> 6) & 0x3F));
+    *pText++ = (char) (0x80 | (codepoint & 0x3F));
+  }
+  return pText;
+}
+
+int main(int argc, char** argv)
+{
+  BitmapFont bitmapFont(2);
+  TrueTypeFont trueTypeFont;
+  const Font* pFont = &bitmapFont;
+  if (argc > 1)
+  {
+    if (!trueTypeFont.loadFromFile(argv[1], 20.0f))
+    {
+      printf("Could not load %s\n", argv[1]);
+      return 1;
+    }
+    pFont = &trueTypeFont;
+    printf("Font: %s at 20 px\n", argv[1]);
+  }
+  else
+  {
+    printf("Font: built in 8x8, scale 2\n");
+  }
+
+  Image image(WIDTH, HEIGHT, 0xFF202020), reference(WIDTH, HEIGHT, 0xFF202020);
+  GlyphAtlas atlas(*pFont);
+  TextRenderer renderer;
+  char text[256];
+  int lineHeight = pFont->getLineHeight();
+
+  // Same frame both ways.
+  renderer.begin(image);
+  for (int line = 0; line < LINES; ++line)
+  {
+    formatLine(0, line, text, sizeof(text));
+    renderer.draw(atlas, text, 10, 10 + line * lineHeight, lineColor(line));
+    drawReference(*pFont, text, 10, 10 + line * lineHeight, lineColor(line), reference);
+  }
+  renderer.end();
+  size_t differences = 0;
+  for (int y = 0; y < HEIGHT; ++y)
+  {
+    for (int x = 0; x < WIDTH; ++x)
+    {
+      differences += image.getRow(y)[x] != reference.getRow(y)[x];
+    }
+  }
+  printf("Pixels different from the reference: %u\n\n", (unsigned int) differences);
+
+  for (int mode = 0; mode < 2; ++mode)
+  {
+    size_t glyphs = 0;
+    atlas.resetStatistics();
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+      image.fill(0xFF202020);
+      if (mode == 0)
+      {
+        for (int line = 0; line < LINES; ++line)
+        {
+          formatLine(frame, line, text, sizeof(text));
+          glyphs += drawReference(*pFont, text, 10, 10 + line * lineHeight, lineColor(line), image);
+        }
+      }
+      else
+      {
+        renderer.begin(image);
+        for (int line = 0; line < LINES; ++line)
+        {
+          formatLine(frame, line, text, sizeof(text));
+          renderer.draw(atlas, text, 10, 10 + line * lineHeight, lineColor(line));
+        }
+        renderer.end();
+        glyphs += renderer.getGlyphCount();
+      }
+    }
+    double ms = elapsedMs(start);
+    printf("%-30s %8.0f glyphs/ms %7.3f ms/frame\n",
+           mode == 0 ? "rasterize per glyph" : "atlas and batched blit", glyphs / ms, ms / FRAMES);
+    if (mode == 1)
+    {
+      size_t lookups = atlas.getHitCount() + atlas.getMissCount();
+      printf("%-30s %7.3f%% hits, %u glyphs cached\n", "", 100.0 * atlas.getHitCount() / lookups,
+             (unsigned int) atlas.getGlyphCount());
+    }
+  }
+
+  // Far more distinct glyphs than fit, 100 per line.
+  GlyphAtlas smallAtlas(*pFont, 256, 256);
+  std::vector<std::vector<char> > lines;
+  for (int first = 0; first < LARGE_SET; first += 100)
+  {
+    std::vector<char> line(100 * 3 + 1);
+    char* pEnd = &line[0];
+    for (int i = 0; i < 100; ++i)
+    {
+      pEnd = appendUtf8(pEnd, 0x4E00 + first + i);
+    }
+    *pEnd = 0;
+    lines.push_back(line);
+  }
+
+  size_t glyphs = 0, flushes = 0;
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+  for (int frame = 0; frame < LARGE_SET_FRAMES; ++frame)
+  {
+    image.fill(0xFF202020);
+    renderer.begin(image);
+    for (size_t line = 0; line < lines.size(); ++line)
+    {
+      renderer.draw(smallAtlas, &lines[line][0], 10, 10 + (int) (line % 40) * lineHeight,
+                    0xFFFFFFFF);
+      // Hot text drawn between the large set stays cached.
+      renderer.draw(smallAtlas, "FPS 60.0", WIDTH - 200, 10, 0xFFFFFF00);
+    }
+    renderer.end();
+    glyphs += renderer.getGlyphCount();
+    flushes += renderer.getFlushCount();
+  }
+  double ms = elapsedMs(start);
+  size_t lookups = smallAtlas.getHitCount() + smallAtlas.getMissCount();
+  printf("\n%d distinct glyphs, 256x256 atlas: %.0f glyphs/ms, %.1f%% hits, %u evictions, "
+         "%.1f blits/frame\n", LARGE_SET, glyphs / ms, 100.0 * smallAtlas.getHitCount() / lookups,
+         (unsigned int) smallAtlas.getEvictionCount(), (double) flushes / LARGE_SET_FRAMES);
+  return 0;
+}
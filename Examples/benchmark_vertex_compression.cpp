@@ -0,0 +1,138 @@
+/*
+ * @file benchmark_vertex_compression.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures the VertexCompression kernels on a large vertex buffer and
+ * reports the memory saved and the error of every attribute.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Geometry\VertexCompression.h>
+#include <LiteCube\Math\AABB.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static float random(float low, float high)
+{
+  return low + (high - low) * (rand() / (float) RAND_MAX);
+}
+
+static void report(const char* name, double ms, size_t count, size_t bytes)
+{
+  printf("  %-22s %8.2f ms %8.1f Mvertices/s %8.1f GB/s\n", name, ms,
+         count / ms / 1000.0, bytes / ms / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+  size_t count = argc > 1 ? (size_t) atoi(argv[1]) : 4000000;
+  const int repeats = 5;
+
+  // A terrain-like patch: positions within a box, mostly upward normals.
+  std::vector<Vector3f> positions(count), normals(count);
+  std::vector<float> uvs(count * 2);
+  AABB bounds;
+  for (size_t i = 0; i < count; ++i)
+  {
+    positions[i] = Vector3f(random(-500.0f, 500.0f), random(0.0f, 80.0f), random(-500.0f, 500.0f));
+    bounds.grow(positions[i]);
+    float nx = random(-1.0f, 1.0f), ny = random(-1.0f, 1.0f), nz = random(-1.0f, 1.0f);
+    float length = sqrtf(nx * nx + ny * ny + nz * nz);
+    normals[i] = Vector3f(nx / length, ny / length, nz / length);
+    uvs[i * 2] = random(0.0f, 1.0f);
+    uvs[i * 2 + 1] = random(0.0f, 1.0f);
+  }
+
+  std::vector<unsigned short> packedPositions(count * 3), packedUVs(count * 2);
+  std::vector<short> packedNormals(count * 2);
+  std::vector<Vector3f> decodedPositions(count), decodedNormals(count);
+  std::vector<float> decodedUVs(count * 2);
+
+  printf("%u vertices\n", (unsigned int) count);
+  double ms = 0.0;
+  std::chrono::high_resolution_clock::time_point start;
+
+  // Reference: copying the uncompressed attributes.
+  std::vector<Vector3f> copy(count);
+  start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < repeats; ++r)
+  {
+    memcpy((void*) &copy[0], &positions[0], count * sizeof(Vector3f));
+  }
+  report("copy positions", elapsedMs(start) / repeats, count, count * sizeof(Vector3f));
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < repeats; ++r)
+  {
+    VertexCompression::encodePositions(&positions[0], count, bounds, &packedPositions[0]);
+  }
+  report("encode positions", elapsedMs(start) / repeats, count, count * sizeof(Vector3f));
+  start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < repeats; ++r)
+  {
+    VertexCompression::decodePositions(&packedPositions[0], count, bounds, &decodedPositions[0]);
+  }
+  report("decode positions", elapsedMs(start) / repeats, count, count * sizeof(Vector3f));
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < repeats; ++r)
+  {
+    VertexCompression::encodeNormals(&normals[0], count, &packedNormals[0]);
+  }
+  report("encode normals", elapsedMs(start) / repeats, count, count * sizeof(Vector3f));
+  start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < repeats; ++r)
+  {
+    VertexCompression::decodeNormals(&packedNormals[0], count, &decodedNormals[0]);
+  }
+  report("decode normals", elapsedMs(start) / repeats, count, count * sizeof(Vector3f));
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < repeats; ++r)
+  {
+    VertexCompression::encodeHalf(&uvs[0], count * 2, &packedUVs[0]);
+  }
+  report("encode uvs (half)", elapsedMs(start) / repeats, count, count * 2 * sizeof(float));
+  start = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r < repeats; ++r)
+  {
+    VertexCompression::decodeHalf(&packedUVs[0], count * 2, &decodedUVs[0]);
+  }
+  ms = elapsedMs(start) / repeats;
+  report("decode uvs (half)", ms, count, count * 2 * sizeof(float));
+
+  Vector3f bound = VertexCompression::getPositionErrorBound(bounds);
+  printf("Errors\n");
+  printf("  positions: %g (bound %g)\n",
+         VertexCompression::measurePositionError(&positions[0], &decodedPositions[0], count),
+         sqrtf(bound.x * bound.x + bound.y * bound.y + bound.z * bound.z));
+  printf("  normals:   %g rad\n",
+         VertexCompression::measureNormalError(&normals[0], &decodedNormals[0], count));
+  printf("  uvs:       %g relative (bound %g)\n",
+         VertexCompression::measureHalfError(&uvs[0], &decodedUVs[0], count * 2),
+         1.0 / 2048.0);
+
+  size_t rawBytes = sizeof(Vector3f) * 2 + 2 * sizeof(float);
+  size_t packedBytes = 3 * sizeof(unsigned short) + 2 * sizeof(short) + 2 * sizeof(unsigned short);
+  printf("Vertex size: %u -> %u bytes (%.2fx smaller)\n", (unsigned int) rawBytes,
+         (unsigned int) packedBytes, rawBytes / (double) packedBytes);
+  return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * @file benchmark_weld.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Measures VertexWelder on a triangle soup against the quadratic
+ * epsilon scan it replaces and against std::unordered_map keyed by
+ * Vector3f.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Core\ThreadPool.h>
+#include <LiteCube\Geometry\VertexWelder.h>
+#include <LiteCube\Math\VectorHash.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+using namespace Lite;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static float jitter(float amount)
+{
+  return ((rand() / (float) RAND_MAX) * 2.0f - 1.0f) * amount;
+}
+
+/*
+ * Every quad of a wavy grid as two triangles with their own corners, like
+ * an exported soup. Corners are shuffled in blocks to defeat locality, and
+ * a small jitter models the rounding of the exporter.
+ */
+static void makeSoup(int side, float noise, std::vector<Vector3f>& points)
+{
+  points.clear();
+  const int corners[6][2] = { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 1, 0 } };
+  for (int z = 0; z + 1 < side; ++z)
+  {
+    for (int x = 0; x + 1 < side; ++x)
+    {
+      for (int c = 0; c < 6; ++c)
+      {
+        float px = (float) (x + corners[c][0]);
+        float pz = (float) (z + corners[c][1]);
+        points.push_back(Vector3f(px + jitter(noise), sinf(px * 0.1f) * cosf(pz * 0.1f) + jitter(noise),
+                                  pz + jitter(noise)));
+      }
+    }
+  }
+  for (size_t i = points.size() - 1; i > 0; --i)
+  {
+    size_t j = ((size_t) rand() * (RAND_MAX + 1u) + rand()) % (i + 1);
+    Vector3f t = points[i];
+    points[i] = points[j];
+    points[j] = t;
+  }
+}
+
+/*
+ * The pass being replaced: compare against every point kept so far.
+ */
+static size_t weldQuadratic(const std::vector<Vector3f>& points, float tolerance,
+                            std::vector<unsigned int>& remap, std::vector<Vector3f>& unique)
+{
+  unique.clear();
+  remap.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const Vector3f& p = points[i];
+    size_t u = 0;
+    for (; u < unique.size(); ++u)
+    {
+      float dx = unique[u].x - p.x, dy = unique[u].y - p.y, dz = unique[u].z - p.z;
+      if (dx * dx + dy * dy + dz * dz <= tolerance * tolerance)
+      {
+        break;
+      }
+    }
+    if (u == unique.size())
+    {
+      unique.push_back(p);
+    }
+    remap[i] = (unsigned int) u;
+  }
+  return unique.size();
+}
+
+int main(int argc, char** argv)
+{
+  int side = argc > 1 ? atoi(argv[1]) : 1000;
+  const float tolerance = 1e-3f;
+
+  ThreadPool& pool = ThreadPool::getDefault();
+  VertexWelder welder;
+  std::vector<Vector3f> points, unique;
+  std::vector<unsigned int> remap, reference;
+  printf("Threads: %u\n", pool.getThreadCount());
+
+  // Small soup, where the quadratic scan still finishes.
+  makeSoup(60, tolerance * 0.1f, points);
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+  size_t expected = weldQuadratic(points, tolerance, reference, unique);
+  double quadraticMs = elapsedMs(start);
+  start = std::chrono::high_resolution_clock::now();
+  size_t welded = welder.weld(&points[0], points.size(), tolerance, remap, unique);
+  double welderMs = elapsedMs(start);
+  bool isSame = welded == expected && remap == reference;
+  printf("%u points, tolerance %g\n", (unsigned int) points.size(), tolerance);
+  printf("  %-26s %9.2f ms  unique: %u\n", "epsilon scan", quadraticMs, (unsigned int) expected);
+  printf("  %-26s %9.2f ms  unique: %u, same result: %s\n", "VertexWelder", welderMs,
+         (unsigned int) welded, isSame ? "yes" : "NO");
+
+  // Exactly duplicated corners.
+  makeSoup(side, 0.0f, points);
+  double count = (double) points.size();
+  printf("%u points, exact\n", (unsigned int) points.size());
+
+  start = std::chrono::high_resolution_clock::now();
+  std::unordered_map<Vector3f, unsigned int, std::hash<Vector3f>, Vector3fExactEqual> map;
+  map.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    map.insert(std::make_pair(points[i], (unsigned int) map.size()));
+  }
+  double mapMs = elapsedMs(start);
+  printf("  %-26s %9.1f ms %8.1f Mpoints/s  unique: %u\n", "std::unordered_map", mapMs,
+         count / mapMs / 1000.0, (unsigned int) map.size());
+
+  start = std::chrono::high_resolution_clock::now();
+  welded = welder.weld(&points[0], points.size(), 0.0f, remap, unique, &pool);
+  welderMs = elapsedMs(start);
+  isSame = isSame && welded == map.size();
+  printf("  %-26s %9.1f ms %8.1f Mpoints/s  unique: %u\n", "VertexWelder exact", welderMs,
+         count / welderMs / 1000.0, (unsigned int) welded);
+
+  // Near duplicates.
+  makeSoup(side, tolerance * 0.1f, points);
+  printf("%u points, tolerance %g\n", (unsigned int) points.size(), tolerance);
+  start = std::chrono::high_resolution_clock::now();
+  welded = welder.weld(&points[0], points.size(), tolerance, remap, unique);
+  welderMs = elapsedMs(start);
+  printf("  %-26s %9.1f ms %8.1f Mpoints/s  unique: %u\n", "VertexWelder single", welderMs,
+         count / welderMs / 1000.0, (unsigned int) welded);
+  start = std::chrono::high_resolution_clock::now();
+  welded = welder.weld(&points[0], points.size(), tolerance, remap, unique, &pool);
+  welderMs = elapsedMs(start);
+  isSame = isSame && welded == (size_t) side * side;
+  printf("  %-26s %9.1f ms %8.1f Mpoints/s  unique: %u (expected %u)\n", "VertexWelder pool",
+         welderMs, count / welderMs / 1000.0, (unsigned int) welded, (unsigned int) (side * side));
+
+  return isSame ? 0 : 1;
+}
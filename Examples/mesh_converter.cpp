@@ -0,0 +1,57 @@
+/*
+ * @file mesh_converter.cpp
+ * @author Ivan Dortulov(ivandortulov@yahoo.com)
+ *
+ * @brief Converts a Wavefront OBJ file to the binary MeshFile format.
+ *
+ * Usage: mesh_converter input.obj output.lcm
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include <LiteCube\Geometry\Mesh.h>
+#include <LiteCube\Geometry\MeshFile.h>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace Lite;
+
+int main(int argc, char** argv)
+{
+  if (argc != 3)
+  {
+    printf("Usage: %s input.obj output.lcm\n", argv[0]);
+    return 1;
+  }
+
+  Mesh mesh;
+  if (!mesh.loadObj(String(argv[1], argv[1] + strlen(argv[1]))))
+  {
+    printf("Failed to read %s\n", argv[1]);
+    return 1;
+  }
+
+  String output(argv[2], argv[2] + strlen(argv[2]));
+  if (!MeshFile::write(output, mesh))
+  {
+    printf("Failed to write %s\n", argv[2]);
+    return 1;
+  }
+
+  MeshFile file;
+  if (!file.open(output) || !file.verify())
+  {
+    printf("Verification of %s failed\n", argv[2]);
+    return 1;
+  }
+
+  printf("%s: %u vertices, %u triangles%s%s\n", argv[2],
+         (unsigned int) mesh.getVertexCount(), (unsigned int) mesh.getTriangleCount(),
+         mesh.hasNormals() ? ", normals" : "", mesh.hasUVs() ? ", uvs" : "");
+  return 0;
+}
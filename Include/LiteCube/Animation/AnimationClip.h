@@ -0,0 +1,124 @@
+/**
+ * @file AnimationClip.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the AnimationClip class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef ANIMATIONCLIP_H
+#define ANIMATIONCLIP_H
+
+#include "..\LiteDefines.h"
+
+#include <vector>
+
+namespace Lite
+{
+
+/**
+ * @class AnimationClip
+ * @brief A set of keyframed tracks sampled together.
+ *
+ * A track animates a Vector3f, such as a translation or a scale, or a
+ * rotation stored as a quaternion. Key times are kept in timelines shared
+ * by every track with identical times, as is the case for baked clips, and
+ * a Cursor remembers the current key of every timeline. For playback that
+ * moves forward the key is found by stepping from the cached one instead of
+ * a binary search per track.
+ *
+ * Hermite keys are converted to the equivalent Bezier control points when
+ * added, so both are evaluated the same way. Rotation keys are flipped to
+ * the hemisphere of the previous key and interpolated componentwise, then
+ * normalized. Values are stored as four floats per key, or four 16 bit
+ * values in a per-track range when the clip is quantized.
+ *
+ * sample() evaluates four tracks of the same kind at a time with SSE2,
+ * transposing their keys so that the output is written as a structure of
+ * arrays, one array per component indexed by track.
+ */
+class LITE_API AnimationClip
+{
+public:
+  enum TrackType
+  {
+    TRACK_VECTOR,
+    TRACK_ROTATION
+  };
+
+  enum Interpolation
+  {
+    INTERPOLATION_LINEAR,
+    INTERPOLATION_HERMITE,
+    INTERPOLATION_BEZIER
+  };
+
+  /**
+   * @brief Playback state of one instance of a clip.
+   */
+  struct Cursor
+  {
+    std::vector<unsigned int> keys;      /**< Current key per timeline */
+    std::vector<float>        factors;   /**< Position between keys per timeline */
+  };
+
+  static const unsigned int INVALID_TRACK = 0xFFFFFFFF;
+
+  // Forward steps from the cached key before switching to a binary search.
+  static const unsigned int MAX_KEY_STEPS = 4;
+
+public:
+  explicit AnimationClip(bool isQuantized = false);
+
+public:
+  unsigned int addTrack(TrackType type, Interpolation interpolation, const float* pTimes,
+                        size_t keyCount, const float* pValues);
+  void clear();
+
+  size_t getTrackCount() const;
+  size_t getTimelineCount() const;
+  float getDuration() const;
+  bool isQuantized() const;
+  size_t getMemoryUsage() const;
+
+  void sample(float time, Cursor& cursor, float* pX, float* pY, float* pZ, float* pW) const;
+
+private:
+  struct Timeline
+  {
+    size_t       offset;
+    unsigned int keyCount;
+  };
+
+  struct Track
+  {
+    TrackType    type;
+    bool         isCubic;
+    unsigned int timeline;
+    size_t       offset;
+    float        scale[4];
+    float        bias[4];
+  };
+
+  unsigned int addTimeline(const float* pTimes, size_t keyCount);
+  void sampleGroup(const unsigned int tracks[4], bool isRotation, bool isCubic,
+                   const Cursor& cursor, float* const pOut[4]) const;
+
+private:
+  bool                        m_isQuantized;
+  std::vector<float>          m_times;
+  std::vector<Timeline>       m_timelines;
+  std::vector<Track>          m_tracks;
+  std::vector<unsigned int>   m_groups[4];
+  std::vector<float>          m_values;
+  std::vector<unsigned short> m_quantized;
+  float                       m_duration;
+};
+
+}
+#endif  // ANIMATIONCLIP_H
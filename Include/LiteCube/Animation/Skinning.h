@@ -0,0 +1,114 @@
+/**
+ * @file Skinning.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Skinning class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef SKINNING_H
+#define SKINNING_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Quaternion.h"
+#include "..\Math\Vector3f.h"
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class Skinning
+ * @brief Deforms bind pose vertices by a palette of bone transforms.
+ *
+ * Every vertex is influenced by up to four bones whose weights add up to 1.
+ * Unused influences have a weight of 0.
+ *
+ * - Linear blend skinning sums the weighted bone matrices and transforms
+ *   the vertex by the result. Normals are transformed by the same matrix
+ *   and normalized, which is exact for rotations and uniform scale.
+ * - Dual quaternion skinning sums the weighted rigid transforms as dual
+ *   quaternions, flipping those in the opposite hemisphere of the first
+ *   influence, and normalizes the result. Joints keep their volume instead
+ *   of collapsing when twisted, but scale is not supported.
+ *
+ * A bone matrix is loaded as two 8 float halves, so with AVX2 blending a
+ * vertex takes two multiply-adds per influence. SSE2 uses four, and a
+ * scalar path is kept for other targets. Several meshes, for example one
+ * per character, are skinned by one call so that the thread pool splits
+ * their vertices evenly regardless of how many there are.
+ */
+class LITE_API Skinning
+{
+public:
+  /**
+   * @brief The bones influencing a vertex and their weights.
+   */
+  struct BoneInfluence
+  {
+    unsigned short bones[4];
+    float          weights[4];
+  };
+
+  /**
+   * @brief A column-major 4x4 affine transform, m[12..14] is the translation.
+   */
+  struct BoneMatrix
+  {
+    float m[16];
+  };
+
+  /**
+   * @brief A rigid transform, dual = 0.5 * translation * real.
+   */
+  struct DualQuaternion
+  {
+    Quaternion real;
+    Quaternion dual;
+  };
+
+  enum Method
+  {
+    LINEAR_BLEND,
+    DUAL_QUATERNION
+  };
+
+  /**
+   * @brief One mesh to skin with its palette and output.
+   */
+  struct Job
+  {
+    Method                method;
+    const Vector3f*       pPositions;
+    const Vector3f*       pNormals;          /**< NULL to skip normals */
+    const BoneInfluence*  pInfluences;
+    size_t                count;
+    const BoneMatrix*     pMatrices;         /**< Palette for LINEAR_BLEND */
+    const DualQuaternion* pDualQuaternions;  /**< Palette for DUAL_QUATERNION */
+    Vector3f*             pOutPositions;
+    Vector3f*             pOutNormals;       /**< Unused if pNormals is NULL */
+  };
+
+  static const size_t GRAIN_SIZE = 4096;
+
+public:
+  static BoneMatrix makeMatrix(const Quaternion& rotation, const Vector3f& translation);
+  static DualQuaternion makeDualQuaternion(const Quaternion& rotation,
+                                           const Vector3f& translation);
+  static void toDualQuaternions(const BoneMatrix* pMatrices, size_t count,
+                                DualQuaternion* pOut);
+
+  static void skin(const Job& job, ThreadPool* pPool = NULL);
+  static void skin(const Job* pJobs, size_t jobCount, ThreadPool* pPool = NULL);
+
+private:
+  Skinning();
+};
+
+}
+#endif  // SKINNING_H
@@ -0,0 +1,164 @@
+/**
+ * @file AssetStreamer.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the AssetStreamer class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef ASSETSTREAMER_H
+#define ASSETSTREAMER_H
+
+#include "..\LiteDefines.h"
+#include "AsyncFileReader.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class AssetStreamer
+ * @brief Loads files in the background in priority order.
+ *
+ * Requests wait in a priority queue until one of a limited number of read
+ * slots is free, so their priority can be changed or the request cancelled
+ * while the camera moves. Files are read with an AsyncFileReader driven by
+ * a dedicated I/O thread, or with blocking reads on the thread pool when
+ * asynchronous I/O is not available. An optional decode function runs on
+ * the pool once the data is in memory.
+ *
+ * Finished requests are handed to their callback from update(), which never
+ * blocks and is meant to be called once per frame.
+ */
+class LITE_API AssetStreamer
+{
+public:
+  typedef unsigned int RequestId;
+
+  enum Status
+  {
+    STATUS_PENDING,
+    STATUS_READING,
+    STATUS_DECODING,
+    STATUS_COMPLETE,
+    STATUS_FAILED,
+    STATUS_CANCELLED
+  };
+
+  typedef std::function<bool (std::vector<unsigned char>& data)> DecodeTask;
+  typedef std::function<void (RequestId id, Status status,
+                              std::vector<unsigned char>& data)> CompletionCallback;
+
+  /**
+   * @brief Streaming statistics since construction or resetMetrics().
+   */
+  struct Metrics
+  {
+    size_t             queueDepth;
+    size_t             readsInFlight;
+    size_t             decodesInFlight;
+    size_t             readyCount;
+    size_t             completedCount;
+    size_t             failedCount;
+    size_t             cancelledCount;
+    unsigned long long bytesRead;
+    double             bytesPerSecond;
+    double             averageLatencyMs;
+    double             maxLatencyMs;
+    bool               isAsyncIO;
+  };
+
+  static const RequestId INVALID_REQUEST = 0;
+  static const unsigned int DEFAULT_MAX_READS = 8;
+
+public:
+  explicit AssetStreamer(ThreadPool* pPool = NULL, unsigned int maxReads = DEFAULT_MAX_READS,
+                         bool useAsyncIO = true);
+  ~AssetStreamer();
+
+public:
+  RequestId request(const String& path, float priority, const DecodeTask& decode,
+                    const CompletionCallback& callback);
+  bool reprioritize(RequestId id, float priority);
+  bool cancel(RequestId id);
+
+  size_t update(size_t maxCompletions = 0);
+  bool isIdle();
+
+  void getMetrics(Metrics& metrics);
+  void resetMetrics();
+
+private:
+  struct Request;
+
+  /*
+   * Priority queue entry. Changing a priority pushes a new entry, entries
+   * whose version no longer matches their request are skipped.
+   */
+  struct QueueEntry
+  {
+    float        priority;
+    unsigned int sequence;
+    unsigned int version;
+    RequestId    id;
+
+    bool operator <(const QueueEntry& other) const;
+  };
+
+  typedef std::chrono::steady_clock Clock;
+
+  AssetStreamer(const AssetStreamer&);
+  AssetStreamer& operator =(const AssetStreamer&);
+
+  void push(Request* pRequest);
+  void rebuildQueue();
+  void dispatch();
+  void readBlocking(Request* pRequest);
+  void onRead(Request* pRequest, bool isSuccess, bool isOnPool);
+  void onDecoded(Request* pRequest, bool isSuccess);
+  void finish(Request* pRequest, Status status);
+  void ioMain();
+
+private:
+  ThreadPool*                            m_pPool;
+  AsyncFileReader                        m_reader;
+  std::thread                            m_ioThread;
+  std::mutex                             m_mutex;
+  std::unordered_map<RequestId, Request*> m_requests;
+  std::vector<QueueEntry>                m_queue;
+  std::deque<Request*>                   m_ready;
+  std::vector<Request*>                  m_delivered;
+  unsigned int                           m_maxReads;
+  unsigned int                           m_sequence;
+  RequestId                              m_nextId;
+  size_t                                 m_pending;
+  size_t                                 m_reads;
+  size_t                                 m_decodes;
+  size_t                                 m_callbacks;
+  bool                                   m_isDispatching;
+  bool                                   m_isStopping;
+
+  Clock::time_point                      m_metricsStart;
+  unsigned long long                     m_bytesRead;
+  size_t                                 m_completedCount;
+  size_t                                 m_failedCount;
+  size_t                                 m_cancelledCount;
+  double                                 m_latencySumMs;
+  double                                 m_maxLatencyMs;
+};
+
+}
+#endif  // ASSETSTREAMER_H
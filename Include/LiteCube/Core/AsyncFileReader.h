@@ -0,0 +1,81 @@
+/**
+ * @file AsyncFileReader.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the AsyncFileReader class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef ASYNCFILEREADER_H
+#define ASYNCFILEREADER_H
+
+#include "..\LiteDefines.h"
+
+#include <mutex>
+#include <vector>
+
+namespace Lite
+{
+
+/**
+ * @class AsyncFileReader
+ * @brief Reads whole files with asynchronous OS file I/O.
+ *
+ * Reads are started from any thread and complete independently of each
+ * other. A single thread collects the finished reads with poll(), each
+ * read is identified by the user data pointer passed when it was started.
+ * On Windows the reads go through overlapped I/O on a completion port.
+ */
+class LITE_API AsyncFileReader
+{
+public:
+  static const unsigned int MAX_READ_SIZE = 16 << 20;
+  static const unsigned int WAIT_FOREVER = 0xFFFFFFFF;
+
+  /**
+   * @brief A finished read.
+   */
+  struct Completion
+  {
+    void*  pUserData;
+    size_t bytesRead;
+    bool   isSuccess;
+  };
+
+public:
+  AsyncFileReader();
+  ~AsyncFileReader();
+
+public:
+  bool open();
+  void close();
+  bool isOpen() const;
+
+  bool read(const String& path, std::vector<unsigned char>& data, void* pUserData);
+  bool cancel(void* pUserData);
+
+  size_t poll(Completion* pCompletions, size_t maxCount, unsigned int timeoutMs);
+  void wake();
+
+private:
+  struct ReadOperation;
+
+  AsyncFileReader(const AsyncFileReader&);
+  AsyncFileReader& operator =(const AsyncFileReader&);
+
+  bool issue(ReadOperation* pOperation);
+  void remove(ReadOperation* pOperation);
+
+private:
+  void*                       m_port;
+  std::vector<ReadOperation*> m_operations;
+  std::mutex                  m_mutex;
+};
+
+}
+#endif  // ASYNCFILEREADER_H
@@ -0,0 +1,81 @@
+/**
+ * @file BitStream.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the BitWriter and BitReader classes
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef BITSTREAM_H
+#define BITSTREAM_H
+
+#include "..\LiteDefines.h"
+
+namespace Lite
+{
+
+/**
+ * @class BitWriter
+ * @brief Packs values of 1 to 32 bits into a caller owned buffer.
+ *
+ * Bits are collected in a 64 bit register and stored 32 at a time, least
+ * significant bit first, so the writer never allocates. Writing past the
+ * end of the buffer drops the bits and marks the writer as overflowed.
+ */
+class LITE_API BitWriter
+{
+public:
+  BitWriter(unsigned char* pBuffer, size_t capacity);
+
+public:
+  void write(unsigned int value, unsigned int bits);
+  void write(const unsigned int* pValues, size_t count, unsigned int bits);
+  size_t flush();
+
+  size_t getBitCount() const;
+  bool hasOverflowed() const;
+
+private:
+  unsigned char*     m_pBuffer;
+  size_t             m_capacity;
+  size_t             m_size;
+  unsigned long long m_scratch;
+  unsigned int       m_scratchBits;
+  bool               m_hasOverflowed;
+};
+
+/**
+ * @class BitReader
+ * @brief Reads values written by a BitWriter.
+ *
+ * Reading past the end of the data gives zero bits and marks the reader as
+ * overflowed.
+ */
+class LITE_API BitReader
+{
+public:
+  BitReader(const unsigned char* pData, size_t size);
+
+public:
+  unsigned int read(unsigned int bits);
+  void read(unsigned int* pValues, size_t count, unsigned int bits);
+
+  size_t getBitCount() const;
+  bool hasOverflowed() const;
+
+private:
+  const unsigned char* m_pData;
+  size_t               m_size;
+  size_t               m_position;
+  size_t               m_bitCount;
+  unsigned long long   m_scratch;
+  unsigned int         m_scratchBits;
+};
+
+}
+#endif  // BITSTREAM_H
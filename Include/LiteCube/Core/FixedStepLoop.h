@@ -0,0 +1,126 @@
+/**
+ * @file FixedStepLoop.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the FixedStepLoop class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef FIXEDSTEPLOOP_H
+#define FIXEDSTEPLOOP_H
+
+#include "..\LiteDefines.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Lite
+{
+class Window;
+
+/**
+ * @class FixedStepLoop
+ * @brief Application loop running the simulation at a fixed time step.
+ *
+ * Elapsed time goes into an accumulator and the simulation steps while it
+ * holds a whole step, so the simulation does not depend on the frame rate.
+ * An update runs at most a fixed number of steps and a long update counts
+ * as a limited time. When the steps cannot keep up, the time they are
+ * behind is dropped instead of growing the work of every following update.
+ *
+ * Rendering gets the time to show, which lies between the last two steps:
+ * on one thread it is a step behind the simulation plus the accumulated
+ * time, getAlpha() gives the same as a fraction of the step. With separate
+ * threads the simulation runs on its own thread against the clock and the
+ * rendering shows the time one step behind the clock, the state is passed
+ * through a TransformBuffer.
+ *
+ * With a time source set the loop reads time from it instead of the clock,
+ * so that a run on one thread gives the same steps every time. A threaded
+ * run calls it from both threads, it must then be thread safe.
+ */
+class LITE_API FixedStepLoop
+{
+public:
+  typedef std::function<void (double time, float step)> StepFunction;
+  typedef std::function<void (double time)> RenderFunction;
+  typedef std::function<bool ()> PollFunction;
+  typedef std::function<double ()> TimeSource;
+
+  static const unsigned int DEFAULT_MAX_STEPS = 5;
+
+  /**
+   * @brief Steps and frames since reset().
+   */
+  struct Stats
+  {
+    unsigned long long stepCount;
+    unsigned long long updateCount;       /**< Calls of advance() */
+    unsigned long long frameCount;        /**< Frames rendered by run() */
+    unsigned long long cappedUpdateCount; /**< Updates that dropped time */
+    unsigned int       maxUpdateSteps;    /**< Most steps run in an update */
+    double             simulatedTime;
+    double             droppedTime;       /**< Time the steps fell behind */
+  };
+
+public:
+  FixedStepLoop();
+  ~FixedStepLoop();
+
+public:
+  void setStep(double seconds);
+  double getStep() const;
+  void setMaxSteps(unsigned int steps);
+  void setMaxUpdateTime(double seconds);
+  void setTimeSource(const TimeSource& source);
+
+  void setStepFunction(const StepFunction& function);
+  void setRenderFunction(const RenderFunction& function);
+
+  unsigned int advance(double elapsed);
+  double getTime() const;
+  float getAlpha() const;
+  double getRenderTime() const;
+
+  void run(const PollFunction& poll, bool isThreaded = false);
+  void run(Window& window, bool isThreaded = false);
+  void stop();
+  void reset();
+
+  void getStats(Stats& stats) const;
+
+private:
+  FixedStepLoop(const FixedStepLoop&);
+  FixedStepLoop& operator =(const FixedStepLoop&);
+
+  double now() const;
+  unsigned int advance(double elapsed, double clock);
+  void simulationMain();
+
+private:
+  double             m_step;
+  unsigned int       m_maxSteps;
+  double             m_maxUpdateTime;
+  TimeSource         m_timeSource;
+  StepFunction       m_stepFunction;
+  RenderFunction     m_renderFunction;
+
+  double             m_time;
+  double             m_accumulator;
+  double             m_lastClock;
+  bool               m_isThreaded;
+  std::atomic<bool>  m_isRunning;
+  std::thread        m_simulation;
+  mutable std::mutex m_mutex;
+  Stats              m_stats;
+};
+
+}
+#endif  // FIXEDSTEPLOOP_H
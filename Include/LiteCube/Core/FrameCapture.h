@@ -0,0 +1,160 @@
+/**
+ * @file FrameCapture.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the FrameCapture class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include "..\LiteDefines.h"
+#include "LzCompressor.h"
+
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class FrameCapture
+ * @brief Records 32 bit frames to a file without stalling the frame loop.
+ *
+ * A frame is copied into one of a fixed number of pooled buffers, the
+ * number is derived from a memory budget. Encoding (a byte delta filter and
+ * LzCompressor) runs on the thread pool and a writer thread appends the
+ * frames to the file in submission order.
+ *
+ * When more than half of the buffers are busy the pipeline is falling
+ * behind and new frames are stored at half resolution. When no buffer is
+ * free the frame is dropped. Both are counted in the statistics and
+ * visible in the file through the frame flags and gaps in the frame index.
+ *
+ * The file starts with a FileHeader, each frame is a FrameHeader followed
+ * by the compressed data, which decodeFrame() turns back into pixels.
+ */
+class LITE_API FrameCapture
+{
+public:
+  static const size_t DEFAULT_MEMORY_BUDGET = 256 << 20;
+  static const unsigned int MIN_BUFFERS = 2;
+  static const unsigned int FILE_VERSION = 1;
+
+  enum FrameFlags
+  {
+    FRAME_DOWNSAMPLED = 1
+  };
+
+  struct FileHeader
+  {
+    char         magic[4];
+    unsigned int version;
+    unsigned int width;
+    unsigned int height;
+  };
+
+  struct FrameHeader
+  {
+    unsigned int index;
+    unsigned int width;
+    unsigned int height;
+    unsigned int flags;
+    unsigned int compressedSize;
+  };
+
+  /**
+   * @brief Capture statistics since open().
+   */
+  struct Stats
+  {
+    size_t             framesSubmitted;
+    size_t             framesWritten;
+    size_t             framesDropped;
+    size_t             framesDownsampled;
+    size_t             buffersInUse;
+    size_t             bufferCount;
+    size_t             memoryUsed;
+    unsigned long long bytesCaptured;
+    unsigned long long bytesWritten;
+    double             averageEncodeMs;
+  };
+
+public:
+  FrameCapture();
+  ~FrameCapture();
+
+public:
+  bool open(const String& path, int width, int height,
+            size_t memoryBudget = DEFAULT_MEMORY_BUDGET, ThreadPool* pPool = NULL);
+  void close();
+  bool isOpen() const;
+
+  int getWidth() const;
+  int getHeight() const;
+
+  unsigned char* beginFrame(size_t& stride);
+  void endFrame();
+  void cancelFrame();
+  bool submitFrame(const unsigned char* pPixels, size_t stride);
+
+  void getStats(Stats& stats);
+
+  static bool decodeFrame(const FrameHeader& header, const unsigned char* pData,
+                          std::vector<unsigned char>& pixels);
+
+private:
+  /*
+   * A pooled frame buffer with its compressed output.
+   */
+  struct Slot
+  {
+    std::vector<unsigned char> pixels;
+    std::vector<unsigned char> compressed;
+    LzCompressor               compressor;
+    FrameHeader                header;
+    unsigned int               sequence;
+  };
+
+  FrameCapture(const FrameCapture&);
+  FrameCapture& operator =(const FrameCapture&);
+
+  void encode(Slot* pSlot);
+  void writerMain();
+
+private:
+  ThreadPool*                   m_pPool;
+  std::ofstream                 m_file;
+  std::thread                   m_writer;
+  std::mutex                    m_mutex;
+  std::condition_variable       m_condition;
+  std::vector<Slot*>            m_slots;
+  std::vector<Slot*>            m_freeSlots;
+  std::map<unsigned int, Slot*> m_encoded;
+  Slot*                         m_pCurrent;
+  int                           m_width;
+  int                           m_height;
+  size_t                        m_slotLimit;
+  unsigned int                  m_frameIndex;
+  unsigned int                  m_nextSequence;
+  unsigned int                  m_nextWrite;
+  size_t                        m_encoding;
+  bool                          m_isOpen;
+  bool                          m_isClosing;
+  Stats                         m_stats;
+  double                        m_encodeMs;
+};
+
+}
+#endif  // FRAMECAPTURE_H
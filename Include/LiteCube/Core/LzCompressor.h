@@ -0,0 +1,53 @@
+/**
+ * @file LzCompressor.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the LzCompressor class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef LZCOMPRESSOR_H
+#define LZCOMPRESSOR_H
+
+#include "..\LiteDefines.h"
+
+#include <vector>
+
+namespace Lite
+{
+
+/**
+ * @class LzCompressor
+ * @brief Fast lossless LZ77 compression in the LZ4 block format.
+ *
+ * Matches are found through a hash table of 4 byte sequences with a single
+ * candidate per entry, and the search step grows over incompressible data,
+ * trading ratio for speed. The table lives in the object, so one compressor
+ * per thread is needed. Decompression does not need an object.
+ */
+class LITE_API LzCompressor
+{
+public:
+  static const unsigned int HASH_BITS = 14;
+
+public:
+  LzCompressor();
+
+public:
+  size_t compress(const unsigned char* pSource, size_t size, unsigned char* pDestination);
+
+  static size_t getMaxCompressedSize(size_t size);
+  static bool decompress(const unsigned char* pSource, size_t size,
+                         unsigned char* pDestination, size_t decompressedSize);
+
+private:
+  std::vector<unsigned int> m_table;
+};
+
+}
+#endif  // LZCOMPRESSOR_H
@@ -0,0 +1,55 @@
+/**
+ * @file MappedFile.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the MappedFile class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "..\LiteDefines.h"
+
+namespace Lite
+{
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file mapped into the address space.
+ *
+ * Pages are loaded by the OS on first access, so opening a file is cheap
+ * regardless of its size and untouched parts are never read.
+ */
+class LITE_API MappedFile
+{
+public:
+  MappedFile();
+  ~MappedFile();
+
+public:
+  bool open(const String& path);
+  void close();
+
+  bool isOpen() const;
+  const void* getData() const;
+  size_t getSize() const;
+
+private:
+  MappedFile(const MappedFile&);
+  MappedFile& operator =(const MappedFile&);
+
+private:
+  void*       m_file;
+  void*       m_mapping;
+  const void* m_pData;
+  size_t      m_size;
+};
+
+}
+#endif  // MAPPEDFILE_H
@@ -0,0 +1,161 @@
+/**
+ * @file Profiler.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Profiler and ProfileZone classes
+ *        and the profiling macros
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "..\LiteDefines.h"
+
+#include <atomic>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace Lite
+{
+
+/**
+ * @class Profiler
+ * @brief Collects timed zones, counters and frame markers from all threads.
+ *
+ * Every thread records into its own ring buffer without taking locks, once
+ * a ring is full the oldest events are overwritten. The ring of a thread
+ * that exits is kept for export and handed to the next thread that starts
+ * recording, so memory is bounded by the number of threads alive at once.
+ * Names are stored by pointer and must outlive the profiler, string
+ * literals are the intended use. The collected events are written as
+ * Chrome trace JSON, which both chrome://tracing and Perfetto open.
+ *
+ * Instrumentation should go through the LITE_PROFILE_* macros below, they
+ * expand to nothing unless LITE_PROFILE is defined.
+ */
+class LITE_API Profiler
+{
+public:
+  static const unsigned int RING_CAPACITY = 1 << 16;
+
+public:
+  static unsigned long long getTimestamp();
+
+  static void setEnabled(bool isEnabled);
+  static bool isEnabled();
+
+  static void setThreadName(const char* pName);
+
+  static void recordZone(const char* pName, unsigned long long start,
+                         unsigned long long end);
+  static void recordCounter(const char* pName, double value);
+  static void markFrame();
+
+  static size_t getEventCount();
+  static size_t getDroppedCount();
+  static double getTicksPerMicrosecond();
+
+  static void clear();
+  static bool exportChromeTrace(const String& path);
+
+private:
+  Profiler();
+
+private:
+  static std::atomic<bool> s_isEnabled;
+};
+
+/**
+ * @class ProfileZone
+ * @brief Records the lifetime of a scope as a zone.
+ *
+ * The clock is read only when the profiler is enabled on entry, a disabled
+ * zone costs a single load.
+ */
+class LITE_API ProfileZone
+{
+public:
+  explicit ProfileZone(const char* pName)
+    : m_pName(pName)
+    , m_start(Profiler::isEnabled() ? Profiler::getTimestamp() : 0)
+  {
+  }
+
+  ~ProfileZone()
+  {
+    if (m_start != 0)
+    {
+      Profiler::recordZone(m_pName, m_start, Profiler::getTimestamp());
+    }
+  }
+
+private:
+  ProfileZone(const ProfileZone&);
+  ProfileZone& operator =(const ProfileZone&);
+
+private:
+  const char*        m_pName;
+  unsigned long long m_start;
+};
+
+/**
+ * @brief Check whether events are being recorded.
+ *
+ * @return true if recording is enabled
+ */
+inline bool Profiler::isEnabled()
+{
+  return s_isEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Read the profiler clock.
+ *
+ * Uses a bare rdtsc where available, without serializing instructions, ticks
+ * are converted to time only when the trace is exported.
+ *
+ * @return current tick count
+ */
+inline unsigned long long Profiler::getTimestamp()
+{
+#if defined(_MSC_VER) || defined(__i386__) || defined(__x86_64__)
+  return __rdtsc();
+#else
+  return (unsigned long long) std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+}
+
+#define LITE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define LITE_PROFILE_CONCAT(a, b) LITE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef LITE_PROFILE
+#define LITE_PROFILE_ZONE(name) \
+  ::Lite::ProfileZone LITE_PROFILE_CONCAT(liteProfileZone, __LINE__)(name)
+#define LITE_PROFILE_FUNCTION() LITE_PROFILE_ZONE(__FUNCTION__)
+#define LITE_PROFILE_COUNTER(name, value) \
+  ::Lite::Profiler::recordCounter(name, (double) (value))
+#define LITE_PROFILE_FRAME() ::Lite::Profiler::markFrame()
+#define LITE_PROFILE_THREAD(name) ::Lite::Profiler::setThreadName(name)
+#else
+#define LITE_PROFILE_ZONE(name) ((void) 0)
+#define LITE_PROFILE_FUNCTION() ((void) 0)
+#define LITE_PROFILE_COUNTER(name, value) ((void) 0)
+#define LITE_PROFILE_FRAME() ((void) 0)
+#define LITE_PROFILE_THREAD(name) ((void) 0)
+#endif
+
+#endif  // PROFILER_H
@@ -0,0 +1,95 @@
+/**
+ * @file SnapshotCodec.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the SnapshotCodec class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef SNAPSHOTCODEC_H
+#define SNAPSHOTCODEC_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\AABB.h"
+#include "..\Math\Vector3f.h"
+#include "BitStream.h"
+
+#include <vector>
+
+namespace Lite
+{
+
+/**
+ * @class SnapshotCodec
+ * @brief Compact encoding of Vector3f fields of many entities for replication.
+ *
+ * Every field, for example the positions or the velocities of all entities,
+ * is quantized to a number of bits per component spanning the bounds of the
+ * field. A quantized snapshot holds one array per field component, so it is
+ * getSnapshotSize() unsigned values: component c of field f of entity e is
+ * at (f * 3 + c) * getEntityCount() + e.
+ *
+ * encode() writes the difference to a baseline snapshot the receiver
+ * already has, or the values themselves without one, in blocks of
+ * BLOCK_SIZE entities. A block starts with a bit telling whether anything
+ * changed. A changed block gives, per field component, the bit width of
+ * its largest zigzag coded difference, followed by the differences at that
+ * width. Entities at rest cost a fraction of a bit and moving ones about
+ * as many bits as they moved steps.
+ *
+ * Quantization, differences and their reconstruction run four values at a
+ * time with SSE2 and give the same results as the scalar path. Encoding
+ * and decoding never allocate, and both sides must add the same fields and
+ * entity count.
+ */
+class LITE_API SnapshotCodec
+{
+public:
+  static const unsigned int MAX_BITS = 24;
+  static const unsigned int BLOCK_SIZE = 16;
+
+public:
+  SnapshotCodec();
+
+public:
+  unsigned int addField(const AABB& bounds, unsigned int bits);
+  unsigned int getFieldCount() const;
+  Vector3f getErrorBound(unsigned int field) const;
+
+  void setEntityCount(size_t count);
+  size_t getEntityCount() const;
+  size_t getSnapshotSize() const;
+  size_t getMaxEncodedSize() const;
+
+  void quantize(unsigned int field, const Vector3f* pValues, unsigned int* pSnapshot) const;
+  void dequantize(unsigned int field, const unsigned int* pSnapshot, Vector3f* pValues) const;
+
+  bool encode(const unsigned int* pSnapshot, const unsigned int* pBaseline, BitWriter& writer);
+  bool decode(BitReader& reader, const unsigned int* pBaseline, unsigned int* pSnapshot);
+
+private:
+  struct Field
+  {
+    float        minimum[3];
+    float        scale[3];
+    float        step[3];
+    unsigned int mask;
+  };
+
+  SnapshotCodec(const SnapshotCodec&);
+  SnapshotCodec& operator =(const SnapshotCodec&);
+
+private:
+  std::vector<Field>        m_fields;
+  size_t                    m_entityCount;
+  std::vector<unsigned int> m_block;
+  std::vector<unsigned int> m_widths;
+};
+
+}
+#endif  // SNAPSHOTCODEC_H
@@ -0,0 +1,60 @@
+/**
+ * @file Span.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Span class template
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+
+namespace Lite
+{
+
+/**
+ * @class Span
+ * @brief Read-only view of a contiguous array owned by someone else.
+ *
+ * The span does not copy or free the elements, the owner must outlive it.
+ */
+template <typename T>
+class Span
+{
+public:
+  Span()
+    : m_pData(NULL)
+    , m_size(0)
+  {
+  }
+
+  Span(const T* pData, size_t size)
+    : m_pData(pData)
+    , m_size(size)
+  {
+  }
+
+public:
+  const T* data() const { return m_pData; }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  const T* begin() const { return m_pData; }
+  const T* end() const { return m_pData + m_size; }
+
+  const T& operator [](size_t index) const { return m_pData[index]; }
+
+private:
+  const T* m_pData;
+  size_t   m_size;
+};
+
+}
+#endif  // SPAN_H
@@ -0,0 +1,75 @@
+/**
+ * @file ThreadPool.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the ThreadPool class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "..\LiteDefines.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Lite
+{
+/**
+ * @class ThreadPool
+ * @brief A fixed set of worker threads executing queued tasks.
+ *
+ * Besides fire-and-forget tasks, the pool offers parallelFor() which splits
+ * an index range into chunks and blocks until all of them are done. A thread
+ * waiting in parallelFor() keeps executing queued tasks, so parallelFor() may
+ * be called recursively from inside a task.
+ */
+class LITE_API ThreadPool
+{
+public:
+  typedef std::function<void ()> Task;
+  typedef std::function<void (size_t begin, size_t end)> RangeTask;
+
+public:
+  explicit ThreadPool(unsigned int numThreads = 0);
+  ~ThreadPool();
+
+public:
+  unsigned int getThreadCount() const;
+
+  void enqueue(const Task& task);
+  void parallelFor(size_t begin, size_t end, size_t grainSize,
+                   const RangeTask& task);
+
+  bool runPendingTask();
+
+public:
+  static ThreadPool& getDefault();
+
+private:
+  ThreadPool(const ThreadPool&);
+  ThreadPool& operator =(const ThreadPool&);
+
+  void workerMain();
+
+private:
+  std::vector<std::thread> m_workers;
+  std::deque<Task> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_isStopping;
+};
+
+}
+
+#endif // THREADPOOL_H
@@ -0,0 +1,92 @@
+/**
+ * @file TransformBuffer.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the TransformBuffer class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef TRANSFORMBUFFER_H
+#define TRANSFORMBUFFER_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Quaternion.h"
+#include "..\Math\Vector3f.h"
+
+#include <mutex>
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class TransformBuffer
+ * @brief Hands positions and orientations from simulation to rendering.
+ *
+ * The simulation writes every transform into the back snapshot after a
+ * step and publishes it with the time it belongs to. Rendering acquires the
+ * latest published snapshot, keeping the one it had before, and
+ * interpolates between the two at any time in between. Publishing and
+ * acquiring only swap snapshots under a lock, so the simulation and the
+ * rendering may run on different threads. The back snapshot holds stale
+ * transforms after publish(), which is why every step writes all of them.
+ *
+ * Positions are interpolated linearly and orientations with a normalized
+ * linear interpolation along the shortest path, four at a time with SSE2.
+ */
+class LITE_API TransformBuffer
+{
+public:
+  static const size_t GRAIN_SIZE = 4096;
+
+public:
+  TransformBuffer();
+
+public:
+  void resize(size_t count);
+  size_t getCount() const;
+
+  Vector3f* getPositions();
+  Quaternion* getOrientations();
+  void publish(double time);
+
+  bool acquire();
+  double getPreviousTime() const;
+  double getCurrentTime() const;
+  void interpolate(double time, Vector3f* pPositions, Quaternion* pOrientations,
+                   ThreadPool* pPool = NULL) const;
+
+  static void interpolate(const Vector3f* pFrom, const Vector3f* pTo, float t,
+                          Vector3f* pOut, size_t count);
+  static void interpolate(const Quaternion* pFrom, const Quaternion* pTo, float t,
+                          Quaternion* pOut, size_t count);
+
+private:
+  struct Snapshot
+  {
+    double                  time;
+    std::vector<Vector3f>   positions;
+    std::vector<Quaternion> orientations;
+  };
+
+  TransformBuffer(const TransformBuffer&);
+  TransformBuffer& operator =(const TransformBuffer&);
+
+private:
+  std::mutex m_mutex;
+  Snapshot   m_back;
+  Snapshot   m_pending;
+  Snapshot   m_previous;
+  Snapshot   m_current;
+  bool       m_isPending;
+  size_t     m_acquiredCount;
+};
+
+}
+#endif  // TRANSFORMBUFFER_H
@@ -20,6 +20,8 @@
 
 namespace Lite
 {
+class FrameCapture;
+
 /**
  * @class Window
  * @brief Class representing an OS window.
@@ -58,6 +60,7 @@ public:
 
   void setSize(int width,  int height);
   void getSize(int& width, int& height) const;
+  void getClientSize(int& width, int& height) const;
 
   void setPosition(int x,  int y);
   void getPosition(int& x, int& y) const;
@@ -77,6 +80,9 @@ public:
   long handleEvent(void* pEvent);
   void pollEvents(bool all = true);
 
+  bool captureFrame(FrameCapture& capture);
+  bool present(const unsigned char* pPixels, int width, int height, size_t stride);
+
 protected:
   bool registerWindowClass();
 
@@ -0,0 +1,93 @@
+/**
+ * @file ParticleSystem.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the ParticleSystem class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Vector3f.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class ParticleSystem
+ * @brief A pool of point particles stored as structure of arrays.
+ *
+ * Every attribute lives in its own float array, so the integration kernel
+ * processes four particles per SSE instruction. Particles whose lifetime
+ * runs out are removed by moving the last particle into their slot, which
+ * keeps the arrays dense but does not preserve the order.
+ */
+class LITE_API ParticleSystem
+{
+public:
+  /**
+   * @struct Plane
+   * @brief An infinite plane particles bounce off, dot(normal, p) = distance.
+   */
+  struct Plane
+  {
+    Vector3f normal;        /**< Unit normal pointing to the free side */
+    float    distance;      /**< Signed distance of the plane from the origin */
+    float    restitution;   /**< Fraction of normal velocity kept after a bounce */
+  };
+
+  static const size_t MAX_PLANES = 8;
+
+public:
+  explicit ParticleSystem(size_t capacity);
+  ~ParticleSystem();
+
+public:
+  bool emit(const Vector3f& position, const Vector3f& velocity, float lifetime);
+  void clear();
+
+  void setGravity(const Vector3f& gravity);
+  const Vector3f& getGravity() const;
+  void setDrag(float drag);
+  float getDrag() const;
+  bool addPlane(const Plane& plane);
+  void clearPlanes();
+
+  void update(float dt, ThreadPool* pPool = NULL);
+
+  size_t getCount() const;
+  size_t getCapacity() const;
+  Vector3f getPosition(size_t index) const;
+  Vector3f getVelocity(size_t index) const;
+  float getLifetime(size_t index) const;
+
+  const float* getPositionsX() const;
+  const float* getPositionsY() const;
+  const float* getPositionsZ() const;
+
+private:
+  void integrate(size_t begin, size_t end, float dt, float damping);
+  void compact();
+
+private:
+  std::vector<float> m_px, m_py, m_pz;
+  std::vector<float> m_vx, m_vy, m_vz;
+  std::vector<float> m_life;
+  std::vector<Plane> m_planes;
+  size_t             m_count;
+  Vector3f           m_gravity;
+  float              m_drag;
+};
+
+}
+#endif  // PARTICLESYSTEM_H
@@ -0,0 +1,126 @@
+/**
+ * @file BVH.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the BVH class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef BVH_H
+#define BVH_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\AABB.h"
+#include "..\Math\Vector3f.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @struct Ray
+ * @brief A ray with a parametric interval [tMin, tMax].
+ */
+struct LITE_API Ray
+{
+  Vector3f origin;      /**< Ray origin */
+  Vector3f direction;   /**< Ray direction, does not need to be normalized */
+  float    tMin;        /**< Start of the interval, in units of direction */
+  float    tMax;        /**< End of the interval, in units of direction */
+};
+
+/**
+ * @struct RayHit
+ * @brief Result of a closest hit query.
+ */
+struct LITE_API RayHit
+{
+  float        t;         /**< Distance along the ray, in units of direction */
+  float        u;         /**< Barycentric coordinate of the second vertex */
+  float        v;         /**< Barycentric coordinate of the third vertex */
+  unsigned int triangle;  /**< Index of the hit triangle, BVH::INVALID_INDEX on a miss */
+};
+
+/**
+ * @class BVH
+ * @brief Bounding volume hierarchy over a static triangle soup.
+ *
+ * The tree is built top-down with a binned surface area heuristic. Subtrees
+ * and the binning of large nodes are distributed over a ThreadPool. Nodes
+ * are 32 bytes and siblings are stored next to each other, so both children
+ * of a node share a 64 byte cache line.
+ */
+class LITE_API BVH
+{
+public:
+  /**
+   * @struct Node
+   * @brief A 32 byte tree node.
+   *
+   * For an inner node leftFirst is the index of the left child and the right
+   * child follows it. For a leaf it is the index of the first triangle and
+   * count holds the number of triangles.
+   */
+  struct Node
+  {
+    float        bmin[3];
+    unsigned int leftFirst;
+    float        bmax[3];
+    unsigned int count;
+  };
+
+  static const unsigned int INVALID_INDEX = 0xFFFFFFFFu;
+  static const unsigned int PACKET_SIZE   = 8;
+
+public:
+  BVH();
+  ~BVH();
+
+public:
+  void build(const Vector3f* pVertices, const unsigned int* pIndices,
+             size_t triangleCount, ThreadPool* pPool = NULL);
+  void clear();
+
+  bool intersect(const Ray& ray, RayHit& hit) const;
+  bool occluded(const Ray& ray) const;
+  void intersectPacket(const Ray* pRays, RayHit* pHits, size_t count) const;
+
+  void intersect(const Ray* pRays, RayHit* pHits, size_t count,
+                 ThreadPool* pPool = NULL) const;
+  void occluded(const Ray* pRays, bool* pResults, size_t count,
+                ThreadPool* pPool = NULL) const;
+
+  AABB getBounds() const;
+  size_t getNodeCount() const;
+  size_t getTriangleCount() const;
+  const Node* getNodes() const;
+
+private:
+  struct Triangle
+  {
+    float v0[3];
+    float e1[3];
+    float e2[3];
+  };
+
+  struct BuildContext;
+
+  void buildNode(BuildContext& ctx, unsigned int nodeIndex,
+                 unsigned int first, unsigned int count, unsigned int depth);
+
+private:
+  std::vector<Node>         m_nodes;
+  std::vector<Triangle>     m_triangles;
+  std::vector<unsigned int> m_triangleIds;
+  size_t                    m_nodeCount;
+};
+
+}
+#endif  // BVH_H
@@ -0,0 +1,90 @@
+/**
+ * @file Geometry2D.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Geometry2D class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef GEOMETRY2D_H
+#define GEOMETRY2D_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Vector2f.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class Geometry2D
+ * @brief Convex hulls, triangulation, clipping and point in polygon tests
+ * on Vector2f.
+ *
+ * Every decision goes through orient(), whose sign is exact: it evaluates
+ * the determinant in double and checks it against a forward error bound,
+ * and only when the bound cannot tell the sign sums the six exact float
+ * products as a floating point expansion (Shewchuk, "Adaptive Precision
+ * Floating-Point Arithmetic and Fast Robust Geometric Predicates"). Hulls
+ * and triangulations therefore stay consistent on collinear and nearly
+ * collinear input.
+ *
+ * - convexHull() drops the points inside the quadrilateral of the extreme
+ *   points, builds the hull of every chunk of the rest with the monotone
+ *   chain, the chunks split between the threads of a pool, and merges the
+ *   chunk hulls.
+ * - triangulate() clips ears of polygons up to EAR_CLIPPING_LIMIT vertices
+ *   and splits larger ones into y-monotone pieces with a sweep line before
+ *   triangulating the pieces in linear time, O(n log n) overall.
+ * - clip() cuts a polygon with a convex one (Sutherland-Hodgman).
+ * - pointsInPolygon() sorts the edges into horizontal bands and tests each
+ *   point against the edges of its band only, four at a time with SSE2 in
+ *   float. Edges too close to a point to tell go to orient(), so the result
+ *   agrees with pointInPolygon() everywhere.
+ *
+ * Polygons are arrays of vertices in either orientation, without the first
+ * vertex repeated at the end. Triangulation expects simple polygons.
+ */
+class LITE_API Geometry2D
+{
+public:
+  static const size_t EAR_CLIPPING_LIMIT = 64;
+  static const size_t POINT_GRAIN_SIZE = 16384;
+
+public:
+  static double orient(const Vector2f& a, const Vector2f& b, const Vector2f& c);
+  static double getSignedArea(const Vector2f* pPolygon, size_t count);
+
+  static void convexHull(const Vector2f* pPoints, size_t count, std::vector<Vector2f>& hull,
+                         ThreadPool* pPool = NULL);
+
+  static bool triangulate(const Vector2f* pPolygon, size_t count,
+                          std::vector<unsigned int>& indices);
+  static bool triangulateEars(const Vector2f* pPolygon, size_t count,
+                              std::vector<unsigned int>& indices);
+  static bool triangulateMonotone(const Vector2f* pPolygon, size_t count,
+                                  std::vector<unsigned int>& indices);
+
+  static void clip(const Vector2f* pPolygon, size_t count, const Vector2f* pConvex,
+                   size_t convexCount, std::vector<Vector2f>& result);
+
+  static bool pointInPolygon(const Vector2f* pPolygon, size_t count, const Vector2f& point);
+  static void pointsInPolygon(const Vector2f* pPolygon, size_t count, const Vector2f* pPoints,
+                              size_t pointCount, unsigned char* pInside,
+                              ThreadPool* pPool = NULL);
+
+  static const char* getInstructionSet();
+
+private:
+  Geometry2D();
+};
+
+}
+#endif  // GEOMETRY2D_H
@@ -0,0 +1,79 @@
+/**
+ * @file KdTree.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the KdTree class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Vector2f.h"
+#include "..\Math\Vector3f.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class KdTree
+ * @brief Balanced k-d tree over a static point set for nearest neighbour
+ * queries.
+ *
+ * The tree is implicit: every range of points is split at its median along
+ * the axis of largest spread, so only the split axis of every median has to
+ * be stored. Ranges of LEAF_SIZE points or less are leaves.
+ *
+ * Vector2f points are stored with z = 0.
+ */
+class LITE_API KdTree
+{
+public:
+  static const unsigned int LEAF_SIZE = 8;
+
+public:
+  KdTree();
+  ~KdTree();
+
+public:
+  void build(const Vector3f* pPoints, size_t count, ThreadPool* pPool = NULL);
+  void build(const Vector2f* pPoints, size_t count, ThreadPool* pPool = NULL);
+  void clear();
+
+  size_t queryKNearest(const Vector3f& point, size_t k,
+                       unsigned int* pIndices, float* pDistancesSqr) const;
+  void queryKNearest(const Vector3f* pPoints, size_t count, size_t k,
+                     unsigned int* pIndices, float* pDistancesSqr,
+                     ThreadPool* pPool = NULL) const;
+  size_t queryRadius(const Vector3f& center, float radius,
+                     std::vector<unsigned int>& results) const;
+
+  size_t getPointCount() const;
+
+private:
+  struct Neighbours;
+
+  void buildRange(size_t begin, size_t end, ThreadPool* pPool);
+  void searchKNearest(size_t begin, size_t end, const float p[3],
+                      Neighbours& best) const;
+  void searchRadius(size_t begin, size_t end, const float c[3],
+                    float radiusSqr, std::vector<unsigned int>& results,
+                    size_t& found) const;
+
+private:
+  std::vector<float>         m_points;
+  std::vector<unsigned int>  m_ids;
+  std::vector<unsigned char> m_axes;
+};
+
+}
+#endif  // KDTREE_H
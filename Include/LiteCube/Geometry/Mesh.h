@@ -0,0 +1,56 @@
+/**
+ * @file Mesh.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Mesh class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef MESH_H
+#define MESH_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Vector2f.h"
+#include "..\Math\Vector3f.h"
+
+#include <vector>
+
+namespace Lite
+{
+
+/**
+ * @class Mesh
+ * @brief Indexed triangle mesh stored in memory.
+ *
+ * Normals and texture coordinates are optional; when present they hold one
+ * entry per position. Every three indices form a triangle.
+ */
+class LITE_API Mesh
+{
+public:
+  Mesh();
+  ~Mesh();
+
+public:
+  bool loadObj(const String& path);
+  void clear();
+
+  bool hasNormals() const;
+  bool hasUVs() const;
+  size_t getVertexCount() const;
+  size_t getTriangleCount() const;
+
+public:
+  std::vector<Vector3f>     positions;
+  std::vector<Vector3f>     normals;
+  std::vector<Vector2f>     uvs;
+  std::vector<unsigned int> indices;
+};
+
+}
+#endif  // MESH_H
@@ -0,0 +1,78 @@
+/**
+ * @file MeshFile.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the MeshFile class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef MESHFILE_H
+#define MESHFILE_H
+
+#include "..\LiteDefines.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\Span.h"
+#include "..\Math\Vector2f.h"
+#include "..\Math\Vector3f.h"
+
+namespace Lite
+{
+class Mesh;
+
+/**
+ * @class MeshFile
+ * @brief Binary mesh file read in place through a memory mapping.
+ *
+ * The file starts with a 64 byte header followed by the position, normal,
+ * texture coordinate and index sections, each aligned to SECTION_ALIGNMENT
+ * bytes. Data is stored little endian in the in-memory layout of Vector3f,
+ * Vector2f and unsigned int, so the getters return spans pointing straight
+ * into the mapped pages: opening a file neither parses nor copies anything.
+ *
+ * open() only checks that the sections fit in the file. verify() checks the
+ * checksum over the header and the sections and that every index refers to
+ * a vertex. It touches every page, so callers that trust their files can
+ * skip it.
+ */
+class LITE_API MeshFile
+{
+public:
+  static const size_t SECTION_ALIGNMENT = 64;
+
+public:
+  MeshFile();
+  ~MeshFile();
+
+public:
+  bool open(const String& path);
+  void close();
+  bool isOpen() const;
+  bool verify() const;
+
+  Span<Vector3f> getPositions() const;
+  Span<Vector3f> getNormals() const;
+  Span<Vector2f> getUVs() const;
+  Span<unsigned int> getIndices() const;
+
+  static bool write(const String& path, const Mesh& mesh);
+
+private:
+  MeshFile(const MeshFile&);
+  MeshFile& operator =(const MeshFile&);
+
+private:
+  MappedFile         m_file;
+  Span<Vector3f>     m_positions;
+  Span<Vector3f>     m_normals;
+  Span<Vector2f>     m_uvs;
+  Span<unsigned int> m_indices;
+  mutable int        m_checksumState;
+};
+
+}
+#endif  // MESHFILE_H
@@ -0,0 +1,107 @@
+/**
+ * @file MeshImporter.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the MeshImporter class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef MESHIMPORTER_H
+#define MESHIMPORTER_H
+
+#include "..\LiteDefines.h"
+
+#include <vector>
+
+namespace Lite
+{
+class Mesh;
+class ThreadPool;
+
+/**
+ * @class MeshImporter
+ * @brief Parallel importer for large Wavefront OBJ and PLY files.
+ *
+ * Files are read through a MappedFile and split into chunks that start and
+ * end on line boundaries. Each chunk is parsed on its own thread with a
+ * locale independent number parser. OBJ files are processed a window of
+ * chunks at a time, so apart from the resulting mesh the memory used stays
+ * proportional to the chunk size and thread count. OBJ face corners sharing
+ * the same position, texture coordinate and normal become one vertex
+ * through a hash table.
+ *
+ * PLY files may be ascii or binary little endian. Only the vertex (x, y, z,
+ * nx, ny, nz, u/s, v/t) and face (vertex_indices) elements are read.
+ */
+class LITE_API MeshImporter
+{
+public:
+  static const size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+public:
+  MeshImporter();
+  ~MeshImporter();
+
+public:
+  void setChunkSize(size_t bytes);
+  size_t getChunkSize() const;
+
+  bool importFile(const String& path, Mesh& mesh, ThreadPool* pPool = NULL);
+  bool importObj(const String& path, Mesh& mesh, ThreadPool* pPool = NULL);
+  bool importPly(const String& path, Mesh& mesh, ThreadPool* pPool = NULL);
+
+  bool parseObj(const char* pData, size_t size, Mesh& mesh, ThreadPool* pPool = NULL);
+  bool parsePly(const char* pData, size_t size, Mesh& mesh, ThreadPool* pPool = NULL);
+
+private:
+  struct Corner
+  {
+    int position;
+    int uv;
+    int normal;
+  };
+
+  struct ObjChunk
+  {
+    std::vector<float>  positions;
+    std::vector<float>  normals;
+    std::vector<float>  uvs;
+    std::vector<int>    corners;
+    std::vector<size_t> relativeIndices;
+    bool                isValid;
+  };
+
+  struct VertexSlot
+  {
+    Corner       corner;
+    unsigned int vertex;
+  };
+
+  void splitLines(const char* pData, size_t size, size_t firstChunk,
+                  size_t chunkCount, std::vector<size_t>& bounds) const;
+  bool mergeObjChunk(ObjChunk& chunk, Mesh& mesh);
+  unsigned int findOrAddVertex(const Corner& corner, Mesh& mesh);
+  void growVertexTable();
+
+private:
+  MeshImporter(const MeshImporter&);
+  MeshImporter& operator =(const MeshImporter&);
+
+private:
+  size_t                  m_chunkSize;
+  std::vector<float>      m_positions;
+  std::vector<float>      m_normals;
+  std::vector<float>      m_uvs;
+  std::vector<VertexSlot> m_vertexTable;
+  size_t                  m_vertexCount;
+  bool                    m_hasNormals;
+  bool                    m_hasUVs;
+};
+
+}
+#endif  // MESHIMPORTER_H
@@ -0,0 +1,68 @@
+/**
+ * @file MeshOptimizer.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the MeshOptimizer class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Vector3f.h"
+
+#include <vector>
+
+namespace Lite
+{
+class Mesh;
+
+/**
+ * @class MeshOptimizer
+ * @brief Reorders triangles and vertices of a mesh for the GPU.
+ *
+ * - optimizeVertexCache() orders the triangles with Tipsify (Sander et al.,
+ *   "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"),
+ *   which runs in linear time and keeps the post-transform cache warm.
+ * - optimizeOverdraw() sorts the clusters found by the previous step so that
+ *   outward facing clusters, likely to occlude the others, are drawn first.
+ *   Clusters start with a cold cache, so the cache efficiency is kept.
+ * - optimizeVertexFetch() renumbers the vertices in order of first use, so
+ *   vertex reads walk memory sequentially. Unused vertices are dropped.
+ *
+ * computeACMR() simulates a FIFO cache and gives the average number of
+ * vertex shader invocations per triangle, 0.5 being ideal for large grids
+ * and 3 the worst.
+ */
+class LITE_API MeshOptimizer
+{
+public:
+  static const unsigned int DEFAULT_CACHE_SIZE = 16;
+
+public:
+  static void optimizeVertexCache(unsigned int* pIndices, size_t indexCount,
+                                  size_t vertexCount,
+                                  unsigned int cacheSize = DEFAULT_CACHE_SIZE,
+                                  std::vector<unsigned int>* pClusters = NULL);
+  static void optimizeOverdraw(unsigned int* pIndices, size_t indexCount,
+                               const Vector3f* pPositions,
+                               const std::vector<unsigned int>& clusters);
+  static size_t optimizeVertexFetch(Mesh& mesh);
+  static void optimize(Mesh& mesh, unsigned int cacheSize = DEFAULT_CACHE_SIZE);
+
+  static float computeACMR(const unsigned int* pIndices, size_t indexCount,
+                           size_t vertexCount,
+                           unsigned int cacheSize = DEFAULT_CACHE_SIZE);
+
+private:
+  MeshOptimizer();
+};
+
+}
+#endif  // MESHOPTIMIZER_H
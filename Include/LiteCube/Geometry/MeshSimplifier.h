@@ -0,0 +1,121 @@
+/**
+ * @file MeshSimplifier.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the MeshSimplifier class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include "..\LiteDefines.h"
+#include "VertexWelder.h"
+
+#include <vector>
+
+namespace Lite
+{
+class Mesh;
+class ThreadPool;
+
+/**
+ * @class MeshSimplifier
+ * @brief Reduces the triangle count of a mesh with quadric error metrics.
+ *
+ * Every vertex accumulates the quadrics of the planes of its triangles
+ * (Garland and Heckbert), weighted by area, and of planes perpendicular to
+ * its border edges. Edges are collapsed into one of their end points, so
+ * normals and texture coordinates stay valid without interpolation.
+ *
+ * The collapses run in passes. A pass computes the cost of every edge in
+ * parallel, sorts them and applies the cheapest ones whose neighbourhoods
+ * do not overlap, skipping collapses that would flip a triangle or make
+ * the surface non-manifold. Vertices on attribute seams and on
+ * non-manifold edges never move; border vertices only move along the
+ * border.
+ *
+ * The quadrics are built from positions moved to the center of the mesh
+ * bounds and scaled to unit size, so the results do not depend on where
+ * the mesh is placed. Errors are distances in the units of the positions.
+ */
+class LITE_API MeshSimplifier
+{
+public:
+  MeshSimplifier();
+  ~MeshSimplifier();
+
+public:
+  size_t simplify(const Mesh& input, Mesh& output, size_t targetTriangles,
+                  float maxError, ThreadPool* pPool = NULL);
+  size_t buildLodChain(const Mesh& input, unsigned int levels, float ratio,
+                       float maxError, std::vector<Mesh>& lods,
+                       ThreadPool* pPool = NULL);
+
+  float getError() const;
+  const std::vector<float>& getLodErrors() const;
+
+private:
+  struct Quadric
+  {
+    float a2, b2, c2, d2;
+    float ab, ac, ad;
+    float bc, bd, cd;
+    float weight;
+  };
+
+  struct Collapse
+  {
+    float        cost;
+    unsigned int from;
+    unsigned int to;
+  };
+
+  enum VertexKind
+  {
+    VERTEX_INTERIOR = 0,
+    VERTEX_BORDER   = 1,
+    VERTEX_LOCKED   = 2
+  };
+
+  void prepare(const Mesh& input, ThreadPool* pPool);
+  void buildAdjacency();
+  void classifyVertices(const Mesh& input, ThreadPool* pPool);
+  void computeQuadrics(ThreadPool* pPool);
+  size_t runPass(size_t targetTriangles, float maxError, ThreadPool* pPool);
+  void evaluateCollapses(ThreadPool* pPool);
+  void sortCollapses();
+  bool computeCost(unsigned int from, unsigned int to, unsigned int edgeTriangles,
+                   float& cost) const;
+  bool isCollapseValid(unsigned int from, unsigned int to) const;
+  unsigned int countEdgeTriangles(unsigned int a, unsigned int b) const;
+  void extract(const Mesh& input, Mesh& output) const;
+
+private:
+  MeshSimplifier(const MeshSimplifier&);
+  MeshSimplifier& operator =(const MeshSimplifier&);
+
+private:
+  std::vector<float>         m_positions;
+  std::vector<Quadric>       m_quadrics;
+  std::vector<unsigned char> m_kinds;
+  std::vector<unsigned int>  m_indices;
+  std::vector<unsigned int>  m_offsets;
+  std::vector<unsigned int>  m_adjacency;
+  std::vector<Collapse>      m_collapses;
+  std::vector<Collapse>      m_sorted;
+  std::vector<unsigned char> m_isTouched;
+  std::vector<unsigned int>  m_remap;
+  std::vector<float>         m_lodErrors;
+  VertexWelder               m_welder;
+  float                      m_scale;
+  float                      m_error;
+};
+
+}
+#endif  // MESHSIMPLIFIER_H
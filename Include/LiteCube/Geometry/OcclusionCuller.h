@@ -0,0 +1,134 @@
+/**
+ * @file OcclusionCuller.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the OcclusionCuller class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef OCCLUSIONCULLER_H
+#define OCCLUSIONCULLER_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\AABB.h"
+#include "..\Math\Vector3f.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class OcclusionCuller
+ * @brief Software hierarchical depth buffer for occlusion culling.
+ *
+ * Simplified occluder meshes are rasterized into a small depth buffer which
+ * stores the reciprocal of the view depth, so that it interpolates linearly
+ * across the screen and larger values are nearer. The screen is split into
+ * bands of rows that are rasterized in parallel, several pixels at a time.
+ *
+ * A mip pyramid keeps the farthest and nearest occluder depth of every
+ * texel. A box is tested on the level where its screen rectangle covers at
+ * most 2x2 texels and, when that is not conclusive, two levels finer. Boxes
+ * crossing the near plane are always reported visible.
+ *
+ * Usage per frame: setCamera(), addOccluders() for every occluder mesh,
+ * rasterize() and then any number of testBoxes() calls.
+ */
+class LITE_API OcclusionCuller
+{
+public:
+  /**
+   * @brief Results of a testBoxes() call.
+   */
+  struct Stats
+  {
+    size_t tested;
+    size_t visible;
+    size_t occluded;
+    size_t outside;
+  };
+
+  static const int BAND_HEIGHT = 16;
+
+public:
+  OcclusionCuller(int width = 512, int height = 256);
+
+public:
+  void setCamera(const Vector3f& eye, const Vector3f& target, const Vector3f& up,
+                 float fovY, float nearPlane);
+  void clear();
+
+  void addOccluders(const Vector3f* pVertices, const unsigned int* pIndices,
+                    size_t indexCount);
+  void rasterize(ThreadPool* pPool = NULL);
+
+  bool isVisible(const AABB& box) const;
+  Stats testBoxes(const AABB* pBoxes, size_t count, unsigned char* pVisible,
+                  ThreadPool* pPool = NULL) const;
+
+  int getWidth() const;
+  int getHeight() const;
+  size_t getTriangleCount() const;
+  unsigned int getLevelCount() const;
+  const float* getDepth(unsigned int level = 0) const;
+  float getViewDepth(int x, int y) const;
+
+private:
+  /*
+   * A triangle in screen space, depth is the reciprocal view depth.
+   */
+  struct ScreenTriangle
+  {
+    float x[3];
+    float y[3];
+    float depth[3];
+  };
+
+  /*
+   * A level of the pyramid, farthest and nearest depth per texel.
+   */
+  struct Level
+  {
+    int                width;
+    int                height;
+    std::vector<float> farthest;
+    std::vector<float> nearest;
+  };
+
+  enum Result
+  {
+    RESULT_VISIBLE,
+    RESULT_OCCLUDED,
+    RESULT_OUTSIDE
+  };
+
+  void addTriangle(const float* pView0, const float* pView1, const float* pView2);
+  void project(const float* pView, float* pScreen) const;
+  void rasterizeBand(int band);
+  void buildLevel(unsigned int level, int beginRow, int endRow);
+  Result testBox(const AABB& box) const;
+  int testRect(unsigned int level, int x0, int y0, int x1, int y1, float depth) const;
+
+private:
+  int                                    m_width;
+  int                                    m_height;
+  Vector3f                               m_eye;
+  float                                  m_axes[3][3];
+  float                                  m_scaleX;
+  float                                  m_scaleY;
+  float                                  m_nearPlane;
+  std::vector<ScreenTriangle>            m_triangles;
+  std::vector<std::vector<unsigned int> > m_bins;
+  std::vector<float>                     m_depth;
+  std::vector<Level>                     m_levels;
+};
+
+}
+#endif  // OCCLUSIONCULLER_H
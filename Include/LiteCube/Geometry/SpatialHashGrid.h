@@ -0,0 +1,82 @@
+/**
+ * @file SpatialHashGrid.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the SpatialHashGrid class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef SPATIALHASHGRID_H
+#define SPATIALHASHGRID_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Vector2f.h"
+#include "..\Math\Vector3f.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class SpatialHashGrid
+ * @brief Uniform grid over an unbounded space for radius queries on
+ * moving points.
+ *
+ * Cells are hashed into a table with one slot per point, so memory does not
+ * depend on the extent of the point set. build() is a counting sort of the
+ * points by slot and is meant to be called every frame. The points are
+ * copied in slot order, so a query reads contiguous memory per cell.
+ *
+ * Vector2f points are stored with z = 0.
+ */
+class LITE_API SpatialHashGrid
+{
+public:
+  explicit SpatialHashGrid(float cellSize = 1.0f);
+  ~SpatialHashGrid();
+
+public:
+  void setCellSize(float cellSize);
+  float getCellSize() const;
+
+  void build(const Vector3f* pPoints, size_t count, ThreadPool* pPool = NULL);
+  void build(const Vector2f* pPoints, size_t count, ThreadPool* pPool = NULL);
+  void clear();
+
+  size_t queryRadius(const Vector3f& center, float radius,
+                     std::vector<unsigned int>& results) const;
+  void queryRadius(const Vector3f* pCenters, size_t count, float radius,
+                   std::vector<unsigned int>& offsets,
+                   std::vector<unsigned int>& results,
+                   ThreadPool* pPool = NULL) const;
+
+  size_t getPointCount() const;
+
+private:
+  void sortPoints(ThreadPool* pPool);
+  unsigned int slotOf(int cx, int cy, int cz) const;
+
+private:
+  float                     m_cellSize;
+  float                     m_invCellSize;
+  unsigned int              m_slotMask;
+  std::vector<unsigned int> m_slotStart;
+  std::vector<unsigned int> m_pointSlots;
+  std::vector<unsigned int> m_ids;
+  std::vector<float>        m_x;
+  std::vector<float>        m_y;
+  std::vector<float>        m_z;
+  std::vector<float>        m_inX;
+  std::vector<float>        m_inY;
+  std::vector<float>        m_inZ;
+};
+
+}
+#endif  // SPATIALHASHGRID_H
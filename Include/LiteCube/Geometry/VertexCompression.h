@@ -0,0 +1,70 @@
+/**
+ * @file VertexCompression.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the VertexCompression class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef VERTEXCOMPRESSION_H
+#define VERTEXCOMPRESSION_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\AABB.h"
+#include "..\Math\Vector3f.h"
+
+namespace Lite
+{
+
+/**
+ * @class VertexCompression
+ * @brief Encoders and decoders for compact vertex attributes.
+ *
+ * - Half floats: IEEE 754 binary16, rounded to nearest even. Relative error
+ *   at most 2^-11 in the normal range (6.1e-5 to 65504), larger values
+ *   become infinity.
+ * - Positions: three unsigned 16 bit values spanning an AABB, 6 instead of
+ *   12 bytes. See getPositionErrorBound().
+ * - Normals: octahedral mapping of a unit vector to two signed 16 bit
+ *   values, 4 instead of 12 bytes, with an angular error around 1e-4 rad.
+ *
+ * Every batch kernel handles several elements per iteration with SSE2, and
+ * with F16C for half floats when available. A scalar path gives the same
+ * results for the remaining elements and on other targets.
+ */
+class LITE_API VertexCompression
+{
+public:
+  static unsigned short floatToHalf(float value);
+  static float halfToFloat(unsigned short value);
+
+  static void encodeHalf(const float* pValues, size_t count, unsigned short* pOut);
+  static void decodeHalf(const unsigned short* pValues, size_t count, float* pOut);
+
+  static void encodePositions(const Vector3f* pPositions, size_t count,
+                              const AABB& bounds, unsigned short* pOut);
+  static void decodePositions(const unsigned short* pValues, size_t count,
+                              const AABB& bounds, Vector3f* pOut);
+  static Vector3f getPositionErrorBound(const AABB& bounds);
+
+  static void encodeNormals(const Vector3f* pNormals, size_t count, short* pOut);
+  static void decodeNormals(const short* pValues, size_t count, Vector3f* pOut);
+
+  static float measureHalfError(const float* pOriginal, const float* pDecoded,
+                                size_t count);
+  static float measurePositionError(const Vector3f* pOriginal,
+                                    const Vector3f* pDecoded, size_t count);
+  static float measureNormalError(const Vector3f* pOriginal,
+                                  const Vector3f* pDecoded, size_t count);
+
+private:
+  VertexCompression();
+};
+
+}
+#endif  // VERTEXCOMPRESSION_H
@@ -0,0 +1,88 @@
+/**
+ * @file VertexWelder.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the VertexWelder class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef VERTEXWELDER_H
+#define VERTEXWELDER_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Vector3f.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class VertexWelder
+ * @brief Merges points closer than a tolerance in linear time.
+ *
+ * Points are quantized to a grid with cells a few times larger than the
+ * tolerance and the cells are kept in an open addressing table with linear
+ * probing. Every point is compared with the representatives of its own cell
+ * and, only when it lies within the tolerance of a cell border, of the
+ * neighbouring cells across that border. A point that matches no
+ * representative becomes a new one. Points are visited in order, so the
+ * result is deterministic and the first point of a cluster is kept.
+ *
+ * A tolerance of zero welds exactly equal points only; the table is then
+ * keyed by the bits of the coordinates, consistent with Vector3fExactEqual.
+ *
+ * The tables are kept between calls to avoid reallocation.
+ */
+class LITE_API VertexWelder
+{
+public:
+  VertexWelder();
+  ~VertexWelder();
+
+public:
+  size_t weld(const Vector3f* pPoints, size_t count, float tolerance,
+              std::vector<unsigned int>& remap, std::vector<Vector3f>& unique,
+              ThreadPool* pPool = NULL);
+
+private:
+  struct PointKey
+  {
+    int          cell[3];
+    unsigned int hash;
+    unsigned int border;
+  };
+
+  struct Cell
+  {
+    int          key[3];
+    unsigned int head;
+  };
+
+  void computeKeys(const Vector3f* pPoints, size_t count, float tolerance,
+                   ThreadPool* pPool);
+  void growCells();
+  Cell* findCell(int x, int y, int z, unsigned int hash);
+  unsigned int findMatch(const Vector3f& point, const PointKey& key,
+                         const std::vector<Vector3f>& unique,
+                         float toleranceSqr);
+
+private:
+  VertexWelder(const VertexWelder&);
+  VertexWelder& operator =(const VertexWelder&);
+
+private:
+  std::vector<PointKey>     m_keys;
+  std::vector<Cell>         m_cells;
+  std::vector<unsigned int> m_next;
+  unsigned int              m_cellMask;
+};
+
+}
+#endif  // VERTEXWELDER_H
@@ -0,0 +1,150 @@
+/**
+ * @file DynamicResolution.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the DynamicResolution class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include "..\LiteDefines.h"
+#include "Image.h"
+#include "ImageOps.h"
+
+#include <chrono>
+#include <functional>
+
+namespace Lite
+{
+class ThreadPool;
+class Window;
+
+/**
+ * @class DynamicResolution
+ * @brief Scales the render resolution to hold a target frame time.
+ *
+ * Frames are rendered into a render target smaller than the window when
+ * they take too long, and present() scales it up to the client area. The
+ * time between beginFrame() and endFrame() is smoothed and one of two
+ * policies picks the scale of the next frame, applied to both axes:
+ *  - PID changes the scale by an incremental PID controller on the
+ *    relative error of the frame time, aiming a little under the target,
+ *  - hysteresis steps the scale down when frames have been over the upper
+ *    threshold, and up when they have been under the lower one, for a
+ *    number of frames in a row.
+ *
+ * With a frame time model set, endFrame() takes the frame time from the
+ * model instead of the clock, so a run gives the same decisions every
+ * time.
+ */
+class LITE_API DynamicResolution
+{
+public:
+  enum Policy
+  {
+    POLICY_PID,
+    POLICY_HYSTERESIS
+  };
+
+  /**
+   * @brief Measurements and decisions since reset().
+   */
+  struct Stats
+  {
+    float        frameMs;          /**< Time of the last frame */
+    float        averageMs;        /**< Smoothed time the policy acts on */
+    float        scale;            /**< Scale of the current render size */
+    int          renderWidth;
+    int          renderHeight;
+    unsigned int frameCount;
+    unsigned int overBudgetCount;  /**< Frames over the target time */
+    unsigned int decreaseCount;    /**< Times the render size went down */
+    unsigned int increaseCount;    /**< Times the render size went up */
+  };
+
+  /**
+   * @brief Gives the time of a frame from its index and render size.
+   */
+  typedef std::function<float (unsigned int frame, int renderWidth, int renderHeight)>
+    FrameTimeModel;
+
+  // Render widths are a multiple of this, which keeps rows SIMD friendly. They are at most the
+  // output width rounded down to it, and one block for outputs narrower than that.
+  static const int WIDTH_ALIGNMENT = 8;
+
+public:
+  DynamicResolution();
+
+public:
+  void setTargetFrameTime(float ms);
+  float getTargetFrameTime() const;
+  void setScaleRange(float minimum, float maximum);
+  void setPolicy(Policy policy);
+  Policy getPolicy() const;
+  void setPidGains(float proportional, float integral, float derivative);
+  void setHeadroom(float fraction);
+  void setHysteresis(float lowerRatio, float upperRatio, unsigned int frames, float step);
+  void setSmoothing(float factor);
+  void setFilter(ImageOps::Filter filter);
+  void setFrameTimeModel(const FrameTimeModel& model);
+
+  void setOutputSize(int width, int height);
+  void reset();
+
+  void beginFrame();
+  void endFrame();
+  void update(float frameMs);
+
+  float getScale() const;
+  int getRenderWidth() const;
+  int getRenderHeight() const;
+  Image& getRenderTarget();
+
+  bool present(Window& window, ThreadPool* pPool = NULL);
+  void getStats(Stats& stats) const;
+
+private:
+  typedef std::chrono::high_resolution_clock Clock;
+
+  DynamicResolution(const DynamicResolution&);
+  DynamicResolution& operator =(const DynamicResolution&);
+
+  void applyScale(float scale);
+
+private:
+  Policy            m_policy;
+  float             m_targetMs;
+  float             m_minScale;
+  float             m_maxScale;
+  float             m_proportional;
+  float             m_integral;
+  float             m_derivative;
+  float             m_headroom;
+  float             m_lowerRatio;
+  float             m_upperRatio;
+  unsigned int      m_hysteresisFrames;
+  float             m_hysteresisStep;
+  float             m_smoothing;
+  ImageOps::Filter  m_filter;
+  FrameTimeModel    m_model;
+
+  int               m_outputWidth;
+  int               m_outputHeight;
+  float             m_controlScale;
+  float             m_errors[2];
+  int               m_streak;
+  Clock::time_point m_frameStart;
+  Stats             m_stats;
+  Image             m_target;
+  Image             m_scaled;
+};
+
+}
+#endif  // DYNAMICRESOLUTION_H
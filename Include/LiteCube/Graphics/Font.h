@@ -0,0 +1,87 @@
+/**
+ * @file Font.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Font and BitmapFont classes
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef FONT_H
+#define FONT_H
+
+#include "..\LiteDefines.h"
+
+namespace Lite
+{
+
+/**
+ * @brief Size and placement of a rasterized glyph, in pixels.
+ */
+struct GlyphMetrics
+{
+  int width;
+  int height;
+  int left;      /**< Offset of the bitmap from the pen position */
+  int top;       /**< Offset of the bitmap from the baseline, negative above it */
+  int advance;   /**< Horizontal distance to the next pen position */
+};
+
+/**
+ * @class Font
+ * @brief A typeface at a fixed pixel size.
+ *
+ * Glyphs are rasterized into 8 bit coverage bitmaps. Codepoints the font
+ * does not contain are drawn with its replacement glyph.
+ */
+class LITE_API Font
+{
+public:
+  virtual ~Font();
+
+public:
+  virtual int getAscent() const = 0;
+  virtual int getDescent() const = 0;
+  virtual int getLineHeight() const = 0;
+  virtual int getMaxGlyphHeight() const = 0;
+
+  virtual void getGlyphMetrics(unsigned int codepoint, GlyphMetrics& metrics) const = 0;
+  virtual void rasterize(unsigned int codepoint, const GlyphMetrics& metrics,
+                         unsigned char* pCoverage, int stride) const = 0;
+};
+
+/**
+ * @class BitmapFont
+ * @brief The built in 8x8 font for printable ASCII.
+ *
+ * Every glyph is drawn as blocks of scale by scale pixels without any
+ * smoothing, which makes it suitable for debug overlays at any size.
+ */
+class LITE_API BitmapFont : public Font
+{
+public:
+  explicit BitmapFont(int scale = 1);
+  virtual ~BitmapFont();
+
+public:
+  int getScale() const;
+
+  virtual int getAscent() const;
+  virtual int getDescent() const;
+  virtual int getLineHeight() const;
+  virtual int getMaxGlyphHeight() const;
+
+  virtual void getGlyphMetrics(unsigned int codepoint, GlyphMetrics& metrics) const;
+  virtual void rasterize(unsigned int codepoint, const GlyphMetrics& metrics,
+                         unsigned char* pCoverage, int stride) const;
+
+private:
+  int m_scale;
+};
+
+}
+#endif  // FONT_H
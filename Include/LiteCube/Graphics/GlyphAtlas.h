@@ -0,0 +1,112 @@
+/**
+ * @file GlyphAtlas.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the GlyphAtlas class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include "..\LiteDefines.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace Lite
+{
+class Font;
+
+/**
+ * @class GlyphAtlas
+ * @brief Caches the rasterized glyphs of a font in one coverage bitmap.
+ *
+ * A glyph is rasterized the first time it is looked up and packed into a
+ * shelf, a row of the atlas as high as the tallest glyph of the font, next
+ * to the glyphs before it. When no shelf has room the least recently used
+ * one is emptied, so sets of glyphs larger than the atlas cycle through it.
+ *
+ * Glyphs looked up since the last call to release() are still waiting to
+ * be drawn, so their shelves are never evicted. find() returns NULL if a
+ * glyph cannot be placed because of that, and the caller has to draw what
+ * it has and release the atlas first.
+ */
+class LITE_API GlyphAtlas
+{
+public:
+  /**
+   * @brief A glyph in the atlas.
+   */
+  struct Glyph
+  {
+    unsigned short x;         /**< Position of the coverage in the atlas */
+    unsigned short y;
+    unsigned short width;
+    unsigned short height;
+    short          left;      /**< Offset of the coverage from the pen position */
+    short          top;       /**< Offset of the coverage from the baseline */
+    short          advance;
+    unsigned short shelf;
+  };
+
+  static const int DEFAULT_SIZE = 512;
+
+public:
+  explicit GlyphAtlas(const Font& font, int width = DEFAULT_SIZE, int height = DEFAULT_SIZE);
+
+public:
+  const Glyph* find(unsigned int codepoint);
+  void release();
+  void clear();
+
+  const Font& getFont() const;
+  int getWidth() const;
+  int getHeight() const;
+  const unsigned char* getPixels() const;
+
+  size_t getGlyphCount() const;
+  size_t getHitCount() const;
+  size_t getMissCount() const;
+  size_t getEvictionCount() const;
+  void resetStatistics();
+
+private:
+  struct Shelf
+  {
+    int                       used;
+    unsigned long long        lastUse;
+    std::vector<unsigned int> codepoints;
+  };
+
+  static const unsigned short NO_SHELF = 0xFFFF;
+
+  GlyphAtlas(const GlyphAtlas&);
+  GlyphAtlas& operator =(const GlyphAtlas&);
+
+  const Glyph* insert(unsigned int codepoint);
+  void evict(size_t shelf);
+
+private:
+  const Font&                             m_font;
+  int                                     m_width;
+  int                                     m_height;
+  int                                     m_shelfHeight;
+  std::vector<unsigned char>              m_pixels;
+  std::vector<Shelf>                      m_shelves;
+  std::unordered_map<unsigned int, Glyph> m_glyphs;
+  const Glyph*                            m_latin[256];
+  unsigned long long                      m_clock;
+  unsigned long long                      m_releaseClock;
+  size_t                                  m_hits;
+  size_t                                  m_misses;
+  size_t                                  m_evictions;
+};
+
+}
+#endif  // GLYPHATLAS_H
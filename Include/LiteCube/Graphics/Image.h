@@ -0,0 +1,61 @@
+/**
+ * @file Image.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Image class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include "..\LiteDefines.h"
+
+#include <vector>
+
+namespace Lite
+{
+class Window;
+
+/**
+ * @class Image
+ * @brief A 32 bit image in memory.
+ *
+ * Pixels are 0xAARRGGBB with straight alpha, which is BGRA in memory and
+ * what Window::present() expects. Rows are stored top first without
+ * padding.
+ */
+class LITE_API Image
+{
+public:
+  Image();
+  Image(int width, int height, unsigned int color = 0);
+
+public:
+  void resize(int width, int height, unsigned int color = 0);
+  void fill(unsigned int color);
+
+  int getWidth() const;
+  int getHeight() const;
+  bool isEmpty() const;
+
+  unsigned int* getPixels();
+  const unsigned int* getPixels() const;
+  unsigned int* getRow(int y);
+  const unsigned int* getRow(int y) const;
+
+  bool present(Window& window) const;
+
+private:
+  int                       m_width;
+  int                       m_height;
+  std::vector<unsigned int> m_pixels;
+};
+
+}
+#endif  // IMAGE_H
@@ -0,0 +1,72 @@
+/**
+ * @file ImageOps.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the ImageOps class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef IMAGEOPS_H
+#define IMAGEOPS_H
+
+#include "..\LiteDefines.h"
+
+namespace Lite
+{
+class Image;
+class ThreadPool;
+class Window;
+
+/**
+ * @class ImageOps
+ * @brief Scaling and pixel format conversion of 32 bit images.
+ *
+ * Scaling works on rows of the target, split between the threads of a
+ * pool, and converts pixels with SSE2 or AVX2. Every instruction set uses
+ * the same fixed point arithmetic, so results are identical everywhere:
+ *  - nearest samples the source pixel under the center of a target pixel,
+ *  - bilinear interpolates the four nearest pixels with 7 bit weights,
+ *  - box averages the source area under a target pixel, which is the
+ *    filter to use when shrinking by more than half.
+ *
+ * The conversions work on arrays of pixels and may run in place.
+ */
+class LITE_API ImageOps
+{
+public:
+  enum Filter
+  {
+    FILTER_NEAREST,
+    FILTER_BILINEAR,
+    FILTER_BOX
+  };
+
+  static const size_t ROW_GRAIN_SIZE = 16;
+  static const size_t PIXEL_GRAIN_SIZE = 65536;
+
+public:
+  static void scale(const Image& source, Image& target, Filter filter, ThreadPool* pPool = NULL);
+
+  static void swapRedBlue(const unsigned int* pSource, unsigned int* pTarget, size_t count,
+                          ThreadPool* pPool = NULL);
+  static void premultiply(const unsigned int* pSource, unsigned int* pTarget, size_t count,
+                          ThreadPool* pPool = NULL);
+  static void unpremultiply(const unsigned int* pSource, unsigned int* pTarget, size_t count,
+                            ThreadPool* pPool = NULL);
+
+  static bool present(const Image& image, Window& window, Filter filter, Image& scaled,
+                      ThreadPool* pPool = NULL);
+
+  static const char* getInstructionSet();
+
+private:
+  ImageOps();
+};
+
+}
+#endif  // IMAGEOPS_H
@@ -0,0 +1,161 @@
+/**
+ * @file RenderQueue.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the RenderQueue class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include "..\LiteDefines.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+typedef unsigned long long SortKey;
+
+/**
+ * @brief A recorded command as handed to a RenderBackend.
+ */
+struct RenderCommand
+{
+  SortKey      key;
+  unsigned int type;
+  const void*  pData;
+};
+
+/**
+ * @class RenderBackend
+ * @brief Executes sorted render commands.
+ */
+class LITE_API RenderBackend
+{
+public:
+  virtual ~RenderBackend();
+
+public:
+  virtual void execute(const RenderCommand* pCommands, size_t count) = 0;
+};
+
+/**
+ * @class CommandBuffer
+ * @brief Commands recorded by a single thread.
+ *
+ * Every command has a sort key, a type and a payload which is copied into
+ * the buffer. Memory is kept between frames, so recording stops allocating
+ * once the buffers have grown to the size of a frame.
+ */
+class LITE_API CommandBuffer
+{
+public:
+  static const size_t PAYLOAD_ALIGNMENT = 16;
+
+public:
+  CommandBuffer();
+
+public:
+  void* push(SortKey key, unsigned int type, size_t size);
+  void push(SortKey key, unsigned int type, const void* pData, size_t size);
+  void clear();
+
+  size_t getCount() const;
+
+  /**
+   * @brief Record a command with a payload of type T.
+   *
+   * @param[in] key  - sort key
+   * @param[in] type - command type
+   * @return payload to fill in, valid until the next push
+   */
+  template <typename T>
+  T* push(SortKey key, unsigned int type)
+  {
+    return static_cast<T*>(push(key, type, sizeof(T)));
+  }
+
+private:
+  friend class RenderQueue;
+
+  struct Entry
+  {
+    SortKey      key;
+    unsigned int type;
+    unsigned int offset;
+  };
+
+  std::vector<Entry>         m_entries;
+  std::vector<unsigned char> m_payload;
+};
+
+/**
+ * @class RenderQueue
+ * @brief Sorts commands recorded on several threads by key.
+ *
+ * Each recording thread owns one of the queue's command buffers. sort()
+ * merges the buffers and orders them with a least significant digit radix
+ * sort over 11 bit digits, in parallel when a pool is given: every task
+ * counts the digits of its chunk and scatters it to offsets derived from
+ * all counts. Digits which are the same for every key are skipped, so
+ * sparse keys cost fewer than the six passes of a full key. The sort is stable, ties
+ * keep the order of the buffers and of recording.
+ *
+ * Keys are built by the caller, typically a layer in the high bits
+ * followed by the pipeline state for opaque and encodeDepth() for
+ * transparent commands.
+ *
+ * Usage per frame: clear(), record into getBuffer(i) from thread i, sort()
+ * and execute() or read getCommands().
+ */
+class LITE_API RenderQueue
+{
+public:
+  static const unsigned int RADIX_BITS = 11;
+  static const unsigned int RADIX_SIZE = 1 << RADIX_BITS;
+
+public:
+  explicit RenderQueue(unsigned int bufferCount = 1);
+  ~RenderQueue();
+
+public:
+  void setBufferCount(unsigned int bufferCount);
+  unsigned int getBufferCount() const;
+  CommandBuffer& getBuffer(unsigned int index);
+
+  void clear();
+  void sort(ThreadPool* pPool = NULL);
+  void execute(RenderBackend& backend) const;
+
+  size_t getCommandCount() const;
+  const RenderCommand* getCommands() const;
+
+  static unsigned int encodeDepth(float depth);
+  static void sortKeys(SortKey* pKeys, unsigned int* pValues, size_t count,
+                       SortKey* pKeysTemp, unsigned int* pValuesTemp,
+                       ThreadPool* pPool = NULL);
+
+private:
+  RenderQueue(const RenderQueue&);
+  RenderQueue& operator =(const RenderQueue&);
+
+private:
+  std::vector<CommandBuffer*> m_buffers;
+  std::vector<SortKey>        m_keys;
+  std::vector<unsigned int>   m_values;
+  std::vector<SortKey>        m_keysTemp;
+  std::vector<unsigned int>   m_valuesTemp;
+  std::vector<RenderCommand>  m_recorded;
+  std::vector<RenderCommand>  m_commands;
+};
+
+}
+#endif  // RENDERQUEUE_H
@@ -0,0 +1,88 @@
+/**
+ * @file SoftwareBackend.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the SoftwareBackend class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef SOFTWAREBACKEND_H
+#define SOFTWAREBACKEND_H
+
+#include "..\LiteDefines.h"
+#include "RenderQueue.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+class Window;
+
+/**
+ * @class SoftwareBackend
+ * @brief Executes render commands into a 32 bit pixel buffer in memory.
+ *
+ * Pixels are 0xAARRGGBB, which is BGRA in memory and what
+ * Window::present() expects. With a pool the buffer is split into one band
+ * of rows per thread and every band executes the whole command list clipped
+ * to its rows, so the result is the same as executing in order. Commands
+ * of other types are ignored, which lets a queue carry commands for several
+ * backends.
+ */
+class LITE_API SoftwareBackend : public RenderBackend
+{
+public:
+  enum CommandType
+  {
+    COMMAND_CLEAR = 1,     /**< ClearCommand */
+    COMMAND_FILL_RECT,     /**< RectCommand, the color replaces the pixels */
+    COMMAND_BLEND_RECT     /**< RectCommand, blended with the color's alpha */
+  };
+
+  struct ClearCommand
+  {
+    unsigned int color;
+  };
+
+  struct RectCommand
+  {
+    int          x;
+    int          y;
+    int          width;
+    int          height;
+    unsigned int color;
+  };
+
+  static const int MIN_BAND_HEIGHT = 16;
+
+public:
+  SoftwareBackend(int width, int height, ThreadPool* pPool = NULL);
+  virtual ~SoftwareBackend();
+
+public:
+  virtual void execute(const RenderCommand* pCommands, size_t count);
+
+  int getWidth() const;
+  int getHeight() const;
+  const unsigned int* getPixels() const;
+
+  bool present(Window& window) const;
+
+private:
+  void executeBand(const RenderCommand* pCommands, size_t count, int beginRow, int endRow);
+
+private:
+  int                       m_width;
+  int                       m_height;
+  ThreadPool*               m_pPool;
+  std::vector<unsigned int> m_pixels;
+};
+
+}
+#endif  // SOFTWAREBACKEND_H
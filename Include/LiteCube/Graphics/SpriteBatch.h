@@ -0,0 +1,114 @@
+/**
+ * @file SpriteBatch.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the SpriteBatch class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\Matrix3x2.h"
+#include "..\Math\Vector2f.h"
+#include "RenderQueue.h"
+
+#include <map>
+#include <vector>
+
+namespace Lite
+{
+class Image;
+class ThreadPool;
+
+/**
+ * @class SpriteBatch
+ * @brief Draws large numbers of textured, rotated sprites into an Image.
+ *
+ * Sprites are collected between begin() and end(). end() sorts them by
+ * layer and then by texture, keeping the submission order otherwise, so
+ * sprites of a layer that share a texture form one batch. The corners of
+ * all sprites are then transformed by the view in bulk and every sprite
+ * becomes a parallelogram with a linear mapping from pixels to texels.
+ *
+ * The target is split into one band of rows per thread and every band
+ * draws the sorted sprites clipped to its rows, sampling the nearest texel
+ * and blending with straight alpha, four pixels at a time with SSE2.
+ */
+class LITE_API SpriteBatch
+{
+public:
+  /**
+   * @brief A sprite, a rectangle of a texture placed in the world.
+   */
+  struct Sprite
+  {
+    const Image* pTexture;
+    Vector2f     position;    /**< Where the origin is placed */
+    Vector2f     size;        /**< Size in pixels before the view */
+    Vector2f     origin;      /**< Pivot, 0 to 1 across the sprite */
+    float        rotation;    /**< Radians around the origin */
+    int          source[4];   /**< Texel rectangle: x, y, width, height,
+                                   clipped to the texture when drawn */
+    unsigned int color;       /**< Tint multiplied with the texels */
+    int          layer;       /**< Lower layers are drawn first */
+  };
+
+  static const int MIN_BAND_HEIGHT = 16;
+
+public:
+  SpriteBatch();
+
+public:
+  void begin(const Matrix3x2& view = Matrix3x2::Identity);
+  void draw(const Sprite& sprite);
+  void draw(const Image* pTexture, const Vector2f& position, int layer = 0);
+  void end(Image& target, ThreadPool* pPool = NULL);
+
+  size_t getSpriteCount() const;
+  size_t getBatchCount() const;
+
+private:
+  /*
+   * A transformed sprite: its bounds in pixels and the mapping from pixel
+   * centers to texels, u = uAxis[0] * x + uAxis[1] * y + uAxis[2].
+   */
+  struct Quad
+  {
+    const Image* pTexture;
+    unsigned int color;
+    int          bounds[4];
+    int          source[4];
+    float        sAxis[3];
+    float        tAxis[3];
+  };
+
+  SpriteBatch(const SpriteBatch&);
+  SpriteBatch& operator =(const SpriteBatch&);
+
+  void buildQuads(size_t begin, size_t end, int width, int height);
+  void rasterizeBand(Image& target, int beginRow, int endRow) const;
+
+private:
+  Matrix3x2                            m_view;
+  std::vector<Sprite>                  m_sprites;
+  std::map<const Image*, unsigned int> m_textureIds;
+  const Image*                         m_pLastTexture;
+  unsigned int                         m_lastTextureId;
+  std::vector<SortKey>                 m_keys;
+  std::vector<SortKey>                 m_keysTemp;
+  std::vector<unsigned int>            m_order;
+  std::vector<unsigned int>            m_orderTemp;
+  std::vector<Vector2f>                m_corners;
+  std::vector<Quad>                    m_quads;
+  size_t                               m_batchCount;
+};
+
+}
+#endif  // SPRITEBATCH_H
@@ -0,0 +1,80 @@
+/**
+ * @file TextRenderer.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the TextRenderer class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef TEXTRENDERER_H
+#define TEXTRENDERER_H
+
+#include "..\LiteDefines.h"
+
+#include <vector>
+
+namespace Lite
+{
+class GlyphAtlas;
+class Image;
+
+/**
+ * @class TextRenderer
+ * @brief Draws UTF-8 text into an Image with glyphs from GlyphAtlas.
+ *
+ * Strings drawn between begin() and end() are laid out immediately into
+ * glyph quads, clipped to the target, and blitted together by end() in
+ * the order they were drawn. Coverage is blended in the color of its
+ * string four pixels at a time with SSE2. The quads are kept between
+ * frames, so drawing does not allocate once they have grown to the size
+ * of a frame.
+ *
+ * If an atlas runs out of room for glyphs during a frame, the quads so
+ * far are blitted early and the atlas is released, so any amount of text
+ * can be drawn with an atlas of any size.
+ */
+class LITE_API TextRenderer
+{
+public:
+  TextRenderer();
+
+public:
+  void begin(Image& target);
+  void draw(GlyphAtlas& atlas, const char* pText, int x, int y, unsigned int color);
+  void end();
+
+  size_t getGlyphCount() const;
+  size_t getFlushCount() const;
+
+private:
+  struct Quad
+  {
+    const unsigned char* pCoverage;
+    int                  stride;
+    int                  x;
+    int                  y;
+    int                  width;
+    int                  height;
+    unsigned int         color;
+  };
+
+  TextRenderer(const TextRenderer&);
+  TextRenderer& operator =(const TextRenderer&);
+
+  void flush();
+
+private:
+  Image*                   m_pTarget;
+  std::vector<Quad>        m_quads;
+  std::vector<GlyphAtlas*> m_atlases;
+  size_t                   m_glyphCount;
+  size_t                   m_flushCount;
+};
+
+}
+#endif  // TEXTRENDERER_H
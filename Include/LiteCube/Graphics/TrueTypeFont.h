@@ -0,0 +1,91 @@
+/**
+ * @file TrueTypeFont.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the TrueTypeFont class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef TRUETYPEFONT_H
+#define TRUETYPEFONT_H
+
+#include "..\LiteDefines.h"
+#include "Font.h"
+
+#include <vector>
+
+namespace Lite
+{
+
+/**
+ * @class TrueTypeFont
+ * @brief A font with quadratic outlines read from a TrueType file.
+ *
+ * Only what is needed to draw unhinted glyphs is read: the character map
+ * (formats 4 and 12), horizontal metrics and simple and composite glyphs.
+ * Outlines are flattened into lines and rasterized with exact area
+ * coverage, accumulated per row, so glyphs are antialiased without
+ * supersampling. Kerning, hinting and CFF outlines are not supported.
+ */
+class LITE_API TrueTypeFont : public Font
+{
+public:
+  TrueTypeFont();
+  virtual ~TrueTypeFont();
+
+public:
+  bool load(const void* pData, size_t size, float pixelHeight);
+  bool loadFromFile(const String& path, float pixelHeight);
+  bool isLoaded() const;
+  float getPixelHeight() const;
+
+  virtual int getAscent() const;
+  virtual int getDescent() const;
+  virtual int getLineHeight() const;
+  virtual int getMaxGlyphHeight() const;
+
+  virtual void getGlyphMetrics(unsigned int codepoint, GlyphMetrics& metrics) const;
+  virtual void rasterize(unsigned int codepoint, const GlyphMetrics& metrics,
+                         unsigned char* pCoverage, int stride) const;
+
+private:
+  struct Point
+  {
+    float x;
+    float y;
+    bool  isOnCurve;
+  };
+
+  TrueTypeFont(const TrueTypeFont&);
+  TrueTypeFont& operator =(const TrueTypeFont&);
+
+  unsigned int findGlyph(unsigned int codepoint) const;
+  bool getGlyphRange(unsigned int glyph, size_t& begin, size_t& end) const;
+  bool readOutline(unsigned int glyph, int depth, size_t& componentBudget,
+                   std::vector<Point>& points, std::vector<size_t>& contourEnds) const;
+
+private:
+  std::vector<unsigned char> m_data;
+  size_t                     m_cmap;
+  unsigned int               m_cmapFormat;
+  size_t                     m_loca;
+  size_t                     m_glyf;
+  size_t                     m_hmtx;
+  unsigned int               m_metricCount;
+  unsigned int               m_glyphCount;
+  bool                       m_isLongLoca;
+  float                      m_pixelHeight;
+  float                      m_scale;
+  int                        m_ascent;
+  int                        m_descent;
+  int                        m_lineHeight;
+  int                        m_maxGlyphHeight;
+};
+
+}
+#endif  // TRUETYPEFONT_H
@@ -15,6 +15,21 @@
 #define LITE_API __declspec(dllimport)
 #endif
 
+// SIMD instruction sets available at compile time. Kernels using them keep a
+// scalar path for the remaining elements and for other targets.
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define LITE_SSE2
+#endif
+
+#if defined(__AVX2__)
+#define LITE_AVX2
+#endif
+
+// Half float conversion instructions, present on every AVX2 capable CPU.
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define LITE_F16C
+#endif
+
 #include <string>
 
 namespace Lite
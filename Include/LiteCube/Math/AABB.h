@@ -0,0 +1,50 @@
+/**
+ * @file AABB.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the AABB class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef AABB_H
+#define AABB_H
+
+#include "..\LiteDefines.h"
+#include "Vector3f.h"
+
+namespace Lite
+{
+
+//!  Class representing an axis aligned bounding box.
+class LITE_API AABB
+{
+public:
+  AABB();
+  AABB(const Vector3f& min, const Vector3f& max);
+
+public:
+  void reset();
+  void grow(const Vector3f& point);
+  void grow(const AABB& other);
+
+  bool isEmpty() const;
+  bool contains(const Vector3f& point) const;
+  bool intersects(const AABB& other) const;
+
+  Vector3f center() const;
+  Vector3f extent() const;
+  float surfaceArea() const;
+  int longestAxis() const;
+
+public:
+  Vector3f min;
+  Vector3f max;
+};
+
+}
+#endif  // AABB_H
@@ -0,0 +1,69 @@
+/**
+ * @file Matrix3x2.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Matrix3x2 class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef MATRIX3X2_H
+#define MATRIX3X2_H
+
+#include "..\LiteDefines.h"
+#include "Vector2f.h"
+
+#include <cstddef>
+
+namespace Lite
+{
+
+//!  Class representing a 2D affine transform.
+/*!
+  Points are row vectors multiplied from the left, so a point maps to
+  (x * m11 + y * m21 + dx, x * m12 + y * m22 + dy) and left * right applies
+  left first.
+*/
+class LITE_API Matrix3x2
+{
+public:
+  Matrix3x2();
+  Matrix3x2(float m11, float m12, float m21, float m22, float dx, float dy);
+
+public:
+  float determinant() const;
+  bool invert();
+  Matrix3x2 inverse() const;
+
+  Vector2f transformPoint(const Vector2f& point) const;
+  Vector2f transformVector(const Vector2f& vector) const;
+  void transformPoints(const Vector2f* pPoints, Vector2f* pResult, size_t count) const;
+
+  static Matrix3x2 translation(float x, float y);
+  static Matrix3x2 rotation(float angle);
+  static Matrix3x2 scale(float x, float y);
+  static Matrix3x2 transform(const Vector2f& position, float angle, const Vector2f& scale,
+                             const Vector2f& origin);
+
+public:
+  bool operator !=(const Matrix3x2& right) const;
+  bool operator ==(const Matrix3x2& right) const;
+
+  Matrix3x2& operator *=(const Matrix3x2& right);
+  friend LITE_API Matrix3x2 operator *(const Matrix3x2& left, const Matrix3x2& right);
+
+public:
+  static const Matrix3x2 Identity;
+
+public:
+  float m11, m12;
+  float m21, m22;
+  float dx, dy;
+};
+
+}
+#endif  // MATRIX3X2_H
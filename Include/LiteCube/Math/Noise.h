@@ -0,0 +1,100 @@
+/**
+ * @file Noise.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Noise class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef NOISE_H
+#define NOISE_H
+
+#include "..\LiteDefines.h"
+#include "Vector2f.h"
+#include "Vector3f.h"
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class Noise
+ * @brief Coherent 2D and 3D noise for procedural content.
+ *
+ * Value, Perlin and simplex noise, each in [-1, 1], optionally summed over
+ * octaves as fBm or ridged multifractal noise. Lattice points are hashed
+ * with integer multiplications instead of a permutation table, so the
+ * kernels need no gathers and evaluate 8 points per AVX2 instruction or 4
+ * with SSE2.
+ *
+ * Every instruction set runs the same sequence of float operations, without
+ * fused multiply-add, so a given point gives bit identical results whether
+ * it is evaluated alone, in a batch, or on another CPU. This requires that
+ * the compiler does not contract operations itself, which holds for MSVC
+ * with /fp:precise and needs -ffp-contract=off with GCC and Clang.
+ */
+class LITE_API Noise
+{
+public:
+  enum Type
+  {
+    TYPE_VALUE,
+    TYPE_PERLIN,
+    TYPE_SIMPLEX
+  };
+
+  enum Fractal
+  {
+    FRACTAL_NONE,
+    FRACTAL_FBM,
+    FRACTAL_RIDGED
+  };
+
+  static const int TILE_SIZE = 64;
+  static const int MAX_OCTAVES = 16;
+
+public:
+  explicit Noise(Type type = TYPE_PERLIN, unsigned int seed = 0);
+
+public:
+  void setType(Type type);
+  Type getType() const;
+  void setSeed(unsigned int seed);
+  unsigned int getSeed() const;
+  void setFrequency(float frequency);
+  float getFrequency() const;
+  void setFractal(Fractal fractal, int octaves = 4, float lacunarity = 2.0f, float gain = 0.5f);
+  Fractal getFractal() const;
+  int getOctaves() const;
+  float getLacunarity() const;
+  float getGain() const;
+
+  float sample(const Vector2f& point) const;
+  float sample(const Vector3f& point) const;
+  void sample(const Vector2f* pPoints, size_t count, float* pOut, ThreadPool* pPool = NULL) const;
+  void sample(const Vector3f* pPoints, size_t count, float* pOut, ThreadPool* pPool = NULL) const;
+
+  void fillGrid(float* pOut, int width, int height, const Vector2f& origin,
+                const Vector2f& spacing, ThreadPool* pPool = NULL) const;
+  void fillGrid(float* pOut, int width, int height, int depth, const Vector3f& origin,
+                const Vector3f& spacing, ThreadPool* pPool = NULL) const;
+
+  static const char* getInstructionSet();
+
+private:
+  Type         m_type;
+  unsigned int m_seed;
+  float        m_frequency;
+  Fractal      m_fractal;
+  int          m_octaves;
+  float        m_lacunarity;
+  float        m_gain;
+};
+
+}
+#endif  // NOISE_H
@@ -0,0 +1,56 @@
+/**
+ * @file Quaternion.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the Quaternion class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include "..\LiteDefines.h"
+#include "Vector3f.h"
+
+namespace Lite
+{
+
+//!  Class representing a rotation as a unit quaternion.
+class LITE_API Quaternion
+{
+public:
+  Quaternion();
+  Quaternion(float x, float y, float z, float w);
+  Quaternion(const Vector3f& axis, float angle);
+
+public:
+  void normalize();
+  float length() const;
+  float dot(const Quaternion& other) const;
+  Quaternion conjugate() const;
+  Vector3f rotate(const Vector3f& point) const;
+  void toMatrix(float matrix[9]) const;
+
+  static Quaternion nlerp(const Quaternion& from, const Quaternion& to, float t);
+  static Quaternion slerp(const Quaternion& from, const Quaternion& to, float t);
+
+public:
+  bool operator !=(const Quaternion& right) const;
+  bool operator ==(const Quaternion& right) const;
+
+  friend LITE_API Quaternion operator *(const Quaternion& left, const Quaternion& right);
+
+public:
+  static const Quaternion Identity;
+
+public:
+  float x, y, z, w;
+};
+
+}
+#endif  // QUATERNION_H
@@ -0,0 +1,168 @@
+/**
+ * @file VectorHash.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains hashing and exact comparison for Vector2f and Vector3f
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef VECTORHASH_H
+#define VECTORHASH_H
+
+#include "..\LiteDefines.h"
+#include "Vector2f.h"
+#include "Vector3f.h"
+
+#include <cstring>
+#include <functional>
+
+namespace Lite
+{
+
+/*
+ * operator == of the vectors compares with a tolerance, which is not
+ * transitive and cannot be combined with a hash. The functors below compare
+ * exactly, or by units in the last place, and std::hash is consistent with
+ * the exact ones. Hash containers keyed by vectors must therefore use the
+ * exact functors, e.g.
+ *
+ *   std::unordered_map<Vector3f, int, std::hash<Vector3f>, Vector3fExactEqual>
+ *
+ * NaN components never compare equal and must not be used in keys.
+ */
+
+/**
+ * Obtain the bits of a float, with -0 folded onto +0 so that values that
+ * compare equal have the same bits.
+ */
+inline unsigned int floatBits(float value)
+{
+  value += 0.0f;
+  unsigned int bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/**
+ * Obtain the number of representable floats between a and b.
+ *
+ * @return distance in units in the last place, 0xFFFFFFFF if either is NaN
+ */
+inline unsigned int ulpDistance(float a, float b)
+{
+  if (a != a || b != b)
+  {
+    return 0xFFFFFFFFu;
+  }
+
+  // Map the sign-magnitude bits to a monotonic unsigned scale.
+  unsigned int ia = floatBits(a), ib = floatBits(b);
+  ia = ia & 0x80000000u ? ~ia + 1u : ia | 0x80000000u;
+  ib = ib & 0x80000000u ? ~ib + 1u : ib | 0x80000000u;
+  return ia > ib ? ia - ib : ib - ia;
+}
+
+/**
+ * Finalizer of MurmurHash3, spreads the bits of a 32 bit key.
+ */
+inline unsigned int mixBits(unsigned int h)
+{
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+//!  Exact component-wise equality of two Vector2f.
+struct Vector2fExactEqual
+{
+  bool operator ()(const Vector2f& left, const Vector2f& right) const
+  {
+    return left.x == right.x && left.y == right.y;
+  }
+};
+
+//!  Exact component-wise equality of two Vector3f.
+struct Vector3fExactEqual
+{
+  bool operator ()(const Vector3f& left, const Vector3f& right) const
+  {
+    return left.x == right.x && left.y == right.y && left.z == right.z;
+  }
+};
+
+//!  Equality of two Vector2f within a number of ulps per component.
+class Vector2fUlpEqual
+{
+public:
+  explicit Vector2fUlpEqual(unsigned int maxUlps = 4)
+    : m_maxUlps(maxUlps)
+  {
+  }
+
+  bool operator ()(const Vector2f& left, const Vector2f& right) const
+  {
+    return ulpDistance(left.x, right.x) <= m_maxUlps &&
+           ulpDistance(left.y, right.y) <= m_maxUlps;
+  }
+
+private:
+  unsigned int m_maxUlps;
+};
+
+//!  Equality of two Vector3f within a number of ulps per component.
+class Vector3fUlpEqual
+{
+public:
+  explicit Vector3fUlpEqual(unsigned int maxUlps = 4)
+    : m_maxUlps(maxUlps)
+  {
+  }
+
+  bool operator ()(const Vector3f& left, const Vector3f& right) const
+  {
+    return ulpDistance(left.x, right.x) <= m_maxUlps &&
+           ulpDistance(left.y, right.y) <= m_maxUlps &&
+           ulpDistance(left.z, right.z) <= m_maxUlps;
+  }
+
+private:
+  unsigned int m_maxUlps;
+};
+
+}
+
+namespace std
+{
+
+template <>
+struct hash<Lite::Vector2f>
+{
+  size_t operator ()(const Lite::Vector2f& value) const
+  {
+    return Lite::mixBits(Lite::floatBits(value.x) * 0x9E3779B1u ^
+                         Lite::floatBits(value.y));
+  }
+};
+
+template <>
+struct hash<Lite::Vector3f>
+{
+  size_t operator ()(const Lite::Vector3f& value) const
+  {
+    return Lite::mixBits((Lite::floatBits(value.x) * 0x9E3779B1u ^
+                          Lite::floatBits(value.y)) * 0x85EBCA77u ^
+                         Lite::floatBits(value.z));
+  }
+};
+
+}
+
+#endif  // VECTORHASH_H
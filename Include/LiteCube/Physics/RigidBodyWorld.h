@@ -0,0 +1,197 @@
+/**
+ * @file RigidBodyWorld.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the RigidBodyWorld class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef RIGIDBODYWORLD_H
+#define RIGIDBODYWORLD_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\AABB.h"
+#include "..\Math\Quaternion.h"
+#include "..\Math\Vector3f.h"
+#include "SweepAndPrune.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class RigidBodyWorld
+ * @brief Simulates spheres and boxes with contacts and friction.
+ *
+ * A step integrates velocities, finds overlapping pairs with a
+ * SweepAndPrune broadphase, generates contacts, groups the dynamic bodies
+ * touching each other into islands and runs a sequential impulse solver on
+ * every island. Islands share no dynamic bodies, so they are solved in
+ * parallel. Finally the positions are integrated (semi-implicit Euler).
+ *
+ * Body state is stored as one array per attribute. A body with zero mass is
+ * static.
+ */
+class LITE_API RigidBodyWorld
+{
+public:
+  /**
+   * @enum ShapeType
+   * @brief Collision shapes.
+   */
+  enum ShapeType
+  {
+    SHAPE_SPHERE = 0,   /**< Sphere, size x holds the radius */
+    SHAPE_BOX    = 1    /**< Box, size holds the half extents */
+  };
+
+  /**
+   * @struct Timings
+   * @brief Duration of every stage of the last step, in milliseconds.
+   */
+  struct Timings
+  {
+    double integrateVelocities;
+    double broadphase;
+    double narrowphase;
+    double islands;
+    double solver;
+    double integratePositions;
+    double total;
+  };
+
+  static const unsigned int INVALID_BODY = 0xFFFFFFFFu;
+
+public:
+  RigidBodyWorld();
+  ~RigidBodyWorld();
+
+public:
+  unsigned int addSphere(const Vector3f& position, float radius, float mass);
+  unsigned int addBox(const Vector3f& position, const Vector3f& halfExtents,
+                      const Quaternion& orientation, float mass);
+  void clear();
+
+  void setGravity(const Vector3f& gravity);
+  const Vector3f& getGravity() const;
+  void setGround(bool isEnabled, float height = 0.0f);
+  void setIterations(unsigned int iterations);
+  void setFriction(float friction);
+  void setRestitution(float restitution);
+
+  void setLinearVelocity(unsigned int body, const Vector3f& velocity);
+  void setAngularVelocity(unsigned int body, const Vector3f& velocity);
+  Vector3f getPosition(unsigned int body) const;
+  Quaternion getOrientation(unsigned int body) const;
+  Vector3f getLinearVelocity(unsigned int body) const;
+  Vector3f getAngularVelocity(unsigned int body) const;
+  ShapeType getShape(unsigned int body) const;
+  size_t getBodyCount() const;
+
+  void step(float dt, ThreadPool* pPool = NULL);
+
+  const Timings& getTimings() const;
+  size_t getContactCount() const;
+  size_t getIslandCount() const;
+
+private:
+  struct Contact
+  {
+    unsigned int a;
+    unsigned int b;
+    unsigned int feature;
+    float        rA[3];
+    float        rB[3];
+    float        normal[3];
+    float        tangent1[3];
+    float        tangent2[3];
+    float        depth;
+    float        normalMass;
+    float        tangentMass1;
+    float        tangentMass2;
+    float        bias;
+    float        impulse;
+    float        impulseT1;
+    float        impulseT2;
+
+    bool operator <(const Contact& other) const;
+  };
+
+  struct SolverBody
+  {
+    float v[3];
+    float invMass;
+    float w[3];
+    float padding;
+    float invInertia[9];
+  };
+
+  struct CachedImpulse
+  {
+    unsigned int a;
+    unsigned int b;
+    unsigned int feature;
+    float        impulse;
+    float        impulseT1;
+    float        impulseT2;
+
+    bool operator <(const CachedImpulse& other) const;
+  };
+
+  unsigned int addBody(const Vector3f& position, const Quaternion& orientation,
+                       const Vector3f& size, ShapeType shape, float mass);
+  AABB computeBounds(unsigned int body) const;
+  void integrateVelocities(size_t begin, size_t end, float dt);
+  void integratePositions(size_t begin, size_t end, float dt);
+  void findContacts(ThreadPool* pPool);
+  void collide(unsigned int a, unsigned int b, std::vector<Contact>& out) const;
+  void collideGround(unsigned int a, std::vector<Contact>& out) const;
+  static void initContact(Contact& contact, unsigned int a, unsigned int b,
+                          unsigned int feature, const float point[3],
+                          const float normal[3], float depth,
+                          const float pa[3], const float pb[3]);
+  void cacheImpulses();
+  void buildIslands();
+  static void applyImpulse(const Contact& contact, const float impulse[3],
+                           SolverBody& bodyA, SolverBody& bodyB);
+  void solveIsland(size_t island, float dt);
+
+private:
+  std::vector<float>         m_px, m_py, m_pz;
+  std::vector<float>         m_qx, m_qy, m_qz, m_qw;
+  std::vector<float>         m_vx, m_vy, m_vz;
+  std::vector<float>         m_wx, m_wy, m_wz;
+  std::vector<float>         m_invMass;
+  std::vector<float>         m_invInertiaX, m_invInertiaY, m_invInertiaZ;
+  std::vector<float>         m_sizeX, m_sizeY, m_sizeZ;
+  std::vector<unsigned char> m_shape;
+  std::vector<unsigned int>  m_proxies;
+  std::vector<float>         m_rotation;
+  std::vector<SolverBody>    m_solverBodies;
+
+  SweepAndPrune              m_broadphase;
+  std::vector<Contact>       m_contacts;
+  std::vector<CachedImpulse> m_impulseCache;
+  std::vector<unsigned int>  m_islandParent;
+  std::vector<unsigned int>  m_islandContacts;
+  std::vector<unsigned int>  m_islandStart;
+  std::vector<unsigned int>  m_islandOrder;
+
+  Vector3f                   m_gravity;
+  float                      m_groundHeight;
+  bool                       m_hasGround;
+  unsigned int               m_iterations;
+  float                      m_friction;
+  float                      m_restitution;
+  Timings                    m_timings;
+};
+
+}
+#endif  // RIGIDBODYWORLD_H
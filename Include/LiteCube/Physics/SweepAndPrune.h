@@ -0,0 +1,101 @@
+/**
+ * @file SweepAndPrune.h
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the declaration of the SweepAndPrune class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#ifndef SWEEPANDPRUNE_H
+#define SWEEPANDPRUNE_H
+
+#include "..\LiteDefines.h"
+#include "..\Math\AABB.h"
+
+#include <vector>
+
+namespace Lite
+{
+class ThreadPool;
+
+/**
+ * @class SweepAndPrune
+ * @brief Broadphase which finds overlapping pairs of boxes by sorting them
+ * along one axis and sweeping.
+ *
+ * The boxes are kept sorted by their minimum on the sweep axis between
+ * updates. Since bodies move little from frame to frame, the order is
+ * repaired with an insertion sort, which is close to linear for nearly
+ * sorted input. The sweep axis is the one with the largest spread of box
+ * centers.
+ *
+ * Every update() reports the pairs that started and stopped overlapping
+ * since the previous update.
+ */
+class LITE_API SweepAndPrune
+{
+public:
+  /**
+   * @struct Pair
+   * @brief Two overlapping proxies, first < second.
+   */
+  struct Pair
+  {
+    unsigned int first;
+    unsigned int second;
+  };
+
+  static const unsigned int INVALID_PROXY = 0xFFFFFFFFu;
+
+public:
+  SweepAndPrune();
+  ~SweepAndPrune();
+
+public:
+  unsigned int addProxy(const AABB& box);
+  void removeProxy(unsigned int proxy);
+  void updateProxy(unsigned int proxy, const AABB& box);
+  void clear();
+
+  void update(ThreadPool* pPool = NULL);
+
+  const std::vector<Pair>& getPairs() const;
+  const std::vector<Pair>& getAddedPairs() const;
+  const std::vector<Pair>& getRemovedPairs() const;
+
+  int getSweepAxis() const;
+  size_t getProxyCount() const;
+
+private:
+  void chooseAxis();
+  void sortProxies(ThreadPool* pPool);
+  void sweep(size_t begin, size_t end, std::vector<unsigned long long>& out) const;
+
+private:
+  std::vector<float>              m_min[3];
+  std::vector<float>              m_max[3];
+  std::vector<unsigned char>      m_isAlive;
+  std::vector<unsigned int>       m_freeProxies;
+  std::vector<unsigned int>       m_removedProxies;
+
+  std::vector<unsigned int>       m_order;
+  std::vector<float>              m_sortedMin[3];
+  std::vector<float>              m_sortedMax[3];
+  size_t                          m_pendingInserts;
+  bool                            m_isFullSortNeeded;
+  int                             m_axis;
+
+  std::vector<unsigned long long> m_pairKeys;
+  std::vector<unsigned long long> m_newPairKeys;
+  std::vector<Pair>               m_pairs;
+  std::vector<Pair>               m_addedPairs;
+  std::vector<Pair>               m_removedPairs;
+};
+
+}
+#endif  // SWEEPANDPRUNE_H
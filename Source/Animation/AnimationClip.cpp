@@ -0,0 +1,513 @@
+/**
+ * @file AnimationClip.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the AnimationClip class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Animation\AnimationClip.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+static const float QUANTIZATION_STEPS = 65535.0f;
+
+// Smallest squared length normalized, shorter rotations become 0.
+static const float MIN_LENGTH_SQR = 1e-20f;
+
+/* Find the segment [key, key + 1] containing time, starting from a cached key. */
+static unsigned int findKey(const float* pTimes, unsigned int keyCount, float time,
+                            unsigned int key)
+{
+  unsigned int lastSegment = keyCount - 2;
+  if (key <= lastSegment && time >= pTimes[key])
+  {
+    for (unsigned int step = 0; step < AnimationClip::MAX_KEY_STEPS; ++step)
+    {
+      if (key == lastSegment || time < pTimes[key + 1])
+      {
+        return key;
+      }
+      ++key;
+    }
+  }
+  else
+  {
+    key = 0;
+  }
+
+  unsigned int found = (unsigned int) (std::upper_bound(pTimes + key, pTimes + keyCount, time) -
+                                       pTimes);
+  return found == 0 ? 0 : std::min(found - 1, lastSegment);
+}
+
+#ifdef LITE_SSE2
+/* Decode four components of a stored element. */
+static inline __m128 loadElement(const float* pValues, const unsigned short* pQuantized,
+                                 const float* pScale, const float* pBias, size_t element)
+{
+  if (pQuantized != NULL)
+  {
+    __m128i packed = _mm_loadl_epi64((const __m128i*) (pQuantized + element * 4));
+    __m128 values = _mm_cvtepi32_ps(_mm_unpacklo_epi16(packed, _mm_setzero_si128()));
+    return _mm_add_ps(_mm_loadu_ps(pBias), _mm_mul_ps(_mm_loadu_ps(pScale), values));
+  }
+  return _mm_loadu_ps(pValues + element * 4);
+}
+#else
+/* Decode four components of a stored element. */
+static inline void loadElement(const float* pValues, const unsigned short* pQuantized,
+                               const float* pScale, const float* pBias, size_t element,
+                               float pOut[4])
+{
+  for (int c = 0; c < 4; ++c)
+  {
+    pOut[c] = pQuantized != NULL ? pBias[c] + pScale[c] * pQuantized[element * 4 + c]
+                                 : pValues[element * 4 + c];
+  }
+}
+#endif
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] isQuantized - store values as 16 bit integers instead of floats
+ */
+AnimationClip::AnimationClip(bool isQuantized)
+  : m_isQuantized(isQuantized)
+  , m_duration(0.0f)
+{
+}
+
+/**
+ * @brief Add a track.
+ *
+ * Every value is 3 floats for TRACK_VECTOR and a quaternion x, y, z, w for
+ * TRACK_ROTATION. LINEAR tracks have one value per key. HERMITE and BEZIER
+ * tracks have three: the in tangent or control point, the value, and the
+ * out tangent or control point. Hermite tangents are in units per second.
+ *
+ * @param[in] type          - kind of value animated
+ * @param[in] interpolation - interpolation between keys
+ * @param[in] pTimes        - keyCount ascending key times in seconds
+ * @param[in] keyCount      - number of keys
+ * @param[in] pValues       - the values of the keys
+ * @return index of the track in the output of sample(), INVALID_TRACK if
+ *         there are no keys
+ */
+unsigned int AnimationClip::addTrack(TrackType type, Interpolation interpolation,
+                                     const float* pTimes, size_t keyCount, const float* pValues)
+{
+  if (keyCount == 0)
+  {
+    return INVALID_TRACK;
+  }
+
+  int components = type == TRACK_ROTATION ? 4 : 3;
+  bool isCubic = interpolation != INTERPOLATION_LINEAR;
+  int perKey = isCubic ? 3 : 1;
+  int valueSlot = isCubic ? 1 : 0;
+
+  // Widen to four components and keep rotations in one hemisphere.
+  std::vector<float> input(keyCount * perKey * 4, 0.0f);
+  for (size_t e = 0; e < keyCount * perKey; ++e)
+  {
+    std::copy(pValues + e * components, pValues + (e + 1) * components, &input[e * 4]);
+  }
+  for (size_t k = 1; k < keyCount && type == TRACK_ROTATION; ++k)
+  {
+    const float* pPrevious = &input[((k - 1) * perKey + valueSlot) * 4];
+    float* pKey = &input[k * perKey * 4];
+    float dot = 0.0f;
+    for (int c = 0; c < 4; ++c)
+    {
+      dot += pPrevious[c] * pKey[valueSlot * 4 + c];
+    }
+    for (int c = 0; dot < 0.0f && c < perKey * 4; ++c)
+    {
+      pKey[c] = -pKey[c];
+    }
+  }
+
+  // A single key is repeated so every track has a segment.
+  std::vector<float> times(pTimes, pTimes + keyCount);
+  if (keyCount == 1)
+  {
+    times.push_back(pTimes[0]);
+  }
+  size_t storedKeys = times.size();
+
+  // Stored per key: the value, then for cubic tracks the two inner Bezier
+  // control points of the segment starting at the key.
+  std::vector<float> elements(storedKeys * perKey * 4);
+  for (size_t k = 0; k < storedKeys; ++k)
+  {
+    size_t key = std::min(k, keyCount - 1);
+    const float* pKey = &input[key * perKey * 4];
+    float* pOut = &elements[k * perKey * 4];
+    for (int c = 0; c < 4; ++c)
+    {
+      pOut[c] = pKey[valueSlot * 4 + c];
+    }
+    if (!isCubic)
+    {
+      continue;
+    }
+
+    const float* pNext = key + 1 < keyCount ? pKey + perKey * 4 : NULL;
+    float third = pNext != NULL ? (times[k + 1] - times[k]) / 3.0f : 0.0f;
+    for (int c = 0; c < 4; ++c)
+    {
+      if (pNext == NULL)
+      {
+        pOut[4 + c] = pOut[c];
+        pOut[8 + c] = pOut[c];
+      }
+      else if (interpolation == INTERPOLATION_HERMITE)
+      {
+        pOut[4 + c] = pKey[4 + c] + pKey[8 + c] * third;
+        pOut[8 + c] = pNext[4 + c] - pNext[c] * third;
+      }
+      else
+      {
+        pOut[4 + c] = pKey[8 + c];
+        pOut[8 + c] = pNext[c];
+      }
+    }
+  }
+
+  Track track;
+  track.type = type;
+  track.isCubic = isCubic;
+  track.timeline = addTimeline(&times[0], storedKeys);
+  for (int c = 0; c < 4; ++c)
+  {
+    track.scale[c] = 1.0f;
+    track.bias[c] = 0.0f;
+  }
+
+  size_t elementCount = elements.size() / 4;
+  if (m_isQuantized)
+  {
+    track.offset = m_quantized.size() / 4;
+    for (int c = 0; c < 4; ++c)
+    {
+      float minimum = elements[c], maximum = elements[c];
+      for (size_t e = 1; e < elementCount; ++e)
+      {
+        minimum = std::min(minimum, elements[e * 4 + c]);
+        maximum = std::max(maximum, elements[e * 4 + c]);
+      }
+      track.bias[c] = minimum;
+      track.scale[c] = (maximum - minimum) / QUANTIZATION_STEPS;
+    }
+    for (size_t e = 0; e < elementCount; ++e)
+    {
+      for (int c = 0; c < 4; ++c)
+      {
+        float step = track.scale[c] > 0.0f ?
+                     (elements[e * 4 + c] - track.bias[c]) / track.scale[c] : 0.0f;
+        m_quantized.push_back((unsigned short) std::min(floorf(step + 0.5f), QUANTIZATION_STEPS));
+      }
+    }
+  }
+  else
+  {
+    track.offset = m_values.size() / 4;
+    m_values.insert(m_values.end(), elements.begin(), elements.end());
+  }
+
+  unsigned int index = (unsigned int) m_tracks.size();
+  m_tracks.push_back(track);
+  m_groups[(type == TRACK_ROTATION ? 2 : 0) + (isCubic ? 1 : 0)].push_back(index);
+  m_duration = std::max(m_duration, times.back());
+  return index;
+}
+
+/**
+ * @brief Remove all tracks.
+ */
+void AnimationClip::clear()
+{
+  m_times.clear();
+  m_timelines.clear();
+  m_tracks.clear();
+  for (int g = 0; g < 4; ++g)
+  {
+    m_groups[g].clear();
+  }
+  m_values.clear();
+  m_quantized.clear();
+  m_duration = 0.0f;
+}
+
+/**
+ * @brief Obtain the number of tracks.
+ *
+ * @return number of tracks
+ */
+size_t AnimationClip::getTrackCount() const
+{
+  return m_tracks.size();
+}
+
+/**
+ * @brief Obtain the number of distinct sets of key times.
+ *
+ * @return number of timelines
+ */
+size_t AnimationClip::getTimelineCount() const
+{
+  return m_timelines.size();
+}
+
+/**
+ * @brief Obtain the time of the last key of all tracks.
+ *
+ * @return duration in seconds
+ */
+float AnimationClip::getDuration() const
+{
+  return m_duration;
+}
+
+/**
+ * @brief Check if the values are stored as 16 bit integers.
+ *
+ * @return true if the clip is quantized
+ */
+bool AnimationClip::isQuantized() const
+{
+  return m_isQuantized;
+}
+
+/**
+ * @brief Obtain the memory used by the keys and tracks.
+ *
+ * @return size in bytes
+ */
+size_t AnimationClip::getMemoryUsage() const
+{
+  return m_times.size() * sizeof(float) + m_timelines.size() * sizeof(Timeline) +
+         m_tracks.size() * (sizeof(Track) + sizeof(unsigned int)) +
+         m_values.size() * sizeof(float) + m_quantized.size() * sizeof(unsigned short);
+}
+
+/**
+ * @brief Evaluate every track at a time.
+ *
+ * Track i is written to pX[i], pY[i], pZ[i], and for rotations pW[i].
+ * Times outside the keys are clamped. Keep one cursor per playing
+ * instance; it is initialized on first use.
+ *
+ * @param[in]     time   - time in seconds
+ * @param[in,out] cursor - cached keys of the instance
+ * @param[out]    pX     - getTrackCount() x components
+ * @param[out]    pY     - getTrackCount() y components
+ * @param[out]    pZ     - getTrackCount() z components
+ * @param[out]    pW     - getTrackCount() w components, NULL if there are
+ *                         no rotation tracks
+ */
+void AnimationClip::sample(float time, Cursor& cursor, float* pX, float* pY, float* pZ,
+                           float* pW) const
+{
+  LITE_PROFILE_ZONE("AnimationClip::sample");
+
+  if (cursor.keys.size() != m_timelines.size())
+  {
+    cursor.keys.assign(m_timelines.size(), 0);
+    cursor.factors.assign(m_timelines.size(), 0.0f);
+  }
+
+  for (size_t i = 0; i < m_timelines.size(); ++i)
+  {
+    const float* pTimes = &m_times[m_timelines[i].offset];
+    unsigned int key = findKey(pTimes, m_timelines[i].keyCount, time, cursor.keys[i]);
+    float span = pTimes[key + 1] - pTimes[key];
+    float factor = span > 0.0f ? (time - pTimes[key]) / span : 0.0f;
+    cursor.keys[i] = key;
+    cursor.factors[i] = std::min(std::max(factor, 0.0f), 1.0f);
+  }
+
+  // The last group of a kind repeats its last track to fill four lanes.
+  float* const pOut[4] = { pX, pY, pZ, pW };
+  for (int g = 0; g < 4; ++g)
+  {
+    const std::vector<unsigned int>& group = m_groups[g];
+    for (size_t i = 0; i < group.size(); i += 4)
+    {
+      unsigned int tracks[4];
+      for (size_t lane = 0; lane < 4; ++lane)
+      {
+        tracks[lane] = group[std::min(i + lane, group.size() - 1)];
+      }
+      sampleGroup(tracks, g >= 2, (g & 1) != 0, cursor, pOut);
+    }
+  }
+}
+
+/*
+ * Evaluate four tracks of the same kind. The values of the four tracks are
+ * transposed so that every register holds one component of all of them.
+ */
+void AnimationClip::sampleGroup(const unsigned int tracks[4], bool isRotation, bool isCubic,
+                                const Cursor& cursor, float* const pOut[4]) const
+{
+  const float* pValues = m_values.empty() ? NULL : &m_values[0];
+  const unsigned short* pQuantized = m_isQuantized && !m_quantized.empty() ?
+                                     &m_quantized[0] : NULL;
+  int slots = isCubic ? 4 : 2;
+  int stride = isCubic ? 3 : 1;
+  int components = isRotation ? 4 : 3;
+
+#ifdef LITE_SSE2
+  __m128 elements[4][4];
+  float factors[4];
+  for (int lane = 0; lane < 4; ++lane)
+  {
+    const Track& track = m_tracks[tracks[lane]];
+    size_t element = track.offset + (size_t) cursor.keys[track.timeline] * stride;
+    factors[lane] = cursor.factors[track.timeline];
+    for (int s = 0; s < slots; ++s)
+    {
+      elements[s][lane] = loadElement(pValues, pQuantized, track.scale, track.bias, element + s);
+    }
+  }
+  for (int s = 0; s < slots; ++s)
+  {
+    _MM_TRANSPOSE4_PS(elements[s][0], elements[s][1], elements[s][2], elements[s][3]);
+  }
+
+  __m128 u = _mm_loadu_ps(factors);
+  __m128 result[4];
+  if (isCubic)
+  {
+    __m128 three = _mm_set1_ps(3.0f);
+    __m128 v = _mm_sub_ps(_mm_set1_ps(1.0f), u);
+    __m128 uv3 = _mm_mul_ps(three, _mm_mul_ps(u, v));
+    __m128 weights[4] = { _mm_mul_ps(_mm_mul_ps(v, v), v), _mm_mul_ps(uv3, v),
+                          _mm_mul_ps(uv3, u), _mm_mul_ps(_mm_mul_ps(u, u), u) };
+    for (int c = 0; c < components; ++c)
+    {
+      result[c] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(weights[0], elements[0][c]),
+                                        _mm_mul_ps(weights[1], elements[1][c])),
+                             _mm_add_ps(_mm_mul_ps(weights[2], elements[2][c]),
+                                        _mm_mul_ps(weights[3], elements[3][c])));
+    }
+  }
+  else
+  {
+    for (int c = 0; c < components; ++c)
+    {
+      result[c] = _mm_add_ps(elements[0][c],
+                             _mm_mul_ps(u, _mm_sub_ps(elements[1][c], elements[0][c])));
+    }
+  }
+
+  if (isRotation)
+  {
+    __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(result[0], result[0]),
+                                             _mm_mul_ps(result[1], result[1])),
+                                  _mm_add_ps(_mm_mul_ps(result[2], result[2]),
+                                             _mm_mul_ps(result[3], result[3])));
+    __m128 length = _mm_sqrt_ps(_mm_max_ps(lengthSqr, _mm_set1_ps(MIN_LENGTH_SQR)));
+    for (int c = 0; c < 4; ++c)
+    {
+      result[c] = _mm_div_ps(result[c], length);
+    }
+  }
+
+  bool isContiguous = tracks[1] == tracks[0] + 1 && tracks[2] == tracks[0] + 2 &&
+                      tracks[3] == tracks[0] + 3;
+  for (int c = 0; c < components; ++c)
+  {
+    if (isContiguous)
+    {
+      _mm_storeu_ps(pOut[c] + tracks[0], result[c]);
+      continue;
+    }
+
+    float values[4];
+    _mm_storeu_ps(values, result[c]);
+    for (int lane = 0; lane < 4; ++lane)
+    {
+      pOut[c][tracks[lane]] = values[lane];
+    }
+  }
+#else
+  for (int lane = 0; lane < 4; ++lane)
+  {
+    const Track& track = m_tracks[tracks[lane]];
+    size_t element = track.offset + (size_t) cursor.keys[track.timeline] * stride;
+    float u = cursor.factors[track.timeline], v = 1.0f - u;
+    float weights[4] = { v * v * v, 3.0f * u * v * v, 3.0f * u * u * v, u * u * u };
+    if (!isCubic)
+    {
+      weights[0] = v;
+      weights[1] = u;
+    }
+
+    float result[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int s = 0; s < slots; ++s)
+    {
+      float values[4];
+      loadElement(pValues, pQuantized, track.scale, track.bias, element + s, values);
+      for (int c = 0; c < 4; ++c)
+      {
+        result[c] += weights[s] * values[c];
+      }
+    }
+
+    float scale = 1.0f;
+    if (isRotation)
+    {
+      float lengthSqr = result[0] * result[0] + result[1] * result[1] +
+                        result[2] * result[2] + result[3] * result[3];
+      scale = 1.0f / sqrtf(std::max(lengthSqr, MIN_LENGTH_SQR));
+    }
+    for (int c = 0; c < components; ++c)
+    {
+      pOut[c][tracks[lane]] = result[c] * scale;
+    }
+  }
+#endif
+}
+
+/*
+ * Store a set of key times, or find an identical stored set.
+ */
+unsigned int AnimationClip::addTimeline(const float* pTimes, size_t keyCount)
+{
+  for (size_t i = 0; i < m_timelines.size(); ++i)
+  {
+    const Timeline& timeline = m_timelines[i];
+    if (timeline.keyCount == keyCount &&
+        std::equal(pTimes, pTimes + keyCount, m_times.begin() + timeline.offset))
+    {
+      return (unsigned int) i;
+    }
+  }
+
+  Timeline timeline;
+  timeline.offset = m_times.size();
+  timeline.keyCount = (unsigned int) keyCount;
+  m_times.insert(m_times.end(), pTimes, pTimes + keyCount);
+  m_timelines.push_back(timeline);
+  return (unsigned int) (m_timelines.size() - 1);
+}
+
+}
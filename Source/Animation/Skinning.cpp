@@ -0,0 +1,448 @@
+/**
+ * @file Skinning.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the Skinning class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Animation\Skinning.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(LITE_AVX2)
+#include <immintrin.h>
+#elif defined(LITE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+static_assert(sizeof(Vector3f) == 3 * sizeof(float), "Vector3f must be tightly packed");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be tightly packed");
+
+// Smallest squared length normalized, shorter vectors become 0.
+static const float MIN_LENGTH_SQR = 1e-20f;
+
+#ifdef LITE_SSE2
+/* Store the first three lanes. */
+static inline void store3(float* pOut, __m128 value)
+{
+  _mm_storel_pi((__m64*) pOut, value);
+  _mm_store_ss(pOut + 2, _mm_movehl_ps(value, value));
+}
+
+/* Scale a vector with w = 0 to unit length. */
+static inline __m128 normalize3(__m128 value)
+{
+  __m128 square = _mm_mul_ps(value, value);
+  __m128 sum = _mm_add_ps(square, _mm_shuffle_ps(square, square, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  __m128 length = _mm_sqrt_ps(_mm_max_ps(sum, _mm_set1_ps(MIN_LENGTH_SQR)));
+  return _mm_div_ps(value, length);
+}
+
+/* Cross product of the xyz lanes, w becomes 0 if both w are equal. */
+static inline __m128 cross3(__m128 left, __m128 right)
+{
+  __m128 leftYzx = _mm_shuffle_ps(left, left, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 rightYzx = _mm_shuffle_ps(right, right, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 result = _mm_sub_ps(_mm_mul_ps(left, rightYzx), _mm_mul_ps(leftYzx, right));
+  return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+/* Rotate a vector by a unit quaternion, v + w * t + cross(q, t), t = 2 * cross(q, v). */
+static inline __m128 rotate3(__m128 real, __m128 realW, __m128 value)
+{
+  __m128 t = cross3(real, value);
+  t = _mm_add_ps(t, t);
+  return _mm_add_ps(_mm_add_ps(value, _mm_mul_ps(realW, t)), cross3(real, t));
+}
+
+/* Transform a vertex by a blended, not yet normalized dual quaternion. */
+static inline void transformDualQuaternion(__m128 real, __m128 dual,
+                                           const Skinning::Job& job, size_t i)
+{
+  __m128 square = _mm_mul_ps(real, real);
+  __m128 sum = _mm_add_ps(square, _mm_shuffle_ps(square, square, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  __m128 length = _mm_sqrt_ps(_mm_max_ps(sum, _mm_set1_ps(MIN_LENGTH_SQR)));
+  real = _mm_div_ps(real, length);
+  dual = _mm_div_ps(dual, length);
+
+  // translation = 2 * (real.w * dual.xyz - dual.w * real.xyz + cross(real, dual))
+  __m128 realW = _mm_shuffle_ps(real, real, _MM_SHUFFLE(3, 3, 3, 3));
+  __m128 dualW = _mm_shuffle_ps(dual, dual, _MM_SHUFFLE(3, 3, 3, 3));
+  __m128 translation = _mm_sub_ps(_mm_mul_ps(realW, dual), _mm_mul_ps(dualW, real));
+  translation = _mm_add_ps(translation, cross3(real, dual));
+  translation = _mm_add_ps(translation, translation);
+
+  const Vector3f& position = job.pPositions[i];
+  __m128 point = _mm_setr_ps(position.x, position.y, position.z, 0.0f);
+  store3(&job.pOutPositions[i].x, _mm_add_ps(rotate3(real, realW, point), translation));
+
+  if (job.pNormals != NULL)
+  {
+    const Vector3f& normal = job.pNormals[i];
+    __m128 vector = _mm_setr_ps(normal.x, normal.y, normal.z, 0.0f);
+    store3(&job.pOutNormals[i].x, rotate3(real, realW, vector));
+  }
+}
+#endif
+
+/* Linear blend skinning of the vertices [begin, end) of a job. */
+static void skinLinear(const Skinning::Job& job, size_t begin, size_t end)
+{
+  const Skinning::BoneMatrix* pPalette = job.pMatrices;
+  for (size_t i = begin; i < end; ++i)
+  {
+    const Skinning::BoneInfluence& influence = job.pInfluences[i];
+    const float* pPosition = &job.pPositions[i].x;
+
+#if defined(LITE_AVX2)
+    // Columns 0 and 1 in one register, 2 and 3 in the other.
+    const float* pBone = pPalette[influence.bones[0]].m;
+    __m256 weight = _mm256_broadcast_ss(&influence.weights[0]);
+    __m256 columns01 = _mm256_mul_ps(weight, _mm256_loadu_ps(pBone));
+    __m256 columns23 = _mm256_mul_ps(weight, _mm256_loadu_ps(pBone + 8));
+    for (int k = 1; k < 4; ++k)
+    {
+      pBone = pPalette[influence.bones[k]].m;
+      weight = _mm256_broadcast_ss(&influence.weights[k]);
+      columns01 = _mm256_add_ps(columns01, _mm256_mul_ps(weight, _mm256_loadu_ps(pBone)));
+      columns23 = _mm256_add_ps(columns23, _mm256_mul_ps(weight, _mm256_loadu_ps(pBone + 8)));
+    }
+
+    __m256 xy = _mm256_blend_ps(_mm256_broadcast_ss(pPosition),
+                                _mm256_broadcast_ss(pPosition + 1), 0xF0);
+    __m256 z1 = _mm256_blend_ps(_mm256_broadcast_ss(pPosition + 2), _mm256_set1_ps(1.0f), 0xF0);
+    __m256 sum = _mm256_add_ps(_mm256_mul_ps(columns01, xy), _mm256_mul_ps(columns23, z1));
+    store3(&job.pOutPositions[i].x, _mm_add_ps(_mm256_castps256_ps128(sum),
+                                               _mm256_extractf128_ps(sum, 1)));
+
+    if (job.pNormals != NULL)
+    {
+      const float* pNormal = &job.pNormals[i].x;
+      xy = _mm256_blend_ps(_mm256_broadcast_ss(pNormal), _mm256_broadcast_ss(pNormal + 1), 0xF0);
+      z1 = _mm256_blend_ps(_mm256_broadcast_ss(pNormal + 2), _mm256_setzero_ps(), 0xF0);
+      sum = _mm256_add_ps(_mm256_mul_ps(columns01, xy), _mm256_mul_ps(columns23, z1));
+      store3(&job.pOutNormals[i].x, normalize3(_mm_add_ps(_mm256_castps256_ps128(sum),
+                                                          _mm256_extractf128_ps(sum, 1))));
+    }
+#elif defined(LITE_SSE2)
+    __m128 columns[4];
+    const float* pBone = pPalette[influence.bones[0]].m;
+    __m128 weight = _mm_set1_ps(influence.weights[0]);
+    for (int c = 0; c < 4; ++c)
+    {
+      columns[c] = _mm_mul_ps(weight, _mm_loadu_ps(pBone + c * 4));
+    }
+    for (int k = 1; k < 4; ++k)
+    {
+      pBone = pPalette[influence.bones[k]].m;
+      weight = _mm_set1_ps(influence.weights[k]);
+      for (int c = 0; c < 4; ++c)
+      {
+        columns[c] = _mm_add_ps(columns[c], _mm_mul_ps(weight, _mm_loadu_ps(pBone + c * 4)));
+      }
+    }
+
+    __m128 xz = _mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(pPosition[0])),
+                           _mm_mul_ps(columns[2], _mm_set1_ps(pPosition[2])));
+    __m128 y1 = _mm_add_ps(_mm_mul_ps(columns[1], _mm_set1_ps(pPosition[1])), columns[3]);
+    store3(&job.pOutPositions[i].x, _mm_add_ps(xz, y1));
+
+    if (job.pNormals != NULL)
+    {
+      const float* pNormal = &job.pNormals[i].x;
+      __m128 normal = _mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(pNormal[0])),
+                                 _mm_mul_ps(columns[2], _mm_set1_ps(pNormal[2])));
+      normal = _mm_add_ps(normal, _mm_mul_ps(columns[1], _mm_set1_ps(pNormal[1])));
+      store3(&job.pOutNormals[i].x, normalize3(normal));
+    }
+#else
+    float m[12];
+    const float* pBone = pPalette[influence.bones[0]].m;
+    for (int c = 0; c < 12; ++c)
+    {
+      m[c] = influence.weights[0] * pBone[c + c / 3];
+    }
+    for (int k = 1; k < 4; ++k)
+    {
+      pBone = pPalette[influence.bones[k]].m;
+      for (int c = 0; c < 12; ++c)
+      {
+        m[c] += influence.weights[k] * pBone[c + c / 3];
+      }
+    }
+
+    float* pOut = &job.pOutPositions[i].x;
+    for (int r = 0; r < 3; ++r)
+    {
+      pOut[r] = m[r] * pPosition[0] + m[3 + r] * pPosition[1] + m[6 + r] * pPosition[2] +
+                m[9 + r];
+    }
+
+    if (job.pNormals != NULL)
+    {
+      const float* pNormal = &job.pNormals[i].x;
+      float normal[3];
+      for (int r = 0; r < 3; ++r)
+      {
+        normal[r] = m[r] * pNormal[0] + m[3 + r] * pNormal[1] + m[6 + r] * pNormal[2];
+      }
+      float lengthSqr = normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2];
+      float scale = 1.0f / sqrtf(std::max(lengthSqr, MIN_LENGTH_SQR));
+      pOut = &job.pOutNormals[i].x;
+      for (int r = 0; r < 3; ++r)
+      {
+        pOut[r] = normal[r] * scale;
+      }
+    }
+#endif
+  }
+}
+
+/* Dual quaternion skinning of the vertices [begin, end) of a job. */
+static void skinDualQuaternion(const Skinning::Job& job, size_t begin, size_t end)
+{
+  const Skinning::DualQuaternion* pPalette = job.pDualQuaternions;
+  for (size_t i = begin; i < end; ++i)
+  {
+    const Skinning::BoneInfluence& influence = job.pInfluences[i];
+    const Quaternion& first = pPalette[influence.bones[0]].real;
+
+    // Flip the influences in the other hemisphere than the first one.
+    float weights[4];
+    weights[0] = influence.weights[0];
+    for (int k = 1; k < 4; ++k)
+    {
+      float dot = first.dot(pPalette[influence.bones[k]].real);
+      weights[k] = dot < 0.0f ? -influence.weights[k] : influence.weights[k];
+    }
+
+#if defined(LITE_AVX2)
+    // Real part in the low half, dual part in the high half.
+    __m256 blended = _mm256_mul_ps(_mm256_broadcast_ss(&weights[0]), _mm256_loadu_ps(&first.x));
+    for (int k = 1; k < 4; ++k)
+    {
+      const float* pBone = &pPalette[influence.bones[k]].real.x;
+      blended = _mm256_add_ps(blended, _mm256_mul_ps(_mm256_broadcast_ss(&weights[k]),
+                                                     _mm256_loadu_ps(pBone)));
+    }
+    transformDualQuaternion(_mm256_castps256_ps128(blended), _mm256_extractf128_ps(blended, 1),
+                            job, i);
+#elif defined(LITE_SSE2)
+    __m128 weight = _mm_set1_ps(weights[0]);
+    __m128 real = _mm_mul_ps(weight, _mm_loadu_ps(&first.x));
+    __m128 dual = _mm_mul_ps(weight, _mm_loadu_ps(&pPalette[influence.bones[0]].dual.x));
+    for (int k = 1; k < 4; ++k)
+    {
+      const Skinning::DualQuaternion& bone = pPalette[influence.bones[k]];
+      weight = _mm_set1_ps(weights[k]);
+      real = _mm_add_ps(real, _mm_mul_ps(weight, _mm_loadu_ps(&bone.real.x)));
+      dual = _mm_add_ps(dual, _mm_mul_ps(weight, _mm_loadu_ps(&bone.dual.x)));
+    }
+    transformDualQuaternion(real, dual, job, i);
+#else
+    float q[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < 4; ++k)
+    {
+      const float* pBone = &pPalette[influence.bones[k]].real.x;
+      for (int c = 0; c < 8; ++c)
+      {
+        q[c] += weights[k] * pBone[c];
+      }
+    }
+
+    float lengthSqr = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+    float scale = 1.0f / sqrtf(std::max(lengthSqr, MIN_LENGTH_SQR));
+    Quaternion real(q[0] * scale, q[1] * scale, q[2] * scale, q[3] * scale);
+    Quaternion dual(q[4] * scale, q[5] * scale, q[6] * scale, q[7] * scale);
+
+    Vector3f rotated = real.rotate(job.pPositions[i]);
+    Vector3f& out = job.pOutPositions[i];
+    out.x = rotated.x + 2.0f * (real.w * dual.x - dual.w * real.x + real.y * dual.z - real.z * dual.y);
+    out.y = rotated.y + 2.0f * (real.w * dual.y - dual.w * real.y + real.z * dual.x - real.x * dual.z);
+    out.z = rotated.z + 2.0f * (real.w * dual.z - dual.w * real.z + real.x * dual.y - real.y * dual.x);
+
+    if (job.pNormals != NULL)
+    {
+      rotated = real.rotate(job.pNormals[i]);
+      job.pOutNormals[i].x = rotated.x;
+      job.pOutNormals[i].y = rotated.y;
+      job.pOutNormals[i].z = rotated.z;
+    }
+#endif
+  }
+}
+
+/* Skin the vertices [begin, end) of a job. */
+static void skinRange(const Skinning::Job& job, size_t begin, size_t end)
+{
+  if (job.method == Skinning::DUAL_QUATERNION)
+  {
+    skinDualQuaternion(job, begin, end);
+  }
+  else
+  {
+    skinLinear(job, begin, end);
+  }
+}
+
+/**
+ * @brief Build a bone matrix from a rotation and a translation.
+ *
+ * @param[in] rotation    - unit quaternion
+ * @param[in] translation - translation applied after the rotation
+ * @return the transform
+ */
+Skinning::BoneMatrix Skinning::makeMatrix(const Quaternion& rotation,
+                                          const Vector3f& translation)
+{
+  float rows[9];
+  rotation.toMatrix(rows);
+
+  BoneMatrix matrix;
+  for (int c = 0; c < 3; ++c)
+  {
+    for (int r = 0; r < 3; ++r)
+    {
+      matrix.m[c * 4 + r] = rows[r * 3 + c];
+    }
+    matrix.m[c * 4 + 3] = 0.0f;
+  }
+  matrix.m[12] = translation.x;
+  matrix.m[13] = translation.y;
+  matrix.m[14] = translation.z;
+  matrix.m[15] = 1.0f;
+  return matrix;
+}
+
+/**
+ * @brief Build a dual quaternion from a rotation and a translation.
+ *
+ * @param[in] rotation    - unit quaternion
+ * @param[in] translation - translation applied after the rotation
+ * @return the transform
+ */
+Skinning::DualQuaternion Skinning::makeDualQuaternion(const Quaternion& rotation,
+                                                      const Vector3f& translation)
+{
+  DualQuaternion result;
+  result.real = rotation;
+  result.dual = Quaternion(translation.x, translation.y, translation.z, 0.0f) * rotation;
+  result.dual.x *= 0.5f;
+  result.dual.y *= 0.5f;
+  result.dual.z *= 0.5f;
+  result.dual.w *= 0.5f;
+  return result;
+}
+
+/**
+ * @brief Convert a palette of bone matrices to dual quaternions.
+ *
+ * The matrices must be rigid, a rotation followed by a translation.
+ *
+ * @param[in]  pMatrices - the bone matrices
+ * @param[in]  count     - number of bones
+ * @param[out] pOut      - count dual quaternions
+ */
+void Skinning::toDualQuaternions(const BoneMatrix* pMatrices, size_t count,
+                                 DualQuaternion* pOut)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    // Element (row, column) is m[column * 4 + row].
+    const float* m = pMatrices[i].m;
+    float trace = m[0] + m[5] + m[10];
+    Quaternion rotation;
+    if (trace > 0.0f)
+    {
+      float s = 2.0f * sqrtf(trace + 1.0f);
+      rotation = Quaternion((m[6] - m[9]) / s, (m[8] - m[2]) / s, (m[1] - m[4]) / s, 0.25f * s);
+    }
+    else if (m[0] > m[5] && m[0] > m[10])
+    {
+      float s = 2.0f * sqrtf(1.0f + m[0] - m[5] - m[10]);
+      rotation = Quaternion(0.25f * s, (m[4] + m[1]) / s, (m[8] + m[2]) / s, (m[6] - m[9]) / s);
+    }
+    else if (m[5] > m[10])
+    {
+      float s = 2.0f * sqrtf(1.0f + m[5] - m[0] - m[10]);
+      rotation = Quaternion((m[4] + m[1]) / s, 0.25f * s, (m[9] + m[6]) / s, (m[8] - m[2]) / s);
+    }
+    else
+    {
+      float s = 2.0f * sqrtf(1.0f + m[10] - m[0] - m[5]);
+      rotation = Quaternion((m[8] + m[2]) / s, (m[9] + m[6]) / s, 0.25f * s, (m[1] - m[4]) / s);
+    }
+    rotation.normalize();
+    pOut[i] = makeDualQuaternion(rotation, Vector3f(m[12], m[13], m[14]));
+  }
+}
+
+/**
+ * @brief Skin a mesh.
+ *
+ * @param[in] job   - the mesh, its palette and the output arrays
+ * @param[in] pPool - thread pool to split the vertices across, or NULL
+ */
+void Skinning::skin(const Job& job, ThreadPool* pPool)
+{
+  skin(&job, 1, pPool);
+}
+
+/**
+ * @brief Skin several meshes at once.
+ *
+ * The vertices of all jobs form one range that is split across the pool,
+ * so many small meshes are spread as evenly as a single large one.
+ *
+ * @param[in] pJobs    - the meshes, their palettes and output arrays
+ * @param[in] jobCount - number of jobs
+ * @param[in] pPool    - thread pool to split the vertices across, or NULL
+ */
+void Skinning::skin(const Job* pJobs, size_t jobCount, ThreadPool* pPool)
+{
+  LITE_PROFILE_ZONE("Skinning::skin");
+
+  // starts[j] is the index of the first vertex of job j in the joint range.
+  std::vector<size_t> starts(jobCount + 1, 0);
+  for (size_t j = 0; j < jobCount; ++j)
+  {
+    starts[j + 1] = starts[j] + pJobs[j].count;
+  }
+
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+    size_t j = std::upper_bound(starts.begin(), starts.end(), begin) - starts.begin() - 1;
+    for (; j < jobCount && starts[j] < end; ++j)
+    {
+      size_t first = std::max(begin, starts[j]) - starts[j];
+      size_t last = std::min(end, starts[j + 1]) - starts[j];
+      skinRange(pJobs[j], first, last);
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, starts[jobCount], GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, starts[jobCount]);
+  }
+}
+
+}
@@ -0,0 +1,594 @@
+/**
+ * @file AssetStreamer.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the AssetStreamer class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\AssetStreamer.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Lite
+{
+
+// Completions taken from the reader per poll.
+static const size_t COMPLETION_BATCH = 16;
+
+// Stale queue entries tolerated before the queue is rebuilt.
+static const size_t MIN_STALE_ENTRIES = 64;
+
+/*
+ * A file request and everything it carries through the pipeline.
+ */
+struct AssetStreamer::Request
+{
+  RequestId                  id;
+  String                     path;
+  float                      priority;
+  unsigned int               sequence;
+  unsigned int               version;
+  Status                     status;
+  bool                       isCancelRequested;
+  DecodeTask                 decode;
+  CompletionCallback         callback;
+  std::vector<unsigned char> data;
+  Clock::time_point          start;
+};
+
+/*
+ * Order for the max-heap: higher priority first, older requests first among
+ * equal priorities.
+ */
+bool AssetStreamer::QueueEntry::operator <(const QueueEntry& other) const
+{
+  return priority < other.priority ||
+         (priority == other.priority && sequence > other.sequence);
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] pPool      - pool running decode functions and, without
+ *                         asynchronous I/O, the reads, NULL for the default
+ *                         pool. Blocking reads need a pool with workers to
+ *                         stay off the calling thread.
+ * @param[in] maxReads   - maximum number of files read at the same time
+ * @param[in] useAsyncIO - false forces blocking reads on the pool
+ */
+AssetStreamer::AssetStreamer(ThreadPool* pPool, unsigned int maxReads, bool useAsyncIO)
+  : m_pPool(pPool != NULL ? pPool : &ThreadPool::getDefault())
+  , m_maxReads(maxReads > 0 ? maxReads : 1)
+  , m_sequence(0)
+  , m_nextId(INVALID_REQUEST + 1)
+  , m_pending(0)
+  , m_reads(0)
+  , m_decodes(0)
+  , m_callbacks(0)
+  , m_isDispatching(false)
+  , m_isStopping(false)
+{
+  resetMetrics();
+  if (useAsyncIO && m_reader.open())
+  {
+    m_ioThread = std::thread(&AssetStreamer::ioMain, this);
+  }
+}
+
+/**
+ * @brief Destructor.
+ *
+ * Cancels all requests and waits for the reads and decodes still running.
+ * Callbacks of requests not yet delivered by update() are not called.
+ */
+AssetStreamer::~AssetStreamer()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+    m_queue.clear();
+    for (std::unordered_map<RequestId, Request*>::iterator it = m_requests.begin();
+         it != m_requests.end(); ++it)
+    {
+      it->second->isCancelRequested = true;
+      if (it->second->status == STATUS_READING && m_reader.isOpen())
+      {
+        m_reader.cancel(it->second);
+      }
+    }
+  }
+
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (m_reads == 0 && m_decodes == 0 && m_callbacks == 0)
+      {
+        break;
+      }
+    }
+    if (!m_pPool->runPendingTask())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  if (m_ioThread.joinable())
+  {
+    m_reader.wake();
+    m_ioThread.join();
+  }
+  m_reader.close();
+
+  for (std::unordered_map<RequestId, Request*>::iterator it = m_requests.begin();
+       it != m_requests.end(); ++it)
+  {
+    delete it->second;
+  }
+}
+
+/**
+ * @brief Queue a file for loading.
+ *
+ * @param[in] path     - path to the file
+ * @param[in] priority - higher priorities are read first
+ * @param[in] decode   - function transforming the file contents in place on
+ *                       the thread pool, may be empty. Returning false fails
+ *                       the request.
+ * @param[in] callback - function receiving the result from update()
+ * @return identifier of the request
+ */
+AssetStreamer::RequestId AssetStreamer::request(const String& path, float priority,
+                                                const DecodeTask& decode,
+                                                const CompletionCallback& callback)
+{
+  Request* pRequest = new Request;
+  pRequest->path              = path;
+  pRequest->priority          = priority;
+  pRequest->version           = 0;
+  pRequest->status            = STATUS_PENDING;
+  pRequest->isCancelRequested = false;
+  pRequest->decode            = decode;
+  pRequest->callback          = callback;
+  pRequest->start             = Clock::now();
+
+  RequestId id;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    id = m_nextId++;
+    if (m_nextId == INVALID_REQUEST)
+    {
+      m_nextId = INVALID_REQUEST + 1;
+    }
+    pRequest->id       = id;
+    pRequest->sequence = m_sequence++;
+    m_requests[id] = pRequest;
+    ++m_pending;
+    push(pRequest);
+  }
+
+  dispatch();
+  return id;
+}
+
+/**
+ * @brief Change the priority of a request that is still queued.
+ *
+ * @param[in] id       - identifier returned by request()
+ * @param[in] priority - the new priority
+ * @return true if the request was still waiting for a read slot
+ */
+bool AssetStreamer::reprioritize(RequestId id, float priority)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  std::unordered_map<RequestId, Request*>::iterator it = m_requests.find(id);
+  if (it == m_requests.end() || it->second->status != STATUS_PENDING)
+  {
+    return false;
+  }
+
+  Request* pRequest = it->second;
+  if (pRequest->priority != priority)
+  {
+    pRequest->priority = priority;
+    ++pRequest->version;
+    if (m_queue.size() >= 2 * m_pending + MIN_STALE_ENTRIES)
+    {
+      rebuildQueue();
+    }
+    else
+    {
+      push(pRequest);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Cancel a request.
+ *
+ * Queued requests are dropped right away, reads in progress are aborted if
+ * the reader supports it and decodes are left to finish with their result
+ * discarded. The callback is still called, with STATUS_CANCELLED.
+ *
+ * @param[in] id - identifier returned by request()
+ * @return true if the request had not finished yet
+ */
+bool AssetStreamer::cancel(RequestId id)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  std::unordered_map<RequestId, Request*>::iterator it = m_requests.find(id);
+  if (it == m_requests.end() || it->second->isCancelRequested)
+  {
+    return false;
+  }
+
+  Request* pRequest = it->second;
+  switch (pRequest->status)
+  {
+  case STATUS_PENDING:
+    --m_pending;
+    finish(pRequest, STATUS_CANCELLED);
+    return true;
+
+  case STATUS_READING:
+    pRequest->isCancelRequested = true;
+    if (m_reader.isOpen())
+    {
+      m_reader.cancel(pRequest);
+    }
+    return true;
+
+  case STATUS_DECODING:
+    pRequest->isCancelRequested = true;
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief Hand finished requests to their callbacks on the calling thread.
+ *
+ * Never waits for outstanding work. The data passed to a callback is freed
+ * after it returns unless the callback swaps it out.
+ *
+ * @param[in] maxCompletions - maximum number of callbacks to call, 0 for all
+ *                             finished requests
+ * @return number of callbacks called
+ */
+size_t AssetStreamer::update(size_t maxCompletions)
+{
+  LITE_PROFILE_ZONE("AssetStreamer::update");
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    size_t count = m_ready.size();
+    if (maxCompletions > 0 && maxCompletions < count)
+    {
+      count = maxCompletions;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+      m_delivered.push_back(m_ready.front());
+      m_requests.erase(m_ready.front()->id);
+      m_ready.pop_front();
+    }
+  }
+
+  size_t count = m_delivered.size();
+  for (size_t i = 0; i < count; ++i)
+  {
+    Request* pRequest = m_delivered[i];
+    if (pRequest->callback)
+    {
+      pRequest->callback(pRequest->id, pRequest->status, pRequest->data);
+    }
+    delete pRequest;
+  }
+  m_delivered.clear();
+  return count;
+}
+
+/**
+ * @brief Check whether every request has been delivered.
+ *
+ * @return true if no request is queued, in progress or waiting for update()
+ */
+bool AssetStreamer::isIdle()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return m_requests.empty();
+}
+
+/**
+ * @brief Obtain the current streaming statistics.
+ *
+ * @param[out] metrics - receives the statistics
+ */
+void AssetStreamer::getMetrics(Metrics& metrics)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  double seconds = std::chrono::duration<double>(Clock::now() - m_metricsStart).count();
+
+  metrics.queueDepth       = m_pending;
+  metrics.readsInFlight    = m_reads;
+  metrics.decodesInFlight  = m_decodes;
+  metrics.readyCount       = m_ready.size();
+  metrics.completedCount   = m_completedCount;
+  metrics.failedCount      = m_failedCount;
+  metrics.cancelledCount   = m_cancelledCount;
+  metrics.bytesRead        = m_bytesRead;
+  metrics.bytesPerSecond   = seconds > 0.0 ? m_bytesRead / seconds : 0.0;
+  metrics.averageLatencyMs = m_completedCount > 0 ? m_latencySumMs / m_completedCount : 0.0;
+  metrics.maxLatencyMs     = m_maxLatencyMs;
+  metrics.isAsyncIO        = m_reader.isOpen();
+}
+
+/**
+ * @brief Restart the counters, throughput and latency statistics.
+ */
+void AssetStreamer::resetMetrics()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_metricsStart   = Clock::now();
+  m_bytesRead      = 0;
+  m_completedCount = 0;
+  m_failedCount    = 0;
+  m_cancelledCount = 0;
+  m_latencySumMs   = 0.0;
+  m_maxLatencyMs   = 0.0;
+}
+
+/*
+ * Add a queue entry for the current priority of a request. Expects the
+ * mutex to be held.
+ */
+void AssetStreamer::push(Request* pRequest)
+{
+  QueueEntry entry;
+  entry.priority = pRequest->priority;
+  entry.sequence = pRequest->sequence;
+  entry.version  = pRequest->version;
+  entry.id       = pRequest->id;
+  m_queue.push_back(entry);
+  std::push_heap(m_queue.begin(), m_queue.end());
+}
+
+/*
+ * Recreate the queue from the pending requests, dropping stale entries.
+ * Expects the mutex to be held.
+ */
+void AssetStreamer::rebuildQueue()
+{
+  m_queue.clear();
+  for (std::unordered_map<RequestId, Request*>::iterator it = m_requests.begin();
+       it != m_requests.end(); ++it)
+  {
+    if (it->second->status == STATUS_PENDING)
+    {
+      push(it->second);
+    }
+  }
+}
+
+/*
+ * Start reads for the highest priority requests while read slots are free.
+ * Only one thread dispatches at a time, it keeps going until no slot or no
+ * request is left, which covers the calls that returned early meanwhile.
+ */
+void AssetStreamer::dispatch()
+{
+  bool isFirst = true;
+  std::vector<Request*> started;
+  for (;;)
+  {
+    started.clear();
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (isFirst && m_isDispatching)
+      {
+        return;
+      }
+      isFirst = false;
+
+      while (m_reads < m_maxReads && !m_queue.empty() && !m_isStopping)
+      {
+        QueueEntry entry = m_queue.front();
+        std::pop_heap(m_queue.begin(), m_queue.end());
+        m_queue.pop_back();
+
+        std::unordered_map<RequestId, Request*>::iterator it = m_requests.find(entry.id);
+        if (it == m_requests.end() || it->second->status != STATUS_PENDING ||
+            it->second->version != entry.version)
+        {
+          continue;
+        }
+
+        it->second->status = STATUS_READING;
+        --m_pending;
+        ++m_reads;
+        started.push_back(it->second);
+      }
+
+      m_isDispatching = !started.empty();
+      if (!m_isDispatching)
+      {
+        return;
+      }
+    }
+
+    for (size_t i = 0; i < started.size(); ++i)
+    {
+      Request* pRequest = started[i];
+      if (m_reader.isOpen())
+      {
+        if (!m_reader.read(pRequest->path, pRequest->data, pRequest))
+        {
+          onRead(pRequest, false, false);
+        }
+      }
+      else
+      {
+        m_pPool->enqueue([this, pRequest]() {
+          readBlocking(pRequest);
+        });
+      }
+    }
+  }
+}
+
+/*
+ * Read a whole file on the calling thread.
+ */
+void AssetStreamer::readBlocking(Request* pRequest)
+{
+  bool isCancelled;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    isCancelled = pRequest->isCancelRequested;
+  }
+
+  bool isSuccess = false;
+  if (!isCancelled)
+  {
+    std::ifstream file(pRequest->path.c_str(), std::ios::binary | std::ios::ate);
+    std::streamoff size = file ? (std::streamoff) file.tellg() : -1;
+    if (size >= 0)
+    {
+      pRequest->data.resize((size_t) size);
+      file.seekg(0);
+      isSuccess = size == 0 || file.read((char*) &pRequest->data[0], size).good();
+    }
+  }
+  onRead(pRequest, isSuccess, true);
+}
+
+/*
+ * Called when the read of a request has finished, successfully or not.
+ * Starts the decode and refills the freed read slot. The call stays counted
+ * until it returns, so the destructor cannot finish underneath it.
+ */
+void AssetStreamer::onRead(Request* pRequest, bool isSuccess, bool isOnPool)
+{
+  bool isDecoding = false;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    --m_reads;
+    ++m_callbacks;
+    if (isSuccess)
+    {
+      m_bytesRead += pRequest->data.size();
+    }
+
+    if (pRequest->isCancelRequested)
+    {
+      finish(pRequest, STATUS_CANCELLED);
+    }
+    else if (!isSuccess)
+    {
+      finish(pRequest, STATUS_FAILED);
+    }
+    else if (!pRequest->decode)
+    {
+      finish(pRequest, STATUS_COMPLETE);
+    }
+    else
+    {
+      pRequest->status = STATUS_DECODING;
+      ++m_decodes;
+      isDecoding = true;
+    }
+  }
+
+  if (isDecoding)
+  {
+    if (isOnPool)
+    {
+      onDecoded(pRequest, pRequest->decode(pRequest->data));
+    }
+    else
+    {
+      m_pPool->enqueue([this, pRequest]() {
+        onDecoded(pRequest, pRequest->decode(pRequest->data));
+      });
+    }
+  }
+
+  dispatch();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  --m_callbacks;
+}
+
+/*
+ * Called when the decode function of a request has returned.
+ */
+void AssetStreamer::onDecoded(Request* pRequest, bool isSuccess)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  --m_decodes;
+  finish(pRequest, pRequest->isCancelRequested ? STATUS_CANCELLED :
+                   isSuccess ? STATUS_COMPLETE : STATUS_FAILED);
+}
+
+/*
+ * Move a request to the list delivered by update(). Expects the mutex to
+ * be held.
+ */
+void AssetStreamer::finish(Request* pRequest, Status status)
+{
+  pRequest->status = status;
+  if (status == STATUS_COMPLETE)
+  {
+    double latencyMs = std::chrono::duration<double, std::milli>(
+      Clock::now() - pRequest->start).count();
+    m_latencySumMs += latencyMs;
+    m_maxLatencyMs = std::max(m_maxLatencyMs, latencyMs);
+    ++m_completedCount;
+  }
+  else if (status == STATUS_FAILED)
+  {
+    ++m_failedCount;
+  }
+  else
+  {
+    ++m_cancelledCount;
+    std::vector<unsigned char>().swap(pRequest->data);
+  }
+  m_ready.push_back(pRequest);
+}
+
+/*
+ * Collects finished reads from the reader until the streamer is destroyed.
+ */
+void AssetStreamer::ioMain()
+{
+  LITE_PROFILE_THREAD("AssetStreamer I/O");
+  AsyncFileReader::Completion completions[COMPLETION_BATCH];
+  for (;;)
+  {
+    size_t count = m_reader.poll(completions, COMPLETION_BATCH, AsyncFileReader::WAIT_FOREVER);
+    for (size_t i = 0; i < count; ++i)
+    {
+      onRead((Request*) completions[i].pUserData, completions[i].isSuccess, false);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_isStopping && m_reads == 0)
+    {
+      return;
+    }
+  }
+}
+
+}
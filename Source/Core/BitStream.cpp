@@ -0,0 +1,263 @@
+/**
+ * @file BitStream.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the BitWriter and BitReader classes
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\BitStream.h"
+
+namespace Lite
+{
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] pBuffer - buffer receiving the bits
+ * @param[in] capacity - size of the buffer in bytes
+ */
+BitWriter::BitWriter(unsigned char* pBuffer, size_t capacity)
+  : m_pBuffer(pBuffer)
+  , m_capacity(pBuffer != NULL ? capacity : 0)
+  , m_size(0)
+  , m_scratch(0)
+  , m_scratchBits(0)
+  , m_hasOverflowed(false)
+{
+}
+
+/**
+ * @brief Append the low bits of a value.
+ *
+ * @param[in] value - the value, bits above the count are ignored
+ * @param[in] bits - number of bits, from 1 to 32
+ */
+void BitWriter::write(unsigned int value, unsigned int bits)
+{
+  unsigned long long mask = (1ull << bits) - 1;
+  m_scratch |= (value & mask) << m_scratchBits;
+  m_scratchBits += bits;
+  if (m_scratchBits < 32)
+  {
+    return;
+  }
+
+  if (m_size + 4 <= m_capacity)
+  {
+    unsigned int word = (unsigned int) m_scratch;
+    m_pBuffer[m_size] = (unsigned char) word;
+    m_pBuffer[m_size + 1] = (unsigned char) (word >> 8);
+    m_pBuffer[m_size + 2] = (unsigned char) (word >> 16);
+    m_pBuffer[m_size + 3] = (unsigned char) (word >> 24);
+    m_size += 4;
+  }
+  else
+  {
+    m_hasOverflowed = true;
+  }
+  m_scratch >>= 32;
+  m_scratchBits -= 32;
+}
+
+/**
+ * @brief Append the low bits of every value of an array.
+ *
+ * @param[in] pValues - the values, bits above the count are ignored
+ * @param[in] count - number of values
+ * @param[in] bits - bits per value, from 1 to 32
+ */
+void BitWriter::write(const unsigned int* pValues, size_t count, unsigned int bits)
+{
+  // The register lives in locals, and whole words go out while they fit.
+  unsigned long long mask = (1ull << bits) - 1;
+  unsigned long long scratch = m_scratch;
+  unsigned int scratchBits = m_scratchBits;
+  for (size_t i = 0; i < count; ++i)
+  {
+    scratch |= (pValues[i] & mask) << scratchBits;
+    scratchBits += bits;
+    if (scratchBits < 32)
+    {
+      continue;
+    }
+
+    if (m_size + 4 <= m_capacity)
+    {
+      unsigned int word = (unsigned int) scratch;
+      unsigned char* pTarget = m_pBuffer + m_size;
+      pTarget[0] = (unsigned char) word;
+      pTarget[1] = (unsigned char) (word >> 8);
+      pTarget[2] = (unsigned char) (word >> 16);
+      pTarget[3] = (unsigned char) (word >> 24);
+      m_size += 4;
+    }
+    else
+    {
+      m_hasOverflowed = true;
+    }
+    scratch >>= 32;
+    scratchBits -= 32;
+  }
+  m_scratch = scratch;
+  m_scratchBits = scratchBits;
+}
+
+/**
+ * @brief Store the bits still held in the register, padded to a byte.
+ *
+ * @return Number of bytes written to the buffer.
+ */
+size_t BitWriter::flush()
+{
+  while (m_scratchBits > 0)
+  {
+    if (m_size < m_capacity)
+    {
+      m_pBuffer[m_size++] = (unsigned char) m_scratch;
+    }
+    else
+    {
+      m_hasOverflowed = true;
+    }
+    m_scratch >>= 8;
+    m_scratchBits = m_scratchBits > 8 ? m_scratchBits - 8 : 0;
+  }
+  return m_size;
+}
+
+/**
+ * @brief Get the number of bits written so far.
+ *
+ * @return The number of bits.
+ */
+size_t BitWriter::getBitCount() const
+{
+  return m_size * 8 + m_scratchBits;
+}
+
+/**
+ * @brief Check whether bits did not fit in the buffer.
+ *
+ * @return True if bits were dropped.
+ */
+bool BitWriter::hasOverflowed() const
+{
+  return m_hasOverflowed;
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] pData - bits written by a BitWriter
+ * @param[in] size - size of the data in bytes
+ */
+BitReader::BitReader(const unsigned char* pData, size_t size)
+  : m_pData(pData)
+  , m_size(pData != NULL ? size : 0)
+  , m_position(0)
+  , m_bitCount(0)
+  , m_scratch(0)
+  , m_scratchBits(0)
+{
+}
+
+/**
+ * @brief Read the next value.
+ *
+ * @param[in] bits - number of bits, from 1 to 32
+ *
+ * @return The value.
+ */
+unsigned int BitReader::read(unsigned int bits)
+{
+  if (m_scratchBits < bits)
+  {
+    // Refill 32 bits, past the end of the data they are zero.
+    unsigned long long word = 0;
+    for (unsigned int i = 0; i < 4 && m_position < m_size; ++i, ++m_position)
+    {
+      word |= (unsigned long long) m_pData[m_position] << (i * 8);
+    }
+    m_scratch |= word << m_scratchBits;
+    m_scratchBits += 32;
+  }
+
+  unsigned int value = (unsigned int) (m_scratch & ((1ull << bits) - 1));
+  m_scratch >>= bits;
+  m_scratchBits -= bits;
+  m_bitCount += bits;
+  return value;
+}
+
+/**
+ * @brief Read an array of values of the same size.
+ *
+ * @param[out] pValues - receives the values
+ * @param[in] count - number of values
+ * @param[in] bits - bits per value, from 1 to 32
+ */
+void BitReader::read(unsigned int* pValues, size_t count, unsigned int bits)
+{
+  // Refills take whole words while four bytes are left.
+  unsigned long long mask = (1ull << bits) - 1;
+  unsigned long long scratch = m_scratch;
+  unsigned int scratchBits = m_scratchBits;
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (scratchBits < bits)
+    {
+      unsigned long long word = 0;
+      if (m_position + 4 <= m_size)
+      {
+        const unsigned char* pSource = m_pData + m_position;
+        word = pSource[0] | (unsigned int) pSource[1] << 8 | (unsigned int) pSource[2] << 16 |
+               (unsigned long long) pSource[3] << 24;
+        m_position += 4;
+      }
+      else
+      {
+        for (unsigned int k = 0; k < 4 && m_position < m_size; ++k, ++m_position)
+        {
+          word |= (unsigned long long) m_pData[m_position] << (k * 8);
+        }
+      }
+      scratch |= word << scratchBits;
+      scratchBits += 32;
+    }
+
+    pValues[i] = (unsigned int) (scratch & mask);
+    scratch >>= bits;
+    scratchBits -= bits;
+  }
+  m_scratch = scratch;
+  m_scratchBits = scratchBits;
+  m_bitCount += count * bits;
+}
+
+/**
+ * @brief Get the number of bits read so far.
+ *
+ * @return The number of bits.
+ */
+size_t BitReader::getBitCount() const
+{
+  return m_bitCount;
+}
+
+/**
+ * @brief Check whether more bits were read than the data holds.
+ *
+ * @return True if reads went past the end.
+ */
+bool BitReader::hasOverflowed() const
+{
+  return m_bitCount > m_size * 8;
+}
+
+}
@@ -0,0 +1,368 @@
+/**
+ * @file FixedStepLoop.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the FixedStepLoop class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\FixedStepLoop.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\Window.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Lite
+{
+
+/**
+ * @brief Constructor.
+ *
+ * Steps 60 times per second, at most DEFAULT_MAX_STEPS times per update,
+ * and counts an update as a quarter of a second at most.
+ */
+FixedStepLoop::FixedStepLoop()
+  : m_step(1.0 / 60.0)
+  , m_maxSteps(DEFAULT_MAX_STEPS)
+  , m_maxUpdateTime(0.25)
+  , m_isThreaded(false)
+  , m_isRunning(false)
+{
+  reset();
+}
+
+/**
+ * @brief Destructor. Stops the simulation thread.
+ */
+FixedStepLoop::~FixedStepLoop()
+{
+  stop();
+  if (m_simulation.joinable())
+  {
+    m_simulation.join();
+  }
+}
+
+/**
+ * @brief Set the time a simulation step advances.
+ *
+ * @param[in] seconds - the step in seconds
+ */
+void FixedStepLoop::setStep(double seconds)
+{
+  m_step = std::max(seconds, 1e-6);
+}
+
+/**
+ * @brief Get the time a simulation step advances.
+ *
+ * @return The step in seconds.
+ */
+double FixedStepLoop::getStep() const
+{
+  return m_step;
+}
+
+/**
+ * @brief Limit the steps an update runs to catch up.
+ *
+ * @param[in] steps - most steps per update, at least 1
+ */
+void FixedStepLoop::setMaxSteps(unsigned int steps)
+{
+  m_maxSteps = std::max(steps, 1u);
+}
+
+/**
+ * @brief Limit the time an update counts, for example after a breakpoint.
+ *
+ * @param[in] seconds - most elapsed time per update
+ */
+void FixedStepLoop::setMaxUpdateTime(double seconds)
+{
+  m_maxUpdateTime = std::max(seconds, 0.0);
+}
+
+/**
+ * @brief Read time from a function instead of the clock.
+ *
+ * When run() is threaded the function is called from both the simulation
+ * and the rendering thread, so it has to be safe to call concurrently.
+ *
+ * @param[in] source - gives the time in seconds, or an empty function to
+ *                     use the clock again
+ */
+void FixedStepLoop::setTimeSource(const TimeSource& source)
+{
+  m_timeSource = source;
+}
+
+/**
+ * @brief Set the function advancing the simulation.
+ *
+ * It receives the time the state is at after the step and the step.
+ *
+ * @param[in] function - the step function
+ */
+void FixedStepLoop::setStepFunction(const StepFunction& function)
+{
+  m_stepFunction = function;
+}
+
+/**
+ * @brief Set the function run() draws a frame with.
+ *
+ * It receives the time to show.
+ *
+ * @param[in] function - the render function
+ */
+void FixedStepLoop::setRenderFunction(const RenderFunction& function)
+{
+  m_renderFunction = function;
+}
+
+/**
+ * @brief Add elapsed time and run the steps it completes.
+ *
+ * @param[in] elapsed - seconds since the last update
+ *
+ * @return Number of steps run.
+ */
+unsigned int FixedStepLoop::advance(double elapsed)
+{
+  return advance(elapsed, m_lastClock + elapsed);
+}
+
+/**
+ * @brief Get the time of the simulation.
+ *
+ * @return The time after the last step, in seconds.
+ */
+double FixedStepLoop::getTime() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_time;
+}
+
+/**
+ * @brief Get how far the accumulated time is into the next step.
+ *
+ * @return A fraction from 0 to 1.
+ */
+float FixedStepLoop::getAlpha() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return (float) (m_accumulator / m_step);
+}
+
+/**
+ * @brief Get the time rendering shows.
+ *
+ * It is a step behind the simulation plus the accumulated time, so that it
+ * lies between the last two steps. While the simulation runs on its own
+ * thread, the time since its last update is added as well.
+ *
+ * @return The time in seconds.
+ */
+double FixedStepLoop::getRenderTime() const
+{
+  double clock = m_isThreaded ? now() : 0.0;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  double time = m_time - m_step + m_accumulator;
+  if (m_isThreaded)
+  {
+    time += std::max(clock - m_lastClock, 0.0);
+  }
+  return std::min(time, m_time);
+}
+
+/**
+ * @brief Update and render until poll returns false or stop() is called.
+ *
+ * @param[in] poll - called at the start of every frame, returns whether to
+ *                   go on
+ * @param[in] isThreaded - if true the simulation runs on its own thread
+ */
+void FixedStepLoop::run(const PollFunction& poll, bool isThreaded)
+{
+  m_isRunning = true;
+  m_isThreaded = isThreaded;
+  m_lastClock = now();
+  if (isThreaded)
+  {
+    m_simulation = std::thread(&FixedStepLoop::simulationMain, this);
+  }
+
+  while (m_isRunning && poll())
+  {
+    if (!isThreaded)
+    {
+      double clock = now();
+      advance(clock - m_lastClock, clock);
+    }
+
+    if (m_renderFunction)
+    {
+      LITE_PROFILE_ZONE("FixedStepLoop::render");
+      m_renderFunction(getRenderTime());
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.frameCount;
+  }
+
+  m_isRunning = false;
+  if (m_simulation.joinable())
+  {
+    m_simulation.join();
+  }
+  m_isThreaded = false;
+}
+
+/**
+ * @brief Update and render until the window is closed or stop() is called.
+ *
+ * @param[in] window - window whose events are polled every frame
+ * @param[in] isThreaded - if true the simulation runs on its own thread
+ */
+void FixedStepLoop::run(Window& window, bool isThreaded)
+{
+  run([&window]() -> bool
+  {
+    window.pollEvents();
+    return !window.isCloseRequested();
+  }, isThreaded);
+}
+
+/**
+ * @brief Make run() return after the current frame. Safe from any thread.
+ */
+void FixedStepLoop::stop()
+{
+  m_isRunning = false;
+}
+
+/**
+ * @brief Start again at time 0 and clear the statistics.
+ *
+ * Must not be called while run() is running.
+ */
+void FixedStepLoop::reset()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_time = 0.0;
+  m_accumulator = 0.0;
+  m_lastClock = 0.0;
+  m_stats.stepCount = 0;
+  m_stats.updateCount = 0;
+  m_stats.frameCount = 0;
+  m_stats.cappedUpdateCount = 0;
+  m_stats.maxUpdateSteps = 0;
+  m_stats.simulatedTime = 0.0;
+  m_stats.droppedTime = 0.0;
+}
+
+/**
+ * @brief Get the steps and frames so far.
+ *
+ * @param[out] stats - receives the statistics
+ */
+void FixedStepLoop::getStats(Stats& stats) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  stats = m_stats;
+}
+
+/* Current time in seconds from the time source or the clock. */
+double FixedStepLoop::now() const
+{
+  if (m_timeSource)
+  {
+    return m_timeSource();
+  }
+  return std::chrono::duration<double>(
+    std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Add elapsed time, measured at clock, and run up to m_maxSteps steps.
+ * Whole steps left over after that are dropped. The time and the
+ * accumulator are updated after every step so that the rendering thread
+ * sees them consistent with the published state.
+ */
+unsigned int FixedStepLoop::advance(double elapsed, double clock)
+{
+  LITE_PROFILE_ZONE("FixedStepLoop::advance");
+
+  double counted = std::min(std::max(elapsed, 0.0), m_maxUpdateTime);
+  double time, accumulator;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_accumulator += counted;
+    m_lastClock = clock;
+    time = m_time;
+    accumulator = m_accumulator;
+  }
+
+  unsigned int steps = 0;
+  while (accumulator >= m_step && steps < m_maxSteps)
+  {
+    time += m_step;
+    if (m_stepFunction)
+    {
+      m_stepFunction(time, (float) m_step);
+    }
+    accumulator -= m_step;
+    ++steps;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_time = time;
+    m_accumulator = accumulator;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  double dropped = std::max(elapsed, 0.0) - counted;
+  if (accumulator >= m_step)
+  {
+    double behind = floor(accumulator / m_step) * m_step;
+    m_accumulator = accumulator - behind;
+    dropped += behind;
+  }
+  if (dropped > 0.0)
+  {
+    ++m_stats.cappedUpdateCount;
+    m_stats.droppedTime += dropped;
+  }
+  ++m_stats.updateCount;
+  m_stats.stepCount += steps;
+  m_stats.maxUpdateSteps = std::max(m_stats.maxUpdateSteps, steps);
+  m_stats.simulatedTime = m_time;
+  LITE_PROFILE_COUNTER("FixedStepLoop::steps", steps);
+  return steps;
+}
+
+/* Simulation thread of run(): updates against the clock, sleeping between steps. */
+void FixedStepLoop::simulationMain()
+{
+  LITE_PROFILE_THREAD("FixedStepLoop simulation");
+  while (m_isRunning)
+  {
+    double clock = now();
+    advance(clock - m_lastClock, clock);
+
+    double wait = m_step - m_accumulator;
+    if (wait > 0.0)
+    {
+      std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+  }
+}
+
+}
@@ -0,0 +1,500 @@
+/**
+ * @file FrameCapture.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the FrameCapture class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\FrameCapture.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+static const size_t PIXEL_SIZE = 4;
+
+/*
+ * Replace every byte by its difference to the same channel of the previous
+ * pixel. Runs backwards so that it can work in place.
+ */
+static void applyDeltaFilter(unsigned char* pData, size_t size)
+{
+  if (size <= PIXEL_SIZE)
+  {
+    return;
+  }
+
+  size_t i = size;
+#ifdef LITE_SSE2
+  while ((i - PIXEL_SIZE) % 16 != 0)
+  {
+    --i;
+    pData[i] = (unsigned char) (pData[i] - pData[i - PIXEL_SIZE]);
+  }
+  while (i >= PIXEL_SIZE + 16)
+  {
+    i -= 16;
+    __m128i current  = _mm_loadu_si128((const __m128i*) (pData + i));
+    __m128i previous = _mm_loadu_si128((const __m128i*) (pData + i - PIXEL_SIZE));
+    _mm_storeu_si128((__m128i*) (pData + i), _mm_sub_epi8(current, previous));
+  }
+#endif
+  while (i > PIXEL_SIZE)
+  {
+    --i;
+    pData[i] = (unsigned char) (pData[i] - pData[i - PIXEL_SIZE]);
+  }
+}
+
+static void removeDeltaFilter(unsigned char* pData, size_t size)
+{
+  for (size_t i = PIXEL_SIZE; i < size; ++i)
+  {
+    pData[i] = (unsigned char) (pData[i] + pData[i - PIXEL_SIZE]);
+  }
+}
+
+/*
+ * Halve the resolution in place by averaging 2x2 blocks. The output is
+ * always written behind the pixels still to be read.
+ */
+static void downsample(unsigned char* pPixels, int width, int height)
+{
+  int halfWidth = width / 2, halfHeight = height / 2;
+  size_t stride = (size_t) width * PIXEL_SIZE;
+  for (int y = 0; y < halfHeight; ++y)
+  {
+    const unsigned char* pRow0 = pPixels + 2 * y * stride;
+    const unsigned char* pRow1 = pRow0 + stride;
+    unsigned char* pOut = pPixels + (size_t) y * halfWidth * PIXEL_SIZE;
+    int x = 0;
+#ifdef LITE_SSE2
+    for (; x + 4 <= halfWidth; x += 4)
+    {
+      // Average the rows, then pairs of horizontally adjacent pixels.
+      __m128i a = _mm_avg_epu8(_mm_loadu_si128((const __m128i*) (pRow0 + x * 8)),
+                               _mm_loadu_si128((const __m128i*) (pRow1 + x * 8)));
+      __m128i b = _mm_avg_epu8(_mm_loadu_si128((const __m128i*) (pRow0 + x * 8 + 16)),
+                               _mm_loadu_si128((const __m128i*) (pRow1 + x * 8 + 16)));
+      __m128i even = _mm_unpacklo_epi64(_mm_shuffle_epi32(a, _MM_SHUFFLE(2, 0, 2, 0)),
+                                        _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 0, 2, 0)));
+      __m128i odd  = _mm_unpacklo_epi64(_mm_shuffle_epi32(a, _MM_SHUFFLE(3, 1, 3, 1)),
+                                        _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 1, 3, 1)));
+      _mm_storeu_si128((__m128i*) (pOut + x * PIXEL_SIZE), _mm_avg_epu8(even, odd));
+    }
+#endif
+    for (; x < halfWidth; ++x)
+    {
+      for (size_t c = 0; c < PIXEL_SIZE; ++c)
+      {
+        size_t offset = (size_t) x * 2 * PIXEL_SIZE + c;
+        pOut[x * PIXEL_SIZE + c] = (unsigned char) ((pRow0[offset] + pRow0[offset + PIXEL_SIZE] +
+                                                     pRow1[offset] + pRow1[offset + PIXEL_SIZE] + 2) >> 2);
+      }
+    }
+  }
+}
+
+/**
+ * Default constructor.
+ * Nothing is recorded until open() is called.
+ */
+FrameCapture::FrameCapture()
+  : m_pPool(NULL)
+  , m_pCurrent(NULL)
+  , m_width(0)
+  , m_height(0)
+  , m_slotLimit(0)
+  , m_frameIndex(0)
+  , m_nextSequence(0)
+  , m_nextWrite(0)
+  , m_encoding(0)
+  , m_isOpen(false)
+  , m_isClosing(false)
+  , m_encodeMs(0.0)
+{
+  memset(&m_stats, 0, sizeof(m_stats));
+}
+
+/**
+ * Destructor.
+ * Writes the frames still in flight and closes the file.
+ */
+FrameCapture::~FrameCapture()
+{
+  close();
+}
+
+/**
+ * @brief Start recording to a file.
+ *
+ * @param[in] path         - path to the output file
+ * @param[in] width        - frame width in pixels
+ * @param[in] height       - frame height in pixels
+ * @param[in] memoryBudget - upper bound for the pooled frame buffers, at
+ *                           least MIN_BUFFERS buffers are used regardless
+ * @param[in] pPool        - pool encoding the frames, NULL for the default
+ *                           pool. Without workers the encoding happens in
+ *                           endFrame().
+ * @return true on success, false if the file could not be created
+ */
+bool FrameCapture::open(const String& path, int width, int height,
+                        size_t memoryBudget, ThreadPool* pPool)
+{
+  close();
+  if (width <= 0 || height <= 0)
+  {
+    return false;
+  }
+
+  m_file.open(path.c_str(), std::ios::binary | std::ios::trunc);
+  if (!m_file)
+  {
+    return false;
+  }
+
+  FileHeader header;
+  memcpy(header.magic, "LCAP", 4);
+  header.version = FILE_VERSION;
+  header.width   = (unsigned int) width;
+  header.height  = (unsigned int) height;
+  m_file.write((const char*) &header, sizeof(header));
+
+  size_t frameSize = (size_t) width * height * PIXEL_SIZE;
+  size_t slotSize = frameSize + LzCompressor::getMaxCompressedSize(frameSize);
+
+  m_pPool        = pPool != NULL ? pPool : &ThreadPool::getDefault();
+  m_width        = width;
+  m_height       = height;
+  m_slotLimit    = std::max<size_t>(memoryBudget / slotSize, MIN_BUFFERS);
+  m_frameIndex   = 0;
+  m_nextSequence = 0;
+  m_nextWrite    = 0;
+  m_encoding     = 0;
+  m_isClosing    = false;
+  m_encodeMs     = 0.0;
+  memset(&m_stats, 0, sizeof(m_stats));
+  m_isOpen = true;
+
+  m_writer = std::thread(&FrameCapture::writerMain, this);
+  return true;
+}
+
+/**
+ * @brief Finish recording.
+ *
+ * Blocks until every submitted frame is written, then closes the file and
+ * frees the buffers.
+ */
+void FrameCapture::close()
+{
+  if (!m_isOpen)
+  {
+    return;
+  }
+
+  cancelFrame();
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (m_encoding == 0)
+      {
+        m_isClosing = true;
+        break;
+      }
+    }
+    if (!m_pPool->runPendingTask())
+    {
+      std::this_thread::yield();
+    }
+  }
+  m_condition.notify_all();
+  m_writer.join();
+
+  m_file.close();
+  for (size_t i = 0; i < m_slots.size(); ++i)
+  {
+    delete m_slots[i];
+  }
+  m_slots.clear();
+  m_freeSlots.clear();
+  m_isOpen = false;
+}
+
+/**
+ * @brief Check whether a recording is in progress.
+ *
+ * @return true between open() and close()
+ */
+bool FrameCapture::isOpen() const
+{
+  return m_isOpen;
+}
+
+/**
+ * @brief Obtain the width of the recorded frames.
+ *
+ * @return frame width in pixels
+ */
+int FrameCapture::getWidth() const
+{
+  return m_width;
+}
+
+/**
+ * @brief Obtain the height of the recorded frames.
+ *
+ * @return frame height in pixels
+ */
+int FrameCapture::getHeight() const
+{
+  return m_height;
+}
+
+/**
+ * @brief Obtain a buffer for the next frame.
+ *
+ * The caller writes width x height 32 bit pixels and calls endFrame() or
+ * cancelFrame(). When no buffer is free the frame is dropped and NULL is
+ * returned, the method never waits.
+ *
+ * @param[out] stride - receives the size of a buffer row in bytes
+ * @return the frame buffer or NULL if the frame is dropped
+ */
+unsigned char* FrameCapture::beginFrame(size_t& stride)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!m_isOpen)
+  {
+    return NULL;
+  }
+
+  stride = (size_t) m_width * PIXEL_SIZE;
+  if (m_pCurrent != NULL)
+  {
+    return &m_pCurrent->pixels[0];
+  }
+
+  Slot* pSlot = NULL;
+  if (!m_freeSlots.empty())
+  {
+    pSlot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+  }
+  else if (m_slots.size() < m_slotLimit)
+  {
+    size_t frameSize = (size_t) m_width * m_height * PIXEL_SIZE;
+    pSlot = new Slot;
+    pSlot->pixels.resize(frameSize);
+    pSlot->compressed.resize(LzCompressor::getMaxCompressedSize(frameSize));
+    m_slots.push_back(pSlot);
+    m_stats.memoryUsed += pSlot->pixels.size() + pSlot->compressed.size();
+  }
+  else
+  {
+    ++m_frameIndex;
+    ++m_stats.framesDropped;
+    return NULL;
+  }
+
+  m_pCurrent = pSlot;
+  return &pSlot->pixels[0];
+}
+
+/**
+ * @brief Submit the frame obtained with beginFrame() for encoding.
+ */
+void FrameCapture::endFrame()
+{
+  Slot* pSlot;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    pSlot = m_pCurrent;
+    if (pSlot == NULL)
+    {
+      return;
+    }
+    m_pCurrent = NULL;
+
+    // Buffers busy other than this one: past half of them the encoder is
+    // not keeping up, so the frame is stored at half resolution.
+    size_t busy = m_slots.size() - m_freeSlots.size() - 1;
+    bool isDownsampled = busy * 2 >= m_slotLimit && m_width > 1 && m_height > 1;
+
+    pSlot->header.index  = m_frameIndex++;
+    pSlot->header.width  = (unsigned int) (isDownsampled ? m_width / 2 : m_width);
+    pSlot->header.height = (unsigned int) (isDownsampled ? m_height / 2 : m_height);
+    pSlot->header.flags  = isDownsampled ? FRAME_DOWNSAMPLED : 0;
+    pSlot->sequence      = m_nextSequence++;
+    m_stats.framesDownsampled += isDownsampled ? 1 : 0;
+    ++m_stats.framesSubmitted;
+    m_stats.bytesCaptured += pSlot->pixels.size();
+    ++m_encoding;
+  }
+
+  m_pPool->enqueue([this, pSlot]() {
+    encode(pSlot);
+  });
+}
+
+/**
+ * @brief Give back the buffer obtained with beginFrame() without recording.
+ */
+void FrameCapture::cancelFrame()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_pCurrent != NULL)
+  {
+    m_freeSlots.push_back(m_pCurrent);
+    m_pCurrent = NULL;
+  }
+}
+
+/**
+ * @brief Record a frame by copying it from memory.
+ *
+ * @param[in] pPixels - width x height 32 bit pixels
+ * @param[in] stride  - size of a row of pPixels in bytes
+ * @return true if the frame was submitted, false if it was dropped
+ */
+bool FrameCapture::submitFrame(const unsigned char* pPixels, size_t stride)
+{
+  LITE_PROFILE_ZONE("FrameCapture::submitFrame");
+  size_t bufferStride;
+  unsigned char* pBuffer = beginFrame(bufferStride);
+  if (pBuffer == NULL)
+  {
+    return false;
+  }
+
+  if (stride == bufferStride)
+  {
+    memcpy(pBuffer, pPixels, bufferStride * m_height);
+  }
+  else
+  {
+    for (int y = 0; y < m_height; ++y)
+    {
+      memcpy(pBuffer + y * bufferStride, pPixels + y * stride, bufferStride);
+    }
+  }
+  endFrame();
+  return true;
+}
+
+/**
+ * @brief Obtain the capture statistics.
+ *
+ * @param[out] stats - receives the statistics
+ */
+void FrameCapture::getStats(Stats& stats)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  stats = m_stats;
+  stats.bufferCount  = m_slotLimit;
+  stats.buffersInUse = m_slots.size() - m_freeSlots.size();
+  stats.averageEncodeMs = m_stats.framesWritten > 0 ? m_encodeMs / m_stats.framesWritten : 0.0;
+}
+
+/**
+ * @brief Turn a recorded frame back into pixels.
+ *
+ * @param[in]  header - header of the frame
+ * @param[in]  pData  - the header.compressedSize bytes following the header
+ * @param[out] pixels - receives header.width x header.height 32 bit pixels
+ * @return true on success, false if the data is malformed
+ */
+bool FrameCapture::decodeFrame(const FrameHeader& header, const unsigned char* pData,
+                               std::vector<unsigned char>& pixels)
+{
+  pixels.resize((size_t) header.width * header.height * PIXEL_SIZE);
+  if (pixels.empty() ||
+      !LzCompressor::decompress(pData, header.compressedSize, &pixels[0], pixels.size()))
+  {
+    return false;
+  }
+  removeDeltaFilter(&pixels[0], pixels.size());
+  return true;
+}
+
+/*
+ * Compress a frame on the pool and queue it for the writer.
+ */
+void FrameCapture::encode(Slot* pSlot)
+{
+  LITE_PROFILE_ZONE("FrameCapture::encode");
+  std::chrono::high_resolution_clock::time_point start =
+    std::chrono::high_resolution_clock::now();
+
+  if (pSlot->header.flags & FRAME_DOWNSAMPLED)
+  {
+    downsample(&pSlot->pixels[0], m_width, m_height);
+  }
+  size_t size = (size_t) pSlot->header.width * pSlot->header.height * PIXEL_SIZE;
+  applyDeltaFilter(&pSlot->pixels[0], size);
+  pSlot->header.compressedSize = (unsigned int)
+    pSlot->compressor.compress(&pSlot->pixels[0], size, &pSlot->compressed[0]);
+
+  double ms = std::chrono::duration<double, std::milli>(
+    std::chrono::high_resolution_clock::now() - start).count();
+  // Notify while holding the lock, close() may destroy the object as soon
+  // as the lock is released.
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_encoded[pSlot->sequence] = pSlot;
+  m_encodeMs += ms;
+  --m_encoding;
+  m_condition.notify_all();
+}
+
+/*
+ * Appends encoded frames to the file in submission order.
+ */
+void FrameCapture::writerMain()
+{
+  LITE_PROFILE_THREAD("FrameCapture writer");
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;)
+  {
+    std::map<unsigned int, Slot*>::iterator it = m_encoded.find(m_nextWrite);
+    if (it == m_encoded.end())
+    {
+      if (m_isClosing && m_encoded.empty())
+      {
+        return;
+      }
+      m_condition.wait(lock);
+      continue;
+    }
+
+    Slot* pSlot = it->second;
+    m_encoded.erase(it);
+    lock.unlock();
+
+    m_file.write((const char*) &pSlot->header, sizeof(FrameHeader));
+    m_file.write((const char*) &pSlot->compressed[0], pSlot->header.compressedSize);
+
+    lock.lock();
+    ++m_nextWrite;
+    ++m_stats.framesWritten;
+    m_stats.bytesWritten += sizeof(FrameHeader) + pSlot->header.compressedSize;
+    m_freeSlots.push_back(pSlot);
+  }
+}
+
+}
@@ -0,0 +1,289 @@
+/**
+ * @file LzCompressor.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the LzCompressor class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\LzCompressor.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Lite
+{
+
+static const size_t MIN_MATCH = 4;
+static const size_t MAX_OFFSET = 65535;
+
+// The block format ends with at least LAST_LITERALS literals and the last
+// match starts at least MATCH_LIMIT bytes before the end.
+static const size_t LAST_LITERALS = 5;
+static const size_t MATCH_LIMIT = 12;
+
+// Every 2^SKIP_SHIFT failed lookups the search step grows by one byte.
+static const unsigned int SKIP_SHIFT = 6;
+
+static unsigned int read32(const unsigned char* pData)
+{
+  unsigned int value;
+  memcpy(&value, pData, sizeof(value));
+  return value;
+}
+
+static unsigned long long read64(const unsigned char* pData)
+{
+  unsigned long long value;
+  memcpy(&value, pData, sizeof(value));
+  return value;
+}
+
+static unsigned int hashSequence(unsigned int sequence)
+{
+  return (sequence * 2654435761u) >> (32 - LzCompressor::HASH_BITS);
+}
+
+/*
+ * Write a length that did not fit its 4 bits of the token.
+ */
+static unsigned char* writeLength(unsigned char* pOut, size_t length)
+{
+  while (length >= 255)
+  {
+    *pOut++ = 255;
+    length -= 255;
+  }
+  *pOut++ = (unsigned char) length;
+  return pOut;
+}
+
+/*
+ * Write a sequence of literals optionally followed by a match.
+ */
+static unsigned char* writeSequence(unsigned char* pOut, const unsigned char* pLiterals,
+                                    size_t literalLength, size_t offset, size_t matchLength)
+{
+  unsigned char* pToken = pOut++;
+  size_t matchCode = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+  *pToken = (unsigned char) ((std::min<size_t>(literalLength, 15) << 4) |
+                             std::min<size_t>(matchCode, 15));
+  if (literalLength >= 15)
+  {
+    pOut = writeLength(pOut, literalLength - 15);
+  }
+  memcpy(pOut, pLiterals, literalLength);
+  pOut += literalLength;
+
+  if (matchLength > 0)
+  {
+    *pOut++ = (unsigned char) offset;
+    *pOut++ = (unsigned char) (offset >> 8);
+    if (matchCode >= 15)
+    {
+      pOut = writeLength(pOut, matchCode - 15);
+    }
+  }
+  return pOut;
+}
+
+/**
+ * Default constructor.
+ */
+LzCompressor::LzCompressor()
+  : m_table(1 << HASH_BITS)
+{
+}
+
+/**
+ * @brief Compress a block of data.
+ *
+ * @param[in]  pSource      - data to compress
+ * @param[in]  size         - number of bytes in pSource, less than 4 GB
+ * @param[out] pDestination - receives the compressed block, must hold
+ *                            getMaxCompressedSize(size) bytes
+ * @return size of the compressed block
+ */
+size_t LzCompressor::compress(const unsigned char* pSource, size_t size,
+                              unsigned char* pDestination)
+{
+  const unsigned char* pIn     = pSource;
+  const unsigned char* pAnchor = pSource;
+  const unsigned char* pEnd    = pSource + size;
+  unsigned char* pOut = pDestination;
+
+  if (size > MATCH_LIMIT)
+  {
+    const unsigned char* pMatchLimit = pEnd - MATCH_LIMIT;
+    const unsigned char* pLast = pEnd - LAST_LITERALS;
+    std::fill(m_table.begin(), m_table.end(), 0);
+    unsigned int misses = 0;
+
+    while (pIn < pMatchLimit)
+    {
+      unsigned int sequence = read32(pIn);
+      unsigned int& entry = m_table[hashSequence(sequence)];
+      const unsigned char* pCandidate = pSource + entry;
+      entry = (unsigned int) (pIn - pSource);
+
+      if (pCandidate >= pIn || (size_t) (pIn - pCandidate) > MAX_OFFSET ||
+          read32(pCandidate) != sequence)
+      {
+        pIn += 1 + (misses++ >> SKIP_SHIFT);
+        continue;
+      }
+      misses = 0;
+
+      // Grow the match backwards into the pending literals, then forwards
+      // a word at a time.
+      while (pIn > pAnchor && pCandidate > pSource && pIn[-1] == pCandidate[-1])
+      {
+        --pIn;
+        --pCandidate;
+      }
+
+      const unsigned char* pMatchEnd = pIn + MIN_MATCH;
+      const unsigned char* pReference = pCandidate + MIN_MATCH;
+      while (pMatchEnd + 8 <= pLast && read64(pMatchEnd) == read64(pReference))
+      {
+        pMatchEnd += 8;
+        pReference += 8;
+      }
+      while (pMatchEnd < pLast && *pMatchEnd == *pReference)
+      {
+        ++pMatchEnd;
+        ++pReference;
+      }
+
+      pOut = writeSequence(pOut, pAnchor, pIn - pAnchor, pIn - pCandidate, pMatchEnd - pIn);
+      pIn = pAnchor = pMatchEnd;
+
+      if (pIn < pMatchLimit)
+      {
+        m_table[hashSequence(read32(pIn - 2))] = (unsigned int) (pIn - 2 - pSource);
+      }
+    }
+  }
+
+  pOut = writeSequence(pOut, pAnchor, pEnd - pAnchor, 0, 0);
+  return pOut - pDestination;
+}
+
+/**
+ * @brief Obtain the worst case size of a compressed block.
+ *
+ * @param[in] size - size of the uncompressed data
+ * @return maximum number of bytes compress() writes
+ */
+size_t LzCompressor::getMaxCompressedSize(size_t size)
+{
+  return size + size / 255 + 16;
+}
+
+/**
+ * @brief Decompress a block written by compress().
+ *
+ * Malformed input is detected and never makes the method read or write
+ * outside the given buffers.
+ *
+ * @param[in]  pSource          - the compressed block
+ * @param[in]  size             - size of the compressed block
+ * @param[out] pDestination     - receives the decompressed data
+ * @param[in]  decompressedSize - exact size of the decompressed data
+ * @return true on success, false if the block is malformed
+ */
+bool LzCompressor::decompress(const unsigned char* pSource, size_t size,
+                              unsigned char* pDestination, size_t decompressedSize)
+{
+  const unsigned char* pIn  = pSource;
+  const unsigned char* pEnd = pSource + size;
+  unsigned char* pOut = pDestination;
+  unsigned char* pOutEnd = pDestination + decompressedSize;
+
+  while (pIn < pEnd)
+  {
+    unsigned int token = *pIn++;
+
+    size_t literalLength = token >> 4;
+    if (literalLength == 15)
+    {
+      unsigned char extra;
+      do
+      {
+        if (pIn >= pEnd)
+        {
+          return false;
+        }
+        extra = *pIn++;
+        literalLength += extra;
+      } while (extra == 255);
+    }
+    if (literalLength > (size_t) (pEnd - pIn) || literalLength > (size_t) (pOutEnd - pOut))
+    {
+      return false;
+    }
+    memcpy(pOut, pIn, literalLength);
+    pIn += literalLength;
+    pOut += literalLength;
+
+    // The last sequence has no match.
+    if (pIn == pEnd)
+    {
+      break;
+    }
+
+    if (pEnd - pIn < 2)
+    {
+      return false;
+    }
+    size_t offset = pIn[0] | (pIn[1] << 8);
+    pIn += 2;
+
+    size_t matchLength = token & 15;
+    if (matchLength == 15)
+    {
+      unsigned char extra;
+      do
+      {
+        if (pIn >= pEnd)
+        {
+          return false;
+        }
+        extra = *pIn++;
+        matchLength += extra;
+      } while (extra == 255);
+    }
+    matchLength += MIN_MATCH;
+
+    if (offset == 0 || offset > (size_t) (pOut - pDestination) ||
+        matchLength > (size_t) (pOutEnd - pOut))
+    {
+      return false;
+    }
+
+    // Overlapping matches repeat the last offset bytes and must be copied
+    // forwards one byte at a time.
+    const unsigned char* pMatch = pOut - offset;
+    if (offset >= matchLength)
+    {
+      memcpy(pOut, pMatch, matchLength);
+      pOut += matchLength;
+    }
+    else
+    {
+      for (size_t i = 0; i < matchLength; ++i)
+      {
+        *pOut++ = pMatch[i];
+      }
+    }
+  }
+
+  return pOut == pOutEnd;
+}
+
+}
@@ -0,0 +1,486 @@
+/**
+ * @file Profiler.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the Profiler class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <locale>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#if defined(_MSC_VER)
+#define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILER_THREAD_LOCAL __thread
+#endif
+
+namespace Lite
+{
+
+static const size_t RING_MASK = Profiler::RING_CAPACITY - 1;
+
+// Shortest interval used to relate the tick counter to wall clock time.
+static const double MIN_CALIBRATION_MS = 10.0;
+
+enum ProfileEventType
+{
+  EVENT_ZONE,
+  EVENT_COUNTER,
+  EVENT_FRAME
+};
+
+/*
+ * A recorded event. Zones keep their end tick in payload, counters the bits
+ * of their value and frame markers the frame number.
+ */
+struct ProfileEvent
+{
+  const char*        pName;
+  unsigned long long start;
+  unsigned long long payload;
+  unsigned int       type;
+};
+
+/*
+ * Ring of events written only by its owner thread. The owner publishes an
+ * event by advancing head after filling the slot. A ring without an owner
+ * keeps the events of its exited thread until another thread takes it.
+ */
+struct ThreadBuffer
+{
+  std::vector<ProfileEvent> events;
+  std::atomic<size_t>       head;
+  std::atomic<size_t>       tail;
+  const char*               pName;
+  unsigned int              id;
+  bool                      hasOwner;
+};
+
+std::atomic<bool> Profiler::s_isEnabled(true);
+
+static std::mutex s_mutex;
+static std::vector<ThreadBuffer*> s_buffers;
+static std::vector<ThreadBuffer*> s_freeBuffers;
+static unsigned int s_threadCount = 0;
+static std::atomic<unsigned long long> s_frame(0);
+static const unsigned long long s_startTicks = Profiler::getTimestamp();
+static const std::chrono::steady_clock::time_point s_startTime =
+  std::chrono::steady_clock::now();
+
+static PROFILER_THREAD_LOCAL ThreadBuffer* s_pThreadBuffer = NULL;
+
+/*
+ * Return the ring of an exiting thread to the free list. Called by the
+ * system with the value stored by watchThreadExit().
+ */
+#if defined(_WIN32)
+static void WINAPI releaseThreadBuffer(void* pValue)
+#else
+static void releaseThreadBuffer(void* pValue)
+#endif
+{
+  ThreadBuffer* pBuffer = static_cast<ThreadBuffer*>(pValue);
+  if (pBuffer == NULL)
+  {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(s_mutex);
+  pBuffer->hasOwner = false;
+  s_freeBuffers.push_back(pBuffer);
+}
+
+#if defined(_WIN32)
+static const DWORD s_exitKey = FlsAlloc(releaseThreadBuffer);
+static bool s_hasExitKey = s_exitKey != FLS_OUT_OF_INDEXES;
+#else
+static pthread_key_t s_exitKey;
+static bool s_hasExitKey = pthread_key_create(&s_exitKey, releaseThreadBuffer) == 0;
+#endif
+
+/*
+ * Frees the exit key on shutdown. Defined after the state above so that it
+ * is destroyed first, FlsFree runs the callbacks of the remaining threads.
+ */
+struct ExitKeyOwner
+{
+  ~ExitKeyOwner()
+  {
+    if (!s_hasExitKey)
+    {
+      return;
+    }
+    s_hasExitKey = false;
+#if defined(_WIN32)
+    FlsFree(s_exitKey);
+#else
+    pthread_key_delete(s_exitKey);
+#endif
+  }
+};
+
+static ExitKeyOwner s_exitKeyOwner;
+
+/*
+ * Arrange for releaseThreadBuffer() to run when the calling thread exits.
+ * Thread local destructors are not available, fiber local storage on
+ * Windows and thread specific data elsewhere provide the callback.
+ */
+static void watchThreadExit(ThreadBuffer* pBuffer)
+{
+  if (!s_hasExitKey)
+  {
+    return;
+  }
+#if defined(_WIN32)
+  FlsSetValue(s_exitKey, pBuffer);
+#else
+  pthread_setspecific(s_exitKey, pBuffer);
+#endif
+}
+
+/*
+ * Give the calling thread a ring on its first event, reusing the ring of
+ * an exited thread when there is one. The events of that thread are
+ * dropped then, until that happens they still reach the trace.
+ */
+static ThreadBuffer* createThreadBuffer()
+{
+  std::unique_lock<std::mutex> lock(s_mutex);
+  ThreadBuffer* pBuffer;
+  if (!s_freeBuffers.empty())
+  {
+    pBuffer = s_freeBuffers.back();
+    s_freeBuffers.pop_back();
+    pBuffer->tail.store(pBuffer->head.load());
+  }
+  else
+  {
+    pBuffer = new ThreadBuffer;
+    pBuffer->events.resize(Profiler::RING_CAPACITY);
+    pBuffer->head.store(0);
+    pBuffer->tail.store(0);
+    s_buffers.push_back(pBuffer);
+  }
+  pBuffer->pName = NULL;
+  pBuffer->id = ++s_threadCount;
+  pBuffer->hasOwner = true;
+  lock.unlock();
+
+  watchThreadExit(pBuffer);
+  s_pThreadBuffer = pBuffer;
+  return pBuffer;
+}
+
+/*
+ * Append an event to the ring of the calling thread. Callers check that
+ * recording is enabled before reading the clock.
+ */
+static void pushEvent(unsigned int type, const char* pName,
+                      unsigned long long start, unsigned long long payload)
+{
+  ThreadBuffer* pBuffer = s_pThreadBuffer;
+  if (pBuffer == NULL)
+  {
+    pBuffer = createThreadBuffer();
+  }
+
+  size_t head = pBuffer->head.load(std::memory_order_relaxed);
+  ProfileEvent& event = pBuffer->events[head & RING_MASK];
+  event.pName   = pName;
+  event.start   = start;
+  event.payload = payload;
+  event.type    = type;
+  pBuffer->head.store(head + 1, std::memory_order_release);
+}
+
+/*
+ * First index of a ring that still holds a valid event.
+ */
+static size_t getFirstEvent(const ThreadBuffer* pBuffer, size_t head)
+{
+  size_t tail = pBuffer->tail.load(std::memory_order_relaxed);
+  if (head - tail > Profiler::RING_CAPACITY)
+  {
+    tail = head - Profiler::RING_CAPACITY;
+  }
+  return tail;
+}
+
+static void writeString(std::ofstream& file, const char* pText)
+{
+  file << '"';
+  for (const char* pChar = pText; *pChar != '\0'; ++pChar)
+  {
+    if (*pChar == '"' || *pChar == '\\')
+    {
+      file << '\\';
+    }
+    if ((unsigned char) *pChar >= 0x20)
+    {
+      file << *pChar;
+    }
+  }
+  file << '"';
+}
+
+/**
+ * @brief Enable or disable recording at run time.
+ *
+ * A disabled profiler still costs a check per event, before the clock is
+ * read. The macros remove even that when LITE_PROFILE is not defined.
+ *
+ * @param[in] isEnabled - true to record events
+ */
+void Profiler::setEnabled(bool isEnabled)
+{
+  s_isEnabled.store(isEnabled);
+}
+
+/**
+ * @brief Name the calling thread in the exported trace.
+ *
+ * @param[in] pName - thread name, must outlive the profiler
+ */
+void Profiler::setThreadName(const char* pName)
+{
+  ThreadBuffer* pBuffer = s_pThreadBuffer;
+  if (pBuffer == NULL)
+  {
+    pBuffer = createThreadBuffer();
+  }
+
+  std::unique_lock<std::mutex> lock(s_mutex);
+  pBuffer->pName = pName;
+}
+
+/**
+ * @brief Record a zone on the calling thread.
+ *
+ * @param[in] pName - zone name, must outlive the profiler
+ * @param[in] start - tick at which the zone was entered
+ * @param[in] end   - tick at which the zone was left
+ */
+void Profiler::recordZone(const char* pName, unsigned long long start,
+                          unsigned long long end)
+{
+  if (isEnabled())
+  {
+    pushEvent(EVENT_ZONE, pName, start, end);
+  }
+}
+
+/**
+ * @brief Record the current value of a named counter.
+ *
+ * @param[in] pName - counter name, must outlive the profiler
+ * @param[in] value - counter value
+ */
+void Profiler::recordCounter(const char* pName, double value)
+{
+  if (!isEnabled())
+  {
+    return;
+  }
+
+  unsigned long long bits;
+  memcpy(&bits, &value, sizeof(bits));
+  pushEvent(EVENT_COUNTER, pName, getTimestamp(), bits);
+}
+
+/**
+ * @brief Mark the start of a new frame.
+ */
+void Profiler::markFrame()
+{
+  if (!isEnabled())
+  {
+    return;
+  }
+
+  pushEvent(EVENT_FRAME, "Frame", getTimestamp(), s_frame.fetch_add(1));
+}
+
+/**
+ * @brief Count the events currently held by all rings.
+ *
+ * @return number of events that would be exported
+ */
+size_t Profiler::getEventCount()
+{
+  std::unique_lock<std::mutex> lock(s_mutex);
+  size_t count = 0;
+  for (size_t i = 0; i < s_buffers.size(); ++i)
+  {
+    size_t head = s_buffers[i]->head.load(std::memory_order_acquire);
+    count += head - getFirstEvent(s_buffers[i], head);
+  }
+  return count;
+}
+
+/**
+ * @brief Count the events overwritten because a ring was full.
+ *
+ * @return number of events lost since the last clear()
+ */
+size_t Profiler::getDroppedCount()
+{
+  std::unique_lock<std::mutex> lock(s_mutex);
+  size_t count = 0;
+  for (size_t i = 0; i < s_buffers.size(); ++i)
+  {
+    size_t head = s_buffers[i]->head.load(std::memory_order_acquire);
+    size_t tail = s_buffers[i]->tail.load(std::memory_order_relaxed);
+    if (head - tail > RING_CAPACITY)
+    {
+      count += head - tail - RING_CAPACITY;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Measure the rate of the profiler clock.
+ *
+ * The first call may block for a few milliseconds while the tick counter
+ * is compared against the system clock.
+ *
+ * @return ticks per microsecond
+ */
+double Profiler::getTicksPerMicrosecond()
+{
+  double elapsedMs;
+  unsigned long long ticks;
+  do
+  {
+    ticks = getTimestamp();
+    elapsedMs = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - s_startTime).count();
+  } while (elapsedMs < MIN_CALIBRATION_MS);
+
+  return (double) (ticks - s_startTicks) / (elapsedMs * 1000.0);
+}
+
+/**
+ * @brief Discard all recorded events.
+ */
+void Profiler::clear()
+{
+  std::unique_lock<std::mutex> lock(s_mutex);
+  for (size_t i = 0; i < s_buffers.size(); ++i)
+  {
+    s_buffers[i]->tail.store(s_buffers[i]->head.load(std::memory_order_acquire));
+  }
+}
+
+/**
+ * @brief Write the recorded events as a Chrome trace JSON file.
+ *
+ * Recording may continue on other threads meanwhile, events overwritten
+ * while they were being copied are left out.
+ *
+ * @param[in] path - path to the output file
+ * @return true on success, false if the file could not be written
+ */
+bool Profiler::exportChromeTrace(const String& path)
+{
+  double ticksPerUs = getTicksPerMicrosecond();
+
+  std::ofstream file(path.c_str(), std::ios::trunc);
+  if (!file)
+  {
+    return false;
+  }
+  file.imbue(std::locale::classic());
+  file << std::fixed << std::setprecision(3);
+  file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+  std::vector<ProfileEvent> events;
+  std::unique_lock<std::mutex> lock(s_mutex);
+  bool isFirst = true;
+  for (size_t i = 0; i < s_buffers.size(); ++i)
+  {
+    const ThreadBuffer* pBuffer = s_buffers[i];
+    size_t head = pBuffer->head.load(std::memory_order_acquire);
+    size_t first = getFirstEvent(pBuffer, head);
+
+    events.clear();
+    for (size_t j = first; j != head; ++j)
+    {
+      events.push_back(pBuffer->events[j & RING_MASK]);
+    }
+
+    // The owner may have wrapped around while we copied. Slots it could
+    // have written since are dropped, including the one it may be filling.
+    size_t newHead = pBuffer->head.load(std::memory_order_acquire);
+    size_t skip = 0;
+    if (newHead - first >= RING_CAPACITY)
+    {
+      skip = newHead - first - RING_CAPACITY + 1;
+      skip = skip < events.size() ? skip : events.size();
+    }
+
+    if (pBuffer->pName != NULL)
+    {
+      file << (isFirst ? "" : ",\n");
+      file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << pBuffer->id
+           << ",\"args\":{\"name\":";
+      writeString(file, pBuffer->pName);
+      file << "}}";
+      isFirst = false;
+    }
+
+    for (size_t j = skip; j < events.size(); ++j)
+    {
+      const ProfileEvent& event = events[j];
+      double ts = (double) (long long) (event.start - s_startTicks) / ticksPerUs;
+
+      file << (isFirst ? "" : ",\n") << "{\"name\":";
+      writeString(file, event.pName);
+      file << ",\"pid\":1,\"tid\":" << pBuffer->id << ",\"ts\":" << ts;
+      if (event.type == EVENT_ZONE)
+      {
+        file << ",\"ph\":\"X\",\"dur\":" << (double) (event.payload - event.start) / ticksPerUs;
+      }
+      else if (event.type == EVENT_COUNTER)
+      {
+        double value;
+        memcpy(&value, &event.payload, sizeof(value));
+        file << ",\"ph\":\"C\",\"args\":{\"value\":" << std::setprecision(6) << value
+             << std::setprecision(3) << "}";
+      }
+      else
+      {
+        file << ",\"ph\":\"i\",\"s\":\"g\",\"args\":{\"frame\":" << event.payload << "}";
+      }
+      file << "}";
+      isFirst = false;
+    }
+  }
+
+  file << "\n]}\n";
+  return file.good();
+}
+
+}
@@ -0,0 +1,458 @@
+/**
+ * @file SnapshotCodec.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the SnapshotCodec class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\SnapshotCodec.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+// Bits holding the width of the differences of a field component in a block.
+static const unsigned int WIDTH_BITS = 5;
+
+/* Number of bits needed to hold a value. */
+static unsigned int bitLength(unsigned int value)
+{
+  unsigned int bits = 0;
+  for (unsigned int shift = 16; shift > 0; shift >>= 1)
+  {
+    if (value >> shift)
+    {
+      value >>= shift;
+      bits += shift;
+    }
+  }
+  return bits + value;
+}
+
+/*
+ * Zigzag code the differences of count values to the baseline, or copy the
+ * values without one, and return the OR of the results.
+ */
+static unsigned int computeDeltas(const unsigned int* pValues, const unsigned int* pBaseline,
+                                  size_t count, unsigned int* pOut)
+{
+  unsigned int bits = 0;
+  size_t i = 0;
+  if (pBaseline == NULL)
+  {
+    for (; i < count; ++i)
+    {
+      pOut[i] = pValues[i];
+      bits |= pValues[i];
+    }
+    return bits;
+  }
+
+#ifdef LITE_SSE2
+  __m128i any = _mm_setzero_si128();
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i delta = _mm_sub_epi32(_mm_loadu_si128((const __m128i*) (pValues + i)),
+                                  _mm_loadu_si128((const __m128i*) (pBaseline + i)));
+    __m128i zigzag = _mm_xor_si128(_mm_slli_epi32(delta, 1), _mm_srai_epi32(delta, 31));
+    _mm_storeu_si128((__m128i*) (pOut + i), zigzag);
+    any = _mm_or_si128(any, zigzag);
+  }
+  any = _mm_or_si128(any, _mm_shuffle_epi32(any, _MM_SHUFFLE(1, 0, 3, 2)));
+  any = _mm_or_si128(any, _mm_shuffle_epi32(any, _MM_SHUFFLE(2, 3, 0, 1)));
+  bits = (unsigned int) _mm_cvtsi128_si32(any);
+#endif
+  for (; i < count; ++i)
+  {
+    int delta = (int) (pValues[i] - pBaseline[i]);
+    pOut[i] = ((unsigned int) delta << 1) ^ (unsigned int) (delta >> 31);
+    bits |= pOut[i];
+  }
+  return bits;
+}
+
+/* Inverse of computeDeltas(), keeping the bits of the field. */
+static void applyDeltas(const unsigned int* pDeltas, const unsigned int* pBaseline, size_t count,
+                        unsigned int mask, unsigned int* pOut)
+{
+  size_t i = 0;
+  if (pBaseline == NULL)
+  {
+    for (; i < count; ++i)
+    {
+      pOut[i] = pDeltas[i] & mask;
+    }
+    return;
+  }
+
+#ifdef LITE_SSE2
+  __m128i one = _mm_set1_epi32(1);
+  __m128i bitMask = _mm_set1_epi32((int) mask);
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i zigzag = _mm_loadu_si128((const __m128i*) (pDeltas + i));
+    __m128i delta = _mm_xor_si128(_mm_srli_epi32(zigzag, 1),
+                                  _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(zigzag, one)));
+    __m128i value = _mm_add_epi32(_mm_loadu_si128((const __m128i*) (pBaseline + i)), delta);
+    _mm_storeu_si128((__m128i*) (pOut + i), _mm_and_si128(value, bitMask));
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    unsigned int delta = (pDeltas[i] >> 1) ^ (0u - (pDeltas[i] & 1));
+    pOut[i] = (pBaseline[i] + delta) & mask;
+  }
+}
+
+/**
+ * @brief Constructor. The codec has no fields and no entities.
+ */
+SnapshotCodec::SnapshotCodec()
+  : m_entityCount(0)
+{
+}
+
+/**
+ * @brief Add a field quantized within bounds.
+ *
+ * The error of a component is at most half the extent of the bounds
+ * divided by 2^bits - 1, values outside the bounds are clamped.
+ *
+ * @param[in] bounds - range of the values
+ * @param[in] bits - bits per component, from 1 to MAX_BITS
+ *
+ * @return Index of the field.
+ */
+unsigned int SnapshotCodec::addField(const AABB& bounds, unsigned int bits)
+{
+  bits = std::min(std::max(bits, 1u), (unsigned int) MAX_BITS);
+  Field field;
+  field.mask = (1u << bits) - 1;
+  for (int c = 0; c < 3; ++c)
+  {
+    float extent = bounds.max.v[c] - bounds.min.v[c];
+    field.minimum[c] = bounds.min.v[c];
+    field.scale[c] = extent > 0.0f ? field.mask / extent : 0.0f;
+    field.step[c] = extent > 0.0f ? extent / field.mask : 0.0f;
+  }
+  m_fields.push_back(field);
+  m_block.resize(m_fields.size() * 3 * BLOCK_SIZE);
+  m_widths.resize(m_fields.size() * 3);
+  return (unsigned int) m_fields.size() - 1;
+}
+
+/**
+ * @brief Get the number of fields.
+ *
+ * @return The number of fields.
+ */
+unsigned int SnapshotCodec::getFieldCount() const
+{
+  return (unsigned int) m_fields.size();
+}
+
+/**
+ * @brief Get the largest quantization error of a field within its bounds.
+ *
+ * @param[in] field - index of the field
+ *
+ * @return Half a quantization step per component, plus the rounding of
+ *         floats of the size of the bounds.
+ */
+Vector3f SnapshotCodec::getErrorBound(unsigned int field) const
+{
+  const Field& f = m_fields[field];
+  Vector3f bound;
+  for (int c = 0; c < 3; ++c)
+  {
+    // Floats near the edge of the bounds are only that precise themselves.
+    float magnitude = std::max(fabsf(f.minimum[c]), fabsf(f.minimum[c] + f.step[c] * f.mask));
+    bound.v[c] = f.step[c] * 0.5f + 2.0f * magnitude * FLT_EPSILON;
+  }
+  return bound;
+}
+
+/**
+ * @brief Set the number of entities in a snapshot.
+ *
+ * @param[in] count - number of entities
+ */
+void SnapshotCodec::setEntityCount(size_t count)
+{
+  m_entityCount = count;
+}
+
+/**
+ * @brief Get the number of entities in a snapshot.
+ *
+ * @return The number of entities.
+ */
+size_t SnapshotCodec::getEntityCount() const
+{
+  return m_entityCount;
+}
+
+/**
+ * @brief Get the size of a quantized snapshot.
+ *
+ * @return Number of unsigned values.
+ */
+size_t SnapshotCodec::getSnapshotSize() const
+{
+  return m_fields.size() * 3 * m_entityCount;
+}
+
+/**
+ * @brief Get the most bytes encode() may write.
+ *
+ * @return Size in bytes.
+ */
+size_t SnapshotCodec::getMaxEncodedSize() const
+{
+  size_t blocks = (m_entityCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  size_t bits = blocks * (1 + m_fields.size() * 3 * WIDTH_BITS);
+  for (size_t f = 0; f < m_fields.size(); ++f)
+  {
+    bits += m_entityCount * 3 * (bitLength(m_fields[f].mask) + 1);
+  }
+  return (bits + 7) / 8;
+}
+
+/**
+ * @brief Quantize a field of every entity.
+ *
+ * @param[in] field - index of the field
+ * @param[in] pValues - getEntityCount() values
+ * @param[out] pSnapshot - quantized snapshot receiving the field
+ */
+void SnapshotCodec::quantize(unsigned int field, const Vector3f* pValues,
+                             unsigned int* pSnapshot) const
+{
+  LITE_PROFILE_ZONE("SnapshotCodec::quantize");
+
+  const Field& f = m_fields[field];
+  size_t count = m_entityCount;
+  unsigned int* pOut[3] = { pSnapshot + (field * 3) * count,
+                            pSnapshot + (field * 3 + 1) * count,
+                            pSnapshot + (field * 3 + 2) * count };
+  float maximum = (float) f.mask;
+  size_t i = 0;
+
+#ifdef LITE_SSE2
+  __m128 minimum[3], scale[3];
+  for (int c = 0; c < 3; ++c)
+  {
+    minimum[c] = _mm_set1_ps(f.minimum[c]);
+    scale[c] = _mm_set1_ps(f.scale[c]);
+  }
+  __m128 upper = _mm_set1_ps(maximum);
+  __m128 half = _mm_set1_ps(0.5f);
+  for (; i + 4 <= count; i += 4)
+  {
+    // Four packed Vector3f, split into one register per component.
+    const float* pSource = &pValues[i].x;
+    __m128 a = _mm_loadu_ps(pSource);
+    __m128 b = _mm_loadu_ps(pSource + 4);
+    __m128 c = _mm_loadu_ps(pSource + 8);
+    __m128 components[3];
+    components[0] = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 0, 2)),
+                                   _MM_SHUFFLE(3, 0, 3, 0));
+    components[1] = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1)),
+                                   _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 0, 0, 3)),
+                                   _MM_SHUFFLE(3, 0, 3, 0));
+    components[2] = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 0, 2)),
+                                   _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 0, 0)),
+                                   _MM_SHUFFLE(3, 0, 3, 0));
+
+    for (int k = 0; k < 3; ++k)
+    {
+      // max() with the value first turns NaN into 0, as the scalar path does.
+      __m128 value = _mm_mul_ps(_mm_sub_ps(components[k], minimum[k]), scale[k]);
+      value = _mm_add_ps(_mm_max_ps(value, _mm_setzero_ps()), half);
+      __m128i quantized = _mm_cvttps_epi32(_mm_min_ps(value, upper));
+      _mm_storeu_si128((__m128i*) (pOut[k] + i), quantized);
+    }
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      float value = (pValues[i].v[k] - f.minimum[k]) * f.scale[k];
+      value = (value > 0.0f ? value : 0.0f) + 0.5f;
+      pOut[k][i] = (unsigned int) (int) (value < maximum ? value : maximum);
+    }
+  }
+}
+
+/**
+ * @brief Reconstruct a field of every entity.
+ *
+ * @param[in] field - index of the field
+ * @param[in] pSnapshot - quantized snapshot holding the field
+ * @param[out] pValues - receives getEntityCount() values
+ */
+void SnapshotCodec::dequantize(unsigned int field, const unsigned int* pSnapshot,
+                               Vector3f* pValues) const
+{
+  LITE_PROFILE_ZONE("SnapshotCodec::dequantize");
+
+  const Field& f = m_fields[field];
+  size_t count = m_entityCount;
+  const unsigned int* pIn[3] = { pSnapshot + (field * 3) * count,
+                                 pSnapshot + (field * 3 + 1) * count,
+                                 pSnapshot + (field * 3 + 2) * count };
+  size_t i = 0;
+
+#ifdef LITE_SSE2
+  __m128 minimum[3], step[3];
+  for (int c = 0; c < 3; ++c)
+  {
+    minimum[c] = _mm_set1_ps(f.minimum[c]);
+    step[c] = _mm_set1_ps(f.step[c]);
+  }
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 components[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      __m128 quantized = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) (pIn[k] + i)));
+      components[k] = _mm_add_ps(minimum[k], _mm_mul_ps(quantized, step[k]));
+    }
+
+    // Interleave the components back into four packed Vector3f.
+    __m128 xyLow = _mm_unpacklo_ps(components[0], components[1]);
+    __m128 xyHigh = _mm_unpackhi_ps(components[0], components[1]);
+    __m128 a = _mm_shuffle_ps(xyLow, _mm_shuffle_ps(components[2], xyLow, _MM_SHUFFLE(2, 0, 0, 0)),
+                              _MM_SHUFFLE(3, 0, 1, 0));
+    __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(xyLow, components[2], _MM_SHUFFLE(1, 1, 3, 3)),
+                              xyHigh, _MM_SHUFFLE(1, 0, 2, 0));
+    __m128 t = _mm_shuffle_ps(components[2], xyHigh, _MM_SHUFFLE(3, 2, 3, 2));
+    __m128 c = _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 3, 2, 0));
+
+    float* pTarget = &pValues[i].x;
+    _mm_storeu_ps(pTarget, a);
+    _mm_storeu_ps(pTarget + 4, b);
+    _mm_storeu_ps(pTarget + 8, c);
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      pValues[i].v[k] = f.minimum[k] + (float) (int) pIn[k][i] * f.step[k];
+    }
+  }
+}
+
+/**
+ * @brief Write a quantized snapshot.
+ *
+ * @param[in] pSnapshot - the snapshot
+ * @param[in] pBaseline - quantized snapshot the receiver has, or NULL to
+ *                        write the values themselves
+ * @param[in] writer - receives the bits
+ *
+ * @return False if the writer ran out of space.
+ */
+bool SnapshotCodec::encode(const unsigned int* pSnapshot, const unsigned int* pBaseline,
+                           BitWriter& writer)
+{
+  LITE_PROFILE_ZONE("SnapshotCodec::encode");
+
+  size_t count = m_entityCount;
+  size_t streams = m_fields.size() * 3;
+  for (size_t start = 0; start < count; start += BLOCK_SIZE)
+  {
+    size_t size = std::min((size_t) BLOCK_SIZE, count - start);
+    bool isChanged = false;
+    for (size_t s = 0; s < streams; ++s)
+    {
+      size_t offset = s * count + start;
+      unsigned int bits = computeDeltas(pSnapshot + offset,
+                                        pBaseline != NULL ? pBaseline + offset : NULL, size,
+                                        &m_block[s * BLOCK_SIZE]);
+      m_widths[s] = bitLength(bits);
+      isChanged = isChanged || m_widths[s] != 0;
+    }
+
+    writer.write(isChanged ? 1 : 0, 1);
+    if (!isChanged)
+    {
+      continue;
+    }
+
+    for (size_t s = 0; s < streams; ++s)
+    {
+      const unsigned int* pDeltas = &m_block[s * BLOCK_SIZE];
+      unsigned int width = m_widths[s];
+      writer.write(width, WIDTH_BITS);
+      if (width != 0)
+      {
+        writer.write(pDeltas, size, width);
+      }
+    }
+  }
+  return !writer.hasOverflowed();
+}
+
+/**
+ * @brief Read a quantized snapshot written by encode().
+ *
+ * @param[in] reader - gives the bits
+ * @param[in] pBaseline - the snapshot the sender encoded against, or NULL
+ * @param[out] pSnapshot - receives the snapshot
+ *
+ * @return False if the data is cut short or malformed.
+ */
+bool SnapshotCodec::decode(BitReader& reader, const unsigned int* pBaseline,
+                           unsigned int* pSnapshot)
+{
+  LITE_PROFILE_ZONE("SnapshotCodec::decode");
+
+  size_t count = m_entityCount;
+  size_t streams = m_fields.size() * 3;
+  unsigned int* pDeltas = m_block.empty() ? NULL : &m_block[0];
+  for (size_t start = 0; start < count; start += BLOCK_SIZE)
+  {
+    size_t size = std::min((size_t) BLOCK_SIZE, count - start);
+    bool isChanged = reader.read(1) != 0;
+    for (size_t s = 0; s < streams; ++s)
+    {
+      unsigned int width = isChanged ? reader.read(WIDTH_BITS) : 0;
+      if (width > MAX_BITS + 1)
+      {
+        return false;
+      }
+      if (width != 0)
+      {
+        reader.read(pDeltas, size, width);
+      }
+      else
+      {
+        std::fill(pDeltas, pDeltas + size, 0u);
+      }
+
+      size_t offset = s * count + start;
+      applyDeltas(pDeltas, pBaseline != NULL ? pBaseline + offset : NULL, size,
+                  m_fields[s / 3].mask, pSnapshot + offset);
+    }
+  }
+  return !reader.hasOverflowed();
+}
+
+}
@@ -0,0 +1,219 @@
+/**
+ * @file ThreadPool.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the ThreadPool class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+
+#include <atomic>
+
+namespace Lite
+{
+
+/**
+ * @brief Constructor.
+ *
+ * Starts the worker threads. The thread calling parallelFor() also takes part
+ * in the work, so numThreads - 1 workers are created.
+ *
+ * @param[in] numThreads - total number of threads, 0 means one per hardware
+ *                         thread
+ */
+ThreadPool::ThreadPool(unsigned int numThreads)
+  : m_isStopping(false)
+{
+  if (numThreads == 0)
+  {
+    numThreads = std::thread::hardware_concurrency();
+  }
+  if (numThreads == 0)
+  {
+    numThreads = 1;
+  }
+
+  for (unsigned int i = 1; i < numThreads; ++i)
+  {
+    m_workers.push_back(std::thread(&ThreadPool::workerMain, this));
+  }
+}
+
+/**
+ * @brief Destructor.
+ *
+ * Finishes the tasks still in the queue and joins the worker threads.
+ */
+ThreadPool::~ThreadPool()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_condition.notify_all();
+
+  for (size_t i = 0; i < m_workers.size(); ++i)
+  {
+    m_workers[i].join();
+  }
+}
+
+/**
+ * @brief Obtain the number of threads working on this pool's tasks.
+ *
+ * @return worker count plus the calling thread
+ */
+unsigned int ThreadPool::getThreadCount() const
+{
+  return (unsigned int) m_workers.size() + 1;
+}
+
+/**
+ * @brief Queue a task for execution on one of the worker threads.
+ *
+ * If the pool has no workers the task is executed immediately.
+ *
+ * @param[in] task - the task to execute
+ */
+void ThreadPool::enqueue(const Task& task)
+{
+  if (m_workers.empty())
+  {
+    task();
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_tasks.push_back(task);
+  }
+  m_condition.notify_one();
+}
+
+/**
+ * @brief Execute one queued task on the calling thread, if there is any.
+ *
+ * @return true if a task was executed, false if the queue was empty
+ */
+bool ThreadPool::runPendingTask()
+{
+  Task task;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_tasks.empty())
+    {
+      return false;
+    }
+    task = m_tasks.front();
+    m_tasks.pop_front();
+  }
+
+  task();
+  return true;
+}
+
+/**
+ * @brief Execute task over the range [begin, end) split into chunks.
+ *
+ * The method returns once every chunk has been processed.
+ *
+ * @param[in] begin     - first index of the range
+ * @param[in] end       - one past the last index of the range
+ * @param[in] grainSize - minimum number of indices per chunk
+ * @param[in] task      - function called with the bounds of every chunk
+ */
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grainSize,
+                             const RangeTask& task)
+{
+  if (end <= begin)
+  {
+    return;
+  }
+
+  LITE_PROFILE_ZONE("ThreadPool::parallelFor");
+  size_t count = end - begin;
+  if (grainSize == 0)
+  {
+    grainSize = 1;
+  }
+
+  // Aim for a few chunks per thread so uneven chunks balance out.
+  size_t chunkSize = count / (getThreadCount() * 4) + 1;
+  if (chunkSize < grainSize)
+  {
+    chunkSize = grainSize;
+  }
+
+  size_t numChunks = (count + chunkSize - 1) / chunkSize;
+  if (numChunks <= 1 || m_workers.empty())
+  {
+    task(begin, end);
+    return;
+  }
+
+  std::atomic<size_t> remaining(numChunks - 1);
+  for (size_t i = 1; i < numChunks; ++i)
+  {
+    size_t chunkBegin = begin + i * chunkSize;
+    size_t chunkEnd   = chunkBegin + chunkSize < end ? chunkBegin + chunkSize : end;
+    std::atomic<size_t>* pRemaining = &remaining;
+    enqueue([=, &task]() {
+      task(chunkBegin, chunkEnd);
+      pRemaining->fetch_sub(1);
+    });
+  }
+
+  task(begin, begin + chunkSize);
+
+  while (remaining.load() != 0)
+  {
+    if (!runPendingTask())
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+/**
+ * @brief Obtain the process wide pool with one thread per hardware thread.
+ *
+ * @return the default pool
+ */
+ThreadPool& ThreadPool::getDefault()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+void ThreadPool::workerMain()
+{
+  LITE_PROFILE_THREAD("ThreadPool worker");
+  for (;;)
+  {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (!m_isStopping && m_tasks.empty())
+      {
+        m_condition.wait(lock);
+      }
+      if (m_tasks.empty())
+      {
+        return;
+      }
+      task = m_tasks.front();
+      m_tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+}
@@ -0,0 +1,321 @@
+/**
+ * @file TransformBuffer.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the TransformBuffer class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Core\TransformBuffer.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(LITE_AVX2)
+#include <immintrin.h>
+#elif defined(LITE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+// Smallest squared length normalized, shorter rotations become 0.
+static const float MIN_LENGTH_SQR = 1e-20f;
+
+/**
+ * @brief Constructor. The buffer holds no transforms.
+ */
+TransformBuffer::TransformBuffer()
+  : m_isPending(false)
+  , m_acquiredCount(0)
+{
+  m_back.time = m_pending.time = m_previous.time = m_current.time = 0.0;
+}
+
+/**
+ * @brief Set the number of transforms.
+ *
+ * Resets every snapshot to the origin and the identity rotation. Must not
+ * be called while another thread uses the buffer.
+ *
+ * @param[in] count - number of transforms
+ */
+void TransformBuffer::resize(size_t count)
+{
+  Snapshot* snapshots[4] = { &m_back, &m_pending, &m_previous, &m_current };
+  for (int i = 0; i < 4; ++i)
+  {
+    snapshots[i]->time = 0.0;
+    snapshots[i]->positions.assign(count, Vector3f());
+    snapshots[i]->orientations.assign(count, Quaternion::Identity);
+  }
+  m_isPending = false;
+  m_acquiredCount = 0;
+}
+
+/**
+ * @brief Get the number of transforms.
+ *
+ * @return The number of transforms.
+ */
+size_t TransformBuffer::getCount() const
+{
+  return m_back.positions.size();
+}
+
+/**
+ * @brief Get the positions of the back snapshot, for the simulation to fill.
+ *
+ * @return getCount() positions, or NULL if there are none.
+ */
+Vector3f* TransformBuffer::getPositions()
+{
+  return m_back.positions.empty() ? NULL : &m_back.positions[0];
+}
+
+/**
+ * @brief Get the orientations of the back snapshot, for the simulation to
+ * fill.
+ *
+ * @return getCount() orientations, or NULL if there are none.
+ */
+Quaternion* TransformBuffer::getOrientations()
+{
+  return m_back.orientations.empty() ? NULL : &m_back.orientations[0];
+}
+
+/**
+ * @brief Make the back snapshot the latest one.
+ *
+ * Replaces a snapshot published before that was not acquired yet.
+ *
+ * @param[in] time - time of the simulation the snapshot shows
+ */
+void TransformBuffer::publish(double time)
+{
+  m_back.time = time;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::swap(m_back.positions, m_pending.positions);
+  std::swap(m_back.orientations, m_pending.orientations);
+  std::swap(m_back.time, m_pending.time);
+  m_isPending = true;
+}
+
+/**
+ * @brief Take the latest published snapshot for rendering.
+ *
+ * The snapshot acquired before becomes the one interpolate() starts from.
+ *
+ * @return True if a snapshot was published since the last call.
+ */
+bool TransformBuffer::acquire()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_isPending)
+  {
+    return false;
+  }
+
+  std::swap(m_previous.positions, m_current.positions);
+  std::swap(m_previous.orientations, m_current.orientations);
+  std::swap(m_previous.time, m_current.time);
+  std::swap(m_current.positions, m_pending.positions);
+  std::swap(m_current.orientations, m_pending.orientations);
+  std::swap(m_current.time, m_pending.time);
+  m_isPending = false;
+  ++m_acquiredCount;
+  return true;
+}
+
+/**
+ * @brief Get the time of the snapshot acquired before the latest one.
+ *
+ * @return The time in seconds.
+ */
+double TransformBuffer::getPreviousTime() const
+{
+  return m_acquiredCount > 1 ? m_previous.time : m_current.time;
+}
+
+/**
+ * @brief Get the time of the latest acquired snapshot.
+ *
+ * @return The time in seconds.
+ */
+double TransformBuffer::getCurrentTime() const
+{
+  return m_current.time;
+}
+
+/**
+ * @brief Interpolate the two acquired snapshots.
+ *
+ * Times outside the two snapshots are clamped to the nearest one.
+ *
+ * @param[in] time - time to show
+ * @param[out] pPositions - receives getCount() positions, may be NULL
+ * @param[out] pOrientations - receives getCount() orientations, may be NULL
+ * @param[in] pPool - optional pool that shares the work between threads
+ */
+void TransformBuffer::interpolate(double time, Vector3f* pPositions, Quaternion* pOrientations,
+                                  ThreadPool* pPool) const
+{
+  LITE_PROFILE_ZONE("TransformBuffer::interpolate");
+
+  size_t count = m_current.positions.size();
+  if (count == 0)
+  {
+    return;
+  }
+
+  const Snapshot& from = m_acquiredCount > 1 ? m_previous : m_current;
+  double span = m_current.time - from.time;
+  float t = span > 0.0 ? (float) std::min(std::max((time - from.time) / span, 0.0), 1.0) : 1.0f;
+
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+    if (pPositions != NULL)
+    {
+      interpolate(&from.positions[begin], &m_current.positions[begin], t,
+                  pPositions + begin, end - begin);
+    }
+    if (pOrientations != NULL)
+    {
+      interpolate(&from.orientations[begin], &m_current.orientations[begin], t,
+                  pOrientations + begin, end - begin);
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, count);
+  }
+}
+
+/**
+ * @brief Interpolate positions linearly.
+ *
+ * @param[in] pFrom - positions at t = 0
+ * @param[in] pTo - positions at t = 1
+ * @param[in] t - interpolation factor
+ * @param[out] pOut - receives the positions, may be one of the inputs
+ * @param[in] count - number of positions
+ */
+void TransformBuffer::interpolate(const Vector3f* pFrom, const Vector3f* pTo, float t,
+                                  Vector3f* pOut, size_t count)
+{
+  // Vector3f is three packed floats, so positions are lerped as one array.
+  const float* pA = &pFrom->x;
+  const float* pB = &pTo->x;
+  float* pResult = &pOut->x;
+  size_t size = count * 3, i = 0;
+
+#if defined(LITE_AVX2)
+  __m256 factor8 = _mm256_set1_ps(t);
+  for (; i + 8 <= size; i += 8)
+  {
+    __m256 a = _mm256_loadu_ps(pA + i);
+    __m256 b = _mm256_loadu_ps(pB + i);
+    _mm256_storeu_ps(pResult + i, _mm256_add_ps(a, _mm256_mul_ps(factor8, _mm256_sub_ps(b, a))));
+  }
+#endif
+#ifdef LITE_SSE2
+  __m128 factor = _mm_set1_ps(t);
+  for (; i + 4 <= size; i += 4)
+  {
+    __m128 a = _mm_loadu_ps(pA + i);
+    __m128 b = _mm_loadu_ps(pB + i);
+    _mm_storeu_ps(pResult + i, _mm_add_ps(a, _mm_mul_ps(factor, _mm_sub_ps(b, a))));
+  }
+#endif
+  for (; i < size; ++i)
+  {
+    pResult[i] = pA[i] + t * (pB[i] - pA[i]);
+  }
+}
+
+/**
+ * @brief Interpolate orientations linearly along the shortest path and
+ * normalize them.
+ *
+ * @param[in] pFrom - orientations at t = 0
+ * @param[in] pTo - orientations at t = 1
+ * @param[in] t - interpolation factor
+ * @param[out] pOut - receives the orientations, may be one of the inputs
+ * @param[in] count - number of orientations
+ */
+void TransformBuffer::interpolate(const Quaternion* pFrom, const Quaternion* pTo, float t,
+                                  Quaternion* pOut, size_t count)
+{
+  size_t i = 0;
+#ifdef LITE_SSE2
+  __m128 factor = _mm_set1_ps(t);
+  __m128 signBit = _mm_set1_ps(-0.0f);
+  __m128 minLengthSqr = _mm_set1_ps(MIN_LENGTH_SQR);
+  for (; i + 4 <= count; i += 4)
+  {
+    // Four quaternions, transposed so that every register holds one component.
+    __m128 a[4], b[4];
+    for (int lane = 0; lane < 4; ++lane)
+    {
+      a[lane] = _mm_loadu_ps(&pFrom[i + lane].x);
+      b[lane] = _mm_loadu_ps(&pTo[i + lane].x);
+    }
+    _MM_TRANSPOSE4_PS(a[0], a[1], a[2], a[3]);
+    _MM_TRANSPOSE4_PS(b[0], b[1], b[2], b[3]);
+
+    // Flip the target of a negative dot product to take the shorter path.
+    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])),
+                            _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+    __m128 flip = _mm_and_ps(dot, signBit);
+    __m128 result[4];
+    for (int c = 0; c < 4; ++c)
+    {
+      __m128 target = _mm_xor_ps(b[c], flip);
+      result[c] = _mm_add_ps(a[c], _mm_mul_ps(factor, _mm_sub_ps(target, a[c])));
+    }
+
+    __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(result[0], result[0]),
+                                             _mm_mul_ps(result[1], result[1])),
+                                  _mm_add_ps(_mm_mul_ps(result[2], result[2]),
+                                             _mm_mul_ps(result[3], result[3])));
+    __m128 length = _mm_sqrt_ps(_mm_max_ps(lengthSqr, minLengthSqr));
+    for (int c = 0; c < 4; ++c)
+    {
+      result[c] = _mm_div_ps(result[c], length);
+    }
+
+    _MM_TRANSPOSE4_PS(result[0], result[1], result[2], result[3]);
+    for (int lane = 0; lane < 4; ++lane)
+    {
+      _mm_storeu_ps(&pOut[i + lane].x, result[lane]);
+    }
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    const Quaternion& a = pFrom[i];
+    const Quaternion& b = pTo[i];
+    float sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f ? -1.0f : 1.0f;
+    float x = a.x + t * (b.x * sign - a.x);
+    float y = a.y + t * (b.y * sign - a.y);
+    float z = a.z + t * (b.z * sign - a.z);
+    float w = a.w + t * (b.w * sign - a.w);
+    float length = sqrtf(std::max(x * x + y * y + z * z + w * w, MIN_LENGTH_SQR));
+    pOut[i] = Quaternion(x / length, y / length, z / length, w / length);
+  }
+}
+
+}
@@ -0,0 +1,303 @@
+/**
+ * @file AsyncFileReader.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the AsyncFileReader class for the
+ *        Windows OS.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\..\Include\LiteCube\Core\AsyncFileReader.h"
+#include <windows.h>
+
+#include <algorithm>
+
+namespace Lite
+{
+
+// Completions dequeued from the port with a single call.
+static const ULONG POLL_BATCH = 16;
+
+/*
+ * State of one file read. The OVERLAPPED structure comes first so that the
+ * pointer returned by the completion port can be cast back.
+ */
+struct AsyncFileReader::ReadOperation
+{
+  OVERLAPPED     overlapped;
+  HANDLE         file;
+  unsigned char* pData;
+  size_t         size;
+  size_t         offset;
+  void*          pUserData;
+};
+
+/**
+ * Default constructor.
+ * No completion port exists until open() is called.
+ */
+AsyncFileReader::AsyncFileReader()
+  : m_port(NULL)
+{
+}
+
+/**
+ * Destructor.
+ * Cancels the reads in progress and closes the completion port.
+ */
+AsyncFileReader::~AsyncFileReader()
+{
+  close();
+}
+
+/**
+ * @brief Create the completion port.
+ *
+ * @return true on success, false if asynchronous I/O is not available
+ */
+bool AsyncFileReader::open()
+{
+  close();
+  m_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+  return m_port != NULL;
+}
+
+/**
+ * @brief Cancel all reads, wait for them and close the completion port.
+ *
+ * Reads cancelled here are not reported by poll().
+ */
+void AsyncFileReader::close()
+{
+  if (m_port == NULL)
+  {
+    return;
+  }
+
+  std::vector<ReadOperation*> operations;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    operations.swap(m_operations);
+  }
+  for (size_t i = 0; i < operations.size(); ++i)
+  {
+    DWORD bytes;
+    CancelIoEx(operations[i]->file, &operations[i]->overlapped);
+    GetOverlappedResult(operations[i]->file, &operations[i]->overlapped, &bytes, TRUE);
+    CloseHandle(operations[i]->file);
+    delete operations[i];
+  }
+
+  CloseHandle((HANDLE) m_port);
+  m_port = NULL;
+}
+
+/**
+ * @brief Check whether the completion port exists.
+ *
+ * @return true if reads can be started
+ */
+bool AsyncFileReader::isOpen() const
+{
+  return m_port != NULL;
+}
+
+/**
+ * @brief Start reading a whole file.
+ *
+ * The data buffer is resized to the file size and filled in the background,
+ * it must not be touched until poll() reports the read.
+ *
+ * @param[in]  path      - path to the file
+ * @param[out] data      - buffer receiving the file contents
+ * @param[in]  pUserData - value identifying the read in poll() and cancel()
+ * @return true if the read was started, false if the file could not be
+ *         opened, in which case poll() will not report it
+ */
+bool AsyncFileReader::read(const String& path, std::vector<unsigned char>& data,
+                           void* pUserData)
+{
+  if (m_port == NULL)
+  {
+    return false;
+  }
+
+  HANDLE file = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                           FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || (unsigned long long) size.QuadPart > (size_t) -1 ||
+      CreateIoCompletionPort(file, (HANDLE) m_port, 0, 0) == NULL)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  data.resize((size_t) size.QuadPart);
+
+  ReadOperation* pOperation = new ReadOperation;
+  memset(&pOperation->overlapped, 0, sizeof(OVERLAPPED));
+  pOperation->file      = file;
+  pOperation->pData     = data.empty() ? NULL : &data[0];
+  pOperation->size      = data.size();
+  pOperation->offset    = 0;
+  pOperation->pUserData = pUserData;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_operations.push_back(pOperation);
+  }
+
+  // An empty file has nothing to read, report it through the port so that
+  // every started read completes the same way.
+  if (pOperation->size == 0)
+  {
+    PostQueuedCompletionStatus((HANDLE) m_port, 0, 0, &pOperation->overlapped);
+    return true;
+  }
+
+  if (!issue(pOperation))
+  {
+    remove(pOperation);
+    CloseHandle(file);
+    delete pOperation;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Abort a read in progress.
+ *
+ * The read is still reported by poll(), as failed unless it had already
+ * finished.
+ *
+ * @param[in] pUserData - value passed to read()
+ * @return true if a read with this user data was in progress
+ */
+bool AsyncFileReader::cancel(void* pUserData)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (size_t i = 0; i < m_operations.size(); ++i)
+  {
+    if (m_operations[i]->pUserData == pUserData)
+    {
+      CancelIoEx(m_operations[i]->file, &m_operations[i]->overlapped);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Collect finished reads.
+ *
+ * Partially read files are continued here, so only one thread may poll.
+ *
+ * @param[out] pCompletions - array receiving the finished reads
+ * @param[in]  maxCount     - capacity of pCompletions
+ * @param[in]  timeoutMs    - time to wait for the first completion,
+ *                            WAIT_FOREVER waits until a read finishes or wake()
+ *                            is called
+ * @return number of entries written to pCompletions
+ */
+size_t AsyncFileReader::poll(Completion* pCompletions, size_t maxCount, unsigned int timeoutMs)
+{
+  OVERLAPPED_ENTRY entries[POLL_BATCH];
+  ULONG removed = 0;
+  ULONG batch = (ULONG) std::min<size_t>(maxCount, POLL_BATCH);
+  if (m_port == NULL || batch == 0 ||
+      !GetQueuedCompletionStatusEx((HANDLE) m_port, entries, batch, &removed, timeoutMs, FALSE))
+  {
+    return 0;
+  }
+
+  size_t count = 0;
+  for (ULONG i = 0; i < removed; ++i)
+  {
+    // Entries without an OVERLAPPED come from wake().
+    if (entries[i].lpOverlapped == NULL)
+    {
+      continue;
+    }
+
+    ReadOperation* pOperation = (ReadOperation*) entries[i].lpOverlapped;
+    DWORD bytes = 0;
+    bool isSuccess = pOperation->size == 0 ||
+      GetOverlappedResult(pOperation->file, &pOperation->overlapped, &bytes, FALSE) != FALSE;
+    pOperation->offset += bytes;
+
+    if (isSuccess && bytes > 0 && pOperation->offset < pOperation->size &&
+        issue(pOperation))
+    {
+      continue;
+    }
+
+    remove(pOperation);
+    CloseHandle(pOperation->file);
+    pCompletions[count].pUserData = pOperation->pUserData;
+    pCompletions[count].bytesRead = pOperation->offset;
+    pCompletions[count].isSuccess = isSuccess && pOperation->offset == pOperation->size;
+    ++count;
+    delete pOperation;
+  }
+  return count;
+}
+
+/**
+ * @brief Make a blocked poll() return.
+ */
+void AsyncFileReader::wake()
+{
+  if (m_port != NULL)
+  {
+    PostQueuedCompletionStatus((HANDLE) m_port, 0, 0, NULL);
+  }
+}
+
+/*
+ * Start reading the next part of a file at its current offset.
+ */
+bool AsyncFileReader::issue(ReadOperation* pOperation)
+{
+  size_t remaining = pOperation->size - pOperation->offset;
+  DWORD chunk = (DWORD) std::min<size_t>(remaining, MAX_READ_SIZE);
+  unsigned long long offset = pOperation->offset;
+
+  pOperation->overlapped.Internal     = 0;
+  pOperation->overlapped.InternalHigh = 0;
+  pOperation->overlapped.Offset       = (DWORD) offset;
+  pOperation->overlapped.OffsetHigh   = (DWORD) (offset >> 32);
+
+  // Completions are queued to the port even when ReadFile finishes at once.
+  if (!ReadFile(pOperation->file, pOperation->pData + pOperation->offset, chunk, NULL,
+                &pOperation->overlapped))
+  {
+    return GetLastError() == ERROR_IO_PENDING;
+  }
+  return true;
+}
+
+/*
+ * Forget a finished read.
+ */
+void AsyncFileReader::remove(ReadOperation* pOperation)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  std::vector<ReadOperation*>::iterator it =
+    std::find(m_operations.begin(), m_operations.end(), pOperation);
+  if (it != m_operations.end())
+  {
+    m_operations.erase(it);
+  }
+}
+
+}
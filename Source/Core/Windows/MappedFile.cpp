@@ -0,0 +1,146 @@
+/**
+ * @file MappedFile.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the MappedFile class for the Windows OS.
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\..\Include\LiteCube\Core\MappedFile.h"
+#include <windows.h>
+
+namespace Lite
+{
+
+/**
+ * Default constructor.
+ * No file is mapped until open() is called.
+ */
+MappedFile::MappedFile()
+  : m_file(INVALID_HANDLE_VALUE)
+  , m_mapping(NULL)
+  , m_pData(NULL)
+  , m_size(0)
+{
+}
+
+/**
+ * Destructor.
+ * Unmaps the file if it is open.
+ */
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+/**
+ * Map a file for reading.
+ *
+ * @param[in] path - path to the file
+ *
+ * @return true on success, false if the file could not be opened or mapped
+ */
+bool MappedFile::open(const String& path)
+{
+  close();
+
+  HANDLE file = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                           OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 ||
+      (unsigned long long) size.QuadPart > (size_t) -1)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  const void* pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (pData == NULL)
+  {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  m_file = file;
+  m_mapping = mapping;
+  m_pData = pData;
+  m_size = (size_t) size.QuadPart;
+  return true;
+}
+
+/**
+ * Unmap the file. Pointers obtained from getData() become invalid.
+ */
+void MappedFile::close()
+{
+  if (m_pData != NULL)
+  {
+    UnmapViewOfFile(m_pData);
+    m_pData = NULL;
+  }
+
+  if (m_mapping != NULL)
+  {
+    CloseHandle(m_mapping);
+    m_mapping = NULL;
+  }
+
+  if (m_file != INVALID_HANDLE_VALUE)
+  {
+    CloseHandle(m_file);
+    m_file = INVALID_HANDLE_VALUE;
+  }
+
+  m_size = 0;
+}
+
+/**
+ * Check whether a file is mapped.
+ *
+ * @return true if open() succeeded and close() was not called since
+ */
+bool MappedFile::isOpen() const
+{
+  return m_pData != NULL;
+}
+
+/**
+ * Obtain the first byte of the file.
+ *
+ * @return pointer to the mapped file, NULL if no file is open
+ */
+const void* MappedFile::getData() const
+{
+  return m_pData;
+}
+
+/**
+ * Obtain the size of the mapped file.
+ *
+ * @return size in bytes
+ */
+size_t MappedFile::getSize() const
+{
+  return m_size;
+}
+
+}
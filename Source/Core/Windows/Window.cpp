@@ -12,6 +12,8 @@
  * of the MIT license.  See the LICENSE file for details.
  */
 #include "..\Include\LiteCube\Core\Window.h"
+#include "..\..\..\Include\LiteCube\Core\FrameCapture.h"
+#include "..\..\..\Include\LiteCube\Core\Profiler.h"
 #include <windows.h>
 
 #define WINDOW_CLASS_NAME TEXT("LiteCubeWindow")
@@ -27,6 +29,45 @@
 namespace Lite
 {
 
+/**
+ * @brief Show a 32 bit BGRA image in the window's client area.
+ *
+ * The image is stretched to the size of the client area, so a buffer
+ * rendered at a lower resolution is upscaled.
+ *
+ * @param pPixels - top row first, 4 bytes per pixel
+ * @param width   - image width in pixels
+ * @param height  - image height in pixels
+ * @param stride  - bytes between rows, a multiple of 4
+ *
+ * @return true if the image was drawn
+ */
+bool Window::present(const unsigned char* pPixels, int width, int height, size_t stride)
+{
+  LITE_PROFILE_ZONE("Window::present");
+  RECT rect;
+  if (!m_isCreated || pPixels == NULL || !GetClientRect((HWND) m_handle, &rect))
+  {
+    return false;
+  }
+
+  BITMAPINFO info;
+  ZeroMemory(&info, sizeof(info));
+  info.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+  info.bmiHeader.biWidth       = (LONG) (stride / 4);
+  info.bmiHeader.biHeight      = -height;
+  info.bmiHeader.biPlanes      = 1;
+  info.bmiHeader.biBitCount    = 32;
+  info.bmiHeader.biCompression = BI_RGB;
+
+  HDC windowDC = GetDC((HWND) m_handle);
+  SetStretchBltMode(windowDC, COLORONCOLOR);
+  int lines = StretchDIBits(windowDC, 0, 0, rect.right, rect.bottom, 0, 0, width, height,
+                            pPixels, &info, DIB_RGB_COLORS, SRCCOPY);
+  ReleaseDC((HWND) m_handle, windowDC);
+  return lines != 0;
+}
+
 static LRESULT CALLBACK WndProc( HWND hWnd, UINT message, 
                                  WPARAM wParam, LPARAM lParam);
 
@@ -238,6 +279,30 @@ void Window::getSize(int& width, int& height) const
   }
 }
 
+/**
+ * @brief Obtain the size of the client area.
+ *
+ * This is the area pixels are drawn to, without the borders and title bar.
+ *
+ * @param[out] width  - the client area width
+ * @param[out] height - the client area height
+ */
+void Window::getClientSize(int& width, int& height) const
+{
+  RECT rect;
+  width = -1;
+  height = -1;
+
+  if (m_handle != NULL && IsWindow((HWND) m_handle))
+  {
+    if (GetClientRect((HWND) m_handle, &rect))
+    {
+      width = rect.right - rect.left;
+      height = rect.bottom - rect.top;
+    }
+  }
+}
+
 /**
  * @brief Change the window's position.
  *
@@ -418,6 +483,7 @@ long Window::handleEvent(void* pEvent)
  */
 void Window::pollEvents(bool all)
 {
+  LITE_PROFILE_ZONE("Window::pollEvents");
   static MSG msg;
   do 
   {
@@ -433,6 +499,66 @@ void Window::pollEvents(bool all)
   } while(all);
 }
 
+/**
+ * @brief Record the contents of the window's client area.
+ *
+ * The pixels are read back from the window into a buffer of the capture as
+ * 32 bit BGRA, top row first. Compression and writing happen in the
+ * background.
+ *
+ * @param capture - open capture whose frame size matches the client area
+ *
+ * @return true if the frame was submitted, false if it was dropped by the
+ *         capture, the sizes differ or the pixels could not be read
+ */
+bool Window::captureFrame(FrameCapture& capture)
+{
+  LITE_PROFILE_ZONE("Window::captureFrame");
+  RECT rect;
+  if (!m_isCreated || !GetClientRect((HWND) m_handle, &rect) ||
+      rect.right != capture.getWidth() || rect.bottom != capture.getHeight())
+  {
+    return false;
+  }
+
+  size_t stride;
+  unsigned char* pPixels = capture.beginFrame(stride);
+  if (pPixels == NULL)
+  {
+    return false;
+  }
+
+  int width = rect.right, height = rect.bottom;
+  HDC windowDC = GetDC((HWND) m_handle);
+  HDC memoryDC = CreateCompatibleDC(windowDC);
+  HBITMAP bitmap = CreateCompatibleBitmap(windowDC, width, height);
+  HGDIOBJ previous = SelectObject(memoryDC, bitmap);
+  BitBlt(memoryDC, 0, 0, width, height, windowDC, 0, 0, SRCCOPY);
+  SelectObject(memoryDC, previous);
+
+  BITMAPINFO info;
+  ZeroMemory(&info, sizeof(info));
+  info.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+  info.bmiHeader.biWidth       = width;
+  info.bmiHeader.biHeight      = -height;
+  info.bmiHeader.biPlanes      = 1;
+  info.bmiHeader.biBitCount    = 32;
+  info.bmiHeader.biCompression = BI_RGB;
+  bool isRead = GetDIBits(memoryDC, bitmap, 0, height, pPixels, &info, DIB_RGB_COLORS) == height;
+
+  DeleteObject(bitmap);
+  DeleteDC(memoryDC);
+  ReleaseDC((HWND) m_handle, windowDC);
+
+  if (!isRead)
+  {
+    capture.cancelFrame();
+    return false;
+  }
+  capture.endFrame();
+  return true;
+}
+
 static LRESULT CALLBACK WndProc(
   HWND   hWnd, 
   UINT   message, 
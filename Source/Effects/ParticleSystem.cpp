@@ -0,0 +1,410 @@
+/**
+ * @file ParticleSystem.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the ParticleSystem class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Effects\ParticleSystem.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+static const size_t GRAIN_SIZE = 8192;
+
+/**
+ * Parametrized constructor.
+ *
+ * @param[in] capacity - maximum number of live particles
+ */
+ParticleSystem::ParticleSystem(size_t capacity)
+  : m_px(capacity), m_py(capacity), m_pz(capacity)
+  , m_vx(capacity), m_vy(capacity), m_vz(capacity)
+  , m_life(capacity)
+  , m_count(0)
+  , m_gravity(0.0f, -9.81f, 0.0f)
+  , m_drag(0.0f)
+{
+}
+
+/**
+ * Destructor.
+ */
+ParticleSystem::~ParticleSystem()
+{
+}
+
+/**
+ * Spawn a particle.
+ *
+ * @param[in] position - initial position
+ * @param[in] velocity - initial velocity
+ * @param[in] lifetime - seconds until the particle is removed
+ *
+ * @return true on success, false if the system is full
+ */
+bool ParticleSystem::emit(const Vector3f& position, const Vector3f& velocity,
+                          float lifetime)
+{
+  if (m_count >= m_life.size())
+  {
+    return false;
+  }
+
+  size_t i = m_count++;
+  m_px[i] = position.x;
+  m_py[i] = position.y;
+  m_pz[i] = position.z;
+  m_vx[i] = velocity.x;
+  m_vy[i] = velocity.y;
+  m_vz[i] = velocity.z;
+  m_life[i] = lifetime;
+  return true;
+}
+
+/**
+ * Remove all particles.
+ */
+void ParticleSystem::clear()
+{
+  m_count = 0;
+}
+
+/**
+ * Set the acceleration applied to every particle.
+ *
+ * @param[in] gravity - acceleration in units per second squared
+ */
+void ParticleSystem::setGravity(const Vector3f& gravity)
+{
+  m_gravity = gravity;
+}
+
+/**
+ * Obtain the acceleration applied to every particle.
+ *
+ * @return gravity
+ */
+const Vector3f& ParticleSystem::getGravity() const
+{
+  return m_gravity;
+}
+
+/**
+ * Set the linear drag coefficient.
+ *
+ * Every step the velocity is scaled by 1 - drag * dt.
+ *
+ * @param[in] drag - drag per second, 0 disables drag
+ */
+void ParticleSystem::setDrag(float drag)
+{
+  m_drag = drag < 0.0f ? 0.0f : drag;
+}
+
+/**
+ * Obtain the linear drag coefficient.
+ *
+ * @return drag per second
+ */
+float ParticleSystem::getDrag() const
+{
+  return m_drag;
+}
+
+/**
+ * Add a plane the particles collide with.
+ *
+ * @param[in] plane - the collision plane
+ *
+ * @return true on success, false if MAX_PLANES planes are already set
+ */
+bool ParticleSystem::addPlane(const Plane& plane)
+{
+  if (m_planes.size() >= MAX_PLANES)
+  {
+    return false;
+  }
+
+  m_planes.push_back(plane);
+  return true;
+}
+
+/**
+ * Remove all collision planes.
+ */
+void ParticleSystem::clearPlanes()
+{
+  m_planes.clear();
+}
+
+/**
+ * Advance the simulation.
+ *
+ * Integrates velocity and position with semi-implicit Euler, resolves plane
+ * collisions and removes expired particles.
+ *
+ * @param[in] dt    - time step in seconds
+ * @param[in] pPool - pool used to split the particles over threads, or NULL
+ */
+void ParticleSystem::update(float dt, ThreadPool* pPool)
+{
+  float damping = 1.0f - m_drag * dt;
+  if (damping < 0.0f)
+  {
+    damping = 0.0f;
+  }
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, m_count, GRAIN_SIZE, [=](size_t begin, size_t end) {
+      integrate(begin, end, dt, damping);
+    });
+  }
+  else
+  {
+    integrate(0, m_count, dt, damping);
+  }
+
+  compact();
+}
+
+void ParticleSystem::integrate(size_t begin, size_t end, float dt, float damping)
+{
+  if (begin >= end)
+  {
+    return;
+  }
+
+  float* px = &m_px[0];
+  float* py = &m_py[0];
+  float* pz = &m_pz[0];
+  float* vx = &m_vx[0];
+  float* vy = &m_vy[0];
+  float* vz = &m_vz[0];
+  float* life = &m_life[0];
+  const Plane* pPlanes = m_planes.empty() ? NULL : &m_planes[0];
+  size_t planeCount = m_planes.size();
+  float gdx = m_gravity.x * dt;
+  float gdy = m_gravity.y * dt;
+  float gdz = m_gravity.z * dt;
+
+  size_t i = begin;
+
+#ifdef LITE_SSE2
+  const __m128 dt4   = _mm_set1_ps(dt);
+  const __m128 damp4 = _mm_set1_ps(damping);
+  const __m128 gdx4  = _mm_set1_ps(gdx);
+  const __m128 gdy4  = _mm_set1_ps(gdy);
+  const __m128 gdz4  = _mm_set1_ps(gdz);
+  const __m128 zero  = _mm_setzero_ps();
+
+  for (; i + 4 <= end; i += 4)
+  {
+    __m128 x  = _mm_loadu_ps(px + i);
+    __m128 y  = _mm_loadu_ps(py + i);
+    __m128 z  = _mm_loadu_ps(pz + i);
+    __m128 ux = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vx + i), gdx4), damp4);
+    __m128 uy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vy + i), gdy4), damp4);
+    __m128 uz = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vz + i), gdz4), damp4);
+
+    x = _mm_add_ps(x, _mm_mul_ps(ux, dt4));
+    y = _mm_add_ps(y, _mm_mul_ps(uy, dt4));
+    z = _mm_add_ps(z, _mm_mul_ps(uz, dt4));
+
+    for (size_t p = 0; p < planeCount; ++p)
+    {
+      const __m128 nx = _mm_set1_ps(pPlanes[p].normal.x);
+      const __m128 ny = _mm_set1_ps(pPlanes[p].normal.y);
+      const __m128 nz = _mm_set1_ps(pPlanes[p].normal.z);
+
+      // Push penetrating particles back onto the plane.
+      __m128 d = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, nx), _mm_mul_ps(y, ny)),
+                                       _mm_mul_ps(z, nz)),
+                            _mm_set1_ps(pPlanes[p].distance));
+      __m128 inside = _mm_cmplt_ps(d, zero);
+      d = _mm_and_ps(inside, d);
+      x = _mm_sub_ps(x, _mm_mul_ps(nx, d));
+      y = _mm_sub_ps(y, _mm_mul_ps(ny, d));
+      z = _mm_sub_ps(z, _mm_mul_ps(nz, d));
+
+      // Reflect the normal velocity of those moving into the plane.
+      __m128 vn = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ux, nx), _mm_mul_ps(uy, ny)),
+                             _mm_mul_ps(uz, nz));
+      __m128 bounce = _mm_and_ps(inside, _mm_cmplt_ps(vn, zero));
+      vn = _mm_and_ps(bounce,
+                      _mm_mul_ps(vn, _mm_set1_ps(1.0f + pPlanes[p].restitution)));
+      ux = _mm_sub_ps(ux, _mm_mul_ps(nx, vn));
+      uy = _mm_sub_ps(uy, _mm_mul_ps(ny, vn));
+      uz = _mm_sub_ps(uz, _mm_mul_ps(nz, vn));
+    }
+
+    _mm_storeu_ps(px + i, x);
+    _mm_storeu_ps(py + i, y);
+    _mm_storeu_ps(pz + i, z);
+    _mm_storeu_ps(vx + i, ux);
+    _mm_storeu_ps(vy + i, uy);
+    _mm_storeu_ps(vz + i, uz);
+    _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt4));
+  }
+#endif
+
+  for (; i < end; ++i)
+  {
+    float ux = (vx[i] + gdx) * damping;
+    float uy = (vy[i] + gdy) * damping;
+    float uz = (vz[i] + gdz) * damping;
+    float x = px[i] + ux * dt;
+    float y = py[i] + uy * dt;
+    float z = pz[i] + uz * dt;
+
+    for (size_t p = 0; p < planeCount; ++p)
+    {
+      const Vector3f& n = pPlanes[p].normal;
+      float d = x * n.x + y * n.y + z * n.z - pPlanes[p].distance;
+      if (d < 0.0f)
+      {
+        x -= n.x * d;
+        y -= n.y * d;
+        z -= n.z * d;
+        float vn = ux * n.x + uy * n.y + uz * n.z;
+        if (vn < 0.0f)
+        {
+          vn *= 1.0f + pPlanes[p].restitution;
+          ux -= n.x * vn;
+          uy -= n.y * vn;
+          uz -= n.z * vn;
+        }
+      }
+    }
+
+    px[i] = x;
+    py[i] = y;
+    pz[i] = z;
+    vx[i] = ux;
+    vy[i] = uy;
+    vz[i] = uz;
+    life[i] -= dt;
+  }
+}
+
+void ParticleSystem::compact()
+{
+  size_t i = 0;
+  while (i < m_count)
+  {
+    if (m_life[i] > 0.0f)
+    {
+      ++i;
+      continue;
+    }
+
+    size_t last = --m_count;
+    m_px[i] = m_px[last];
+    m_py[i] = m_py[last];
+    m_pz[i] = m_pz[last];
+    m_vx[i] = m_vx[last];
+    m_vy[i] = m_vy[last];
+    m_vz[i] = m_vz[last];
+    m_life[i] = m_life[last];
+  }
+}
+
+/**
+ * Obtain the number of live particles.
+ *
+ * @return particle count
+ */
+size_t ParticleSystem::getCount() const
+{
+  return m_count;
+}
+
+/**
+ * Obtain the maximum number of live particles.
+ *
+ * @return capacity
+ */
+size_t ParticleSystem::getCapacity() const
+{
+  return m_life.size();
+}
+
+/**
+ * Obtain the position of a particle.
+ *
+ * @param[in] index - particle index, less than getCount()
+ *
+ * @return position
+ */
+Vector3f ParticleSystem::getPosition(size_t index) const
+{
+  return Vector3f(m_px[index], m_py[index], m_pz[index]);
+}
+
+/**
+ * Obtain the velocity of a particle.
+ *
+ * @param[in] index - particle index, less than getCount()
+ *
+ * @return velocity
+ */
+Vector3f ParticleSystem::getVelocity(size_t index) const
+{
+  return Vector3f(m_vx[index], m_vy[index], m_vz[index]);
+}
+
+/**
+ * Obtain the remaining lifetime of a particle.
+ *
+ * @param[in] index - particle index, less than getCount()
+ *
+ * @return seconds until the particle is removed
+ */
+float ParticleSystem::getLifetime(size_t index) const
+{
+  return m_life[index];
+}
+
+/**
+ * Obtain the x coordinates of all live particles, for rendering.
+ *
+ * @return getCount() x coordinates
+ */
+const float* ParticleSystem::getPositionsX() const
+{
+  return m_px.empty() ? NULL : &m_px[0];
+}
+
+/**
+ * Obtain the y coordinates of all live particles, for rendering.
+ *
+ * @return getCount() y coordinates
+ */
+const float* ParticleSystem::getPositionsY() const
+{
+  return m_py.empty() ? NULL : &m_py[0];
+}
+
+/**
+ * Obtain the z coordinates of all live particles, for rendering.
+ *
+ * @return getCount() z coordinates
+ */
+const float* ParticleSystem::getPositionsZ() const
+{
+  return m_pz.empty() ? NULL : &m_pz[0];
+}
+
+}
@@ -0,0 +1,947 @@
+/**
+ * @file BVH.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the BVH class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\BVH.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+
+namespace Lite
+{
+
+static const unsigned int BIN_COUNT              = 16;
+static const unsigned int MAX_LEAF_SIZE          = 8;
+static const unsigned int MAX_DEPTH              = 64;
+static const unsigned int PARALLEL_TASK_SIZE     = 4096;
+static const unsigned int PARALLEL_BIN_SIZE      = 65536;
+static const float        TRAVERSAL_COST         = 1.0f;
+
+/*
+ * Bounds and centroid of a single triangle, used only while building.
+ */
+struct PrimInfo
+{
+  float bmin[3];
+  float bmax[3];
+  float centroid[3];
+};
+
+/*
+ * Bounds of a set of primitives together with the bounds of their centroids.
+ */
+struct RangeBounds
+{
+  float bmin[3];
+  float bmax[3];
+  float cmin[3];
+  float cmax[3];
+
+  void reset()
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      bmin[i] = cmin[i] =  FLT_MAX;
+      bmax[i] = cmax[i] = -FLT_MAX;
+    }
+  }
+
+  void merge(const RangeBounds& other)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      bmin[i] = std::min(bmin[i], other.bmin[i]);
+      bmax[i] = std::max(bmax[i], other.bmax[i]);
+      cmin[i] = std::min(cmin[i], other.cmin[i]);
+      cmax[i] = std::max(cmax[i], other.cmax[i]);
+    }
+  }
+};
+
+struct Bin
+{
+  float        bmin[3];
+  float        bmax[3];
+  unsigned int count;
+};
+
+struct BinSet
+{
+  Bin bins[3][BIN_COUNT];
+
+  void reset()
+  {
+    for (int a = 0; a < 3; ++a)
+    {
+      for (unsigned int b = 0; b < BIN_COUNT; ++b)
+      {
+        Bin& bin = bins[a][b];
+        bin.count = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+          bin.bmin[i] =  FLT_MAX;
+          bin.bmax[i] = -FLT_MAX;
+        }
+      }
+    }
+  }
+
+  void merge(const BinSet& other)
+  {
+    for (int a = 0; a < 3; ++a)
+    {
+      for (unsigned int b = 0; b < BIN_COUNT; ++b)
+      {
+        Bin& bin = bins[a][b];
+        const Bin& src = other.bins[a][b];
+        bin.count += src.count;
+        for (int i = 0; i < 3; ++i)
+        {
+          bin.bmin[i] = std::min(bin.bmin[i], src.bmin[i]);
+          bin.bmax[i] = std::max(bin.bmax[i], src.bmax[i]);
+        }
+      }
+    }
+  }
+};
+
+struct BVH::BuildContext
+{
+  std::vector<PrimInfo>     prims;
+  unsigned int*             pIds;
+  std::atomic<unsigned int> nodeCount;
+  ThreadPool*               pPool;
+};
+
+static float halfArea(const float bmin[3], const float bmax[3])
+{
+  float dx = bmax[0] - bmin[0];
+  float dy = bmax[1] - bmin[1];
+  float dz = bmax[2] - bmin[2];
+  return dx * dy + dy * dz + dz * dx;
+}
+
+static void boundRange(const PrimInfo* pPrims, const unsigned int* pIds,
+                       size_t begin, size_t end, RangeBounds& out)
+{
+  out.reset();
+  for (size_t i = begin; i < end; ++i)
+  {
+    const PrimInfo& p = pPrims[pIds[i]];
+    for (int k = 0; k < 3; ++k)
+    {
+      out.bmin[k] = std::min(out.bmin[k], p.bmin[k]);
+      out.bmax[k] = std::max(out.bmax[k], p.bmax[k]);
+      out.cmin[k] = std::min(out.cmin[k], p.centroid[k]);
+      out.cmax[k] = std::max(out.cmax[k], p.centroid[k]);
+    }
+  }
+}
+
+static inline unsigned int binIndex(float c, float cmin, float scale)
+{
+  int b = (int) ((c - cmin) * scale);
+  if (b < 0) b = 0;
+  if (b >= (int) BIN_COUNT) b = BIN_COUNT - 1;
+  return (unsigned int) b;
+}
+
+static void binRange(const PrimInfo* pPrims, const unsigned int* pIds,
+                     size_t begin, size_t end,
+                     const float cmin[3], const float scale[3], BinSet& out)
+{
+  out.reset();
+  for (size_t i = begin; i < end; ++i)
+  {
+    const PrimInfo& p = pPrims[pIds[i]];
+    for (int a = 0; a < 3; ++a)
+    {
+      Bin& bin = out.bins[a][binIndex(p.centroid[a], cmin[a], scale[a])];
+      bin.count++;
+      for (int k = 0; k < 3; ++k)
+      {
+        bin.bmin[k] = std::min(bin.bmin[k], p.bmin[k]);
+        bin.bmax[k] = std::max(bin.bmax[k], p.bmax[k]);
+      }
+    }
+  }
+}
+
+/*
+ * Slab test of a ray against a node. Returns the entry distance or FLT_MAX
+ * on a miss.
+ */
+static inline float intersectNode(const BVH::Node& node, const float o[3],
+                                  const float inv[3], float tMin, float tMax)
+{
+  float tx1 = (node.bmin[0] - o[0]) * inv[0];
+  float tx2 = (node.bmax[0] - o[0]) * inv[0];
+  float tNear = std::min(tx1, tx2);
+  float tFar  = std::max(tx1, tx2);
+  float ty1 = (node.bmin[1] - o[1]) * inv[1];
+  float ty2 = (node.bmax[1] - o[1]) * inv[1];
+  tNear = std::max(tNear, std::min(ty1, ty2));
+  tFar  = std::min(tFar,  std::max(ty1, ty2));
+  float tz1 = (node.bmin[2] - o[2]) * inv[2];
+  float tz2 = (node.bmax[2] - o[2]) * inv[2];
+  tNear = std::max(tNear, std::min(tz1, tz2));
+  tFar  = std::min(tFar,  std::max(tz1, tz2));
+  tNear = std::max(tNear, tMin);
+  tFar  = std::min(tFar, tMax);
+  return tNear <= tFar ? tNear : FLT_MAX;
+}
+
+/*
+ * Moller-Trumbore test against a triangle stored as a vertex and two edges.
+ */
+static inline bool intersectTriangle(const float v0[3], const float e1[3],
+                                     const float e2[3], const float o[3],
+                                     const float d[3], float tMin, float tMax,
+                                     float& t, float& u, float& v)
+{
+  float h[3] = { d[1] * e2[2] - d[2] * e2[1],
+                 d[2] * e2[0] - d[0] * e2[2],
+                 d[0] * e2[1] - d[1] * e2[0] };
+  float a = e1[0] * h[0] + e1[1] * h[1] + e1[2] * h[2];
+  if (a > -1e-12f && a < 1e-12f)
+  {
+    return false;
+  }
+
+  float f = 1.0f / a;
+  float s[3] = { o[0] - v0[0], o[1] - v0[1], o[2] - v0[2] };
+  u = f * (s[0] * h[0] + s[1] * h[1] + s[2] * h[2]);
+  if (u < 0.0f || u > 1.0f)
+  {
+    return false;
+  }
+
+  float q[3] = { s[1] * e1[2] - s[2] * e1[1],
+                 s[2] * e1[0] - s[0] * e1[2],
+                 s[0] * e1[1] - s[1] * e1[0] };
+  v = f * (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]);
+  if (v < 0.0f || u + v > 1.0f)
+  {
+    return false;
+  }
+
+  t = f * (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]);
+  return t > tMin && t < tMax;
+}
+
+static inline float safeInverse(float d)
+{
+  if (std::fabs(d) < 1e-20f)
+  {
+    return d < 0.0f ? -1e20f : 1e20f;
+  }
+  return 1.0f / d;
+}
+
+/**
+ * Default constructor.
+ * Creates an empty hierarchy which no ray intersects.
+ */
+BVH::BVH()
+  : m_nodeCount(0)
+{
+}
+
+/**
+ * Destructor.
+ */
+BVH::~BVH()
+{
+}
+
+/**
+ * Build the hierarchy over a triangle soup.
+ *
+ * The vertex data is copied, so the arrays may be released afterwards.
+ *
+ * @param[in] pVertices     - vertex positions
+ * @param[in] pIndices      - three vertex indices per triangle, or NULL if
+ *                            every three consecutive vertices form a triangle
+ * @param[in] triangleCount - number of triangles
+ * @param[in] pPool         - pool used to build in parallel, NULL to build on
+ *                            the calling thread only
+ */
+void BVH::build(const Vector3f* pVertices, const unsigned int* pIndices,
+                size_t triangleCount, ThreadPool* pPool)
+{
+  clear();
+  if (pVertices == NULL || triangleCount == 0)
+  {
+    return;
+  }
+
+  BuildContext ctx;
+  ctx.prims.resize(triangleCount);
+  ctx.pPool = pPool;
+  ctx.nodeCount = 2;  // Node 1 is unused so that sibling pairs are aligned.
+
+  m_triangleIds.resize(triangleCount);
+  m_triangles.resize(triangleCount);
+  m_nodes.resize(triangleCount * 2 + 1);
+  ctx.pIds = &m_triangleIds[0];
+
+  PrimInfo* pPrims = &ctx.prims[0];
+  unsigned int* pIds = ctx.pIds;
+  Triangle* pTris = &m_triangles[0];
+  ThreadPool::RangeTask prepare = [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      const Vector3f& a = pVertices[pIndices ? pIndices[i * 3 + 0] : i * 3 + 0];
+      const Vector3f& b = pVertices[pIndices ? pIndices[i * 3 + 1] : i * 3 + 1];
+      const Vector3f& c = pVertices[pIndices ? pIndices[i * 3 + 2] : i * 3 + 2];
+      PrimInfo& p = pPrims[i];
+      Triangle& t = pTris[i];
+      for (int k = 0; k < 3; ++k)
+      {
+        p.bmin[k] = std::min(a.v[k], std::min(b.v[k], c.v[k]));
+        p.bmax[k] = std::max(a.v[k], std::max(b.v[k], c.v[k]));
+        p.centroid[k] = (a.v[k] + b.v[k] + c.v[k]) * (1.0f / 3.0f);
+        t.v0[k] = a.v[k];
+        t.e1[k] = b.v[k] - a.v[k];
+        t.e2[k] = c.v[k] - a.v[k];
+      }
+      pIds[i] = (unsigned int) i;
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, triangleCount, 4096, prepare);
+  }
+  else
+  {
+    prepare(0, triangleCount);
+  }
+
+  buildNode(ctx, 0, 0, (unsigned int) triangleCount, 0);
+
+  m_nodeCount = ctx.nodeCount.load();
+  m_nodes.resize(m_nodeCount);
+
+  // Store the triangles in leaf order so a leaf reads one contiguous run.
+  std::vector<Triangle> unordered;
+  unordered.swap(m_triangles);
+  m_triangles.resize(triangleCount);
+  const Triangle* pSrc = &unordered[0];
+  Triangle* pDst = &m_triangles[0];
+  ThreadPool::RangeTask reorder = [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      pDst[i] = pSrc[pIds[i]];
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, triangleCount, 16384, reorder);
+  }
+  else
+  {
+    reorder(0, triangleCount);
+  }
+}
+
+void BVH::buildNode(BuildContext& ctx, unsigned int nodeIndex,
+                    unsigned int first, unsigned int count, unsigned int depth)
+{
+  const PrimInfo* pPrims = &ctx.prims[0];
+  unsigned int* pIds = ctx.pIds;
+  bool isParallel = ctx.pPool != NULL && count >= PARALLEL_BIN_SIZE;
+  size_t numChunks = isParallel ? ctx.pPool->getThreadCount() * 2 : 1;
+
+  // Node bounds and centroid bounds.
+  RangeBounds bounds;
+  if (isParallel)
+  {
+    std::vector<RangeBounds> partial(numChunks);
+    size_t chunkSize = (count + numChunks - 1) / numChunks;
+    ctx.pPool->parallelFor(0, numChunks, 1, [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c)
+      {
+        size_t b = first + c * chunkSize;
+        size_t e = std::min<size_t>(b + chunkSize, first + count);
+        boundRange(pPrims, pIds, std::min<size_t>(b, e), e, partial[c]);
+      }
+    });
+    bounds.reset();
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      bounds.merge(partial[c]);
+    }
+  }
+  else
+  {
+    boundRange(pPrims, pIds, first, first + count, bounds);
+  }
+
+  Node& node = m_nodes[nodeIndex];
+  for (int k = 0; k < 3; ++k)
+  {
+    node.bmin[k] = bounds.bmin[k];
+    node.bmax[k] = bounds.bmax[k];
+  }
+  node.leftFirst = first;
+  node.count = count;
+
+  if (count <= 2 || depth + 1 >= MAX_DEPTH)
+  {
+    return;
+  }
+
+  // Bin the centroids along all three axes.
+  float scale[3];
+  bool canSplit = false;
+  for (int a = 0; a < 3; ++a)
+  {
+    float extent = bounds.cmax[a] - bounds.cmin[a];
+    scale[a] = extent > 0.0f ? (float) BIN_COUNT * 0.99999f / extent : 0.0f;
+    canSplit = canSplit || extent > 0.0f;
+  }
+
+  int   bestAxis = -1;
+  unsigned int bestBin = 0;
+  float bestCost = FLT_MAX;
+
+  if (canSplit)
+  {
+    BinSet bins;
+    if (isParallel)
+    {
+      std::vector<BinSet> partial(numChunks);
+      size_t chunkSize = (count + numChunks - 1) / numChunks;
+      ctx.pPool->parallelFor(0, numChunks, 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+        {
+          size_t b = first + c * chunkSize;
+          size_t e = std::min<size_t>(b + chunkSize, first + count);
+          binRange(pPrims, pIds, std::min<size_t>(b, e), e,
+                   bounds.cmin, scale, partial[c]);
+        }
+      });
+      bins.reset();
+      for (size_t c = 0; c < numChunks; ++c)
+      {
+        bins.merge(partial[c]);
+      }
+    }
+    else
+    {
+      binRange(pPrims, pIds, first, first + count, bounds.cmin, scale, bins);
+    }
+
+    // Sweep the bins from both sides to evaluate every split plane.
+    for (int a = 0; a < 3; ++a)
+    {
+      if (scale[a] == 0.0f)
+      {
+        continue;
+      }
+
+      float leftArea[BIN_COUNT - 1];
+      unsigned int leftCount[BIN_COUNT - 1];
+      float bmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+      float bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+      unsigned int sum = 0;
+      for (unsigned int b = 0; b < BIN_COUNT - 1; ++b)
+      {
+        const Bin& bin = bins.bins[a][b];
+        sum += bin.count;
+        for (int k = 0; k < 3; ++k)
+        {
+          bmin[k] = std::min(bmin[k], bin.bmin[k]);
+          bmax[k] = std::max(bmax[k], bin.bmax[k]);
+        }
+        leftCount[b] = sum;
+        leftArea[b] = sum > 0 ? halfArea(bmin, bmax) : 0.0f;
+      }
+
+      for (int k = 0; k < 3; ++k)
+      {
+        bmin[k] =  FLT_MAX;
+        bmax[k] = -FLT_MAX;
+      }
+      sum = 0;
+      for (unsigned int b = BIN_COUNT - 1; b > 0; --b)
+      {
+        const Bin& bin = bins.bins[a][b];
+        sum += bin.count;
+        for (int k = 0; k < 3; ++k)
+        {
+          bmin[k] = std::min(bmin[k], bin.bmin[k]);
+          bmax[k] = std::max(bmax[k], bin.bmax[k]);
+        }
+        if (sum == 0 || leftCount[b - 1] == 0)
+        {
+          continue;
+        }
+        float cost = leftCount[b - 1] * leftArea[b - 1] + sum * halfArea(bmin, bmax);
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestAxis = a;
+          bestBin = b - 1;
+        }
+      }
+    }
+  }
+
+  float nodeArea = halfArea(bounds.bmin, bounds.bmax);
+  float leafCost = (float) count * nodeArea;
+  bool splitIsWorse = bestAxis < 0 || TRAVERSAL_COST * nodeArea + bestCost >= leafCost;
+  if (splitIsWorse && count <= MAX_LEAF_SIZE)
+  {
+    return;
+  }
+
+  unsigned int leftCount = 0;
+  if (bestAxis >= 0)
+  {
+    float cmin = bounds.cmin[bestAxis];
+    float axisScale = scale[bestAxis];
+    int axis = bestAxis;
+    unsigned int* pMid = std::partition(pIds + first, pIds + first + count,
+      [=](unsigned int id) {
+        return binIndex(pPrims[id].centroid[axis], cmin, axisScale) <= bestBin;
+      });
+    leftCount = (unsigned int) (pMid - (pIds + first));
+  }
+
+  if (leftCount == 0 || leftCount == count)
+  {
+    // All centroids coincide, any split is as good as another.
+    leftCount = count / 2;
+  }
+
+  unsigned int children = ctx.nodeCount.fetch_add(2);
+  node.leftFirst = children;
+  node.count = 0;
+
+  if (ctx.pPool != NULL && count >= PARALLEL_TASK_SIZE)
+  {
+    ctx.pPool->parallelFor(0, 2, 1, [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c)
+      {
+        if (c == 0)
+        {
+          buildNode(ctx, children, first, leftCount, depth + 1);
+        }
+        else
+        {
+          buildNode(ctx, children + 1, first + leftCount,
+                    count - leftCount, depth + 1);
+        }
+      }
+    });
+  }
+  else
+  {
+    buildNode(ctx, children, first, leftCount, depth + 1);
+    buildNode(ctx, children + 1, first + leftCount, count - leftCount, depth + 1);
+  }
+}
+
+/**
+ * Release the hierarchy.
+ */
+void BVH::clear()
+{
+  std::vector<Node>().swap(m_nodes);
+  std::vector<Triangle>().swap(m_triangles);
+  std::vector<unsigned int>().swap(m_triangleIds);
+  m_nodeCount = 0;
+}
+
+/**
+ * Find the closest triangle hit by the ray.
+ *
+ * @param[in]  ray - the query ray
+ * @param[out] hit - the closest hit, untouched on a miss
+ *
+ * @return true if a triangle was hit, false otherwise
+ */
+bool BVH::intersect(const Ray& ray, RayHit& hit) const
+{
+  if (m_nodeCount == 0)
+  {
+    return false;
+  }
+
+  const float o[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+  const float d[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+  const float inv[3] = { safeInverse(d[0]), safeInverse(d[1]), safeInverse(d[2]) };
+  const Node* pNodes = &m_nodes[0];
+
+  float tBest = ray.tMax;
+  unsigned int best = INVALID_INDEX;
+  float bestU = 0.0f, bestV = 0.0f;
+
+  if (intersectNode(pNodes[0], o, inv, ray.tMin, tBest) == FLT_MAX)
+  {
+    return false;
+  }
+
+  unsigned int stack[MAX_DEPTH + 1];
+  unsigned int stackSize = 0;
+  const Node* pNode = pNodes;
+
+  for (;;)
+  {
+    if (pNode->count > 0)
+    {
+      for (unsigned int i = 0; i < pNode->count; ++i)
+      {
+        const Triangle& tri = m_triangles[pNode->leftFirst + i];
+        float t, u, v;
+        if (intersectTriangle(tri.v0, tri.e1, tri.e2, o, d, ray.tMin, tBest, t, u, v))
+        {
+          tBest = t;
+          bestU = u;
+          bestV = v;
+          best = pNode->leftFirst + i;
+        }
+      }
+      if (stackSize == 0)
+      {
+        break;
+      }
+      pNode = &pNodes[stack[--stackSize]];
+      continue;
+    }
+
+    unsigned int nearChild = pNode->leftFirst;
+    unsigned int farChild  = nearChild + 1;
+    float dNear = intersectNode(pNodes[nearChild], o, inv, ray.tMin, tBest);
+    float dFar  = intersectNode(pNodes[farChild],  o, inv, ray.tMin, tBest);
+    if (dNear > dFar)
+    {
+      std::swap(dNear, dFar);
+      std::swap(nearChild, farChild);
+    }
+
+    if (dNear == FLT_MAX)
+    {
+      if (stackSize == 0)
+      {
+        break;
+      }
+      pNode = &pNodes[stack[--stackSize]];
+    }
+    else
+    {
+      pNode = &pNodes[nearChild];
+      if (dFar != FLT_MAX)
+      {
+        stack[stackSize++] = farChild;
+      }
+    }
+  }
+
+  if (best == INVALID_INDEX)
+  {
+    return false;
+  }
+
+  hit.t = tBest;
+  hit.u = bestU;
+  hit.v = bestV;
+  hit.triangle = m_triangleIds[best];
+  return true;
+}
+
+/**
+ * Check if the ray hits any triangle.
+ *
+ * Traversal stops at the first hit, which makes this cheaper than
+ * intersect() for shadow and line of sight rays.
+ *
+ * @param[in] ray - the query ray
+ *
+ * @return true if any triangle is hit within [tMin, tMax]
+ */
+bool BVH::occluded(const Ray& ray) const
+{
+  if (m_nodeCount == 0)
+  {
+    return false;
+  }
+
+  const float o[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+  const float d[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+  const float inv[3] = { safeInverse(d[0]), safeInverse(d[1]), safeInverse(d[2]) };
+  const Node* pNodes = &m_nodes[0];
+
+  unsigned int stack[MAX_DEPTH + 1];
+  unsigned int stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0)
+  {
+    const Node& node = pNodes[stack[--stackSize]];
+    if (intersectNode(node, o, inv, ray.tMin, ray.tMax) == FLT_MAX)
+    {
+      continue;
+    }
+
+    if (node.count > 0)
+    {
+      for (unsigned int i = 0; i < node.count; ++i)
+      {
+        const Triangle& tri = m_triangles[node.leftFirst + i];
+        float t, u, v;
+        if (intersectTriangle(tri.v0, tri.e1, tri.e2, o, d, ray.tMin, ray.tMax, t, u, v))
+        {
+          return true;
+        }
+      }
+    }
+    else
+    {
+      stack[stackSize++] = node.leftFirst + 1;
+      stack[stackSize++] = node.leftFirst;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Find the closest hits of up to PACKET_SIZE rays traversed together.
+ *
+ * Every node is fetched once for the whole packet and tested against all
+ * rays still active in it. This pays off for coherent rays such as camera
+ * rays of neighbouring pixels.
+ *
+ * @param[in]  pRays - the query rays
+ * @param[out] pHits - closest hit per ray, triangle is INVALID_INDEX on a miss
+ * @param[in]  count - number of rays, at most PACKET_SIZE
+ */
+void BVH::intersectPacket(const Ray* pRays, RayHit* pHits, size_t count) const
+{
+  if (count > PACKET_SIZE)
+  {
+    count = PACKET_SIZE;
+  }
+
+  float o[3][PACKET_SIZE], d[3][PACKET_SIZE], inv[3][PACKET_SIZE];
+  float tMin[PACKET_SIZE], tMax[PACKET_SIZE];
+  float hitU[PACKET_SIZE], hitV[PACKET_SIZE];
+  unsigned int hitTri[PACKET_SIZE];
+
+  for (size_t r = 0; r < PACKET_SIZE; ++r)
+  {
+    // Unused lanes get an empty interval so they never hit anything.
+    size_t src = r < count ? r : 0;
+    for (int k = 0; k < 3; ++k)
+    {
+      o[k][r] = pRays[src].origin.v[k];
+      d[k][r] = pRays[src].direction.v[k];
+      inv[k][r] = safeInverse(d[k][r]);
+    }
+    tMin[r] = r < count ? pRays[r].tMin : 1.0f;
+    tMax[r] = r < count ? pRays[r].tMax : 0.0f;
+    hitTri[r] = INVALID_INDEX;
+    hitU[r] = hitV[r] = 0.0f;
+  }
+
+  if (m_nodeCount > 0)
+  {
+    const Node* pNodes = &m_nodes[0];
+    unsigned int stack[MAX_DEPTH + 1];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+      const Node& node = pNodes[stack[--stackSize]];
+
+      float entry[PACKET_SIZE];
+      float nearest = FLT_MAX;
+      for (unsigned int r = 0; r < PACKET_SIZE; ++r)
+      {
+        float tx1 = (node.bmin[0] - o[0][r]) * inv[0][r];
+        float tx2 = (node.bmax[0] - o[0][r]) * inv[0][r];
+        float ty1 = (node.bmin[1] - o[1][r]) * inv[1][r];
+        float ty2 = (node.bmax[1] - o[1][r]) * inv[1][r];
+        float tz1 = (node.bmin[2] - o[2][r]) * inv[2][r];
+        float tz2 = (node.bmax[2] - o[2][r]) * inv[2][r];
+        float tNear = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)),
+                               std::max(std::min(tz1, tz2), tMin[r]));
+        float tFar  = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)),
+                               std::min(std::max(tz1, tz2), tMax[r]));
+        entry[r] = tNear <= tFar ? tNear : FLT_MAX;
+        nearest = std::min(nearest, entry[r]);
+      }
+
+      if (nearest == FLT_MAX)
+      {
+        continue;
+      }
+
+      if (node.count == 0)
+      {
+        stack[stackSize++] = node.leftFirst + 1;
+        stack[stackSize++] = node.leftFirst;
+        continue;
+      }
+
+      for (unsigned int i = 0; i < node.count; ++i)
+      {
+        const Triangle& tri = m_triangles[node.leftFirst + i];
+        for (unsigned int r = 0; r < PACKET_SIZE; ++r)
+        {
+          if (entry[r] == FLT_MAX)
+          {
+            continue;
+          }
+          const float ro[3] = { o[0][r], o[1][r], o[2][r] };
+          const float rd[3] = { d[0][r], d[1][r], d[2][r] };
+          float t, u, v;
+          if (intersectTriangle(tri.v0, tri.e1, tri.e2, ro, rd, tMin[r], tMax[r], t, u, v))
+          {
+            tMax[r] = t;
+            hitU[r] = u;
+            hitV[r] = v;
+            hitTri[r] = node.leftFirst + i;
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t r = 0; r < count; ++r)
+  {
+    pHits[r].t = tMax[r];
+    pHits[r].u = hitU[r];
+    pHits[r].v = hitV[r];
+    pHits[r].triangle = hitTri[r] != INVALID_INDEX ? m_triangleIds[hitTri[r]]
+                                                   : INVALID_INDEX;
+  }
+}
+
+/**
+ * Find the closest hits of a batch of rays.
+ *
+ * The rays are split into packets of PACKET_SIZE consecutive rays, so
+ * neighbouring rays should be coherent for the best performance.
+ *
+ * @param[in]  pRays - the query rays
+ * @param[out] pHits - closest hit per ray, triangle is INVALID_INDEX on a miss
+ * @param[in]  count - number of rays
+ * @param[in]  pPool - pool used to trace in parallel, or NULL
+ */
+void BVH::intersect(const Ray* pRays, RayHit* pHits, size_t count,
+                    ThreadPool* pPool) const
+{
+  size_t numPackets = (count + PACKET_SIZE - 1) / PACKET_SIZE;
+  ThreadPool::RangeTask trace = [=](size_t begin, size_t end) {
+    for (size_t p = begin; p < end; ++p)
+    {
+      size_t first = p * PACKET_SIZE;
+      size_t n = std::min<size_t>(PACKET_SIZE, count - first);
+      intersectPacket(pRays + first, pHits + first, n);
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, numPackets, 64, trace);
+  }
+  else
+  {
+    trace(0, numPackets);
+  }
+}
+
+/**
+ * Check a batch of rays for occlusion.
+ *
+ * @param[in]  pRays    - the query rays
+ * @param[out] pResults - true for every ray that hits a triangle
+ * @param[in]  count    - number of rays
+ * @param[in]  pPool    - pool used to trace in parallel, or NULL
+ */
+void BVH::occluded(const Ray* pRays, bool* pResults, size_t count,
+                   ThreadPool* pPool) const
+{
+  ThreadPool::RangeTask trace = [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      pResults[i] = occluded(pRays[i]);
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, 512, trace);
+  }
+  else
+  {
+    trace(0, count);
+  }
+}
+
+/**
+ * Obtain the bounds of the whole hierarchy.
+ *
+ * @return bounding box of all triangles, empty if nothing was built
+ */
+AABB BVH::getBounds() const
+{
+  if (m_nodeCount == 0)
+  {
+    return AABB();
+  }
+
+  const Node& root = m_nodes[0];
+  return AABB(Vector3f(root.bmin[0], root.bmin[1], root.bmin[2]),
+              Vector3f(root.bmax[0], root.bmax[1], root.bmax[2]));
+}
+
+/**
+ * Obtain the number of nodes, including the unused padding node.
+ *
+ * @return node count
+ */
+size_t BVH::getNodeCount() const
+{
+  return m_nodeCount;
+}
+
+/**
+ * Obtain the number of triangles in the hierarchy.
+ *
+ * @return triangle count
+ */
+size_t BVH::getTriangleCount() const
+{
+  return m_triangles.size();
+}
+
+/**
+ * Obtain the node array. The root is the first node.
+ *
+ * @return pointer to the nodes, NULL if nothing was built
+ */
+const BVH::Node* BVH::getNodes() const
+{
+  return m_nodeCount > 0 ? &m_nodes[0] : NULL;
+}
+
+}
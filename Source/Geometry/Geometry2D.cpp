@@ -0,0 +1,1107 @@
+/**
+ * @file Geometry2D.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the Geometry2D class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\Geometry2D.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <set>
+#include <utility>
+
+#if defined(LITE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+// Relative error of orient() evaluated in double, (3 + 16e)e with e = 2^-53.
+static const double ORIENT_BOUND = 3.3306690738754716e-16;
+
+// The same for float, with e = 2^-24, rounded up.
+static const float ORIENT_BOUND_FLOAT = 1.7881400e-7f;
+
+// Chunks of the convex hull per thread of the pool.
+static const size_t CHUNKS_PER_THREAD = 4;
+
+// Bands of the point in polygon test at most, and the index of unused lanes.
+static const size_t MAX_BANDS = 4096;
+static const unsigned int NO_EDGE = 0xFFFFFFFFu;
+
+// Set bits of four bit masks.
+static const int BIT_COUNTS[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+enum VertexType
+{
+  VERTEX_START,
+  VERTEX_END,
+  VERTEX_SPLIT,
+  VERTEX_MERGE,
+  VERTEX_REGULAR
+};
+
+/*
+ * Sum of two doubles and the rounding error of the sum (Knuth).
+ */
+static inline void twoSum(double a, double b, double& sum, double& error)
+{
+  sum = a + b;
+  double bVirtual = sum - a;
+  double aVirtual = sum - bVirtual;
+  error = (a - aVirtual) + (b - bVirtual);
+}
+
+/*
+ * Exact orientation. The product of two floats fits in a double, so the
+ * expanded determinant is a sum of six exact terms, which are accumulated
+ * into a nonoverlapping expansion. Its largest component has the sign of
+ * the sum and approximates it to double precision.
+ */
+static double orientExact(const Vector2f& a, const Vector2f& b, const Vector2f& c)
+{
+  double terms[6] =
+  {
+    (double) a.x * b.y, -((double) a.x * c.y), -((double) b.x * a.y),
+    (double) b.x * c.y, (double) c.x * a.y, -((double) c.x * b.y)
+  };
+
+  double expansion[6];
+  int size = 0;
+  for (int i = 0; i < 6; ++i)
+  {
+    double sum = terms[i];
+    int grown = 0;
+    for (int k = 0; k < size; ++k)
+    {
+      double error;
+      twoSum(sum, expansion[k], sum, error);
+      if (error != 0.0)
+      {
+        expansion[grown++] = error;
+      }
+    }
+    expansion[grown++] = sum;
+    size = grown;
+  }
+
+  for (int k = size - 1; k >= 0; --k)
+  {
+    if (expansion[k] != 0.0)
+    {
+      return expansion[k];
+    }
+  }
+  return 0.0;
+}
+
+/*
+ * Order of the points of the monotone chain, by x and then by y.
+ */
+static bool isBefore(const Vector2f& a, const Vector2f& b)
+{
+  return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+static bool isSame(const Vector2f& a, const Vector2f& b)
+{
+  return a.x == b.x && a.y == b.y;
+}
+
+/*
+ * Replace points with their convex hull, counterclockwise from the
+ * smallest point and without collinear points (Andrew's monotone chain).
+ */
+static void buildHull(std::vector<Vector2f>& points)
+{
+  std::sort(points.begin(), points.end(), isBefore);
+  points.erase(std::unique(points.begin(), points.end(), isSame), points.end());
+  size_t count = points.size();
+  if (count < 3)
+  {
+    return;
+  }
+
+  std::vector<Vector2f> hull(2 * count);
+  size_t size = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    while (size >= 2 && Geometry2D::orient(hull[size - 2], hull[size - 1], points[i]) <= 0.0)
+    {
+      --size;
+    }
+    hull[size++] = points[i];
+  }
+
+  size_t lowerSize = size + 1;
+  for (size_t i = count - 1; i-- > 0;)
+  {
+    while (size >= lowerSize &&
+           Geometry2D::orient(hull[size - 2], hull[size - 1], points[i]) <= 0.0)
+    {
+      --size;
+    }
+    hull[size++] = points[i];
+  }
+
+  // The upper chain ends at the first point again.
+  hull.resize(size - 1);
+  points.swap(hull);
+}
+
+/*
+ * Check whether a point is strictly inside the quadrilateral of the
+ * extreme points without calling the exact predicate; points it cannot
+ * tell are kept.
+ */
+static bool isInside(const Vector2f* pQuad, const Vector2f& point)
+{
+  for (int k = 0; k < 4; ++k)
+  {
+    const Vector2f& a = pQuad[k];
+    const Vector2f& b = pQuad[(k + 1) & 3];
+    double left = ((double) a.x - point.x) * ((double) b.y - point.y);
+    double right = ((double) a.y - point.y) * ((double) b.x - point.x);
+    if (left - right <= ORIENT_BOUND * (fabs(left) + fabs(right)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * Change of the winding number around a point crossing edge a b, +1 for
+ * upward edges passing right of the point and -1 for downward edges
+ * passing left of it (Sunday).
+ */
+static int getCrossing(const Vector2f& a, const Vector2f& b, const Vector2f& point)
+{
+  if (a.y <= point.y)
+  {
+    return b.y > point.y && Geometry2D::orient(a, b, point) > 0.0 ? 1 : 0;
+  }
+  return b.y <= point.y && Geometry2D::orient(a, b, point) < 0.0 ? -1 : 0;
+}
+
+/*
+ * Horizontal band of the point in polygon test holding a y coordinate.
+ */
+static size_t getBand(float y, float bottom, float scale, size_t bandCount)
+{
+  size_t band = (size_t) ((y - bottom) * scale);
+  return std::min(band, bandCount - 1);
+}
+
+/*
+ * Run a task over count items, split between the threads of the pool.
+ */
+static void run(const ThreadPool::RangeTask& task, size_t count, size_t grainSize,
+                ThreadPool* pPool)
+{
+  if (pPool != NULL && count > grainSize)
+  {
+    pPool->parallelFor(0, count, grainSize, task);
+  }
+  else
+  {
+    task(0, count);
+  }
+}
+
+/*
+ * Vertex a comes before vertex b when sweeping from top to bottom.
+ */
+static bool isAbove(const Vector2f& a, const Vector2f& b)
+{
+  return a.y > b.y || (a.y == b.y && a.x < b.x);
+}
+
+/*
+ * Vertices of a polygon walked counterclockwise, as indices into the
+ * caller's array.
+ */
+class Walk
+{
+public:
+  Walk(const Vector2f* pPolygon, size_t count)
+    : m_pPolygon(pPolygon)
+    , m_indices(count)
+  {
+    bool isReversed = Geometry2D::getSignedArea(pPolygon, count) < 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      m_indices[i] = (unsigned int) (isReversed ? count - 1 - i : i);
+    }
+  }
+
+  const Vector2f& operator [](size_t i) const
+  {
+    return m_pPolygon[m_indices[i]];
+  }
+
+  size_t getCount() const
+  {
+    return m_indices.size();
+  }
+
+  void addTriangle(size_t a, size_t b, size_t c, std::vector<unsigned int>& indices) const
+  {
+    if (Geometry2D::orient((*this)[a], (*this)[b], (*this)[c]) < 0.0)
+    {
+      std::swap(b, c);
+    }
+    indices.push_back(m_indices[a]);
+    indices.push_back(m_indices[b]);
+    indices.push_back(m_indices[c]);
+  }
+
+private:
+  const Vector2f*           m_pPolygon;
+  std::vector<unsigned int> m_indices;
+};
+
+/*
+ * Sweep line of the monotone partition. Edge i runs from vertex i to the
+ * next one, edge count stands for the vertex being looked up.
+ */
+struct Sweep
+{
+  const Walk* pWalk;
+  double      x;
+  double      y;
+
+  double getX(size_t edge) const
+  {
+    size_t count = pWalk->getCount();
+    if (edge == count)
+    {
+      return x;
+    }
+
+    const Vector2f& a = (*pWalk)[edge];
+    const Vector2f& b = (*pWalk)[edge + 1 == count ? 0 : edge + 1];
+    if (a.y == y)
+    {
+      return a.x;
+    }
+    if (b.y == y)
+    {
+      return b.x;
+    }
+    return a.x + (y - a.y) * ((double) b.x - a.x) / ((double) b.y - a.y);
+  }
+};
+
+/*
+ * Edges crossing the sweep line from left to right.
+ */
+struct EdgeLess
+{
+  const Sweep* pSweep;
+
+  bool operator ()(size_t left, size_t right) const
+  {
+    return pSweep->getX(left) < pSweep->getX(right);
+  }
+};
+
+/*
+ * Angular order of the neighbours of a vertex, counterclockwise from the
+ * positive x axis.
+ */
+struct AngleLess
+{
+  const Walk* pWalk;
+  Vector2f    center;
+
+  int getHalf(const Vector2f& point) const
+  {
+    return point.y < center.y || (point.y == center.y && point.x < center.x) ? 1 : 0;
+  }
+
+  bool operator ()(unsigned int left, unsigned int right) const
+  {
+    const Vector2f& a = (*pWalk)[left];
+    const Vector2f& b = (*pWalk)[right];
+    int leftHalf = getHalf(a), rightHalf = getHalf(b);
+    if (leftHalf != rightHalf)
+    {
+      return leftHalf < rightHalf;
+    }
+    return Geometry2D::orient(center, a, b) > 0.0;
+  }
+};
+
+/*
+ * Triangulate a y-monotone piece given counterclockwise, by walking both
+ * chains from the top with a stack of vertices not yet triangulated.
+ */
+static void triangulatePiece(const Walk& walk, const std::vector<unsigned int>& piece,
+                             std::vector<unsigned int>& order, std::vector<bool>& isLeft,
+                             std::vector<unsigned int>& stack,
+                             std::vector<unsigned int>& indices)
+{
+  size_t count = piece.size();
+  if (count < 3)
+  {
+    return;
+  }
+
+  size_t top = 0, bottom = 0;
+  for (size_t i = 1; i < count; ++i)
+  {
+    if (isAbove(walk[piece[i]], walk[piece[top]]))
+    {
+      top = i;
+    }
+    if (isAbove(walk[piece[bottom]], walk[piece[i]]))
+    {
+      bottom = i;
+    }
+  }
+
+  // Merge the left chain, forward from the top, with the right one.
+  order.clear();
+  isLeft.assign(count, false);
+  size_t left = top, right = (top + count - 1) % count;
+  while (order.size() < count)
+  {
+    bool isLeftNext = left != bottom &&
+                      (right == bottom || isAbove(walk[piece[left]], walk[piece[right]]));
+    if (left == bottom && right == bottom)
+    {
+      order.push_back(bottom);
+      break;
+    }
+    if (isLeftNext)
+    {
+      isLeft[left] = true;
+      order.push_back(left);
+      left = (left + 1) % count;
+    }
+    else
+    {
+      order.push_back(right);
+      right = (right + count - 1) % count;
+    }
+  }
+
+  stack.clear();
+  stack.push_back(order[0]);
+  stack.push_back(order[1]);
+  for (size_t j = 2; j + 1 < count; ++j)
+  {
+    unsigned int current = order[j];
+    if (isLeft[current] != isLeft[stack.back()])
+    {
+      for (size_t k = 0; k + 1 < stack.size(); ++k)
+      {
+        walk.addTriangle(piece[current], piece[stack[k]], piece[stack[k + 1]], indices);
+      }
+      unsigned int previous = stack.back();
+      stack.clear();
+      stack.push_back(previous);
+      stack.push_back(current);
+      continue;
+    }
+
+    unsigned int last = stack.back();
+    stack.pop_back();
+    while (!stack.empty())
+    {
+      double side = Geometry2D::orient(walk[piece[stack.back()]], walk[piece[last]],
+                                       walk[piece[current]]);
+      if (isLeft[current] ? side <= 0.0 : side >= 0.0)
+      {
+        break;
+      }
+      walk.addTriangle(piece[current], piece[last], piece[stack.back()], indices);
+      last = stack.back();
+      stack.pop_back();
+    }
+    stack.push_back(last);
+    stack.push_back(current);
+  }
+
+  unsigned int last = order[count - 1];
+  for (size_t k = 0; k + 1 < stack.size(); ++k)
+  {
+    walk.addTriangle(piece[last], piece[stack[k]], piece[stack[k + 1]], indices);
+  }
+}
+
+/**
+ * @brief Orientation of three points.
+ *
+ * @param[in] a - first point
+ * @param[in] b - second point
+ * @param[in] c - third point
+ *
+ * @return Positive if the points turn counterclockwise, negative if they
+ * turn clockwise and zero if they are collinear. The sign is exact and the
+ * value approximates twice the signed area of the triangle.
+ */
+double Geometry2D::orient(const Vector2f& a, const Vector2f& b, const Vector2f& c)
+{
+  double left = ((double) a.x - c.x) * ((double) b.y - c.y);
+  double right = ((double) a.y - c.y) * ((double) b.x - c.x);
+  double determinant = left - right;
+  double bound = ORIENT_BOUND * (fabs(left) + fabs(right));
+  if (determinant > bound || -determinant > bound)
+  {
+    return determinant;
+  }
+  return orientExact(a, b, c);
+}
+
+/**
+ * @brief Get the signed area of a polygon.
+ *
+ * @param[in] pPolygon - vertices of the polygon
+ * @param[in] count - number of vertices
+ *
+ * @return The area, positive for counterclockwise polygons.
+ */
+double Geometry2D::getSignedArea(const Vector2f* pPolygon, size_t count)
+{
+  double area = 0.0;
+  for (size_t i = 0, j = count - 1; i < count; j = i++)
+  {
+    area += (double) pPolygon[j].x * pPolygon[i].y - (double) pPolygon[i].x * pPolygon[j].y;
+  }
+  return area * 0.5;
+}
+
+/**
+ * @brief Compute the convex hull of a set of points.
+ *
+ * @param[in] pPoints - the points
+ * @param[in] count - number of points
+ * @param[out] hull - receives the hull counterclockwise, starting at the
+ * point with the smallest x, without collinear points
+ * @param[in] pPool - threads sharing the work, NULL to run on the caller
+ */
+void Geometry2D::convexHull(const Vector2f* pPoints, size_t count, std::vector<Vector2f>& hull,
+                            ThreadPool* pPool)
+{
+  LITE_PROFILE_ZONE("Geometry2D::convexHull");
+  hull.clear();
+  if (count == 0)
+  {
+    return;
+  }
+
+  size_t chunkCount = 1;
+  if (pPool != NULL && count >= 2 * POINT_GRAIN_SIZE)
+  {
+    chunkCount = std::min(count / POINT_GRAIN_SIZE,
+                          (size_t) pPool->getThreadCount() * CHUNKS_PER_THREAD);
+  }
+  size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+  // Leftmost, bottom, rightmost and top points of every chunk.
+  std::vector<size_t> extremes(chunkCount * 4);
+  ThreadPool::RangeTask findExtremes = [&](size_t begin, size_t end)
+  {
+    for (size_t chunk = begin; chunk < end; ++chunk)
+    {
+      size_t first = chunk * chunkSize, last = std::min(first + chunkSize, count);
+      size_t* pExtremes = &extremes[chunk * 4];
+      pExtremes[0] = pExtremes[1] = pExtremes[2] = pExtremes[3] = first;
+      for (size_t i = first + 1; i < last; ++i)
+      {
+        const Vector2f& point = pPoints[i];
+        pExtremes[0] = point.x < pPoints[pExtremes[0]].x ? i : pExtremes[0];
+        pExtremes[1] = point.y < pPoints[pExtremes[1]].y ? i : pExtremes[1];
+        pExtremes[2] = point.x > pPoints[pExtremes[2]].x ? i : pExtremes[2];
+        pExtremes[3] = point.y > pPoints[pExtremes[3]].y ? i : pExtremes[3];
+      }
+    }
+  };
+  run(findExtremes, chunkCount, 1, pPool);
+
+  Vector2f quad[4];
+  for (int k = 0; k < 4; ++k)
+  {
+    quad[k] = pPoints[extremes[k]];
+  }
+  for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+  {
+    const size_t* pExtremes = &extremes[chunk * 4];
+    quad[0] = pPoints[pExtremes[0]].x < quad[0].x ? pPoints[pExtremes[0]] : quad[0];
+    quad[1] = pPoints[pExtremes[1]].y < quad[1].y ? pPoints[pExtremes[1]] : quad[1];
+    quad[2] = pPoints[pExtremes[2]].x > quad[2].x ? pPoints[pExtremes[2]] : quad[2];
+    quad[3] = pPoints[pExtremes[3]].y > quad[3].y ? pPoints[pExtremes[3]] : quad[3];
+  }
+
+  // Hulls of the points of every chunk outside the quadrilateral.
+  std::vector<std::vector<Vector2f> > chunkHulls(chunkCount);
+  ThreadPool::RangeTask buildChunks = [&](size_t begin, size_t end)
+  {
+    for (size_t chunk = begin; chunk < end; ++chunk)
+    {
+      size_t first = chunk * chunkSize, last = std::min(first + chunkSize, count);
+      std::vector<Vector2f>& points = chunkHulls[chunk];
+      for (size_t i = first; i < last; ++i)
+      {
+        if (!isInside(quad, pPoints[i]))
+        {
+          points.push_back(pPoints[i]);
+        }
+      }
+      buildHull(points);
+    }
+  };
+  run(buildChunks, chunkCount, 1, pPool);
+
+  for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+  {
+    hull.insert(hull.end(), chunkHulls[chunk].begin(), chunkHulls[chunk].end());
+  }
+  buildHull(hull);
+  LITE_PROFILE_COUNTER("Geometry2D hull points", (double) hull.size());
+}
+
+/**
+ * @brief Triangulate a simple polygon, by ear clipping up to
+ * EAR_CLIPPING_LIMIT vertices and by a sweep line above.
+ *
+ * @param[in] pPolygon - vertices of the polygon
+ * @param[in] count - number of vertices
+ * @param[out] indices - receives count - 2 counterclockwise triangles
+ *
+ * @return True on success, false if the polygon is not simple.
+ */
+bool Geometry2D::triangulate(const Vector2f* pPolygon, size_t count,
+                             std::vector<unsigned int>& indices)
+{
+  if (count <= EAR_CLIPPING_LIMIT)
+  {
+    return triangulateEars(pPolygon, count, indices);
+  }
+  return triangulateMonotone(pPolygon, count, indices);
+}
+
+/**
+ * @brief Triangulate a simple polygon by clipping ears, in O(n^2).
+ *
+ * @param[in] pPolygon - vertices of the polygon
+ * @param[in] count - number of vertices
+ * @param[out] indices - receives count - 2 counterclockwise triangles
+ *
+ * @return True on success, false if no ear was left to clip.
+ */
+bool Geometry2D::triangulateEars(const Vector2f* pPolygon, size_t count,
+                                 std::vector<unsigned int>& indices)
+{
+  LITE_PROFILE_ZONE("Geometry2D::triangulateEars");
+  indices.clear();
+  if (count < 3)
+  {
+    return false;
+  }
+
+  Walk walk(pPolygon, count);
+  std::vector<size_t> previous(count), next(count);
+  std::vector<bool> isReflex(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    previous[i] = (i + count - 1) % count;
+    next[i] = (i + 1) % count;
+  }
+  for (size_t i = 0; i < count; ++i)
+  {
+    isReflex[i] = orient(walk[previous[i]], walk[i], walk[next[i]]) < 0.0;
+  }
+
+  indices.reserve((count - 2) * 3);
+  size_t remaining = count, current = 0, misses = 0;
+  while (remaining > 3)
+  {
+    size_t before = previous[current], after = next[current];
+    bool isEar = !isReflex[current];
+    for (size_t i = next[after]; isEar && i != before; i = next[i])
+    {
+      // Only reflex vertices can reach into the triangle of a convex one.
+      isEar = !isReflex[i] || orient(walk[before], walk[current], walk[i]) < 0.0 ||
+              orient(walk[current], walk[after], walk[i]) < 0.0 ||
+              orient(walk[after], walk[before], walk[i]) < 0.0;
+    }
+
+    if (!isEar)
+    {
+      current = after;
+      if (++misses > remaining)
+      {
+        return false;
+      }
+      continue;
+    }
+
+    walk.addTriangle(before, current, after, indices);
+    next[before] = after;
+    previous[after] = before;
+    isReflex[before] = orient(walk[previous[before]], walk[before], walk[after]) < 0.0;
+    isReflex[after] = orient(walk[before], walk[after], walk[next[after]]) < 0.0;
+    --remaining;
+    misses = 0;
+    current = after;
+  }
+  walk.addTriangle(previous[current], current, next[current], indices);
+  return true;
+}
+
+/**
+ * @brief Triangulate a simple polygon by splitting it into y-monotone
+ * pieces with a sweep line, in O(n log n).
+ *
+ * @param[in] pPolygon - vertices of the polygon
+ * @param[in] count - number of vertices
+ * @param[out] indices - receives count - 2 counterclockwise triangles
+ *
+ * @return True on success, false if the sweep found the polygon not simple.
+ */
+bool Geometry2D::triangulateMonotone(const Vector2f* pPolygon, size_t count,
+                                     std::vector<unsigned int>& indices)
+{
+  LITE_PROFILE_ZONE("Geometry2D::triangulateMonotone");
+  indices.clear();
+  if (count < 3)
+  {
+    return false;
+  }
+
+  Walk walk(pPolygon, count);
+  std::vector<unsigned int> events(count);
+  std::vector<unsigned char> types(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const Vector2f& before = walk[(i + count - 1) % count];
+    const Vector2f& after = walk[(i + 1) % count];
+    bool isConvex = orient(before, walk[i], after) > 0.0;
+    bool isBeforeBelow = isAbove(walk[i], before), isAfterBelow = isAbove(walk[i], after);
+    if (isBeforeBelow && isAfterBelow)
+    {
+      types[i] = (unsigned char) (isConvex ? VERTEX_START : VERTEX_SPLIT);
+    }
+    else if (!isBeforeBelow && !isAfterBelow)
+    {
+      types[i] = (unsigned char) (isConvex ? VERTEX_END : VERTEX_MERGE);
+    }
+    else
+    {
+      types[i] = VERTEX_REGULAR;
+    }
+    events[i] = (unsigned int) i;
+  }
+  std::sort(events.begin(), events.end(), [&](unsigned int a, unsigned int b)
+  {
+    return isAbove(walk[a], walk[b]) || (isSame(walk[a], walk[b]) && a < b);
+  });
+
+  // Edges with the polygon on their right and the vertex their diagonal
+  // would connect to, the lowest vertex seen between them and the next edge.
+  Sweep sweep = { &walk, 0.0, 0.0 };
+  EdgeLess less = { &sweep };
+  typedef std::set<size_t, EdgeLess> Status;
+  Status status(less);
+  std::vector<Status::iterator> locations(count, status.end());
+  std::vector<unsigned int> helpers(count);
+  std::vector<std::pair<unsigned int, unsigned int> > diagonals;
+
+  for (size_t e = 0; e < count; ++e)
+  {
+    unsigned int vertex = events[e];
+    unsigned int edgeBefore = (unsigned int) ((vertex + count - 1) % count);
+    sweep.x = walk[vertex].x;
+    sweep.y = walk[vertex].y;
+
+    bool isEdgeBeforeClosed = types[vertex] == VERTEX_END || types[vertex] == VERTEX_MERGE ||
+                              (types[vertex] == VERTEX_REGULAR &&
+                               isAbove(walk[edgeBefore], walk[vertex]));
+    if (isEdgeBeforeClosed)
+    {
+      if (locations[edgeBefore] == status.end())
+      {
+        return false;
+      }
+      if (types[helpers[edgeBefore]] == VERTEX_MERGE)
+      {
+        diagonals.push_back(std::make_pair(vertex, helpers[edgeBefore]));
+      }
+      status.erase(locations[edgeBefore]);
+      locations[edgeBefore] = status.end();
+    }
+
+    bool isLeftNeeded = types[vertex] == VERTEX_SPLIT || types[vertex] == VERTEX_MERGE ||
+                        (types[vertex] == VERTEX_REGULAR && !isEdgeBeforeClosed);
+    if (isLeftNeeded)
+    {
+      Status::iterator left = status.upper_bound(count);
+      if (left == status.begin())
+      {
+        return false;
+      }
+      --left;
+      if (types[vertex] == VERTEX_SPLIT || types[helpers[*left]] == VERTEX_MERGE)
+      {
+        diagonals.push_back(std::make_pair(vertex, helpers[*left]));
+      }
+      helpers[*left] = vertex;
+    }
+
+    bool isEdgeAfterOpened = types[vertex] == VERTEX_START || types[vertex] == VERTEX_SPLIT ||
+                             (types[vertex] == VERTEX_REGULAR && isEdgeBeforeClosed);
+    if (isEdgeAfterOpened)
+    {
+      std::pair<Status::iterator, bool> inserted = status.insert(vertex);
+      if (!inserted.second)
+      {
+        return false;
+      }
+      locations[vertex] = inserted.first;
+      helpers[vertex] = vertex;
+    }
+  }
+  LITE_PROFILE_COUNTER("Geometry2D diagonals", (double) diagonals.size());
+
+  // Neighbours of every vertex along edges and diagonals, by angle.
+  std::vector<unsigned int> offsets(count + 1, 2);
+  offsets[count] = 0;
+  for (size_t i = 0; i < diagonals.size(); ++i)
+  {
+    ++offsets[diagonals[i].first];
+    ++offsets[diagonals[i].second];
+  }
+  unsigned int total = 0;
+  for (size_t i = 0; i <= count; ++i)
+  {
+    unsigned int degree = offsets[i];
+    offsets[i] = total;
+    total += degree;
+  }
+  std::vector<unsigned int> neighbours(total), fill(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < count; ++i)
+  {
+    neighbours[fill[i]++] = (unsigned int) ((i + 1) % count);
+    neighbours[fill[i]++] = (unsigned int) ((i + count - 1) % count);
+  }
+  for (size_t i = 0; i < diagonals.size(); ++i)
+  {
+    neighbours[fill[diagonals[i].first]++] = diagonals[i].second;
+    neighbours[fill[diagonals[i].second]++] = diagonals[i].first;
+  }
+
+  // Half edges already walked, those from a vertex to the one before it
+  // bound the outside.
+  std::vector<bool> isWalked(total, false);
+  for (size_t i = 0; i < count; ++i)
+  {
+    AngleLess angleLess = { &walk, walk[i] };
+    std::sort(neighbours.begin() + offsets[i], neighbours.begin() + offsets[i + 1], angleLess);
+    unsigned int before = (unsigned int) ((i + count - 1) % count);
+    for (unsigned int k = offsets[i]; k < offsets[i + 1]; ++k)
+    {
+      isWalked[k] = isWalked[k] || neighbours[k] == before;
+    }
+  }
+
+  // Walk every piece keeping it on the left, turning as far as possible
+  // at each vertex, and triangulate it.
+  indices.reserve((count - 2) * 3);
+  std::vector<unsigned int> piece, order, stack;
+  std::vector<bool> isLeft;
+  for (size_t start = 0; start < count; ++start)
+  {
+    for (unsigned int k = offsets[start]; k < offsets[start + 1]; ++k)
+    {
+      if (isWalked[k])
+      {
+        continue;
+      }
+
+      piece.clear();
+      unsigned int vertex = (unsigned int) start, halfEdge = k;
+      while (!isWalked[halfEdge])
+      {
+        isWalked[halfEdge] = true;
+        piece.push_back(vertex);
+        unsigned int target = neighbours[halfEdge];
+        unsigned int first = offsets[target], degree = offsets[target + 1] - first;
+        unsigned int slot = 0;
+        while (slot < degree && neighbours[first + slot] != vertex)
+        {
+          ++slot;
+        }
+        halfEdge = first + (slot + degree - 1) % degree;
+        vertex = target;
+      }
+      triangulatePiece(walk, piece, order, isLeft, stack, indices);
+    }
+  }
+  return indices.size() == (count - 2) * 3;
+}
+
+/**
+ * @brief Clip a polygon with a convex polygon.
+ *
+ * @param[in] pPolygon - vertices of the polygon to clip
+ * @param[in] count - number of vertices
+ * @param[in] pConvex - vertices of the convex polygon, in either orientation
+ * @param[in] convexCount - number of vertices of the convex polygon
+ * @param[out] result - receives the part of the polygon inside the convex
+ * one, in the orientation of the polygon. Concave polygons cut into several
+ * parts come out joined along the boundary of the convex one.
+ */
+void Geometry2D::clip(const Vector2f* pPolygon, size_t count, const Vector2f* pConvex,
+                      size_t convexCount, std::vector<Vector2f>& result)
+{
+  LITE_PROFILE_ZONE("Geometry2D::clip");
+  result.clear();
+  if (count < 3 || convexCount < 3)
+  {
+    return;
+  }
+
+  result.assign(pPolygon, pPolygon + count);
+  double sign = getSignedArea(pConvex, convexCount) < 0.0 ? -1.0 : 1.0;
+  std::vector<Vector2f> input;
+  input.reserve(count);
+  for (size_t k = 0; k < convexCount && !result.empty(); ++k)
+  {
+    const Vector2f& a = pConvex[k];
+    const Vector2f& b = pConvex[k + 1 == convexCount ? 0 : k + 1];
+    input.swap(result);
+    result.clear();
+
+    Vector2f previous = input.back();
+    double previousSide = sign * orient(a, b, previous);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      const Vector2f& current = input[i];
+      double side = sign * orient(a, b, current);
+      if ((side < 0.0 && previousSide > 0.0) || (side > 0.0 && previousSide < 0.0))
+      {
+        double t = previousSide / (previousSide - side);
+        result.push_back(Vector2f((float) (previous.x + (current.x - (double) previous.x) * t),
+                                  (float) (previous.y + (current.y - (double) previous.y) * t)));
+      }
+      if (side >= 0.0)
+      {
+        result.push_back(current);
+      }
+      previous = current;
+      previousSide = side;
+    }
+  }
+
+  if (result.size() < 3)
+  {
+    result.clear();
+  }
+}
+
+/**
+ * @brief Check whether a point is inside a polygon by its winding number.
+ *
+ * @param[in] pPolygon - vertices of the polygon
+ * @param[in] count - number of vertices
+ * @param[in] point - the point
+ *
+ * @return True if the polygon winds around the point. Points on the
+ * boundary are inside on the left and bottom edges of the polygon.
+ */
+bool Geometry2D::pointInPolygon(const Vector2f* pPolygon, size_t count, const Vector2f& point)
+{
+  int winding = 0;
+  for (size_t i = 0, j = count - 1; i < count; j = i++)
+  {
+    winding += getCrossing(pPolygon[j], pPolygon[i], point);
+  }
+  return winding != 0;
+}
+
+/**
+ * @brief Check whether each of an array of points is inside a polygon.
+ *
+ * The edges are sorted into horizontal bands first, so every point is
+ * tested against the few edges overlapping its band only.
+ *
+ * @param[in] pPolygon - vertices of the polygon
+ * @param[in] count - number of vertices
+ * @param[in] pPoints - the points
+ * @param[in] pointCount - number of points
+ * @param[out] pInside - receives 1 for every point inside and 0 otherwise,
+ * as pointInPolygon() would
+ * @param[in] pPool - threads sharing the work, NULL to run on the caller
+ */
+void Geometry2D::pointsInPolygon(const Vector2f* pPolygon, size_t count, const Vector2f* pPoints,
+                                 size_t pointCount, unsigned char* pInside, ThreadPool* pPool)
+{
+  LITE_PROFILE_ZONE("Geometry2D::pointsInPolygon");
+  if (count == 0)
+  {
+    std::fill(pInside, pInside + pointCount, (unsigned char) 0);
+    return;
+  }
+
+  float bottom = pPolygon[0].y, top = bottom;
+  for (size_t i = 1; i < count; ++i)
+  {
+    bottom = std::min(bottom, pPolygon[i].y);
+    top = std::max(top, pPolygon[i].y);
+  }
+  size_t bandCount = std::min(std::max(count / 2, (size_t) 1), MAX_BANDS);
+  float scale = top > bottom ? bandCount / (top - bottom) : 0.0f;
+
+  // Count the edges overlapping every band, in groups of four.
+  std::vector<unsigned int> offsets(bandCount + 1, 0);
+  for (size_t i = 0, j = count - 1; i < count; j = i++)
+  {
+    size_t first = getBand(std::min(pPolygon[j].y, pPolygon[i].y), bottom, scale, bandCount);
+    size_t last = getBand(std::max(pPolygon[j].y, pPolygon[i].y), bottom, scale, bandCount);
+    for (size_t band = first; band <= last; ++band)
+    {
+      ++offsets[band];
+    }
+  }
+  unsigned int groupCount = 0;
+  for (size_t band = 0; band <= bandCount; ++band)
+  {
+    unsigned int groups = (offsets[band] + 3) / 4;
+    offsets[band] = groupCount;
+    groupCount += groups;
+  }
+
+  // A group holds the starts along x and y, the directions along x and the
+  // ends along y of its edges, then their indices. Unused lanes never cross.
+  std::vector<float> groups(groupCount * 16, 0.0f);
+  std::vector<unsigned int> edges(groupCount * 4, NO_EDGE);
+  std::vector<unsigned int> fill(bandCount);
+  for (size_t band = 0; band < bandCount; ++band)
+  {
+    fill[band] = offsets[band] * 4;
+  }
+  for (unsigned int group = 0; group < groupCount; ++group)
+  {
+    std::vector<float>::iterator pGroup = groups.begin() + group * 16;
+    std::fill(pGroup + 4, pGroup + 8, FLT_MAX);
+    std::fill(pGroup + 12, pGroup + 16, FLT_MAX);
+  }
+  for (size_t i = 0, j = count - 1; i < count; j = i++)
+  {
+    size_t first = getBand(std::min(pPolygon[j].y, pPolygon[i].y), bottom, scale, bandCount);
+    size_t last = getBand(std::max(pPolygon[j].y, pPolygon[i].y), bottom, scale, bandCount);
+    for (size_t band = first; band <= last; ++band)
+    {
+      unsigned int lane = fill[band]++;
+      float* pGroup = &groups[lane / 4 * 16 + lane % 4];
+      pGroup[0] = pPolygon[j].x;
+      pGroup[4] = pPolygon[j].y;
+      pGroup[8] = pPolygon[i].x - pPolygon[j].x;
+      pGroup[12] = pPolygon[i].y;
+      edges[lane] = (unsigned int) i;
+    }
+  }
+
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+#if defined(LITE_SSE2)
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 bound = _mm_set1_ps(ORIENT_BOUND_FLOAT);
+#endif
+    for (size_t i = begin; i < end; ++i)
+    {
+      const Vector2f& point = pPoints[i];
+      if (!(point.y >= bottom && point.y < top))
+      {
+        pInside[i] = 0;
+        continue;
+      }
+
+      size_t band = getBand(point.y, bottom, scale, bandCount);
+      int winding = 0;
+#if defined(LITE_SSE2)
+      __m128 x = _mm_set1_ps(point.x);
+      __m128 y = _mm_set1_ps(point.y);
+      for (unsigned int group = offsets[band]; group < offsets[band + 1]; ++group)
+      {
+        const float* pGroup = &groups[group * 16];
+        __m128 ay = _mm_loadu_ps(pGroup + 4);
+        __m128 by = _mm_loadu_ps(pGroup + 12);
+        __m128 up = _mm_and_ps(_mm_cmple_ps(ay, y), _mm_cmpgt_ps(by, y));
+        __m128 down = _mm_and_ps(_mm_cmpgt_ps(ay, y), _mm_cmple_ps(by, y));
+        int crossing = _mm_movemask_ps(_mm_or_ps(up, down));
+        if (crossing == 0)
+        {
+          continue;
+        }
+
+        // orient(a, b, point) in float with its error bound.
+        __m128 left = _mm_mul_ps(_mm_loadu_ps(pGroup + 8), _mm_sub_ps(y, ay));
+        __m128 right = _mm_mul_ps(_mm_sub_ps(x, _mm_loadu_ps(pGroup)), _mm_sub_ps(by, ay));
+        __m128 determinant = _mm_sub_ps(left, right);
+        __m128 error = _mm_mul_ps(bound, _mm_add_ps(_mm_andnot_ps(signMask, left),
+                                                    _mm_andnot_ps(signMask, right)));
+        int isPositive = _mm_movemask_ps(_mm_cmpgt_ps(determinant, error));
+        int isNegative = _mm_movemask_ps(_mm_cmpgt_ps(_mm_xor_ps(determinant, signMask), error));
+        winding += BIT_COUNTS[_mm_movemask_ps(up) & isPositive] -
+                   BIT_COUNTS[_mm_movemask_ps(down) & isNegative];
+
+        int uncertain = crossing & ~(isPositive | isNegative);
+        for (int lane = 0; uncertain != 0; ++lane, uncertain >>= 1)
+        {
+          if ((uncertain & 1) != 0)
+          {
+            unsigned int edge = edges[group * 4 + lane];
+            winding += getCrossing(pPolygon[edge == 0 ? count - 1 : edge - 1], pPolygon[edge],
+                                   point);
+          }
+        }
+      }
+#else
+      for (unsigned int slot = offsets[band] * 4; slot < offsets[band + 1] * 4; ++slot)
+      {
+        unsigned int edge = edges[slot];
+        if (edge != NO_EDGE)
+        {
+          winding += getCrossing(pPolygon[edge == 0 ? count - 1 : edge - 1], pPolygon[edge],
+                                 point);
+        }
+      }
+#endif
+      pInside[i] = winding != 0 ? 1 : 0;
+    }
+  };
+  run(task, pointCount, POINT_GRAIN_SIZE, pPool);
+  LITE_PROFILE_COUNTER("Geometry2D band edges", (double) groupCount * 4 / bandCount);
+}
+
+/**
+ * @brief Get the instruction set of pointsInPolygon().
+ *
+ * @return "SSE2" or "scalar".
+ */
+const char* Geometry2D::getInstructionSet()
+{
+#if defined(LITE_SSE2)
+  return "SSE2";
+#else
+  return "scalar";
+#endif
+}
+
+}
@@ -0,0 +1,411 @@
+/**
+ * @file KdTree.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the KdTree class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\KdTree.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace Lite
+{
+
+static const size_t PARALLEL_BUILD_SIZE = 32768;
+
+/*
+ * The k best candidates found so far, sorted by distance.
+ */
+struct KdTree::Neighbours
+{
+  unsigned int* pIndices;
+  float*        pDistancesSqr;
+  size_t        capacity;
+  size_t        size;
+
+  float worst() const
+  {
+    return size < capacity ? FLT_MAX : pDistancesSqr[size - 1];
+  }
+
+  void insert(unsigned int index, float distanceSqr)
+  {
+    size_t i = size < capacity ? size++ : capacity - 1;
+    while (i > 0 && pDistancesSqr[i - 1] > distanceSqr)
+    {
+      pDistancesSqr[i] = pDistancesSqr[i - 1];
+      pIndices[i] = pIndices[i - 1];
+      --i;
+    }
+    pDistancesSqr[i] = distanceSqr;
+    pIndices[i] = index;
+  }
+};
+
+/**
+ * Default constructor.
+ * Creates an empty tree.
+ */
+KdTree::KdTree()
+{
+}
+
+/**
+ * Destructor.
+ */
+KdTree::~KdTree()
+{
+}
+
+/**
+ * Build the tree over a set of points.
+ *
+ * The points are copied, query results refer to their index in pPoints.
+ *
+ * @param[in] pPoints - point positions
+ * @param[in] count   - number of points
+ * @param[in] pPool   - pool used to build subtrees in parallel, or NULL
+ */
+void KdTree::build(const Vector3f* pPoints, size_t count, ThreadPool* pPool)
+{
+  m_points.resize(count * 3);
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_points[i * 3 + 0] = pPoints[i].x;
+    m_points[i * 3 + 1] = pPoints[i].y;
+    m_points[i * 3 + 2] = pPoints[i].z;
+  }
+
+  m_ids.resize(count);
+  m_axes.assign(count, 0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_ids[i] = (unsigned int) i;
+  }
+
+  buildRange(0, count, pPool);
+
+  // Store the points in tree order so queries read them sequentially.
+  std::vector<float> ordered(count * 3);
+  for (size_t i = 0; i < count; ++i)
+  {
+    ordered[i * 3 + 0] = m_points[m_ids[i] * 3 + 0];
+    ordered[i * 3 + 1] = m_points[m_ids[i] * 3 + 1];
+    ordered[i * 3 + 2] = m_points[m_ids[i] * 3 + 2];
+  }
+  m_points.swap(ordered);
+}
+
+/**
+ * Build the tree over a set of 2D points.
+ *
+ * @param[in] pPoints - point positions
+ * @param[in] count   - number of points
+ * @param[in] pPool   - pool used to build subtrees in parallel, or NULL
+ */
+void KdTree::build(const Vector2f* pPoints, size_t count, ThreadPool* pPool)
+{
+  std::vector<Vector3f> points(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    points[i] = Vector3f(pPoints[i], 0.0f);
+  }
+  build(count > 0 ? &points[0] : NULL, count, pPool);
+}
+
+/**
+ * Remove all points from the tree.
+ */
+void KdTree::clear()
+{
+  m_points.clear();
+  m_ids.clear();
+  m_axes.clear();
+}
+
+void KdTree::buildRange(size_t begin, size_t end, ThreadPool* pPool)
+{
+  if (end - begin <= LEAF_SIZE)
+  {
+    return;
+  }
+
+  float bmin[3] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+  float bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+  for (size_t i = begin; i < end; ++i)
+  {
+    const float* p = &m_points[m_ids[i] * 3];
+    for (int k = 0; k < 3; ++k)
+    {
+      bmin[k] = std::min(bmin[k], p[k]);
+      bmax[k] = std::max(bmax[k], p[k]);
+    }
+  }
+
+  int axis = 0;
+  for (int k = 1; k < 3; ++k)
+  {
+    if (bmax[k] - bmin[k] > bmax[axis] - bmin[axis])
+    {
+      axis = k;
+    }
+  }
+
+  size_t mid = (begin + end) / 2;
+  const float* pCoords = &m_points[axis];
+  std::nth_element(m_ids.begin() + begin, m_ids.begin() + mid, m_ids.begin() + end,
+    [=](unsigned int a, unsigned int b) {
+      return pCoords[a * 3] < pCoords[b * 3];
+    });
+  m_axes[mid] = (unsigned char) axis;
+
+  if (pPool != NULL && end - begin >= PARALLEL_BUILD_SIZE)
+  {
+    pPool->parallelFor(0, 2, 1, [=](size_t first, size_t last) {
+      for (size_t c = first; c < last; ++c)
+      {
+        if (c == 0)
+        {
+          buildRange(begin, mid, pPool);
+        }
+        else
+        {
+          buildRange(mid + 1, end, pPool);
+        }
+      }
+    });
+  }
+  else
+  {
+    buildRange(begin, mid, pPool);
+    buildRange(mid + 1, end, pPool);
+  }
+}
+
+void KdTree::searchKNearest(size_t begin, size_t end, const float p[3],
+                            Neighbours& best) const
+{
+  if (end - begin <= LEAF_SIZE)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      const float* q = &m_points[i * 3];
+      float dx = q[0] - p[0];
+      float dy = q[1] - p[1];
+      float dz = q[2] - p[2];
+      float distSqr = dx * dx + dy * dy + dz * dz;
+      if (distSqr < best.worst())
+      {
+        best.insert(m_ids[i], distSqr);
+      }
+    }
+    return;
+  }
+
+  size_t mid = (begin + end) / 2;
+  const float* q = &m_points[mid * 3];
+  float dx = q[0] - p[0];
+  float dy = q[1] - p[1];
+  float dz = q[2] - p[2];
+  float distSqr = dx * dx + dy * dy + dz * dz;
+  if (distSqr < best.worst())
+  {
+    best.insert(m_ids[mid], distSqr);
+  }
+
+  int axis = m_axes[mid];
+  float diff = p[axis] - q[axis];
+  if (diff < 0.0f)
+  {
+    searchKNearest(begin, mid, p, best);
+    if (diff * diff < best.worst())
+    {
+      searchKNearest(mid + 1, end, p, best);
+    }
+  }
+  else
+  {
+    searchKNearest(mid + 1, end, p, best);
+    if (diff * diff < best.worst())
+    {
+      searchKNearest(begin, mid, p, best);
+    }
+  }
+}
+
+void KdTree::searchRadius(size_t begin, size_t end, const float c[3],
+                          float radiusSqr, std::vector<unsigned int>& results,
+                          size_t& found) const
+{
+  if (end - begin <= LEAF_SIZE)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      const float* q = &m_points[i * 3];
+      float dx = q[0] - c[0];
+      float dy = q[1] - c[1];
+      float dz = q[2] - c[2];
+      if (dx * dx + dy * dy + dz * dz <= radiusSqr)
+      {
+        results.push_back(m_ids[i]);
+        ++found;
+      }
+    }
+    return;
+  }
+
+  size_t mid = (begin + end) / 2;
+  const float* q = &m_points[mid * 3];
+  float dx = q[0] - c[0];
+  float dy = q[1] - c[1];
+  float dz = q[2] - c[2];
+  if (dx * dx + dy * dy + dz * dz <= radiusSqr)
+  {
+    results.push_back(m_ids[mid]);
+    ++found;
+  }
+
+  int axis = m_axes[mid];
+  float diff = c[axis] - q[axis];
+  if (diff <= 0.0f || diff * diff <= radiusSqr)
+  {
+    searchRadius(begin, mid, c, radiusSqr, results, found);
+  }
+  if (diff >= 0.0f || diff * diff <= radiusSqr)
+  {
+    searchRadius(mid + 1, end, c, radiusSqr, results, found);
+  }
+}
+
+/**
+ * Find the k points closest to point.
+ *
+ * @param[in]  point         - query position
+ * @param[in]  k             - number of neighbours to find
+ * @param[out] pIndices      - k slots for the indices of the neighbours,
+ *                             closest first
+ * @param[out] pDistancesSqr - k slots for the squared distances, may be NULL
+ *
+ * @return number of neighbours found, less than k if the tree is smaller
+ */
+size_t KdTree::queryKNearest(const Vector3f& point, size_t k,
+                             unsigned int* pIndices, float* pDistancesSqr) const
+{
+  if (k == 0 || m_ids.empty())
+  {
+    return 0;
+  }
+
+  float localDistances[64];
+  std::vector<float> manyDistances;
+  if (pDistancesSqr == NULL)
+  {
+    if (k > 64)
+    {
+      manyDistances.resize(k);
+      pDistancesSqr = &manyDistances[0];
+    }
+    else
+    {
+      pDistancesSqr = localDistances;
+    }
+  }
+
+  Neighbours best;
+  best.pIndices = pIndices;
+  best.pDistancesSqr = pDistancesSqr;
+  best.capacity = k;
+  best.size = 0;
+
+  const float p[3] = { point.x, point.y, point.z };
+  searchKNearest(0, m_ids.size(), p, best);
+  return best.size;
+}
+
+/**
+ * Find the k nearest neighbours of every query point.
+ *
+ * Query i writes its results to pIndices[i * k] and pDistancesSqr[i * k].
+ * Slots past the number of neighbours found are set to 0xFFFFFFFF and
+ * FLT_MAX.
+ *
+ * @param[in]  pPoints       - query positions
+ * @param[in]  count         - number of queries
+ * @param[in]  k             - number of neighbours per query
+ * @param[out] pIndices      - count * k neighbour indices
+ * @param[out] pDistancesSqr - count * k squared distances, may be NULL
+ * @param[in]  pPool         - pool used to run the queries in parallel, or
+ *                             NULL
+ */
+void KdTree::queryKNearest(const Vector3f* pPoints, size_t count, size_t k,
+                           unsigned int* pIndices, float* pDistancesSqr,
+                           ThreadPool* pPool) const
+{
+  ThreadPool::RangeTask query = [=](size_t begin, size_t end) {
+    for (size_t q = begin; q < end; ++q)
+    {
+      unsigned int* pOutIndices = pIndices + q * k;
+      float* pOutDistances = pDistancesSqr != NULL ? pDistancesSqr + q * k : NULL;
+      size_t found = queryKNearest(pPoints[q], k, pOutIndices, pOutDistances);
+      for (size_t i = found; i < k; ++i)
+      {
+        pOutIndices[i] = 0xFFFFFFFFu;
+        if (pOutDistances != NULL)
+        {
+          pOutDistances[i] = FLT_MAX;
+        }
+      }
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, 256, query);
+  }
+  else
+  {
+    query(0, count);
+  }
+}
+
+/**
+ * Find all points within radius of center.
+ *
+ * @param[in]  center  - query position
+ * @param[in]  radius  - query radius
+ * @param[out] results - indices of the points found are appended to it
+ *
+ * @return number of points found
+ */
+size_t KdTree::queryRadius(const Vector3f& center, float radius,
+                           std::vector<unsigned int>& results) const
+{
+  size_t found = 0;
+  if (!m_ids.empty())
+  {
+    const float c[3] = { center.x, center.y, center.z };
+    searchRadius(0, m_ids.size(), c, radius * radius, results, found);
+  }
+  return found;
+}
+
+/**
+ * Obtain the number of points in the tree.
+ *
+ * @return point count
+ */
+size_t KdTree::getPointCount() const
+{
+  return m_ids.size();
+}
+
+}
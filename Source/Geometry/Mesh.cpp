@@ -0,0 +1,249 @@
+/**
+ * @file Mesh.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the Mesh class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\Mesh.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace Lite
+{
+
+/*
+ * Position, texture coordinate and normal index of an OBJ face corner,
+ * zero based, -1 when missing.
+ */
+struct ObjCorner
+{
+  int position;
+  int uv;
+  int normal;
+
+  bool operator <(const ObjCorner& other) const
+  {
+    if (position != other.position)
+    {
+      return position < other.position;
+    }
+    if (uv != other.uv)
+    {
+      return uv < other.uv;
+    }
+    return normal < other.normal;
+  }
+};
+
+/*
+ * Convert a one based, possibly negative (relative) OBJ index.
+ */
+static int resolveObjIndex(int index, size_t count)
+{
+  if (index > 0)
+  {
+    return index - 1;
+  }
+  if (index < 0)
+  {
+    return (int) count + index;
+  }
+  return -1;
+}
+
+/**
+ * Default constructor.
+ * Creates an empty mesh.
+ */
+Mesh::Mesh()
+{
+}
+
+/**
+ * Destructor.
+ */
+Mesh::~Mesh()
+{
+}
+
+/**
+ * Load a Wavefront OBJ file.
+ *
+ * Polygons are triangulated as fans. Face corners sharing the same
+ * position, texture coordinate and normal become one vertex.
+ *
+ * @param[in] path - path to the .obj file
+ *
+ * @return true on success, false if the file could not be read or
+ *         references missing data
+ */
+bool Mesh::loadObj(const String& path)
+{
+  clear();
+
+  std::ifstream file(path.c_str());
+  if (!file)
+  {
+    return false;
+  }
+
+  std::vector<Vector3f> filePositions;
+  std::vector<Vector3f> fileNormals;
+  std::vector<Vector2f> fileUVs;
+  std::map<ObjCorner, unsigned int> vertices;
+  std::vector<unsigned int> face;
+  std::string line;
+  bool hasNormals = false, hasUVs = false;
+
+  while (std::getline(file, line))
+  {
+    std::istringstream stream(line);
+    std::string keyword;
+    stream >> keyword;
+
+    if (keyword == "v")
+    {
+      Vector3f p;
+      stream >> p.x >> p.y >> p.z;
+      filePositions.push_back(p);
+    }
+    else if (keyword == "vn")
+    {
+      Vector3f n;
+      stream >> n.x >> n.y >> n.z;
+      fileNormals.push_back(n);
+    }
+    else if (keyword == "vt")
+    {
+      Vector2f uv;
+      stream >> uv.x >> uv.y;
+      fileUVs.push_back(uv);
+    }
+    else if (keyword == "f")
+    {
+      face.clear();
+      std::string token;
+      while (stream >> token)
+      {
+        ObjCorner corner;
+        int p = 0, t = 0, n = 0;
+        if (sscanf(token.c_str(), "%d/%d/%d", &p, &t, &n) != 3 &&
+            sscanf(token.c_str(), "%d//%d", &p, &n) != 2 &&
+            sscanf(token.c_str(), "%d/%d", &p, &t) != 2 &&
+            sscanf(token.c_str(), "%d", &p) != 1)
+        {
+          clear();
+          return false;
+        }
+
+        corner.position = resolveObjIndex(p, filePositions.size());
+        corner.uv = resolveObjIndex(t, fileUVs.size());
+        corner.normal = resolveObjIndex(n, fileNormals.size());
+        if (corner.position < 0 || corner.position >= (int) filePositions.size() ||
+            corner.uv >= (int) fileUVs.size() ||
+            corner.normal >= (int) fileNormals.size())
+        {
+          clear();
+          return false;
+        }
+        hasUVs = hasUVs || corner.uv >= 0;
+        hasNormals = hasNormals || corner.normal >= 0;
+
+        std::map<ObjCorner, unsigned int>::iterator it = vertices.find(corner);
+        if (it == vertices.end())
+        {
+          unsigned int index = (unsigned int) positions.size();
+          vertices.insert(std::make_pair(corner, index));
+          positions.push_back(filePositions[corner.position]);
+          normals.push_back(corner.normal >= 0 ? fileNormals[corner.normal] : Vector3f());
+          uvs.push_back(corner.uv >= 0 ? fileUVs[corner.uv] : Vector2f());
+          face.push_back(index);
+        }
+        else
+        {
+          face.push_back(it->second);
+        }
+      }
+
+      for (size_t i = 2; i < face.size(); ++i)
+      {
+        indices.push_back(face[0]);
+        indices.push_back(face[i - 1]);
+        indices.push_back(face[i]);
+      }
+    }
+  }
+
+  if (!hasNormals)
+  {
+    normals.clear();
+  }
+  if (!hasUVs)
+  {
+    uvs.clear();
+  }
+  return true;
+}
+
+/**
+ * Remove all vertices and triangles.
+ */
+void Mesh::clear()
+{
+  positions.clear();
+  normals.clear();
+  uvs.clear();
+  indices.clear();
+}
+
+/**
+ * Check whether the mesh has one normal per position.
+ *
+ * @return true if normals are present
+ */
+bool Mesh::hasNormals() const
+{
+  return !normals.empty();
+}
+
+/**
+ * Check whether the mesh has one texture coordinate per position.
+ *
+ * @return true if texture coordinates are present
+ */
+bool Mesh::hasUVs() const
+{
+  return !uvs.empty();
+}
+
+/**
+ * Obtain the number of vertices.
+ *
+ * @return vertex count
+ */
+size_t Mesh::getVertexCount() const
+{
+  return positions.size();
+}
+
+/**
+ * Obtain the number of triangles.
+ *
+ * @return triangle count
+ */
+size_t Mesh::getTriangleCount() const
+{
+  return indices.size() / 3;
+}
+
+}
@@ -0,0 +1,357 @@
+/**
+ * @file MeshFile.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the MeshFile class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\MeshFile.h"
+#include "..\..\Include\LiteCube\Geometry\Mesh.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace Lite
+{
+
+static_assert(sizeof(Vector3f) == 3 * sizeof(float), "Vector3f must be tightly packed");
+static_assert(sizeof(Vector2f) == 2 * sizeof(float), "Vector2f must be tightly packed");
+static_assert(sizeof(unsigned int) == 4, "Indices are stored as 32 bit integers");
+
+static const char MAGIC[4] = { 'L', 'C', 'M', 'B' };
+static const unsigned int VERSION = 2;
+
+enum MeshFileFlags
+{
+  MF_NORMALS = 1,
+  MF_UVS     = 1 << 1
+};
+
+enum ChecksumState
+{
+  CHECKSUM_UNKNOWN = 0,
+  CHECKSUM_VALID   = 1,
+  CHECKSUM_INVALID = 2
+};
+
+/*
+ * On-disk header, 64 bytes. Offsets are from the start of the file.
+ */
+struct MeshFileHeader
+{
+  char               magic[4];
+  unsigned int       version;
+  unsigned int       flags;
+  unsigned int       vertexCount;
+  unsigned int       indexCount;
+  unsigned int       reserved;
+  unsigned long long checksum;
+  unsigned long long positionsOffset;
+  unsigned long long normalsOffset;
+  unsigned long long uvsOffset;
+  unsigned long long indicesOffset;
+};
+
+static_assert(sizeof(MeshFileHeader) <= MeshFile::SECTION_ALIGNMENT,
+              "The header must fit before the first section");
+
+static size_t alignSection(size_t offset)
+{
+  return (offset + MeshFile::SECTION_ALIGNMENT - 1) & ~(MeshFile::SECTION_ALIGNMENT - 1);
+}
+
+/*
+ * Add 32 bit words to the running sums of a Fletcher style checksum. The
+ * second sum makes it sensitive to the order of the words, not only to
+ * their values.
+ */
+static void addChecksumWords(const unsigned char* pData, size_t size,
+                             unsigned long long& a, unsigned long long& b)
+{
+  size_t words = size / 4;
+  for (size_t i = 0; i < words; ++i)
+  {
+    unsigned int word;
+    memcpy(&word, pData + i * 4, 4);
+    a += word;
+    b += a;
+  }
+}
+
+/*
+ * Checksum over the header, with its checksum field cleared, followed by
+ * the sections, so that corrupt counts and offsets are caught as well.
+ */
+static unsigned long long computeChecksum(const MeshFileHeader& header,
+                                          const unsigned char* pSections, size_t size)
+{
+  MeshFileHeader copy = header;
+  copy.checksum = 0;
+
+  unsigned long long a = 1, b = 0;
+  addChecksumWords((const unsigned char*) &copy, sizeof(copy), a, b);
+  addChecksumWords(pSections, size, a, b);
+  return a ^ (b << 32 | b >> 32);
+}
+
+/**
+ * Default constructor.
+ * No file is open until open() is called.
+ */
+MeshFile::MeshFile()
+  : m_checksumState(CHECKSUM_UNKNOWN)
+{
+}
+
+/**
+ * Destructor.
+ * Unmaps the file if it is open.
+ */
+MeshFile::~MeshFile()
+{
+}
+
+/**
+ * Map a mesh file and check its header.
+ *
+ * The section data is not read, see verify().
+ *
+ * @param[in] path - path to a file created with write()
+ *
+ * @return true on success, false if the file is missing, is not a mesh file
+ *         or its sections do not fit in the file
+ */
+bool MeshFile::open(const String& path)
+{
+  close();
+
+  if (!m_file.open(path) || m_file.getSize() < SECTION_ALIGNMENT)
+  {
+    m_file.close();
+    return false;
+  }
+
+  const unsigned char* pData = (const unsigned char*) m_file.getData();
+  size_t size = m_file.getSize();
+  MeshFileHeader header;
+  memcpy(&header, pData, sizeof(header));
+
+  unsigned long long vertices = header.vertexCount;
+  bool hasNormals = (header.flags & MF_NORMALS) != 0;
+  bool hasUVs = (header.flags & MF_UVS) != 0;
+  struct Section
+  {
+    unsigned long long offset;
+    unsigned long long bytes;
+  } sections[4] = {
+    { header.positionsOffset, vertices * sizeof(Vector3f) },
+    { header.normalsOffset,   hasNormals ? vertices * sizeof(Vector3f) : 0 },
+    { header.uvsOffset,       hasUVs ? vertices * sizeof(Vector2f) : 0 },
+    { header.indicesOffset,   (unsigned long long) header.indexCount * sizeof(unsigned int) }
+  };
+
+  bool isValid = memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header.version == VERSION;
+  for (int i = 0; i < 4 && isValid; ++i)
+  {
+    isValid = sections[i].offset % SECTION_ALIGNMENT == 0 &&
+              sections[i].offset >= SECTION_ALIGNMENT &&
+              sections[i].offset <= size &&
+              sections[i].bytes <= size - sections[i].offset;
+  }
+
+  if (!isValid)
+  {
+    m_file.close();
+    return false;
+  }
+
+  m_positions = Span<Vector3f>((const Vector3f*) (pData + header.positionsOffset),
+                               header.vertexCount);
+  if (hasNormals)
+  {
+    m_normals = Span<Vector3f>((const Vector3f*) (pData + header.normalsOffset),
+                               header.vertexCount);
+  }
+  if (hasUVs)
+  {
+    m_uvs = Span<Vector2f>((const Vector2f*) (pData + header.uvsOffset),
+                           header.vertexCount);
+  }
+  m_indices = Span<unsigned int>((const unsigned int*) (pData + header.indicesOffset),
+                                 header.indexCount);
+  return true;
+}
+
+/**
+ * Unmap the file. Spans obtained from the getters become invalid.
+ */
+void MeshFile::close()
+{
+  m_file.close();
+  m_positions = Span<Vector3f>();
+  m_normals = Span<Vector3f>();
+  m_uvs = Span<Vector2f>();
+  m_indices = Span<unsigned int>();
+  m_checksumState = CHECKSUM_UNKNOWN;
+}
+
+/**
+ * Check whether a file is open.
+ *
+ * @return true if open() succeeded and close() was not called since
+ */
+bool MeshFile::isOpen() const
+{
+  return m_file.isOpen();
+}
+
+/**
+ * Check the section data against the checksum stored in the header.
+ *
+ * The checksum covers the header and the sections. Indices are checked
+ * against the vertex count too, so that a file which passes can be drawn
+ * without further checks. The work is done on the first call only, later
+ * calls return the stored result. Not safe to call from several threads
+ * at once.
+ *
+ * @return true if the data is intact, false if it is corrupt, an index is
+ *         out of range or no file is open
+ */
+bool MeshFile::verify() const
+{
+  if (!m_file.isOpen())
+  {
+    return false;
+  }
+
+  if (m_checksumState == CHECKSUM_UNKNOWN)
+  {
+    const unsigned char* pData = (const unsigned char*) m_file.getData();
+    MeshFileHeader header;
+    memcpy(&header, pData, sizeof(header));
+    unsigned long long checksum = computeChecksum(header, pData + SECTION_ALIGNMENT,
+                                                  m_file.getSize() - SECTION_ALIGNMENT);
+    bool isValid = checksum == header.checksum;
+    for (size_t i = 0; i < m_indices.size() && isValid; ++i)
+    {
+      isValid = m_indices[i] < header.vertexCount;
+    }
+    m_checksumState = isValid ? CHECKSUM_VALID : CHECKSUM_INVALID;
+  }
+
+  return m_checksumState == CHECKSUM_VALID;
+}
+
+/**
+ * Obtain the vertex positions.
+ *
+ * @return span over the mapped file, empty if no file is open
+ */
+Span<Vector3f> MeshFile::getPositions() const
+{
+  return m_positions;
+}
+
+/**
+ * Obtain the vertex normals.
+ *
+ * @return span over the mapped file, empty if the mesh has no normals
+ */
+Span<Vector3f> MeshFile::getNormals() const
+{
+  return m_normals;
+}
+
+/**
+ * Obtain the vertex texture coordinates.
+ *
+ * @return span over the mapped file, empty if the mesh has no texture
+ *         coordinates
+ */
+Span<Vector2f> MeshFile::getUVs() const
+{
+  return m_uvs;
+}
+
+/**
+ * Obtain the triangle indices.
+ *
+ * @return span over the mapped file, three indices per triangle
+ */
+Span<unsigned int> MeshFile::getIndices() const
+{
+  return m_indices;
+}
+
+/**
+ * Write a mesh in the binary format.
+ *
+ * @param[in] path - path of the file to create or overwrite
+ * @param[in] mesh - the mesh to store
+ *
+ * @return true on success, false if the file could not be written
+ */
+bool MeshFile::write(const String& path, const Mesh& mesh)
+{
+  size_t vertexCount = mesh.getVertexCount();
+  bool hasNormals = mesh.hasNormals() && mesh.normals.size() == vertexCount;
+  bool hasUVs = mesh.hasUVs() && mesh.uvs.size() == vertexCount;
+
+  MeshFileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.flags = (hasNormals ? MF_NORMALS : 0) | (hasUVs ? MF_UVS : 0);
+  header.vertexCount = (unsigned int) vertexCount;
+  header.indexCount = (unsigned int) mesh.indices.size();
+
+  size_t offset = SECTION_ALIGNMENT;
+  header.positionsOffset = offset;
+  offset = alignSection(offset + vertexCount * sizeof(Vector3f));
+  header.normalsOffset = offset;
+  offset = alignSection(offset + (hasNormals ? vertexCount * sizeof(Vector3f) : 0));
+  header.uvsOffset = offset;
+  offset = alignSection(offset + (hasUVs ? vertexCount * sizeof(Vector2f) : 0));
+  header.indicesOffset = offset;
+  offset = alignSection(offset + mesh.indices.size() * sizeof(unsigned int));
+
+  std::vector<unsigned char> data(offset, 0);
+  if (vertexCount > 0)
+  {
+    memcpy(&data[header.positionsOffset], &mesh.positions[0], vertexCount * sizeof(Vector3f));
+    if (hasNormals)
+    {
+      memcpy(&data[header.normalsOffset], &mesh.normals[0], vertexCount * sizeof(Vector3f));
+    }
+    if (hasUVs)
+    {
+      memcpy(&data[header.uvsOffset], &mesh.uvs[0], vertexCount * sizeof(Vector2f));
+    }
+  }
+  if (!mesh.indices.empty())
+  {
+    memcpy(&data[header.indicesOffset], &mesh.indices[0],
+           mesh.indices.size() * sizeof(unsigned int));
+  }
+
+  header.checksum = computeChecksum(header, &data[SECTION_ALIGNMENT], offset - SECTION_ALIGNMENT);
+  memcpy(&data[0], &header, sizeof(header));
+
+  std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+  if (!file)
+  {
+    return false;
+  }
+  file.write((const char*) &data[0], (std::streamsize) data.size());
+  return file.good();
+}
+
+}
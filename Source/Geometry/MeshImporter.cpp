@@ -0,0 +1,1294 @@
+/**
+ * @file MeshImporter.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the MeshImporter class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\MeshImporter.h"
+#include "..\..\Include\LiteCube\Geometry\Mesh.h"
+#include "..\..\Include\LiteCube\Core\MappedFile.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace Lite
+{
+
+static const size_t MIN_CHUNK_SIZE = 4096;
+static const unsigned int EMPTY_SLOT = 0xFFFFFFFFu;
+static const size_t VERTEX_GRAIN_SIZE = 16384;
+
+/*
+ * Number parsing. Unlike strtod() and streams these ignore the C locale,
+ * so a decimal comma setting cannot break the import, and they parse
+ * straight from the mapped file without a terminating zero.
+ */
+static const double POWERS_OF_TEN[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline const char* skipSpaces(const char* p, const char* end)
+{
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+  {
+    ++p;
+  }
+  return p;
+}
+
+static inline bool isDigit(char c)
+{
+  return (unsigned char) (c - '0') < 10;
+}
+
+/*
+ * Parse a decimal floating point number. Returns the position after the
+ * number, or NULL if there is none.
+ */
+static const char* parseFloat(const char* p, const char* end, float& value)
+{
+  bool isNegative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+  {
+    isNegative = *p == '-';
+    ++p;
+  }
+
+  // Up to 19 significant digits fit in the mantissa, the rest only scale it.
+  unsigned long long mantissa = 0;
+  int digits = 0, exponent = 0;
+  bool hasDigits = false;
+  while (p < end && isDigit(*p))
+  {
+    if (digits < 19)
+    {
+      mantissa = mantissa * 10 + (*p - '0');
+      digits += mantissa != 0;
+    }
+    else
+    {
+      ++exponent;
+    }
+    hasDigits = true;
+    ++p;
+  }
+
+  if (p < end && *p == '.')
+  {
+    ++p;
+    while (p < end && isDigit(*p))
+    {
+      if (digits < 19)
+      {
+        mantissa = mantissa * 10 + (*p - '0');
+        digits += mantissa != 0;
+        --exponent;
+      }
+      hasDigits = true;
+      ++p;
+    }
+  }
+
+  if (!hasDigits)
+  {
+    return NULL;
+  }
+
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    const char* q = p + 1;
+    bool isExponentNegative = false;
+    if (q < end && (*q == '-' || *q == '+'))
+    {
+      isExponentNegative = *q == '-';
+      ++q;
+    }
+    if (q < end && isDigit(*q))
+    {
+      int e = 0;
+      while (q < end && isDigit(*q))
+      {
+        e = e < 10000 ? e * 10 + (*q - '0') : e;
+        ++q;
+      }
+      exponent += isExponentNegative ? -e : e;
+      p = q;
+    }
+  }
+
+  double result = (double) mantissa;
+  if (mantissa != 0 && exponent != 0)
+  {
+    if (exponent > 0 && exponent <= 22)
+    {
+      result *= POWERS_OF_TEN[exponent];
+    }
+    else if (exponent < 0 && exponent >= -22)
+    {
+      result /= POWERS_OF_TEN[-exponent];
+    }
+    else
+    {
+      result *= pow(10.0, exponent);
+    }
+  }
+
+  value = (float) (isNegative ? -result : result);
+  return p;
+}
+
+/*
+ * Parse a decimal integer. Returns the position after the number, or NULL
+ * if there is none.
+ */
+static const char* parseInt(const char* p, const char* end, long long& value)
+{
+  bool isNegative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+  {
+    isNegative = *p == '-';
+    ++p;
+  }
+
+  if (p >= end || !isDigit(*p))
+  {
+    return NULL;
+  }
+
+  long long result = 0;
+  while (p < end && isDigit(*p))
+  {
+    result = result < 0x7FFFFFFFFFFFLL ? result * 10 + (*p - '0') : result;
+    ++p;
+  }
+
+  value = isNegative ? -result : result;
+  return p;
+}
+
+static inline const char* findLineEnd(const char* p, const char* end)
+{
+  const char* pLineEnd = (const char*) memchr(p, '\n', end - p);
+  return pLineEnd != NULL ? pLineEnd : end;
+}
+
+/*
+ * Parse the lines of one OBJ chunk. Indices are converted to zero based,
+ * negative (relative) indices are resolved against the counts within the
+ * chunk and listed in relativeIndices so that the merge can add the counts
+ * of the preceding chunks.
+ */
+static void parseObjChunk(const char* p, const char* end,
+                          std::vector<float>& positions, std::vector<float>& normals,
+                          std::vector<float>& uvs, std::vector<int>& corners,
+                          std::vector<size_t>& relativeIndices, bool& isValid)
+{
+  int face[3 * 64];
+  unsigned char relative[64];
+  isValid = true;
+
+  while (p < end && isValid)
+  {
+    const char* pLineEnd = findLineEnd(p, end);
+    const char* q = skipSpaces(p, pLineEnd);
+    p = pLineEnd + 1;
+
+    if (pLineEnd - q < 2)
+    {
+      continue;
+    }
+
+    if (q[0] == 'v')
+    {
+      std::vector<float>* pTarget;
+      int components;
+      if (q[1] == ' ' || q[1] == '\t')
+      {
+        pTarget = &positions;
+        components = 3;
+        q += 1;
+      }
+      else if (q[1] == 'n')
+      {
+        pTarget = &normals;
+        components = 3;
+        q += 2;
+      }
+      else if (q[1] == 't')
+      {
+        pTarget = &uvs;
+        components = 2;
+        q += 2;
+      }
+      else
+      {
+        continue;
+      }
+
+      for (int c = 0; c < components; ++c)
+      {
+        float value = 0.0f;
+        const char* pNext = parseFloat(skipSpaces(q, pLineEnd), pLineEnd, value);
+        if (pNext == NULL)
+        {
+          // A texture coordinate may omit v.
+          isValid = pTarget == &uvs && c == 1;
+          if (!isValid)
+          {
+            break;
+          }
+        }
+        else
+        {
+          q = pNext;
+        }
+        pTarget->push_back(value);
+      }
+    }
+    else if (q[0] == 'f' && (q[1] == ' ' || q[1] == '\t'))
+    {
+      int count = 0;
+      int attributeCounts[3] = {
+        (int) (positions.size() / 3), (int) (uvs.size() / 2), (int) (normals.size() / 3)
+      };
+      q = skipSpaces(q + 1, pLineEnd);
+      while (q < pLineEnd && isValid)
+      {
+        if (count == 64)
+        {
+          isValid = false;
+          break;
+        }
+
+        int* pCorner = &face[count * 3];
+        relative[count] = 0;
+        pCorner[0] = pCorner[1] = pCorner[2] = -1;
+        for (int a = 0; a < 3; ++a)
+        {
+          long long index;
+          const char* pNext = parseInt(q, pLineEnd, index);
+          if (pNext != NULL)
+          {
+            q = pNext;
+            // Indices that do not fit an int are out of range of any mesh.
+            if (index > 0 && index <= INT_MAX)
+            {
+              pCorner[a] = (int) (index - 1);
+            }
+            else if (index < 0 && index >= -INT_MAX)
+            {
+              pCorner[a] = (int) (attributeCounts[a] + index);
+              relative[count] |= (unsigned char) (1 << a);
+            }
+            else
+            {
+              isValid = false;
+            }
+          }
+          else if (a == 0)
+          {
+            isValid = false;
+          }
+
+          if (a < 2 && q < pLineEnd && *q == '/')
+          {
+            ++q;
+          }
+          else
+          {
+            break;
+          }
+        }
+        ++count;
+        q = skipSpaces(q, pLineEnd);
+      }
+
+      // Fan triangulation.
+      for (int i = 2; i < count && isValid; ++i)
+      {
+        const int fan[3] = { 0, i - 1, i };
+        for (int k = 0; k < 3; ++k)
+        {
+          size_t base = corners.size();
+          corners.insert(corners.end(), face + fan[k] * 3, face + fan[k] * 3 + 3);
+          for (int a = 0; a < 3; ++a)
+          {
+            if (relative[fan[k]] & (1 << a))
+            {
+              relativeIndices.push_back(base + a);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Default constructor.
+ * Uses chunks of DEFAULT_CHUNK_SIZE bytes.
+ */
+MeshImporter::MeshImporter()
+  : m_chunkSize(DEFAULT_CHUNK_SIZE)
+  , m_vertexCount(0)
+  , m_hasNormals(false)
+  , m_hasUVs(false)
+{
+}
+
+/**
+ * Destructor.
+ */
+MeshImporter::~MeshImporter()
+{
+}
+
+/**
+ * Set the number of bytes parsed by one task.
+ *
+ * Larger chunks lower the scheduling overhead, smaller ones balance better
+ * and lower the memory used while importing OBJ files.
+ *
+ * @param[in] bytes - chunk size, at least 4 KiB
+ */
+void MeshImporter::setChunkSize(size_t bytes)
+{
+  m_chunkSize = bytes < MIN_CHUNK_SIZE ? MIN_CHUNK_SIZE : bytes;
+}
+
+/**
+ * Obtain the number of bytes parsed by one task.
+ *
+ * @return chunk size in bytes
+ */
+size_t MeshImporter::getChunkSize() const
+{
+  return m_chunkSize;
+}
+
+/**
+ * Import an OBJ or PLY file, chosen by the file extension.
+ *
+ * @param[in]  path  - path to a .obj or .ply file
+ * @param[out] mesh  - receives the mesh
+ * @param[in]  pPool - pool used to parse chunks in parallel, or NULL
+ *
+ * @return true on success, false if the file could not be read or parsed
+ */
+bool MeshImporter::importFile(const String& path, Mesh& mesh, ThreadPool* pPool)
+{
+  size_t dot = path.rfind('.');
+  if (dot != String::npos && path.size() - dot == 4 &&
+      (path[dot + 1] == 'p' || path[dot + 1] == 'P') &&
+      (path[dot + 2] == 'l' || path[dot + 2] == 'L') &&
+      (path[dot + 3] == 'y' || path[dot + 3] == 'Y'))
+  {
+    return importPly(path, mesh, pPool);
+  }
+  return importObj(path, mesh, pPool);
+}
+
+/**
+ * Import a Wavefront OBJ file.
+ *
+ * @param[in]  path  - path to the .obj file
+ * @param[out] mesh  - receives the mesh
+ * @param[in]  pPool - pool used to parse chunks in parallel, or NULL
+ *
+ * @return true on success, false if the file could not be read or parsed
+ */
+bool MeshImporter::importObj(const String& path, Mesh& mesh, ThreadPool* pPool)
+{
+  MappedFile file;
+  if (!file.open(path))
+  {
+    mesh.clear();
+    return false;
+  }
+  return parseObj((const char*) file.getData(), file.getSize(), mesh, pPool);
+}
+
+/**
+ * Import a PLY file.
+ *
+ * @param[in]  path  - path to the .ply file
+ * @param[out] mesh  - receives the mesh
+ * @param[in]  pPool - pool used to parse chunks in parallel, or NULL
+ *
+ * @return true on success, false if the file could not be read or parsed
+ */
+bool MeshImporter::importPly(const String& path, Mesh& mesh, ThreadPool* pPool)
+{
+  MappedFile file;
+  if (!file.open(path))
+  {
+    mesh.clear();
+    return false;
+  }
+  return parsePly((const char*) file.getData(), file.getSize(), mesh, pPool);
+}
+
+/*
+ * Compute the bounds of chunkCount chunks starting at begin, which must be
+ * the start of a line. Every bound is moved forward to the next line start.
+ */
+void MeshImporter::splitLines(const char* pData, size_t size, size_t begin,
+                              size_t chunkCount, std::vector<size_t>& bounds) const
+{
+  bounds.resize(chunkCount + 1);
+  bounds[0] = begin;
+  for (size_t i = 1; i <= chunkCount; ++i)
+  {
+    size_t offset = begin + i * m_chunkSize;
+    if (offset >= size)
+    {
+      bounds[i] = size;
+      continue;
+    }
+
+    offset = std::max(offset, bounds[i - 1]);
+    if (offset == 0 || pData[offset - 1] == '\n')
+    {
+      bounds[i] = offset;
+      continue;
+    }
+    const char* pNewLine = (const char*) memchr(pData + offset, '\n', size - offset);
+    bounds[i] = pNewLine != NULL ? pNewLine - pData + 1 : size;
+  }
+}
+
+/**
+ * Parse Wavefront OBJ text.
+ *
+ * The file is parsed one window of chunks at a time. While the chunks of a
+ * window are merged into the mesh, the pool already parses the next window.
+ *
+ * @param[in]  pData - the file contents
+ * @param[in]  size  - size of the contents in bytes
+ * @param[out] mesh  - receives the mesh
+ * @param[in]  pPool - pool used to parse chunks in parallel, or NULL
+ *
+ * @return true on success, false on a syntax error or an index out of range
+ */
+bool MeshImporter::parseObj(const char* pData, size_t size, Mesh& mesh, ThreadPool* pPool)
+{
+  mesh.clear();
+  m_positions.clear();
+  m_normals.clear();
+  m_uvs.clear();
+  m_vertexTable.assign(1024, VertexSlot());
+  for (size_t i = 0; i < m_vertexTable.size(); ++i)
+  {
+    m_vertexTable[i].vertex = EMPTY_SLOT;
+  }
+  m_vertexCount = 0;
+  m_hasNormals = false;
+  m_hasUVs = false;
+
+  size_t windowChunks = pPool != NULL ? pPool->getThreadCount() * 2 : 1;
+  std::vector<ObjChunk> windows[2];
+  std::vector<size_t> bounds[2];
+  windows[0].resize(windowChunks);
+  windows[1].resize(windowChunks);
+
+  ThreadPool::RangeTask parseTasks[2];
+  for (int w = 0; w < 2; ++w)
+  {
+    std::vector<ObjChunk>* pChunks = &windows[w];
+    std::vector<size_t>* pBounds = &bounds[w];
+    parseTasks[w] = [=](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c)
+      {
+        ObjChunk& chunk = (*pChunks)[c];
+        chunk.positions.clear();
+        chunk.normals.clear();
+        chunk.uvs.clear();
+        chunk.corners.clear();
+        chunk.relativeIndices.clear();
+        parseObjChunk(pData + (*pBounds)[c], pData + (*pBounds)[c + 1],
+                      chunk.positions, chunk.normals, chunk.uvs, chunk.corners,
+                      chunk.relativeIndices, chunk.isValid);
+      }
+    };
+  }
+
+  size_t offset = 0;
+  int current = 0;
+  splitLines(pData, size, offset, windowChunks, bounds[current]);
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, windowChunks, 1, parseTasks[current]);
+  }
+  else
+  {
+    parseTasks[current](0, windowChunks);
+  }
+
+  bool isValid = true;
+  while (true)
+  {
+    offset = bounds[current].back();
+    bool hasNext = offset < size;
+    int next = 1 - current;
+    std::atomic<bool> isNextParsed(false);
+
+    if (hasNext)
+    {
+      splitLines(pData, size, offset, windowChunks, bounds[next]);
+      if (pPool != NULL)
+      {
+        ThreadPool::RangeTask& task = parseTasks[next];
+        pPool->enqueue([pPool, &task, windowChunks, &isNextParsed]() {
+          pPool->parallelFor(0, windowChunks, 1, task);
+          isNextParsed = true;
+        });
+      }
+    }
+
+    for (size_t c = 0; c < windowChunks && isValid; ++c)
+    {
+      ObjChunk& chunk = windows[current][c];
+      isValid = chunk.isValid && mergeObjChunk(chunk, mesh);
+    }
+
+    if (hasNext)
+    {
+      if (pPool != NULL)
+      {
+        while (!isNextParsed)
+        {
+          if (!pPool->runPendingTask())
+          {
+            std::this_thread::yield();
+          }
+        }
+      }
+      else if (isValid)
+      {
+        parseTasks[next](0, windowChunks);
+      }
+    }
+
+    if (!hasNext || !isValid)
+    {
+      break;
+    }
+    current = next;
+  }
+
+  m_positions.clear();
+  m_normals.clear();
+  m_uvs.clear();
+  m_vertexTable.clear();
+
+  if (!isValid)
+  {
+    mesh.clear();
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Append the attributes of a chunk to the file attributes and turn its face
+ * corners into indexed vertices.
+ */
+bool MeshImporter::mergeObjChunk(ObjChunk& chunk, Mesh& mesh)
+{
+  int bases[3] = {
+    (int) (m_positions.size() / 3), (int) (m_uvs.size() / 2), (int) (m_normals.size() / 3)
+  };
+  m_positions.insert(m_positions.end(), chunk.positions.begin(), chunk.positions.end());
+  m_uvs.insert(m_uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+  m_normals.insert(m_normals.end(), chunk.normals.begin(), chunk.normals.end());
+
+  // A relative index may point before the preceding chunks, which must not be
+  // mistaken for a missing attribute (-1).
+  for (size_t i = 0; i < chunk.relativeIndices.size(); ++i)
+  {
+    size_t field = chunk.relativeIndices[i];
+    chunk.corners[field] += bases[field % 3];
+    if (chunk.corners[field] < 0)
+    {
+      return false;
+    }
+  }
+
+  int counts[3] = {
+    (int) (m_positions.size() / 3), (int) (m_uvs.size() / 2), (int) (m_normals.size() / 3)
+  };
+  for (size_t i = 0; i + 2 < chunk.corners.size(); i += 3)
+  {
+    Corner corner;
+    corner.position = chunk.corners[i];
+    corner.uv = chunk.corners[i + 1];
+    corner.normal = chunk.corners[i + 2];
+    if (corner.position < 0 || corner.position >= counts[0] ||
+        corner.uv < -1 || corner.uv >= counts[1] ||
+        corner.normal < -1 || corner.normal >= counts[2])
+    {
+      return false;
+    }
+    mesh.indices.push_back(findOrAddVertex(corner, mesh));
+  }
+  return true;
+}
+
+static inline size_t hashCorner(int p, int t, int n)
+{
+  unsigned int h = (unsigned int) p * 0x9E3779B1u;
+  h ^= (unsigned int) (t + 1) * 0x85EBCA77u;
+  h ^= (unsigned int) (n + 1) * 0xC2B2AE3Du;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 13;
+  return h;
+}
+
+unsigned int MeshImporter::findOrAddVertex(const Corner& corner, Mesh& mesh)
+{
+  if ((m_vertexCount + 1) * 2 > m_vertexTable.size())
+  {
+    growVertexTable();
+  }
+
+  size_t mask = m_vertexTable.size() - 1;
+  size_t slot = hashCorner(corner.position, corner.uv, corner.normal) & mask;
+  while (m_vertexTable[slot].vertex != EMPTY_SLOT)
+  {
+    const Corner& other = m_vertexTable[slot].corner;
+    if (other.position == corner.position && other.uv == corner.uv &&
+        other.normal == corner.normal)
+    {
+      return m_vertexTable[slot].vertex;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  unsigned int vertex = (unsigned int) m_vertexCount++;
+  m_vertexTable[slot].corner = corner;
+  m_vertexTable[slot].vertex = vertex;
+
+  const float* p = &m_positions[corner.position * 3];
+  mesh.positions.push_back(Vector3f(p[0], p[1], p[2]));
+
+  // Normal and texture coordinate arrays are created by the first corner
+  // that has them.
+  if (corner.normal >= 0 && !m_hasNormals)
+  {
+    m_hasNormals = true;
+    mesh.normals.resize(vertex);
+  }
+  if (m_hasNormals)
+  {
+    const float* n = corner.normal >= 0 ? &m_normals[corner.normal * 3] : NULL;
+    mesh.normals.push_back(n != NULL ? Vector3f(n[0], n[1], n[2]) : Vector3f());
+  }
+
+  if (corner.uv >= 0 && !m_hasUVs)
+  {
+    m_hasUVs = true;
+    mesh.uvs.resize(vertex);
+  }
+  if (m_hasUVs)
+  {
+    const float* t = corner.uv >= 0 ? &m_uvs[corner.uv * 2] : NULL;
+    mesh.uvs.push_back(t != NULL ? Vector2f(t[0], t[1]) : Vector2f());
+  }
+
+  return vertex;
+}
+
+void MeshImporter::growVertexTable()
+{
+  std::vector<VertexSlot> table(m_vertexTable.size() * 2);
+  for (size_t i = 0; i < table.size(); ++i)
+  {
+    table[i].vertex = EMPTY_SLOT;
+  }
+
+  size_t mask = table.size() - 1;
+  for (size_t i = 0; i < m_vertexTable.size(); ++i)
+  {
+    const VertexSlot& entry = m_vertexTable[i];
+    if (entry.vertex == EMPTY_SLOT)
+    {
+      continue;
+    }
+    size_t slot = hashCorner(entry.corner.position, entry.corner.uv,
+                             entry.corner.normal) & mask;
+    while (table[slot].vertex != EMPTY_SLOT)
+    {
+      slot = (slot + 1) & mask;
+    }
+    table[slot] = entry;
+  }
+  m_vertexTable.swap(table);
+}
+
+/*
+ * PLY header description.
+ */
+enum PlyType
+{
+  PLY_INVALID = 0,
+  PLY_INT8,
+  PLY_UINT8,
+  PLY_INT16,
+  PLY_UINT16,
+  PLY_INT32,
+  PLY_UINT32,
+  PLY_FLOAT32,
+  PLY_FLOAT64
+};
+
+enum PlyTarget
+{
+  PLY_IGNORED = -1,
+  PLY_X, PLY_Y, PLY_Z,
+  PLY_NX, PLY_NY, PLY_NZ,
+  PLY_U, PLY_V,
+  PLY_INDICES
+};
+
+struct PlyProperty
+{
+  PlyType type;
+  PlyType countType;
+  bool    isList;
+  int     target;
+};
+
+struct PlyElement
+{
+  std::string              name;
+  size_t                   count;
+  std::vector<PlyProperty> properties;
+};
+
+static PlyType parsePlyType(const std::string& name)
+{
+  static const struct { const char* name; PlyType type; } TYPES[] = {
+    { "char", PLY_INT8 },     { "int8", PLY_INT8 },
+    { "uchar", PLY_UINT8 },   { "uint8", PLY_UINT8 },
+    { "short", PLY_INT16 },   { "int16", PLY_INT16 },
+    { "ushort", PLY_UINT16 }, { "uint16", PLY_UINT16 },
+    { "int", PLY_INT32 },     { "int32", PLY_INT32 },
+    { "uint", PLY_UINT32 },   { "uint32", PLY_UINT32 },
+    { "float", PLY_FLOAT32 }, { "float32", PLY_FLOAT32 },
+    { "double", PLY_FLOAT64 }, { "float64", PLY_FLOAT64 }
+  };
+  for (size_t i = 0; i < sizeof(TYPES) / sizeof(TYPES[0]); ++i)
+  {
+    if (name == TYPES[i].name)
+    {
+      return TYPES[i].type;
+    }
+  }
+  return PLY_INVALID;
+}
+
+static size_t plyTypeSize(PlyType type)
+{
+  static const size_t SIZES[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+  return SIZES[type];
+}
+
+static int plyTarget(const std::string& element, const std::string& property)
+{
+  if (element == "vertex")
+  {
+    static const char* NAMES[] = { "x", "y", "z", "nx", "ny", "nz" };
+    for (int i = 0; i < 6; ++i)
+    {
+      if (property == NAMES[i])
+      {
+        return PLY_X + i;
+      }
+    }
+    if (property == "u" || property == "s" || property == "texture_u")
+    {
+      return PLY_U;
+    }
+    if (property == "v" || property == "t" || property == "texture_v")
+    {
+      return PLY_V;
+    }
+  }
+  else if (element == "face" &&
+           (property == "vertex_indices" || property == "vertex_index"))
+  {
+    return PLY_INDICES;
+  }
+  return PLY_IGNORED;
+}
+
+static inline double readPlyValue(const unsigned char* p, PlyType type)
+{
+  switch (type)
+  {
+  case PLY_INT8:    { signed char v;        memcpy(&v, p, 1); return v; }
+  case PLY_UINT8:   { unsigned char v;      memcpy(&v, p, 1); return v; }
+  case PLY_INT16:   { short v;              memcpy(&v, p, 2); return v; }
+  case PLY_UINT16:  { unsigned short v;     memcpy(&v, p, 2); return v; }
+  case PLY_INT32:   { int v;                memcpy(&v, p, 4); return v; }
+  case PLY_UINT32:  { unsigned int v;       memcpy(&v, p, 4); return v; }
+  case PLY_FLOAT32: { float v;              memcpy(&v, p, 4); return v; }
+  case PLY_FLOAT64: { double v;             memcpy(&v, p, 8); return v; }
+  default:          return 0.0;
+  }
+}
+
+/*
+ * Add the triangles of a polygon, rejecting indices outside the mesh.
+ */
+static inline bool addPlyPolygon(const long long* pIndices, size_t count,
+                                 size_t vertexCount, std::vector<unsigned int>& out)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (pIndices[i] < 0 || (unsigned long long) pIndices[i] >= vertexCount)
+    {
+      return false;
+    }
+  }
+  for (size_t i = 2; i < count; ++i)
+  {
+    out.push_back((unsigned int) pIndices[0]);
+    out.push_back((unsigned int) pIndices[i - 1]);
+    out.push_back((unsigned int) pIndices[i]);
+  }
+  return true;
+}
+
+/*
+ * Store one decoded vertex property.
+ */
+static inline void setPlyVertex(Mesh& mesh, size_t vertex, int target, float value)
+{
+  switch (target)
+  {
+  case PLY_X:  mesh.positions[vertex].x = value; break;
+  case PLY_Y:  mesh.positions[vertex].y = value; break;
+  case PLY_Z:  mesh.positions[vertex].z = value; break;
+  case PLY_NX: mesh.normals[vertex].x = value; break;
+  case PLY_NY: mesh.normals[vertex].y = value; break;
+  case PLY_NZ: mesh.normals[vertex].z = value; break;
+  case PLY_U:  mesh.uvs[vertex].x = value; break;
+  case PLY_V:  mesh.uvs[vertex].y = value; break;
+  default:     break;
+  }
+}
+
+/**
+ * Parse a PLY file.
+ *
+ * @param[in]  pData - the file contents
+ * @param[in]  size  - size of the contents in bytes
+ * @param[out] mesh  - receives the mesh
+ * @param[in]  pPool - pool used to parse chunks in parallel, or NULL
+ *
+ * @return true on success, false for an unsupported format, a syntax error
+ *         or an index out of range
+ */
+bool MeshImporter::parsePly(const char* pData, size_t size, Mesh& mesh, ThreadPool* pPool)
+{
+  mesh.clear();
+
+  // Header, parsed line by line. It is tiny compared to the body.
+  const char* end = pData + size;
+  const char* p = pData;
+  std::vector<PlyElement> elements;
+  bool isBinary = false, hasFormat = false, hasEnd = false;
+  for (int line = 0; p < end && !hasEnd; ++line)
+  {
+    const char* pLineEnd = findLineEnd(p, end);
+    std::istringstream stream(std::string(p, pLineEnd));
+    p = pLineEnd + 1;
+
+    std::string keyword;
+    stream >> keyword;
+    if (line == 0)
+    {
+      if (keyword != "ply")
+      {
+        return false;
+      }
+    }
+    else if (keyword == "format")
+    {
+      std::string format;
+      stream >> format;
+      if (format != "ascii" && format != "binary_little_endian")
+      {
+        return false;
+      }
+      isBinary = format != "ascii";
+      hasFormat = true;
+    }
+    else if (keyword == "element")
+    {
+      PlyElement element;
+      stream >> element.name >> element.count;
+      if (!stream)
+      {
+        return false;
+      }
+      elements.push_back(element);
+    }
+    else if (keyword == "property")
+    {
+      if (elements.empty())
+      {
+        return false;
+      }
+
+      PlyProperty property;
+      std::string type, name;
+      stream >> type;
+      property.isList = type == "list";
+      property.countType = PLY_INVALID;
+      if (property.isList)
+      {
+        std::string countType;
+        stream >> countType >> type;
+        property.countType = parsePlyType(countType);
+      }
+      stream >> name;
+      property.type = parsePlyType(type);
+      property.target = plyTarget(elements.back().name, name);
+
+      // Lists are only supported outside of the vertex element, where
+      // they are read as face indices or skipped.
+      if (property.type == PLY_INVALID ||
+          (property.isList && property.countType == PLY_INVALID) ||
+          (property.isList && elements.back().name == "vertex"))
+      {
+        return false;
+      }
+      elements.back().properties.push_back(property);
+    }
+    else if (keyword == "end_header")
+    {
+      hasEnd = true;
+    }
+  }
+
+  if (!hasFormat || !hasEnd)
+  {
+    return false;
+  }
+  p = std::min(p, end);
+
+  // Every record takes at least a byte, a line in ASCII files, which bounds the
+  // counts by the size of the body before anything is allocated.
+  size_t bodySize = end - p;
+  for (size_t e = 0; e < elements.size(); ++e)
+  {
+    size_t recordSize = 0;
+    for (size_t i = 0; i < elements[e].properties.size() && isBinary; ++i)
+    {
+      const PlyProperty& property = elements[e].properties[i];
+      recordSize += plyTypeSize(property.isList ? property.countType : property.type);
+    }
+    recordSize = std::max(recordSize, (size_t) 1);
+    if (elements[e].count > bodySize / recordSize)
+    {
+      return false;
+    }
+    bodySize -= elements[e].count * recordSize;
+  }
+
+  // Allocate the vertex attributes present in the file.
+  size_t vertexCount = 0;
+  bool hasNormals = false, hasUVs = false;
+  for (size_t e = 0; e < elements.size(); ++e)
+  {
+    if (elements[e].name != "vertex")
+    {
+      continue;
+    }
+    vertexCount = elements[e].count;
+    for (size_t i = 0; i < elements[e].properties.size(); ++i)
+    {
+      int target = elements[e].properties[i].target;
+      hasNormals = hasNormals || (target >= PLY_NX && target <= PLY_NZ);
+      hasUVs = hasUVs || target == PLY_U || target == PLY_V;
+    }
+  }
+  mesh.positions.resize(vertexCount);
+  mesh.normals.resize(hasNormals ? vertexCount : 0);
+  mesh.uvs.resize(hasUVs ? vertexCount : 0);
+
+  bool isValid = true;
+  if (isBinary)
+  {
+    const unsigned char* pBody = (const unsigned char*) p;
+    const unsigned char* pEnd = (const unsigned char*) end;
+    for (size_t e = 0; e < elements.size() && isValid; ++e)
+    {
+      const PlyElement& element = elements[e];
+      size_t stride = 0;
+      bool isFixed = true;
+      for (size_t i = 0; i < element.properties.size(); ++i)
+      {
+        isFixed = isFixed && !element.properties[i].isList;
+        stride += plyTypeSize(element.properties[i].type);
+      }
+
+      if (isFixed)
+      {
+        if (stride != 0 && (size_t) (pEnd - pBody) / stride < element.count)
+        {
+          isValid = false;
+          break;
+        }
+
+        if (element.name == "vertex")
+        {
+          // Fixed size records, decoded in parallel.
+          const unsigned char* pRecords = pBody;
+          const std::vector<PlyProperty>& properties = element.properties;
+          ThreadPool::RangeTask decode = [&, pRecords, stride](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v)
+            {
+              const unsigned char* pRecord = pRecords + v * stride;
+              for (size_t i = 0; i < properties.size(); ++i)
+              {
+                if (properties[i].target != PLY_IGNORED)
+                {
+                  setPlyVertex(mesh, v, properties[i].target,
+                               (float) readPlyValue(pRecord, properties[i].type));
+                }
+                pRecord += plyTypeSize(properties[i].type);
+              }
+            }
+          };
+          if (pPool != NULL)
+          {
+            pPool->parallelFor(0, element.count, VERTEX_GRAIN_SIZE, decode);
+          }
+          else
+          {
+            decode(0, element.count);
+          }
+        }
+        pBody += stride * element.count;
+        continue;
+      }
+
+      // Variable size records, the faces are read sequentially.
+      long long indices[256];
+      for (size_t r = 0; r < element.count && isValid; ++r)
+      {
+        for (size_t i = 0; i < element.properties.size() && isValid; ++i)
+        {
+          const PlyProperty& property = element.properties[i];
+          if (!property.isList)
+          {
+            size_t bytes = plyTypeSize(property.type);
+            isValid = (size_t) (pEnd - pBody) >= bytes;
+            pBody += isValid ? bytes : 0;
+            continue;
+          }
+
+          size_t countBytes = plyTypeSize(property.countType);
+          size_t itemBytes = plyTypeSize(property.type);
+          if ((size_t) (pEnd - pBody) < countBytes)
+          {
+            isValid = false;
+            break;
+          }
+          double countValue = readPlyValue(pBody, property.countType);
+          pBody += countBytes;
+          if (!(countValue >= 0.0 && countValue <= (double) ((size_t) (pEnd - pBody) / itemBytes)))
+          {
+            isValid = false;
+            break;
+          }
+          size_t count = (size_t) countValue;
+
+          if (property.target == PLY_INDICES)
+          {
+            if (count > 256)
+            {
+              isValid = false;
+              break;
+            }
+            for (size_t k = 0; k < count; ++k)
+            {
+              // Out of range values, which may not fit an integer, are rejected as -1.
+              double index = readPlyValue(pBody + k * itemBytes, property.type);
+              indices[k] = index >= 0.0 && index < (double) vertexCount ? (long long) index : -1;
+            }
+            isValid = addPlyPolygon(indices, count, vertexCount, mesh.indices);
+          }
+          pBody += count * itemBytes;
+        }
+      }
+    }
+  }
+  else
+  {
+    // Count the lines of every chunk in parallel to learn which element the
+    // lines of each chunk belong to.
+    size_t bodyBegin = p - pData;
+    size_t chunkCount = (size - bodyBegin) / m_chunkSize + 1;
+    std::vector<size_t> bounds;
+    splitLines(pData, size, bodyBegin, chunkCount, bounds);
+
+    std::vector<size_t> firstLine(chunkCount + 1, 0);
+    ThreadPool::RangeTask countLines = [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c)
+      {
+        size_t lines = 0;
+        const char* q = pData + bounds[c];
+        const char* pChunkEnd = pData + bounds[c + 1];
+        while (q < pChunkEnd)
+        {
+          q = findLineEnd(q, pChunkEnd) + 1;
+          ++lines;
+        }
+        firstLine[c + 1] = lines;
+      }
+    };
+    if (pPool != NULL)
+    {
+      pPool->parallelFor(0, chunkCount, 1, countLines);
+    }
+    else
+    {
+      countLines(0, chunkCount);
+    }
+    for (size_t c = 0; c < chunkCount; ++c)
+    {
+      firstLine[c + 1] += firstLine[c];
+    }
+
+    std::vector<size_t> elementStart(elements.size() + 1, 0);
+    for (size_t e = 0; e < elements.size(); ++e)
+    {
+      elementStart[e + 1] = elementStart[e] + elements[e].count;
+    }
+    if (firstLine[chunkCount] < elementStart[elements.size()])
+    {
+      return false;
+    }
+
+    std::vector< std::vector<unsigned int> > faces(chunkCount);
+    std::vector<char> chunkValid(chunkCount, 1);
+    ThreadPool::RangeTask parseLines = [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c)
+      {
+        const char* q = pData + bounds[c];
+        const char* pChunkEnd = pData + bounds[c + 1];
+        size_t line = firstLine[c];
+        size_t e = 0;
+        long long indices[256];
+        while (q < pChunkEnd && chunkValid[c])
+        {
+          const char* pLineEnd = findLineEnd(q, pChunkEnd);
+          while (e < elements.size() && line >= elementStart[e + 1])
+          {
+            ++e;
+          }
+          if (e == elements.size())
+          {
+            break;
+          }
+
+          const PlyElement& element = elements[e];
+          size_t record = line - elementStart[e];
+          bool isVertex = element.name == "vertex";
+          const char* r = q;
+          for (size_t i = 0; i < element.properties.size() && chunkValid[c]; ++i)
+          {
+            const PlyProperty& property = element.properties[i];
+            if (!property.isList)
+            {
+              float value;
+              r = parseFloat(skipSpaces(r, pLineEnd), pLineEnd, value);
+              if (r == NULL)
+              {
+                chunkValid[c] = 0;
+              }
+              else if (isVertex)
+              {
+                setPlyVertex(mesh, record, property.target, value);
+              }
+              continue;
+            }
+
+            long long count;
+            r = parseInt(skipSpaces(r, pLineEnd), pLineEnd, count);
+            if (r == NULL || count < 0 || count > 256)
+            {
+              chunkValid[c] = 0;
+              break;
+            }
+            for (long long k = 0; k < count && r != NULL; ++k)
+            {
+              r = parseInt(skipSpaces(r, pLineEnd), pLineEnd, indices[k]);
+            }
+            if (r == NULL)
+            {
+              chunkValid[c] = 0;
+            }
+            else if (property.target == PLY_INDICES &&
+                     !addPlyPolygon(indices, (size_t) count, vertexCount, faces[c]))
+            {
+              chunkValid[c] = 0;
+            }
+          }
+
+          q = pLineEnd + 1;
+          ++line;
+        }
+      }
+    };
+    if (pPool != NULL)
+    {
+      pPool->parallelFor(0, chunkCount, 1, parseLines);
+    }
+    else
+    {
+      parseLines(0, chunkCount);
+    }
+
+    size_t indexCount = 0;
+    for (size_t c = 0; c < chunkCount; ++c)
+    {
+      isValid = isValid && chunkValid[c] != 0;
+      indexCount += faces[c].size();
+    }
+    mesh.indices.reserve(indexCount);
+    for (size_t c = 0; c < chunkCount && isValid; ++c)
+    {
+      mesh.indices.insert(mesh.indices.end(), faces[c].begin(), faces[c].end());
+    }
+  }
+
+  if (!isValid)
+  {
+    mesh.clear();
+    return false;
+  }
+  return true;
+}
+
+}
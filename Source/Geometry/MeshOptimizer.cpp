@@ -0,0 +1,400 @@
+/**
+ * @file MeshOptimizer.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the MeshOptimizer class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\MeshOptimizer.h"
+#include "..\..\Include\LiteCube\Geometry\Mesh.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Lite
+{
+
+static const unsigned int INVALID_INDEX = 0xFFFFFFFFu;
+
+struct ClusterOrder
+{
+  unsigned int cluster;
+  float        metric;
+
+  bool operator <(const ClusterOrder& other) const
+  {
+    return metric > other.metric;
+  }
+};
+
+/*
+ * Build the list of triangles using every vertex.
+ */
+static void buildAdjacency(const unsigned int* pIndices, size_t indexCount,
+                           size_t vertexCount, std::vector<unsigned int>& offsets,
+                           std::vector<unsigned int>& triangles)
+{
+  offsets.assign(vertexCount + 1, 0);
+  for (size_t i = 0; i < indexCount; ++i)
+  {
+    ++offsets[pIndices[i] + 1];
+  }
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    offsets[v + 1] += offsets[v];
+  }
+
+  triangles.resize(indexCount);
+  std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < indexCount; ++i)
+  {
+    triangles[fill[pIndices[i]]++] = (unsigned int) (i / 3);
+  }
+}
+
+/**
+ * Reorder triangles to reuse the post-transform vertex cache.
+ *
+ * @param[in,out] pIndices    - triangle list to reorder in place
+ * @param[in]     indexCount  - number of indices, a multiple of three
+ * @param[in]     vertexCount - number of vertices referenced by the indices
+ * @param[in]     cacheSize   - number of vertices the cache holds
+ * @param[out]    pClusters   - if not NULL, receives the first triangle of
+ *                              every run that starts with a cold cache
+ */
+void MeshOptimizer::optimizeVertexCache(unsigned int* pIndices, size_t indexCount,
+                                        size_t vertexCount, unsigned int cacheSize,
+                                        std::vector<unsigned int>* pClusters)
+{
+  indexCount -= indexCount % 3;
+  if (pClusters != NULL)
+  {
+    pClusters->clear();
+  }
+  if (indexCount == 0)
+  {
+    return;
+  }
+
+  std::vector<unsigned int> offsets, adjacency;
+  buildAdjacency(pIndices, indexCount, vertexCount, offsets, adjacency);
+
+  std::vector<unsigned int> live(vertexCount);
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    live[v] = offsets[v + 1] - offsets[v];
+  }
+
+  std::vector<unsigned int> cacheTime(vertexCount, 0);
+  std::vector<bool> isEmitted(indexCount / 3, false);
+  std::vector<unsigned int> deadEnds, candidates, output(indexCount);
+  deadEnds.reserve(indexCount);
+  size_t outputCount = 0;
+  unsigned int timestamp = cacheSize + 1;
+  size_t cursor = 0;
+
+  unsigned int fan = INVALID_INDEX;
+  while (cursor < vertexCount && live[cursor] == 0)
+  {
+    ++cursor;
+  }
+  fan = cursor < vertexCount ? (unsigned int) cursor : INVALID_INDEX;
+  if (pClusters != NULL)
+  {
+    pClusters->push_back(0);
+  }
+
+  while (fan != INVALID_INDEX)
+  {
+    // Emit every remaining triangle around the fanning vertex.
+    candidates.clear();
+    for (unsigned int a = offsets[fan]; a < offsets[fan + 1]; ++a)
+    {
+      unsigned int triangle = adjacency[a];
+      if (isEmitted[triangle])
+      {
+        continue;
+      }
+      isEmitted[triangle] = true;
+
+      for (int k = 0; k < 3; ++k)
+      {
+        unsigned int v = pIndices[triangle * 3 + k];
+        output[outputCount++] = v;
+        deadEnds.push_back(v);
+        candidates.push_back(v);
+        --live[v];
+        if (timestamp - cacheTime[v] > cacheSize)
+        {
+          cacheTime[v] = timestamp++;
+        }
+      }
+    }
+
+    // Continue with the candidate that stays in the cache longest while
+    // its remaining triangles are emitted.
+    fan = INVALID_INDEX;
+    int bestPriority = -1;
+    for (size_t c = 0; c < candidates.size(); ++c)
+    {
+      unsigned int v = candidates[c];
+      if (live[v] == 0)
+      {
+        continue;
+      }
+      int priority = 0;
+      if (timestamp - cacheTime[v] + 2 * live[v] <= cacheSize)
+      {
+        priority = (int) (timestamp - cacheTime[v]);
+      }
+      if (priority > bestPriority)
+      {
+        bestPriority = priority;
+        fan = v;
+      }
+    }
+
+    if (fan == INVALID_INDEX)
+    {
+      // Dead end: recently used vertices first, then any vertex left.
+      while (!deadEnds.empty() && fan == INVALID_INDEX)
+      {
+        unsigned int v = deadEnds.back();
+        deadEnds.pop_back();
+        if (live[v] > 0)
+        {
+          fan = v;
+        }
+      }
+      while (fan == INVALID_INDEX && cursor < vertexCount)
+      {
+        if (live[cursor] > 0)
+        {
+          fan = (unsigned int) cursor;
+        }
+        ++cursor;
+      }
+      if (pClusters != NULL && fan != INVALID_INDEX)
+      {
+        pClusters->push_back((unsigned int) (outputCount / 3));
+      }
+    }
+  }
+
+  std::copy(output.begin(), output.begin() + outputCount, pIndices);
+}
+
+/**
+ * Sort clusters of triangles to reduce overdraw.
+ *
+ * A cluster whose surface faces away from the center of the mesh is likely
+ * to hide the clusters behind it, so clusters are drawn in decreasing
+ * order of the distance of their centroid from the mesh center along their
+ * average normal.
+ *
+ * @param[in,out] pIndices   - triangle list to reorder in place
+ * @param[in]     indexCount - number of indices, a multiple of three
+ * @param[in]     pPositions - vertex positions
+ * @param[in]     clusters   - first triangle of every cluster, in increasing
+ *                             order, as produced by optimizeVertexCache()
+ */
+void MeshOptimizer::optimizeOverdraw(unsigned int* pIndices, size_t indexCount,
+                                     const Vector3f* pPositions,
+                                     const std::vector<unsigned int>& clusters)
+{
+  size_t triangleCount = indexCount / 3;
+  if (clusters.size() < 2 || triangleCount == 0)
+  {
+    return;
+  }
+
+  // Area weighted centroid and normal of every cluster and of the mesh.
+  std::vector<float> sums(clusters.size() * 7, 0.0f);
+  float center[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+  for (size_t c = 0; c < clusters.size(); ++c)
+  {
+    size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+    float* pSum = &sums[c * 7];
+    for (size_t t = clusters[c]; t < end; ++t)
+    {
+      const Vector3f& a = pPositions[pIndices[t * 3]];
+      const Vector3f& b = pPositions[pIndices[t * 3 + 1]];
+      const Vector3f& d = pPositions[pIndices[t * 3 + 2]];
+      float e1[3] = { b.x - a.x, b.y - a.y, b.z - a.z };
+      float e2[3] = { d.x - a.x, d.y - a.y, d.z - a.z };
+      float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                     e1[0] * e2[1] - e1[1] * e2[0] };
+      float area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      float centroid[3] = { (a.x + b.x + d.x) / 3.0f, (a.y + b.y + d.y) / 3.0f,
+                            (a.z + b.z + d.z) / 3.0f };
+      for (int k = 0; k < 3; ++k)
+      {
+        pSum[k] += centroid[k] * area;
+        pSum[3 + k] += n[k];
+        center[k] += centroid[k] * area;
+      }
+      pSum[6] += area;
+      center[3] += area;
+    }
+  }
+
+  if (center[3] <= 0.0f)
+  {
+    return;
+  }
+  for (int k = 0; k < 3; ++k)
+  {
+    center[k] /= center[3];
+  }
+
+  std::vector<ClusterOrder> order(clusters.size());
+  for (size_t c = 0; c < clusters.size(); ++c)
+  {
+    const float* pSum = &sums[c * 7];
+    float metric = 0.0f;
+    float normalLength = sqrtf(pSum[3] * pSum[3] + pSum[4] * pSum[4] + pSum[5] * pSum[5]);
+    if (pSum[6] > 0.0f && normalLength > 0.0f)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        metric += (pSum[k] / pSum[6] - center[k]) * pSum[3 + k];
+      }
+      metric /= normalLength;
+    }
+    order[c].cluster = (unsigned int) c;
+    order[c].metric = metric;
+  }
+  std::stable_sort(order.begin(), order.end());
+
+  std::vector<unsigned int> source(pIndices, pIndices + triangleCount * 3);
+  unsigned int* pOut = pIndices;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    size_t c = order[i].cluster;
+    size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+    pOut = std::copy(source.begin() + clusters[c] * 3, source.begin() + end * 3, pOut);
+  }
+}
+
+/**
+ * Renumber the vertices of a mesh in order of first use by the indices.
+ *
+ * Vertices not referenced by any triangle are removed.
+ *
+ * @param[in,out] mesh - mesh to reorder
+ *
+ * @return number of vertices left
+ */
+size_t MeshOptimizer::optimizeVertexFetch(Mesh& mesh)
+{
+  size_t vertexCount = mesh.positions.size();
+  std::vector<unsigned int> remap(vertexCount, INVALID_INDEX);
+  unsigned int next = 0;
+  for (size_t i = 0; i < mesh.indices.size(); ++i)
+  {
+    unsigned int& index = mesh.indices[i];
+    if (remap[index] == INVALID_INDEX)
+    {
+      remap[index] = next++;
+    }
+    index = remap[index];
+  }
+
+  std::vector<unsigned int> order(next);
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    if (remap[v] != INVALID_INDEX)
+    {
+      order[remap[v]] = (unsigned int) v;
+    }
+  }
+
+  std::vector<Vector3f> positions;
+  std::vector<Vector3f> normals;
+  std::vector<Vector2f> uvs;
+  positions.reserve(next);
+  normals.reserve(mesh.hasNormals() ? next : 0);
+  uvs.reserve(mesh.hasUVs() ? next : 0);
+  for (unsigned int i = 0; i < next; ++i)
+  {
+    positions.push_back(mesh.positions[order[i]]);
+    if (mesh.hasNormals())
+    {
+      normals.push_back(mesh.normals[order[i]]);
+    }
+    if (mesh.hasUVs())
+    {
+      uvs.push_back(mesh.uvs[order[i]]);
+    }
+  }
+
+  mesh.positions.swap(positions);
+  mesh.normals.swap(normals);
+  mesh.uvs.swap(uvs);
+  return next;
+}
+
+/**
+ * Run the whole pipeline on a mesh: vertex cache, overdraw and vertex fetch
+ * optimization.
+ *
+ * @param[in,out] mesh      - mesh to optimize
+ * @param[in]     cacheSize - number of vertices the cache holds
+ */
+void MeshOptimizer::optimize(Mesh& mesh, unsigned int cacheSize)
+{
+  if (mesh.indices.empty())
+  {
+    return;
+  }
+
+  std::vector<unsigned int> clusters;
+  optimizeVertexCache(&mesh.indices[0], mesh.indices.size(), mesh.positions.size(),
+                      cacheSize, &clusters);
+  optimizeOverdraw(&mesh.indices[0], mesh.indices.size(), &mesh.positions[0], clusters);
+  optimizeVertexFetch(mesh);
+}
+
+/**
+ * Calculate the average cache miss ratio of a triangle list with a FIFO
+ * cache.
+ *
+ * @param[in] pIndices    - triangle list
+ * @param[in] indexCount  - number of indices
+ * @param[in] vertexCount - number of vertices referenced by the indices
+ * @param[in] cacheSize   - number of vertices the cache holds
+ *
+ * @return cache misses per triangle
+ */
+float MeshOptimizer::computeACMR(const unsigned int* pIndices, size_t indexCount,
+                                 size_t vertexCount, unsigned int cacheSize)
+{
+  size_t triangleCount = indexCount / 3;
+  if (triangleCount == 0)
+  {
+    return 0.0f;
+  }
+
+  // A vertex is cached while fewer than cacheSize misses followed its own.
+  std::vector<unsigned int> cacheTime(vertexCount, 0);
+  unsigned int timestamp = cacheSize + 1;
+  size_t misses = 0;
+  for (size_t i = 0; i < triangleCount * 3; ++i)
+  {
+    unsigned int v = pIndices[i];
+    if (timestamp - cacheTime[v] > cacheSize)
+    {
+      cacheTime[v] = timestamp++;
+      ++misses;
+    }
+  }
+  return misses / (float) triangleCount;
+}
+
+}
@@ -0,0 +1,819 @@
+/**
+ * @file MeshSimplifier.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the MeshSimplifier class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\MeshSimplifier.h"
+#include "..\..\Include\LiteCube\Geometry\Mesh.h"
+#include "..\..\Include\LiteCube\Geometry\MeshOptimizer.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace Lite
+{
+
+static const size_t       GRAIN_SIZE = 4096;
+static const unsigned int INVALID_INDEX = 0xFFFFFFFFu;
+
+// Weight of the planes keeping border edges in place, relative to the area
+// weighted planes of the triangles.
+static const float        BORDER_WEIGHT = 10.0f;
+
+// Distinct neighbours considered by the link condition; vertices with more
+// are not collapsed.
+static const unsigned int MAX_RING = 64;
+
+// Cosine of the largest rotation of a triangle normal by a collapse.
+static const float        MIN_NORMAL_COSINE = 0.25f;
+
+// Buckets of the collapse sort, indexed by the upper bits of the cost.
+static const unsigned int SORT_BITS = 11;
+static const unsigned int SORT_BUCKETS = 1 << SORT_BITS;
+
+static inline unsigned int sortKey(float cost)
+{
+  unsigned int bits;
+  memcpy(&bits, &cost, sizeof(bits));
+  return bits >> (32 - SORT_BITS - 1);
+}
+
+static inline void cross(const float* a, const float* b, const float* c, float* n)
+{
+  float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+  float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+  n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+  n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+  n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+/*
+ * Collect the distinct neighbours of a vertex, sorted. Returns false if
+ * there are more than MAX_RING.
+ */
+static bool collectRing(const unsigned int* pIndices, const unsigned int* pTriangles,
+                        unsigned int triangleCount, unsigned int vertex,
+                        unsigned int* pRing, unsigned int& ringSize)
+{
+  if (triangleCount * 2 > MAX_RING)
+  {
+    return false;
+  }
+  ringSize = 0;
+  for (unsigned int i = 0; i < triangleCount; ++i)
+  {
+    const unsigned int* pTriangle = pIndices + pTriangles[i] * 3;
+    for (int k = 0; k < 3; ++k)
+    {
+      if (pTriangle[k] != vertex)
+      {
+        pRing[ringSize++] = pTriangle[k];
+      }
+    }
+  }
+  std::sort(pRing, pRing + ringSize);
+  ringSize = (unsigned int) (std::unique(pRing, pRing + ringSize) - pRing);
+  return true;
+}
+
+/**
+ * Default constructor.
+ */
+MeshSimplifier::MeshSimplifier()
+  : m_scale(1.0f)
+  , m_error(0.0f)
+{
+}
+
+/**
+ * Destructor.
+ */
+MeshSimplifier::~MeshSimplifier()
+{
+}
+
+/**
+ * Simplify a mesh.
+ *
+ * Stops when the triangle count reaches the target or when every remaining
+ * collapse would exceed the error limit.
+ *
+ * @param[in]  input           - mesh to simplify
+ * @param[out] output          - receives the simplified mesh, with the
+ *                               vertices in their original order
+ * @param[in]  targetTriangles - triangle count to reach
+ * @param[in]  maxError        - largest error of a collapse
+ * @param[in]  pPool           - pool used to evaluate collapses in
+ *                               parallel, or NULL
+ *
+ * @return number of triangles of the simplified mesh
+ */
+size_t MeshSimplifier::simplify(const Mesh& input, Mesh& output, size_t targetTriangles,
+                                float maxError, ThreadPool* pPool)
+{
+  prepare(input, pPool);
+  while (runPass(targetTriangles, maxError, pPool) > 0)
+  {
+  }
+  extract(input, output);
+  return output.getTriangleCount();
+}
+
+/**
+ * Build a chain of levels of detail.
+ *
+ * Level 0 is the input mesh and every further level has ratio times the
+ * triangles of the previous one. All levels come from a single
+ * simplification of the input, so their errors are relative to the input.
+ * Every level is finished with MeshOptimizer::optimize() on the pool while
+ * the next one is simplified. The chain ends early when the error limit
+ * stops the simplification.
+ *
+ * @param[in]  input    - mesh to simplify
+ * @param[in]  levels   - number of levels, including the input
+ * @param[in]  ratio    - triangle count of a level relative to the previous
+ * @param[in]  maxError - largest error of a collapse
+ * @param[out] lods     - receives the levels
+ * @param[in]  pPool    - pool used for the work, or NULL
+ *
+ * @return number of levels built
+ */
+size_t MeshSimplifier::buildLodChain(const Mesh& input, unsigned int levels, float ratio,
+                                     float maxError, std::vector<Mesh>& lods,
+                                     ThreadPool* pPool)
+{
+  lods.clear();
+  m_lodErrors.clear();
+  if (levels == 0)
+  {
+    return 0;
+  }
+
+  // Reserved up front, tasks keep pointers to the levels.
+  lods.reserve(levels);
+  std::atomic<unsigned int> pending(0);
+
+  lods.push_back(input);
+  m_lodErrors.push_back(0.0f);
+  prepare(input, pPool);
+  double target = (double) (m_indices.size() / 3);
+
+  for (unsigned int level = 0; level < levels; ++level)
+  {
+    if (level > 0)
+    {
+      target *= ratio;
+      size_t before = m_indices.size();
+      while (runPass((size_t) target, maxError, pPool) > 0)
+      {
+      }
+      if (m_indices.size() == before || m_indices.empty())
+      {
+        break;
+      }
+      lods.push_back(Mesh());
+      m_lodErrors.push_back(m_error);
+      extract(input, lods.back());
+    }
+
+    Mesh* pLod = &lods.back();
+    if (pPool != NULL)
+    {
+      ++pending;
+      pPool->enqueue([pLod, &pending]() {
+        MeshOptimizer::optimize(*pLod);
+        --pending;
+      });
+    }
+    else
+    {
+      MeshOptimizer::optimize(*pLod);
+    }
+  }
+
+  while (pending > 0)
+  {
+    if (!pPool->runPendingTask())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  return lods.size();
+}
+
+/**
+ * Obtain the error of the last simplification.
+ *
+ * @return largest error of the collapses performed
+ */
+float MeshSimplifier::getError() const
+{
+  return m_error;
+}
+
+/**
+ * Obtain the error of every level built by the last buildLodChain().
+ *
+ * @return errors relative to the input mesh, one per level
+ */
+const std::vector<float>& MeshSimplifier::getLodErrors() const
+{
+  return m_lodErrors;
+}
+
+/*
+ * Copy the input, drop degenerate triangles and compute the vertex kinds
+ * and quadrics.
+ */
+void MeshSimplifier::prepare(const Mesh& input, ThreadPool* pPool)
+{
+  // Quadrics are accumulated in float, so the positions are moved to the
+  // center of their bounds and scaled to unit size first. Done in double,
+  // a translated mesh gives the same positions and the same collapses.
+  size_t vertexCount = input.positions.size();
+  double minimum[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+  double maximum[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      minimum[k] = std::min(minimum[k], (double) input.positions[v].v[k]);
+      maximum[k] = std::max(maximum[k], (double) input.positions[v].v[k]);
+    }
+  }
+  double center[3] = { 0.0, 0.0, 0.0 };
+  double extent = 0.0;
+  for (int k = 0; k < 3 && vertexCount > 0; ++k)
+  {
+    center[k] = (minimum[k] + maximum[k]) * 0.5;
+    extent = std::max(extent, maximum[k] - minimum[k]);
+  }
+  m_scale = extent > 0.0 ? (float) extent : 1.0f;
+
+  m_positions.resize(vertexCount * 3);
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      m_positions[v * 3 + k] = (float) ((input.positions[v].v[k] - center[k]) / m_scale);
+    }
+  }
+
+  m_indices.clear();
+  m_indices.reserve(input.indices.size());
+  for (size_t i = 0; i + 2 < input.indices.size(); i += 3)
+  {
+    unsigned int a = input.indices[i], b = input.indices[i + 1], c = input.indices[i + 2];
+    if (a != b && b != c && a != c)
+    {
+      m_indices.push_back(a);
+      m_indices.push_back(b);
+      m_indices.push_back(c);
+    }
+  }
+
+  // Every pass walks the triangles and their neighbourhoods, which stay
+  // close in memory in cache friendly order.
+  if (!m_indices.empty())
+  {
+    MeshOptimizer::optimizeVertexCache(&m_indices[0], m_indices.size(), vertexCount);
+  }
+
+  m_error = 0.0f;
+  buildAdjacency();
+  classifyVertices(input, pPool);
+  computeQuadrics(pPool);
+}
+
+/*
+ * Build the list of triangles using every vertex.
+ */
+void MeshSimplifier::buildAdjacency()
+{
+  size_t vertexCount = m_positions.size() / 3;
+  m_offsets.assign(vertexCount + 1, 0);
+  for (size_t i = 0; i < m_indices.size(); ++i)
+  {
+    ++m_offsets[m_indices[i] + 1];
+  }
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    m_offsets[v + 1] += m_offsets[v];
+  }
+
+  m_adjacency.resize(m_indices.size());
+  std::vector<unsigned int> fill(m_offsets.begin(), m_offsets.end() - 1);
+  for (size_t i = 0; i < m_indices.size(); ++i)
+  {
+    m_adjacency[fill[m_indices[i]]++] = (unsigned int) (i / 3);
+  }
+}
+
+/*
+ * Number of triangles containing the edge between two vertices.
+ */
+unsigned int MeshSimplifier::countEdgeTriangles(unsigned int a, unsigned int b) const
+{
+  if (m_offsets[a + 1] - m_offsets[a] > m_offsets[b + 1] - m_offsets[b])
+  {
+    std::swap(a, b);
+  }
+  unsigned int count = 0;
+  for (unsigned int i = m_offsets[a]; i < m_offsets[a + 1]; ++i)
+  {
+    const unsigned int* pTriangle = &m_indices[m_adjacency[i] * 3];
+    count += pTriangle[0] == b || pTriangle[1] == b || pTriangle[2] == b;
+  }
+  return count;
+}
+
+/*
+ * Lock vertices sharing their position with another vertex (attribute
+ * seams) or lying on non-manifold edges, and mark the border vertices.
+ */
+void MeshSimplifier::classifyVertices(const Mesh& input, ThreadPool* pPool)
+{
+  size_t vertexCount = input.positions.size();
+  m_kinds.assign(vertexCount, VERTEX_INTERIOR);
+  if (vertexCount == 0)
+  {
+    return;
+  }
+
+  std::vector<Vector3f> unique;
+  m_welder.weld(&input.positions[0], vertexCount, 0.0f, m_remap, unique, pPool);
+  std::vector<unsigned int> shared(unique.size(), 0);
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    ++shared[m_remap[v]];
+  }
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    if (shared[m_remap[v]] > 1)
+    {
+      m_kinds[v] = VERTEX_LOCKED;
+    }
+  }
+
+  ThreadPool::RangeTask classify = [this](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v)
+    {
+      if (m_kinds[v] == VERTEX_LOCKED)
+      {
+        continue;
+      }
+      for (unsigned int i = m_offsets[v]; i < m_offsets[v + 1]; ++i)
+      {
+        const unsigned int* pTriangle = &m_indices[m_adjacency[i] * 3];
+        for (int k = 0; k < 3; ++k)
+        {
+          if (pTriangle[k] == v)
+          {
+            continue;
+          }
+          unsigned int count = countEdgeTriangles((unsigned int) v, pTriangle[k]);
+          if (count > 2)
+          {
+            m_kinds[v] = VERTEX_LOCKED;
+          }
+          else if (count == 1 && m_kinds[v] == VERTEX_INTERIOR)
+          {
+            m_kinds[v] = VERTEX_BORDER;
+          }
+        }
+      }
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, vertexCount, GRAIN_SIZE, classify);
+  }
+  else
+  {
+    classify(0, vertexCount);
+  }
+}
+
+/*
+ * Accumulate the quadric of every vertex from its triangles. Each vertex
+ * gathers its own, so the vertices are processed in parallel.
+ */
+void MeshSimplifier::computeQuadrics(ThreadPool* pPool)
+{
+  size_t vertexCount = m_positions.size() / 3;
+  m_quadrics.resize(vertexCount);
+
+  ThreadPool::RangeTask accumulate = [this](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v)
+    {
+      Quadric q;
+      memset(&q, 0, sizeof(q));
+      for (unsigned int i = m_offsets[v]; i < m_offsets[v + 1]; ++i)
+      {
+        const unsigned int* pTriangle = &m_indices[m_adjacency[i] * 3];
+        const float* p[3] = { &m_positions[pTriangle[0] * 3], &m_positions[pTriangle[1] * 3],
+                              &m_positions[pTriangle[2] * 3] };
+        float n[3];
+        cross(p[0], p[1], p[2], n);
+        float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length <= 0.0f)
+        {
+          continue;
+        }
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+
+        // Planes through the border edges of this vertex, perpendicular to
+        // the triangle, keep the outline in place.
+        float planes[3][5];
+        int planeCount = 0;
+        planes[planeCount][0] = n[0];
+        planes[planeCount][1] = n[1];
+        planes[planeCount][2] = n[2];
+        planes[planeCount][3] = -(n[0] * p[0][0] + n[1] * p[0][1] + n[2] * p[0][2]);
+        planes[planeCount++][4] = length * 0.5f;
+
+        for (int k = 0; k < 3; ++k)
+        {
+          unsigned int a = pTriangle[k], b = pTriangle[(k + 1) % 3];
+          if ((a != v && b != v) || m_kinds[a] == VERTEX_INTERIOR ||
+              m_kinds[b] == VERTEX_INTERIOR || countEdgeTriangles(a, b) != 1)
+          {
+            continue;
+          }
+          const float* pa = &m_positions[a * 3];
+          const float* pb = &m_positions[b * 3];
+          float e[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+          float m[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2],
+                         e[0] * n[1] - e[1] * n[0] };
+          float edgeSqr = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+          float mLength = sqrtf(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+          if (mLength <= 0.0f)
+          {
+            continue;
+          }
+          planes[planeCount][0] = m[0] / mLength;
+          planes[planeCount][1] = m[1] / mLength;
+          planes[planeCount][2] = m[2] / mLength;
+          planes[planeCount][3] = -(planes[planeCount][0] * pa[0] +
+                                    planes[planeCount][1] * pa[1] +
+                                    planes[planeCount][2] * pa[2]);
+          planes[planeCount++][4] = edgeSqr * BORDER_WEIGHT;
+        }
+
+        for (int k = 0; k < planeCount; ++k)
+        {
+          float a = planes[k][0], b = planes[k][1], c = planes[k][2];
+          float d = planes[k][3], w = planes[k][4];
+          q.a2 += w * a * a;
+          q.b2 += w * b * b;
+          q.c2 += w * c * c;
+          q.d2 += w * d * d;
+          q.ab += w * a * b;
+          q.ac += w * a * c;
+          q.ad += w * a * d;
+          q.bc += w * b * c;
+          q.bd += w * b * d;
+          q.cd += w * c * d;
+          q.weight += w;
+        }
+      }
+      m_quadrics[v] = q;
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, vertexCount, GRAIN_SIZE, accumulate);
+  }
+  else
+  {
+    accumulate(0, vertexCount);
+  }
+}
+
+/*
+ * Compute the cost of collapsing one vertex into another. Only the kinds of
+ * the vertices are checked here, see isCollapseValid().
+ */
+bool MeshSimplifier::computeCost(unsigned int from, unsigned int to,
+                                 unsigned int edgeTriangles, float& cost) const
+{
+  unsigned char kind = m_kinds[from];
+  if (kind == VERTEX_LOCKED)
+  {
+    return false;
+  }
+
+  // Border vertices move along the border, interior ones across manifold
+  // edges only.
+  if (edgeTriangles != (kind == VERTEX_BORDER ? 1u : 2u))
+  {
+    return false;
+  }
+
+  const float* pTarget = &m_positions[to * 3];
+  const Quadric& a = m_quadrics[from];
+  const Quadric& b = m_quadrics[to];
+  float x = pTarget[0], y = pTarget[1], z = pTarget[2];
+  float error =
+    (a.a2 + b.a2) * x * x + (a.b2 + b.b2) * y * y + (a.c2 + b.c2) * z * z +
+    2.0f * ((a.ab + b.ab) * x * y + (a.ac + b.ac) * x * z + (a.bc + b.bc) * y * z +
+            (a.ad + b.ad) * x + (a.bd + b.bd) * y + (a.cd + b.cd) * z) +
+    (a.d2 + b.d2);
+  float weight = a.weight + b.weight;
+  cost = weight > 0.0f && error > 0.0f ? error / weight : 0.0f;
+  return true;
+}
+
+/*
+ * Check that a collapse keeps the surface manifold and does not flip
+ * triangles. Only needed for the few collapses that are applied.
+ */
+bool MeshSimplifier::isCollapseValid(unsigned int from, unsigned int to) const
+{
+  unsigned int edgeTriangles = m_kinds[from] == VERTEX_BORDER ? 1 : 2;
+
+  // Link condition: the end points may only share the neighbours opposite
+  // to the edge, otherwise the collapse pinches the surface.
+  unsigned int ringFrom[MAX_RING], ringTo[MAX_RING];
+  unsigned int sizeFrom, sizeTo;
+  if (!collectRing(&m_indices[0], &m_adjacency[m_offsets[from]],
+                   m_offsets[from + 1] - m_offsets[from], from, ringFrom, sizeFrom) ||
+      !collectRing(&m_indices[0], &m_adjacency[m_offsets[to]],
+                   m_offsets[to + 1] - m_offsets[to], to, ringTo, sizeTo))
+  {
+    return false;
+  }
+  unsigned int common = 0;
+  for (unsigned int i = 0, j = 0; i < sizeFrom && j < sizeTo;)
+  {
+    if (ringFrom[i] == ringTo[j])
+    {
+      ++common;
+      ++i;
+      ++j;
+    }
+    else if (ringFrom[i] < ringTo[j])
+    {
+      ++i;
+    }
+    else
+    {
+      ++j;
+    }
+  }
+  if (common != edgeTriangles)
+  {
+    return false;
+  }
+
+  // Reject triangles that would flip or turn too far.
+  const float* pTarget = &m_positions[to * 3];
+  for (unsigned int i = m_offsets[from]; i < m_offsets[from + 1]; ++i)
+  {
+    const unsigned int* pTriangle = &m_indices[m_adjacency[i] * 3];
+    if (pTriangle[0] == to || pTriangle[1] == to || pTriangle[2] == to)
+    {
+      continue;
+    }
+    const float* p[3];
+    const float* q[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      p[k] = &m_positions[pTriangle[k] * 3];
+      q[k] = pTriangle[k] == from ? pTarget : p[k];
+    }
+    float before[3], after[3];
+    cross(p[0], p[1], p[2], before);
+    cross(q[0], q[1], q[2], after);
+    float dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+    float lengths = sqrtf((before[0] * before[0] + before[1] * before[1] + before[2] * before[2]) *
+                          (after[0] * after[0] + after[1] * after[1] + after[2] * after[2]));
+    if (!(lengths > 0.0f) || dot < MIN_NORMAL_COSINE * lengths)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Compute the cost of both directions of every edge. Interior edges are
+ * seen by two triangles, only the one with the increasing vertex order
+ * evaluates them.
+ */
+void MeshSimplifier::evaluateCollapses(ThreadPool* pPool)
+{
+  size_t triangleCount = m_indices.size() / 3;
+  m_collapses.resize(triangleCount * 6);
+
+  ThreadPool::RangeTask evaluate = [this](size_t begin, size_t end) {
+    for (size_t t = begin; t < end; ++t)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        unsigned int a = m_indices[t * 3 + k];
+        unsigned int b = m_indices[t * 3 + (k + 1) % 3];
+        bool isLocked = m_kinds[a] == VERTEX_LOCKED && m_kinds[b] == VERTEX_LOCKED;
+        unsigned int edgeTriangles = isLocked ? 0 : countEdgeTriangles(a, b);
+        bool isEvaluated = !isLocked && (a < b || edgeTriangles == 1);
+        for (int direction = 0; direction < 2; ++direction)
+        {
+          Collapse& collapse = m_collapses[t * 6 + k * 2 + direction];
+          collapse.from = direction == 0 ? a : b;
+          collapse.to = direction == 0 ? b : a;
+          if (!isEvaluated ||
+              !computeCost(collapse.from, collapse.to, edgeTriangles, collapse.cost))
+          {
+            collapse.from = INVALID_INDEX;
+          }
+        }
+      }
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, triangleCount, GRAIN_SIZE / 4, evaluate);
+  }
+  else
+  {
+    evaluate(0, triangleCount);
+  }
+}
+
+/*
+ * Order the valid collapses by cost with a counting sort on the upper bits
+ * of the cost. Costs are not negative, so their bits sort like integers;
+ * eleven bits keep the exponent and the first mantissa bits, which is
+ * close enough for the greedy selection and takes a single pass.
+ */
+void MeshSimplifier::sortCollapses()
+{
+  unsigned int histogram[SORT_BUCKETS + 1];
+  memset(histogram, 0, sizeof(histogram));
+  size_t valid = 0;
+  for (size_t i = 0; i < m_collapses.size(); ++i)
+  {
+    if (m_collapses[i].from != INVALID_INDEX)
+    {
+      ++histogram[sortKey(m_collapses[i].cost) + 1];
+      ++valid;
+    }
+  }
+  for (unsigned int b = 0; b < SORT_BUCKETS; ++b)
+  {
+    histogram[b + 1] += histogram[b];
+  }
+
+  m_sorted.resize(valid);
+  for (size_t i = 0; i < m_collapses.size(); ++i)
+  {
+    if (m_collapses[i].from != INVALID_INDEX)
+    {
+      m_sorted[histogram[sortKey(m_collapses[i].cost)]++] = m_collapses[i];
+    }
+  }
+}
+
+/*
+ * Apply the cheapest collapses with disjoint neighbourhoods.
+ *
+ * Returns the number of collapses, 0 when the target or the error limit
+ * has been reached.
+ */
+size_t MeshSimplifier::runPass(size_t targetTriangles, float maxError, ThreadPool* pPool)
+{
+  size_t triangleCount = m_indices.size() / 3;
+  if (triangleCount <= targetTriangles)
+  {
+    return 0;
+  }
+
+  evaluateCollapses(pPool);
+  sortCollapses();
+
+  size_t vertexCount = m_positions.size() / 3;
+  m_isTouched.assign(vertexCount, 0);
+  m_remap.resize(vertexCount);
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    m_remap[v] = (unsigned int) v;
+  }
+
+  float maxCost = maxError / m_scale * (maxError / m_scale);
+  size_t collapsed = 0;
+  for (size_t i = 0; i < m_sorted.size() && triangleCount > targetTriangles; ++i)
+  {
+    const Collapse& c = m_sorted[i];
+    if (c.cost > maxCost)
+    {
+      break;
+    }
+    if (m_isTouched[c.from] || m_isTouched[c.to] || !isCollapseValid(c.from, c.to))
+    {
+      continue;
+    }
+
+    // The one ring of the moving vertex is frozen for the rest of the pass,
+    // so the checks made against the old triangles stay valid.
+    for (unsigned int a = m_offsets[c.from]; a < m_offsets[c.from + 1]; ++a)
+    {
+      const unsigned int* pTriangle = &m_indices[m_adjacency[a] * 3];
+      m_isTouched[pTriangle[0]] = 1;
+      m_isTouched[pTriangle[1]] = 1;
+      m_isTouched[pTriangle[2]] = 1;
+    }
+
+    m_remap[c.from] = c.to;
+    triangleCount -= countEdgeTriangles(c.from, c.to);
+    Quadric& q = m_quadrics[c.to];
+    const Quadric& r = m_quadrics[c.from];
+    q.a2 += r.a2; q.b2 += r.b2; q.c2 += r.c2; q.d2 += r.d2;
+    q.ab += r.ab; q.ac += r.ac; q.ad += r.ad;
+    q.bc += r.bc; q.bd += r.bd; q.cd += r.cd;
+    q.weight += r.weight;
+    m_error = std::max(m_error, sqrtf(c.cost) * m_scale);
+    ++collapsed;
+  }
+
+  if (collapsed == 0)
+  {
+    return 0;
+  }
+
+  size_t out = 0;
+  for (size_t i = 0; i < m_indices.size(); i += 3)
+  {
+    unsigned int a = m_remap[m_indices[i]];
+    unsigned int b = m_remap[m_indices[i + 1]];
+    unsigned int c = m_remap[m_indices[i + 2]];
+    if (a != b && b != c && a != c)
+    {
+      m_indices[out++] = a;
+      m_indices[out++] = b;
+      m_indices[out++] = c;
+    }
+  }
+  m_indices.resize(out);
+  buildAdjacency();
+  return collapsed;
+}
+
+/*
+ * Copy the remaining triangles and the vertices they use.
+ */
+void MeshSimplifier::extract(const Mesh& input, Mesh& output) const
+{
+  size_t vertexCount = m_positions.size() / 3;
+  std::vector<unsigned int> remap(vertexCount, INVALID_INDEX);
+  for (size_t i = 0; i < m_indices.size(); ++i)
+  {
+    remap[m_indices[i]] = 0;
+  }
+
+  output.clear();
+  unsigned int next = 0;
+  for (size_t v = 0; v < vertexCount; ++v)
+  {
+    if (remap[v] == INVALID_INDEX)
+    {
+      continue;
+    }
+    remap[v] = next++;
+    output.positions.push_back(input.positions[v]);
+    if (input.hasNormals())
+    {
+      output.normals.push_back(input.normals[v]);
+    }
+    if (input.hasUVs())
+    {
+      output.uvs.push_back(input.uvs[v]);
+    }
+  }
+
+  output.indices.resize(m_indices.size());
+  for (size_t i = 0; i < m_indices.size(); ++i)
+  {
+    output.indices[i] = remap[m_indices[i]];
+  }
+}
+
+}
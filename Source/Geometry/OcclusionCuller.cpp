@@ -0,0 +1,807 @@
+/**
+ * @file OcclusionCuller.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the OcclusionCuller class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\OcclusionCuller.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+
+#if defined(LITE_AVX2)
+#include <immintrin.h>
+#elif defined(LITE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+// Buffer widths are a multiple of this so rows split evenly into vectors.
+static const int WIDTH_ALIGNMENT = 8;
+
+// Boxes tested per task.
+static const size_t BOX_GRAIN_SIZE = 1024;
+
+// Levels refined below the one where a box covers 2x2 texels.
+static const unsigned int REFINE_LEVELS = 2;
+
+// Triangles smaller than this in pixels squared are skipped.
+static const float MIN_AREA = 1e-6f;
+
+/*
+ * Convert a projected coordinate to int, clamped to a range before the
+ * conversion so that huge values stay defined. NaN goes to the minimum.
+ */
+static int clampToInt(float value, int minimum, int maximum)
+{
+  return value > (float) minimum ? (value < (float) maximum ? (int) value : maximum) : minimum;
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] width  - depth buffer width, rounded up to a multiple of 8
+ * @param[in] height - depth buffer height
+ */
+OcclusionCuller::OcclusionCuller(int width, int height)
+  : m_width((std::max(width, 1) + WIDTH_ALIGNMENT - 1) / WIDTH_ALIGNMENT * WIDTH_ALIGNMENT)
+  , m_height(std::max(height, 1))
+  , m_eye(0.0f, 0.0f, 0.0f)
+  , m_scaleX(1.0f)
+  , m_scaleY(1.0f)
+  , m_nearPlane(0.1f)
+{
+  m_depth.resize((size_t) m_width * m_height, 0.0f);
+  m_bins.resize((m_height + BAND_HEIGHT - 1) / BAND_HEIGHT);
+
+  // Level 0 is the depth buffer itself, its entry stays empty.
+  m_levels.resize(1);
+  m_levels[0].width  = m_width;
+  m_levels[0].height = m_height;
+  while (m_levels.back().width > 1 || m_levels.back().height > 1)
+  {
+    Level level;
+    level.width  = (m_levels.back().width + 1) / 2;
+    level.height = (m_levels.back().height + 1) / 2;
+    level.farthest.resize((size_t) level.width * level.height, 0.0f);
+    level.nearest.resize((size_t) level.width * level.height, 0.0f);
+    m_levels.push_back(level);
+  }
+
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      m_axes[i][j] = i == j ? 1.0f : 0.0f;
+    }
+  }
+}
+
+/**
+ * @brief Set the camera for the following occluders and tests.
+ *
+ * @param[in] eye       - camera position
+ * @param[in] target    - point the camera looks at
+ * @param[in] up        - approximate up direction
+ * @param[in] fovY      - vertical field of view in radians
+ * @param[in] nearPlane - distance of the near plane
+ */
+void OcclusionCuller::setCamera(const Vector3f& eye, const Vector3f& target, const Vector3f& up,
+                                float fovY, float nearPlane)
+{
+  float forward[3] = { target.x - eye.x, target.y - eye.y, target.z - eye.z };
+  float right[3] = { forward[1] * up.z - forward[2] * up.y,
+                     forward[2] * up.x - forward[0] * up.z,
+                     forward[0] * up.y - forward[1] * up.x };
+  float forwardLength = sqrtf(forward[0] * forward[0] + forward[1] * forward[1] + forward[2] * forward[2]);
+  float rightLength = sqrtf(right[0] * right[0] + right[1] * right[1] + right[2] * right[2]);
+  for (int i = 0; i < 3; ++i)
+  {
+    forward[i] /= forwardLength;
+    right[i] /= rightLength;
+  }
+
+  m_eye = eye;
+  for (int i = 0; i < 3; ++i)
+  {
+    m_axes[0][i] = right[i];
+    m_axes[2][i] = forward[i];
+  }
+  m_axes[1][0] = right[1] * forward[2] - right[2] * forward[1];
+  m_axes[1][1] = right[2] * forward[0] - right[0] * forward[2];
+  m_axes[1][2] = right[0] * forward[1] - right[1] * forward[0];
+
+  // Square pixels, the horizontal field of view follows the aspect ratio.
+  m_scaleY = m_height * 0.5f / tanf(fovY * 0.5f);
+  m_scaleX = m_scaleY;
+  m_nearPlane = nearPlane;
+}
+
+/**
+ * @brief Remove all occluders.
+ */
+void OcclusionCuller::clear()
+{
+  m_triangles.clear();
+}
+
+/**
+ * @brief Add an indexed occluder mesh.
+ *
+ * The triangles are transformed with the current camera and clipped
+ * against the near plane right away. Both sides of a triangle occlude.
+ *
+ * @param[in] pVertices  - vertex positions
+ * @param[in] pIndices   - three indices per triangle
+ * @param[in] indexCount - number of indices
+ */
+void OcclusionCuller::addOccluders(const Vector3f* pVertices, const unsigned int* pIndices,
+                                   size_t indexCount)
+{
+  for (size_t i = 0; i + 2 < indexCount; i += 3)
+  {
+    float view[3][3];
+    int behind = 0;
+    for (int k = 0; k < 3; ++k)
+    {
+      const Vector3f& vertex = pVertices[pIndices[i + k]];
+      float offset[3] = { vertex.x - m_eye.x, vertex.y - m_eye.y, vertex.z - m_eye.z };
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        view[k][axis] = m_axes[axis][0] * offset[0] + m_axes[axis][1] * offset[1] +
+                        m_axes[axis][2] * offset[2];
+      }
+      behind += view[k][2] < m_nearPlane ? 1 : 0;
+    }
+
+    if (behind == 0)
+    {
+      addTriangle(view[0], view[1], view[2]);
+      continue;
+    }
+    if (behind == 3)
+    {
+      continue;
+    }
+
+    // Clip the triangle against the near plane, which leaves a triangle or
+    // a quad.
+    float polygon[4][3];
+    int count = 0;
+    for (int k = 0; k < 3; ++k)
+    {
+      const float* pA = view[k];
+      const float* pB = view[(k + 1) % 3];
+      bool isInsideA = pA[2] >= m_nearPlane, isInsideB = pB[2] >= m_nearPlane;
+      if (isInsideA)
+      {
+        std::copy(pA, pA + 3, polygon[count++]);
+      }
+      if (isInsideA != isInsideB)
+      {
+        float t = (m_nearPlane - pA[2]) / (pB[2] - pA[2]);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          polygon[count][axis] = pA[axis] + (pB[axis] - pA[axis]) * t;
+        }
+        polygon[count++][2] = m_nearPlane;
+      }
+    }
+
+    for (int k = 2; k < count; ++k)
+    {
+      addTriangle(polygon[0], polygon[k - 1], polygon[k]);
+    }
+  }
+}
+
+/**
+ * @brief Rasterize the occluders and build the depth pyramid.
+ *
+ * @param[in] pPool - pool to rasterize on, NULL to run on the calling thread
+ */
+void OcclusionCuller::rasterize(ThreadPool* pPool)
+{
+  LITE_PROFILE_ZONE("OcclusionCuller::rasterize");
+
+  // Bin the triangles into bands of rows, each band is then rasterized
+  // by one task without synchronization.
+  for (size_t i = 0; i < m_bins.size(); ++i)
+  {
+    m_bins[i].clear();
+  }
+  for (size_t i = 0; i < m_triangles.size(); ++i)
+  {
+    const ScreenTriangle& triangle = m_triangles[i];
+    float minY = std::min(triangle.y[0], std::min(triangle.y[1], triangle.y[2]));
+    float maxY = std::max(triangle.y[0], std::max(triangle.y[1], triangle.y[2]));
+    if (!(maxY >= 0.0f && minY < (float) m_height))
+    {
+      continue;
+    }
+    int first = clampToInt(minY, 0, m_height - 1) / BAND_HEIGHT;
+    int last = clampToInt(maxY, 0, m_height - 1) / BAND_HEIGHT;
+    for (int band = first; band <= last; ++band)
+    {
+      m_bins[band].push_back((unsigned int) i);
+    }
+  }
+
+  ThreadPool::RangeTask bandTask = [this](size_t begin, size_t end) {
+    for (size_t band = begin; band < end; ++band)
+    {
+      rasterizeBand((int) band);
+    }
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, m_bins.size(), 1, bandTask);
+  }
+  else
+  {
+    bandTask(0, m_bins.size());
+  }
+
+  for (unsigned int level = 1; level < m_levels.size(); ++level)
+  {
+    ThreadPool::RangeTask levelTask = [this, level](size_t begin, size_t end) {
+      buildLevel(level, (int) begin, (int) end);
+    };
+    size_t rows = m_levels[level].height;
+    if (pPool != NULL && rows >= 2 * BAND_HEIGHT)
+    {
+      pPool->parallelFor(0, rows, BAND_HEIGHT, levelTask);
+    }
+    else
+    {
+      levelTask(0, rows);
+    }
+  }
+}
+
+/**
+ * @brief Test a single box against the occluders.
+ *
+ * @param[in] box - the box to test
+ * @return false if the box is occluded or outside the view
+ */
+bool OcclusionCuller::isVisible(const AABB& box) const
+{
+  return testBox(box) == RESULT_VISIBLE;
+}
+
+/**
+ * @brief Test a batch of boxes against the occluders.
+ *
+ * @param[in]  pBoxes   - the boxes to test
+ * @param[in]  count    - number of boxes
+ * @param[out] pVisible - receives 1 for every visible box and 0 otherwise
+ * @param[in]  pPool    - pool to test on, NULL to run on the calling thread
+ * @return number of visible, occluded and out of view boxes
+ */
+OcclusionCuller::Stats OcclusionCuller::testBoxes(const AABB* pBoxes, size_t count,
+                                                  unsigned char* pVisible,
+                                                  ThreadPool* pPool) const
+{
+  LITE_PROFILE_ZONE("OcclusionCuller::testBoxes");
+  std::atomic<size_t> visible(0), occluded(0);
+
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end) {
+    size_t visibleCount = 0, occludedCount = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      Result result = testBox(pBoxes[i]);
+      pVisible[i] = result == RESULT_VISIBLE ? 1 : 0;
+      visibleCount += result == RESULT_VISIBLE ? 1 : 0;
+      occludedCount += result == RESULT_OCCLUDED ? 1 : 0;
+    }
+    visible += visibleCount;
+    occluded += occludedCount;
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, BOX_GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, count);
+  }
+
+  Stats stats;
+  stats.tested   = count;
+  stats.visible  = visible.load();
+  stats.occluded = occluded.load();
+  stats.outside  = count - stats.visible - stats.occluded;
+  return stats;
+}
+
+/**
+ * @brief Obtain the width of the depth buffer.
+ *
+ * @return width in pixels, a multiple of 8
+ */
+int OcclusionCuller::getWidth() const
+{
+  return m_width;
+}
+
+/**
+ * @brief Obtain the height of the depth buffer.
+ *
+ * @return height in pixels
+ */
+int OcclusionCuller::getHeight() const
+{
+  return m_height;
+}
+
+/**
+ * @brief Obtain the number of occluder triangles after clipping.
+ *
+ * @return triangle count
+ */
+size_t OcclusionCuller::getTriangleCount() const
+{
+  return m_triangles.size();
+}
+
+/**
+ * @brief Obtain the number of pyramid levels, including the depth buffer.
+ *
+ * @return level count
+ */
+unsigned int OcclusionCuller::getLevelCount() const
+{
+  return (unsigned int) m_levels.size();
+}
+
+/**
+ * @brief Obtain the farthest reciprocal depth per texel of a level.
+ *
+ * Level 0 is the depth buffer. Texels without occluders hold 0.
+ *
+ * @param[in] level - pyramid level
+ * @return row major texels of the level
+ */
+const float* OcclusionCuller::getDepth(unsigned int level) const
+{
+  return level == 0 ? &m_depth[0] : &m_levels[level].farthest[0];
+}
+
+/**
+ * @brief Obtain the view depth of the nearest occluder at a pixel.
+ *
+ * @param[in] x - pixel column
+ * @param[in] y - pixel row, 0 is the top
+ * @return view depth or FLT_MAX if no occluder covers the pixel
+ */
+float OcclusionCuller::getViewDepth(int x, int y) const
+{
+  float depth = m_depth[(size_t) y * m_width + x];
+  return depth > 0.0f ? 1.0f / depth : FLT_MAX;
+}
+
+/*
+ * Project a triangle in front of the near plane and keep it if it covers
+ * part of the screen.
+ */
+void OcclusionCuller::addTriangle(const float* pView0, const float* pView1, const float* pView2)
+{
+  ScreenTriangle triangle;
+  const float* views[3] = { pView0, pView1, pView2 };
+  for (int k = 0; k < 3; ++k)
+  {
+    float screen[3];
+    project(views[k], screen);
+    triangle.x[k] = screen[0];
+    triangle.y[k] = screen[1];
+    triangle.depth[k] = screen[2];
+  }
+
+  float minX = std::min(triangle.x[0], std::min(triangle.x[1], triangle.x[2]));
+  float maxX = std::max(triangle.x[0], std::max(triangle.x[1], triangle.x[2]));
+  float minY = std::min(triangle.y[0], std::min(triangle.y[1], triangle.y[2]));
+  float maxY = std::max(triangle.y[0], std::max(triangle.y[1], triangle.y[2]));
+  float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+               (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+  if (maxX < 0.0f || maxY < 0.0f || minX >= m_width || minY >= m_height ||
+      fabsf(area) < MIN_AREA)
+  {
+    return;
+  }
+  m_triangles.push_back(triangle);
+}
+
+/*
+ * View space to pixel coordinates and reciprocal depth.
+ */
+void OcclusionCuller::project(const float* pView, float* pScreen) const
+{
+  float inverseDepth = 1.0f / pView[2];
+  pScreen[0] = m_width * 0.5f + pView[0] * m_scaleX * inverseDepth;
+  pScreen[1] = m_height * 0.5f - pView[1] * m_scaleY * inverseDepth;
+  pScreen[2] = inverseDepth;
+}
+
+/*
+ * Rasterize the triangles binned to a band of rows. A pixel is covered when
+ * its center lies inside the triangle and keeps the nearest depth.
+ */
+void OcclusionCuller::rasterizeBand(int band)
+{
+  int bandBegin = band * BAND_HEIGHT;
+  int bandEnd = std::min(bandBegin + BAND_HEIGHT, m_height);
+  std::fill(m_depth.begin() + (size_t) bandBegin * m_width,
+            m_depth.begin() + (size_t) bandEnd * m_width, 0.0f);
+
+  const std::vector<unsigned int>& bin = m_bins[band];
+  for (size_t t = 0; t < bin.size(); ++t)
+  {
+    const ScreenTriangle& triangle = m_triangles[bin[t]];
+    float x[3] = { triangle.x[0], triangle.x[1], triangle.x[2] };
+    float y[3] = { triangle.y[0], triangle.y[1], triangle.y[2] };
+    float d[3] = { triangle.depth[0], triangle.depth[1], triangle.depth[2] };
+
+    // Double sided: flip clockwise triangles so the inside is positive.
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (area < 0.0f)
+    {
+      std::swap(x[1], x[2]);
+      std::swap(y[1], y[2]);
+      std::swap(d[1], d[2]);
+      area = -area;
+    }
+
+    // Edge k is opposite to vertex k: E(x, y) = a * x + b * y + c.
+    float a[3], b[3], c[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      int i0 = (k + 1) % 3, i1 = (k + 2) % 3;
+      a[k] = y[i0] - y[i1];
+      b[k] = x[i1] - x[i0];
+      c[k] = -(a[k] * x[i0] + b[k] * y[i0]);
+    }
+    float inverseArea = 1.0f / area;
+    float depthA = (a[0] * d[0] + a[1] * d[1] + a[2] * d[2]) * inverseArea;
+    float depthB = (b[0] * d[0] + b[1] * d[1] + b[2] * d[2]) * inverseArea;
+    float depthC = (c[0] * d[0] + c[1] * d[1] + c[2] * d[2]) * inverseArea;
+
+    float minX = std::min(x[0], std::min(x[1], x[2]));
+    float maxX = std::max(x[0], std::max(x[1], x[2]));
+    float minY = std::min(y[0], std::min(y[1], y[2]));
+    float maxY = std::max(y[0], std::max(y[1], y[2]));
+    int beginX = clampToInt(floorf(minX), 0, m_width) & ~(WIDTH_ALIGNMENT - 1);
+    int endX = clampToInt(ceilf(maxX) + 1.0f, 0, m_width);
+    int beginY = clampToInt(floorf(minY), bandBegin, bandEnd);
+    int endY = clampToInt(ceilf(maxY) + 1.0f, bandBegin, bandEnd);
+
+    for (int row = beginY; row < endY; ++row)
+    {
+      // Narrow the row to the span between the edges, the edge tests below
+      // still decide coverage.
+      float py = row + 0.5f;
+      float spanBegin = (float) beginX, spanEnd = (float) endX;
+      for (int k = 0; k < 3; ++k)
+      {
+        float edge = b[k] * py + c[k];
+        if (a[k] > 0.0f)
+        {
+          spanBegin = std::max(spanBegin, -edge / a[k] - 1.0f);
+        }
+        else if (a[k] < 0.0f)
+        {
+          spanEnd = std::min(spanEnd, -edge / a[k] + 1.0f);
+        }
+        else if (edge < 0.0f)
+        {
+          spanEnd = spanBegin;
+        }
+      }
+      if (spanBegin >= spanEnd)
+      {
+        continue;
+      }
+      int px = (int) spanBegin & ~(WIDTH_ALIGNMENT - 1);
+      int rowEnd = (int) spanEnd;
+
+      float* pDepth = &m_depth[(size_t) row * m_width];
+#if defined(LITE_AVX2)
+      __m256 offsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+      __m256 edges[3], steps[3];
+      for (int k = 0; k < 3; ++k)
+      {
+        edges[k] = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[k]),
+                                               _mm256_add_ps(_mm256_set1_ps((float) px), offsets)),
+                                 _mm256_set1_ps(b[k] * py + c[k]));
+        steps[k] = _mm256_set1_ps(a[k] * 8.0f);
+      }
+      __m256 depth = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(depthA),
+                                                 _mm256_add_ps(_mm256_set1_ps((float) px), offsets)),
+                                   _mm256_set1_ps(depthB * py + depthC));
+      __m256 depthStep = _mm256_set1_ps(depthA * 8.0f);
+      for (; px < rowEnd; px += 8)
+      {
+        // The sign bits of the three edges are set outside the triangle.
+        __m256 outside = _mm256_or_ps(edges[0], _mm256_or_ps(edges[1], edges[2]));
+        if (_mm256_movemask_ps(outside) != 0xFF)
+        {
+          __m256 current = _mm256_loadu_ps(pDepth + px);
+          __m256 nearer = _mm256_max_ps(current, depth);
+          _mm256_storeu_ps(pDepth + px, _mm256_blendv_ps(nearer, current, outside));
+        }
+        edges[0] = _mm256_add_ps(edges[0], steps[0]);
+        edges[1] = _mm256_add_ps(edges[1], steps[1]);
+        edges[2] = _mm256_add_ps(edges[2], steps[2]);
+        depth = _mm256_add_ps(depth, depthStep);
+      }
+#elif defined(LITE_SSE2)
+      __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+      __m128 edges[3], steps[3];
+      for (int k = 0; k < 3; ++k)
+      {
+        edges[k] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[k]),
+                                         _mm_add_ps(_mm_set1_ps((float) px), offsets)),
+                              _mm_set1_ps(b[k] * py + c[k]));
+        steps[k] = _mm_set1_ps(a[k] * 4.0f);
+      }
+      __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthA),
+                                           _mm_add_ps(_mm_set1_ps((float) px), offsets)),
+                                _mm_set1_ps(depthB * py + depthC));
+      __m128 depthStep = _mm_set1_ps(depthA * 4.0f);
+      __m128 zero = _mm_setzero_ps();
+      for (; px < rowEnd; px += 4)
+      {
+        __m128 inside = _mm_and_ps(_mm_cmpge_ps(edges[0], zero),
+                                   _mm_and_ps(_mm_cmpge_ps(edges[1], zero),
+                                              _mm_cmpge_ps(edges[2], zero)));
+        if (_mm_movemask_ps(inside) != 0)
+        {
+          __m128 current = _mm_loadu_ps(pDepth + px);
+          __m128 nearer = _mm_max_ps(current, depth);
+          _mm_storeu_ps(pDepth + px, _mm_or_ps(_mm_and_ps(inside, nearer),
+                                               _mm_andnot_ps(inside, current)));
+        }
+        edges[0] = _mm_add_ps(edges[0], steps[0]);
+        edges[1] = _mm_add_ps(edges[1], steps[1]);
+        edges[2] = _mm_add_ps(edges[2], steps[2]);
+        depth = _mm_add_ps(depth, depthStep);
+      }
+#endif
+      for (; px < rowEnd; ++px)
+      {
+        float cx = px + 0.5f;
+        if (a[0] * cx + b[0] * py + c[0] >= 0.0f && a[1] * cx + b[1] * py + c[1] >= 0.0f &&
+            a[2] * cx + b[2] * py + c[2] >= 0.0f)
+        {
+          pDepth[px] = std::max(pDepth[px], depthA * cx + depthB * py + depthC);
+        }
+      }
+    }
+  }
+}
+
+/*
+ * Reduce rows of the previous level into a level of the pyramid. Edge
+ * texels of odd sized levels reuse the last row or column.
+ */
+void OcclusionCuller::buildLevel(unsigned int level, int beginRow, int endRow)
+{
+  const Level& source = m_levels[level - 1];
+  Level& target = m_levels[level];
+  const float* pSourceFar = level == 1 ? &m_depth[0] : &source.farthest[0];
+  const float* pSourceNear = level == 1 ? &m_depth[0] : &source.nearest[0];
+
+  for (int y = beginRow; y < endRow; ++y)
+  {
+    size_t row0 = (size_t) (2 * y) * source.width;
+    size_t row1 = (size_t) std::min(2 * y + 1, source.height - 1) * source.width;
+    float* pFar = &target.farthest[(size_t) y * target.width];
+    float* pNear = &target.nearest[(size_t) y * target.width];
+
+    int x = 0;
+#ifdef LITE_SSE2
+    for (; 2 * x + 8 <= source.width; x += 4)
+    {
+      size_t offset = 2 * x;
+      __m128 far0 = _mm_min_ps(_mm_loadu_ps(pSourceFar + row0 + offset),
+                               _mm_loadu_ps(pSourceFar + row1 + offset));
+      __m128 far1 = _mm_min_ps(_mm_loadu_ps(pSourceFar + row0 + offset + 4),
+                               _mm_loadu_ps(pSourceFar + row1 + offset + 4));
+      _mm_storeu_ps(pFar + x, _mm_min_ps(_mm_shuffle_ps(far0, far1, _MM_SHUFFLE(2, 0, 2, 0)),
+                                         _mm_shuffle_ps(far0, far1, _MM_SHUFFLE(3, 1, 3, 1))));
+
+      __m128 near0 = _mm_max_ps(_mm_loadu_ps(pSourceNear + row0 + offset),
+                                _mm_loadu_ps(pSourceNear + row1 + offset));
+      __m128 near1 = _mm_max_ps(_mm_loadu_ps(pSourceNear + row0 + offset + 4),
+                                _mm_loadu_ps(pSourceNear + row1 + offset + 4));
+      _mm_storeu_ps(pNear + x, _mm_max_ps(_mm_shuffle_ps(near0, near1, _MM_SHUFFLE(2, 0, 2, 0)),
+                                          _mm_shuffle_ps(near0, near1, _MM_SHUFFLE(3, 1, 3, 1))));
+    }
+#endif
+    for (; x < target.width; ++x)
+    {
+      size_t x0 = 2 * x, x1 = std::min(2 * x + 1, source.width - 1);
+      pFar[x] = std::min(std::min(pSourceFar[row0 + x0], pSourceFar[row0 + x1]),
+                         std::min(pSourceFar[row1 + x0], pSourceFar[row1 + x1]));
+      pNear[x] = std::max(std::max(pSourceNear[row0 + x0], pSourceNear[row0 + x1]),
+                          std::max(pSourceNear[row1 + x0], pSourceNear[row1 + x1]));
+    }
+  }
+}
+
+/*
+ * Project the box and compare its nearest depth with the pyramid.
+ */
+OcclusionCuller::Result OcclusionCuller::testBox(const AABB& box) const
+{
+  // Reject against the frustum with the view space center and extent of
+  // the box before projecting any corner.
+  float center[3] = { (box.min.x + box.max.x) * 0.5f - m_eye.x,
+                      (box.min.y + box.max.y) * 0.5f - m_eye.y,
+                      (box.min.z + box.max.z) * 0.5f - m_eye.z };
+  float half[3] = { (box.max.x - box.min.x) * 0.5f, (box.max.y - box.min.y) * 0.5f,
+                    (box.max.z - box.min.z) * 0.5f };
+  float view[3], extent[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    view[axis] = m_axes[axis][0] * center[0] + m_axes[axis][1] * center[1] +
+                 m_axes[axis][2] * center[2];
+    extent[axis] = fabsf(m_axes[axis][0]) * half[0] + fabsf(m_axes[axis][1]) * half[1] +
+                   fabsf(m_axes[axis][2]) * half[2];
+  }
+
+  float halfWidth = m_width * 0.5f, halfHeight = m_height * 0.5f;
+  if (view[2] + extent[2] < m_nearPlane ||
+      fabsf(view[0]) * m_scaleX - view[2] * halfWidth > extent[0] * m_scaleX + extent[2] * halfWidth ||
+      fabsf(view[1]) * m_scaleY - view[2] * halfHeight > extent[1] * m_scaleY + extent[2] * halfHeight)
+  {
+    return RESULT_OUTSIDE;
+  }
+  float minDepth = view[2] - extent[2];
+  if (minDepth < m_nearPlane)
+  {
+    return RESULT_VISIBLE;
+  }
+
+  // Project the corners, a corner is the center plus or minus the view
+  // space half axes.
+  float axisX[3], axisY[3], axisZ[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    axisX[i] = m_axes[0][i] * half[i];
+    axisY[i] = m_axes[1][i] * half[i];
+    axisZ[i] = m_axes[2][i] * half[i];
+  }
+  float minX, maxX, minY, maxY;
+#ifdef LITE_SSE2
+  __m128 signs0 = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+  __m128 signs1 = _mm_setr_ps(-1.0f, -1.0f, 1.0f, 1.0f);
+  __m128 cornersX = _mm_add_ps(_mm_add_ps(_mm_set1_ps(view[0]),
+                                          _mm_mul_ps(signs0, _mm_set1_ps(axisX[0]))),
+                               _mm_mul_ps(signs1, _mm_set1_ps(axisX[1])));
+  __m128 cornersY = _mm_add_ps(_mm_add_ps(_mm_set1_ps(view[1]),
+                                          _mm_mul_ps(signs0, _mm_set1_ps(axisY[0]))),
+                               _mm_mul_ps(signs1, _mm_set1_ps(axisY[1])));
+  __m128 cornersZ = _mm_add_ps(_mm_add_ps(_mm_set1_ps(view[2]),
+                                          _mm_mul_ps(signs0, _mm_set1_ps(axisZ[0]))),
+                               _mm_mul_ps(signs1, _mm_set1_ps(axisZ[1])));
+  __m128 offsetX = _mm_set1_ps(axisX[2]), offsetY = _mm_set1_ps(axisY[2]);
+  __m128 offsetZ = _mm_set1_ps(axisZ[2]);
+  __m128 scaleX = _mm_set1_ps(m_scaleX), scaleY = _mm_set1_ps(-m_scaleY);
+
+  __m128 inverse0 = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sub_ps(cornersZ, offsetZ));
+  __m128 inverse1 = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(cornersZ, offsetZ));
+  __m128 screenX0 = _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(cornersX, offsetX), scaleX), inverse0);
+  __m128 screenX1 = _mm_mul_ps(_mm_mul_ps(_mm_add_ps(cornersX, offsetX), scaleX), inverse1);
+  __m128 screenY0 = _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(cornersY, offsetY), scaleY), inverse0);
+  __m128 screenY1 = _mm_mul_ps(_mm_mul_ps(_mm_add_ps(cornersY, offsetY), scaleY), inverse1);
+
+  __m128 lowX = _mm_min_ps(screenX0, screenX1), highX = _mm_max_ps(screenX0, screenX1);
+  __m128 lowY = _mm_min_ps(screenY0, screenY1), highY = _mm_max_ps(screenY0, screenY1);
+  lowX = _mm_min_ps(lowX, _mm_shuffle_ps(lowX, lowX, _MM_SHUFFLE(1, 0, 3, 2)));
+  highX = _mm_max_ps(highX, _mm_shuffle_ps(highX, highX, _MM_SHUFFLE(1, 0, 3, 2)));
+  lowY = _mm_min_ps(lowY, _mm_shuffle_ps(lowY, lowY, _MM_SHUFFLE(1, 0, 3, 2)));
+  highY = _mm_max_ps(highY, _mm_shuffle_ps(highY, highY, _MM_SHUFFLE(1, 0, 3, 2)));
+  minX = halfWidth + std::min(_mm_cvtss_f32(lowX), _mm_cvtss_f32(_mm_shuffle_ps(lowX, lowX, 1)));
+  maxX = halfWidth + std::max(_mm_cvtss_f32(highX), _mm_cvtss_f32(_mm_shuffle_ps(highX, highX, 1)));
+  minY = halfHeight + std::min(_mm_cvtss_f32(lowY), _mm_cvtss_f32(_mm_shuffle_ps(lowY, lowY, 1)));
+  maxY = halfHeight + std::max(_mm_cvtss_f32(highY), _mm_cvtss_f32(_mm_shuffle_ps(highY, highY, 1)));
+#else
+  minX = minY = FLT_MAX;
+  maxX = maxY = -FLT_MAX;
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    float corner3[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const float* pAxis = axis == 0 ? axisX : (axis == 1 ? axisY : axisZ);
+      corner3[axis] = view[axis] + ((corner & 1) ? pAxis[0] : -pAxis[0]) +
+                      ((corner & 2) ? pAxis[1] : -pAxis[1]) + ((corner & 4) ? pAxis[2] : -pAxis[2]);
+    }
+    float screen[3];
+    project(corner3, screen);
+    minX = std::min(minX, screen[0]);
+    maxX = std::max(maxX, screen[0]);
+    minY = std::min(minY, screen[1]);
+    maxY = std::max(maxY, screen[1]);
+  }
+#endif
+  if (maxX < 0.0f || maxY < 0.0f || minX >= m_width || minY >= m_height)
+  {
+    return RESULT_OUTSIDE;
+  }
+  if (!(minX <= maxX && minY <= maxY))
+  {
+    // NaN, nothing is known about the box.
+    return RESULT_VISIBLE;
+  }
+
+  int x0 = clampToInt(minX, 0, m_width - 1), x1 = clampToInt(maxX, 0, m_width - 1);
+  int y0 = clampToInt(minY, 0, m_height - 1), y1 = clampToInt(maxY, 0, m_height - 1);
+  float depth = 1.0f / minDepth;
+
+  unsigned int level = 0;
+  while (level + 1 < m_levels.size() &&
+         ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+  {
+    ++level;
+  }
+
+  int result = testRect(level, x0 >> level, y0 >> level, x1 >> level, y1 >> level, depth);
+  if (result < 0)
+  {
+    return RESULT_OCCLUDED;
+  }
+  if (result > 0 || level == 0)
+  {
+    return RESULT_VISIBLE;
+  }
+
+  level = level > REFINE_LEVELS ? level - REFINE_LEVELS : 0;
+  result = testRect(level, x0 >> level, y0 >> level, x1 >> level, y1 >> level, depth);
+  return result < 0 ? RESULT_OCCLUDED : RESULT_VISIBLE;
+}
+
+/*
+ * Compare a depth with a rectangle of texels. Returns -1 if every texel has
+ * all its occluders in front of the depth, 1 if some texel has all of them
+ * behind it, in which case no finer level can prove occlusion, and 0
+ * otherwise.
+ */
+int OcclusionCuller::testRect(unsigned int level, int x0, int y0, int x1, int y1,
+                              float depth) const
+{
+  const Level& rect = m_levels[level];
+  const float* pFar = level == 0 ? &m_depth[0] : &rect.farthest[0];
+  const float* pNear = level == 0 ? &m_depth[0] : &rect.nearest[0];
+
+  bool isOccluded = true;
+  for (int y = y0; y <= y1; ++y)
+  {
+    size_t row = (size_t) y * rect.width;
+    for (int x = x0; x <= x1; ++x)
+    {
+      if (pNear[row + x] <= depth)
+      {
+        return 1;
+      }
+      isOccluded = isOccluded && pFar[row + x] > depth;
+    }
+  }
+  return isOccluded ? -1 : 0;
+}
+
+}
@@ -0,0 +1,365 @@
+/**
+ * @file SpatialHashGrid.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the SpatialHashGrid class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\SpatialHashGrid.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Lite
+{
+
+static const size_t GRAIN_SIZE = 4096;
+
+// Cell coordinates are clamped to this, so far away points share the outer
+// cells instead of overflowing.
+static const double MAX_CELL = 1073741824.0;
+
+static inline int cellCoord(float value, float invCellSize)
+{
+  double cell = std::floor((double) value * invCellSize);
+  return (int) (cell > -MAX_CELL ? (cell < MAX_CELL ? cell : MAX_CELL) : -MAX_CELL);
+}
+
+/**
+ * Parametrized constructor.
+ *
+ * @param[in] cellSize - edge length of a cell, ideally close to the query
+ *                       radius
+ */
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+  : m_cellSize(1.0f)
+  , m_invCellSize(1.0f)
+  , m_slotMask(0)
+{
+  setCellSize(cellSize);
+}
+
+/**
+ * Destructor.
+ */
+SpatialHashGrid::~SpatialHashGrid()
+{
+}
+
+/**
+ * Change the cell size. Takes effect on the next build().
+ *
+ * @param[in] cellSize - edge length of a cell, must be positive
+ */
+void SpatialHashGrid::setCellSize(float cellSize)
+{
+  if (cellSize > 0.0f)
+  {
+    m_cellSize = cellSize;
+    m_invCellSize = 1.0f / cellSize;
+  }
+}
+
+/**
+ * Obtain the cell size.
+ *
+ * @return edge length of a cell
+ */
+float SpatialHashGrid::getCellSize() const
+{
+  return m_cellSize;
+}
+
+/**
+ * Rebuild the grid from a set of points.
+ *
+ * The points are copied, query results refer to their index in pPoints.
+ *
+ * @param[in] pPoints - point positions
+ * @param[in] count   - number of points
+ * @param[in] pPool   - pool used to hash the points in parallel, or NULL
+ */
+void SpatialHashGrid::build(const Vector3f* pPoints, size_t count,
+                            ThreadPool* pPool)
+{
+  m_inX.resize(count);
+  m_inY.resize(count);
+  m_inZ.resize(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_inX[i] = pPoints[i].x;
+    m_inY[i] = pPoints[i].y;
+    m_inZ[i] = pPoints[i].z;
+  }
+  sortPoints(pPool);
+}
+
+/**
+ * Rebuild the grid from a set of 2D points.
+ *
+ * @param[in] pPoints - point positions
+ * @param[in] count   - number of points
+ * @param[in] pPool   - pool used to hash the points in parallel, or NULL
+ */
+void SpatialHashGrid::build(const Vector2f* pPoints, size_t count,
+                            ThreadPool* pPool)
+{
+  m_inX.resize(count);
+  m_inY.resize(count);
+  m_inZ.assign(count, 0.0f);
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_inX[i] = pPoints[i].x;
+    m_inY[i] = pPoints[i].y;
+  }
+  sortPoints(pPool);
+}
+
+/**
+ * Remove all points from the grid.
+ */
+void SpatialHashGrid::clear()
+{
+  m_inX.clear();
+  m_inY.clear();
+  m_inZ.clear();
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_ids.clear();
+  m_pointSlots.clear();
+  m_slotStart.clear();
+  m_slotMask = 0;
+}
+
+unsigned int SpatialHashGrid::slotOf(int cx, int cy, int cz) const
+{
+  unsigned int h = ((unsigned int) cx * 73856093u) ^
+                   ((unsigned int) cy * 19349663u) ^
+                   ((unsigned int) cz * 83492791u);
+  return h & m_slotMask;
+}
+
+void SpatialHashGrid::sortPoints(ThreadPool* pPool)
+{
+  size_t count = m_inX.size();
+  unsigned int tableSize = 1;
+  while (tableSize < count)
+  {
+    tableSize <<= 1;
+  }
+  m_slotMask = tableSize - 1;
+
+  m_pointSlots.resize(count);
+  ThreadPool::RangeTask hash = [this](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      m_pointSlots[i] = slotOf(cellCoord(m_inX[i], m_invCellSize),
+                               cellCoord(m_inY[i], m_invCellSize),
+                               cellCoord(m_inZ[i], m_invCellSize));
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, GRAIN_SIZE, hash);
+  }
+  else
+  {
+    hash(0, count);
+  }
+
+  // Counting sort by slot.
+  m_slotStart.assign(tableSize + 1, 0);
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_slotStart[m_pointSlots[i] + 1]++;
+  }
+  for (unsigned int s = 0; s < tableSize; ++s)
+  {
+    m_slotStart[s + 1] += m_slotStart[s];
+  }
+
+  m_x.resize(count);
+  m_y.resize(count);
+  m_z.resize(count);
+  m_ids.resize(count);
+  std::vector<unsigned int> cursor(m_slotStart.begin(), m_slotStart.end() - 1);
+  for (size_t i = 0; i < count; ++i)
+  {
+    unsigned int dst = cursor[m_pointSlots[i]]++;
+    m_x[dst] = m_inX[i];
+    m_y[dst] = m_inY[i];
+    m_z[dst] = m_inZ[i];
+    m_ids[dst] = (unsigned int) i;
+  }
+}
+
+/**
+ * Find all points within radius of center.
+ *
+ * @param[in]  center  - query position
+ * @param[in]  radius  - query radius
+ * @param[out] results - indices of the points found are appended to it
+ *
+ * @return number of points found
+ */
+size_t SpatialHashGrid::queryRadius(const Vector3f& center, float radius,
+                                    std::vector<unsigned int>& results) const
+{
+  if (m_ids.empty())
+  {
+    return 0;
+  }
+
+  int minX = cellCoord(center.x - radius, m_invCellSize);
+  int minY = cellCoord(center.y - radius, m_invCellSize);
+  int minZ = cellCoord(center.z - radius, m_invCellSize);
+  int maxX = cellCoord(center.x + radius, m_invCellSize);
+  int maxY = cellCoord(center.y + radius, m_invCellSize);
+  int maxZ = cellCoord(center.z + radius, m_invCellSize);
+
+  size_t found = 0;
+  float radiusSqr = radius * radius;
+
+  // A box of more cells than the table has slots visits every slot anyway,
+  // so the points are scanned directly.
+  double cellCount = ((double) maxX - minX + 1.0) * ((double) maxY - minY + 1.0) *
+                     ((double) maxZ - minZ + 1.0);
+  if (cellCount > (double) m_slotMask + 1.0)
+  {
+    for (size_t i = 0; i < m_ids.size(); ++i)
+    {
+      float dx = m_x[i] - center.x;
+      float dy = m_y[i] - center.y;
+      float dz = m_z[i] - center.z;
+      if (dx * dx + dy * dy + dz * dz <= radiusSqr)
+      {
+        results.push_back(m_ids[i]);
+        ++found;
+      }
+    }
+    return found;
+  }
+
+  // Different cells may share a slot, visit every slot once.
+  unsigned int localSlots[64];
+  std::vector<unsigned int> manySlots;
+  unsigned int* pSlots = localSlots;
+  if (cellCount > 64.0)
+  {
+    manySlots.resize((size_t) cellCount);
+    pSlots = &manySlots[0];
+  }
+
+  size_t slotCount = 0;
+  for (int z = minZ; z <= maxZ; ++z)
+  {
+    for (int y = minY; y <= maxY; ++y)
+    {
+      for (int x = minX; x <= maxX; ++x)
+      {
+        pSlots[slotCount++] = slotOf(x, y, z);
+      }
+    }
+  }
+  std::sort(pSlots, pSlots + slotCount);
+  slotCount = std::unique(pSlots, pSlots + slotCount) - pSlots;
+
+  for (size_t s = 0; s < slotCount; ++s)
+  {
+    unsigned int end = m_slotStart[pSlots[s] + 1];
+    for (unsigned int i = m_slotStart[pSlots[s]]; i < end; ++i)
+    {
+      float dx = m_x[i] - center.x;
+      float dy = m_y[i] - center.y;
+      float dz = m_z[i] - center.z;
+      if (dx * dx + dy * dy + dz * dz <= radiusSqr)
+      {
+        results.push_back(m_ids[i]);
+        ++found;
+      }
+    }
+  }
+
+  return found;
+}
+
+/**
+ * Find all points within radius of every center.
+ *
+ * The results are stored in compressed rows: the points found for query i
+ * are results[offsets[i]] to results[offsets[i + 1] - 1].
+ *
+ * @param[in]  pCenters - query positions
+ * @param[in]  count    - number of queries
+ * @param[in]  radius   - query radius
+ * @param[out] offsets  - count + 1 row offsets into results
+ * @param[out] results  - indices of the points found
+ * @param[in]  pPool    - pool used to run the queries in parallel, or NULL
+ */
+void SpatialHashGrid::queryRadius(const Vector3f* pCenters, size_t count,
+                                  float radius,
+                                  std::vector<unsigned int>& offsets,
+                                  std::vector<unsigned int>& results,
+                                  ThreadPool* pPool) const
+{
+  offsets.resize(count + 1);
+  results.clear();
+
+  size_t numChunks = pPool != NULL ? pPool->getThreadCount() * 4 : 1;
+  size_t chunkSize = (count + numChunks - 1) / numChunks;
+  std::vector< std::vector<unsigned int> > partial(numChunks);
+
+  ThreadPool::RangeTask query = [&](size_t begin, size_t end) {
+    for (size_t c = begin; c < end; ++c)
+    {
+      size_t first = std::min(c * chunkSize, count);
+      size_t last  = std::min(first + chunkSize, count);
+      for (size_t q = first; q < last; ++q)
+      {
+        offsets[q + 1] = (unsigned int) queryRadius(pCenters[q], radius, partial[c]);
+      }
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, numChunks, 1, query);
+  }
+  else
+  {
+    query(0, numChunks);
+  }
+
+  offsets[0] = 0;
+  for (size_t q = 0; q < count; ++q)
+  {
+    offsets[q + 1] += offsets[q];
+  }
+
+  results.reserve(offsets[count]);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    results.insert(results.end(), partial[c].begin(), partial[c].end());
+  }
+}
+
+/**
+ * Obtain the number of points in the grid.
+ *
+ * @return point count
+ */
+size_t SpatialHashGrid::getPointCount() const
+{
+  return m_ids.size();
+}
+
+}
@@ -0,0 +1,667 @@
+/**
+ * @file VertexCompression.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the VertexCompression class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\VertexCompression.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef LITE_F16C
+#include <immintrin.h>
+#endif
+
+namespace Lite
+{
+
+static_assert(sizeof(Vector3f) == 3 * sizeof(float), "Vector3f must be tightly packed");
+
+static const float QUANTIZED_MAX = 65535.0f;
+static const float SNORM_MAX = 32767.0f;
+static const float MIN_NORMAL_LENGTH = 1e-30f;
+static const double HALF_MIN_NORMAL = 6.103515625e-5;
+
+static inline unsigned int asUInt(float value)
+{
+  unsigned int bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static inline float asFloat(unsigned int bits)
+{
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/*
+ * Round to the nearest integer, ties to even like the SIMD conversions.
+ */
+static inline int roundToInt(float value)
+{
+#ifdef LITE_SSE2
+  return _mm_cvtss_si32(_mm_set_ss(value));
+#else
+  float r = floorf(value + 0.5f);
+  if (r - value == 0.5f && fmodf(r, 2.0f) != 0.0f)
+  {
+    r -= 1.0f;
+  }
+  return (int) r;
+#endif
+}
+
+static inline float clampf(float value, float low, float high)
+{
+  return value < low ? low : (value > high ? high : value);
+}
+
+/*
+ * Octahedral mapping of one unit vector, see encodeNormals().
+ */
+static inline void octEncode(float x, float y, float z, short* pOut)
+{
+  float l1 = fabsf(x) + fabsf(y) + fabsf(z);
+  float inv = 1.0f / (l1 > MIN_NORMAL_LENGTH ? l1 : MIN_NORMAL_LENGTH);
+  float u = x * inv;
+  float v = y * inv;
+  if (z < 0.0f)
+  {
+    float fu = 1.0f - fabsf(v);
+    float fv = 1.0f - fabsf(u);
+    u = u < 0.0f ? -fu : fu;
+    v = v < 0.0f ? -fv : fv;
+  }
+  pOut[0] = (short) roundToInt(u * SNORM_MAX);
+  pOut[1] = (short) roundToInt(v * SNORM_MAX);
+}
+
+static inline void octDecode(const short* pValues, float* pOut)
+{
+  float u = clampf(pValues[0] * (1.0f / SNORM_MAX), -1.0f, 1.0f);
+  float v = clampf(pValues[1] * (1.0f / SNORM_MAX), -1.0f, 1.0f);
+  float z = 1.0f - fabsf(u) - fabsf(v);
+  float t = -z > 0.0f ? -z : 0.0f;
+  float x = u < 0.0f ? u + t : u - t;
+  float y = v < 0.0f ? v + t : v - t;
+  float inv = 1.0f / sqrtf(x * x + y * y + z * z);
+  pOut[0] = x * inv;
+  pOut[1] = y * inv;
+  pOut[2] = z * inv;
+}
+
+#ifdef LITE_SSE2
+/*
+ * Four xyz triples in three registers to one register per coordinate.
+ */
+static inline void transposeToSoA(__m128 a, __m128 b, __m128 c,
+                                  __m128& x, __m128& y, __m128& z)
+{
+  x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)),
+                     _MM_SHUFFLE(2, 0, 3, 0));
+  y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                     _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                     _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline void transposeToAoS(__m128 x, __m128 y, __m128 z,
+                                  __m128& a, __m128& b, __m128& c)
+{
+  a = _mm_shuffle_ps(_mm_unpacklo_ps(x, y),
+                     _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                     _MM_SHUFFLE(2, 0, 1, 0));
+  b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                     _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                     _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+/*
+ * Pack four 32 bit integers in [0, 65535] to unsigned 16 bit values. SSE2
+ * only has signed saturation, so the range is shifted around it.
+ */
+static inline __m128i packUnsigned(__m128i low, __m128i high)
+{
+  const __m128i bias32 = _mm_set1_epi32(32768);
+  const __m128i bias16 = _mm_set1_epi16((short) 0x8000);
+  return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(low, bias32),
+                                       _mm_sub_epi32(high, bias32)), bias16);
+}
+
+static inline __m128 copySign(__m128 magnitude, __m128 sign)
+{
+  const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int) 0x80000000u));
+  return _mm_or_ps(_mm_andnot_ps(signMask, magnitude), _mm_and_ps(signMask, sign));
+}
+#endif
+
+/**
+ * Convert a float to a half float, rounding to nearest even.
+ *
+ * @param[in] value - value to convert
+ *
+ * @return the bits of the half float
+ */
+unsigned short VertexCompression::floatToHalf(float value)
+{
+  const unsigned int infinity = 255u << 23;
+  const unsigned int halfMax = (127u + 16u) << 23;
+  const unsigned int minNormal = (127u - 14u) << 23;
+  const unsigned int subnormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+  unsigned int bits = asUInt(value);
+  unsigned int sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  unsigned int result;
+  if (bits >= halfMax)
+  {
+    // Overflow to infinity, NaN stays a quiet NaN.
+    result = bits > infinity ? 0x7E00u : 0x7C00u;
+  }
+  else if (bits < minNormal)
+  {
+    // Subnormal or zero, the float addition does the rounding.
+    result = asUInt(asFloat(bits) + asFloat(subnormalMagic)) - subnormalMagic;
+  }
+  else
+  {
+    unsigned int mantissaOdd = (bits >> 13) & 1;
+    bits += ((15u - 127u) << 23) + 0xFFFu + mantissaOdd;
+    result = bits >> 13;
+  }
+  return (unsigned short) (result | (sign >> 16));
+}
+
+/**
+ * Convert a half float to a float. Exact for all values.
+ *
+ * @param[in] value - the bits of the half float
+ *
+ * @return the float value
+ */
+float VertexCompression::halfToFloat(unsigned short value)
+{
+  // Scaling by 2^112 rebiases the exponent and normalizes subnormals.
+  const float magic = asFloat((254u - 15u) << 23);
+
+  unsigned int magnitude = value & 0x7FFFu;
+  float result = asFloat(magnitude << 13) * magic;
+  unsigned int bits = asUInt(result);
+  if (magnitude >= 0x7C00u)
+  {
+    bits |= 255u << 23;
+  }
+  return asFloat(bits | ((value & 0x8000u) << 16));
+}
+
+/**
+ * Convert an array of floats to half floats.
+ *
+ * @param[in]  pValues - floats to convert
+ * @param[in]  count   - number of values
+ * @param[out] pOut    - receives count half floats
+ */
+void VertexCompression::encodeHalf(const float* pValues, size_t count,
+                                   unsigned short* pOut)
+{
+  size_t i = 0;
+#if defined(LITE_F16C)
+  for (; i + 8 <= count; i += 8)
+  {
+    _mm_storeu_si128((__m128i*) (pOut + i),
+                     _mm256_cvtps_ph(_mm256_loadu_ps(pValues + i), _MM_FROUND_TO_NEAREST_INT));
+  }
+#elif defined(LITE_SSE2)
+  // The scalar conversion on four lanes, without branches.
+  const __m128i signMask = _mm_set1_epi32((int) 0x80000000u);
+  const __m128i halfMax = _mm_set1_epi32((127 + 16) << 23);
+  const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+  const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+  const __m128i normalBias = _mm_set1_epi32((int) (0xFFFu + ((15u - 127u) << 23)));
+  const __m128i nanBit = _mm_set1_epi32(0x200);
+  const __m128i infinity = _mm_set1_epi32(0x7C00);
+
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i halves[2];
+    for (int j = 0; j < 2; ++j)
+    {
+      __m128 value = _mm_loadu_ps(pValues + i + j * 4);
+      __m128i sign = _mm_and_si128(_mm_castps_si128(value), signMask);
+      __m128 magnitude = _mm_xor_ps(value, _mm_castsi128_ps(sign));
+      __m128i bits = _mm_castps_si128(magnitude);
+
+      __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(magnitude, magnitude));
+      __m128i isRegular = _mm_cmpgt_epi32(halfMax, bits);
+      __m128i special = _mm_or_si128(_mm_and_si128(isNaN, nanBit), infinity);
+
+      __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, bits);
+      __m128i subnormal = _mm_sub_epi32(
+        _mm_castps_si128(_mm_add_ps(magnitude, _mm_castsi128_ps(subnormalMagic))),
+        subnormalMagic);
+
+      __m128i mantissaOdd = _mm_srli_epi32(_mm_slli_epi32(bits, 18), 31);
+      __m128i normal = _mm_srli_epi32(
+        _mm_add_epi32(_mm_add_epi32(bits, normalBias), mantissaOdd), 13);
+
+      __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal),
+                                    _mm_andnot_si128(isSubnormal, normal));
+      __m128i result = _mm_or_si128(_mm_and_si128(isRegular, finite),
+                                    _mm_andnot_si128(isRegular, special));
+      // The arithmetic shift makes the signed pack below exact.
+      halves[j] = _mm_or_si128(result, _mm_srai_epi32(sign, 16));
+    }
+    _mm_storeu_si128((__m128i*) (pOut + i), _mm_packs_epi32(halves[0], halves[1]));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    pOut[i] = floatToHalf(pValues[i]);
+  }
+}
+
+/**
+ * Convert an array of half floats to floats.
+ *
+ * @param[in]  pValues - half floats to convert
+ * @param[in]  count   - number of values
+ * @param[out] pOut    - receives count floats
+ */
+void VertexCompression::decodeHalf(const unsigned short* pValues, size_t count,
+                                   float* pOut)
+{
+  size_t i = 0;
+#if defined(LITE_F16C)
+  for (; i + 8 <= count; i += 8)
+  {
+    _mm256_storeu_ps(pOut + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) (pValues + i))));
+  }
+#elif defined(LITE_SSE2)
+  const __m128i magnitudeMask = _mm_set1_epi32(0x7FFF);
+  const __m128i maxFinite = _mm_set1_epi32(0x7BFF);
+  const __m128i infinity = _mm_set1_epi32(255 << 23);
+  const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+  const __m128i zero = _mm_setzero_si128();
+
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i packed = _mm_loadu_si128((const __m128i*) (pValues + i));
+    __m128i halves[2] = { _mm_unpacklo_epi16(packed, zero),
+                          _mm_unpackhi_epi16(packed, zero) };
+    for (int j = 0; j < 2; ++j)
+    {
+      __m128i magnitude = _mm_and_si128(halves[j], magnitudeMask);
+      __m128i sign = _mm_slli_epi32(_mm_xor_si128(halves[j], magnitude), 16);
+      __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), magic);
+      __m128i special = _mm_and_si128(_mm_cmpgt_epi32(magnitude, maxFinite), infinity);
+      _mm_storeu_ps(pOut + i + j * 4,
+                    _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(sign, special))));
+    }
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    pOut[i] = halfToFloat(pValues[i]);
+  }
+}
+
+/**
+ * Quantize positions to three unsigned 16 bit values within a box.
+ *
+ * Positions outside the box are clamped to it.
+ *
+ * @param[in]  pPositions - positions to encode
+ * @param[in]  count      - number of positions
+ * @param[in]  bounds     - box containing the positions
+ * @param[out] pOut       - receives 3 * count values
+ */
+void VertexCompression::encodePositions(const Vector3f* pPositions, size_t count,
+                                        const AABB& bounds, unsigned short* pOut)
+{
+  Vector3f extent = bounds.extent();
+  float offset[3] = { bounds.min.x, bounds.min.y, bounds.min.z };
+  float scale[3] = { extent.x > 0.0f ? QUANTIZED_MAX / extent.x : 0.0f,
+                     extent.y > 0.0f ? QUANTIZED_MAX / extent.y : 0.0f,
+                     extent.z > 0.0f ? QUANTIZED_MAX / extent.z : 0.0f };
+  const float* pValues = (const float*) pPositions;
+
+  size_t i = 0;
+#ifdef LITE_SSE2
+  // Four positions are twelve floats in three registers. Register r starts
+  // at float 4 * r, which is axis r, so the axes are rotated per register.
+  __m128 offsets[3] = {
+    _mm_setr_ps(offset[0], offset[1], offset[2], offset[0]),
+    _mm_setr_ps(offset[1], offset[2], offset[0], offset[1]),
+    _mm_setr_ps(offset[2], offset[0], offset[1], offset[2])
+  };
+  __m128 scales[3] = {
+    _mm_setr_ps(scale[0], scale[1], scale[2], scale[0]),
+    _mm_setr_ps(scale[1], scale[2], scale[0], scale[1]),
+    _mm_setr_ps(scale[2], scale[0], scale[1], scale[2])
+  };
+
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 maxValue = _mm_set1_ps(QUANTIZED_MAX);
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i quantized[3];
+    for (int r = 0; r < 3; ++r)
+    {
+      __m128 value = _mm_loadu_ps(pValues + i * 3 + r * 4);
+      value = _mm_mul_ps(_mm_sub_ps(value, offsets[r]), scales[r]);
+      value = _mm_min_ps(_mm_max_ps(value, zero), maxValue);
+      quantized[r] = _mm_cvtps_epi32(value);
+    }
+    _mm_storeu_si128((__m128i*) (pOut + i * 3), packUnsigned(quantized[0], quantized[1]));
+    _mm_storel_epi64((__m128i*) (pOut + i * 3 + 8), packUnsigned(quantized[2], quantized[2]));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      float value = (pValues[i * 3 + axis] - offset[axis]) * scale[axis];
+      pOut[i * 3 + axis] = (unsigned short) roundToInt(clampf(value, 0.0f, QUANTIZED_MAX));
+    }
+  }
+}
+
+/**
+ * Restore positions quantized with encodePositions().
+ *
+ * @param[in]  pValues - 3 * count quantized values
+ * @param[in]  count   - number of positions
+ * @param[in]  bounds  - box used to encode the positions
+ * @param[out] pOut    - receives count positions
+ */
+void VertexCompression::decodePositions(const unsigned short* pValues, size_t count,
+                                        const AABB& bounds, Vector3f* pOut)
+{
+  Vector3f extent = bounds.extent();
+  float offset[3] = { bounds.min.x, bounds.min.y, bounds.min.z };
+  float step[3] = { extent.x / QUANTIZED_MAX, extent.y / QUANTIZED_MAX,
+                    extent.z / QUANTIZED_MAX };
+  float* pFloats = (float*) pOut;
+
+  size_t i = 0;
+#ifdef LITE_SSE2
+  __m128 offsets[3] = {
+    _mm_setr_ps(offset[0], offset[1], offset[2], offset[0]),
+    _mm_setr_ps(offset[1], offset[2], offset[0], offset[1]),
+    _mm_setr_ps(offset[2], offset[0], offset[1], offset[2])
+  };
+  __m128 steps[3] = {
+    _mm_setr_ps(step[0], step[1], step[2], step[0]),
+    _mm_setr_ps(step[1], step[2], step[0], step[1]),
+    _mm_setr_ps(step[2], step[0], step[1], step[2])
+  };
+
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i first = _mm_loadu_si128((const __m128i*) (pValues + i * 3));
+    __m128i last = _mm_loadl_epi64((const __m128i*) (pValues + i * 3 + 8));
+    __m128i quantized[3] = { _mm_unpacklo_epi16(first, zero),
+                             _mm_unpackhi_epi16(first, zero),
+                             _mm_unpacklo_epi16(last, zero) };
+    for (int r = 0; r < 3; ++r)
+    {
+      __m128 value = _mm_cvtepi32_ps(quantized[r]);
+      _mm_storeu_ps(pFloats + i * 3 + r * 4,
+                    _mm_add_ps(_mm_mul_ps(value, steps[r]), offsets[r]));
+    }
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      pFloats[i * 3 + axis] = pValues[i * 3 + axis] * step[axis] + offset[axis];
+    }
+  }
+}
+
+/**
+ * Obtain the largest error of a position quantized within a box: half a
+ * quantization step per axis, plus the float rounding of the decoded value.
+ *
+ * @param[in] bounds - box used to encode the positions
+ *
+ * @return largest absolute error per axis
+ */
+Vector3f VertexCompression::getPositionErrorBound(const AABB& bounds)
+{
+  Vector3f extent = bounds.extent();
+  float error[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    float magnitude = fabsf(bounds.min.v[axis]) > fabsf(bounds.max.v[axis]) ?
+                      fabsf(bounds.min.v[axis]) : fabsf(bounds.max.v[axis]);
+    error[axis] = extent.v[axis] * (0.5f / QUANTIZED_MAX) + magnitude * 2.0f * FLT_EPSILON;
+  }
+  return Vector3f(error[0], error[1], error[2]);
+}
+
+/**
+ * Encode unit normals with the octahedral mapping.
+ *
+ * The normal is projected onto the octahedron |x| + |y| + |z| = 1, whose
+ * lower half is folded over the upper one, and the resulting square is
+ * stored as two signed normalized 16 bit values. A zero vector decodes as
+ * (0, 0, 1).
+ *
+ * @param[in]  pNormals - unit vectors to encode
+ * @param[in]  count    - number of normals
+ * @param[out] pOut     - receives 2 * count values
+ */
+void VertexCompression::encodeNormals(const Vector3f* pNormals, size_t count, short* pOut)
+{
+  const float* pValues = (const float*) pNormals;
+
+  size_t i = 0;
+#ifdef LITE_SSE2
+  const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int) 0x80000000u));
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 minLength = _mm_set1_ps(MIN_NORMAL_LENGTH);
+  const __m128 scale = _mm_set1_ps(SNORM_MAX);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 x, y, z;
+    transposeToSoA(_mm_loadu_ps(pValues + i * 3), _mm_loadu_ps(pValues + i * 3 + 4),
+                   _mm_loadu_ps(pValues + i * 3 + 8), x, y, z);
+
+    __m128 l1 = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)),
+                           _mm_andnot_ps(signMask, z));
+    __m128 inv = _mm_div_ps(one, _mm_max_ps(l1, minLength));
+    __m128 u = _mm_mul_ps(x, inv);
+    __m128 v = _mm_mul_ps(y, inv);
+
+    // Fold the lower half. The sign of zero is positive, like the scalar path.
+    __m128 isLower = _mm_cmplt_ps(z, zero);
+    __m128 signU = _mm_and_ps(_mm_cmplt_ps(u, zero), signMask);
+    __m128 signV = _mm_and_ps(_mm_cmplt_ps(v, zero), signMask);
+    __m128 foldedU = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, v)), signU);
+    __m128 foldedV = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)), signV);
+    u = _mm_or_ps(_mm_and_ps(isLower, foldedU), _mm_andnot_ps(isLower, u));
+    v = _mm_or_ps(_mm_and_ps(isLower, foldedV), _mm_andnot_ps(isLower, v));
+
+    __m128i qu = _mm_cvtps_epi32(_mm_mul_ps(u, scale));
+    __m128i qv = _mm_cvtps_epi32(_mm_mul_ps(v, scale));
+    _mm_storeu_si128((__m128i*) (pOut + i * 2),
+                     _mm_packs_epi32(_mm_unpacklo_epi32(qu, qv), _mm_unpackhi_epi32(qu, qv)));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    octEncode(pValues[i * 3], pValues[i * 3 + 1], pValues[i * 3 + 2], pOut + i * 2);
+  }
+}
+
+/**
+ * Restore normals encoded with encodeNormals().
+ *
+ * @param[in]  pValues - 2 * count encoded values
+ * @param[in]  count   - number of normals
+ * @param[out] pOut    - receives count unit vectors
+ */
+void VertexCompression::decodeNormals(const short* pValues, size_t count, Vector3f* pOut)
+{
+  float* pFloats = (float*) pOut;
+
+  size_t i = 0;
+#ifdef LITE_SSE2
+  const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int) 0x80000000u));
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 minusOne = _mm_set1_ps(-1.0f);
+  const __m128 scale = _mm_set1_ps(1.0f / SNORM_MAX);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i packed = _mm_loadu_si128((const __m128i*) (pValues + i * 2));
+    __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+    __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16));
+    __m128 u = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 v = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+    u = _mm_min_ps(_mm_max_ps(_mm_mul_ps(u, scale), minusOne), one);
+    v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, scale), minusOne), one);
+
+    __m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)),
+                          _mm_andnot_ps(signMask, v));
+    __m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+    __m128 x = _mm_sub_ps(u, copySign(t, _mm_and_ps(_mm_cmplt_ps(u, zero), signMask)));
+    __m128 y = _mm_sub_ps(v, copySign(t, _mm_and_ps(_mm_cmplt_ps(v, zero), signMask)));
+
+    __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                  _mm_mul_ps(z, z));
+    __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(lengthSqr));
+    __m128 a, b, c;
+    transposeToAoS(_mm_mul_ps(x, inv), _mm_mul_ps(y, inv), _mm_mul_ps(z, inv), a, b, c);
+    _mm_storeu_ps(pFloats + i * 3, a);
+    _mm_storeu_ps(pFloats + i * 3 + 4, b);
+    _mm_storeu_ps(pFloats + i * 3 + 8, c);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    octDecode(pValues + i * 2, pFloats + i * 3);
+  }
+}
+
+/**
+ * Measure the largest relative error of decoded half floats.
+ *
+ * Below the smallest normal half float the error is taken relative to it,
+ * which keeps the result within 2^-11 for every finite half float.
+ *
+ * @param[in] pOriginal - values before encoding
+ * @param[in] pDecoded  - values after decoding
+ * @param[in] count     - number of values
+ *
+ * @return largest relative error
+ */
+float VertexCompression::measureHalfError(const float* pOriginal, const float* pDecoded,
+                                          size_t count)
+{
+  double maxError = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double magnitude = fabs((double) pOriginal[i]);
+    double error = fabs((double) pDecoded[i] - pOriginal[i]) /
+                   (magnitude > HALF_MIN_NORMAL ? magnitude : HALF_MIN_NORMAL);
+    if (!(error <= maxError))
+    {
+      maxError = error;
+    }
+  }
+  return (float) maxError;
+}
+
+/**
+ * Measure the largest distance between original and decoded positions.
+ *
+ * @param[in] pOriginal - positions before encoding
+ * @param[in] pDecoded  - positions after decoding
+ * @param[in] count     - number of positions
+ *
+ * @return largest distance
+ */
+float VertexCompression::measurePositionError(const Vector3f* pOriginal,
+                                              const Vector3f* pDecoded, size_t count)
+{
+  double maxErrorSqr = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double dx = (double) pDecoded[i].x - pOriginal[i].x;
+    double dy = (double) pDecoded[i].y - pOriginal[i].y;
+    double dz = (double) pDecoded[i].z - pOriginal[i].z;
+    double errorSqr = dx * dx + dy * dy + dz * dz;
+    if (errorSqr > maxErrorSqr)
+    {
+      maxErrorSqr = errorSqr;
+    }
+  }
+  return (float) sqrt(maxErrorSqr);
+}
+
+/**
+ * Measure the largest angle between original and decoded normals.
+ *
+ * @param[in] pOriginal - normals before encoding
+ * @param[in] pDecoded  - normals after decoding
+ * @param[in] count     - number of normals
+ *
+ * @return largest angle in radians
+ */
+float VertexCompression::measureNormalError(const Vector3f* pOriginal,
+                                            const Vector3f* pDecoded, size_t count)
+{
+  double maxAngle = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const Vector3f& a = pOriginal[i];
+    const Vector3f& b = pDecoded[i];
+    // atan2 of the cross and dot products stays accurate for small angles.
+    double cx = (double) a.y * b.z - (double) a.z * b.y;
+    double cy = (double) a.z * b.x - (double) a.x * b.z;
+    double cz = (double) a.x * b.y - (double) a.y * b.x;
+    double dot = (double) a.x * b.x + (double) a.y * b.y + (double) a.z * b.z;
+    double angle = atan2(sqrt(cx * cx + cy * cy + cz * cz), dot);
+    if (angle > maxAngle)
+    {
+      maxAngle = angle;
+    }
+  }
+  return (float) maxAngle;
+}
+
+}
@@ -0,0 +1,308 @@
+/**
+ * @file VertexWelder.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the VertexWelder class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Geometry\VertexWelder.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+#include "..\..\Include\LiteCube\Math\VectorHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+static const size_t       GRAIN_SIZE = 4096;
+static const unsigned int INVALID_INDEX = 0xFFFFFFFFu;
+
+// Cell edge in tolerances. Per axis a point then needs the neighbouring cell
+// only half of the time.
+static const float        CELL_SCALE = 4.0f;
+
+// Points ahead whose cell is prefetched.
+static const size_t       PREFETCH_DISTANCE = 16;
+
+// Border flags of PointKey, two bits per axis.
+static const unsigned int BORDER_LOW = 1;
+static const unsigned int BORDER_HIGH = 2;
+
+// Cell coordinates are clamped to this, so far away points share the outer
+// cells instead of overflowing, and a neighbour one cell further still fits.
+static const float        MAX_CELL = 1073741824.0f;
+
+/*
+ * Convert a floored coordinate to a cell, NaN goes to the lowest cell.
+ */
+static inline int clampCell(float cell)
+{
+  return (int) (cell > -MAX_CELL ? (cell < MAX_CELL ? cell : MAX_CELL) : -MAX_CELL);
+}
+
+static inline unsigned int hashCell(int x, int y, int z)
+{
+  return mixBits(((unsigned int) x * 0x9E3779B1u ^ (unsigned int) y) *
+                 0x85EBCA77u ^ (unsigned int) z);
+}
+
+/**
+ * Default constructor.
+ */
+VertexWelder::VertexWelder()
+  : m_cellMask(0)
+{
+}
+
+/**
+ * Destructor.
+ */
+VertexWelder::~VertexWelder()
+{
+}
+
+/**
+ * Merge points closer than a tolerance.
+ *
+ * Points with NaN coordinates are never merged when the tolerance is
+ * positive.
+ *
+ * @param[in]  pPoints   - points to weld
+ * @param[in]  count     - number of points
+ * @param[in]  tolerance - largest distance of merged points, 0 to merge only
+ *                         exactly equal points
+ * @param[out] remap     - index in unique of every point
+ * @param[out] unique    - the remaining points, in order of first occurrence
+ * @param[in]  pPool     - pool used to quantize the points in parallel, or
+ *                         NULL
+ *
+ * @return number of unique points
+ */
+size_t VertexWelder::weld(const Vector3f* pPoints, size_t count,
+                          float tolerance, std::vector<unsigned int>& remap,
+                          std::vector<Vector3f>& unique, ThreadPool* pPool)
+{
+  remap.resize(count);
+  unique.clear();
+  if (count == 0)
+  {
+    return 0;
+  }
+
+  // Welded data usually has several points per cell, so start with a table
+  // for a fraction of the points and grow it when it is half full.
+  unsigned int tableSize = 16;
+  while (tableSize < count / 2)
+  {
+    tableSize <<= 1;
+  }
+  Cell empty = { { 0, 0, 0 }, INVALID_INDEX };
+  m_cells.assign(tableSize, empty);
+  m_cellMask = tableSize - 1;
+  m_next.resize(count);
+  size_t cellCount = 0;
+
+  bool isExact = !(tolerance > 0.0f);
+  float toleranceSqr = tolerance * tolerance;
+  computeKeys(pPoints, count, isExact ? 0.0f : tolerance, pPool);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+#ifdef LITE_SSE2
+    if (i + PREFETCH_DISTANCE < count)
+    {
+      _mm_prefetch((const char*) &m_cells[m_keys[i + PREFETCH_DISTANCE].hash &
+                                          m_cellMask], _MM_HINT_T0);
+    }
+#endif
+
+    const PointKey& key = m_keys[i];
+    Cell* pCell = findCell(key.cell[0], key.cell[1], key.cell[2], key.hash);
+    unsigned int match = isExact ? pCell->head
+                                 : findMatch(pPoints[i], key, unique, toleranceSqr);
+
+    if (match == INVALID_INDEX)
+    {
+      match = (unsigned int) unique.size();
+      unique.push_back(pPoints[i]);
+      m_next[match] = pCell->head;
+      if (pCell->head == INVALID_INDEX)
+      {
+        pCell->key[0] = key.cell[0];
+        pCell->key[1] = key.cell[1];
+        pCell->key[2] = key.cell[2];
+        if (++cellCount * 2 > m_cells.size())
+        {
+          pCell->head = match;
+          growCells();
+          pCell = findCell(key.cell[0], key.cell[1], key.cell[2], key.hash);
+        }
+      }
+      pCell->head = match;
+    }
+    remap[i] = match;
+  }
+
+  return unique.size();
+}
+
+/*
+ * Quantize every point. With a tolerance of zero the key is the bits of the
+ * coordinates and no neighbours are needed.
+ */
+void VertexWelder::computeKeys(const Vector3f* pPoints, size_t count,
+                               float tolerance, ThreadPool* pPool)
+{
+  m_keys.resize(count);
+
+  float invCellSize = tolerance > 0.0f ? 1.0f / (tolerance * CELL_SCALE) : 0.0f;
+  // Slightly wider than one tolerance so rounding never hides a neighbour.
+  float margin = 1.0f / CELL_SCALE + 1e-4f;
+
+  ThreadPool::RangeTask quantize = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      const Vector3f& p = pPoints[i];
+      PointKey& key = m_keys[i];
+      if (invCellSize == 0.0f)
+      {
+        key.cell[0] = (int) floatBits(p.x);
+        key.cell[1] = (int) floatBits(p.y);
+        key.cell[2] = (int) floatBits(p.z);
+        key.border = 0;
+      }
+      else
+      {
+        // Shifted by half a cell, so points on a grid with a spacing of a
+        // multiple of the cell size are not all on cell borders.
+        float coords[3] = { p.x * invCellSize + 0.5f, p.y * invCellSize + 0.5f,
+                            p.z * invCellSize + 0.5f };
+        key.border = 0;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          float cell = std::floor(coords[axis]);
+          float offset = coords[axis] - cell;
+          key.cell[axis] = clampCell(cell);
+          if (offset < margin)
+          {
+            key.border |= BORDER_LOW << (axis * 2);
+          }
+          else if (offset > 1.0f - margin)
+          {
+            key.border |= BORDER_HIGH << (axis * 2);
+          }
+        }
+      }
+      key.hash = hashCell(key.cell[0], key.cell[1], key.cell[2]);
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, GRAIN_SIZE, quantize);
+  }
+  else
+  {
+    quantize(0, count);
+  }
+}
+
+/*
+ * Double the cell table and reinsert the occupied cells.
+ */
+void VertexWelder::growCells()
+{
+  std::vector<Cell> cells(m_cells.size() * 2);
+  m_cells.swap(cells);
+  Cell empty = { { 0, 0, 0 }, INVALID_INDEX };
+  std::fill(m_cells.begin(), m_cells.end(), empty);
+  m_cellMask = (unsigned int) m_cells.size() - 1;
+
+  for (size_t i = 0; i < cells.size(); ++i)
+  {
+    const Cell& cell = cells[i];
+    if (cell.head != INVALID_INDEX)
+    {
+      *findCell(cell.key[0], cell.key[1], cell.key[2],
+                hashCell(cell.key[0], cell.key[1], cell.key[2])) = cell;
+    }
+  }
+}
+
+/*
+ * Find the slot of a cell, or the empty slot where it would be inserted.
+ */
+VertexWelder::Cell* VertexWelder::findCell(int x, int y, int z,
+                                           unsigned int hash)
+{
+  unsigned int slot = hash & m_cellMask;
+  for (;;)
+  {
+    Cell& cell = m_cells[slot];
+    if (cell.head == INVALID_INDEX ||
+        (cell.key[0] == x && cell.key[1] == y && cell.key[2] == z))
+    {
+      return &cell;
+    }
+    slot = (slot + 1) & m_cellMask;
+  }
+}
+
+/*
+ * Search the cell of a point and the neighbours it is close to for a
+ * representative within the tolerance.
+ */
+unsigned int VertexWelder::findMatch(const Vector3f& point, const PointKey& key,
+                                     const std::vector<Vector3f>& unique,
+                                     float toleranceSqr)
+{
+  int offsets[3][2];
+  int counts[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    unsigned int border = (key.border >> (axis * 2)) & 3;
+    offsets[axis][0] = 0;
+    offsets[axis][1] = border == BORDER_LOW ? -1 : 1;
+    counts[axis] = border != 0 ? 2 : 1;
+  }
+
+  for (int ix = 0; ix < counts[0]; ++ix)
+  {
+    for (int iy = 0; iy < counts[1]; ++iy)
+    {
+      for (int iz = 0; iz < counts[2]; ++iz)
+      {
+        int x = key.cell[0] + offsets[0][ix];
+        int y = key.cell[1] + offsets[1][iy];
+        int z = key.cell[2] + offsets[2][iz];
+        unsigned int hash = ix + iy + iz == 0 ? key.hash : hashCell(x, y, z);
+        const Cell* pCell = findCell(x, y, z, hash);
+        for (unsigned int u = pCell->head; u != INVALID_INDEX; u = m_next[u])
+        {
+          float dx = unique[u].x - point.x;
+          float dy = unique[u].y - point.y;
+          float dz = unique[u].z - point.z;
+          if (dx * dx + dy * dy + dz * dz <= toleranceSqr)
+          {
+            return u;
+          }
+        }
+      }
+    }
+  }
+
+  return INVALID_INDEX;
+}
+
+}
@@ -0,0 +1,432 @@
+/**
+ * @file DynamicResolution.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the DynamicResolution class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\DynamicResolution.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\Window.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Lite
+{
+
+// Smallest change of the scale the PID policy applies, so that noise in
+// the frame times does not resize the render target every frame.
+static const float PID_DEADBAND = 0.02f;
+
+/**
+ * @brief Constructor.
+ *
+ * Targets 60 frames per second with the PID policy, scaling down to half
+ * the output size at most.
+ */
+DynamicResolution::DynamicResolution()
+  : m_policy(POLICY_PID)
+  , m_targetMs(1000.0f / 60.0f)
+  , m_minScale(0.5f)
+  , m_maxScale(1.0f)
+  , m_proportional(0.3f)
+  , m_integral(0.05f)
+  , m_derivative(0.0f)
+  , m_headroom(0.1f)
+  , m_lowerRatio(0.8f)
+  , m_upperRatio(1.0f)
+  , m_hysteresisFrames(8)
+  , m_hysteresisStep(0.1f)
+  , m_smoothing(0.1f)
+  , m_filter(ImageOps::FILTER_BILINEAR)
+  , m_outputWidth(0)
+  , m_outputHeight(0)
+{
+  reset();
+}
+
+/**
+ * @brief Set the frame time to hold.
+ *
+ * @param[in] ms - the target in milliseconds
+ */
+void DynamicResolution::setTargetFrameTime(float ms)
+{
+  m_targetMs = std::max(ms, 0.001f);
+}
+
+/**
+ * @brief Get the frame time to hold.
+ *
+ * @return The target in milliseconds.
+ */
+float DynamicResolution::getTargetFrameTime() const
+{
+  return m_targetMs;
+}
+
+/**
+ * @brief Limit the scale of the render size.
+ *
+ * @param[in] minimum - smallest scale per axis, above 0
+ * @param[in] maximum - largest scale per axis, usually 1
+ */
+void DynamicResolution::setScaleRange(float minimum, float maximum)
+{
+  m_minScale = std::max(minimum, 0.01f);
+  m_maxScale = std::max(maximum, m_minScale);
+  m_controlScale = std::min(std::max(m_controlScale, m_minScale), m_maxScale);
+  applyScale(std::min(std::max(m_stats.scale, m_minScale), m_maxScale));
+}
+
+/**
+ * @brief Choose how the scale follows the frame time.
+ *
+ * @param[in] policy - the policy
+ */
+void DynamicResolution::setPolicy(Policy policy)
+{
+  m_policy = policy;
+  m_controlScale = m_stats.scale;
+  m_errors[0] = m_errors[1] = 0.0f;
+  m_streak = 0;
+}
+
+/**
+ * @brief Get how the scale follows the frame time.
+ *
+ * @return The policy.
+ */
+DynamicResolution::Policy DynamicResolution::getPolicy() const
+{
+  return m_policy;
+}
+
+/**
+ * @brief Set the gains of the PID policy.
+ *
+ * The error is the headroom relative to the target, positive when frames
+ * are faster than it, and the output is the change of the scale.
+ *
+ * @param[in] proportional - gain of the change of the error
+ * @param[in] integral - gain of the error
+ * @param[in] derivative - gain of the change of the change of the error
+ */
+void DynamicResolution::setPidGains(float proportional, float integral, float derivative)
+{
+  m_proportional = proportional;
+  m_integral = integral;
+  m_derivative = derivative;
+}
+
+/**
+ * @brief Set how far under the target the PID policy aims.
+ *
+ * Noise puts about half of the frames over the time a controller holds, so
+ * it holds a shorter one.
+ *
+ * @param[in] fraction - fraction of the target left free
+ */
+void DynamicResolution::setHeadroom(float fraction)
+{
+  m_headroom = std::min(std::max(fraction, 0.0f), 0.9f);
+}
+
+/**
+ * @brief Set the thresholds of the hysteresis policy.
+ *
+ * @param[in] lowerRatio - fraction of the target under which the scale
+ *                         goes up
+ * @param[in] upperRatio - fraction of the target over which the scale goes
+ *                         down
+ * @param[in] frames - frames in a row past a threshold before the scale
+ *                     changes
+ * @param[in] step - change of the scale
+ */
+void DynamicResolution::setHysteresis(float lowerRatio, float upperRatio, unsigned int frames,
+                                      float step)
+{
+  m_lowerRatio = lowerRatio;
+  m_upperRatio = std::max(upperRatio, lowerRatio);
+  m_hysteresisFrames = std::max(frames, 1u);
+  m_hysteresisStep = std::max(step, 0.001f);
+}
+
+/**
+ * @brief Set how quickly the smoothed frame time follows new frames.
+ *
+ * @param[in] factor - weight of the newest frame, 1 for no smoothing
+ */
+void DynamicResolution::setSmoothing(float factor)
+{
+  m_smoothing = std::min(std::max(factor, 0.01f), 1.0f);
+}
+
+/**
+ * @brief Choose the filter present() scales the render target with.
+ *
+ * @param[in] filter - the filter, bilinear by default
+ */
+void DynamicResolution::setFilter(ImageOps::Filter filter)
+{
+  m_filter = filter;
+}
+
+/**
+ * @brief Take frame times from a model instead of the clock.
+ *
+ * @param[in] model - gives the time of a frame, or an empty function to
+ *                    measure frames again
+ */
+void DynamicResolution::setFrameTimeModel(const FrameTimeModel& model)
+{
+  m_model = model;
+}
+
+/**
+ * @brief Set the size the render target is presented at.
+ *
+ * present() calls this with the size of the client area of the window.
+ *
+ * @param[in] width - width in pixels
+ * @param[in] height - height in pixels
+ */
+void DynamicResolution::setOutputSize(int width, int height)
+{
+  m_outputWidth = std::max(width, 0);
+  m_outputHeight = std::max(height, 0);
+  applyScale(m_stats.scale);
+}
+
+/**
+ * @brief Go back to the largest scale and clear the statistics.
+ */
+void DynamicResolution::reset()
+{
+  m_controlScale = m_maxScale;
+  m_errors[0] = m_errors[1] = 0.0f;
+  m_streak = 0;
+  m_stats.frameMs = 0.0f;
+  m_stats.averageMs = 0.0f;
+  m_stats.renderWidth = -1;
+  m_stats.renderHeight = -1;
+  m_stats.frameCount = 0;
+  m_stats.overBudgetCount = 0;
+  m_stats.decreaseCount = 0;
+  m_stats.increaseCount = 0;
+  applyScale(m_maxScale);
+}
+
+/**
+ * @brief Start timing a frame.
+ */
+void DynamicResolution::beginFrame()
+{
+  m_frameStart = Clock::now();
+}
+
+/**
+ * @brief Finish a frame and choose the render size of the next one.
+ *
+ * The frame time comes from the model if one is set, otherwise it is the
+ * time since beginFrame().
+ */
+void DynamicResolution::endFrame()
+{
+  float ms;
+  if (m_model)
+  {
+    ms = m_model(m_stats.frameCount, m_stats.renderWidth, m_stats.renderHeight);
+  }
+  else
+  {
+    ms = (float) std::chrono::duration<double, std::milli>(Clock::now() - m_frameStart).count();
+  }
+  update(ms);
+}
+
+/**
+ * @brief Account for a frame and choose the render size of the next one.
+ *
+ * @param[in] frameMs - time the frame took in milliseconds
+ */
+void DynamicResolution::update(float frameMs)
+{
+  Stats& stats = m_stats;
+  stats.frameMs = frameMs;
+  stats.averageMs = stats.frameCount == 0 ? frameMs :
+                    stats.averageMs + m_smoothing * (frameMs - stats.averageMs);
+  ++stats.frameCount;
+  if (frameMs > m_targetMs)
+  {
+    ++stats.overBudgetCount;
+  }
+
+  float scale = stats.scale;
+  if (m_policy == POLICY_PID)
+  {
+    float setpoint = m_targetMs * (1.0f - m_headroom);
+    float error = (setpoint - stats.averageMs) / setpoint;
+    m_controlScale += m_proportional * (error - m_errors[0]) + m_integral * error +
+                      m_derivative * (error - 2.0f * m_errors[0] + m_errors[1]);
+    m_controlScale = std::min(std::max(m_controlScale, m_minScale), m_maxScale);
+    m_errors[1] = m_errors[0];
+    m_errors[0] = error;
+
+    bool isAtLimit = m_controlScale == m_minScale || m_controlScale == m_maxScale;
+    if (fabsf(m_controlScale - scale) >= PID_DEADBAND || (isAtLimit && m_controlScale != scale))
+    {
+      scale = m_controlScale;
+    }
+  }
+  else
+  {
+    if (stats.averageMs > m_targetMs * m_upperRatio)
+    {
+      m_streak = std::max(m_streak, 0) + 1;
+    }
+    else if (stats.averageMs < m_targetMs * m_lowerRatio)
+    {
+      m_streak = std::min(m_streak, 0) - 1;
+    }
+    else
+    {
+      m_streak = 0;
+    }
+
+    if (m_streak >= (int) m_hysteresisFrames)
+    {
+      scale -= m_hysteresisStep;
+      m_streak = 0;
+    }
+    else if (-m_streak >= (int) m_hysteresisFrames)
+    {
+      scale += m_hysteresisStep;
+      m_streak = 0;
+    }
+    scale = std::min(std::max(scale, m_minScale), m_maxScale);
+  }
+
+  if (scale != stats.scale)
+  {
+    int area = stats.renderWidth * stats.renderHeight;
+    applyScale(scale);
+    int newArea = stats.renderWidth * stats.renderHeight;
+    if (newArea < area)
+    {
+      ++stats.decreaseCount;
+    }
+    else if (newArea > area)
+    {
+      ++stats.increaseCount;
+    }
+  }
+
+  LITE_PROFILE_COUNTER("DynamicResolution::frameMs", frameMs);
+  LITE_PROFILE_COUNTER("DynamicResolution::scale", stats.scale);
+}
+
+/**
+ * @brief Get the scale of the render size.
+ *
+ * @return The scale per axis.
+ */
+float DynamicResolution::getScale() const
+{
+  return m_stats.scale;
+}
+
+/**
+ * @brief Get the width frames are rendered at.
+ *
+ * @return The width in pixels.
+ */
+int DynamicResolution::getRenderWidth() const
+{
+  return m_stats.renderWidth;
+}
+
+/**
+ * @brief Get the height frames are rendered at.
+ *
+ * @return The height in pixels.
+ */
+int DynamicResolution::getRenderHeight() const
+{
+  return m_stats.renderHeight;
+}
+
+/**
+ * @brief Get the image to render the frame into.
+ *
+ * Its pixels are discarded when the render size changes.
+ *
+ * @return The render target.
+ */
+Image& DynamicResolution::getRenderTarget()
+{
+  return m_target;
+}
+
+/**
+ * @brief Draw the render target scaled to the client area of a window.
+ *
+ * A change of the client area takes effect on the next frame.
+ *
+ * @param[in] window - the window to draw to
+ * @param[in] pPool - optional pool that shares the scaling between threads
+ *
+ * @return True if the frame was drawn.
+ */
+bool DynamicResolution::present(Window& window, ThreadPool* pPool)
+{
+  bool isPresented = ImageOps::present(m_target, window, m_filter, m_scaled, pPool);
+  int width, height;
+  window.getClientSize(width, height);
+  if (width > 0 && height > 0 && (width != m_outputWidth || height != m_outputHeight))
+  {
+    setOutputSize(width, height);
+  }
+  return isPresented;
+}
+
+/**
+ * @brief Get the measurements and decisions so far.
+ *
+ * @param[out] stats - receives the statistics
+ */
+void DynamicResolution::getStats(Stats& stats) const
+{
+  stats = m_stats;
+}
+
+/* Set the scale and resize the render target to match. */
+void DynamicResolution::applyScale(float scale)
+{
+  int width = 0, height = 0;
+  if (m_outputWidth > 0 && m_outputHeight > 0)
+  {
+    // Whole blocks only, at most the output width rounded down and at least one block.
+    int maxWidth = std::max(m_outputWidth / WIDTH_ALIGNMENT, 1) * WIDTH_ALIGNMENT;
+    width = (int) (m_outputWidth * scale / WIDTH_ALIGNMENT + 0.5f) * WIDTH_ALIGNMENT;
+    width = std::min(std::max(width, (int) WIDTH_ALIGNMENT), maxWidth);
+    height = std::min(std::max((int) (m_outputHeight * scale + 0.5f), 1), m_outputHeight);
+  }
+
+  m_stats.scale = scale;
+  if (width != m_stats.renderWidth || height != m_stats.renderHeight)
+  {
+    m_stats.renderWidth = width;
+    m_stats.renderHeight = height;
+    m_target.resize(width, height);
+  }
+}
+
+}
@@ -0,0 +1,294 @@
+/**
+ * @file GlyphAtlas.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the GlyphAtlas class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\GlyphAtlas.h"
+#include "..\..\Include\LiteCube\Graphics\Font.h"
+
+#include <algorithm>
+
+namespace Lite
+{
+
+// Largest atlas side that glyph positions can address.
+static const int MAX_SIZE = 0xFFFF;
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] font - the font whose glyphs are cached, which has to outlive
+ *                   the atlas
+ * @param[in] width - width of the atlas in pixels
+ * @param[in] height - height of the atlas in pixels
+ */
+GlyphAtlas::GlyphAtlas(const Font& font, int width, int height)
+  : m_font(font)
+  , m_width(std::min(std::max(width, 1), MAX_SIZE))
+  , m_height(std::min(std::max(height, 1), MAX_SIZE))
+  , m_clock(0)
+  , m_releaseClock(0)
+  , m_hits(0)
+  , m_misses(0)
+  , m_evictions(0)
+{
+  m_shelfHeight = std::min(std::max(font.getMaxGlyphHeight(), 1), m_height);
+  m_pixels.assign((size_t) m_width * m_height, 0);
+  m_shelves.resize(m_height / m_shelfHeight);
+  clear();
+}
+
+/**
+ * @brief Find a glyph, rasterizing it into the atlas if it is not there.
+ *
+ * The glyph stays valid until its shelf is evicted, which does not happen
+ * before the next call to release().
+ *
+ * @param[in] codepoint - the character
+ *
+ * @return The glyph, or NULL if the atlas is full of glyphs that have not
+ *         been released.
+ */
+const GlyphAtlas::Glyph* GlyphAtlas::find(unsigned int codepoint)
+{
+  ++m_clock;
+  const Glyph* pGlyph = NULL;
+  if (codepoint < 256)
+  {
+    pGlyph = m_latin[codepoint];
+  }
+  else
+  {
+    std::unordered_map<unsigned int, Glyph>::const_iterator it = m_glyphs.find(codepoint);
+    if (it != m_glyphs.end())
+    {
+      pGlyph = &it->second;
+    }
+  }
+
+  if (pGlyph == NULL)
+  {
+    return insert(codepoint);
+  }
+  if (pGlyph->shelf != NO_SHELF)
+  {
+    m_shelves[pGlyph->shelf].lastUse = m_clock;
+  }
+  ++m_hits;
+  return pGlyph;
+}
+
+/**
+ * @brief Allow the glyphs found so far to be evicted.
+ *
+ * Called once everything that uses them has been drawn.
+ */
+void GlyphAtlas::release()
+{
+  m_releaseClock = m_clock;
+}
+
+/**
+ * @brief Remove all glyphs.
+ */
+void GlyphAtlas::clear()
+{
+  for (size_t i = 0; i < m_shelves.size(); ++i)
+  {
+    m_shelves[i].used = 0;
+    m_shelves[i].lastUse = 0;
+    m_shelves[i].codepoints.clear();
+  }
+  m_glyphs.clear();
+  std::fill(m_latin, m_latin + 256, static_cast<const Glyph*>(NULL));
+  m_releaseClock = m_clock;
+}
+
+/**
+ * @brief Get the font of the atlas.
+ *
+ * @return The font.
+ */
+const Font& GlyphAtlas::getFont() const
+{
+  return m_font;
+}
+
+/**
+ * @brief Get the width of the atlas.
+ *
+ * @return The width in pixels.
+ */
+int GlyphAtlas::getWidth() const
+{
+  return m_width;
+}
+
+/**
+ * @brief Get the height of the atlas.
+ *
+ * @return The height in pixels.
+ */
+int GlyphAtlas::getHeight() const
+{
+  return m_height;
+}
+
+/**
+ * @brief Get the coverage of the atlas.
+ *
+ * @return One byte per pixel, rows top first without padding.
+ */
+const unsigned char* GlyphAtlas::getPixels() const
+{
+  return &m_pixels[0];
+}
+
+/**
+ * @brief Get the number of glyphs in the atlas.
+ *
+ * @return The glyph count.
+ */
+size_t GlyphAtlas::getGlyphCount() const
+{
+  return m_glyphs.size();
+}
+
+/**
+ * @brief Get the number of lookups that found their glyph in the atlas.
+ *
+ * @return The hit count since the statistics were reset.
+ */
+size_t GlyphAtlas::getHitCount() const
+{
+  return m_hits;
+}
+
+/**
+ * @brief Get the number of glyphs that had to be rasterized.
+ *
+ * @return The miss count since the statistics were reset.
+ */
+size_t GlyphAtlas::getMissCount() const
+{
+  return m_misses;
+}
+
+/**
+ * @brief Get the number of glyphs removed to make room for others.
+ *
+ * @return The eviction count since the statistics were reset.
+ */
+size_t GlyphAtlas::getEvictionCount() const
+{
+  return m_evictions;
+}
+
+/**
+ * @brief Reset the hit, miss and eviction counts.
+ */
+void GlyphAtlas::resetStatistics()
+{
+  m_hits = 0;
+  m_misses = 0;
+  m_evictions = 0;
+}
+
+/*
+ * Rasterize a glyph into the first shelf with room, evicting the least
+ * recently used shelf that has been released if none has.
+ */
+const GlyphAtlas::Glyph* GlyphAtlas::insert(unsigned int codepoint)
+{
+  GlyphMetrics metrics;
+  m_font.getGlyphMetrics(codepoint, metrics);
+  metrics.width = std::min(std::max(metrics.width, 0), m_width);
+  metrics.height = std::min(std::max(metrics.height, 0), m_shelfHeight);
+
+  Glyph glyph;
+  glyph.x = 0;
+  glyph.y = 0;
+  glyph.width = (unsigned short) metrics.width;
+  glyph.height = (unsigned short) metrics.height;
+  glyph.left = (short) metrics.left;
+  glyph.top = (short) metrics.top;
+  glyph.advance = (short) metrics.advance;
+  glyph.shelf = NO_SHELF;
+
+  if (metrics.width > 0 && metrics.height > 0)
+  {
+    size_t count = m_shelves.size(), shelf = count;
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (m_shelves[i].used + metrics.width <= m_width)
+      {
+        shelf = i;
+        break;
+      }
+    }
+
+    if (shelf == count)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        if (m_shelves[i].lastUse <= m_releaseClock &&
+            (shelf == count || m_shelves[i].lastUse < m_shelves[shelf].lastUse))
+        {
+          shelf = i;
+        }
+      }
+      if (shelf == count)
+      {
+        return NULL;
+      }
+      evict(shelf);
+    }
+
+    Shelf& target = m_shelves[shelf];
+    glyph.x = (unsigned short) target.used;
+    glyph.y = (unsigned short) (shelf * m_shelfHeight);
+    glyph.shelf = (unsigned short) shelf;
+    target.used += metrics.width;
+    target.lastUse = m_clock;
+    target.codepoints.push_back(codepoint);
+    m_font.rasterize(codepoint, metrics, &m_pixels[(size_t) glyph.y * m_width + glyph.x],
+                     m_width);
+  }
+
+  Glyph& stored = m_glyphs[codepoint];
+  stored = glyph;
+  if (codepoint < 256)
+  {
+    m_latin[codepoint] = &stored;
+  }
+  ++m_misses;
+  return &stored;
+}
+
+/* Remove every glyph of a shelf. */
+void GlyphAtlas::evict(size_t shelf)
+{
+  Shelf& target = m_shelves[shelf];
+  for (size_t i = 0; i < target.codepoints.size(); ++i)
+  {
+    unsigned int codepoint = target.codepoints[i];
+    m_glyphs.erase(codepoint);
+    if (codepoint < 256)
+    {
+      m_latin[codepoint] = NULL;
+    }
+  }
+  m_evictions += target.codepoints.size();
+  target.codepoints.clear();
+  target.used = 0;
+}
+
+}
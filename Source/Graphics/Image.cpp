@@ -0,0 +1,157 @@
+/**
+ * @file Image.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the Image class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\Image.h"
+#include "..\..\Include\LiteCube\Core\Window.h"
+
+#include <algorithm>
+
+namespace Lite
+{
+
+/**
+ * @brief Constructor, creates an empty image.
+ */
+Image::Image()
+  : m_width(0)
+  , m_height(0)
+{
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] width  - width in pixels
+ * @param[in] height - height in pixels
+ * @param[in] color  - initial color of every pixel
+ */
+Image::Image(int width, int height, unsigned int color)
+  : m_width(0)
+  , m_height(0)
+{
+  resize(width, height, color);
+}
+
+/**
+ * @brief Change the size of the image, discarding its pixels.
+ *
+ * @param[in] width  - width in pixels
+ * @param[in] height - height in pixels
+ * @param[in] color  - new color of every pixel
+ */
+void Image::resize(int width, int height, unsigned int color)
+{
+  m_width = std::max(width, 0);
+  m_height = std::max(height, 0);
+  m_pixels.assign((size_t) m_width * m_height, color);
+}
+
+/**
+ * @brief Set every pixel to a color.
+ *
+ * @param[in] color - the color
+ */
+void Image::fill(unsigned int color)
+{
+  std::fill(m_pixels.begin(), m_pixels.end(), color);
+}
+
+/**
+ * @brief Obtain the width of the image.
+ *
+ * @return width in pixels
+ */
+int Image::getWidth() const
+{
+  return m_width;
+}
+
+/**
+ * @brief Obtain the height of the image.
+ *
+ * @return height in pixels
+ */
+int Image::getHeight() const
+{
+  return m_height;
+}
+
+/**
+ * @brief Check if the image has no pixels.
+ *
+ * @return true if the width or height is 0
+ */
+bool Image::isEmpty() const
+{
+  return m_pixels.empty();
+}
+
+/**
+ * @brief Obtain the pixels.
+ *
+ * @return getWidth() * getHeight() pixels, NULL for an empty image
+ */
+unsigned int* Image::getPixels()
+{
+  return m_pixels.empty() ? NULL : &m_pixels[0];
+}
+
+/**
+ * @brief Obtain the pixels.
+ *
+ * @return getWidth() * getHeight() pixels, NULL for an empty image
+ */
+const unsigned int* Image::getPixels() const
+{
+  return m_pixels.empty() ? NULL : &m_pixels[0];
+}
+
+/**
+ * @brief Obtain a row of pixels.
+ *
+ * @param[in] y - row index, 0 is the top
+ * @return getWidth() pixels
+ */
+unsigned int* Image::getRow(int y)
+{
+  return &m_pixels[(size_t) y * m_width];
+}
+
+/**
+ * @brief Obtain a row of pixels.
+ *
+ * @param[in] y - row index, 0 is the top
+ * @return getWidth() pixels
+ */
+const unsigned int* Image::getRow(int y) const
+{
+  return &m_pixels[(size_t) y * m_width];
+}
+
+/**
+ * @brief Show the image in a window, stretched to its client area.
+ *
+ * @param[in] window - the window to draw to
+ * @return true if the image was drawn
+ */
+bool Image::present(Window& window) const
+{
+  if (m_pixels.empty())
+  {
+    return false;
+  }
+  return window.present((const unsigned char*) &m_pixels[0], m_width, m_height,
+                        m_width * sizeof(unsigned int));
+}
+
+}
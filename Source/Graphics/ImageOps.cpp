@@ -0,0 +1,709 @@
+/**
+ * @file ImageOps.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the ImageOps class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\ImageOps.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+#include "..\..\Include\LiteCube\Core\Window.h"
+#include "..\..\Include\LiteCube\Graphics\Image.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(LITE_AVX2)
+#include <immintrin.h>
+#elif defined(LITE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+// Bits of the bilinear weights.
+static const int BILINEAR_BITS = 7;
+static const int BILINEAR_ONE = 1 << BILINEAR_BITS;
+
+// Box weights of an axis add up to this.
+static const int BOX_ONE = 256;
+
+/*
+ * Source pixels a box filtered target pixel covers along one axis and
+ * their weights, which start at offset in the weight array.
+ */
+struct BoxSpan
+{
+  int first;
+  int count;
+  int offset;
+};
+
+/*
+ * Map target pixel centers to source pixels for nearest sampling.
+ */
+static void buildNearest(int sourceSize, int targetSize, std::vector<int>& indices)
+{
+  indices.resize(targetSize);
+  for (int i = 0; i < targetSize; ++i)
+  {
+    long long index = (2LL * i + 1) * sourceSize / (2LL * targetSize);
+    indices[i] = (int) std::min(index, (long long) sourceSize - 1);
+  }
+}
+
+/*
+ * Map target pixel centers to the two nearest source pixels and the
+ * weight of the second one.
+ */
+static void buildBilinear(int sourceSize, int targetSize, std::vector<int>& first,
+                          std::vector<int>& second, std::vector<int>& weights)
+{
+  first.resize(targetSize);
+  second.resize(targetSize);
+  weights.resize(targetSize);
+  long long last = (long long) (sourceSize - 1) * BILINEAR_ONE;
+  for (int i = 0; i < targetSize; ++i)
+  {
+    long long position = (2LL * i + 1) * sourceSize * BILINEAR_ONE / (2LL * targetSize) -
+                         BILINEAR_ONE / 2;
+    position = std::min(std::max(position, 0LL), last);
+    first[i] = (int) (position >> BILINEAR_BITS);
+    second[i] = std::min(first[i] + 1, sourceSize - 1);
+    weights[i] = (int) (position & (BILINEAR_ONE - 1));
+  }
+}
+
+/*
+ * Weight every source pixel by how much of it a target pixel covers. The
+ * weights are rounded so that every target pixel has weights summing to
+ * BOX_ONE. If paired, spans are widened by a zero weight at the end to an
+ * even count, which may reach one pixel past the source. The column sums
+ * keep a zeroed spare pixel there.
+ */
+static void buildBox(int sourceSize, int targetSize, bool isPaired, std::vector<BoxSpan>& spans,
+                     std::vector<short>& weights)
+{
+  spans.resize(targetSize);
+  weights.clear();
+  for (int i = 0; i < targetSize; ++i)
+  {
+    // In units of 1 / targetSize source pixels.
+    long long left = (long long) i * sourceSize, right = left + sourceSize;
+    BoxSpan& span = spans[i];
+    span.first = (int) (left / targetSize);
+    span.count = (int) ((right + targetSize - 1) / targetSize) - span.first;
+    span.offset = (int) weights.size();
+
+    long long covered = 0;
+    int previous = 0;
+    for (int j = span.first; j < span.first + span.count; ++j)
+    {
+      covered += std::min(right, (j + 1LL) * targetSize) -
+                 std::max(left, (long long) j * targetSize);
+      int total = (int) ((covered * BOX_ONE + sourceSize / 2) / sourceSize);
+      weights.push_back((short) (total - previous));
+      previous = total;
+    }
+
+    if (isPaired && span.count % 2 != 0)
+    {
+      weights.push_back(0);
+      ++span.count;
+    }
+  }
+}
+
+/* Sample one row with the nearest filter. */
+static void nearestRow(const unsigned int* pSource, const int* pColumns, unsigned int* pTarget,
+                       int width)
+{
+  int x = 0;
+#ifdef LITE_AVX2
+  for (; x + 8 <= width; x += 8)
+  {
+    __m256i columns = _mm256_loadu_si256((const __m256i*) (pColumns + x));
+    _mm256_storeu_si256((__m256i*) (pTarget + x),
+                        _mm256_i32gather_epi32((const int*) pSource, columns, 4));
+  }
+#endif
+  for (; x < width; ++x)
+  {
+    pTarget[x] = pSource[pColumns[x]];
+  }
+}
+
+/* Interpolate between two values with a 7 bit weight. */
+static int lerp(int a, int b, int weight)
+{
+  return a + (((b - a) * weight + BILINEAR_ONE / 2) >> BILINEAR_BITS);
+}
+
+#if defined(LITE_SSE2) && !defined(LITE_AVX2)
+static __m128i lerp(__m128i a, __m128i b, __m128i weight)
+{
+  __m128i round = _mm_set1_epi16(BILINEAR_ONE / 2);
+  __m128i delta = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(b, a), weight), round);
+  return _mm_add_epi16(a, _mm_srai_epi16(delta, BILINEAR_BITS));
+}
+#endif
+
+#ifdef LITE_AVX2
+static __m256i lerp(__m256i a, __m256i b, __m256i weight)
+{
+  __m256i round = _mm256_set1_epi16(BILINEAR_ONE / 2);
+  __m256i delta = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(b, a), weight), round);
+  return _mm256_add_epi16(a, _mm256_srai_epi16(delta, BILINEAR_BITS));
+}
+
+/* Widen four pixels to 16 bits per channel. */
+static __m256i widen(__m128i pixels)
+{
+  return _mm256_cvtepu8_epi16(pixels);
+}
+#endif
+
+/*
+ * Sample one row with the bilinear filter. The SIMD kernels read the
+ * column weights repeated for each of the four channels.
+ */
+static void bilinearRow(const unsigned int* pRow0, const unsigned int* pRow1, int rowWeight,
+                        const int* pFirst, const int* pSecond, const int* pWeights,
+                        const short* pRepeatedWeights, unsigned int* pTarget, int width)
+{
+  int x = 0;
+#if defined(LITE_AVX2)
+  __m256i weightY = _mm256_set1_epi16((short) rowWeight);
+  for (; x + 8 <= width; x += 8)
+  {
+    __m256i first = _mm256_loadu_si256((const __m256i*) (pFirst + x));
+    __m256i second = _mm256_loadu_si256((const __m256i*) (pSecond + x));
+    __m256i a = _mm256_i32gather_epi32((const int*) pRow0, first, 4);
+    __m256i b = _mm256_i32gather_epi32((const int*) pRow0, second, 4);
+    __m256i c = _mm256_i32gather_epi32((const int*) pRow1, first, 4);
+    __m256i d = _mm256_i32gather_epi32((const int*) pRow1, second, 4);
+    __m256i weightLow = _mm256_loadu_si256((const __m256i*) (pRepeatedWeights + 4 * x));
+    __m256i weightHigh = _mm256_loadu_si256((const __m256i*) (pRepeatedWeights + 4 * x + 16));
+
+    __m256i low = lerp(lerp(widen(_mm256_castsi256_si128(a)), widen(_mm256_castsi256_si128(b)),
+                            weightLow),
+                       lerp(widen(_mm256_castsi256_si128(c)), widen(_mm256_castsi256_si128(d)),
+                            weightLow), weightY);
+    __m256i high = lerp(lerp(widen(_mm256_extracti128_si256(a, 1)),
+                             widen(_mm256_extracti128_si256(b, 1)), weightHigh),
+                        lerp(widen(_mm256_extracti128_si256(c, 1)),
+                             widen(_mm256_extracti128_si256(d, 1)), weightHigh), weightY);
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+    _mm256_storeu_si256((__m256i*) (pTarget + x), packed);
+  }
+#elif defined(LITE_SSE2)
+  __m128i zero = _mm_setzero_si128();
+  __m128i weightY = _mm_set1_epi16((short) rowWeight);
+  for (; x + 4 <= width; x += 4)
+  {
+    __m128i a = _mm_set_epi32(pRow0[pFirst[x + 3]], pRow0[pFirst[x + 2]], pRow0[pFirst[x + 1]],
+                              pRow0[pFirst[x]]);
+    __m128i b = _mm_set_epi32(pRow0[pSecond[x + 3]], pRow0[pSecond[x + 2]],
+                              pRow0[pSecond[x + 1]], pRow0[pSecond[x]]);
+    __m128i c = _mm_set_epi32(pRow1[pFirst[x + 3]], pRow1[pFirst[x + 2]], pRow1[pFirst[x + 1]],
+                              pRow1[pFirst[x]]);
+    __m128i d = _mm_set_epi32(pRow1[pSecond[x + 3]], pRow1[pSecond[x + 2]],
+                              pRow1[pSecond[x + 1]], pRow1[pSecond[x]]);
+    __m128i weightLow = _mm_loadu_si128((const __m128i*) (pRepeatedWeights + 4 * x));
+    __m128i weightHigh = _mm_loadu_si128((const __m128i*) (pRepeatedWeights + 4 * x + 8));
+
+    __m128i low = lerp(lerp(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero), weightLow),
+                       lerp(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(d, zero), weightLow),
+                       weightY);
+    __m128i high = lerp(lerp(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero), weightHigh),
+                        lerp(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(d, zero), weightHigh),
+                        weightY);
+    _mm_storeu_si128((__m128i*) (pTarget + x), _mm_packus_epi16(low, high));
+  }
+#endif
+
+  for (; x < width; ++x)
+  {
+    unsigned int a = pRow0[pFirst[x]], b = pRow0[pSecond[x]];
+    unsigned int c = pRow1[pFirst[x]], d = pRow1[pSecond[x]];
+    unsigned int result = 0;
+    for (int channel = 0; channel < 32; channel += 8)
+    {
+      int top = lerp((a >> channel) & 0xFF, (b >> channel) & 0xFF, pWeights[x]);
+      int bottom = lerp((c >> channel) & 0xFF, (d >> channel) & 0xFF, pWeights[x]);
+      result |= (unsigned int) lerp(top, bottom, rowWeight) << channel;
+    }
+    pTarget[x] = result;
+  }
+}
+
+/*
+ * Sum source rows with their box weights into 16 bit channels, halved so
+ * that the horizontal pass can use signed multiplies.
+ */
+static void boxColumns(const unsigned char* const* pRows, const short* pWeights, int rowCount,
+                       unsigned short* pTarget, int channelCount)
+{
+  int i = 0;
+#if defined(LITE_AVX2)
+  __m256i one = _mm256_set1_epi16(1);
+  for (; i + 32 <= channelCount; i += 32)
+  {
+    __m256i low = _mm256_setzero_si256(), high = _mm256_setzero_si256();
+    for (int r = 0; r < rowCount; ++r)
+    {
+      __m256i weight = _mm256_set1_epi16(pWeights[r]);
+      __m128i sourceLow = _mm_loadu_si128((const __m128i*) (pRows[r] + i));
+      __m128i sourceHigh = _mm_loadu_si128((const __m128i*) (pRows[r] + i + 16));
+      low = _mm256_add_epi16(low, _mm256_mullo_epi16(_mm256_cvtepu8_epi16(sourceLow), weight));
+      high = _mm256_add_epi16(high, _mm256_mullo_epi16(_mm256_cvtepu8_epi16(sourceHigh), weight));
+    }
+    _mm256_storeu_si256((__m256i*) (pTarget + i), _mm256_srli_epi16(_mm256_add_epi16(low, one), 1));
+    _mm256_storeu_si256((__m256i*) (pTarget + i + 16),
+                        _mm256_srli_epi16(_mm256_add_epi16(high, one), 1));
+  }
+#elif defined(LITE_SSE2)
+  __m128i zero = _mm_setzero_si128();
+  __m128i one = _mm_set1_epi16(1);
+  for (; i + 16 <= channelCount; i += 16)
+  {
+    __m128i low = zero, high = zero;
+    for (int r = 0; r < rowCount; ++r)
+    {
+      __m128i weight = _mm_set1_epi16(pWeights[r]);
+      __m128i source = _mm_loadu_si128((const __m128i*) (pRows[r] + i));
+      low = _mm_add_epi16(low, _mm_mullo_epi16(_mm_unpacklo_epi8(source, zero), weight));
+      high = _mm_add_epi16(high, _mm_mullo_epi16(_mm_unpackhi_epi8(source, zero), weight));
+    }
+    _mm_storeu_si128((__m128i*) (pTarget + i), _mm_srli_epi16(_mm_add_epi16(low, one), 1));
+    _mm_storeu_si128((__m128i*) (pTarget + i + 8), _mm_srli_epi16(_mm_add_epi16(high, one), 1));
+  }
+#endif
+  for (; i < channelCount; ++i)
+  {
+    unsigned int sum = 0;
+    for (int r = 0; r < rowCount; ++r)
+    {
+      sum += pRows[r][i] * pWeights[r];
+    }
+    pTarget[i] = (unsigned short) ((sum + 1) >> 1);
+  }
+}
+
+/*
+ * Sum the column sums under every target pixel with their box weights.
+ * With SSE2 the spans are paired and two source pixels are weighted per
+ * multiply-add.
+ */
+static void boxRow(const unsigned short* pColumns, const BoxSpan* pSpans, const short* pWeights,
+                   bool isPaired, unsigned int* pTarget, int width)
+{
+#ifdef LITE_SSE2
+  if (isPaired)
+  {
+    __m128i round = _mm_set1_epi32(1 << 14);
+    for (int x = 0; x < width; ++x)
+    {
+      const BoxSpan& span = pSpans[x];
+      const unsigned short* pSource = pColumns + 4 * span.first;
+      const short* pWeight = pWeights + span.offset;
+      __m128i sum = round;
+      for (int i = 0; i < span.count; i += 2)
+      {
+        __m128i pair = _mm_loadu_si128((const __m128i*) (pSource + 4 * i));
+        pair = _mm_unpacklo_epi16(pair, _mm_srli_si128(pair, 8));
+        __m128i weight = _mm_set1_epi32((unsigned short) pWeight[i] |
+                                        (unsigned int) pWeight[i + 1] << 16);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(pair, weight));
+      }
+      sum = _mm_srli_epi32(sum, 15);
+      sum = _mm_packs_epi32(sum, sum);
+      pTarget[x] = (unsigned int) _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+    }
+    return;
+  }
+#endif
+
+  for (int x = 0; x < width; ++x)
+  {
+    const BoxSpan& span = pSpans[x];
+    const unsigned short* pSource = pColumns + 4 * span.first;
+    const short* pWeight = pWeights + span.offset;
+    unsigned int result = 0;
+    for (int channel = 0; channel < 4; ++channel)
+    {
+      int sum = 1 << 14;
+      for (int i = 0; i < span.count; ++i)
+      {
+        sum += pSource[4 * i + channel] * pWeight[i];
+      }
+      result |= (unsigned int) std::min(sum >> 15, 255) << (8 * channel);
+    }
+    pTarget[x] = result;
+  }
+}
+
+/**
+ * @brief Scale an image to the size of another.
+ *
+ * @param[in] source - the image to scale
+ * @param[out] target - receives the scaled image, keeping its size
+ * @param[in] filter - how source pixels are sampled
+ * @param[in] pPool - optional pool that shares the rows between threads
+ */
+void ImageOps::scale(const Image& source, Image& target, Filter filter, ThreadPool* pPool)
+{
+  LITE_PROFILE_ZONE("ImageOps::scale");
+  int sourceWidth = source.getWidth(), sourceHeight = source.getHeight();
+  int targetWidth = target.getWidth(), targetHeight = target.getHeight();
+  if (source.isEmpty() || target.isEmpty())
+  {
+    return;
+  }
+
+  ThreadPool::RangeTask task;
+  std::vector<int> columns, secondColumns, rows, secondRows, columnWeights, rowWeights;
+  std::vector<short> repeatedWeights, boxColumnWeights, boxRowWeights;
+  std::vector<BoxSpan> columnSpans, rowSpans;
+  bool isPaired = false;
+
+  if (filter == FILTER_NEAREST)
+  {
+    buildNearest(sourceWidth, targetWidth, columns);
+    buildNearest(sourceHeight, targetHeight, rows);
+    task = [&](size_t begin, size_t end)
+    {
+      for (size_t y = begin; y < end; ++y)
+      {
+        unsigned int* pTarget = target.getRow((int) y);
+        if (y > begin && rows[y] == rows[y - 1])
+        {
+          memcpy(pTarget, target.getRow((int) y - 1), targetWidth * sizeof(unsigned int));
+        }
+        else if (sourceWidth == targetWidth)
+        {
+          memcpy(pTarget, source.getRow(rows[y]), targetWidth * sizeof(unsigned int));
+        }
+        else
+        {
+          nearestRow(source.getRow(rows[y]), &columns[0], pTarget, targetWidth);
+        }
+      }
+    };
+  }
+  else if (filter == FILTER_BILINEAR)
+  {
+    buildBilinear(sourceWidth, targetWidth, columns, secondColumns, columnWeights);
+    buildBilinear(sourceHeight, targetHeight, rows, secondRows, rowWeights);
+    repeatedWeights.resize(4 * targetWidth);
+    for (int x = 0; x < targetWidth; ++x)
+    {
+      std::fill(&repeatedWeights[4 * x], &repeatedWeights[4 * x] + 4, (short) columnWeights[x]);
+    }
+    task = [&](size_t begin, size_t end)
+    {
+      for (size_t y = begin; y < end; ++y)
+      {
+        bilinearRow(source.getRow(rows[y]), source.getRow(secondRows[y]), rowWeights[y],
+                    &columns[0], &secondColumns[0], &columnWeights[0], &repeatedWeights[0],
+                    target.getRow((int) y), targetWidth);
+      }
+    };
+  }
+  else
+  {
+#ifdef LITE_SSE2
+    isPaired = sourceWidth >= 2;
+#endif
+    buildBox(sourceWidth, targetWidth, isPaired, columnSpans, boxColumnWeights);
+    buildBox(sourceHeight, targetHeight, false, rowSpans, boxRowWeights);
+    task = [&](size_t begin, size_t end)
+    {
+      // One spare pixel for the padding of paired spans, never written.
+      std::vector<unsigned short> sums(4 * ((size_t) sourceWidth + 1), 0);
+      std::vector<const unsigned char*> pRows;
+      for (size_t y = begin; y < end; ++y)
+      {
+        const BoxSpan& span = rowSpans[y];
+        pRows.resize(span.count);
+        for (int r = 0; r < span.count; ++r)
+        {
+          pRows[r] = reinterpret_cast<const unsigned char*>(source.getRow(span.first + r));
+        }
+        boxColumns(&pRows[0], &boxRowWeights[span.offset], span.count, &sums[0],
+                   4 * sourceWidth);
+        boxRow(&sums[0], &columnSpans[0], &boxColumnWeights[0], isPaired,
+               target.getRow((int) y), targetWidth);
+      }
+    };
+  }
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, targetHeight, ROW_GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, targetHeight);
+  }
+}
+
+/**
+ * @brief Swap the red and blue channels, converting between RGBA and BGRA.
+ *
+ * @param[in] pSource - the pixels to convert
+ * @param[out] pTarget - receives the converted pixels, may be pSource
+ * @param[in] count - number of pixels
+ * @param[in] pPool - optional pool that shares the pixels between threads
+ */
+void ImageOps::swapRedBlue(const unsigned int* pSource, unsigned int* pTarget, size_t count,
+                           ThreadPool* pPool)
+{
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+    size_t i = begin;
+#if defined(LITE_AVX2)
+    __m256i order = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                     2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    for (; i + 8 <= end; i += 8)
+    {
+      __m256i pixels = _mm256_loadu_si256((const __m256i*) (pSource + i));
+      _mm256_storeu_si256((__m256i*) (pTarget + i), _mm256_shuffle_epi8(pixels, order));
+    }
+#elif defined(LITE_SSE2)
+    __m128i keep = _mm_set1_epi32((int) 0xFF00FF00);
+    __m128i low = _mm_set1_epi32(0xFF);
+    for (; i + 4 <= end; i += 4)
+    {
+      __m128i pixels = _mm_loadu_si128((const __m128i*) (pSource + i));
+      __m128i swapped = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 16), low),
+                                     _mm_slli_epi32(_mm_and_si128(pixels, low), 16));
+      _mm_storeu_si128((__m128i*) (pTarget + i),
+                       _mm_or_si128(_mm_and_si128(pixels, keep), swapped));
+    }
+#endif
+    for (; i < end; ++i)
+    {
+      unsigned int pixel = pSource[i];
+      pTarget[i] = (pixel & 0xFF00FF00) | (pixel >> 16 & 0xFF) | (pixel & 0xFF) << 16;
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, PIXEL_GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, count);
+  }
+}
+
+/**
+ * @brief Multiply the color channels with alpha.
+ *
+ * @param[in] pSource - pixels with straight alpha
+ * @param[out] pTarget - receives pixels with premultiplied alpha, may be
+ *                       pSource
+ * @param[in] count - number of pixels
+ * @param[in] pPool - optional pool that shares the pixels between threads
+ */
+void ImageOps::premultiply(const unsigned int* pSource, unsigned int* pTarget, size_t count,
+                           ThreadPool* pPool)
+{
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+    size_t i = begin;
+#if defined(LITE_AVX2)
+    __m256i zero = _mm256_setzero_si256();
+    __m256i half = _mm256_set1_epi16(128);
+    __m256i alphaMask = _mm256_set1_epi32((int) 0xFF000000);
+    for (; i + 8 <= end; i += 8)
+    {
+      __m256i pixels = _mm256_loadu_si256((const __m256i*) (pSource + i));
+      __m256i low = _mm256_unpacklo_epi8(pixels, zero);
+      __m256i high = _mm256_unpackhi_epi8(pixels, zero);
+      __m256i alphaLow = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(low, 0xFF), 0xFF);
+      __m256i alphaHigh = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(high, 0xFF), 0xFF);
+      low = _mm256_add_epi16(_mm256_mullo_epi16(low, alphaLow), half);
+      high = _mm256_add_epi16(_mm256_mullo_epi16(high, alphaHigh), half);
+      low = _mm256_srli_epi16(_mm256_add_epi16(low, _mm256_srli_epi16(low, 8)), 8);
+      high = _mm256_srli_epi16(_mm256_add_epi16(high, _mm256_srli_epi16(high, 8)), 8);
+      __m256i result = _mm256_blendv_epi8(_mm256_packus_epi16(low, high), pixels, alphaMask);
+      _mm256_storeu_si256((__m256i*) (pTarget + i), result);
+    }
+#elif defined(LITE_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    __m128i half = _mm_set1_epi16(128);
+    __m128i alphaMask = _mm_set1_epi32((int) 0xFF000000);
+    for (; i + 4 <= end; i += 4)
+    {
+      __m128i pixels = _mm_loadu_si128((const __m128i*) (pSource + i));
+      __m128i low = _mm_unpacklo_epi8(pixels, zero);
+      __m128i high = _mm_unpackhi_epi8(pixels, zero);
+      __m128i alphaLow = _mm_shufflehi_epi16(_mm_shufflelo_epi16(low, 0xFF), 0xFF);
+      __m128i alphaHigh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(high, 0xFF), 0xFF);
+      low = _mm_add_epi16(_mm_mullo_epi16(low, alphaLow), half);
+      high = _mm_add_epi16(_mm_mullo_epi16(high, alphaHigh), half);
+      low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+      high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+      __m128i result = _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_packus_epi16(low, high)),
+                                    _mm_and_si128(pixels, alphaMask));
+      _mm_storeu_si128((__m128i*) (pTarget + i), result);
+    }
+#endif
+    for (; i < end; ++i)
+    {
+      unsigned int pixel = pSource[i], alpha = pixel >> 24, result = pixel & 0xFF000000;
+      for (int channel = 0; channel < 24; channel += 8)
+      {
+        unsigned int value = ((pixel >> channel) & 0xFF) * alpha + 128;
+        result |= ((value + (value >> 8)) >> 8) << channel;
+      }
+      pTarget[i] = result;
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, PIXEL_GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, count);
+  }
+}
+
+/**
+ * @brief Divide the color channels by alpha.
+ *
+ * Pixels with zero alpha become transparent black.
+ *
+ * @param[in] pSource - pixels with premultiplied alpha
+ * @param[out] pTarget - receives pixels with straight alpha, may be pSource
+ * @param[in] count - number of pixels
+ * @param[in] pPool - optional pool that shares the pixels between threads
+ */
+void ImageOps::unpremultiply(const unsigned int* pSource, unsigned int* pTarget, size_t count,
+                             ThreadPool* pPool)
+{
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+    size_t i = begin;
+#ifdef LITE_SSE2
+    __m128i zero = _mm_setzero_si128();
+    __m128 channelMax = _mm_set1_ps(255.0f);
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128i alphaMask = _mm_set1_epi32((int) 0xFF000000);
+    for (; i + 4 <= end; i += 4)
+    {
+      __m128i pixels = _mm_loadu_si128((const __m128i*) (pSource + i));
+      __m128i low = _mm_unpacklo_epi8(pixels, zero), high = _mm_unpackhi_epi8(pixels, zero);
+      __m128i channels[4] =
+      {
+        _mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+        _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero)
+      };
+      for (int p = 0; p < 4; ++p)
+      {
+        __m128 values = _mm_cvtepi32_ps(channels[p]);
+        __m128 alpha = _mm_shuffle_ps(values, values, 0xFF);
+        __m128 scaled = _mm_add_ps(_mm_mul_ps(values, _mm_div_ps(channelMax, alpha)), half);
+        channels[p] = _mm_and_si128(_mm_cvttps_epi32(scaled),
+                                    _mm_castps_si128(_mm_cmpgt_ps(alpha, _mm_setzero_ps())));
+      }
+      __m128i result = _mm_packus_epi16(_mm_packs_epi32(channels[0], channels[1]),
+                                        _mm_packs_epi32(channels[2], channels[3]));
+      result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(pixels, alphaMask));
+      _mm_storeu_si128((__m128i*) (pTarget + i), result);
+    }
+#endif
+    for (; i < end; ++i)
+    {
+      unsigned int pixel = pSource[i], alpha = pixel >> 24, result = pixel & 0xFF000000;
+      if (alpha != 0)
+      {
+        float scale = 255.0f / alpha;
+        for (int channel = 0; channel < 24; channel += 8)
+        {
+          int value = (int) (((pixel >> channel) & 0xFF) * scale + 0.5f);
+          result |= (unsigned int) std::min(value, 255) << channel;
+        }
+      }
+      pTarget[i] = result;
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, PIXEL_GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, count);
+  }
+}
+
+/**
+ * @brief Draw an image scaled to the client area of a window.
+ *
+ * The image is drawn as it is if it already has the size of the client
+ * area. Otherwise it is scaled into another image, which is resized only
+ * when the size of the window changes.
+ *
+ * @param[in] image - the image to draw
+ * @param[in] window - the window to draw to
+ * @param[in] filter - how the image is sampled when scaled
+ * @param[in,out] scaled - keeps the scaled image between calls
+ * @param[in] pPool - optional pool that shares the rows between threads
+ *
+ * @return True if the image was drawn.
+ */
+bool ImageOps::present(const Image& image, Window& window, Filter filter, Image& scaled,
+                       ThreadPool* pPool)
+{
+  int width, height;
+  window.getClientSize(width, height);
+  if (image.isEmpty() || width <= 0 || height <= 0)
+  {
+    return false;
+  }
+  if (width == image.getWidth() && height == image.getHeight())
+  {
+    return image.present(window);
+  }
+
+  if (scaled.getWidth() != width || scaled.getHeight() != height)
+  {
+    scaled.resize(width, height);
+  }
+  scale(image, scaled, filter, pPool);
+  return scaled.present(window);
+}
+
+/**
+ * @brief Get the instruction set the kernels were compiled for.
+ *
+ * @return "AVX2", "SSE2" or "scalar".
+ */
+const char* ImageOps::getInstructionSet()
+{
+#if defined(LITE_AVX2)
+  return "AVX2";
+#elif defined(LITE_SSE2)
+  return "SSE2";
+#else
+  return "scalar";
+#endif
+}
+
+}
@@ -0,0 +1,460 @@
+/**
+ * @file RenderQueue.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the RenderQueue class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\RenderQueue.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Lite
+{
+
+// Payload offset of commands without a payload.
+static const unsigned int NO_PAYLOAD = 0xFFFFFFFF;
+
+// Below this many keys an insertion sort is faster than the radix passes.
+static const size_t INSERTION_SORT_LIMIT = 64;
+
+// Smallest number of keys per sorting task.
+static const size_t SORT_GRAIN_SIZE = 16384;
+
+// Commands gathered or reordered per task.
+static const size_t COPY_GRAIN_SIZE = 65536;
+
+RenderBackend::~RenderBackend()
+{
+}
+
+/**
+ * @brief Constructor.
+ */
+CommandBuffer::CommandBuffer()
+{
+}
+
+/**
+ * @brief Record a command and reserve its payload.
+ *
+ * @param[in] key  - sort key
+ * @param[in] type - command type
+ * @param[in] size - payload size in bytes, may be 0
+ * @return payload to fill in, aligned to PAYLOAD_ALIGNMENT and valid
+ *         until the next push, NULL if size is 0
+ */
+void* CommandBuffer::push(SortKey key, unsigned int type, size_t size)
+{
+  Entry entry;
+  entry.key  = key;
+  entry.type = type;
+  entry.offset = NO_PAYLOAD;
+  if (size > 0)
+  {
+    size_t offset = (m_payload.size() + PAYLOAD_ALIGNMENT - 1) & ~(PAYLOAD_ALIGNMENT - 1);
+    m_payload.resize(offset + size);
+    entry.offset = (unsigned int) offset;
+  }
+  m_entries.push_back(entry);
+  return size > 0 ? &m_payload[entry.offset] : NULL;
+}
+
+/**
+ * @brief Record a command with a copy of its payload.
+ *
+ * @param[in] key   - sort key
+ * @param[in] type  - command type
+ * @param[in] pData - payload
+ * @param[in] size  - payload size in bytes
+ */
+void CommandBuffer::push(SortKey key, unsigned int type, const void* pData, size_t size)
+{
+  void* pPayload = push(key, type, size);
+  if (pPayload != NULL)
+  {
+    memcpy(pPayload, pData, size);
+  }
+}
+
+/**
+ * @brief Remove all commands, keeping the memory.
+ */
+void CommandBuffer::clear()
+{
+  m_entries.clear();
+  m_payload.clear();
+}
+
+/**
+ * @brief Obtain the number of recorded commands.
+ *
+ * @return command count
+ */
+size_t CommandBuffer::getCount() const
+{
+  return m_entries.size();
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] bufferCount - number of command buffers, one per recording
+ *                          thread
+ */
+RenderQueue::RenderQueue(unsigned int bufferCount)
+{
+  setBufferCount(bufferCount);
+}
+
+/**
+ * @brief Destructor.
+ */
+RenderQueue::~RenderQueue()
+{
+  for (size_t i = 0; i < m_buffers.size(); ++i)
+  {
+    delete m_buffers[i];
+  }
+}
+
+/**
+ * @brief Change the number of command buffers.
+ *
+ * Removed buffers lose their commands.
+ *
+ * @param[in] bufferCount - number of command buffers, at least 1
+ */
+void RenderQueue::setBufferCount(unsigned int bufferCount)
+{
+  bufferCount = std::max(bufferCount, 1u);
+  while (m_buffers.size() > bufferCount)
+  {
+    delete m_buffers.back();
+    m_buffers.pop_back();
+  }
+  while (m_buffers.size() < bufferCount)
+  {
+    m_buffers.push_back(new CommandBuffer());
+  }
+}
+
+/**
+ * @brief Obtain the number of command buffers.
+ *
+ * @return buffer count
+ */
+unsigned int RenderQueue::getBufferCount() const
+{
+  return (unsigned int) m_buffers.size();
+}
+
+/**
+ * @brief Obtain a command buffer to record into.
+ *
+ * A buffer may only be used by one thread at a time.
+ *
+ * @param[in] index - buffer index, less than getBufferCount()
+ * @return the buffer
+ */
+CommandBuffer& RenderQueue::getBuffer(unsigned int index)
+{
+  return *m_buffers[index];
+}
+
+/**
+ * @brief Remove the commands of all buffers.
+ */
+void RenderQueue::clear()
+{
+  for (size_t i = 0; i < m_buffers.size(); ++i)
+  {
+    m_buffers[i]->clear();
+  }
+  m_commands.clear();
+}
+
+/**
+ * @brief Merge the command buffers and sort the commands by key.
+ *
+ * The buffers must not be recorded into until the sorted commands have
+ * been executed.
+ *
+ * @param[in] pPool - pool to sort on, NULL to run on the calling thread
+ */
+void RenderQueue::sort(ThreadPool* pPool)
+{
+  LITE_PROFILE_ZONE("RenderQueue::sort");
+
+  std::vector<size_t> offsets(m_buffers.size() + 1, 0);
+  for (size_t i = 0; i < m_buffers.size(); ++i)
+  {
+    offsets[i + 1] = offsets[i] + m_buffers[i]->getCount();
+  }
+  size_t count = offsets.back();
+  m_keys.resize(count);
+  m_values.resize(count);
+  m_keysTemp.resize(count);
+  m_valuesTemp.resize(count);
+  m_recorded.resize(count);
+  m_commands.resize(count);
+  if (count == 0)
+  {
+    return;
+  }
+
+  ThreadPool::RangeTask gatherTask = [&](size_t begin, size_t end) {
+    for (size_t b = begin; b < end; ++b)
+    {
+      const CommandBuffer& buffer = *m_buffers[b];
+      size_t first = offsets[b];
+      for (size_t i = 0; i < buffer.m_entries.size(); ++i)
+      {
+        const CommandBuffer::Entry& entry = buffer.m_entries[i];
+        RenderCommand& command = m_recorded[first + i];
+        command.key   = entry.key;
+        command.type  = entry.type;
+        command.pData = entry.offset != NO_PAYLOAD ? &buffer.m_payload[entry.offset] : NULL;
+        m_keys[first + i] = entry.key;
+        m_values[first + i] = (unsigned int) (first + i);
+      }
+    }
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, m_buffers.size(), 1, gatherTask);
+  }
+  else
+  {
+    gatherTask(0, m_buffers.size());
+  }
+
+  sortKeys(&m_keys[0], &m_values[0], count, &m_keysTemp[0], &m_valuesTemp[0], pPool);
+
+  ThreadPool::RangeTask reorderTask = [this](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      m_commands[i] = m_recorded[m_values[i]];
+    }
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, COPY_GRAIN_SIZE, reorderTask);
+  }
+  else
+  {
+    reorderTask(0, count);
+  }
+}
+
+/**
+ * @brief Hand the sorted commands to a backend.
+ *
+ * @param[in] backend - the backend to execute on
+ */
+void RenderQueue::execute(RenderBackend& backend) const
+{
+  LITE_PROFILE_ZONE("RenderQueue::execute");
+  if (!m_commands.empty())
+  {
+    backend.execute(&m_commands[0], m_commands.size());
+  }
+}
+
+/**
+ * @brief Obtain the number of sorted commands.
+ *
+ * @return command count of the last sort()
+ */
+size_t RenderQueue::getCommandCount() const
+{
+  return m_commands.size();
+}
+
+/**
+ * @brief Obtain the sorted commands.
+ *
+ * @return commands in key order, NULL if there are none
+ */
+const RenderCommand* RenderQueue::getCommands() const
+{
+  return m_commands.empty() ? NULL : &m_commands[0];
+}
+
+/**
+ * @brief Map a depth to bits which sort in the same order.
+ *
+ * Complement the result to sort back to front.
+ *
+ * @param[in] depth - any finite float
+ * @return bits ordered like the depth
+ */
+unsigned int RenderQueue::encodeDepth(float depth)
+{
+  unsigned int bits;
+  memcpy(&bits, &depth, sizeof(bits));
+  return (bits & 0x80000000) != 0 ? ~bits : bits | 0x80000000;
+}
+
+/**
+ * @brief Stable sort of keys together with a value per key.
+ *
+ * @param[in,out] pKeys       - keys, sorted on return
+ * @param[in,out] pValues     - values, reordered like the keys
+ * @param[in]     count       - number of keys
+ * @param[in]     pKeysTemp   - scratch memory for count keys
+ * @param[in]     pValuesTemp - scratch memory for count values
+ * @param[in]     pPool       - pool to sort on, NULL to run on the calling
+ *                              thread
+ */
+void RenderQueue::sortKeys(SortKey* pKeys, unsigned int* pValues, size_t count,
+                           SortKey* pKeysTemp, unsigned int* pValuesTemp, ThreadPool* pPool)
+{
+  if (count < INSERTION_SORT_LIMIT)
+  {
+    for (size_t i = 1; i < count; ++i)
+    {
+      SortKey key = pKeys[i];
+      unsigned int value = pValues[i];
+      size_t j = i;
+      for (; j > 0 && pKeys[j - 1] > key; --j)
+      {
+        pKeys[j] = pKeys[j - 1];
+        pValues[j] = pValues[j - 1];
+      }
+      pKeys[j] = key;
+      pValues[j] = value;
+    }
+    return;
+  }
+
+  size_t chunkCount = 1;
+  if (pPool != NULL)
+  {
+    chunkCount = std::min((size_t) pPool->getThreadCount() + 1, count / SORT_GRAIN_SIZE);
+    chunkCount = std::max(chunkCount, (size_t) 1);
+  }
+  const unsigned int passCount = (64 + RADIX_BITS - 1) / RADIX_BITS;
+  std::vector<size_t> counts(chunkCount * RADIX_SIZE * passCount, 0);
+  std::vector<SortKey> varying(chunkCount, 0);
+
+  // Count the digits of every pass and find the bits which differ between
+  // keys, digits without any are skipped. The counts of a chunk are only
+  // valid for the first pass, unless there is a single chunk.
+  ThreadPool::RangeTask histogramTask = [&](size_t begin, size_t end) {
+    for (size_t chunk = begin; chunk < end; ++chunk)
+    {
+      size_t* pCounts = &counts[chunk * RADIX_SIZE * passCount];
+      SortKey first = pKeys[0], bits = 0;
+      for (size_t i = chunk * count / chunkCount; i < (chunk + 1) * count / chunkCount; ++i)
+      {
+        SortKey key = pKeys[i];
+        bits |= key ^ first;
+        for (unsigned int pass = 0; pass < passCount; ++pass)
+        {
+          ++pCounts[pass * RADIX_SIZE + ((key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1))];
+        }
+      }
+      varying[chunk] = bits;
+    }
+  };
+  if (chunkCount > 1)
+  {
+    pPool->parallelFor(0, chunkCount, 1, histogramTask);
+  }
+  else
+  {
+    histogramTask(0, 1);
+  }
+  SortKey varyingBits = 0;
+  for (size_t i = 0; i < chunkCount; ++i)
+  {
+    varyingBits |= varying[i];
+  }
+
+  SortKey* pSourceKeys = pKeys;
+  unsigned int* pSourceValues = pValues;
+  SortKey* pTargetKeys = pKeysTemp;
+  unsigned int* pTargetValues = pValuesTemp;
+  bool isFirstPass = true;
+  for (unsigned int pass = 0; pass < passCount; ++pass)
+  {
+    unsigned int shift = pass * RADIX_BITS;
+    if (((varyingBits >> shift) & (RADIX_SIZE - 1)) == 0)
+    {
+      continue;
+    }
+
+    ThreadPool::RangeTask countTask = [&](size_t begin, size_t end) {
+      for (size_t chunk = begin; chunk < end; ++chunk)
+      {
+        size_t* pCounts = &counts[(chunk * passCount + pass) * RADIX_SIZE];
+        std::fill(pCounts, pCounts + RADIX_SIZE, 0);
+        for (size_t i = chunk * count / chunkCount; i < (chunk + 1) * count / chunkCount; ++i)
+        {
+          ++pCounts[(pSourceKeys[i] >> shift) & (RADIX_SIZE - 1)];
+        }
+      }
+    };
+    if (chunkCount > 1 && !isFirstPass)
+    {
+      pPool->parallelFor(0, chunkCount, 1, countTask);
+    }
+    isFirstPass = false;
+
+    // Each chunk writes its keys of a digit after those of earlier chunks.
+    size_t offset = 0;
+    for (unsigned int digit = 0; digit < RADIX_SIZE; ++digit)
+    {
+      for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+      {
+        size_t& digitCount = counts[(chunk * passCount + pass) * RADIX_SIZE + digit];
+        size_t digitOffset = offset;
+        offset += digitCount;
+        digitCount = digitOffset;
+      }
+    }
+
+    ThreadPool::RangeTask scatterTask = [&](size_t begin, size_t end) {
+      for (size_t chunk = begin; chunk < end; ++chunk)
+      {
+        size_t* pOffsets = &counts[(chunk * passCount + pass) * RADIX_SIZE];
+        for (size_t i = chunk * count / chunkCount; i < (chunk + 1) * count / chunkCount; ++i)
+        {
+          SortKey key = pSourceKeys[i];
+          size_t target = pOffsets[(key >> shift) & (RADIX_SIZE - 1)]++;
+          pTargetKeys[target] = key;
+          pTargetValues[target] = pSourceValues[i];
+        }
+      }
+    };
+    if (chunkCount > 1)
+    {
+      pPool->parallelFor(0, chunkCount, 1, scatterTask);
+    }
+    else
+    {
+      scatterTask(0, 1);
+    }
+
+    std::swap(pSourceKeys, pTargetKeys);
+    std::swap(pSourceValues, pTargetValues);
+  }
+
+  if (pSourceKeys != pKeys)
+  {
+    memcpy(pKeys, pSourceKeys, count * sizeof(SortKey));
+    memcpy(pValues, pSourceValues, count * sizeof(unsigned int));
+  }
+}
+
+}
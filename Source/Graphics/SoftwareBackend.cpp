@@ -0,0 +1,212 @@
+/**
+ * @file SoftwareBackend.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the SoftwareBackend class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\SoftwareBackend.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+#include "..\..\Include\LiteCube\Core\Window.h"
+
+#include <algorithm>
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+/*
+ * Blend a color with the given alpha over a span of pixels, rounding like
+ * a division by 255.
+ */
+static void blendSpan(unsigned int* pPixels, int count, unsigned int color)
+{
+  unsigned int alpha = color >> 24;
+  unsigned int inverse = 255 - alpha;
+  unsigned int source[4] = { (color & 0xFF) * alpha, ((color >> 8) & 0xFF) * alpha,
+                             ((color >> 16) & 0xFF) * alpha, 255 * alpha };
+  int i = 0;
+#ifdef LITE_SSE2
+  __m128i zero = _mm_setzero_si128();
+  __m128i inverseFactor = _mm_set1_epi16((short) inverse);
+  __m128i sourceTerm = _mm_add_epi16(_mm_setr_epi16((short) source[0], (short) source[1],
+                                                    (short) source[2], (short) source[3],
+                                                    (short) source[0], (short) source[1],
+                                                    (short) source[2], (short) source[3]),
+                                     _mm_set1_epi16(128));
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i pixels = _mm_loadu_si128((const __m128i*) (pPixels + i));
+    __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), inverseFactor),
+                                sourceTerm);
+    __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), inverseFactor),
+                                 sourceTerm);
+    low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+    high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+    _mm_storeu_si128((__m128i*) (pPixels + i), _mm_packus_epi16(low, high));
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    unsigned int pixel = pPixels[i], result = 0;
+    for (int channel = 0; channel < 4; ++channel)
+    {
+      unsigned int value = ((pixel >> (channel * 8)) & 0xFF) * inverse + source[channel] + 128;
+      result |= ((value + (value >> 8)) >> 8) << (channel * 8);
+    }
+    pPixels[i] = result;
+  }
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param[in] width  - buffer width in pixels
+ * @param[in] height - buffer height in pixels
+ * @param[in] pPool  - pool to execute on, NULL to run on the calling thread
+ */
+SoftwareBackend::SoftwareBackend(int width, int height, ThreadPool* pPool)
+  : m_width(std::max(width, 1))
+  , m_height(std::max(height, 1))
+  , m_pPool(pPool)
+{
+  m_pixels.resize((size_t) m_width * m_height, 0);
+}
+
+/**
+ * @brief Destructor.
+ */
+SoftwareBackend::~SoftwareBackend()
+{
+}
+
+/**
+ * @brief Execute commands in order.
+ *
+ * @param[in] pCommands - commands, usually sorted by a RenderQueue
+ * @param[in] count     - number of commands
+ */
+void SoftwareBackend::execute(const RenderCommand* pCommands, size_t count)
+{
+  LITE_PROFILE_ZONE("SoftwareBackend::execute");
+  // Every band walks all commands, so there is one band per thread.
+  int bandHeight = m_height;
+  if (m_pPool != NULL)
+  {
+    bandHeight = std::max((int) (m_height / (m_pPool->getThreadCount() + 1)),
+                          (int) MIN_BAND_HEIGHT);
+  }
+  ThreadPool::RangeTask task = [this, pCommands, count, bandHeight](size_t begin, size_t end) {
+    for (size_t band = begin; band < end; ++band)
+    {
+      int beginRow = (int) band * bandHeight;
+      executeBand(pCommands, count, beginRow, std::min(beginRow + bandHeight, m_height));
+    }
+  };
+
+  size_t bandCount = (m_height + bandHeight - 1) / bandHeight;
+  if (m_pPool != NULL && bandCount > 1)
+  {
+    m_pPool->parallelFor(0, bandCount, 1, task);
+  }
+  else
+  {
+    task(0, bandCount);
+  }
+}
+
+/**
+ * @brief Obtain the width of the buffer.
+ *
+ * @return width in pixels
+ */
+int SoftwareBackend::getWidth() const
+{
+  return m_width;
+}
+
+/**
+ * @brief Obtain the height of the buffer.
+ *
+ * @return height in pixels
+ */
+int SoftwareBackend::getHeight() const
+{
+  return m_height;
+}
+
+/**
+ * @brief Obtain the pixels.
+ *
+ * @return getWidth() * getHeight() pixels, top row first
+ */
+const unsigned int* SoftwareBackend::getPixels() const
+{
+  return &m_pixels[0];
+}
+
+/**
+ * @brief Show the buffer in a window, stretched to its client area.
+ *
+ * @param[in] window - the window to draw to
+ * @return true if the buffer was drawn
+ */
+bool SoftwareBackend::present(Window& window) const
+{
+  return window.present((const unsigned char*) &m_pixels[0], m_width, m_height,
+                        m_width * sizeof(unsigned int));
+}
+
+/*
+ * Execute all commands clipped to a band of rows.
+ */
+void SoftwareBackend::executeBand(const RenderCommand* pCommands, size_t count, int beginRow,
+                                  int endRow)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    const RenderCommand& command = pCommands[i];
+    if (command.type == COMMAND_CLEAR)
+    {
+      const ClearCommand* pClear = static_cast<const ClearCommand*>(command.pData);
+      std::fill(m_pixels.begin() + (size_t) beginRow * m_width,
+                m_pixels.begin() + (size_t) endRow * m_width, pClear->color);
+    }
+    else if (command.type == COMMAND_FILL_RECT || command.type == COMMAND_BLEND_RECT)
+    {
+      const RectCommand* pRect = static_cast<const RectCommand*>(command.pData);
+      int x0 = std::max(pRect->x, 0), x1 = std::min(pRect->x + pRect->width, m_width);
+      int y0 = std::max(pRect->y, beginRow), y1 = std::min(pRect->y + pRect->height, endRow);
+      if (x0 >= x1 || y0 >= y1)
+      {
+        continue;
+      }
+
+      bool isOpaque = command.type == COMMAND_FILL_RECT || (pRect->color >> 24) == 255;
+      for (int y = y0; y < y1; ++y)
+      {
+        unsigned int* pRow = &m_pixels[(size_t) y * m_width];
+        if (isOpaque)
+        {
+          std::fill(pRow + x0, pRow + x1, pRect->color);
+        }
+        else
+        {
+          blendSpan(pRow + x0, x1 - x0, pRect->color);
+        }
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,461 @@
+/**
+ * @file SpriteBatch.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the SpriteBatch class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\SpriteBatch.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+#include "..\..\Include\LiteCube\Graphics\Image.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+// Sprites turned into quads per task.
+static const size_t QUAD_GRAIN_SIZE = 4096;
+
+// Texels gathered before they are blended.
+static const int SPAN_SIZE = 64;
+
+/*
+ * Blend straight alpha source pixels over the target, rounding like a
+ * division by 255.
+ */
+static void blendPixels(unsigned int* pTarget, const unsigned int* pSource, int count)
+{
+  int i = 0;
+#ifdef LITE_SSE2
+  __m128i zero = _mm_setzero_si128();
+  __m128i opaque = _mm_set1_epi32((int) 0xFF000000);
+  __m128i channelMax = _mm_set1_epi16(255);
+  __m128i half = _mm_set1_epi16(128);
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i source = _mm_loadu_si128((const __m128i*) (pSource + i));
+    int alphaMask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(source, opaque), opaque));
+    if (alphaMask == 0xFFFF)
+    {
+      _mm_storeu_si128((__m128i*) (pTarget + i), source);
+      continue;
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(source, opaque), zero)) == 0xFFFF)
+    {
+      continue;
+    }
+
+    // The alpha of each pixel is spread over its channels, the source alpha
+    // channel itself counts as 255 so that the result is a + d * (1 - a).
+    __m128i target = _mm_loadu_si128((const __m128i*) (pTarget + i));
+    __m128i sourceLow = _mm_unpacklo_epi8(source, zero);
+    __m128i sourceHigh = _mm_unpackhi_epi8(source, zero);
+    __m128i alphaLow = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sourceLow, 0xFF), 0xFF);
+    __m128i alphaHigh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sourceHigh, 0xFF), 0xFF);
+    sourceLow = _mm_unpacklo_epi8(_mm_or_si128(source, opaque), zero);
+    sourceHigh = _mm_unpackhi_epi8(_mm_or_si128(source, opaque), zero);
+
+    __m128i low = _mm_add_epi16(_mm_mullo_epi16(sourceLow, alphaLow),
+                                _mm_mullo_epi16(_mm_unpacklo_epi8(target, zero),
+                                                _mm_sub_epi16(channelMax, alphaLow)));
+    __m128i high = _mm_add_epi16(_mm_mullo_epi16(sourceHigh, alphaHigh),
+                                 _mm_mullo_epi16(_mm_unpackhi_epi8(target, zero),
+                                                 _mm_sub_epi16(channelMax, alphaHigh)));
+    low = _mm_add_epi16(low, half);
+    high = _mm_add_epi16(high, half);
+    low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+    high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+    _mm_storeu_si128((__m128i*) (pTarget + i), _mm_packus_epi16(low, high));
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    unsigned int source = pSource[i];
+    unsigned int alpha = source >> 24;
+    if (alpha == 255)
+    {
+      pTarget[i] = source;
+    }
+    else if (alpha != 0)
+    {
+      unsigned int target = pTarget[i], result = 0;
+      source |= 0xFF000000;
+      for (int channel = 0; channel < 32; channel += 8)
+      {
+        unsigned int value = ((source >> channel) & 0xFF) * alpha +
+                             ((target >> channel) & 0xFF) * (255 - alpha) + 128;
+        result |= ((value + (value >> 8)) >> 8) << channel;
+      }
+      pTarget[i] = result;
+    }
+  }
+}
+
+/*
+ * Multiply the channels of a texel with a tint.
+ */
+static unsigned int modulate(unsigned int texel, unsigned int color)
+{
+  unsigned int result = 0;
+  for (int channel = 0; channel < 32; channel += 8)
+  {
+    unsigned int value = ((texel >> channel) & 0xFF) * ((color >> channel) & 0xFF) + 128;
+    result |= ((value + (value >> 8)) >> 8) << channel;
+  }
+  return result;
+}
+
+/*
+ * Convert a whole number to int, clamped to a range before the conversion
+ * so that huge values stay defined. NaN goes to the minimum.
+ */
+static int clampToInt(float value, int minimum, int maximum)
+{
+  return value > (float) minimum ? (value < (float) maximum ? (int) value : maximum) : minimum;
+}
+
+static bool isFinite(float value)
+{
+  return value - value == 0.0f;
+}
+
+/*
+ * Narrow a row to the pixels whose centers map into [0, 1) of a linear
+ * function f(x) = slope * (x + 0.5) + offset.
+ */
+static void clipSpan(float slope, float offset, int& begin, int& end)
+{
+  if (slope > 0.0f)
+  {
+    begin = clampToInt(ceilf(-offset / slope - 0.5f), begin, end);
+    end = clampToInt(ceilf((1.0f - offset) / slope - 0.5f), begin, end);
+  }
+  else if (slope < 0.0f)
+  {
+    begin = clampToInt(floorf((1.0f - offset) / slope - 0.5f) + 1.0f, begin, end);
+    end = clampToInt(floorf(-offset / slope - 0.5f) + 1.0f, begin, end);
+  }
+  else if (offset < 0.0f || offset >= 1.0f)
+  {
+    end = begin;
+  }
+}
+
+/**
+ * @brief Constructor.
+ */
+SpriteBatch::SpriteBatch()
+  : m_pLastTexture(NULL)
+  , m_lastTextureId(0)
+  , m_batchCount(0)
+{
+}
+
+/**
+ * @brief Start collecting sprites for a frame.
+ *
+ * @param[in] view - transform from world to target pixels
+ */
+void SpriteBatch::begin(const Matrix3x2& view)
+{
+  m_view = view;
+  m_sprites.clear();
+  m_keys.clear();
+  m_textureIds.clear();
+  m_pLastTexture = NULL;
+  m_lastTextureId = 0;
+}
+
+/**
+ * @brief Add a sprite.
+ *
+ * @param[in] sprite - the sprite, its texture must live until end()
+ */
+void SpriteBatch::draw(const Sprite& sprite)
+{
+  if (sprite.pTexture != m_pLastTexture)
+  {
+    std::map<const Image*, unsigned int>::iterator it = m_textureIds.find(sprite.pTexture);
+    if (it == m_textureIds.end())
+    {
+      it = m_textureIds.insert(std::make_pair(sprite.pTexture,
+                                              (unsigned int) m_textureIds.size())).first;
+    }
+    m_pLastTexture = sprite.pTexture;
+    m_lastTextureId = it->second;
+  }
+
+  // Layer, texture and submission order, the layer biased to sort signed.
+  SortKey layer = (SortKey) ((sprite.layer + 0x8000) & 0xFFFF);
+  m_keys.push_back((layer << 48) | ((SortKey) (m_lastTextureId & 0xFFFF) << 32) |
+                   (SortKey) m_sprites.size());
+  m_sprites.push_back(sprite);
+}
+
+/**
+ * @brief Add a whole texture at its size, untinted and unrotated.
+ *
+ * @param[in] pTexture - the texture, must live until end()
+ * @param[in] position - top left corner
+ * @param[in] layer    - lower layers are drawn first
+ */
+void SpriteBatch::draw(const Image* pTexture, const Vector2f& position, int layer)
+{
+  Sprite sprite;
+  sprite.pTexture  = pTexture;
+  sprite.position  = position;
+  sprite.size      = Vector2f((float) pTexture->getWidth(), (float) pTexture->getHeight());
+  sprite.origin    = Vector2f(0.0f, 0.0f);
+  sprite.rotation  = 0.0f;
+  sprite.source[0] = 0;
+  sprite.source[1] = 0;
+  sprite.source[2] = pTexture->getWidth();
+  sprite.source[3] = pTexture->getHeight();
+  sprite.color     = 0xFFFFFFFF;
+  sprite.layer     = layer;
+  draw(sprite);
+}
+
+/**
+ * @brief Sort and draw the collected sprites.
+ *
+ * @param[in,out] target - image to draw into
+ * @param[in]     pPool  - pool to draw on, NULL to run on the calling
+ *                         thread
+ */
+void SpriteBatch::end(Image& target, ThreadPool* pPool)
+{
+  LITE_PROFILE_ZONE("SpriteBatch::end");
+  size_t count = m_sprites.size();
+  m_order.resize(count);
+  m_orderTemp.resize(count);
+  m_keysTemp.resize(count);
+  m_corners.resize(count * 4);
+  m_quads.resize(count);
+  m_batchCount = 0;
+  if (count == 0 || target.isEmpty())
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_order[i] = (unsigned int) i;
+  }
+  RenderQueue::sortKeys(&m_keys[0], &m_order[0], count, &m_keysTemp[0], &m_orderTemp[0], pPool);
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_batchCount += i == 0 || (m_keys[i] >> 32) != (m_keys[i - 1] >> 32) ? 1 : 0;
+  }
+
+  int width = target.getWidth(), height = target.getHeight();
+  ThreadPool::RangeTask quadTask = [this, width, height](size_t begin, size_t end) {
+    buildQuads(begin, end, width, height);
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, QUAD_GRAIN_SIZE, quadTask);
+  }
+  else
+  {
+    quadTask(0, count);
+  }
+
+  // Every band walks all quads, so there is one band per thread.
+  int bandHeight = height;
+  if (pPool != NULL)
+  {
+    bandHeight = std::max((int) (height / (pPool->getThreadCount() + 1)), (int) MIN_BAND_HEIGHT);
+  }
+  ThreadPool::RangeTask bandTask = [this, &target, bandHeight, height](size_t begin, size_t end) {
+    for (size_t band = begin; band < end; ++band)
+    {
+      int beginRow = (int) band * bandHeight;
+      rasterizeBand(target, beginRow, std::min(beginRow + bandHeight, height));
+    }
+  };
+  size_t bandCount = (height + bandHeight - 1) / bandHeight;
+  if (pPool != NULL && bandCount > 1)
+  {
+    pPool->parallelFor(0, bandCount, 1, bandTask);
+  }
+  else
+  {
+    bandTask(0, bandCount);
+  }
+}
+
+/**
+ * @brief Obtain the number of sprites collected since begin().
+ *
+ * @return sprite count
+ */
+size_t SpriteBatch::getSpriteCount() const
+{
+  return m_sprites.size();
+}
+
+/**
+ * @brief Obtain the number of runs of sprites sharing layer and texture
+ *        drawn by the last end().
+ *
+ * @return batch count
+ */
+size_t SpriteBatch::getBatchCount() const
+{
+  return m_batchCount;
+}
+
+/*
+ * Place the corners of a range of sorted sprites, transform them by the
+ * view in one go and set up the pixel to texel mapping. Bounds are clamped
+ * to a pixel around the target, and source rectangles to the texture.
+ */
+void SpriteBatch::buildQuads(size_t begin, size_t end, int width, int height)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    const Sprite& sprite = m_sprites[m_order[i]];
+    Matrix3x2 world = Matrix3x2::transform(sprite.position, sprite.rotation, sprite.size,
+                                           sprite.origin);
+    Vector2f* pCorners = &m_corners[i * 4];
+    pCorners[0] = Vector2f(world.dx, world.dy);
+    pCorners[1] = Vector2f(world.dx + world.m11, world.dy + world.m12);
+    pCorners[2] = Vector2f(world.dx + world.m21, world.dy + world.m22);
+    pCorners[3] = Vector2f(pCorners[1].x + world.m21, pCorners[1].y + world.m22);
+  }
+  m_view.transformPoints(&m_corners[begin * 4], &m_corners[begin * 4], (end - begin) * 4);
+
+  for (size_t i = begin; i < end; ++i)
+  {
+    const Sprite& sprite = m_sprites[m_order[i]];
+    const Vector2f* pCorners = &m_corners[i * 4];
+    Quad& quad = m_quads[i];
+    quad.pTexture = sprite.pTexture;
+    quad.color = sprite.color;
+
+    float minX = std::min(std::min(pCorners[0].x, pCorners[1].x),
+                          std::min(pCorners[2].x, pCorners[3].x));
+    float maxX = std::max(std::max(pCorners[0].x, pCorners[1].x),
+                          std::max(pCorners[2].x, pCorners[3].x));
+    float minY = std::min(std::min(pCorners[0].y, pCorners[1].y),
+                          std::min(pCorners[2].y, pCorners[3].y));
+    float maxY = std::max(std::max(pCorners[0].y, pCorners[1].y),
+                          std::max(pCorners[2].y, pCorners[3].y));
+    quad.bounds[0] = clampToInt(floorf(minX), -1, width);
+    quad.bounds[1] = clampToInt(floorf(minY), -1, height);
+    quad.bounds[2] = clampToInt(ceilf(maxX), -1, width);
+    quad.bounds[3] = clampToInt(ceilf(maxY), -1, height);
+
+    // The part of the source rectangle inside the texture.
+    int sourceX0 = 0, sourceY0 = 0, sourceX1 = 0, sourceY1 = 0;
+    if (quad.pTexture != NULL)
+    {
+      sourceX0 = std::max(sprite.source[0], 0);
+      sourceY0 = std::max(sprite.source[1], 0);
+      sourceX1 = (int) std::min((long long) sprite.source[0] + sprite.source[2],
+                                (long long) quad.pTexture->getWidth());
+      sourceY1 = (int) std::min((long long) sprite.source[1] + sprite.source[3],
+                                (long long) quad.pTexture->getHeight());
+    }
+    quad.source[0] = sourceX0;
+    quad.source[1] = sourceY0;
+    quad.source[2] = sourceX1 - sourceX0;
+    quad.source[3] = sourceY1 - sourceY0;
+
+    // Invert the edges to map pixels back to s and t across the sprite.
+    float ax = pCorners[1].x - pCorners[0].x, ay = pCorners[1].y - pCorners[0].y;
+    float bx = pCorners[2].x - pCorners[0].x, by = pCorners[2].y - pCorners[0].y;
+    float det = ax * by - ay * bx;
+    float inv = 1.0f / det;
+    quad.sAxis[0] = by * inv;
+    quad.sAxis[1] = -bx * inv;
+    quad.sAxis[2] = -(quad.sAxis[0] * pCorners[0].x + quad.sAxis[1] * pCorners[0].y);
+    quad.tAxis[0] = -ay * inv;
+    quad.tAxis[1] = ax * inv;
+    quad.tAxis[2] = -(quad.tAxis[0] * pCorners[0].x + quad.tAxis[1] * pCorners[0].y);
+
+    bool isMapped = det != 0.0f;
+    for (int k = 0; k < 3; ++k)
+    {
+      isMapped = isMapped && isFinite(quad.sAxis[k]) && isFinite(quad.tAxis[k]);
+    }
+    if (!isMapped || quad.pTexture == NULL || quad.source[2] <= 0 || quad.source[3] <= 0)
+    {
+      quad.bounds[3] = quad.bounds[1] - 1;
+    }
+  }
+}
+
+/*
+ * Draw the quads in order, clipped to a band of rows.
+ */
+void SpriteBatch::rasterizeBand(Image& target, int beginRow, int endRow) const
+{
+  unsigned int span[SPAN_SIZE];
+  int width = target.getWidth();
+  for (size_t q = 0; q < m_quads.size(); ++q)
+  {
+    const Quad& quad = m_quads[q];
+    int y0 = std::max(quad.bounds[1], beginRow), y1 = std::min(quad.bounds[3] + 1, endRow);
+    int x0 = std::max(quad.bounds[0], 0), x1 = std::min(quad.bounds[2] + 1, width);
+    if (y0 >= y1 || x0 >= x1)
+    {
+      continue;
+    }
+
+    const Image& texture = *quad.pTexture;
+    int textureWidth = texture.getWidth();
+    const unsigned int* pTexels = texture.getPixels();
+    float sourceX = (float) quad.source[0], sourceY = (float) quad.source[1];
+    float sourceWidth = (float) quad.source[2], sourceHeight = (float) quad.source[3];
+    int lastX = quad.source[0] + quad.source[2] - 1;
+    int lastY = quad.source[1] + quad.source[3] - 1;
+    bool isTinted = quad.color != 0xFFFFFFFF;
+
+    for (int y = y0; y < y1; ++y)
+    {
+      float centerY = y + 0.5f;
+      float sOffset = quad.sAxis[1] * centerY + quad.sAxis[2];
+      float tOffset = quad.tAxis[1] * centerY + quad.tAxis[2];
+      int begin = x0, end = x1;
+      clipSpan(quad.sAxis[0], sOffset, begin, end);
+      clipSpan(quad.tAxis[0], tOffset, begin, end);
+      unsigned int* pRow = target.getRow(y);
+
+      for (int x = begin; x < end; x += SPAN_SIZE)
+      {
+        int count = std::min(end - x, SPAN_SIZE);
+        float centerX = x + 0.5f;
+        float u = sourceX + (quad.sAxis[0] * centerX + sOffset) * sourceWidth;
+        float v = sourceY + (quad.tAxis[0] * centerX + tOffset) * sourceHeight;
+        float uStep = quad.sAxis[0] * sourceWidth, vStep = quad.tAxis[0] * sourceHeight;
+        for (int i = 0; i < count; ++i)
+        {
+          int tx = std::min(std::max((int) u, quad.source[0]), lastX);
+          int ty = std::min(std::max((int) v, quad.source[1]), lastY);
+          unsigned int texel = pTexels[(size_t) ty * textureWidth + tx];
+          span[i] = isTinted ? modulate(texel, quad.color) : texel;
+          u += uStep;
+          v += vStep;
+        }
+        blendPixels(pRow + x, span, count);
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,311 @@
+/**
+ * @file TextRenderer.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the TextRenderer class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\TextRenderer.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Graphics\Font.h"
+#include "..\..\Include\LiteCube\Graphics\GlyphAtlas.h"
+#include "..\..\Include\LiteCube\Graphics\Image.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef LITE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+// Drawn for malformed UTF-8.
+static const unsigned int REPLACEMENT_CHARACTER = 0xFFFD;
+
+/*
+ * Decode the next character of a UTF-8 string. Invalid sequences give the
+ * replacement character and never skip the terminating zero.
+ */
+static unsigned int decodeUtf8(const unsigned char*& pText)
+{
+  unsigned int codepoint = *pText++;
+  if (codepoint < 0x80)
+  {
+    return codepoint;
+  }
+
+  int extra;
+  unsigned int minimum;
+  if ((codepoint & 0xE0) == 0xC0)
+  {
+    extra = 1;
+    minimum = 0x80;
+    codepoint &= 0x1F;
+  }
+  else if ((codepoint & 0xF0) == 0xE0)
+  {
+    extra = 2;
+    minimum = 0x800;
+    codepoint &= 0x0F;
+  }
+  else if ((codepoint & 0xF8) == 0xF0)
+  {
+    extra = 3;
+    minimum = 0x10000;
+    codepoint &= 0x07;
+  }
+  else
+  {
+    return REPLACEMENT_CHARACTER;
+  }
+
+  for (int i = 0; i < extra; ++i)
+  {
+    if ((*pText & 0xC0) != 0x80)
+    {
+      return REPLACEMENT_CHARACTER;
+    }
+    codepoint = codepoint << 6 | (*pText++ & 0x3F);
+  }
+  return codepoint < minimum || codepoint > 0x10FFFF ? REPLACEMENT_CHARACTER : codepoint;
+}
+
+/*
+ * Blend a color over the target with its alpha scaled by coverage,
+ * rounding like a division by 255.
+ */
+static void blendCoverage(unsigned int* pTarget, const unsigned char* pCoverage, int count,
+                          unsigned int color)
+{
+  unsigned int colorAlpha = color >> 24;
+  unsigned int opaque = color | 0xFF000000;
+  int i = 0;
+#ifdef LITE_SSE2
+  __m128i zero = _mm_setzero_si128();
+  __m128i channelMax = _mm_set1_epi16(255);
+  __m128i half = _mm_set1_epi16(128);
+  __m128i alphaScale = _mm_set1_epi16((short) colorAlpha);
+  __m128i source = _mm_unpacklo_epi8(_mm_set1_epi32((int) opaque), zero);
+  __m128i solid = _mm_set1_epi32((int) opaque);
+  for (; i + 4 <= count; i += 4)
+  {
+    int coverage;
+    memcpy(&coverage, pCoverage + i, 4);
+    if (coverage == 0)
+    {
+      continue;
+    }
+    if (coverage == -1 && colorAlpha == 255)
+    {
+      _mm_storeu_si128((__m128i*) (pTarget + i), solid);
+      continue;
+    }
+
+    __m128i alpha = _mm_unpacklo_epi8(_mm_cvtsi32_si128(coverage), zero);
+    alpha = _mm_add_epi16(_mm_mullo_epi16(alpha, alphaScale), half);
+    alpha = _mm_srli_epi16(_mm_add_epi16(alpha, _mm_srli_epi16(alpha, 8)), 8);
+    alpha = _mm_unpacklo_epi16(alpha, alpha);
+    __m128i alphaLow = _mm_unpacklo_epi32(alpha, alpha);
+    __m128i alphaHigh = _mm_unpackhi_epi32(alpha, alpha);
+
+    __m128i target = _mm_loadu_si128((const __m128i*) (pTarget + i));
+    __m128i low = _mm_add_epi16(_mm_mullo_epi16(source, alphaLow),
+                                _mm_mullo_epi16(_mm_unpacklo_epi8(target, zero),
+                                                _mm_sub_epi16(channelMax, alphaLow)));
+    __m128i high = _mm_add_epi16(_mm_mullo_epi16(source, alphaHigh),
+                                 _mm_mullo_epi16(_mm_unpackhi_epi8(target, zero),
+                                                 _mm_sub_epi16(channelMax, alphaHigh)));
+    low = _mm_add_epi16(low, half);
+    high = _mm_add_epi16(high, half);
+    low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+    high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+    _mm_storeu_si128((__m128i*) (pTarget + i), _mm_packus_epi16(low, high));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    unsigned int alpha = pCoverage[i] * colorAlpha + 128;
+    alpha = (alpha + (alpha >> 8)) >> 8;
+    if (alpha == 255)
+    {
+      pTarget[i] = opaque;
+    }
+    else if (alpha != 0)
+    {
+      unsigned int target = pTarget[i], result = 0;
+      for (int channel = 0; channel < 32; channel += 8)
+      {
+        unsigned int value = ((opaque >> channel) & 0xFF) * alpha +
+                             ((target >> channel) & 0xFF) * (255 - alpha) + 128;
+        result |= ((value + (value >> 8)) >> 8) << channel;
+      }
+      pTarget[i] = result;
+    }
+  }
+}
+
+/**
+ * @brief Constructor.
+ */
+TextRenderer::TextRenderer()
+  : m_pTarget(NULL)
+  , m_glyphCount(0)
+  , m_flushCount(0)
+{
+}
+
+/**
+ * @brief Start collecting text.
+ *
+ * @param[in] target - the image the text is drawn into
+ */
+void TextRenderer::begin(Image& target)
+{
+  m_pTarget = &target;
+  m_quads.clear();
+  m_atlases.clear();
+  m_glyphCount = 0;
+  m_flushCount = 0;
+}
+
+/**
+ * @brief Lay out a string.
+ *
+ * Lines are separated by '\n' and start at the same x.
+ *
+ * @param[in] atlas - the glyphs of the font to draw with
+ * @param[in] pText - zero terminated UTF-8 text
+ * @param[in] x - left of the text in pixels
+ * @param[in] y - top of the first line in pixels
+ * @param[in] color - 0xAARRGGBB color of the text
+ */
+void TextRenderer::draw(GlyphAtlas& atlas, const char* pText, int x, int y, unsigned int color)
+{
+  if (m_pTarget == NULL || pText == NULL)
+  {
+    return;
+  }
+  if (std::find(m_atlases.begin(), m_atlases.end(), &atlas) == m_atlases.end())
+  {
+    m_atlases.push_back(&atlas);
+  }
+
+  const Font& font = atlas.getFont();
+  const unsigned char* pPixels = atlas.getPixels();
+  int stride = atlas.getWidth();
+  int targetWidth = m_pTarget->getWidth(), targetHeight = m_pTarget->getHeight();
+  int penX = x, baseline = y + font.getAscent(), lineHeight = font.getLineHeight();
+
+  const unsigned char* pCharacter = reinterpret_cast<const unsigned char*>(pText);
+  while (*pCharacter != 0)
+  {
+    unsigned int codepoint = decodeUtf8(pCharacter);
+    if (codepoint == '\n')
+    {
+      penX = x;
+      baseline += lineHeight;
+      continue;
+    }
+
+    const GlyphAtlas::Glyph* pGlyph = atlas.find(codepoint);
+    if (pGlyph == NULL)
+    {
+      flush();
+      pGlyph = atlas.find(codepoint);
+      if (pGlyph == NULL)
+      {
+        continue;
+      }
+    }
+
+    int left = penX + pGlyph->left, top = baseline + pGlyph->top;
+    int x0 = std::max(left, 0), y0 = std::max(top, 0);
+    int x1 = std::min(left + pGlyph->width, targetWidth);
+    int y1 = std::min(top + pGlyph->height, targetHeight);
+    if (x0 < x1 && y0 < y1)
+    {
+      Quad quad;
+      quad.pCoverage = pPixels + (size_t) (pGlyph->y + y0 - top) * stride + pGlyph->x + x0 - left;
+      quad.stride = stride;
+      quad.x = x0;
+      quad.y = y0;
+      quad.width = x1 - x0;
+      quad.height = y1 - y0;
+      quad.color = color;
+      m_quads.push_back(quad);
+    }
+    penX += pGlyph->advance;
+    ++m_glyphCount;
+  }
+}
+
+/**
+ * @brief Blit the collected text into the target.
+ */
+void TextRenderer::end()
+{
+  flush();
+  m_atlases.clear();
+  m_pTarget = NULL;
+}
+
+/**
+ * @brief Get the number of glyphs laid out since begin().
+ *
+ * @return The glyph count.
+ */
+size_t TextRenderer::getGlyphCount() const
+{
+  return m_glyphCount;
+}
+
+/**
+ * @brief Get the number of times glyphs were blitted since begin().
+ *
+ * @return 1 unless an atlas ran out of room during the frame.
+ */
+size_t TextRenderer::getFlushCount() const
+{
+  return m_flushCount;
+}
+
+/*
+ * Blit the quads collected so far and release the atlases they came from.
+ */
+void TextRenderer::flush()
+{
+  LITE_PROFILE_ZONE("TextRenderer::flush");
+  if (m_pTarget == NULL)
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < m_quads.size(); ++i)
+  {
+    const Quad& quad = m_quads[i];
+    const unsigned char* pCoverage = quad.pCoverage;
+    for (int y = 0; y < quad.height; ++y)
+    {
+      blendCoverage(m_pTarget->getRow(quad.y + y) + quad.x, pCoverage, quad.width, quad.color);
+      pCoverage += quad.stride;
+    }
+  }
+  m_quads.clear();
+
+  for (size_t i = 0; i < m_atlases.size(); ++i)
+  {
+    m_atlases[i]->release();
+  }
+  ++m_flushCount;
+}
+
+}
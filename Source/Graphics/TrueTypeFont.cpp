@@ -0,0 +1,819 @@
+/**
+ * @file TrueTypeFont.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the TrueTypeFont class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Graphics\TrueTypeFont.h"
+#include "..\..\Include\LiteCube\Core\MappedFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Lite
+{
+
+// Flags of a point of a simple glyph.
+static const unsigned char POINT_ON_CURVE = 0x01;
+static const unsigned char POINT_SHORT_X = 0x02;
+static const unsigned char POINT_SHORT_Y = 0x04;
+static const unsigned char POINT_REPEAT = 0x08;
+static const unsigned char POINT_SAME_X = 0x10;
+static const unsigned char POINT_SAME_Y = 0x20;
+
+// Flags of a component of a composite glyph.
+static const unsigned int COMPONENT_ARGS_ARE_WORDS = 0x0001;
+static const unsigned int COMPONENT_ARGS_ARE_OFFSETS = 0x0002;
+static const unsigned int COMPONENT_SCALE = 0x0008;
+static const unsigned int COMPONENT_MORE = 0x0020;
+static const unsigned int COMPONENT_XY_SCALE = 0x0040;
+static const unsigned int COMPONENT_TWO_BY_TWO = 0x0080;
+
+// Nesting of composite glyphs followed before giving up.
+static const int MAX_COMPOSITE_DEPTH = 8;
+
+// Limits of a glyph with all its components, so that a damaged font whose
+// composites refer to each other many times cannot blow up. Larger glyphs
+// are drawn empty.
+static const size_t MAX_GLYPH_COMPONENTS = 1024;
+static const size_t MAX_GLYPH_POINTS = 65536;
+
+// Squared deviation of a curve from its chord in pixels which is drawn as
+// a line, and the tolerance that sets the number of lines otherwise.
+static const float FLAT_CURVE = 0.333f;
+static const float CURVE_TOLERANCE = 3.0f;
+
+/*
+ * Big endian readers which return zero past the end of the data, so a
+ * damaged file gives wrong glyphs rather than reading out of bounds.
+ */
+static unsigned int readU8(const std::vector<unsigned char>& data, size_t offset)
+{
+  return offset < data.size() ? data[offset] : 0;
+}
+
+static unsigned int readU16(const std::vector<unsigned char>& data, size_t offset)
+{
+  return readU8(data, offset) << 8 | readU8(data, offset + 1);
+}
+
+static int readS16(const std::vector<unsigned char>& data, size_t offset)
+{
+  return (short) readU16(data, offset);
+}
+
+static unsigned int readU32(const std::vector<unsigned char>& data, size_t offset)
+{
+  return readU16(data, offset) << 16 | readU16(data, offset + 2);
+}
+
+/* Read a 2.14 fixed point number. */
+static float readF2Dot14(const std::vector<unsigned char>& data, size_t offset)
+{
+  return readS16(data, offset) / 16384.0f;
+}
+
+/*
+ * Add the signed area covered by a line to the pixels it crosses. Summing
+ * a row from the left then gives the coverage of every pixel.
+ */
+static void drawLine(float* pArea, int width, int height, float x0, float y0, float x1, float y1)
+{
+  if (y0 == y1)
+  {
+    return;
+  }
+  float direction = 1.0f;
+  if (y0 > y1)
+  {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+    direction = -1.0f;
+  }
+  x0 = std::min(std::max(x0, 0.0f), (float) width);
+  x1 = std::min(std::max(x1, 0.0f), (float) width);
+
+  float slope = (x1 - x0) / (y1 - y0);
+  float x = x0;
+  int begin = 0;
+  if (y0 < 0.0f)
+  {
+    x -= y0 * slope;
+  }
+  else
+  {
+    begin = (int) y0;
+  }
+  int end = std::min(height, (int) ceilf(y1));
+
+  for (int y = begin; y < end; ++y)
+  {
+    float* pRow = pArea + (size_t) y * width;
+    float dy = std::min(y + 1.0f, y1) - std::max((float) y, y0);
+    float next = x + slope * dy;
+    float area = dy * direction;
+    float left = std::min(x, next), right = std::max(x, next);
+    float leftFloor = floorf(left), rightCeil = ceilf(right);
+    int first = (int) leftFloor, last = (int) rightCeil;
+
+    if (last <= first + 1)
+    {
+      float middle = 0.5f * (x + next) - leftFloor;
+      pRow[first] += area - area * middle;
+      pRow[first + 1] += area * middle;
+    }
+    else
+    {
+      float inverse = 1.0f / (right - left);
+      float leftFraction = left - leftFloor;
+      float a0 = 0.5f * inverse * (1.0f - leftFraction) * (1.0f - leftFraction);
+      float rightFraction = right - rightCeil + 1.0f;
+      float am = 0.5f * inverse * rightFraction * rightFraction;
+      pRow[first] += area * a0;
+      if (last == first + 2)
+      {
+        pRow[first + 1] += area * (1.0f - a0 - am);
+      }
+      else
+      {
+        float a1 = inverse * (1.5f - leftFraction);
+        pRow[first + 1] += area * (a1 - a0);
+        for (int i = first + 2; i < last - 1; ++i)
+        {
+          pRow[i] += area * inverse;
+        }
+        float a2 = a1 + (last - first - 3) * inverse;
+        pRow[last - 1] += area * (1.0f - a2 - am);
+      }
+      pRow[last] += area * am;
+    }
+    x = next;
+  }
+}
+
+/* Draw a quadratic Bezier curve as lines. */
+static void drawCurve(float* pArea, int width, int height, float x0, float y0, float x1, float y1,
+                      float x2, float y2)
+{
+  float dx = x0 - 2.0f * x1 + x2, dy = y0 - 2.0f * y1 + y2;
+  float deviation = dx * dx + dy * dy;
+  if (deviation < FLAT_CURVE)
+  {
+    drawLine(pArea, width, height, x0, y0, x2, y2);
+    return;
+  }
+
+  int steps = 1 + (int) sqrtf(sqrtf(CURVE_TOLERANCE * deviation));
+  float x = x0, y = y0;
+  for (int i = 1; i <= steps; ++i)
+  {
+    float t = (float) i / steps, s = 1.0f - t;
+    float nextX = s * s * x0 + 2.0f * s * t * x1 + t * t * x2;
+    float nextY = s * s * y0 + 2.0f * s * t * y1 + t * t * y2;
+    drawLine(pArea, width, height, x, y, nextX, nextY);
+    x = nextX;
+    y = nextY;
+  }
+}
+
+/**
+ * @brief Constructor.
+ */
+TrueTypeFont::TrueTypeFont()
+  : m_cmap(0)
+  , m_cmapFormat(0)
+  , m_loca(0)
+  , m_glyf(0)
+  , m_hmtx(0)
+  , m_metricCount(0)
+  , m_glyphCount(0)
+  , m_isLongLoca(false)
+  , m_pixelHeight(0.0f)
+  , m_scale(0.0f)
+  , m_ascent(0)
+  , m_descent(0)
+  , m_lineHeight(0)
+  , m_maxGlyphHeight(0)
+{
+}
+
+/**
+ * @brief Destructor.
+ */
+TrueTypeFont::~TrueTypeFont()
+{
+}
+
+/**
+ * @brief Load a font from memory.
+ *
+ * The data is copied and can be released afterwards.
+ *
+ * @param[in] pData - contents of a TrueType file
+ * @param[in] size - size of the data in bytes
+ * @param[in] pixelHeight - distance from the highest ascender to the lowest
+ *                          descender in pixels
+ *
+ * @return True if the font was loaded, false if the data is not a TrueType
+ *         font with the required tables.
+ */
+bool TrueTypeFont::load(const void* pData, size_t size, float pixelHeight)
+{
+  const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+  m_data.assign(pBytes, pBytes + size);
+  m_glyphCount = 0;
+
+  size_t cmap = 0, head = 0, hhea = 0, maxp = 0;
+  m_loca = m_glyf = m_hmtx = 0;
+  unsigned int tableCount = readU16(m_data, 4);
+  for (unsigned int i = 0; i < tableCount; ++i)
+  {
+    size_t record = 12 + 16 * i;
+    size_t offset = readU32(m_data, record + 8), length = readU32(m_data, record + 12);
+    if (record + 16 > size || offset > size || length > size - offset)
+    {
+      continue;
+    }
+
+    const char* pTag = reinterpret_cast<const char*>(&m_data[record]);
+    if (memcmp(pTag, "cmap", 4) == 0)
+    {
+      cmap = offset;
+    }
+    else if (memcmp(pTag, "head", 4) == 0)
+    {
+      head = offset;
+    }
+    else if (memcmp(pTag, "hhea", 4) == 0)
+    {
+      hhea = offset;
+    }
+    else if (memcmp(pTag, "maxp", 4) == 0)
+    {
+      maxp = offset;
+    }
+    else if (memcmp(pTag, "loca", 4) == 0)
+    {
+      m_loca = offset;
+    }
+    else if (memcmp(pTag, "glyf", 4) == 0)
+    {
+      m_glyf = offset;
+    }
+    else if (memcmp(pTag, "hmtx", 4) == 0)
+    {
+      m_hmtx = offset;
+    }
+  }
+
+  // Prefer a full Unicode map over one for the basic multilingual plane.
+  int best = 0;
+  unsigned int mapCount = readU16(m_data, cmap + 2);
+  for (unsigned int i = 0; cmap != 0 && i < mapCount; ++i)
+  {
+    size_t record = cmap + 4 + 8 * i;
+    unsigned int platform = readU16(m_data, record), encoding = readU16(m_data, record + 2);
+    size_t table = cmap + readU32(m_data, record + 4);
+    unsigned int format = readU16(m_data, table);
+    bool isUnicode = platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10));
+    int priority = !isUnicode ? 0 : format == 12 ? 2 : format == 4 ? 1 : 0;
+    if (priority > best)
+    {
+      best = priority;
+      m_cmap = table;
+      m_cmapFormat = format;
+    }
+  }
+
+  int ascender = readS16(m_data, hhea + 4), descender = readS16(m_data, hhea + 6);
+  if (best == 0 || head == 0 || hhea == 0 || maxp == 0 || m_loca == 0 || m_glyf == 0 ||
+      m_hmtx == 0 || ascender <= descender || pixelHeight <= 0.0f)
+  {
+    m_data.clear();
+    return false;
+  }
+
+  m_isLongLoca = readS16(m_data, head + 50) != 0;
+  m_metricCount = std::max(readU16(m_data, hhea + 34), 1u);
+  m_glyphCount = readU16(m_data, maxp + 4);
+  m_pixelHeight = pixelHeight;
+  m_scale = pixelHeight / (ascender - descender);
+  m_ascent = (int) ceilf(ascender * m_scale);
+  m_descent = (int) ceilf(-descender * m_scale);
+  m_lineHeight = (int) floorf((ascender - descender + readS16(m_data, hhea + 8)) * m_scale + 0.5f);
+  m_maxGlyphHeight = (int) ceilf(-readS16(m_data, head + 38) * m_scale) -
+                     (int) floorf(-readS16(m_data, head + 42) * m_scale);
+  return true;
+}
+
+/**
+ * @brief Load a font from a file.
+ *
+ * @param[in] path - path to a .ttf file
+ * @param[in] pixelHeight - distance from the highest ascender to the lowest
+ *                          descender in pixels
+ *
+ * @return True if the font was loaded.
+ */
+bool TrueTypeFont::loadFromFile(const String& path, float pixelHeight)
+{
+  MappedFile file;
+  if (!file.open(path))
+  {
+    m_data.clear();
+    m_glyphCount = 0;
+    return false;
+  }
+  return load(file.getData(), file.getSize(), pixelHeight);
+}
+
+/**
+ * @brief Check if a font is loaded.
+ *
+ * @return True if glyphs can be drawn.
+ */
+bool TrueTypeFont::isLoaded() const
+{
+  return m_glyphCount > 0;
+}
+
+/**
+ * @brief Get the size the font was loaded at.
+ *
+ * @return The pixel height.
+ */
+float TrueTypeFont::getPixelHeight() const
+{
+  return m_pixelHeight;
+}
+
+/**
+ * @brief Get the height of the font above the baseline.
+ *
+ * @return The ascent in pixels.
+ */
+int TrueTypeFont::getAscent() const
+{
+  return m_ascent;
+}
+
+/**
+ * @brief Get the depth of the font below the baseline.
+ *
+ * @return The descent in pixels.
+ */
+int TrueTypeFont::getDescent() const
+{
+  return m_descent;
+}
+
+/**
+ * @brief Get the distance between the baselines of two lines.
+ *
+ * @return The line height in pixels.
+ */
+int TrueTypeFont::getLineHeight() const
+{
+  return m_lineHeight;
+}
+
+/**
+ * @brief Get the height of the tallest glyph bitmap.
+ *
+ * @return The height in pixels, from the bounds of all glyphs.
+ */
+int TrueTypeFont::getMaxGlyphHeight() const
+{
+  return m_maxGlyphHeight;
+}
+
+/**
+ * @brief Get the size and placement of a glyph.
+ *
+ * @param[in] codepoint - the character
+ * @param[out] metrics - the glyph metrics
+ */
+void TrueTypeFont::getGlyphMetrics(unsigned int codepoint, GlyphMetrics& metrics) const
+{
+  metrics.width = metrics.height = 0;
+  metrics.left = metrics.top = metrics.advance = 0;
+  if (!isLoaded())
+  {
+    return;
+  }
+
+  unsigned int glyph = findGlyph(codepoint);
+  unsigned int advance = readU16(m_data, m_hmtx + 4 * std::min(glyph, m_metricCount - 1));
+  metrics.advance = (int) floorf(advance * m_scale + 0.5f);
+
+  size_t begin, end;
+  if (getGlyphRange(glyph, begin, end) && end - begin >= 10)
+  {
+    int left = (int) floorf(readS16(m_data, begin + 2) * m_scale);
+    int bottom = (int) ceilf(-readS16(m_data, begin + 4) * m_scale);
+    int right = (int) ceilf(readS16(m_data, begin + 6) * m_scale);
+    int top = (int) floorf(-readS16(m_data, begin + 8) * m_scale);
+    if (right > left && bottom > top)
+    {
+      metrics.width = right - left;
+      metrics.height = bottom - top;
+      metrics.left = left;
+      metrics.top = top;
+    }
+  }
+}
+
+/**
+ * @brief Draw the antialiased coverage of a glyph.
+ *
+ * @param[in] codepoint - the character
+ * @param[in] metrics - the glyph metrics, possibly reduced to clip it
+ * @param[out] pCoverage - where the top left pixel of the glyph is written
+ * @param[in] stride - distance between rows of the coverage in bytes
+ */
+void TrueTypeFont::rasterize(unsigned int codepoint, const GlyphMetrics& metrics,
+                             unsigned char* pCoverage, int stride) const
+{
+  int width = metrics.width, height = metrics.height;
+  if (width <= 0 || height <= 0)
+  {
+    return;
+  }
+
+  std::vector<Point> points;
+  std::vector<size_t> contourEnds;
+  size_t componentBudget = MAX_GLYPH_COMPONENTS;
+  if (!readOutline(findGlyph(codepoint), 0, componentBudget, points, contourEnds))
+  {
+    // Still write the coverage, as empty.
+    points.clear();
+    contourEnds.clear();
+  }
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    points[i].x = points[i].x * m_scale - metrics.left;
+    points[i].y = -points[i].y * m_scale - metrics.top;
+  }
+
+  // Lines may touch the pixel past the end of the last row.
+  std::vector<float> area((size_t) width * height + 2, 0.0f);
+  size_t begin = 0;
+  for (size_t c = 0; c < contourEnds.size(); ++c)
+  {
+    size_t end = contourEnds[c], count = end - begin;
+    if (count < 2)
+    {
+      begin = end;
+      continue;
+    }
+
+    // Start from a point on the curve, or between the first two control
+    // points if there is none.
+    size_t first = begin;
+    while (first < end && !points[first].isOnCurve)
+    {
+      ++first;
+    }
+    float startX, startY;
+    if (first < end)
+    {
+      startX = points[first].x;
+      startY = points[first].y;
+      ++first;
+    }
+    else
+    {
+      startX = 0.5f * (points[begin].x + points[end - 1].x);
+      startY = 0.5f * (points[begin].y + points[end - 1].y);
+      first = begin;
+    }
+
+    float x = startX, y = startY, controlX = 0.0f, controlY = 0.0f;
+    bool hasControl = false;
+    for (size_t i = 0; i <= count; ++i)
+    {
+      float nextX = startX, nextY = startY;
+      bool isOnCurve = true;
+      if (i < count)
+      {
+        const Point& point = points[begin + (first - begin + i) % count];
+        nextX = point.x;
+        nextY = point.y;
+        isOnCurve = point.isOnCurve;
+      }
+
+      if (isOnCurve)
+      {
+        if (hasControl)
+        {
+          drawCurve(&area[0], width, height, x, y, controlX, controlY, nextX, nextY);
+        }
+        else
+        {
+          drawLine(&area[0], width, height, x, y, nextX, nextY);
+        }
+        hasControl = false;
+        x = nextX;
+        y = nextY;
+      }
+      else
+      {
+        if (hasControl)
+        {
+          float middleX = 0.5f * (controlX + nextX), middleY = 0.5f * (controlY + nextY);
+          drawCurve(&area[0], width, height, x, y, controlX, controlY, middleX, middleY);
+          x = middleX;
+          y = middleY;
+        }
+        controlX = nextX;
+        controlY = nextY;
+        hasControl = true;
+      }
+    }
+    begin = end;
+  }
+
+  float accumulated = 0.0f;
+  for (int y = 0; y < height; ++y)
+  {
+    const float* pArea = &area[(size_t) y * width];
+    unsigned char* pRow = pCoverage + (size_t) y * stride;
+    for (int x = 0; x < width; ++x)
+    {
+      accumulated += pArea[x];
+      pRow[x] = (unsigned char) (std::min(fabsf(accumulated), 1.0f) * 255.0f + 0.5f);
+    }
+  }
+}
+
+/*
+ * Look up the glyph index of a character, 0 if the font does not contain
+ * it.
+ */
+unsigned int TrueTypeFont::findGlyph(unsigned int codepoint) const
+{
+  unsigned int glyph = 0;
+  if (m_cmapFormat == 4 && codepoint <= 0xFFFF)
+  {
+    unsigned int segmentCount = readU16(m_data, m_cmap + 6) / 2;
+    size_t endCodes = m_cmap + 14;
+    size_t startCodes = endCodes + 2 * segmentCount + 2;
+    size_t deltas = startCodes + 2 * segmentCount;
+    size_t rangeOffsets = deltas + 2 * segmentCount;
+
+    unsigned int low = 0, high = segmentCount;
+    while (low < high)
+    {
+      unsigned int middle = (low + high) / 2;
+      if (readU16(m_data, endCodes + 2 * middle) < codepoint)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        high = middle;
+      }
+    }
+    if (low == segmentCount)
+    {
+      return 0;
+    }
+
+    unsigned int start = readU16(m_data, startCodes + 2 * low);
+    if (start > codepoint)
+    {
+      return 0;
+    }
+    unsigned int delta = readU16(m_data, deltas + 2 * low);
+    size_t rangeOffset = rangeOffsets + 2 * low;
+    unsigned int range = readU16(m_data, rangeOffset);
+    if (range == 0)
+    {
+      glyph = (codepoint + delta) & 0xFFFF;
+    }
+    else
+    {
+      glyph = readU16(m_data, rangeOffset + range + 2 * (codepoint - start));
+      glyph = glyph != 0 ? (glyph + delta) & 0xFFFF : 0;
+    }
+  }
+  else if (m_cmapFormat == 12)
+  {
+    unsigned int groupCount = readU32(m_data, m_cmap + 12);
+    size_t groups = m_cmap + 16;
+    unsigned int low = 0, high = groupCount;
+    while (low < high)
+    {
+      unsigned int middle = low + (high - low) / 2;
+      if (readU32(m_data, groups + 12 * (size_t) middle + 4) < codepoint)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        high = middle;
+      }
+    }
+    if (low == groupCount)
+    {
+      return 0;
+    }
+
+    size_t group = groups + 12 * (size_t) low;
+    unsigned int start = readU32(m_data, group);
+    if (start > codepoint)
+    {
+      return 0;
+    }
+    glyph = readU32(m_data, group + 8) + (codepoint - start);
+  }
+  return glyph < m_glyphCount ? glyph : 0;
+}
+
+/* Find the data of a glyph, which is empty for glyphs without outlines. */
+bool TrueTypeFont::getGlyphRange(unsigned int glyph, size_t& begin, size_t& end) const
+{
+  if (glyph >= m_glyphCount)
+  {
+    return false;
+  }
+  if (m_isLongLoca)
+  {
+    begin = m_glyf + readU32(m_data, m_loca + 4 * (size_t) glyph);
+    end = m_glyf + readU32(m_data, m_loca + 4 * (size_t) glyph + 4);
+  }
+  else
+  {
+    begin = m_glyf + 2 * (size_t) readU16(m_data, m_loca + 2 * (size_t) glyph);
+    end = m_glyf + 2 * (size_t) readU16(m_data, m_loca + 2 * (size_t) glyph + 2);
+  }
+  return begin <= end && end <= m_data.size();
+}
+
+/*
+ * Append the points of a glyph in font units and the end of each contour.
+ * The components of composite glyphs are read recursively and transformed.
+ * Every component takes one from the budget. Fails when the budget runs out
+ * or the points and contours exceed MAX_GLYPH_POINTS.
+ */
+bool TrueTypeFont::readOutline(unsigned int glyph, int depth, size_t& componentBudget,
+                               std::vector<Point>& points, std::vector<size_t>& contourEnds) const
+{
+  size_t begin, end;
+  if (!getGlyphRange(glyph, begin, end) || end - begin < 10)
+  {
+    return true;
+  }
+
+  int contourCount = readS16(m_data, begin);
+  size_t offset = begin + 10;
+  if (contourCount >= 0)
+  {
+    size_t first = points.size();
+    size_t pointCount = 0;
+    if (contourEnds.size() + contourCount > MAX_GLYPH_POINTS)
+    {
+      return false;
+    }
+    for (int c = 0; c < contourCount; ++c)
+    {
+      size_t contourEnd = std::max((size_t) readU16(m_data, offset + 2 * c) + 1, pointCount);
+      contourEnds.push_back(first + contourEnd);
+      pointCount = contourEnd;
+    }
+    if (first + pointCount > MAX_GLYPH_POINTS)
+    {
+      return false;
+    }
+    offset += 2 * contourCount;
+    offset += 2 + readU16(m_data, offset);
+
+    std::vector<unsigned char> flags(pointCount);
+    for (size_t i = 0; i < pointCount;)
+    {
+      unsigned char flag = (unsigned char) readU8(m_data, offset++);
+      size_t repeat = flag & POINT_REPEAT ? readU8(m_data, offset++) : 0;
+      for (size_t r = 0; r <= repeat && i < pointCount; ++r)
+      {
+        flags[i++] = flag;
+      }
+    }
+
+    points.resize(first + pointCount);
+    int value = 0;
+    for (size_t i = 0; i < pointCount; ++i)
+    {
+      if (flags[i] & POINT_SHORT_X)
+      {
+        int delta = readU8(m_data, offset++);
+        value += flags[i] & POINT_SAME_X ? delta : -delta;
+      }
+      else if (!(flags[i] & POINT_SAME_X))
+      {
+        value += readS16(m_data, offset);
+        offset += 2;
+      }
+      points[first + i].x = (float) value;
+      points[first + i].isOnCurve = (flags[i] & POINT_ON_CURVE) != 0;
+    }
+    value = 0;
+    for (size_t i = 0; i < pointCount; ++i)
+    {
+      if (flags[i] & POINT_SHORT_Y)
+      {
+        int delta = readU8(m_data, offset++);
+        value += flags[i] & POINT_SAME_Y ? delta : -delta;
+      }
+      else if (!(flags[i] & POINT_SAME_Y))
+      {
+        value += readS16(m_data, offset);
+        offset += 2;
+      }
+      points[first + i].y = (float) value;
+    }
+    return true;
+  }
+
+  if (depth >= MAX_COMPOSITE_DEPTH)
+  {
+    return true;
+  }
+
+  unsigned int flags;
+  do
+  {
+    flags = readU16(m_data, offset);
+    unsigned int component = readU16(m_data, offset + 2);
+    offset += 4;
+
+    float dx, dy;
+    if (flags & COMPONENT_ARGS_ARE_WORDS)
+    {
+      dx = (float) readS16(m_data, offset);
+      dy = (float) readS16(m_data, offset + 2);
+      offset += 4;
+    }
+    else
+    {
+      dx = (float) (signed char) readU8(m_data, offset);
+      dy = (float) (signed char) readU8(m_data, offset + 1);
+      offset += 2;
+    }
+    // Components placed by matching points are drawn without an offset.
+    if (!(flags & COMPONENT_ARGS_ARE_OFFSETS))
+    {
+      dx = dy = 0.0f;
+    }
+
+    float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f;
+    if (flags & COMPONENT_SCALE)
+    {
+      a = d = readF2Dot14(m_data, offset);
+      offset += 2;
+    }
+    else if (flags & COMPONENT_XY_SCALE)
+    {
+      a = readF2Dot14(m_data, offset);
+      d = readF2Dot14(m_data, offset + 2);
+      offset += 4;
+    }
+    else if (flags & COMPONENT_TWO_BY_TWO)
+    {
+      a = readF2Dot14(m_data, offset);
+      b = readF2Dot14(m_data, offset + 2);
+      c = readF2Dot14(m_data, offset + 4);
+      d = readF2Dot14(m_data, offset + 6);
+      offset += 8;
+    }
+
+    if (componentBudget == 0)
+    {
+      return false;
+    }
+    --componentBudget;
+
+    size_t first = points.size();
+    if (!readOutline(component, depth + 1, componentBudget, points, contourEnds))
+    {
+      return false;
+    }
+    for (size_t i = first; i < points.size(); ++i)
+    {
+      float x = points[i].x, y = points[i].y;
+      points[i].x = a * x + c * y + dx;
+      points[i].y = b * x + d * y + dy;
+    }
+  }
+  while ((flags & COMPONENT_MORE) && offset < end);
+  return true;
+}
+
+}
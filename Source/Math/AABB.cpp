@@ -0,0 +1,173 @@
+/**
+ * @file AABB.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the AABB class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Math\AABB.h"
+
+#include <cfloat>
+
+namespace Lite
+{
+
+/**
+ * Default constructor.
+ * Creates an empty box which grows to fit the first point added to it.
+ */
+AABB::AABB()
+  : min( FLT_MAX,  FLT_MAX,  FLT_MAX)
+  , max(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+{
+}
+
+/**
+ * Parametrized constructor.
+ *
+ * @param[in] min - minimum corner
+ * @param[in] max - maximum corner
+ */
+AABB::AABB(const Vector3f& min, const Vector3f& max)
+  : min(min)
+  , max(max)
+{
+}
+
+/**
+ * Make the box empty.
+ */
+void AABB::reset()
+{
+  min = Vector3f( FLT_MAX,  FLT_MAX,  FLT_MAX);
+  max = Vector3f(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+}
+
+/**
+ * Grow the box so that it contains point.
+ *
+ * @param[in] point - point to include
+ */
+void AABB::grow(const Vector3f& point)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (point.v[i] < min.v[i]) min.v[i] = point.v[i];
+    if (point.v[i] > max.v[i]) max.v[i] = point.v[i];
+  }
+}
+
+/**
+ * Grow the box so that it contains the other box.
+ *
+ * @param[in] other - box to include
+ */
+void AABB::grow(const AABB& other)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (other.min.v[i] < min.v[i]) min.v[i] = other.min.v[i];
+    if (other.max.v[i] > max.v[i]) max.v[i] = other.max.v[i];
+  }
+}
+
+/**
+ * Check if the box contains no points.
+ *
+ * @return true if empty, false otherwise
+ */
+bool AABB::isEmpty() const
+{
+  return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+/**
+ * Check if a point lies inside the box or on its boundary.
+ *
+ * @param[in] point - point to test
+ *
+ * @return true if the point is inside, false otherwise
+ */
+bool AABB::contains(const Vector3f& point) const
+{
+  return point.x >= min.x && point.x <= max.x &&
+         point.y >= min.y && point.y <= max.y &&
+         point.z >= min.z && point.z <= max.z;
+}
+
+/**
+ * Check if this box overlaps the other box.
+ *
+ * @param[in] other - box to test against
+ *
+ * @return true if the boxes overlap, false otherwise
+ */
+bool AABB::intersects(const AABB& other) const
+{
+  return min.x <= other.max.x && max.x >= other.min.x &&
+         min.y <= other.max.y && max.y >= other.min.y &&
+         min.z <= other.max.z && max.z >= other.min.z;
+}
+
+/**
+ * Calculate the center of the box.
+ *
+ * @return box center
+ */
+Vector3f AABB::center() const
+{
+  return Vector3f((min.x + max.x) * 0.5f,
+                  (min.y + max.y) * 0.5f,
+                  (min.z + max.z) * 0.5f);
+}
+
+/**
+ * Calculate the size of the box along every axis.
+ *
+ * @return box size
+ */
+Vector3f AABB::extent() const
+{
+  return Vector3f(max.x - min.x, max.y - min.y, max.z - min.z);
+}
+
+/**
+ * Calculate the surface area of the box.
+ *
+ * @return surface area, 0 for an empty box
+ */
+float AABB::surfaceArea() const
+{
+  if (isEmpty())
+  {
+    return 0.0f;
+  }
+
+  float dx = max.x - min.x;
+  float dy = max.y - min.y;
+  float dz = max.z - min.z;
+  return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+/**
+ * Find the axis along which the box is longest.
+ *
+ * @return 0 for x, 1 for y and 2 for z
+ */
+int AABB::longestAxis() const
+{
+  Vector3f e = extent();
+  if (e.x >= e.y && e.x >= e.z)
+  {
+    return 0;
+  }
+  return e.y >= e.z ? 1 : 2;
+}
+
+}
@@ -0,0 +1,266 @@
+/**
+ * @file Matrix3x2.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the Matrix3x2 class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Math\Matrix3x2.h"
+
+#include <cmath>
+
+#if defined(LITE_AVX2)
+#include <immintrin.h>
+#elif defined(LITE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+const Matrix3x2 Matrix3x2::Identity;
+
+/**
+ * Default constructor.
+ * Initializes the matrix to the identity transform.
+ */
+Matrix3x2::Matrix3x2()
+  : m11(1.0f), m12(0.0f)
+  , m21(0.0f), m22(1.0f)
+  , dx(0.0f), dy(0.0f)
+{
+}
+
+/**
+ * Parametrized constructor.
+ *
+ * @param[in] m11 - x axis, x component
+ * @param[in] m12 - x axis, y component
+ * @param[in] m21 - y axis, x component
+ * @param[in] m22 - y axis, y component
+ * @param[in] dx  - translation along x
+ * @param[in] dy  - translation along y
+ */
+Matrix3x2::Matrix3x2(float m11, float m12, float m21, float m22, float dx, float dy)
+  : m11(m11), m12(m12)
+  , m21(m21), m22(m22)
+  , dx(dx), dy(dy)
+{
+}
+
+/**
+ * Calculate the determinant of the linear part.
+ *
+ * @return determinant
+ */
+float Matrix3x2::determinant() const
+{
+  return m11 * m22 - m12 * m21;
+}
+
+/**
+ * Invert this matrix in place.
+ *
+ * @return false if the matrix is singular, in which case it is unchanged
+ */
+bool Matrix3x2::invert()
+{
+  float det = determinant();
+  if (det == 0.0f)
+  {
+    return false;
+  }
+
+  float inv = 1.0f / det;
+  Matrix3x2 result(m22 * inv, -m12 * inv, -m21 * inv, m11 * inv, 0.0f, 0.0f);
+  result.dx = -(dx * result.m11 + dy * result.m21);
+  result.dy = -(dx * result.m12 + dy * result.m22);
+  *this = result;
+  return true;
+}
+
+/**
+ * Calculate the inverse transform.
+ *
+ * @return inverse, or this matrix if it is singular
+ */
+Matrix3x2 Matrix3x2::inverse() const
+{
+  Matrix3x2 result(*this);
+  result.invert();
+  return result;
+}
+
+/**
+ * Transform a point.
+ *
+ * @param[in] point - the point
+ *
+ * @return transformed point
+ */
+Vector2f Matrix3x2::transformPoint(const Vector2f& point) const
+{
+  return Vector2f(point.x * m11 + point.y * m21 + dx, point.x * m12 + point.y * m22 + dy);
+}
+
+/**
+ * Transform a direction, ignoring the translation.
+ *
+ * @param[in] vector - the direction
+ *
+ * @return transformed direction
+ */
+Vector2f Matrix3x2::transformVector(const Vector2f& vector) const
+{
+  return Vector2f(vector.x * m11 + vector.y * m21, vector.x * m12 + vector.y * m22);
+}
+
+/**
+ * Transform an array of points.
+ *
+ * Four points are transformed at a time with AVX2, two with SSE2. The
+ * arrays may be the same.
+ *
+ * @param[in]  pPoints - points to transform
+ * @param[out] pResult - receives the transformed points
+ * @param[in]  count   - number of points
+ */
+void Matrix3x2::transformPoints(const Vector2f* pPoints, Vector2f* pResult, size_t count) const
+{
+  const float* pIn = reinterpret_cast<const float*>(pPoints);
+  float* pOut = reinterpret_cast<float*>(pResult);
+  size_t i = 0;
+#if defined(LITE_AVX2)
+  __m256 xAxis = _mm256_setr_ps(m11, m12, m11, m12, m11, m12, m11, m12);
+  __m256 yAxis = _mm256_setr_ps(m21, m22, m21, m22, m21, m22, m21, m22);
+  __m256 offset = _mm256_setr_ps(dx, dy, dx, dy, dx, dy, dx, dy);
+  for (; i + 4 <= count; i += 4)
+  {
+    __m256 points = _mm256_loadu_ps(pIn + i * 2);
+    __m256 result = _mm256_add_ps(_mm256_mul_ps(_mm256_moveldup_ps(points), xAxis),
+                                  _mm256_add_ps(_mm256_mul_ps(_mm256_movehdup_ps(points), yAxis),
+                                                offset));
+    _mm256_storeu_ps(pOut + i * 2, result);
+  }
+#elif defined(LITE_SSE2)
+  __m128 xAxis = _mm_setr_ps(m11, m12, m11, m12);
+  __m128 yAxis = _mm_setr_ps(m21, m22, m21, m22);
+  __m128 offset = _mm_setr_ps(dx, dy, dx, dy);
+  for (; i + 2 <= count; i += 2)
+  {
+    __m128 points = _mm_loadu_ps(pIn + i * 2);
+    __m128 x = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+    __m128 y = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+    _mm_storeu_ps(pOut + i * 2, _mm_add_ps(_mm_mul_ps(x, xAxis),
+                                           _mm_add_ps(_mm_mul_ps(y, yAxis), offset)));
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    float x = pIn[i * 2], y = pIn[i * 2 + 1];
+    pOut[i * 2]     = x * m11 + y * m21 + dx;
+    pOut[i * 2 + 1] = x * m12 + y * m22 + dy;
+  }
+}
+
+/**
+ * Create a translation.
+ *
+ * @param[in] x - offset along x
+ * @param[in] y - offset along y
+ *
+ * @return the transform
+ */
+Matrix3x2 Matrix3x2::translation(float x, float y)
+{
+  return Matrix3x2(1.0f, 0.0f, 0.0f, 1.0f, x, y);
+}
+
+/**
+ * Create a rotation around the origin.
+ *
+ * @param[in] angle - angle in radians, from the x axis towards the y axis
+ *
+ * @return the transform
+ */
+Matrix3x2 Matrix3x2::rotation(float angle)
+{
+  float c = cosf(angle), s = sinf(angle);
+  return Matrix3x2(c, s, -s, c, 0.0f, 0.0f);
+}
+
+/**
+ * Create a scale.
+ *
+ * @param[in] x - scale along x
+ * @param[in] y - scale along y
+ *
+ * @return the transform
+ */
+Matrix3x2 Matrix3x2::scale(float x, float y)
+{
+  return Matrix3x2(x, 0.0f, 0.0f, y, 0.0f, 0.0f);
+}
+
+/**
+ * Create the transform of an object: scale and rotate around an origin,
+ * then move the origin to a position.
+ *
+ * @param[in] position - where the origin ends up
+ * @param[in] angle    - rotation in radians
+ * @param[in] scale    - scale along the object's axes
+ * @param[in] origin   - pivot in object coordinates
+ *
+ * @return the transform
+ */
+Matrix3x2 Matrix3x2::transform(const Vector2f& position, float angle, const Vector2f& scale,
+                               const Vector2f& origin)
+{
+  float c = cosf(angle), s = sinf(angle);
+  Matrix3x2 result(c * scale.x, s * scale.x, -s * scale.y, c * scale.y, 0.0f, 0.0f);
+  result.dx = position.x - (origin.x * result.m11 + origin.y * result.m21);
+  result.dy = position.y - (origin.x * result.m12 + origin.y * result.m22);
+  return result;
+}
+
+bool Matrix3x2::operator !=(const Matrix3x2& right) const
+{
+  return !(*this == right);
+}
+
+bool Matrix3x2::operator ==(const Matrix3x2& right) const
+{
+  return m11 == right.m11 && m12 == right.m12 && m21 == right.m21 &&
+         m22 == right.m22 && dx == right.dx && dy == right.dy;
+}
+
+Matrix3x2& Matrix3x2::operator *=(const Matrix3x2& right)
+{
+  *this = *this * right;
+  return *this;
+}
+
+/**
+ * Combine two transforms.
+ *
+ * @param[in] left  - applied first
+ * @param[in] right - applied second
+ *
+ * @return the combined transform
+ */
+Matrix3x2 operator *(const Matrix3x2& left, const Matrix3x2& right)
+{
+  return Matrix3x2(left.m11 * right.m11 + left.m12 * right.m21,
+                   left.m11 * right.m12 + left.m12 * right.m22,
+                   left.m21 * right.m11 + left.m22 * right.m21,
+                   left.m21 * right.m12 + left.m22 * right.m22,
+                   left.dx * right.m11 + left.dy * right.m21 + right.dx,
+                   left.dx * right.m12 + left.dy * right.m22 + right.dy);
+}
+
+}
@@ -0,0 +1,987 @@
+/**
+ * @file Noise.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the Noise class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Math\Noise.h"
+#include "..\..\Include\LiteCube\Core\Profiler.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(LITE_AVX2)
+#include <immintrin.h>
+#elif defined(LITE_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Lite
+{
+
+static const size_t GRAIN_SIZE = 4096;
+
+static const unsigned int PRIME_X = 501125321u;
+static const unsigned int PRIME_Y = 1136930381u;
+static const unsigned int PRIME_Z = 1720413743u;
+static const unsigned int HASH_MULTIPLIER = 0x27D4EB2Du;
+
+// Skew factors of the simplex grids, (sqrt(3) - 1) / 2 and (3 - sqrt(3)) / 6.
+static const float F2 = 0.366025403784f;
+static const float G2 = 0.211324865405f;
+static const float F3 = 1.0f / 3.0f;
+static const float G3 = 1.0f / 6.0f;
+
+// Bring the peaks of the gradient noises close to [-1, 1].
+static const float PERLIN2_SCALE = 0.65f;
+static const float PERLIN3_SCALE = 0.95f;
+static const float SIMPLEX2_SCALE = 45.0f;
+static const float SIMPLEX3_SCALE = 32.0f;
+
+/* Settings of a Noise, shared by all lane widths. */
+struct Parameters
+{
+  Noise::Type    type;
+  Noise::Fractal fractal;
+  int            dimensions;
+  unsigned int   seed;
+  int            octaves;
+  float          frequency;
+  float          lacunarity;
+  float          gain;
+  float          scale;
+};
+
+/*
+ * The noise functions below are written once for any lane type: one float
+ * for the scalar path, or 4 or 8 with SSE2 and AVX2. Every lane type
+ * implements the helpers with the same IEEE operations, which is what keeps
+ * the results identical across instruction sets.
+ */
+struct ScalarLanes
+{
+  enum { WIDTH = 1 };
+  typedef float        Float;
+  typedef unsigned int Int;
+  typedef bool         Mask;
+
+  static Float load(const float* pValues) { return *pValues; }
+  static void store(float* pOut, Float value) { *pOut = value; }
+};
+
+static inline float lanesFloor(float value)
+{
+  float truncated = (float) (int) value;
+  return truncated > value ? truncated - 1.0f : truncated;
+}
+
+static inline unsigned int lanesToInt(float value) { return (unsigned int) (int) value; }
+static inline float lanesToFloat(unsigned int value) { return (float) (int) value; }
+static inline bool lanesLess(float left, float right) { return left < right; }
+static inline bool lanesGreaterEqual(float left, float right) { return left >= right; }
+static inline bool lanesBit(unsigned int value, unsigned int bit) { return (value & bit) != 0; }
+static inline bool lanesAnd(bool left, bool right) { return left && right; }
+static inline bool lanesOr(bool left, bool right) { return left || right; }
+static inline bool lanesAndNot(bool left, bool right) { return !left && right; }
+static inline bool lanesNot(bool value) { return !value; }
+static inline float lanesSelect(bool mask, float left, float right) { return mask ? left : right; }
+static inline float lanesNegateIf(bool mask, float value) { return mask ? -value : value; }
+static inline float lanesMax(float left, float right) { return left > right ? left : right; }
+static inline float lanesAbs(float value) { return fabsf(value); }
+static inline unsigned int lanesMaskToInt(bool mask) { return mask ? 1u : 0u; }
+static inline float lanesMaskToFloat(bool mask) { return mask ? 1.0f : 0.0f; }
+
+#if defined(LITE_AVX2)
+struct Float8
+{
+  __m256 v;
+  Float8() {}
+  Float8(__m256 value) : v(value) {}
+  Float8(float value) : v(_mm256_set1_ps(value)) {}
+};
+
+struct Int8
+{
+  __m256i v;
+  Int8() {}
+  Int8(__m256i value) : v(value) {}
+  Int8(unsigned int value) : v(_mm256_set1_epi32((int) value)) {}
+};
+
+struct Mask8
+{
+  __m256 v;
+  Mask8(__m256 value) : v(value) {}
+};
+
+struct SimdLanes
+{
+  enum { WIDTH = 8 };
+  typedef Float8 Float;
+  typedef Int8   Int;
+  typedef Mask8  Mask;
+
+  static Float load(const float* pValues) { return _mm256_loadu_ps(pValues); }
+  static void store(float* pOut, Float value) { _mm256_storeu_ps(pOut, value.v); }
+};
+
+static inline Float8 operator +(Float8 left, Float8 right) { return _mm256_add_ps(left.v, right.v); }
+static inline Float8 operator -(Float8 left, Float8 right) { return _mm256_sub_ps(left.v, right.v); }
+static inline Float8 operator *(Float8 left, Float8 right) { return _mm256_mul_ps(left.v, right.v); }
+static inline Int8 operator +(Int8 left, Int8 right) { return _mm256_add_epi32(left.v, right.v); }
+static inline Int8 operator -(Int8 left, Int8 right) { return _mm256_sub_epi32(left.v, right.v); }
+static inline Int8 operator *(Int8 left, Int8 right) { return _mm256_mullo_epi32(left.v, right.v); }
+static inline Int8 operator ^(Int8 left, Int8 right) { return _mm256_xor_si256(left.v, right.v); }
+static inline Int8 operator >>(Int8 value, int count) { return _mm256_srli_epi32(value.v, count); }
+
+static inline Float8 lanesFloor(Float8 value)
+{
+  __m256 truncated = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(value.v));
+  __m256 isAbove = _mm256_cmp_ps(truncated, value.v, _CMP_GT_OQ);
+  return _mm256_sub_ps(truncated, _mm256_and_ps(isAbove, _mm256_set1_ps(1.0f)));
+}
+
+static inline Int8 lanesToInt(Float8 value) { return _mm256_cvttps_epi32(value.v); }
+static inline Float8 lanesToFloat(Int8 value) { return _mm256_cvtepi32_ps(value.v); }
+static inline Mask8 lanesLess(Float8 left, Float8 right)
+{
+  return _mm256_cmp_ps(left.v, right.v, _CMP_LT_OQ);
+}
+static inline Mask8 lanesGreaterEqual(Float8 left, Float8 right)
+{
+  return _mm256_cmp_ps(left.v, right.v, _CMP_GE_OQ);
+}
+static inline Mask8 lanesBit(Int8 value, unsigned int bit)
+{
+  __m256i mask = _mm256_set1_epi32((int) bit);
+  return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(value.v, mask), mask));
+}
+static inline Mask8 lanesAnd(Mask8 left, Mask8 right) { return _mm256_and_ps(left.v, right.v); }
+static inline Mask8 lanesOr(Mask8 left, Mask8 right) { return _mm256_or_ps(left.v, right.v); }
+static inline Mask8 lanesAndNot(Mask8 left, Mask8 right) { return _mm256_andnot_ps(left.v, right.v); }
+static inline Mask8 lanesNot(Mask8 value)
+{
+  return _mm256_xor_ps(value.v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+}
+static inline Float8 lanesSelect(Mask8 mask, Float8 left, Float8 right)
+{
+  return _mm256_blendv_ps(right.v, left.v, mask.v);
+}
+static inline Float8 lanesNegateIf(Mask8 mask, Float8 value)
+{
+  return _mm256_xor_ps(value.v, _mm256_and_ps(mask.v, _mm256_set1_ps(-0.0f)));
+}
+static inline Float8 lanesMax(Float8 left, Float8 right) { return _mm256_max_ps(left.v, right.v); }
+static inline Float8 lanesAbs(Float8 value)
+{
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value.v);
+}
+static inline Int8 lanesMaskToInt(Mask8 mask)
+{
+  return _mm256_and_si256(_mm256_castps_si256(mask.v), _mm256_set1_epi32(1));
+}
+static inline Float8 lanesMaskToFloat(Mask8 mask)
+{
+  return _mm256_and_ps(mask.v, _mm256_set1_ps(1.0f));
+}
+#elif defined(LITE_SSE2)
+struct Float4
+{
+  __m128 v;
+  Float4() {}
+  Float4(__m128 value) : v(value) {}
+  Float4(float value) : v(_mm_set1_ps(value)) {}
+};
+
+struct Int4
+{
+  __m128i v;
+  Int4() {}
+  Int4(__m128i value) : v(value) {}
+  Int4(unsigned int value) : v(_mm_set1_epi32((int) value)) {}
+};
+
+struct Mask4
+{
+  __m128 v;
+  Mask4(__m128 value) : v(value) {}
+};
+
+struct SimdLanes
+{
+  enum { WIDTH = 4 };
+  typedef Float4 Float;
+  typedef Int4   Int;
+  typedef Mask4  Mask;
+
+  static Float load(const float* pValues) { return _mm_loadu_ps(pValues); }
+  static void store(float* pOut, Float value) { _mm_storeu_ps(pOut, value.v); }
+};
+
+static inline Float4 operator +(Float4 left, Float4 right) { return _mm_add_ps(left.v, right.v); }
+static inline Float4 operator -(Float4 left, Float4 right) { return _mm_sub_ps(left.v, right.v); }
+static inline Float4 operator *(Float4 left, Float4 right) { return _mm_mul_ps(left.v, right.v); }
+static inline Int4 operator +(Int4 left, Int4 right) { return _mm_add_epi32(left.v, right.v); }
+static inline Int4 operator -(Int4 left, Int4 right) { return _mm_sub_epi32(left.v, right.v); }
+static inline Int4 operator ^(Int4 left, Int4 right) { return _mm_xor_si128(left.v, right.v); }
+static inline Int4 operator >>(Int4 value, int count) { return _mm_srli_epi32(value.v, count); }
+
+// SSE2 has no 32 bit low multiply, so the even and odd lanes are multiplied
+// to 64 bits and the low halves interleaved.
+static inline Int4 operator *(Int4 left, Int4 right)
+{
+  __m128i even = _mm_mul_epu32(left.v, right.v);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(left.v, 32), _mm_srli_epi64(right.v, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline Float4 lanesFloor(Float4 value)
+{
+  __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value.v));
+  __m128 isAbove = _mm_cmpgt_ps(truncated, value.v);
+  return _mm_sub_ps(truncated, _mm_and_ps(isAbove, _mm_set1_ps(1.0f)));
+}
+
+static inline Int4 lanesToInt(Float4 value) { return _mm_cvttps_epi32(value.v); }
+static inline Float4 lanesToFloat(Int4 value) { return _mm_cvtepi32_ps(value.v); }
+static inline Mask4 lanesLess(Float4 left, Float4 right) { return _mm_cmplt_ps(left.v, right.v); }
+static inline Mask4 lanesGreaterEqual(Float4 left, Float4 right)
+{
+  return _mm_cmpge_ps(left.v, right.v);
+}
+static inline Mask4 lanesBit(Int4 value, unsigned int bit)
+{
+  __m128i mask = _mm_set1_epi32((int) bit);
+  return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(value.v, mask), mask));
+}
+static inline Mask4 lanesAnd(Mask4 left, Mask4 right) { return _mm_and_ps(left.v, right.v); }
+static inline Mask4 lanesOr(Mask4 left, Mask4 right) { return _mm_or_ps(left.v, right.v); }
+static inline Mask4 lanesAndNot(Mask4 left, Mask4 right) { return _mm_andnot_ps(left.v, right.v); }
+static inline Mask4 lanesNot(Mask4 value)
+{
+  return _mm_xor_ps(value.v, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+}
+static inline Float4 lanesSelect(Mask4 mask, Float4 left, Float4 right)
+{
+  return _mm_or_ps(_mm_and_ps(mask.v, left.v), _mm_andnot_ps(mask.v, right.v));
+}
+static inline Float4 lanesNegateIf(Mask4 mask, Float4 value)
+{
+  return _mm_xor_ps(value.v, _mm_and_ps(mask.v, _mm_set1_ps(-0.0f)));
+}
+static inline Float4 lanesMax(Float4 left, Float4 right) { return _mm_max_ps(left.v, right.v); }
+static inline Float4 lanesAbs(Float4 value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value.v); }
+static inline Int4 lanesMaskToInt(Mask4 mask)
+{
+  return _mm_and_si128(_mm_castps_si128(mask.v), _mm_set1_epi32(1));
+}
+static inline Float4 lanesMaskToFloat(Mask4 mask)
+{
+  return _mm_and_ps(mask.v, _mm_set1_ps(1.0f));
+}
+#else
+typedef ScalarLanes SimdLanes;
+#endif
+
+/* Hash of a lattice point, its coordinates already multiplied by the primes. */
+template <class L>
+static inline typename L::Int hash(typename L::Int seed, typename L::Int x,
+                                   typename L::Int y, typename L::Int z)
+{
+  typename L::Int h = (seed ^ x ^ y ^ z) * typename L::Int(HASH_MULTIPLIER);
+  return h ^ (h >> 15);
+}
+
+/* Quintic fade curve, 6t^5 - 15t^4 + 10t^3. */
+template <class F>
+static inline F fade(F t)
+{
+  return t * t * t * (t * (t * F(6.0f) - F(15.0f)) + F(10.0f));
+}
+
+template <class F>
+static inline F lerp(F from, F to, F t)
+{
+  return from + t * (to - from);
+}
+
+/* Lattice value in [-1, 1) from a hash. */
+template <class L>
+static inline typename L::Float latticeValue(typename L::Int h)
+{
+  typedef typename L::Float Float;
+  return lanesToFloat(h >> 8) * Float(1.0f / 8388608.0f) - Float(1.0f);
+}
+
+/* Dot product with one of 8 gradients, (+-1, +-2) and (+-2, +-1). */
+template <class L>
+static inline typename L::Float gradient(typename L::Int h, typename L::Float x,
+                                         typename L::Float y)
+{
+  typename L::Mask swap = lanesBit(h, 4);
+  typename L::Float u = lanesSelect(swap, y, x);
+  typename L::Float v = lanesSelect(swap, x, y);
+  return lanesNegateIf(lanesBit(h, 1), u) + lanesNegateIf(lanesBit(h, 2), v + v);
+}
+
+/* Dot product with one of the 12 edge gradients of a cube, as in improved Perlin noise. */
+template <class L>
+static inline typename L::Float gradient(typename L::Int h, typename L::Float x,
+                                         typename L::Float y, typename L::Float z)
+{
+  typename L::Mask bit1 = lanesBit(h, 1), bit4 = lanesBit(h, 4), bit8 = lanesBit(h, 8);
+  typename L::Float u = lanesSelect(bit8, y, x);
+  typename L::Float v = lanesSelect(lanesOr(bit4, bit8),
+                                    lanesSelect(lanesAndNot(bit1, lanesAnd(bit4, bit8)), x, z),
+                                    y);
+  return lanesNegateIf(bit1, u) + lanesNegateIf(lanesBit(h, 2), v);
+}
+
+template <class L>
+static typename L::Float valueNoise(typename L::Float x, typename L::Float y,
+                                    typename L::Int seed)
+{
+  typedef typename L::Float Float;
+  typedef typename L::Int Int;
+  Float fx = lanesFloor(x), fy = lanesFloor(y);
+  Float u = fade(x - fx), v = fade(y - fy);
+  Int x0 = lanesToInt(fx) * Int(PRIME_X), y0 = lanesToInt(fy) * Int(PRIME_Y);
+  Int x1 = x0 + Int(PRIME_X), y1 = y0 + Int(PRIME_Y), z = Int(0u);
+
+  Float a = lerp(latticeValue<L>(hash<L>(seed, x0, y0, z)),
+                 latticeValue<L>(hash<L>(seed, x1, y0, z)), u);
+  Float b = lerp(latticeValue<L>(hash<L>(seed, x0, y1, z)),
+                 latticeValue<L>(hash<L>(seed, x1, y1, z)), u);
+  return lerp(a, b, v);
+}
+
+template <class L>
+static typename L::Float valueNoise(typename L::Float x, typename L::Float y,
+                                    typename L::Float z, typename L::Int seed)
+{
+  typedef typename L::Float Float;
+  typedef typename L::Int Int;
+  Float fx = lanesFloor(x), fy = lanesFloor(y), fz = lanesFloor(z);
+  Float u = fade(x - fx), v = fade(y - fy), w = fade(z - fz);
+  Int x0 = lanesToInt(fx) * Int(PRIME_X), y0 = lanesToInt(fy) * Int(PRIME_Y);
+  Int z0 = lanesToInt(fz) * Int(PRIME_Z);
+  Int x1 = x0 + Int(PRIME_X), y1 = y0 + Int(PRIME_Y), z1 = z0 + Int(PRIME_Z);
+
+  Float a = lerp(lerp(latticeValue<L>(hash<L>(seed, x0, y0, z0)),
+                      latticeValue<L>(hash<L>(seed, x1, y0, z0)), u),
+                 lerp(latticeValue<L>(hash<L>(seed, x0, y1, z0)),
+                      latticeValue<L>(hash<L>(seed, x1, y1, z0)), u), v);
+  Float b = lerp(lerp(latticeValue<L>(hash<L>(seed, x0, y0, z1)),
+                      latticeValue<L>(hash<L>(seed, x1, y0, z1)), u),
+                 lerp(latticeValue<L>(hash<L>(seed, x0, y1, z1)),
+                      latticeValue<L>(hash<L>(seed, x1, y1, z1)), u), v);
+  return lerp(a, b, w);
+}
+
+template <class L>
+static typename L::Float perlinNoise(typename L::Float x, typename L::Float y,
+                                     typename L::Int seed)
+{
+  typedef typename L::Float Float;
+  typedef typename L::Int Int;
+  Float fx = lanesFloor(x), fy = lanesFloor(y);
+  Float tx = x - fx, ty = y - fy;
+  Float tx1 = tx - Float(1.0f), ty1 = ty - Float(1.0f);
+  Int x0 = lanesToInt(fx) * Int(PRIME_X), y0 = lanesToInt(fy) * Int(PRIME_Y);
+  Int x1 = x0 + Int(PRIME_X), y1 = y0 + Int(PRIME_Y), z = Int(0u);
+
+  Float u = fade(tx), v = fade(ty);
+  Float a = lerp(gradient<L>(hash<L>(seed, x0, y0, z), tx, ty),
+                 gradient<L>(hash<L>(seed, x1, y0, z), tx1, ty), u);
+  Float b = lerp(gradient<L>(hash<L>(seed, x0, y1, z), tx, ty1),
+                 gradient<L>(hash<L>(seed, x1, y1, z), tx1, ty1), u);
+  return lerp(a, b, v) * Float(PERLIN2_SCALE);
+}
+
+template <class L>
+static typename L::Float perlinNoise(typename L::Float x, typename L::Float y,
+                                     typename L::Float z, typename L::Int seed)
+{
+  typedef typename L::Float Float;
+  typedef typename L::Int Int;
+  Float fx = lanesFloor(x), fy = lanesFloor(y), fz = lanesFloor(z);
+  Float tx = x - fx, ty = y - fy, tz = z - fz;
+  Float tx1 = tx - Float(1.0f), ty1 = ty - Float(1.0f), tz1 = tz - Float(1.0f);
+  Int x0 = lanesToInt(fx) * Int(PRIME_X), y0 = lanesToInt(fy) * Int(PRIME_Y);
+  Int z0 = lanesToInt(fz) * Int(PRIME_Z);
+  Int x1 = x0 + Int(PRIME_X), y1 = y0 + Int(PRIME_Y), z1 = z0 + Int(PRIME_Z);
+
+  Float u = fade(tx), v = fade(ty), w = fade(tz);
+  Float a = lerp(lerp(gradient<L>(hash<L>(seed, x0, y0, z0), tx, ty, tz),
+                      gradient<L>(hash<L>(seed, x1, y0, z0), tx1, ty, tz), u),
+                 lerp(gradient<L>(hash<L>(seed, x0, y1, z0), tx, ty1, tz),
+                      gradient<L>(hash<L>(seed, x1, y1, z0), tx1, ty1, tz), u), v);
+  Float b = lerp(lerp(gradient<L>(hash<L>(seed, x0, y0, z1), tx, ty, tz1),
+                      gradient<L>(hash<L>(seed, x1, y0, z1), tx1, ty, tz1), u),
+                 lerp(gradient<L>(hash<L>(seed, x0, y1, z1), tx, ty1, tz1),
+                      gradient<L>(hash<L>(seed, x1, y1, z1), tx1, ty1, tz1), u), v);
+  return lerp(a, b, w) * Float(PERLIN3_SCALE);
+}
+
+/* Contribution of a simplex corner, max(r - |d|^2, 0)^4 * gradient. */
+template <class L>
+static inline typename L::Float corner(typename L::Int h, typename L::Float x,
+                                       typename L::Float y, float radius)
+{
+  typedef typename L::Float Float;
+  Float t = lanesMax(Float(radius) - x * x - y * y, Float(0.0f));
+  t = t * t;
+  return t * t * gradient<L>(h, x, y);
+}
+
+template <class L>
+static inline typename L::Float corner(typename L::Int h, typename L::Float x,
+                                       typename L::Float y, typename L::Float z, float radius)
+{
+  typedef typename L::Float Float;
+  Float t = lanesMax(Float(radius) - x * x - y * y - z * z, Float(0.0f));
+  t = t * t;
+  return t * t * gradient<L>(h, x, y, z);
+}
+
+template <class L>
+static typename L::Float simplexNoise(typename L::Float x, typename L::Float y,
+                                      typename L::Int seed)
+{
+  typedef typename L::Float Float;
+  typedef typename L::Int Int;
+  Float skew = (x + y) * Float(F2);
+  Float fi = lanesFloor(x + skew), fj = lanesFloor(y + skew);
+  Float unskew = (fi + fj) * Float(G2);
+  Float x0 = x - (fi - unskew), y0 = y - (fj - unskew);
+
+  // The middle corner steps along x in the lower triangle, along y otherwise.
+  typename L::Mask isLower = lanesLess(y0, x0);
+  Float i1 = lanesMaskToFloat(isLower);
+  Float x1 = x0 - i1 + Float(G2), y1 = y0 - (Float(1.0f) - i1) + Float(G2);
+  Float x2 = x0 + Float(2.0f * G2 - 1.0f), y2 = y0 + Float(2.0f * G2 - 1.0f);
+
+  Int i = lanesToInt(fi) * Int(PRIME_X), j = lanesToInt(fj) * Int(PRIME_Y), z = Int(0u);
+  Int step = lanesMaskToInt(isLower);
+  Int h0 = hash<L>(seed, i, j, z);
+  Int h1 = hash<L>(seed, i + step * Int(PRIME_X), j + (Int(1u) - step) * Int(PRIME_Y), z);
+  Int h2 = hash<L>(seed, i + Int(PRIME_X), j + Int(PRIME_Y), z);
+
+  Float sum = corner<L>(h0, x0, y0, 0.5f) + corner<L>(h1, x1, y1, 0.5f) +
+              corner<L>(h2, x2, y2, 0.5f);
+  return sum * Float(SIMPLEX2_SCALE);
+}
+
+template <class L>
+static typename L::Float simplexNoise(typename L::Float x, typename L::Float y,
+                                      typename L::Float z, typename L::Int seed)
+{
+  typedef typename L::Float Float;
+  typedef typename L::Int Int;
+  typedef typename L::Mask Mask;
+  Float skew = (x + y + z) * Float(F3);
+  Float fi = lanesFloor(x + skew), fj = lanesFloor(y + skew), fk = lanesFloor(z + skew);
+  Float unskew = (fi + fj + fk) * Float(G3);
+  Float x0 = x - (fi - unskew), y0 = y - (fj - unskew), z0 = z - (fk - unskew);
+
+  // Order of the coordinates picks the two middle corners of the tetrahedron.
+  Mask xy = lanesGreaterEqual(x0, y0), yz = lanesGreaterEqual(y0, z0);
+  Mask xz = lanesGreaterEqual(x0, z0);
+  Mask i1 = lanesAnd(xy, xz), j1 = lanesAndNot(xy, yz), k1 = lanesNot(lanesOr(xz, yz));
+  Mask i2 = lanesOr(xy, xz), j2 = lanesOr(lanesNot(xy), yz), k2 = lanesNot(lanesAnd(xz, yz));
+
+  Float x1 = x0 - lanesMaskToFloat(i1) + Float(G3);
+  Float y1 = y0 - lanesMaskToFloat(j1) + Float(G3);
+  Float z1 = z0 - lanesMaskToFloat(k1) + Float(G3);
+  Float x2 = x0 - lanesMaskToFloat(i2) + Float(2.0f * G3);
+  Float y2 = y0 - lanesMaskToFloat(j2) + Float(2.0f * G3);
+  Float z2 = z0 - lanesMaskToFloat(k2) + Float(2.0f * G3);
+  Float x3 = x0 + Float(3.0f * G3 - 1.0f);
+  Float y3 = y0 + Float(3.0f * G3 - 1.0f);
+  Float z3 = z0 + Float(3.0f * G3 - 1.0f);
+
+  Int i = lanesToInt(fi) * Int(PRIME_X), j = lanesToInt(fj) * Int(PRIME_Y);
+  Int k = lanesToInt(fk) * Int(PRIME_Z);
+  Int h0 = hash<L>(seed, i, j, k);
+  Int h1 = hash<L>(seed, i + lanesMaskToInt(i1) * Int(PRIME_X),
+                   j + lanesMaskToInt(j1) * Int(PRIME_Y), k + lanesMaskToInt(k1) * Int(PRIME_Z));
+  Int h2 = hash<L>(seed, i + lanesMaskToInt(i2) * Int(PRIME_X),
+                   j + lanesMaskToInt(j2) * Int(PRIME_Y), k + lanesMaskToInt(k2) * Int(PRIME_Z));
+  Int h3 = hash<L>(seed, i + Int(PRIME_X), j + Int(PRIME_Y), k + Int(PRIME_Z));
+
+  Float sum = corner<L>(h0, x0, y0, z0, 0.6f) + corner<L>(h1, x1, y1, z1, 0.6f) +
+              corner<L>(h2, x2, y2, z2, 0.6f) + corner<L>(h3, x3, y3, z3, 0.6f);
+  return sum * Float(SIMPLEX3_SCALE);
+}
+
+/* Noise and fractal sum at lane positions, z is ignored in 2D. */
+template <class L>
+static typename L::Float evaluate(const Parameters& parameters, typename L::Float x,
+                                  typename L::Float y, typename L::Float z)
+{
+  typedef typename L::Float Float;
+  typedef typename L::Int Int;
+  Float sum(0.0f);
+  float frequency = parameters.frequency, amplitude = 1.0f;
+  for (int octave = 0; octave < parameters.octaves; ++octave)
+  {
+    Float px = x * Float(frequency), py = y * Float(frequency), pz = z * Float(frequency);
+    Int seed(parameters.seed + (unsigned int) octave);
+
+    Float value;
+    if (parameters.type == Noise::TYPE_VALUE)
+    {
+      value = parameters.dimensions == 2 ? valueNoise<L>(px, py, seed)
+                                         : valueNoise<L>(px, py, pz, seed);
+    }
+    else if (parameters.type == Noise::TYPE_PERLIN)
+    {
+      value = parameters.dimensions == 2 ? perlinNoise<L>(px, py, seed)
+                                         : perlinNoise<L>(px, py, pz, seed);
+    }
+    else
+    {
+      value = parameters.dimensions == 2 ? simplexNoise<L>(px, py, seed)
+                                         : simplexNoise<L>(px, py, pz, seed);
+    }
+
+    if (parameters.fractal == Noise::FRACTAL_RIDGED)
+    {
+      value = Float(1.0f) - lanesAbs(value);
+      value = value * value;
+    }
+    sum = sum + value * Float(amplitude);
+    amplitude *= parameters.gain;
+    frequency *= parameters.lacunarity;
+  }
+
+  // Ridged octaves are in [0, 1] and shifted to [-1, 1].
+  if (parameters.fractal == Noise::FRACTAL_RIDGED)
+  {
+    return sum * Float(parameters.scale) - Float(1.0f);
+  }
+  return sum * Float(parameters.scale);
+}
+
+template <class L>
+static inline void evaluateBlock(const Parameters& parameters, const float* pX,
+                                 const float* pY, const float* pZ, float* pOut)
+{
+  L::store(pOut, evaluate<L>(parameters, L::load(pX), L::load(pY), L::load(pZ)));
+}
+
+/* Evaluate points [begin, end) of an array of 2 or 3 floats per point. */
+static void evaluatePoints(const Parameters& parameters, const float* pPoints, size_t begin,
+                           size_t end, float* pOut)
+{
+  const int WIDTH = SimdLanes::WIDTH;
+  int stride = parameters.dimensions;
+  float coordinates[3][WIDTH];
+  size_t i = begin;
+  for (; i + WIDTH <= end; i += WIDTH)
+  {
+    for (int lane = 0; lane < WIDTH; ++lane)
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        coordinates[c][lane] = pPoints[(i + lane) * stride + std::min(c, stride - 1)];
+      }
+    }
+    evaluateBlock<SimdLanes>(parameters, coordinates[0], coordinates[1], coordinates[2],
+                             pOut + i);
+  }
+  for (; i < end; ++i)
+  {
+    const float* pPoint = pPoints + i * stride;
+    evaluateBlock<ScalarLanes>(parameters, pPoint, pPoint + 1, pPoint + stride - 1, pOut + i);
+  }
+}
+
+/* Evaluate one tile of a grid, a row of columns [x0, x1) is contiguous in pOut. */
+static void evaluateTile(const Parameters& parameters, const float* pColumns, int x0, int x1,
+                         int y0, int y1, float y, float z, float yStep, float* pOut,
+                         size_t rowStride)
+{
+  const int WIDTH = SimdLanes::WIDTH;
+  float ys[WIDTH], zs[WIDTH];
+  std::fill(zs, zs + WIDTH, z);
+  for (int row = y0; row < y1; ++row)
+  {
+    std::fill(ys, ys + WIDTH, y + (float) row * yStep);
+    float* pRow = pOut + row * rowStride;
+    int column = x0;
+    for (; column + WIDTH <= x1; column += WIDTH)
+    {
+      evaluateBlock<SimdLanes>(parameters, pColumns + column, ys, zs, pRow + column);
+    }
+    for (; column < x1; ++column)
+    {
+      evaluateBlock<ScalarLanes>(parameters, pColumns + column, ys, zs, pRow + column);
+    }
+  }
+}
+
+/* Fill a grid of depth slices tile by tile. */
+static void fillTiles(const Parameters& parameters, float* pOut, int width, int height,
+                      int depth, const float origin[3], const float spacing[3], ThreadPool* pPool)
+{
+  if (width <= 0 || height <= 0 || depth <= 0)
+  {
+    return;
+  }
+
+  std::vector<float> columns(width);
+  for (int x = 0; x < width; ++x)
+  {
+    columns[x] = origin[0] + (float) x * spacing[0];
+  }
+
+  int tilesX = (width + Noise::TILE_SIZE - 1) / Noise::TILE_SIZE;
+  int tilesY = (height + Noise::TILE_SIZE - 1) / Noise::TILE_SIZE;
+  size_t sliceSize = (size_t) width * height;
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+    for (size_t tile = begin; tile < end; ++tile)
+    {
+      int tileX = (int) (tile % tilesX);
+      int tileY = (int) (tile / tilesX % tilesY);
+      int slice = (int) (tile / tilesX / tilesY);
+      int x0 = tileX * Noise::TILE_SIZE, y0 = tileY * Noise::TILE_SIZE;
+      evaluateTile(parameters, &columns[0], x0, std::min(x0 + Noise::TILE_SIZE, width), y0,
+                   std::min(y0 + Noise::TILE_SIZE, height), origin[1],
+                   origin[2] + (float) slice * spacing[2], spacing[1],
+                   pOut + slice * sliceSize, width);
+    }
+  };
+
+  size_t tileCount = (size_t) tilesX * tilesY * depth;
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, tileCount, 1, task);
+  }
+  else
+  {
+    task(0, tileCount);
+  }
+}
+
+/* Gather the settings of a noise for the kernels. */
+static Parameters makeParameters(const Noise& noise, int dimensions)
+{
+  Parameters parameters;
+  parameters.type = noise.getType();
+  parameters.fractal = noise.getFractal();
+  parameters.dimensions = dimensions;
+  parameters.seed = noise.getSeed();
+  parameters.octaves = noise.getFractal() == Noise::FRACTAL_NONE ? 1 : noise.getOctaves();
+  parameters.frequency = noise.getFrequency();
+  parameters.lacunarity = noise.getLacunarity();
+  parameters.gain = noise.getGain();
+
+  float amplitude = 1.0f, total = 0.0f;
+  for (int octave = 0; octave < parameters.octaves; ++octave)
+  {
+    total += amplitude;
+    amplitude *= parameters.gain;
+  }
+  parameters.scale = (parameters.fractal == Noise::FRACTAL_RIDGED ? 2.0f : 1.0f) / total;
+  return parameters;
+}
+
+/**
+ * @brief Constructor.
+ *
+ * The noise has a frequency of 1 and no fractal octaves.
+ *
+ * @param[in] type - basis noise
+ * @param[in] seed - seed of the lattice hash
+ */
+Noise::Noise(Type type, unsigned int seed)
+  : m_type(type)
+  , m_seed(seed)
+  , m_frequency(1.0f)
+  , m_fractal(FRACTAL_NONE)
+  , m_octaves(1)
+  , m_lacunarity(2.0f)
+  , m_gain(0.5f)
+{
+}
+
+/**
+ * @brief Set the basis noise.
+ *
+ * @param[in] type - value, Perlin or simplex noise
+ */
+void Noise::setType(Type type)
+{
+  m_type = type;
+}
+
+/**
+ * @brief Obtain the basis noise.
+ *
+ * @return type of noise
+ */
+Noise::Type Noise::getType() const
+{
+  return m_type;
+}
+
+/**
+ * @brief Set the seed. Octave i uses seed + i.
+ *
+ * @param[in] seed - seed of the lattice hash
+ */
+void Noise::setSeed(unsigned int seed)
+{
+  m_seed = seed;
+}
+
+/**
+ * @brief Obtain the seed.
+ *
+ * @return seed of the lattice hash
+ */
+unsigned int Noise::getSeed() const
+{
+  return m_seed;
+}
+
+/**
+ * @brief Set the frequency of the first octave.
+ *
+ * @param[in] frequency - lattice cells per unit
+ */
+void Noise::setFrequency(float frequency)
+{
+  m_frequency = frequency;
+}
+
+/**
+ * @brief Obtain the frequency of the first octave.
+ *
+ * @return lattice cells per unit
+ */
+float Noise::getFrequency() const
+{
+  return m_frequency;
+}
+
+/**
+ * @brief Set how octaves are combined.
+ *
+ * Octave i has the frequency multiplied by lacunarity^i and the amplitude
+ * by gain^i. The sum is normalized back to [-1, 1].
+ *
+ * @param[in] fractal    - fBm, ridged, or a single octave
+ * @param[in] octaves    - number of octaves, 1 to MAX_OCTAVES
+ * @param[in] lacunarity - frequency multiplier per octave
+ * @param[in] gain       - amplitude multiplier per octave
+ */
+void Noise::setFractal(Fractal fractal, int octaves, float lacunarity, float gain)
+{
+  m_fractal = fractal;
+  m_octaves = std::min(std::max(octaves, 1), static_cast<int>(MAX_OCTAVES));
+  m_lacunarity = lacunarity;
+  m_gain = gain;
+}
+
+/**
+ * @brief Obtain how octaves are combined.
+ *
+ * @return the fractal type
+ */
+Noise::Fractal Noise::getFractal() const
+{
+  return m_fractal;
+}
+
+/**
+ * @brief Obtain the number of octaves.
+ *
+ * @return number of octaves, ignored for FRACTAL_NONE
+ */
+int Noise::getOctaves() const
+{
+  return m_octaves;
+}
+
+/**
+ * @brief Obtain the frequency multiplier per octave.
+ *
+ * @return lacunarity
+ */
+float Noise::getLacunarity() const
+{
+  return m_lacunarity;
+}
+
+/**
+ * @brief Obtain the amplitude multiplier per octave.
+ *
+ * @return gain
+ */
+float Noise::getGain() const
+{
+  return m_gain;
+}
+
+/**
+ * @brief Evaluate the noise at a point.
+ *
+ * @param[in] point - sample position
+ * @return noise value in [-1, 1]
+ */
+float Noise::sample(const Vector2f& point) const
+{
+  float result;
+  evaluateBlock<ScalarLanes>(makeParameters(*this, 2), &point.x, &point.y, &point.y, &result);
+  return result;
+}
+
+/**
+ * @brief Evaluate the noise at a point.
+ *
+ * @param[in] point - sample position
+ * @return noise value in [-1, 1]
+ */
+float Noise::sample(const Vector3f& point) const
+{
+  float result;
+  evaluateBlock<ScalarLanes>(makeParameters(*this, 3), &point.x, &point.y, &point.z, &result);
+  return result;
+}
+
+/**
+ * @brief Evaluate the noise at many points.
+ *
+ * @param[in]  pPoints - sample positions
+ * @param[in]  count   - number of points
+ * @param[out] pOut    - count noise values
+ * @param[in]  pPool   - thread pool to split the points across, or NULL
+ */
+void Noise::sample(const Vector2f* pPoints, size_t count, float* pOut, ThreadPool* pPool) const
+{
+  LITE_PROFILE_ZONE("Noise::sample");
+
+  Parameters parameters = makeParameters(*this, 2);
+  const float* pCoordinates = reinterpret_cast<const float*>(pPoints);
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+    evaluatePoints(parameters, pCoordinates, begin, end, pOut);
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, count);
+  }
+}
+
+/**
+ * @brief Evaluate the noise at many points.
+ *
+ * @param[in]  pPoints - sample positions
+ * @param[in]  count   - number of points
+ * @param[out] pOut    - count noise values
+ * @param[in]  pPool   - thread pool to split the points across, or NULL
+ */
+void Noise::sample(const Vector3f* pPoints, size_t count, float* pOut, ThreadPool* pPool) const
+{
+  LITE_PROFILE_ZONE("Noise::sample");
+
+  Parameters parameters = makeParameters(*this, 3);
+  const float* pCoordinates = reinterpret_cast<const float*>(pPoints);
+  ThreadPool::RangeTask task = [&](size_t begin, size_t end)
+  {
+    evaluatePoints(parameters, pCoordinates, begin, end, pOut);
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, GRAIN_SIZE, task);
+  }
+  else
+  {
+    task(0, count);
+  }
+}
+
+/**
+ * @brief Evaluate the noise on a 2D grid.
+ *
+ * Sample (x, y) is at origin + (x, y) * spacing and is written to
+ * pOut[y * width + x]. Tiles of TILE_SIZE x TILE_SIZE samples are spread
+ * across the pool.
+ *
+ * @param[out] pOut    - width * height noise values
+ * @param[in]  width   - number of columns
+ * @param[in]  height  - number of rows
+ * @param[in]  origin  - position of the first sample
+ * @param[in]  spacing - distance between neighbouring samples
+ * @param[in]  pPool   - thread pool to split the tiles across, or NULL
+ */
+void Noise::fillGrid(float* pOut, int width, int height, const Vector2f& origin,
+                     const Vector2f& spacing, ThreadPool* pPool) const
+{
+  LITE_PROFILE_ZONE("Noise::fillGrid");
+
+  float gridOrigin[3] = { origin.x, origin.y, 0.0f };
+  float gridSpacing[3] = { spacing.x, spacing.y, 0.0f };
+  fillTiles(makeParameters(*this, 2), pOut, width, height, 1, gridOrigin, gridSpacing, pPool);
+}
+
+/**
+ * @brief Evaluate the noise on a 3D grid.
+ *
+ * Sample (x, y, z) is at origin + (x, y, z) * spacing and is written to
+ * pOut[(z * height + y) * width + x].
+ *
+ * @param[out] pOut    - width * height * depth noise values
+ * @param[in]  width   - number of columns
+ * @param[in]  height  - number of rows
+ * @param[in]  depth   - number of slices
+ * @param[in]  origin  - position of the first sample
+ * @param[in]  spacing - distance between neighbouring samples
+ * @param[in]  pPool   - thread pool to split the tiles across, or NULL
+ */
+void Noise::fillGrid(float* pOut, int width, int height, int depth, const Vector3f& origin,
+                     const Vector3f& spacing, ThreadPool* pPool) const
+{
+  LITE_PROFILE_ZONE("Noise::fillGrid");
+
+  float gridOrigin[3] = { origin.x, origin.y, origin.z };
+  float gridSpacing[3] = { spacing.x, spacing.y, spacing.z };
+  fillTiles(makeParameters(*this, 3), pOut, width, height, depth, gridOrigin, gridSpacing,
+            pPool);
+}
+
+/**
+ * @brief Obtain the instruction set the batch functions were built for.
+ *
+ * @return "AVX2", "SSE2" or "scalar"
+ */
+const char* Noise::getInstructionSet()
+{
+#if defined(LITE_AVX2)
+  return "AVX2";
+#elif defined(LITE_SSE2)
+  return "SSE2";
+#else
+  return "scalar";
+#endif
+}
+
+}
@@ -0,0 +1,235 @@
+/**
+ * @file Quaternion.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the Quaternion class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Math\Quaternion.h"
+
+#include <cmath>
+
+namespace Lite
+{
+const Quaternion Quaternion::Identity;
+
+/**
+ * Default constructor.
+ * Initializes the quaternion to the identity rotation.
+ */
+Quaternion::Quaternion()
+  : x(0.0f)
+  , y(0.0f)
+  , z(0.0f)
+  , w(1.0f)
+{
+}
+
+/**
+ * Parametrized constructor.
+ *
+ * @param[in] x - x component of the vector part
+ * @param[in] y - y component of the vector part
+ * @param[in] z - z component of the vector part
+ * @param[in] w - scalar part
+ */
+Quaternion::Quaternion(float x, float y, float z, float w)
+  : x(x)
+  , y(y)
+  , z(z)
+  , w(w)
+{
+}
+
+/**
+ * Create a rotation around an axis.
+ *
+ * @param[in] axis  - unit rotation axis
+ * @param[in] angle - rotation angle in radians
+ */
+Quaternion::Quaternion(const Vector3f& axis, float angle)
+{
+  float s = sinf(angle * 0.5f);
+  x = axis.x * s;
+  y = axis.y * s;
+  z = axis.z * s;
+  w = cosf(angle * 0.5f);
+}
+
+/**
+ * Normalize this quaternion so that it represents a pure rotation.
+ */
+void Quaternion::normalize()
+{
+  float len = length();
+  if (len > 0.0f)
+  {
+    float inv = 1.0f / len;
+    x *= inv;
+    y *= inv;
+    z *= inv;
+    w *= inv;
+  }
+}
+
+/**
+ * Calculate the length of this quaternion.
+ *
+ * @return length, 1 for a rotation
+ */
+float Quaternion::length() const
+{
+  return sqrtf(x * x + y * y + z * z + w * w);
+}
+
+/**
+ * Calculate the four dimensional dot product with the other quaternion.
+ *
+ * @param[in] other - right hand side of the operation
+ *
+ * @return the dot product
+ */
+float Quaternion::dot(const Quaternion& other) const
+{
+  return x * other.x + y * other.y + z * other.z + w * other.w;
+}
+
+/**
+ * Calculate the conjugate, which is the inverse rotation.
+ *
+ * @return the conjugate quaternion
+ */
+Quaternion Quaternion::conjugate() const
+{
+  return Quaternion(-x, -y, -z, w);
+}
+
+/**
+ * Rotate a point by this rotation.
+ *
+ * @param[in] point - point to rotate
+ *
+ * @return rotated point
+ */
+Vector3f Quaternion::rotate(const Vector3f& point) const
+{
+  // t = 2 * cross(q.xyz, p), p' = p + w * t + cross(q.xyz, t)
+  float tx = 2.0f * (y * point.z - z * point.y);
+  float ty = 2.0f * (z * point.x - x * point.z);
+  float tz = 2.0f * (x * point.y - y * point.x);
+  return Vector3f(point.x + w * tx + (y * tz - z * ty),
+                  point.y + w * ty + (z * tx - x * tz),
+                  point.z + w * tz + (x * ty - y * tx));
+}
+
+/**
+ * Convert this rotation to a row-major 3x3 matrix.
+ *
+ * @param[out] matrix - the nine matrix elements
+ */
+void Quaternion::toMatrix(float matrix[9]) const
+{
+  float xx = x * x, yy = y * y, zz = z * z;
+  float xy = x * y, xz = x * z, yz = y * z;
+  float wx = w * x, wy = w * y, wz = w * z;
+
+  matrix[0] = 1.0f - 2.0f * (yy + zz);
+  matrix[1] = 2.0f * (xy - wz);
+  matrix[2] = 2.0f * (xz + wy);
+  matrix[3] = 2.0f * (xy + wz);
+  matrix[4] = 1.0f - 2.0f * (xx + zz);
+  matrix[5] = 2.0f * (yz - wx);
+  matrix[6] = 2.0f * (xz - wy);
+  matrix[7] = 2.0f * (yz + wx);
+  matrix[8] = 1.0f - 2.0f * (xx + yy);
+}
+
+/**
+ * Interpolate linearly and normalize, along the shortest path.
+ *
+ * Cheaper than slerp() and accurate enough for small angles.
+ *
+ * @param[in] from - rotation at t = 0
+ * @param[in] to   - rotation at t = 1
+ * @param[in] t    - interpolation factor
+ *
+ * @return interpolated rotation
+ */
+Quaternion Quaternion::nlerp(const Quaternion& from, const Quaternion& to, float t)
+{
+  float sign = from.dot(to) < 0.0f ? -1.0f : 1.0f;
+  float s = 1.0f - t;
+  Quaternion q(from.x * s + to.x * t * sign,
+               from.y * s + to.y * t * sign,
+               from.z * s + to.z * t * sign,
+               from.w * s + to.w * t * sign);
+  q.normalize();
+  return q;
+}
+
+/**
+ * Interpolate with constant angular velocity, along the shortest path.
+ *
+ * @param[in] from - rotation at t = 0
+ * @param[in] to   - rotation at t = 1
+ * @param[in] t    - interpolation factor
+ *
+ * @return interpolated rotation
+ */
+Quaternion Quaternion::slerp(const Quaternion& from, const Quaternion& to, float t)
+{
+  float cosTheta = from.dot(to);
+  float sign = 1.0f;
+  if (cosTheta < 0.0f)
+  {
+    cosTheta = -cosTheta;
+    sign = -1.0f;
+  }
+
+  if (cosTheta > 0.9995f)
+  {
+    return nlerp(from, to, t);
+  }
+
+  float theta = acosf(cosTheta);
+  float invSin = 1.0f / sinf(theta);
+  float a = sinf((1.0f - t) * theta) * invSin;
+  float b = sinf(t * theta) * invSin * sign;
+  return Quaternion(from.x * a + to.x * b,
+                    from.y * a + to.y * b,
+                    from.z * a + to.z * b,
+                    from.w * a + to.w * b);
+}
+
+bool Quaternion::operator !=(const Quaternion& right) const
+{
+  return !(*this == right);
+}
+
+bool Quaternion::operator ==(const Quaternion& right) const
+{
+  return fabs(x - right.x) < EPSILON &&
+         fabs(y - right.y) < EPSILON &&
+         fabs(z - right.z) < EPSILON &&
+         fabs(w - right.w) < EPSILON;
+}
+
+/**
+ * Combine two rotations. The right rotation is applied first.
+ */
+Quaternion operator *(const Quaternion& left, const Quaternion& right)
+{
+  return Quaternion(
+    left.w * right.x + left.x * right.w + left.y * right.z - left.z * right.y,
+    left.w * right.y - left.x * right.z + left.y * right.w + left.z * right.x,
+    left.w * right.z + left.x * right.y - left.y * right.x + left.z * right.w,
+    left.w * right.w - left.x * right.x - left.y * right.y - left.z * right.z);
+}
+
+}
@@ -85,7 +85,7 @@ Vector2f::~Vector2f()
  *
  * This method makes the vector have a length of 1.
  */
-inline void Vector2f::normalize()
+void Vector2f::normalize()
 {
 	float length = this->length();
 	x /= length;
@@ -97,7 +97,7 @@ inline void Vector2f::normalize()
  *
  * @return vector length
 */
-inline float Vector2f::length() const
+float Vector2f::length() const
 {
 	return (float)sqrt((double) x * x + y * y);
 }
@@ -107,7 +107,7 @@ inline float Vector2f::length() const
  *
  * @return vector squared length
 */
-inline float Vector2f::lengthSqr() const
+float Vector2f::lengthSqr() const
 {
 	return x * x + y * y;
 }
@@ -120,7 +120,7 @@ inline float Vector2f::lengthSqr() const
  *
  * @return the dot product
  */
-inline float Vector2f::dot(const Vector2f& other) const
+float Vector2f::dot(const Vector2f& other) const
 {
 	return x * other.x + y * other.y;
 }
@@ -132,7 +132,7 @@ inline float Vector2f::dot(const Vector2f& other) const
  *
  * @return distance to other vector
  */
-inline float Vector2f::distance(const Vector2f& other) const
+float Vector2f::distance(const Vector2f& other) const
 {
 	return sqrt((x - other.x) * (x - other.x) + (y - other.y) * (y - other.y));
 }
@@ -144,7 +144,7 @@ inline float Vector2f::distance(const Vector2f& other) const
  *
  * @return squared distance to other vector
  */
-inline float Vector2f::distanceSqr(const Vector2f& other) const
+float Vector2f::distanceSqr(const Vector2f& other) const
 {
 	return sqrt((x - other.x) * (x - other.x) + (y - other.y) * (y - other.y));
 }
@@ -157,7 +157,7 @@ inline float Vector2f::distanceSqr(const Vector2f& other) const
  *
  * @return the reflection
  */
-inline Vector2f Vector2f::reflect(const Vector2f& normal) const
+Vector2f Vector2f::reflect(const Vector2f& normal) const
 {
 	float dot = this->dot(normal);
 	return Vector2f(x - 2.0f * dot * normal.x,
@@ -171,7 +171,7 @@ inline Vector2f Vector2f::reflect(const Vector2f& normal) const
  *
  * @return angle in degrees
  */
-inline float Vector2f::angle(const Vector2f& other) const
+float Vector2f::angle(const Vector2f& other) const
 {
 	return atan2(x * other.y - y * other.x,
 		         dot(other));
@@ -183,7 +183,7 @@ inline float Vector2f::angle(const Vector2f& other) const
  *
  * @return coordinates array with two elements
  */
-inline Vector2f::operator float*()
+Vector2f::operator float*()
 {
 	return v;
 }
@@ -194,24 +194,24 @@ inline Vector2f::operator float*()
  *
  * @return const coordinates array with two elements
  */
-inline Vector2f::operator const float*() const
+Vector2f::operator const float*() const
 {
 	return v;
 }
 
-inline bool Vector2f::operator !=(const Vector2f& right) const
+bool Vector2f::operator !=(const Vector2f& right) const
 {
 	return fabs(x - right.x) > EPSILON || 
          fabs(y - right.y) > EPSILON;
 }
 
-inline bool Vector2f::operator ==(const Vector2f& right) const
+bool Vector2f::operator ==(const Vector2f& right) const
 {
 	return fabs(x - right.x) < EPSILON &&
 		     fabs(y - right.y) < EPSILON;
 }
 
-inline Vector2f& Vector2f::operator =(const Vector2f& right)
+Vector2f& Vector2f::operator =(const Vector2f& right)
 {
 	if (this != &right)
 	{
@@ -222,48 +222,48 @@ inline Vector2f& Vector2f::operator =(const Vector2f& right)
 	return *this;
 }
 
-inline Vector2f Vector2f::operator -() const
+Vector2f Vector2f::operator -() const
 {
 	return Vector2f(-x, -y);
 }
 
-inline Vector2f& Vector2f::operator *=(float val)
+Vector2f& Vector2f::operator *=(float val)
 {
 	x *= val;
 	y *= val;
 	return *this;
 }
 
-inline Vector2f& Vector2f::operator +=(const Vector2f& right)
+Vector2f& Vector2f::operator +=(const Vector2f& right)
 {
 	x += right.x;
 	y += right.y;
 	return *this;
 }
 
-inline Vector2f& Vector2f::operator -=(const Vector2f& right)
+Vector2f& Vector2f::operator -=(const Vector2f& right)
 {
 	x -= right.x;
 	y -= right.y;
 	return *this;
 }
 
-inline Vector2f operator *(const Vector2f& left, float right)
+Vector2f operator *(const Vector2f& left, float right)
 {
 	return Vector2f(left.x * right, left.y * right);
 }
 
-inline Vector2f operator *(float left, const Vector2f& right)
+Vector2f operator *(float left, const Vector2f& right)
 {
 	return Vector2f(right.x * left, right.y * left);
 }
 
-inline Vector2f operator -(const Vector2f& left, const Vector2f& right)
+Vector2f operator -(const Vector2f& left, const Vector2f& right)
 {
 	return Vector2f(left.x - right.x, left.y - right.y);
 }
 
-inline Vector2f operator +(const Vector2f& left, const Vector2f& right)
+Vector2f operator +(const Vector2f& left, const Vector2f& right)
 {
 	return Vector2f(left.x + right.x, left.y + right.y);
 }
@@ -93,11 +93,12 @@ Vector3f::~Vector3f()
  * Normalize this vector.
  * This method makes the vector have a length of 1.
  */
-inline void Vector3f::normalize()
+void Vector3f::normalize()
 {
-  x /= length();
-  y /= length();
-  z /= length();
+  float length = this->length();
+  x /= length;
+  y /= length;
+  z /= length;
 }
 
 /**
@@ -105,7 +106,7 @@ inline void Vector3f::normalize()
  *
  * @return vector length
 */
-inline float Vector3f::length() const
+float Vector3f::length() const
 {
   return sqrt(x * x + y * y + z * z);
 }
@@ -115,7 +116,7 @@ inline float Vector3f::length() const
  *
  * @return vector squared length
 */
-inline float Vector3f::lengthSqr() const
+float Vector3f::lengthSqr() const
 {
   return x * x + y * y + z * z;
 }
@@ -127,7 +128,7 @@ inline float Vector3f::lengthSqr() const
  *
  * @return the dot product
  */
-inline float Vector3f::dot(const Vector3f& other) const
+float Vector3f::dot(const Vector3f& other) const
 {
   return x * other.x + y * other.y + z * other.z;
 }
@@ -139,7 +140,7 @@ inline float Vector3f::dot(const Vector3f& other) const
  *
  * @return distance to other vector
  */
-inline float Vector3f::distance(const Vector3f& other) const
+float Vector3f::distance(const Vector3f& other) const
 {
   return sqrt((x - other.x) * (x - other.x) +
               (y - other.y) * (y - other.y) + 
@@ -153,7 +154,7 @@ inline float Vector3f::distance(const Vector3f& other) const
  *
  * @return squared distance to other vector
  */
-inline float Vector3f::distanceSqr(const Vector3f& other) const
+float Vector3f::distanceSqr(const Vector3f& other) const
 {
   return (x - other.x) * (x - other.x) +
          (y - other.y) * (y - other.y) + 
@@ -0,0 +1,1274 @@
+/**
+ * @file RigidBodyWorld.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the RigidBodyWorld class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Physics\RigidBodyWorld.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace Lite
+{
+
+static const float  BAUMGARTE            = 0.2f;
+static const float  PENETRATION_SLOP     = 0.005f;
+static const float  RESTITUTION_VELOCITY = 1.0f;
+static const size_t MAX_BOX_CONTACTS     = 4;
+static const size_t BODY_GRAIN_SIZE      = 1024;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static double elapsedMs(Clock::time_point& start)
+{
+  Clock::time_point now = Clock::now();
+  double ms = std::chrono::duration<double, std::milli>(now - start).count();
+  start = now;
+  return ms;
+}
+
+static inline float dot3(const float a[3], const float b[3])
+{
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+static inline void cross3(const float a[3], const float b[3], float out[3])
+{
+  float x = a[1] * b[2] - a[2] * b[1];
+  float y = a[2] * b[0] - a[0] * b[2];
+  float z = a[0] * b[1] - a[1] * b[0];
+  out[0] = x;
+  out[1] = y;
+  out[2] = z;
+}
+
+static inline void mul33(const float m[9], const float v[3], float out[3])
+{
+  float x = m[0] * v[0] + m[1] * v[1] + m[2] * v[2];
+  float y = m[3] * v[0] + m[4] * v[1] + m[5] * v[2];
+  float z = m[6] * v[0] + m[7] * v[1] + m[8] * v[2];
+  out[0] = x;
+  out[1] = y;
+  out[2] = z;
+}
+
+static inline void mul33T(const float m[9], const float v[3], float out[3])
+{
+  float x = m[0] * v[0] + m[3] * v[1] + m[6] * v[2];
+  float y = m[1] * v[0] + m[4] * v[1] + m[7] * v[2];
+  float z = m[2] * v[0] + m[5] * v[1] + m[8] * v[2];
+  out[0] = x;
+  out[1] = y;
+  out[2] = z;
+}
+
+/*
+ * Build two unit tangents perpendicular to the unit normal n.
+ */
+static void tangentBasis(const float n[3], float t1[3], float t2[3])
+{
+  if (fabsf(n[0]) > 0.57735f)
+  {
+    t1[0] = n[1];
+    t1[1] = -n[0];
+    t1[2] = 0.0f;
+  }
+  else
+  {
+    t1[0] = 0.0f;
+    t1[1] = n[2];
+    t1[2] = -n[1];
+  }
+  float inv = 1.0f / sqrtf(dot3(t1, t1));
+  t1[0] *= inv;
+  t1[1] *= inv;
+  t1[2] *= inv;
+  cross3(n, t1, t2);
+}
+
+/**
+ * Default constructor.
+ * Creates an empty world with earth gravity and a ground plane at y = 0.
+ */
+RigidBodyWorld::RigidBodyWorld()
+  : m_gravity(0.0f, -9.81f, 0.0f)
+  , m_groundHeight(0.0f)
+  , m_hasGround(true)
+  , m_iterations(10)
+  , m_friction(0.5f)
+  , m_restitution(0.0f)
+{
+  m_timings.integrateVelocities = 0.0;
+  m_timings.broadphase = 0.0;
+  m_timings.narrowphase = 0.0;
+  m_timings.islands = 0.0;
+  m_timings.solver = 0.0;
+  m_timings.integratePositions = 0.0;
+  m_timings.total = 0.0;
+}
+
+/**
+ * Destructor.
+ */
+RigidBodyWorld::~RigidBodyWorld()
+{
+}
+
+/**
+ * Add a sphere.
+ *
+ * @param[in] position - center of the sphere
+ * @param[in] radius   - sphere radius
+ * @param[in] mass     - mass, 0 for a static body
+ *
+ * @return handle of the new body
+ */
+unsigned int RigidBodyWorld::addSphere(const Vector3f& position, float radius,
+                                       float mass)
+{
+  return addBody(position, Quaternion::Identity,
+                 Vector3f(radius, radius, radius), SHAPE_SPHERE, mass);
+}
+
+/**
+ * Add a box.
+ *
+ * @param[in] position    - center of the box
+ * @param[in] halfExtents - half of the box size along its local axes
+ * @param[in] orientation - initial rotation
+ * @param[in] mass        - mass, 0 for a static body
+ *
+ * @return handle of the new body
+ */
+unsigned int RigidBodyWorld::addBox(const Vector3f& position,
+                                    const Vector3f& halfExtents,
+                                    const Quaternion& orientation, float mass)
+{
+  return addBody(position, orientation, halfExtents, SHAPE_BOX, mass);
+}
+
+unsigned int RigidBodyWorld::addBody(const Vector3f& position,
+                                     const Quaternion& orientation,
+                                     const Vector3f& size, ShapeType shape,
+                                     float mass)
+{
+  unsigned int body = (unsigned int) m_invMass.size();
+  Quaternion q = orientation;
+  q.normalize();
+
+  m_px.push_back(position.x);
+  m_py.push_back(position.y);
+  m_pz.push_back(position.z);
+  m_qx.push_back(q.x);
+  m_qy.push_back(q.y);
+  m_qz.push_back(q.z);
+  m_qw.push_back(q.w);
+  m_vx.push_back(0.0f);
+  m_vy.push_back(0.0f);
+  m_vz.push_back(0.0f);
+  m_wx.push_back(0.0f);
+  m_wy.push_back(0.0f);
+  m_wz.push_back(0.0f);
+  m_sizeX.push_back(size.x);
+  m_sizeY.push_back(size.y);
+  m_sizeZ.push_back(size.z);
+  m_shape.push_back((unsigned char) shape);
+
+  float ix = 0.0f, iy = 0.0f, iz = 0.0f;
+  if (mass > 0.0f)
+  {
+    if (shape == SHAPE_SPHERE)
+    {
+      ix = iy = iz = 0.4f * mass * size.x * size.x;
+    }
+    else
+    {
+      ix = mass / 3.0f * (size.y * size.y + size.z * size.z);
+      iy = mass / 3.0f * (size.x * size.x + size.z * size.z);
+      iz = mass / 3.0f * (size.x * size.x + size.y * size.y);
+    }
+  }
+  m_invMass.push_back(mass > 0.0f ? 1.0f / mass : 0.0f);
+  m_invInertiaX.push_back(ix > 0.0f ? 1.0f / ix : 0.0f);
+  m_invInertiaY.push_back(iy > 0.0f ? 1.0f / iy : 0.0f);
+  m_invInertiaZ.push_back(iz > 0.0f ? 1.0f / iz : 0.0f);
+
+  m_rotation.resize(m_rotation.size() + 9);
+  m_solverBodies.resize(m_solverBodies.size() + 1);
+  q.toMatrix(&m_rotation[body * 9]);
+
+  m_proxies.push_back(m_broadphase.addProxy(computeBounds(body)));
+  return body;
+}
+
+/**
+ * Remove all bodies.
+ */
+void RigidBodyWorld::clear()
+{
+  std::vector<float>* arrays[] = {
+    &m_px, &m_py, &m_pz, &m_qx, &m_qy, &m_qz, &m_qw,
+    &m_vx, &m_vy, &m_vz, &m_wx, &m_wy, &m_wz, &m_invMass,
+    &m_invInertiaX, &m_invInertiaY, &m_invInertiaZ,
+    &m_sizeX, &m_sizeY, &m_sizeZ, &m_rotation
+  };
+  for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); ++i)
+  {
+    arrays[i]->clear();
+  }
+  m_shape.clear();
+  m_proxies.clear();
+  m_solverBodies.clear();
+  m_broadphase.clear();
+  m_contacts.clear();
+  m_impulseCache.clear();
+  m_islandContacts.clear();
+  m_islandStart.clear();
+  m_islandOrder.clear();
+}
+
+/**
+ * Set the acceleration applied to all dynamic bodies.
+ *
+ * @param[in] gravity - acceleration in units per second squared
+ */
+void RigidBodyWorld::setGravity(const Vector3f& gravity)
+{
+  m_gravity = gravity;
+}
+
+/**
+ * Obtain the acceleration applied to all dynamic bodies.
+ *
+ * @return gravity
+ */
+const Vector3f& RigidBodyWorld::getGravity() const
+{
+  return m_gravity;
+}
+
+/**
+ * Enable or disable the infinite ground plane facing +y.
+ *
+ * @param[in] isEnabled - true to collide with the ground
+ * @param[in] height    - y coordinate of the plane
+ */
+void RigidBodyWorld::setGround(bool isEnabled, float height)
+{
+  m_hasGround = isEnabled;
+  m_groundHeight = height;
+}
+
+/**
+ * Set the number of solver iterations per step.
+ *
+ * @param[in] iterations - more iterations give stiffer stacks
+ */
+void RigidBodyWorld::setIterations(unsigned int iterations)
+{
+  m_iterations = iterations > 0 ? iterations : 1;
+}
+
+/**
+ * Set the Coulomb friction coefficient used by all contacts.
+ *
+ * @param[in] friction - friction coefficient
+ */
+void RigidBodyWorld::setFriction(float friction)
+{
+  m_friction = friction;
+}
+
+/**
+ * Set the restitution used by all contacts.
+ *
+ * @param[in] restitution - 0 for no bounce, 1 for a perfectly elastic bounce
+ */
+void RigidBodyWorld::setRestitution(float restitution)
+{
+  m_restitution = restitution;
+}
+
+/**
+ * Set the linear velocity of a body.
+ *
+ * @param[in] body     - body handle
+ * @param[in] velocity - velocity in units per second
+ */
+void RigidBodyWorld::setLinearVelocity(unsigned int body, const Vector3f& velocity)
+{
+  m_vx[body] = velocity.x;
+  m_vy[body] = velocity.y;
+  m_vz[body] = velocity.z;
+}
+
+/**
+ * Set the angular velocity of a body.
+ *
+ * @param[in] body     - body handle
+ * @param[in] velocity - rotation axis scaled by radians per second
+ */
+void RigidBodyWorld::setAngularVelocity(unsigned int body, const Vector3f& velocity)
+{
+  m_wx[body] = velocity.x;
+  m_wy[body] = velocity.y;
+  m_wz[body] = velocity.z;
+}
+
+/**
+ * Obtain the position of a body.
+ *
+ * @param[in] body - body handle
+ *
+ * @return center of mass
+ */
+Vector3f RigidBodyWorld::getPosition(unsigned int body) const
+{
+  return Vector3f(m_px[body], m_py[body], m_pz[body]);
+}
+
+/**
+ * Obtain the orientation of a body.
+ *
+ * @param[in] body - body handle
+ *
+ * @return rotation
+ */
+Quaternion RigidBodyWorld::getOrientation(unsigned int body) const
+{
+  return Quaternion(m_qx[body], m_qy[body], m_qz[body], m_qw[body]);
+}
+
+/**
+ * Obtain the linear velocity of a body.
+ *
+ * @param[in] body - body handle
+ *
+ * @return velocity in units per second
+ */
+Vector3f RigidBodyWorld::getLinearVelocity(unsigned int body) const
+{
+  return Vector3f(m_vx[body], m_vy[body], m_vz[body]);
+}
+
+/**
+ * Obtain the angular velocity of a body.
+ *
+ * @param[in] body - body handle
+ *
+ * @return rotation axis scaled by radians per second
+ */
+Vector3f RigidBodyWorld::getAngularVelocity(unsigned int body) const
+{
+  return Vector3f(m_wx[body], m_wy[body], m_wz[body]);
+}
+
+/**
+ * Obtain the shape of a body.
+ *
+ * @param[in] body - body handle
+ *
+ * @return shape type
+ */
+RigidBodyWorld::ShapeType RigidBodyWorld::getShape(unsigned int body) const
+{
+  return (ShapeType) m_shape[body];
+}
+
+/**
+ * Obtain the number of bodies.
+ *
+ * @return body count
+ */
+size_t RigidBodyWorld::getBodyCount() const
+{
+  return m_invMass.size();
+}
+
+AABB RigidBodyWorld::computeBounds(unsigned int body) const
+{
+  float ex = m_sizeX[body], ey = m_sizeY[body], ez = m_sizeZ[body];
+  if (m_shape[body] == SHAPE_BOX)
+  {
+    const float* r = &m_rotation[body * 9];
+    float hx = fabsf(r[0]) * ex + fabsf(r[1]) * ey + fabsf(r[2]) * ez;
+    float hy = fabsf(r[3]) * ex + fabsf(r[4]) * ey + fabsf(r[5]) * ez;
+    float hz = fabsf(r[6]) * ex + fabsf(r[7]) * ey + fabsf(r[8]) * ez;
+    ex = hx;
+    ey = hy;
+    ez = hz;
+  }
+
+  return AABB(Vector3f(m_px[body] - ex, m_py[body] - ey, m_pz[body] - ez),
+              Vector3f(m_px[body] + ex, m_py[body] + ey, m_pz[body] + ez));
+}
+
+/*
+ * Refresh the rotation matrices and copy the velocities, with gravity
+ * applied, into the solver bodies the constraint solver works on.
+ */
+void RigidBodyWorld::integrateVelocities(size_t begin, size_t end, float dt)
+{
+  float gx = m_gravity.x * dt;
+  float gy = m_gravity.y * dt;
+  float gz = m_gravity.z * dt;
+
+  for (size_t i = begin; i < end; ++i)
+  {
+    float* r = &m_rotation[i * 9];
+    Quaternion(m_qx[i], m_qy[i], m_qz[i], m_qw[i]).toMatrix(r);
+
+    // I^-1 in world space is R * diag(I^-1) * R^T.
+    SolverBody& body = m_solverBodies[i];
+    float d[3] = { m_invInertiaX[i], m_invInertiaY[i], m_invInertiaZ[i] };
+    for (int row = 0; row < 3; ++row)
+    {
+      for (int col = 0; col < 3; ++col)
+      {
+        body.invInertia[row * 3 + col] = r[row * 3 + 0] * d[0] * r[col * 3 + 0] +
+                                         r[row * 3 + 1] * d[1] * r[col * 3 + 1] +
+                                         r[row * 3 + 2] * d[2] * r[col * 3 + 2];
+      }
+    }
+
+    bool isDynamic = m_invMass[i] > 0.0f;
+    body.invMass = m_invMass[i];
+    body.v[0] = m_vx[i] + (isDynamic ? gx : 0.0f);
+    body.v[1] = m_vy[i] + (isDynamic ? gy : 0.0f);
+    body.v[2] = m_vz[i] + (isDynamic ? gz : 0.0f);
+    body.w[0] = m_wx[i];
+    body.w[1] = m_wy[i];
+    body.w[2] = m_wz[i];
+    body.padding = 0.0f;
+  }
+}
+
+/*
+ * Copy the solved velocities back and integrate the positions with them.
+ */
+void RigidBodyWorld::integratePositions(size_t begin, size_t end, float dt)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    if (m_invMass[i] == 0.0f)
+    {
+      continue;
+    }
+
+    const SolverBody& body = m_solverBodies[i];
+    m_vx[i] = body.v[0];
+    m_vy[i] = body.v[1];
+    m_vz[i] = body.v[2];
+    m_wx[i] = body.w[0];
+    m_wy[i] = body.w[1];
+    m_wz[i] = body.w[2];
+
+    m_px[i] += m_vx[i] * dt;
+    m_py[i] += m_vy[i] * dt;
+    m_pz[i] += m_vz[i] * dt;
+
+    // dq/dt = 0.5 * (0, w) * q
+    float hx = m_wx[i] * dt * 0.5f;
+    float hy = m_wy[i] * dt * 0.5f;
+    float hz = m_wz[i] * dt * 0.5f;
+    float x = m_qx[i], y = m_qy[i], z = m_qz[i], w = m_qw[i];
+    float qx = x + hx * w + hy * z - hz * y;
+    float qy = y + hy * w + hz * x - hx * z;
+    float qz = z + hz * w + hx * y - hy * x;
+    float qw = w - hx * x - hy * y - hz * z;
+    float inv = 1.0f / sqrtf(qx * qx + qy * qy + qz * qz + qw * qw);
+    m_qx[i] = qx * inv;
+    m_qy[i] = qy * inv;
+    m_qz[i] = qz * inv;
+    m_qw[i] = qw * inv;
+  }
+}
+
+/*
+ * Contact generation. Every contact has the normal pointing from body a to
+ * body b and a positive penetration depth. Body a is always dynamic. The
+ * feature identifies the contact point within the pair from step to step.
+ */
+void RigidBodyWorld::initContact(Contact& contact, unsigned int a, unsigned int b,
+                                 unsigned int feature, const float point[3],
+                                 const float normal[3], float depth,
+                                 const float pa[3], const float pb[3])
+{
+  contact.a = a;
+  contact.b = b;
+  contact.feature = feature;
+  for (int k = 0; k < 3; ++k)
+  {
+    contact.normal[k] = normal[k];
+    contact.rA[k] = point[k] - pa[k];
+    contact.rB[k] = pb != NULL ? point[k] - pb[k] : 0.0f;
+  }
+  contact.depth = depth;
+  contact.impulse = contact.impulseT1 = contact.impulseT2 = 0.0f;
+}
+
+void RigidBodyWorld::collideGround(unsigned int a, std::vector<Contact>& out) const
+{
+  const float pa[3] = { m_px[a], m_py[a], m_pz[a] };
+  const float normal[3] = { 0.0f, -1.0f, 0.0f };
+
+  if (m_shape[a] == SHAPE_SPHERE)
+  {
+    float depth = m_groundHeight - (pa[1] - m_sizeX[a]);
+    if (depth > 0.0f)
+    {
+      float point[3] = { pa[0], pa[1] - m_sizeX[a], pa[2] };
+      out.push_back(Contact());
+      initContact(out.back(), a, INVALID_BODY, 0, point, normal, depth, pa, NULL);
+    }
+    return;
+  }
+
+  const float* r = &m_rotation[a * 9];
+  const float h[3] = { m_sizeX[a], m_sizeY[a], m_sizeZ[a] };
+  for (int v = 0; v < 8; ++v)
+  {
+    float local[3] = { v & 1 ? h[0] : -h[0], v & 2 ? h[1] : -h[1], v & 4 ? h[2] : -h[2] };
+    float point[3];
+    mul33(r, local, point);
+    point[0] += pa[0];
+    point[1] += pa[1];
+    point[2] += pa[2];
+    float depth = m_groundHeight - point[1];
+    if (depth > 0.0f)
+    {
+      out.push_back(Contact());
+      initContact(out.back(), a, INVALID_BODY, v, point, normal, depth, pa, NULL);
+    }
+  }
+}
+
+void RigidBodyWorld::collide(unsigned int a, unsigned int b,
+                             std::vector<Contact>& out) const
+{
+  // Order the pair so that a sphere comes first, the contacts are flipped
+  // back at the end so that body a stays the dynamic one.
+  if (m_shape[a] == SHAPE_BOX && m_shape[b] == SHAPE_SPHERE)
+  {
+    size_t first = out.size();
+    collide(b, a, out);
+    for (size_t i = first; i < out.size(); ++i)
+    {
+      Contact& c = out[i];
+      std::swap(c.a, c.b);
+      for (int k = 0; k < 3; ++k)
+      {
+        std::swap(c.rA[k], c.rB[k]);
+        c.normal[k] = -c.normal[k];
+      }
+    }
+    return;
+  }
+
+  const float pa[3] = { m_px[a], m_py[a], m_pz[a] };
+  const float pb[3] = { m_px[b], m_py[b], m_pz[b] };
+  float d[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+
+  if (m_shape[a] == SHAPE_SPHERE && m_shape[b] == SHAPE_SPHERE)
+  {
+    float radii = m_sizeX[a] + m_sizeX[b];
+    float distSqr = dot3(d, d);
+    if (distSqr >= radii * radii)
+    {
+      return;
+    }
+
+    float dist = sqrtf(distSqr);
+    float normal[3] = { 0.0f, 1.0f, 0.0f };
+    if (dist > 1e-6f)
+    {
+      normal[0] = d[0] / dist;
+      normal[1] = d[1] / dist;
+      normal[2] = d[2] / dist;
+    }
+    float point[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      point[k] = pa[k] + normal[k] * (m_sizeX[a] - (radii - dist) * 0.5f);
+    }
+    out.push_back(Contact());
+    initContact(out.back(), a, b, 0, point, normal, radii - dist, pa, pb);
+    return;
+  }
+
+  if (m_shape[a] == SHAPE_SPHERE)
+  {
+    // Sphere a against box b, in the local frame of the box.
+    const float* r = &m_rotation[b * 9];
+    const float h[3] = { m_sizeX[b], m_sizeY[b], m_sizeZ[b] };
+    float radius = m_sizeX[a];
+    float local[3], minusD[3] = { -d[0], -d[1], -d[2] };
+    mul33T(r, minusD, local);
+
+    float closest[3];
+    bool isInside = true;
+    for (int k = 0; k < 3; ++k)
+    {
+      closest[k] = std::max(-h[k], std::min(h[k], local[k]));
+      isInside = isInside && closest[k] == local[k];
+    }
+
+    float localNormal[3] = { 0.0f, 0.0f, 0.0f };   // Box towards sphere.
+    float depth;
+    if (isInside)
+    {
+      int axis = 0;
+      float best = h[0] - fabsf(local[0]);
+      for (int k = 1; k < 3; ++k)
+      {
+        if (h[k] - fabsf(local[k]) < best)
+        {
+          best = h[k] - fabsf(local[k]);
+          axis = k;
+        }
+      }
+      localNormal[axis] = local[axis] < 0.0f ? -1.0f : 1.0f;
+      closest[axis] = localNormal[axis] * h[axis];
+      depth = radius + best;
+    }
+    else
+    {
+      float diff[3] = { local[0] - closest[0], local[1] - closest[1], local[2] - closest[2] };
+      float distSqr = dot3(diff, diff);
+      if (distSqr >= radius * radius)
+      {
+        return;
+      }
+      float dist = sqrtf(distSqr);
+      for (int k = 0; k < 3; ++k)
+      {
+        localNormal[k] = diff[k] / dist;
+      }
+      depth = radius - dist;
+    }
+
+    float normal[3], point[3];
+    mul33(r, localNormal, normal);
+    mul33(r, closest, point);
+    for (int k = 0; k < 3; ++k)
+    {
+      normal[k] = -normal[k];
+      point[k] += pb[k];
+    }
+    out.push_back(Contact());
+    initContact(out.back(), a, b, 0, point, normal, depth, pa, pb);
+    return;
+  }
+
+  // Box against box: separating axis test over the 15 candidate axes.
+  const float* ra = &m_rotation[a * 9];
+  const float* rb = &m_rotation[b * 9];
+  const float ha[3] = { m_sizeX[a], m_sizeY[a], m_sizeZ[a] };
+  const float hb[3] = { m_sizeX[b], m_sizeY[b], m_sizeZ[b] };
+  float axesA[3][3], axesB[3][3];
+  for (int k = 0; k < 3; ++k)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      axesA[k][j] = ra[j * 3 + k];
+      axesB[k][j] = rb[j * 3 + k];
+    }
+  }
+
+  float bestDepth = 1e30f;
+  int bestAxis = 0;
+  float normal[3] = { 0.0f, 1.0f, 0.0f };
+  for (int i = 0; i < 15; ++i)
+  {
+    float axis[3];
+    if (i < 3)
+    {
+      axis[0] = axesA[i][0]; axis[1] = axesA[i][1]; axis[2] = axesA[i][2];
+    }
+    else if (i < 6)
+    {
+      axis[0] = axesB[i - 3][0]; axis[1] = axesB[i - 3][1]; axis[2] = axesB[i - 3][2];
+    }
+    else
+    {
+      cross3(axesA[(i - 6) / 3], axesB[(i - 6) % 3], axis);
+      float lenSqr = dot3(axis, axis);
+      if (lenSqr < 1e-6f)
+      {
+        continue;
+      }
+      float inv = 1.0f / sqrtf(lenSqr);
+      axis[0] *= inv; axis[1] *= inv; axis[2] *= inv;
+    }
+
+    float extentA = 0.0f, extentB = 0.0f;
+    for (int k = 0; k < 3; ++k)
+    {
+      extentA += fabsf(dot3(axis, axesA[k])) * ha[k];
+      extentB += fabsf(dot3(axis, axesB[k])) * hb[k];
+    }
+    float distance = dot3(axis, d);
+    float depth = extentA + extentB - fabsf(distance);
+    if (depth <= 0.0f)
+    {
+      return;
+    }
+
+    // Prefer the faces of a, then the faces of b, then edges, so that the
+    // reference face does not flip between steps and break warm starting.
+    float weighted = i < 3 ? depth : i < 6 ? depth * 1.02f + 1e-4f
+                                           : depth * 1.05f + 2e-4f;
+    if (weighted < bestDepth)
+    {
+      bestDepth = weighted;
+      bestAxis = i;
+      float sign = distance < 0.0f ? -1.0f : 1.0f;
+      normal[0] = axis[0] * sign;
+      normal[1] = axis[1] * sign;
+      normal[2] = axis[2] * sign;
+    }
+  }
+
+  // Vertices of the incident box that lie inside the reference box become
+  // contacts. A face of a is the reference for axes 0-2 and a face of b for
+  // axes 3-5, an edge pair checks the vertices of both boxes.
+  Contact candidates[16];
+  float candidateDepth[16];
+  size_t candidateCount = 0;
+  float supportA = dot3(normal, pa), supportB = dot3(normal, pb);
+  for (int k = 0; k < 3; ++k)
+  {
+    supportA += fabsf(dot3(normal, axesA[k])) * ha[k];
+    supportB -= fabsf(dot3(normal, axesB[k])) * hb[k];
+  }
+
+  int firstBox = bestAxis >= 3 && bestAxis < 6 ? 1 : 0;
+  int lastBox = bestAxis < 3 ? 1 : 2;
+  for (int box = firstBox; box < lastBox; ++box)
+  {
+    const float* rSelf  = box == 0 ? rb : ra;
+    const float* hSelf  = box == 0 ? hb : ha;
+    const float* pSelf  = box == 0 ? pb : pa;
+    const float* rOther = box == 0 ? ra : rb;
+    const float* hOther = box == 0 ? ha : hb;
+    const float* pOther = box == 0 ? pa : pb;
+
+    for (int v = 0; v < 8; ++v)
+    {
+      float local[3] = { v & 1 ? hSelf[0] : -hSelf[0],
+                         v & 2 ? hSelf[1] : -hSelf[1],
+                         v & 4 ? hSelf[2] : -hSelf[2] };
+      float point[3];
+      mul33(rSelf, local, point);
+      point[0] += pSelf[0];
+      point[1] += pSelf[1];
+      point[2] += pSelf[2];
+
+      float rel[3] = { point[0] - pOther[0], point[1] - pOther[1], point[2] - pOther[2] };
+      float inOther[3];
+      mul33T(rOther, rel, inOther);
+      const float margin = 1.01f;
+      if (fabsf(inOther[0]) > hOther[0] * margin + PENETRATION_SLOP ||
+          fabsf(inOther[1]) > hOther[1] * margin + PENETRATION_SLOP ||
+          fabsf(inOther[2]) > hOther[2] * margin + PENETRATION_SLOP)
+      {
+        continue;
+      }
+
+      float depth = box == 0 ? supportA - dot3(normal, point)
+                             : dot3(normal, point) - supportB;
+      if (depth <= 0.0f)
+      {
+        continue;
+      }
+
+      initContact(candidates[candidateCount], a, b, box * 8 + v, point, normal,
+                  std::min(depth, bestDepth), pa, pb);
+      candidateDepth[candidateCount] = depth;
+      ++candidateCount;
+    }
+  }
+
+  if (candidateCount == 0)
+  {
+    // Edge against edge: use the point halfway between the support planes.
+    float center[3] = { 0.5f * (pa[0] + pb[0]), 0.5f * (pa[1] + pb[1]), 0.5f * (pa[2] + pb[2]) };
+    float offset = 0.5f * (supportA + supportB) - dot3(normal, center);
+    float point[3] = { center[0] + normal[0] * offset,
+                       center[1] + normal[1] * offset,
+                       center[2] + normal[2] * offset };
+    out.push_back(Contact());
+    initContact(out.back(), a, b, 16, point, normal,
+                std::min(bestDepth, supportA - supportB), pa, pb);
+    return;
+  }
+
+  // Keep the deepest contacts.
+  while (candidateCount > MAX_BOX_CONTACTS)
+  {
+    size_t shallowest = 0;
+    for (size_t i = 1; i < candidateCount; ++i)
+    {
+      if (candidateDepth[i] < candidateDepth[shallowest])
+      {
+        shallowest = i;
+      }
+    }
+    --candidateCount;
+    candidates[shallowest] = candidates[candidateCount];
+    candidateDepth[shallowest] = candidateDepth[candidateCount];
+  }
+  out.insert(out.end(), candidates, candidates + candidateCount);
+}
+
+void RigidBodyWorld::findContacts(ThreadPool* pPool)
+{
+  const std::vector<SweepAndPrune::Pair>& pairs = m_broadphase.getPairs();
+  size_t bodyCount = m_invMass.size();
+  size_t numChunks = pPool != NULL ? pPool->getThreadCount() * 4 : 1;
+  std::vector< std::vector<Contact> > partial(numChunks);
+
+  // Proxies are created in body order and never removed, so a proxy handle
+  // is also the body handle.
+  ThreadPool::RangeTask narrowphase = [&](size_t begin, size_t end) {
+    for (size_t c = begin; c < end; ++c)
+    {
+      size_t pairBegin = pairs.size() * c / numChunks;
+      size_t pairEnd   = pairs.size() * (c + 1) / numChunks;
+      for (size_t p = pairBegin; p < pairEnd; ++p)
+      {
+        unsigned int a = pairs[p].first;
+        unsigned int b = pairs[p].second;
+        if (m_invMass[a] == 0.0f && m_invMass[b] == 0.0f)
+        {
+          continue;
+        }
+        if (m_invMass[a] == 0.0f)
+        {
+          std::swap(a, b);
+        }
+        collide(a, b, partial[c]);
+      }
+
+      if (m_hasGround)
+      {
+        size_t bodyBegin = bodyCount * c / numChunks;
+        size_t bodyEnd   = bodyCount * (c + 1) / numChunks;
+        for (size_t i = bodyBegin; i < bodyEnd; ++i)
+        {
+          if (m_invMass[i] > 0.0f)
+          {
+            collideGround((unsigned int) i, partial[c]);
+          }
+        }
+      }
+    }
+  };
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, numChunks, 1, narrowphase);
+  }
+  else
+  {
+    narrowphase(0, numChunks);
+  }
+
+  // The chunks depend on the thread count. Order the contacts by body pair
+  // so that islands and solver order, and so the simulation, do not.
+  m_contacts.clear();
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    m_contacts.insert(m_contacts.end(), partial[c].begin(), partial[c].end());
+  }
+  std::stable_sort(m_contacts.begin(), m_contacts.end());
+}
+
+bool RigidBodyWorld::Contact::operator <(const Contact& other) const
+{
+  if (a != other.a)
+  {
+    return a < other.a;
+  }
+  if (b != other.b)
+  {
+    return b < other.b;
+  }
+  return feature < other.feature;
+}
+
+bool RigidBodyWorld::CachedImpulse::operator <(const CachedImpulse& other) const
+{
+  if (a != other.a)
+  {
+    return a < other.a;
+  }
+  if (b != other.b)
+  {
+    return b < other.b;
+  }
+  return feature < other.feature;
+}
+
+/*
+ * Remember the impulses of this step so that the solver can start from them
+ * in the next one (warm starting). Stacks need far fewer iterations this way.
+ */
+void RigidBodyWorld::cacheImpulses()
+{
+  m_impulseCache.resize(m_contacts.size());
+  for (size_t i = 0; i < m_contacts.size(); ++i)
+  {
+    const Contact& c = m_contacts[i];
+    CachedImpulse& cached = m_impulseCache[i];
+    cached.a = c.a;
+    cached.b = c.b;
+    cached.feature = c.feature;
+    cached.impulse = c.impulse;
+    cached.impulseT1 = c.impulseT1;
+    cached.impulseT2 = c.impulseT2;
+  }
+  std::sort(m_impulseCache.begin(), m_impulseCache.end());
+}
+
+static unsigned int findRoot(std::vector<unsigned int>& parent, unsigned int i)
+{
+  while (parent[i] != i)
+  {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+void RigidBodyWorld::buildIslands()
+{
+  size_t bodyCount = m_invMass.size();
+  m_islandParent.resize(bodyCount);
+  for (size_t i = 0; i < bodyCount; ++i)
+  {
+    m_islandParent[i] = (unsigned int) i;
+  }
+
+  // Static bodies and the ground do not connect islands. Body a of every
+  // contact is dynamic.
+  for (size_t c = 0; c < m_contacts.size(); ++c)
+  {
+    unsigned int b = m_contacts[c].b;
+    if (b != INVALID_BODY && m_invMass[b] > 0.0f)
+    {
+      unsigned int rootA = findRoot(m_islandParent, m_contacts[c].a);
+      unsigned int rootB = findRoot(m_islandParent, b);
+      if (rootA != rootB)
+      {
+        m_islandParent[rootA] = rootB;
+      }
+    }
+  }
+
+  // Number the islands with contacts and bucket the contacts by island.
+  std::vector<unsigned int> islandOfRoot(bodyCount, (unsigned int) INVALID_BODY);
+  std::vector<unsigned int> contactIsland(m_contacts.size());
+  unsigned int islandCount = 0;
+  for (size_t c = 0; c < m_contacts.size(); ++c)
+  {
+    unsigned int root = findRoot(m_islandParent, m_contacts[c].a);
+    if (islandOfRoot[root] == INVALID_BODY)
+    {
+      islandOfRoot[root] = islandCount++;
+    }
+    contactIsland[c] = islandOfRoot[root];
+  }
+
+  m_islandStart.assign(islandCount + 1, 0);
+  for (size_t c = 0; c < m_contacts.size(); ++c)
+  {
+    m_islandStart[contactIsland[c] + 1]++;
+  }
+  for (unsigned int i = 0; i < islandCount; ++i)
+  {
+    m_islandStart[i + 1] += m_islandStart[i];
+  }
+
+  m_islandContacts.resize(m_contacts.size());
+  std::vector<unsigned int> cursor(m_islandStart.begin(), m_islandStart.end() - 1);
+  for (size_t c = 0; c < m_contacts.size(); ++c)
+  {
+    m_islandContacts[cursor[contactIsland[c]]++] = (unsigned int) c;
+  }
+
+  // Largest islands first so they do not end up last on one thread.
+  m_islandOrder.resize(islandCount);
+  for (unsigned int i = 0; i < islandCount; ++i)
+  {
+    m_islandOrder[i] = i;
+  }
+  const std::vector<unsigned int>& start = m_islandStart;
+  std::sort(m_islandOrder.begin(), m_islandOrder.end(),
+    [&start](unsigned int x, unsigned int y) {
+      return start[x + 1] - start[x] > start[y + 1] - start[y];
+    });
+}
+
+void RigidBodyWorld::applyImpulse(const Contact& c, const float p[3],
+                                  SolverBody& bodyA, SolverBody& bodyB)
+{
+  float rp[3], dw[3];
+  bodyA.v[0] -= p[0] * bodyA.invMass;
+  bodyA.v[1] -= p[1] * bodyA.invMass;
+  bodyA.v[2] -= p[2] * bodyA.invMass;
+  cross3(c.rA, p, rp);
+  mul33(bodyA.invInertia, rp, dw);
+  bodyA.w[0] -= dw[0];
+  bodyA.w[1] -= dw[1];
+  bodyA.w[2] -= dw[2];
+
+  // Static bodies are shared between islands and must not be written to.
+  if (bodyB.invMass > 0.0f)
+  {
+    bodyB.v[0] += p[0] * bodyB.invMass;
+    bodyB.v[1] += p[1] * bodyB.invMass;
+    bodyB.v[2] += p[2] * bodyB.invMass;
+    cross3(c.rB, p, rp);
+    mul33(bodyB.invInertia, rp, dw);
+    bodyB.w[0] += dw[0];
+    bodyB.w[1] += dw[1];
+    bodyB.w[2] += dw[2];
+  }
+}
+
+/*
+ * Velocity of the contact point on b relative to the one on a.
+ */
+static inline float relativeVelocity(const float rA[3], const float rB[3],
+                                     const float vA[3], const float wA[3],
+                                     const float vB[3], const float wB[3],
+                                     const float dir[3])
+{
+  float wrA[3], wrB[3];
+  cross3(wA, rA, wrA);
+  cross3(wB, rB, wrB);
+  return (vB[0] + wrB[0] - vA[0] - wrA[0]) * dir[0] +
+         (vB[1] + wrB[1] - vA[1] - wrA[1]) * dir[1] +
+         (vB[2] + wrB[2] - vA[2] - wrA[2]) * dir[2];
+}
+
+void RigidBodyWorld::solveIsland(size_t island, float dt)
+{
+  // Stands in for the ground, it is never written to.
+  SolverBody ground;
+  memset(&ground, 0, sizeof(ground));
+
+  unsigned int first = m_islandStart[island];
+  unsigned int last  = m_islandStart[island + 1];
+  float invDt = 1.0f / dt;
+
+  // Prepare the contacts: effective masses, velocity bias and warm start.
+  for (unsigned int i = first; i < last; ++i)
+  {
+    Contact& c = m_contacts[m_islandContacts[i]];
+    SolverBody& bodyA = m_solverBodies[c.a];
+    SolverBody& bodyB = c.b != INVALID_BODY ? m_solverBodies[c.b] : ground;
+
+    tangentBasis(c.normal, c.tangent1, c.tangent2);
+    const float* dirs[3] = { c.normal, c.tangent1, c.tangent2 };
+    float masses[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      float rnA[3], rnB[3], tA[3], tB[3];
+      cross3(c.rA, dirs[k], rnA);
+      cross3(c.rB, dirs[k], rnB);
+      mul33(bodyA.invInertia, rnA, tA);
+      mul33(bodyB.invInertia, rnB, tB);
+      float k0 = bodyA.invMass + bodyB.invMass + dot3(rnA, tA) + dot3(rnB, tB);
+      masses[k] = k0 > 0.0f ? 1.0f / k0 : 0.0f;
+    }
+    c.normalMass = masses[0];
+    c.tangentMass1 = masses[1];
+    c.tangentMass2 = masses[2];
+
+    float vn = relativeVelocity(c.rA, c.rB, bodyA.v, bodyA.w, bodyB.v, bodyB.w,
+                                c.normal);
+    c.bias = BAUMGARTE * invDt * std::max(c.depth - PENETRATION_SLOP, 0.0f);
+    if (vn < -RESTITUTION_VELOCITY)
+    {
+      c.bias = std::max(c.bias, -m_restitution * vn);
+    }
+
+    CachedImpulse key;
+    key.a = c.a;
+    key.b = c.b;
+    key.feature = c.feature;
+    std::vector<CachedImpulse>::const_iterator cached =
+      std::lower_bound(m_impulseCache.begin(), m_impulseCache.end(), key);
+    if (cached != m_impulseCache.end() && cached->a == c.a && cached->b == c.b &&
+        cached->feature == c.feature)
+    {
+      c.impulse = cached->impulse;
+      c.impulseT1 = cached->impulseT1;
+      c.impulseT2 = cached->impulseT2;
+
+      float p[3];
+      for (int k = 0; k < 3; ++k)
+      {
+        p[k] = c.normal[k] * c.impulse + c.tangent1[k] * c.impulseT1 +
+               c.tangent2[k] * c.impulseT2;
+      }
+      applyImpulse(c, p, bodyA, bodyB);
+    }
+  }
+
+  for (unsigned int it = 0; it < m_iterations; ++it)
+  {
+    for (unsigned int i = first; i < last; ++i)
+    {
+      Contact& c = m_contacts[m_islandContacts[i]];
+      SolverBody& bodyA = m_solverBodies[c.a];
+      SolverBody& bodyB = c.b != INVALID_BODY ? m_solverBodies[c.b] : ground;
+
+      const float* dirs[3] = { c.normal, c.tangent1, c.tangent2 };
+      const float masses[3] = { c.normalMass, c.tangentMass1, c.tangentMass2 };
+      float* accumulated[3] = { &c.impulse, &c.impulseT1, &c.impulseT2 };
+
+      // Friction first, then the normal impulse which keeps the bodies apart.
+      for (int k = 2; k >= 0; --k)
+      {
+        const float* dir = dirs[k];
+        float v = relativeVelocity(c.rA, c.rB, bodyA.v, bodyA.w, bodyB.v, bodyB.w,
+                                   dir);
+
+        float lambda, old = *accumulated[k];
+        if (k == 0)
+        {
+          lambda = masses[0] * (c.bias - v);
+          *accumulated[0] = std::max(old + lambda, 0.0f);
+        }
+        else
+        {
+          float limit = m_friction * c.impulse;
+          lambda = -masses[k] * v;
+          *accumulated[k] = std::max(-limit, std::min(old + lambda, limit));
+        }
+        lambda = *accumulated[k] - old;
+
+        float p[3] = { dir[0] * lambda, dir[1] * lambda, dir[2] * lambda };
+        applyImpulse(c, p, bodyA, bodyB);
+      }
+    }
+  }
+}
+
+/**
+ * Advance the simulation by one time step.
+ *
+ * The duration of every stage is available from getTimings() afterwards.
+ *
+ * @param[in] dt    - time step in seconds, typically fixed at 1/60
+ * @param[in] pPool - pool used to run the stages in parallel, or NULL
+ */
+void RigidBodyWorld::step(float dt, ThreadPool* pPool)
+{
+  size_t bodyCount = m_invMass.size();
+  Clock::time_point stepStart = Clock::now();
+  Clock::time_point start = stepStart;
+
+  ThreadPool::RangeTask velocities = [=](size_t begin, size_t end) {
+    integrateVelocities(begin, end, dt);
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, bodyCount, BODY_GRAIN_SIZE, velocities);
+  }
+  else
+  {
+    velocities(0, bodyCount);
+  }
+  m_timings.integrateVelocities = elapsedMs(start);
+
+  for (size_t i = 0; i < bodyCount; ++i)
+  {
+    m_broadphase.updateProxy(m_proxies[i], computeBounds((unsigned int) i));
+  }
+  m_broadphase.update(pPool);
+  m_timings.broadphase = elapsedMs(start);
+
+  findContacts(pPool);
+  m_timings.narrowphase = elapsedMs(start);
+
+  buildIslands();
+  m_timings.islands = elapsedMs(start);
+
+  ThreadPool::RangeTask solve = [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+    {
+      solveIsland(m_islandOrder[i], dt);
+    }
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, m_islandOrder.size(), 1, solve);
+  }
+  else
+  {
+    solve(0, m_islandOrder.size());
+  }
+  cacheImpulses();
+  m_timings.solver = elapsedMs(start);
+
+  ThreadPool::RangeTask positions = [=](size_t begin, size_t end) {
+    integratePositions(begin, end, dt);
+  };
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, bodyCount, BODY_GRAIN_SIZE, positions);
+  }
+  else
+  {
+    positions(0, bodyCount);
+  }
+  m_timings.integratePositions = elapsedMs(start);
+  m_timings.total = elapsedMs(stepStart);
+}
+
+/**
+ * Obtain the duration of every stage of the last step.
+ *
+ * @return stage timings in milliseconds
+ */
+const RigidBodyWorld::Timings& RigidBodyWorld::getTimings() const
+{
+  return m_timings;
+}
+
+/**
+ * Obtain the number of contacts found in the last step.
+ *
+ * @return contact count
+ */
+size_t RigidBodyWorld::getContactCount() const
+{
+  return m_contacts.size();
+}
+
+/**
+ * Obtain the number of islands solved in the last step.
+ *
+ * @return island count, bodies without contacts are not counted
+ */
+size_t RigidBodyWorld::getIslandCount() const
+{
+  return m_islandOrder.size();
+}
+
+}
@@ -0,0 +1,473 @@
+/**
+ * @file SweepAndPrune.cpp
+ * @date 18.10.2026
+ * @author Ivan Dortulov (ivandortulov@yahoo.com)
+ * @brief Contains the implementation of the SweepAndPrune class
+ *
+ * @section COPYRIGHT
+ * Copyright (C) 2016 Ivan Dortulov (ivandortulov@yahoo.com)
+ *
+ * @section LICENSE
+ * This software may be modified and distributed under the terms
+ * of the MIT license.  See the LICENSE file for details.
+ */
+#include "..\..\Include\LiteCube\Physics\SweepAndPrune.h"
+#include "..\..\Include\LiteCube\Core\ThreadPool.h"
+
+#include <algorithm>
+
+namespace Lite
+{
+
+// Switch the sweep axis only when another axis is clearly better, because
+// switching requires a full sort.
+static const float AXIS_SWITCH_RATIO = 1.5f;
+
+static inline unsigned long long pairKey(unsigned int a, unsigned int b)
+{
+  return a < b ? ((unsigned long long) a << 32) | b
+               : ((unsigned long long) b << 32) | a;
+}
+
+static inline SweepAndPrune::Pair keyToPair(unsigned long long key)
+{
+  SweepAndPrune::Pair pair;
+  pair.first  = (unsigned int) (key >> 32);
+  pair.second = (unsigned int) (key & 0xFFFFFFFFu);
+  return pair;
+}
+
+/**
+ * Default constructor.
+ */
+SweepAndPrune::SweepAndPrune()
+  : m_pendingInserts(0)
+  , m_isFullSortNeeded(true)
+  , m_axis(0)
+{
+}
+
+/**
+ * Destructor.
+ */
+SweepAndPrune::~SweepAndPrune()
+{
+}
+
+/**
+ * Add a box to the broadphase.
+ *
+ * The box takes part in the next update().
+ *
+ * @param[in] box - the bounds of the body
+ *
+ * @return handle of the new proxy
+ */
+unsigned int SweepAndPrune::addProxy(const AABB& box)
+{
+  unsigned int proxy;
+  if (!m_freeProxies.empty())
+  {
+    proxy = m_freeProxies.back();
+    m_freeProxies.pop_back();
+  }
+  else
+  {
+    proxy = (unsigned int) m_isAlive.size();
+    m_isAlive.push_back(0);
+    for (int a = 0; a < 3; ++a)
+    {
+      m_min[a].push_back(0.0f);
+      m_max[a].push_back(0.0f);
+    }
+  }
+
+  m_isAlive[proxy] = 1;
+  updateProxy(proxy, box);
+  m_order.push_back(proxy);
+  ++m_pendingInserts;
+  return proxy;
+}
+
+/**
+ * Remove a box from the broadphase.
+ *
+ * Its pairs are reported as removed by the next update(). The handle is not
+ * reused before that update.
+ *
+ * @param[in] proxy - handle returned by addProxy()
+ */
+void SweepAndPrune::removeProxy(unsigned int proxy)
+{
+  if (proxy < m_isAlive.size() && m_isAlive[proxy])
+  {
+    m_isAlive[proxy] = 0;
+    m_removedProxies.push_back(proxy);
+  }
+}
+
+/**
+ * Move a box.
+ *
+ * @param[in] proxy - handle returned by addProxy()
+ * @param[in] box   - the new bounds of the body
+ */
+void SweepAndPrune::updateProxy(unsigned int proxy, const AABB& box)
+{
+  if (proxy < m_isAlive.size())
+  {
+    for (int a = 0; a < 3; ++a)
+    {
+      m_min[a][proxy] = box.min.v[a];
+      m_max[a][proxy] = box.max.v[a];
+    }
+  }
+}
+
+/**
+ * Remove all boxes and pairs.
+ */
+void SweepAndPrune::clear()
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    m_min[a].clear();
+    m_max[a].clear();
+    m_sortedMin[a].clear();
+    m_sortedMax[a].clear();
+  }
+  m_isAlive.clear();
+  m_freeProxies.clear();
+  m_removedProxies.clear();
+  m_order.clear();
+  m_pairKeys.clear();
+  m_newPairKeys.clear();
+  m_pairs.clear();
+  m_addedPairs.clear();
+  m_removedPairs.clear();
+  m_pendingInserts = 0;
+  m_isFullSortNeeded = true;
+}
+
+void SweepAndPrune::chooseAxis()
+{
+  size_t count = m_order.size();
+  if (count < 2)
+  {
+    return;
+  }
+
+  double sum[3] = { 0.0, 0.0, 0.0 };
+  double sumSqr[3] = { 0.0, 0.0, 0.0 };
+  for (size_t i = 0; i < count; ++i)
+  {
+    unsigned int proxy = m_order[i];
+    for (int a = 0; a < 3; ++a)
+    {
+      double c = 0.5 * ((double) m_min[a][proxy] + m_max[a][proxy]);
+      sum[a] += c;
+      sumSqr[a] += c * c;
+    }
+  }
+
+  double variance[3];
+  int best = 0;
+  for (int a = 0; a < 3; ++a)
+  {
+    variance[a] = sumSqr[a] / count - (sum[a] / count) * (sum[a] / count);
+    if (variance[a] > variance[best])
+    {
+      best = a;
+    }
+  }
+
+  if (best != m_axis && variance[best] > variance[m_axis] * AXIS_SWITCH_RATIO)
+  {
+    m_axis = best;
+    m_isFullSortNeeded = true;
+  }
+}
+
+void SweepAndPrune::sortProxies(ThreadPool* pPool)
+{
+  size_t count = m_order.size();
+  std::vector<float>& keys = m_sortedMin[m_axis];
+  const std::vector<float>& mins = m_min[m_axis];
+  keys.resize(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    keys[i] = mins[m_order[i]];
+  }
+
+  if (m_isFullSortNeeded || m_pendingInserts * 8 > count)
+  {
+    std::sort(m_order.begin(), m_order.end(),
+      [&mins](unsigned int a, unsigned int b) {
+        return mins[a] < mins[b];
+      });
+    for (size_t i = 0; i < count; ++i)
+    {
+      keys[i] = mins[m_order[i]];
+    }
+  }
+  else
+  {
+    // Coherent motion keeps the order almost sorted.
+    for (size_t i = 1; i < count; ++i)
+    {
+      float key = keys[i];
+      unsigned int proxy = m_order[i];
+      size_t j = i;
+      while (j > 0 && keys[j - 1] > key)
+      {
+        keys[j] = keys[j - 1];
+        m_order[j] = m_order[j - 1];
+        --j;
+      }
+      keys[j] = key;
+      m_order[j] = proxy;
+    }
+  }
+
+  m_isFullSortNeeded = false;
+  m_pendingInserts = 0;
+
+  // Copy the boxes in sweep order so the sweep reads memory sequentially.
+  ThreadPool::RangeTask gather = [this](size_t begin, size_t end) {
+    for (int a = 0; a < 3; ++a)
+    {
+      if (a != m_axis)
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          m_sortedMin[a][i] = m_min[a][m_order[i]];
+        }
+      }
+      for (size_t i = begin; i < end; ++i)
+      {
+        m_sortedMax[a][i] = m_max[a][m_order[i]];
+      }
+    }
+  };
+
+  for (int a = 0; a < 3; ++a)
+  {
+    m_sortedMin[a].resize(count);
+    m_sortedMax[a].resize(count);
+  }
+
+  if (pPool != NULL)
+  {
+    pPool->parallelFor(0, count, 8192, gather);
+  }
+  else
+  {
+    gather(0, count);
+  }
+}
+
+void SweepAndPrune::sweep(size_t begin, size_t end,
+                          std::vector<unsigned long long>& out) const
+{
+  int a0 = m_axis;
+  int a1 = (m_axis + 1) % 3;
+  int a2 = (m_axis + 2) % 3;
+  size_t count = m_order.size();
+  const float* pMin0 = count > 0 ? &m_sortedMin[a0][0] : NULL;
+  const float* pMax0 = count > 0 ? &m_sortedMax[a0][0] : NULL;
+  const float* pMin1 = count > 0 ? &m_sortedMin[a1][0] : NULL;
+  const float* pMax1 = count > 0 ? &m_sortedMax[a1][0] : NULL;
+  const float* pMin2 = count > 0 ? &m_sortedMin[a2][0] : NULL;
+  const float* pMax2 = count > 0 ? &m_sortedMax[a2][0] : NULL;
+
+  for (size_t i = begin; i < end; ++i)
+  {
+    float max0 = pMax0[i];
+    float min1 = pMin1[i], max1 = pMax1[i];
+    float min2 = pMin2[i], max2 = pMax2[i];
+    for (size_t j = i + 1; j < count && pMin0[j] <= max0; ++j)
+    {
+      // Most candidates fail, evaluate without branches.
+      bool isOverlapping = (pMin1[j] <= max1) & (pMax1[j] >= min1) &
+                           (pMin2[j] <= max2) & (pMax2[j] >= min2);
+      if (isOverlapping)
+      {
+        out.push_back(pairKey(m_order[i], m_order[j]));
+      }
+    }
+  }
+}
+
+/**
+ * Bring the broadphase up to date with the boxes.
+ *
+ * Afterwards getPairs() holds all overlapping pairs, sorted, and
+ * getAddedPairs() / getRemovedPairs() hold the changes since the previous
+ * update.
+ *
+ * With a pool the sorted boxes are split into equal segments along the
+ * sweep axis and every segment is swept on its own thread. A segment owns
+ * the pairs whose lower box, in sweep order, lies in it.
+ *
+ * @param[in] pPool - pool used to sweep in parallel, or NULL
+ */
+void SweepAndPrune::update(ThreadPool* pPool)
+{
+  if (!m_removedProxies.empty())
+  {
+    const std::vector<unsigned char>& alive = m_isAlive;
+    m_order.erase(std::remove_if(m_order.begin(), m_order.end(),
+      [&alive](unsigned int proxy) {
+        return alive[proxy] == 0;
+      }), m_order.end());
+    m_freeProxies.insert(m_freeProxies.end(),
+                         m_removedProxies.begin(), m_removedProxies.end());
+    m_removedProxies.clear();
+  }
+
+  chooseAxis();
+  sortProxies(pPool);
+
+  size_t count = m_order.size();
+  m_newPairKeys.clear();
+  if (pPool != NULL && count > 4096)
+  {
+    size_t numSegments = pPool->getThreadCount() * 4;
+    size_t segmentSize = (count + numSegments - 1) / numSegments;
+    std::vector< std::vector<unsigned long long> > partial(numSegments);
+    pPool->parallelFor(0, numSegments, 1, [&](size_t begin, size_t end) {
+      for (size_t s = begin; s < end; ++s)
+      {
+        size_t first = std::min(s * segmentSize, count);
+        size_t last  = std::min(first + segmentSize, count);
+        sweep(first, last, partial[s]);
+        std::sort(partial[s].begin(), partial[s].end());
+      }
+    });
+
+    // Concatenate the sorted segments and merge neighbours pairwise.
+    std::vector<size_t> runs(1, 0);
+    for (size_t s = 0; s < numSegments; ++s)
+    {
+      m_newPairKeys.insert(m_newPairKeys.end(), partial[s].begin(), partial[s].end());
+      runs.push_back(m_newPairKeys.size());
+    }
+
+    std::vector<unsigned long long> merged(m_newPairKeys.size());
+    while (runs.size() > 2)
+    {
+      size_t numRuns = runs.size() - 1;
+      std::vector<unsigned long long>& src = m_newPairKeys;
+      pPool->parallelFor(0, (numRuns + 1) / 2, 1, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r)
+        {
+          size_t first  = runs[r * 2];
+          size_t middle = runs[std::min(r * 2 + 1, numRuns)];
+          size_t last   = runs[std::min(r * 2 + 2, numRuns)];
+          std::merge(src.begin() + first, src.begin() + middle,
+                     src.begin() + middle, src.begin() + last,
+                     merged.begin() + first);
+        }
+      });
+
+      std::vector<size_t> nextRuns;
+      for (size_t r = 0; r < runs.size(); r += 2)
+      {
+        nextRuns.push_back(runs[r]);
+      }
+      if (nextRuns.back() != runs.back())
+      {
+        nextRuns.push_back(runs.back());
+      }
+      runs.swap(nextRuns);
+      m_newPairKeys.swap(merged);
+    }
+  }
+  else
+  {
+    sweep(0, count, m_newPairKeys);
+    std::sort(m_newPairKeys.begin(), m_newPairKeys.end());
+  }
+
+  // Both key lists are sorted, so the changes fall out of one merge pass.
+  m_addedPairs.clear();
+  m_removedPairs.clear();
+  size_t i = 0, j = 0;
+  while (i < m_pairKeys.size() || j < m_newPairKeys.size())
+  {
+    if (j == m_newPairKeys.size() ||
+        (i < m_pairKeys.size() && m_pairKeys[i] < m_newPairKeys[j]))
+    {
+      m_removedPairs.push_back(keyToPair(m_pairKeys[i++]));
+    }
+    else if (i == m_pairKeys.size() || m_newPairKeys[j] < m_pairKeys[i])
+    {
+      m_addedPairs.push_back(keyToPair(m_newPairKeys[j++]));
+    }
+    else
+    {
+      ++i;
+      ++j;
+    }
+  }
+
+  m_pairKeys.swap(m_newPairKeys);
+  m_pairs.resize(m_pairKeys.size());
+  for (size_t p = 0; p < m_pairKeys.size(); ++p)
+  {
+    m_pairs[p] = keyToPair(m_pairKeys[p]);
+  }
+}
+
+/**
+ * Obtain all overlapping pairs found by the last update().
+ *
+ * @return pairs sorted by first, then second
+ */
+const std::vector<SweepAndPrune::Pair>& SweepAndPrune::getPairs() const
+{
+  return m_pairs;
+}
+
+/**
+ * Obtain the pairs which started overlapping in the last update().
+ *
+ * @return new pairs
+ */
+const std::vector<SweepAndPrune::Pair>& SweepAndPrune::getAddedPairs() const
+{
+  return m_addedPairs;
+}
+
+/**
+ * Obtain the pairs which stopped overlapping in the last update(),
+ * including the pairs of removed proxies.
+ *
+ * @return pairs which no longer overlap
+ */
+const std::vector<SweepAndPrune::Pair>& SweepAndPrune::getRemovedPairs() const
+{
+  return m_removedPairs;
+}
+
+/**
+ * Obtain the axis the boxes are currently sorted along.
+ *
+ * @return 0 for x, 1 for y and 2 for z
+ */
+int SweepAndPrune::getSweepAxis() const
+{
+  return m_axis;
+}
+
+/**
+ * Obtain the number of boxes in the broadphase.
+ *
+ * @return proxy count
+ */
+size_t SweepAndPrune::getProxyCount() const
+{
+  return m_isAlive.size() - m_freeProxies.size() - m_removedProxies.size();
+}
+
+}